@@ -27,7 +27,12 @@ mutable struct IdDict{K,V} <: AbstractDict{K,V}
     ht::Vector{Any}
     count::Int
     ndel::Int
-    IdDict{K,V}() where {K, V} = new{K,V}(Vector{Any}(undef, 32), 0, 0)
+    # resizes of large tables are done incrementally: `old` holds the previous
+    # table until all of its pairs have been migrated into `ht`, and `migrated`
+    # is the first old slot not yet moved (see _migrate! below)
+    old::Union{Vector{Any}, Nothing}
+    migrated::Int
+    IdDict{K,V}() where {K, V} = new{K,V}(Vector{Any}(undef, 32), 0, 0, nothing, 0)
 
     function IdDict{K,V}(itr) where {K, V}
         d = IdDict{K,V}()
@@ -42,7 +47,9 @@ mutable struct IdDict{K,V} <: AbstractDict{K,V}
         d
     end
 
-    IdDict{K,V}(d::IdDict{K,V}) where {K, V} = new{K,V}(copy(d.ht), d.count, d.ndel)
+    IdDict{K,V}(d::IdDict{K,V}) where {K, V} =
+        new{K,V}(copy(d.ht), d.count, d.ndel,
+                 d.old === nothing ? nothing : copy(d.old::Vector{Any}), d.migrated)
 end
 
 IdDict() = IdDict{Any,Any}()
@@ -68,7 +75,32 @@ end
 
 empty(d::IdDict, ::Type{K}, ::Type{V}) where {K, V} = IdDict{K,V}()
 
+# grow incrementally (instead of all at once inside jl_eqtable_put) once the
+# table is this long, so a single insertion never rehashes millions of slots
+const _OIDD_INCREMENTAL_MIN = 1 << 16
+# old slots to migrate per insertion while a resize is in progress (deletions
+# must not migrate: filter! deletes during iteration, and moving a pair into
+# the already-visited part of d.ht would let it escape the filter)
+const _OIDD_MIGRATE_BATCH = 64
+
+# move up to _OIDD_MIGRATE_BATCH pairs from d.old into d.ht
+function _migrate!(d::IdDict)
+    old = d.old::Vector{Any}
+    cursor = RefValue{Csize_t}(d.migrated % Csize_t)
+    d.ht = ccall(:jl_idtable_migrate, Vector{Any}, (Any, Any, Csize_t, Ptr{Csize_t}),
+                 old, d.ht, _OIDD_MIGRATE_BATCH % Csize_t, cursor)
+    d.migrated = cursor[] % Int
+    if d.migrated >= length(old)
+        d.old = nothing
+        d.migrated = 0
+    end
+    nothing
+end
+
 function rehash!(d::IdDict, newsz = length(d.ht))
+    while d.old !== nothing # finish any in-progress incremental resize
+        _migrate!(d)
+    end
     d.ht = ccall(:jl_idtable_rehash, Vector{Any}, (Any, Csize_t), d.ht, newsz)
     d
 end
@@ -88,23 +120,53 @@ function setindex!(d::IdDict{K,V}, @nospecialize(val), @nospecialize(key)) where
     if !(val isa V) # avoid a dynamic call
         val = convert(V, val)
     end
-    if d.ndel >= ((3*length(d.ht))>>2)
-        rehash!(d, max(length(d.ht)>>1, 32))
-        d.ndel = 0
+    if d.old === nothing
+        if d.ndel >= ((3*length(d.ht))>>2)
+            rehash!(d, max(length(d.ht)>>1, 32))
+            d.ndel = 0
+        end
+        sz = length(d.ht)
+        if sz >= _OIDD_INCREMENTAL_MIN && 8*(d.count + d.ndel) >= 3*sz
+            # about to exceed ~75% occupancy: start an incremental resize
+            # before jl_eqtable_put is forced to do a synchronous one
+            # (same growth policy as jl_table_assign_bp)
+            d.old = d.ht
+            d.migrated = 0
+            d.ndel = 0
+            d.ht = Vector{Any}(undef, sz >= (1<<19) ? sz<<1 : sz<<2)
+        end
+    else
+        _migrate!(d)
+    end
+    found = RefValue{Cint}(0)
+    if d.old !== nothing
+        # remove any unmigrated copy so the key lives only in the new table
+        ccall(:jl_eqtable_pop, Any, (Any, Any, Any, Ptr{Cint}),
+              d.old::Vector{Any}, key, secret_table_token, found)
     end
     inserted = RefValue{Cint}(0)
     d.ht = ccall(:jl_eqtable_put, Array{Any,1}, (Any, Any, Any, Ptr{Cint}), d.ht, key, val, inserted)
-    d.count += inserted[]
+    d.count += inserted[] - found[]
     return d
 end
 
-function get(d::IdDict{K,V}, @nospecialize(key), @nospecialize(default)) where {K, V}
+# lookup across the current table and, during an incremental resize, the
+# not-yet-migrated part of the old one
+function _oidd_get(d::IdDict, @nospecialize(key), @nospecialize(default))
     val = ccall(:jl_eqtable_get, Any, (Any, Any, Any), d.ht, key, default)
+    if val === default && d.old !== nothing
+        val = ccall(:jl_eqtable_get, Any, (Any, Any, Any), d.old::Vector{Any}, key, default)
+    end
+    return val
+end
+
+function get(d::IdDict{K,V}, @nospecialize(key), @nospecialize(default)) where {K, V}
+    val = _oidd_get(d, key, default)
     val === default ? default : val::V
 end
 
 function getindex(d::IdDict{K,V}, @nospecialize(key)) where {K, V}
-    val = ccall(:jl_eqtable_get, Any, (Any, Any, Any), d.ht, key, secret_table_token)
+    val = _oidd_get(d, key, secret_table_token)
     val === secret_table_token && throw(KeyError(key))
     return val::V
 end
@@ -112,6 +174,16 @@ end
 function pop!(d::IdDict{K,V}, @nospecialize(key), @nospecialize(default)) where {K, V}
     found = RefValue{Cint}(0)
     val = ccall(:jl_eqtable_pop, Any, (Any, Any, Any, Ptr{Cint}), d.ht, key, default, found)
+    if found[] === Cint(0) && d.old !== nothing
+        val = ccall(:jl_eqtable_pop, Any, (Any, Any, Any, Ptr{Cint}),
+                    d.old::Vector{Any}, key, default, found)
+        if found[] !== Cint(0)
+            # the tombstone lives in the old table, which is dropped once the
+            # resize finishes, so it does not count towards d.ndel
+            d.count -= 1
+            return val::V
+        end
+    end
     if found[] === Cint(0)
         return default
     else
@@ -135,6 +207,8 @@ end
 function empty!(d::IdDict)
     resize!(d.ht, 32)
     ccall(:memset, Ptr{Cvoid}, (Ptr{Cvoid}, Cint, Csize_t), d.ht, 0, sizeof(d.ht))
+    d.old = nothing
+    d.migrated = 0
     d.ndel = 0
     d.count = 0
     return d
@@ -142,10 +216,24 @@ end
 
 _oidd_nextind(a, i) = reinterpret(Int, ccall(:jl_eqtable_nextind, Csize_t, (Any, Csize_t), a, i))
 
+# iteration covers d.ht first, then (during an incremental resize) the
+# unmigrated tail of d.old; states >= length(d.ht) index into the old table
 function iterate(d::IdDict{K,V}, idx=0) where {K, V}
-    idx = _oidd_nextind(d.ht, idx)
-    idx == -1 && return nothing
-    return (Pair{K, V}(d.ht[idx + 1]::K, d.ht[idx + 2]::V), idx + 2)
+    ht = d.ht
+    lht = length(ht)
+    if idx < lht
+        nidx = _oidd_nextind(ht, idx)
+        if nidx != -1
+            return (Pair{K, V}(ht[nidx + 1]::K, ht[nidx + 2]::V), nidx + 2)
+        end
+        idx = lht
+    end
+    old = d.old
+    old === nothing && return nothing
+    old = old::Vector{Any}
+    nidx = _oidd_nextind(old, idx - lht)
+    nidx == -1 && return nothing
+    return (Pair{K, V}(old[nidx + 1]::K, old[nidx + 2]::V), lht + nidx + 2)
 end
 
 length(d::IdDict) = d.count
@@ -153,7 +241,7 @@ length(d::IdDict) = d.count
 copy(d::IdDict) = typeof(d)(d)
 
 function get!(d::IdDict{K,V}, @nospecialize(key), @nospecialize(default)) where {K, V}
-    val = ccall(:jl_eqtable_get, Any, (Any, Any, Any), d.ht, key, secret_table_token)
+    val = _oidd_get(d, key, secret_table_token)
     if val === secret_table_token
         val = isa(default, V) ? default : convert(V, default)
         setindex!(d, val, key)
@@ -164,7 +252,7 @@ function get!(d::IdDict{K,V}, @nospecialize(key), @nospecialize(default)) where
 end
 
 function get(default::Callable, d::IdDict{K,V}, @nospecialize(key)) where {K, V}
-    val = ccall(:jl_eqtable_get, Any, (Any, Any, Any), d.ht, key, secret_table_token)
+    val = _oidd_get(d, key, secret_table_token)
     if val === secret_table_token
         return default()
     else
@@ -173,7 +261,7 @@ function get(default::Callable, d::IdDict{K,V}, @nospecialize(key)) where {K, V}
 end
 
 function get!(default::Callable, d::IdDict{K,V}, @nospecialize(key)) where {K, V}
-    val = ccall(:jl_eqtable_get, Any, (Any, Any, Any), d.ht, key, secret_table_token)
+    val = _oidd_get(d, key, secret_table_token)
     if val === secret_table_token
         val = default()
         if !isa(val, V)
@@ -703,6 +703,19 @@ end
 # 2-digit decimal characters ("00":"99")
 const _dec_d100 = UInt16[(0x30 + i % 10) << 0x8 + (0x30 + i ÷ 10) for i = 0:99]
 
+# machine-word integers go through the runtime's division-free formatter
+# (src/support/int2str.c), which also saves the up-front ndigits pass
+function dec(x::Union{UInt8,UInt16,UInt32,UInt64}, pad::Int, neg::Bool)
+    pad > 1 && return invoke(dec, Tuple{Unsigned,Int,Bool}, x, pad, neg)
+    a = StringVector(neg + 21)
+    if neg
+        @inbounds a[1] = 0x2d # '-'
+    end
+    n = GC.@preserve a ccall(:jl_format_uint64, Csize_t,
+                             (Ptr{UInt8}, UInt64), pointer(a) + neg, x % UInt64) % Int
+    String(resize!(a, neg + n))
+end
+
 function dec(x::Unsigned, pad::Int, neg::Bool)
     n = neg + ndigits(x, pad=pad)
     a = StringVector(n)
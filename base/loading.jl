@@ -820,7 +820,7 @@ function _require_from_serialized(path::String)
     try
         isvalid_cache_header(io) || return ArgumentError("Invalid header in cache file $path.")
         depmodnames = parse_cache_header(io)[3]
-        isvalid_file_crc(io) || return ArgumentError("Invalid checksum in cache file $path.")
+        isvalid_file_crc(io, path) || return ArgumentError("Invalid checksum in cache file $path.")
     finally
         close(io)
     end
@@ -1486,9 +1486,9 @@ function compilecache(pkg::PkgId, path::String, internal_stderr::IO = stderr, in
         close(tmpio)
         p = create_expr_cache(pkg, path, tmppath, concrete_deps, internal_stderr, internal_stdout)
         if success(p)
-            # append checksum to the end of the .ji file:
+            # append the per-chunk checksum trailer to the end of the .ji file:
             open(tmppath, "a+") do f
-                write(f, _crc32c(seekstart(f)))
+                write_file_crc(f)
             end
             # inherit permission from the source file (and make them writable)
             chmod(tmppath, filemode(path) & 0o777 | 0o200)
@@ -1525,7 +1525,77 @@ end
 module_build_id(m::Module) = ccall(:jl_module_build_id, UInt64, (Any,), m)
 
 isvalid_cache_header(f::IOStream) = (0 != ccall(:jl_read_verify_header, Cint, (Ptr{Cvoid},), f.ios))
-isvalid_file_crc(f::IOStream) = (_crc32c(seekstart(f), filesize(f) - 4) == read(f, UInt32))
+
+const JI_CRC_CHUNK_SIZE = 1 << 20
+
+# append the checksum trailer to a finished cache file: one crc32c per
+# JI_CRC_CHUNK_SIZE chunk of the body, then the chunk count, then a crc32c of
+# the trailer itself, so that isvalid_file_crc can verify chunks in parallel
+function write_file_crc(f::IO)
+    len = filesize(f)
+    nchunks = max(1, cld(len, JI_CRC_CHUNK_SIZE))
+    seekstart(f)
+    trailer = IOBuffer()
+    for i in 1:nchunks
+        nb = min(JI_CRC_CHUNK_SIZE, len - (i - 1) * JI_CRC_CHUNK_SIZE)
+        write(trailer, _crc32c(f, nb))
+    end
+    write(trailer, UInt32(nchunks))
+    data = take!(trailer)
+    seekend(f)
+    write(f, data)
+    write(f, _crc32c(data))
+    nothing
+end
+
+function isvalid_file_crc(f::IOStream, path::String)
+    len = filesize(f)
+    len > 8 || return false
+    seek(f, len - 8)
+    nchunks = Int(read(f, UInt32))
+    trailercrc = read(f, UInt32)
+    body = len - 4 * nchunks - 8
+    (body > 0 && nchunks == max(1, cld(body, JI_CRC_CHUNK_SIZE))) || return false
+    seek(f, body)
+    tdata = read(f, 4 * nchunks + 4)
+    _crc32c(tdata) == trailercrc || return false
+    tio = IOBuffer(tdata)
+    crcs = UInt32[read(tio, UInt32) for _ in 1:nchunks]
+    # verify the chunks on all threads at once: each worker streams its own
+    # contiguous range of the file through a private handle, which also turns
+    # one long serial read into parallel I/O on networked filesystems
+    nw = min(Threads.nthreads(), nchunks)
+    if nw <= 1
+        seekstart(f)
+        for i in 1:nchunks
+            nb = min(JI_CRC_CHUNK_SIZE, body - (i - 1) * JI_CRC_CHUNK_SIZE)
+            _crc32c(f, nb) == crcs[i] || return false
+        end
+        return true
+    end
+    per = cld(nchunks, nw)
+    failed = Threads.Atomic{Bool}(false)
+    tasks = Task[]
+    for w in 1:nw
+        lo = (w - 1) * per + 1
+        hi = min(nchunks, w * per)
+        lo <= hi || break
+        t = Threads.@spawn open(path, "r") do g
+            seek(g, (lo - 1) * JI_CRC_CHUNK_SIZE)
+            for i in lo:hi
+                failed[] && break
+                nb = min(JI_CRC_CHUNK_SIZE, body - (i - 1) * JI_CRC_CHUNK_SIZE)
+                if _crc32c(g, nb) != crcs[i]
+                    failed[] = true
+                    break
+                end
+            end
+        end
+        push!(tasks, t)
+    end
+    foreach(wait, tasks)
+    return !failed[]
+end
 
 struct CacheHeaderIncludes
     id::PkgId
@@ -1941,7 +2011,7 @@ get_compiletime_preferences(::Nothing) = String[]
             end
         end
 
-        if !isvalid_file_crc(io)
+        if !isvalid_file_crc(io, cachefile)
             @debug "Rejecting cache file $cachefile because it has an invalid checksum"
             return true
         end
@@ -2006,6 +2076,55 @@ function precompile(argt::Type)
     return ret
 end
 
+"""
+    precompile_batch(sigs::Vector; workers::Integer = Threads.nthreads())
+
+Compile the signature types in `sigs` (tuple types, as passed to
+[`precompile`](@ref)) on background threads while the caller continues
+running. Returns a `Task`; `wait` on it for completion, or `fetch` it to
+obtain the number of signatures that were compiled successfully. Invalid or
+stale signatures are skipped.
+
+Intended for services that record their hot method set in production and
+replay it at boot, instead of warming up sequentially on the main thread.
+"""
+function precompile_batch(sigs::Vector; workers::Integer = Threads.nthreads())
+    sigs = convert(Vector{Any}, sigs)
+    nworkers = min(max(Int(workers), 1), max(length(sigs), 1))
+    chunk = cld(length(sigs), nworkers)
+    tasks = Task[]
+    for w in 1:nworkers
+        lo = (w - 1) * chunk
+        hi = min(lo + chunk, length(sigs))
+        lo >= hi && break
+        t = Threads.@spawn ccall(:jl_compile_hint_batch, Csize_t,
+                                 (Any, Csize_t, Csize_t), sigs, lo, hi)
+        push!(tasks, t)
+    end
+    return Threads.@spawn mapreduce(t -> Int(fetch(t)::Csize_t), +, tasks; init=0)
+end
+
+# Driver for the compile phase of `jl_compile_all_defs` (--compile=all and
+# sysimage builds): split the collected method-table entries into contiguous
+# chunks and drain them on worker tasks through the C batch compiler. The C
+# side falls back to compiling serially when this is unavailable or only one
+# thread is configured.
+function _compile_all_parallel(found::Vector{Any})
+    nworkers = min(Threads.nthreads(), max(length(found), 1))
+    chunk = cld(length(found), nworkers)
+    tasks = Task[]
+    for w in 1:nworkers
+        lo = (w - 1) * chunk
+        hi = min(lo + chunk, length(found))
+        lo >= hi && break
+        t = Threads.@spawn ccall(:jl_compile_all_defs_batch, Cvoid,
+                                 (Any, Csize_t, Csize_t), found, lo, hi)
+        push!(tasks, t)
+    end
+    foreach(wait, tasks)
+    return nothing
+end
+
 precompile(include_package_for_output, (PkgId, String, Vector{String}, Vector{String}, Vector{String}, typeof(_concrete_dependencies), Nothing))
 precompile(include_package_for_output, (PkgId, String, Vector{String}, Vector{String}, Vector{String}, typeof(_concrete_dependencies), String))
 precompile(create_expr_cache, (PkgId, String, String, typeof(_concrete_dependencies), IO, IO))
@@ -49,6 +49,7 @@ struct JLOptions
     rr_detach::Int8
     strip_metadata::Int8
     strip_ir::Int8
+    heap_size_hint::UInt64
 end
 
 # This runs early in the sysimage != is not defined yet
@@ -22,6 +22,13 @@ See also: `BLAS.get_num_threads` and `BLAS.set_num_threads` in the
 """
 nthreads() = Int(unsafe_load(cglobal(:jl_n_threads, Cint)))
 
+# Whether depth-first scheduling of spawned tasks was requested via
+# JULIA_SCHED_DEPTH_FIRST. When enabled, `@spawn` switches to the child task
+# immediately and leaves the parent's continuation available for stealing,
+# so nested spawn trees unwind depth-first instead of materializing every
+# sibling task's state at once.
+depth_first_schedule() = unsafe_load(cglobal(:jl_sched_depth_first, Cint)) != 0
+
 function threading_run(func)
     ccall(:jl_enter_threaded_region, Cvoid, ())
     n = nthreads()
@@ -184,7 +191,12 @@ macro spawn(expr)
             if $(Expr(:islocal, var))
                 put!($var, task)
             end
-            schedule(task)
+            if Threads.depth_first_schedule()
+                # run the child now; the parent is enqueued and stealable
+                Base.yield(task)
+            else
+                schedule(task)
+            end
             task
         end
     end
@@ -85,6 +85,21 @@ function jit_total_bytes()
     return Int(ccall(:jl_jit_total_bytes, Csize_t, ()))
 end
 
+"""
+    Base.jit_code_occupancy()
+
+Return a `(used, reserved)` tuple: the bytes of native code emitted by the
+just-in-time compiler and the bytes of memory mapped to hold it. The
+difference is padding inside the code blocks, which are sized and aligned
+for huge pages where the operating system supports them.
+"""
+function jit_code_occupancy()
+    used = Ref{Csize_t}(0)
+    reserved = Ref{Csize_t}(0)
+    ccall(:jl_jit_code_stats, Cvoid, (Ptr{Csize_t}, Ptr{Csize_t}), used, reserved)
+    return (Int(used[]), Int(reserved[]))
+end
+
 # print elapsed time, return expression value
 const _mem_units = ["byte", "KiB", "MiB", "GiB", "TiB", "PiB"]
 const _cnt_units = ["", " k", " M", " G", " T", " P"]
@@ -236,6 +236,73 @@ __attribute__((constructor)) void jl_load_libjulia_internal(void) {
     ((void (*)(void))jl_init_options_addr)();
 }
 
+#if defined(_OS_LINUX_)
+#include <pthread.h>
+#include <fcntl.h>
+
+// Warm the page cache for the sysimage on a background thread while the rest
+// of startup proceeds. `jl_restore_system_image` otherwise demand-pages the
+// whole image through minor faults, which on a cold-cache container start
+// serializes startup behind disk I/O. readahead() is purely advisory, so a
+// wrong guess about the path (or any error here) only forfeits the overlap.
+static void * prefault_sysimg(void * path)
+{
+    int fd = open((const char *)path, O_RDONLY | O_CLOEXEC);
+    free(path);
+    if (fd == -1)
+        return NULL;
+    off_t len = lseek(fd, 0, SEEK_END);
+    // issue the readahead in bounded chunks: each call blocks until its pages
+    // are resident, so chunking keeps the request stream going while the
+    // kernel merges adjacent I/O
+    const off_t chunk = 4 * 1024 * 1024;
+    for (off_t off = 0; off < len; off += chunk) {
+        if (readahead(fd, off, (size_t)chunk) != 0)
+            break;
+    }
+    close(fd);
+    return NULL;
+}
+
+// Figure out which sysimage the runtime is going to load (an explicit
+// -J/--sysimage argument, or the default one next to our libdir) and kick
+// off the prefault thread for it.
+static void start_sysimg_prefault(int argc, char * argv[])
+{
+    const char * explicit_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        const char * arg = argv[i];
+        if (strcmp(arg, "--") == 0)
+            break;
+        if (arg[0] == '-' && arg[1] == 'J')
+            explicit_path = (arg[2] != '\0') ? arg + 2 : (i + 1 < argc ? argv[i + 1] : NULL);
+        else if (strncmp(arg, "--sysimage=", 11) == 0)
+            explicit_path = arg + 11;
+        else if (strcmp(arg, "--sysimage") == 0 && i + 1 < argc)
+            explicit_path = argv[i + 1];
+    }
+    const char * disable = getenv("JULIA_SYSIMAGE_PREFAULT");
+    if (disable != NULL && strcmp(disable, "0") == 0)
+        return;
+    char * path = (char *)malloc(2*PATH_MAX + 1);
+    if (path == NULL)
+        return;
+    path[0] = '\0';
+    if (explicit_path != NULL) {
+        strncat(path, explicit_path, 2*PATH_MAX);
+    }
+    else {
+        strncat(path, jl_get_libdir(), 2*PATH_MAX);
+        strncat(path, PATHSEPSTRING "julia" PATHSEPSTRING "sys.so", 2*PATH_MAX);
+    }
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, prefault_sysimg, path) != 0)
+        free(path);
+    else
+        pthread_detach(thread);
+}
+#endif
+
 // Load libjulia and run the REPL with the given arguments (in UTF-8 format)
 JL_DLLEXPORT int jl_load_repl(int argc, char * argv[]) {
     // Some compilers/platforms are known to have `__attribute__((constructor))` issues,
@@ -247,6 +314,10 @@ JL_DLLEXPORT int jl_load_repl(int argc, char * argv[]) {
             exit(1);
         }
     }
+#if defined(_OS_LINUX_)
+    // Overlap sysimage I/O with the rest of startup.
+    start_sysimg_prefault(argc, argv);
+#endif
     // Next, if we're on Linux/FreeBSD, set up fast TLS.
 #if !defined(_OS_WINDOWS_) && !defined(_OS_DARWIN_)
     void (*jl_pgcstack_setkey)(void*, void*(*)(void)) = lookup_symbol(libjulia_internal, "jl_pgcstack_setkey");
@@ -37,6 +37,9 @@
 #endif
 
 // for outputting code
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/StringSet.h>
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/Bitcode/BitcodeWriterPass.h>
 #include "llvm/Object/ArchiveWriter.h"
@@ -45,6 +48,9 @@
 #include <llvm/IR/LegacyPassManagers.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 
+#include <atomic>
+#include <thread>
+
 
 using namespace llvm;
 
@@ -427,6 +433,32 @@ static void reportWriterError(const ErrorInfoBase &E)
     jl_safe_printf("ERROR: failed to emit output file %s\n", err.c_str());
 }
 
+// Number of threads (and therefore module partitions) used to emit the text
+// portion of a system image. `JULIA_IMAGE_THREADS` overrides the default of
+// half the CPU threads.
+static size_t jl_image_codegen_threads(void)
+{
+    const char *env = getenv("JULIA_IMAGE_THREADS");
+    if (env) {
+        int n = atoi(env);
+        return n > 0 ? (size_t)n : 1;
+    }
+    int n = jl_cpu_threads() / 2;
+    return n > 0 ? (size_t)n : 1;
+}
+
+// Rough compile-cost estimate used to balance the partitions.
+static size_t partition_weight(const GlobalObject &G)
+{
+    if (auto F = dyn_cast<Function>(&G)) {
+        size_t w = 1;
+        for (const BasicBlock &BB : *F)
+            w += BB.size();
+        return w;
+    }
+    return 1;
+}
+
 
 // takes the running content that has collected in the shadow module and dump it to disk
 // this builds the object file portion of the sysimage files for fast startup
@@ -517,7 +549,9 @@ void jl_dump_native_impl(void *native_code,
     Type *T_psize = T_size->getPointerTo();
 
     // add metadata information
-    if (imaging_mode) {
+    // (incremental native output needs the tables too, even though the
+    // process-global imaging mode is off during package precompilation)
+    if (imaging_mode || jl_options.incremental) {
         emit_offset_table(*data->M, data->jl_sysimg_gvars, "jl_sysimg_gvars", T_psize);
         emit_offset_table(*data->M, data->jl_sysimg_fvars, "jl_sysimg_fvars", T_psize);
 
@@ -545,7 +579,179 @@ void jl_dump_native_impl(void *native_code,
             emit_result(asm_Archive, asm_Buffer, asm_Name, outputs);
     };
 
-    add_output(*data->M, "unopt.bc", "text.bc", "text.o", "text.s");
+    // When several image codegen threads are configured, partition the text
+    // module across them and emit one object per partition. Since every
+    // definition keeps its (now external, hidden) symbol, the archive members
+    // link together exactly like the single `text.o` does. The data module
+    // below is trivial and always emitted sequentially.
+    size_t nparts = jl_image_codegen_threads();
+    if (nparts > 1) {
+        // Cross-partition references need real symbols: promote every
+        // module-local definition to external linkage. The names are already
+        // unique within the module, and hidden visibility plus dso_local
+        // keeps them out of the dynamic symbol table and cheap to reference.
+        for (GlobalValue &G : data->M->global_values()) {
+            if (G.isDeclaration() || G.hasAppendingLinkage())
+                continue;
+            if (G.hasLocalLinkage()) {
+                G.setLinkage(GlobalValue::ExternalLinkage);
+                G.setVisibility(GlobalValue::HiddenVisibility);
+                G.setDSOLocal(true);
+            }
+        }
+        // Assign each definition to the currently lightest partition.
+        // The `jl_sysimg_fvars`/`jl_sysimg_gvars` tables need no special
+        // handling: their initializers reference the (external) symbols and
+        // turn into relocations wherever the definitions end up.
+        struct Partition {
+            StringSet<> syms;
+            size_t weight = 0;
+        };
+        std::vector<Partition> parts(nparts);
+        auto lightest = [&] () -> Partition& {
+            size_t min_id = 0;
+            for (size_t i = 1; i < nparts; i++) {
+                if (parts[i].weight < parts[min_id].weight)
+                    min_id = i;
+            }
+            return parts[min_id];
+        };
+        for (GlobalObject &G : data->M->global_objects()) {
+            if (G.isDeclaration() || G.hasAppendingLinkage())
+                continue;
+            auto &p = lightest();
+            p.syms.insert(G.getName());
+            p.weight += partition_weight(G);
+        }
+        // An alias must stay with its aliasee (aliases cannot be declared).
+        for (GlobalAlias &A : data->M->aliases()) {
+            const GlobalObject *base = A.getBaseObject();
+            for (auto &p : parts) {
+                if (base && p.syms.count(base->getName())) {
+                    p.syms.insert(A.getName());
+                    break;
+                }
+            }
+        }
+        // Serialize the module once; every worker deserializes it into its
+        // own context so that optimization and MC run fully concurrently,
+        // then drops the definitions owned by the other partitions.
+        SmallVector<char, 0> ir_Buffer;
+        {
+            raw_svector_ostream ir_OS(ir_Buffer);
+            WriteBitcodeToFile(*data->M, ir_OS);
+        }
+        struct PartitionOutput {
+            SmallVector<char, 0> unopt_bc, bc, obj, asm_;
+        };
+        std::vector<PartitionOutput> part_outs(nparts);
+        auto compile_partition = [&] (size_t i) {
+            LLVMContext PCtx;
+            auto MOrErr = parseBitcodeFile(MemoryBufferRef(
+                    StringRef(ir_Buffer.data(), ir_Buffer.size()), "text"), PCtx);
+            if (!MOrErr) {
+                handleAllErrors(MOrErr.takeError(), reportWriterError);
+                abort();
+            }
+            std::unique_ptr<Module> PM_M = std::move(*MOrErr);
+            auto &syms = parts[i].syms;
+            for (Function &F : PM_M->functions()) {
+                if (!F.isDeclaration() && !syms.count(F.getName()))
+                    F.deleteBody();
+            }
+            for (GlobalVariable &G : make_early_inc_range(PM_M->globals())) {
+                if (G.isDeclaration())
+                    continue;
+                if (G.hasAppendingLinkage()) {
+                    // appending-linkage lists (llvm.used & co) cannot be
+                    // declared; keep them in the first partition only
+                    if (i != 0)
+                        G.eraseFromParent();
+                    continue;
+                }
+                if (!syms.count(G.getName()))
+                    G.setInitializer(nullptr);
+            }
+            for (GlobalAlias &A : make_early_inc_range(PM_M->aliases())) {
+                if (syms.count(A.getName()))
+                    continue;
+                std::string name = A.getName().str();
+                A.setName("");
+                GlobalValue *decl;
+                if (auto fty = dyn_cast<FunctionType>(A.getValueType()))
+                    decl = Function::Create(fty, GlobalValue::ExternalLinkage,
+                                            name, PM_M.get());
+                else
+                    decl = new GlobalVariable(*PM_M, A.getValueType(), false,
+                                              GlobalValue::ExternalLinkage,
+                                              nullptr, name);
+                A.replaceAllUsesWith(decl);
+                A.eraseFromParent();
+            }
+            // codegen through a TargetMachine is not thread safe,
+            // so each worker gets its own
+            std::unique_ptr<TargetMachine> PTM(
+                TM->getTarget().createTargetMachine(
+                    TM->getTargetTriple().getTriple(),
+                    TM->getTargetCPU(),
+                    TM->getTargetFeatureString(),
+                    TM->Options,
+                    TM->getRelocationModel(),
+                    TM->getCodeModel(),
+                    CodeGenOpt::Aggressive));
+            legacy::PassManager PPM;
+            addTargetPasses(&PPM, PTM.get());
+            raw_svector_ostream unopt_bc_pOS(part_outs[i].unopt_bc);
+            raw_svector_ostream bc_pOS(part_outs[i].bc);
+            raw_svector_ostream obj_pOS(part_outs[i].obj);
+            raw_svector_ostream asm_pOS(part_outs[i].asm_);
+            if (unopt_bc_fname)
+                PPM.add(createBitcodeWriterPass(unopt_bc_pOS));
+            if (bc_fname || obj_fname || asm_fname) {
+                addOptimizationPasses(&PPM, jl_options.opt_level, true, true);
+                addMachinePasses(&PPM, PTM.get(), jl_options.opt_level);
+            }
+            if (bc_fname)
+                PPM.add(createBitcodeWriterPass(bc_pOS));
+            if (obj_fname)
+                if (PTM->addPassesToEmitFile(PPM, obj_pOS, nullptr, CGFT_ObjectFile, false))
+                    jl_safe_printf("ERROR: target does not support generation of object files\n");
+            if (asm_fname)
+                if (PTM->addPassesToEmitFile(PPM, asm_pOS, nullptr, CGFT_AssemblyFile, false))
+                    jl_safe_printf("ERROR: target does not support generation of object files\n");
+            PPM.run(*PM_M);
+        };
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < nparts; i++)
+            workers.emplace_back(compile_partition, i);
+        for (auto &w : workers)
+            w.join();
+        // member names must outlive writeArchive below
+        std::vector<std::string> part_names;
+        part_names.reserve(4 * nparts);
+        for (size_t i = 0; i < nparts; i++) {
+            auto name = [&] (const char *base, const char *suffix) -> StringRef {
+                part_names.push_back(std::string(base) + "#" +
+                                     std::to_string(i + 1) + suffix);
+                return part_names.back();
+            };
+            if (unopt_bc_fname)
+                emit_result(unopt_bc_Archive, part_outs[i].unopt_bc,
+                            name("unopt", ".bc"), outputs);
+            if (bc_fname)
+                emit_result(bc_Archive, part_outs[i].bc,
+                            name("text", ".bc"), outputs);
+            if (obj_fname)
+                emit_result(obj_Archive, part_outs[i].obj,
+                            name("text", ".o"), outputs);
+            if (asm_fname)
+                emit_result(asm_Archive, part_outs[i].asm_,
+                            name("text", ".s"), outputs);
+        }
+    }
+    else {
+        add_output(*data->M, "unopt.bc", "text.bc", "text.o", "text.s");
+    }
 
     std::unique_ptr<Module> sysimage(new Module("sysimage", Context));
     sysimage->setTargetTriple(data->M->getTargetTriple());
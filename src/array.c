@@ -7,10 +7,15 @@
 #include <string.h>
 #ifdef _OS_WINDOWS_
 #include <malloc.h>
+#else
+#include <unistd.h>
 #endif
 #include "julia.h"
 #include "julia_internal.h"
 #include "julia_assert.h"
+#if defined(_CPU_X86_64_)
+#include <emmintrin.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,6 +57,62 @@ static inline void memmove_safe(int hasptr, char *dst, const char *src, size_t n
         memmove(dst, src, nb);
 }
 
+#if defined(_CPU_X86_64_)
+// Copies larger than the last-level cache evict everything the following
+// compute phase would have reused. Above that size we stream the destination
+// with non-temporal stores (SSE2, so unconditionally available on x86-64)
+// instead of going through memcpy.
+static size_t nt_copy_threshold(void) JL_NOTSAFEPOINT
+{
+    static size_t thresh = 0;
+    if (__unlikely(thresh == 0)) {
+        long l3 = -1;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+        l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+        thresh = l3 > 0 ? (size_t)l3 : (size_t)32 * 1024 * 1024;
+    }
+    return thresh;
+}
+
+static void memcpy_stream(char *dst, const char *src, size_t nb) JL_NOTSAFEPOINT
+{
+    while (((uintptr_t)dst & 15) && nb) {
+        *dst++ = *src++;
+        nb--;
+    }
+    while (nb >= 64) {
+        __m128i x0 = _mm_loadu_si128((const __m128i*)src);
+        __m128i x1 = _mm_loadu_si128((const __m128i*)(src + 16));
+        __m128i x2 = _mm_loadu_si128((const __m128i*)(src + 32));
+        __m128i x3 = _mm_loadu_si128((const __m128i*)(src + 48));
+        _mm_stream_si128((__m128i*)dst, x0);
+        _mm_stream_si128((__m128i*)(dst + 16), x1);
+        _mm_stream_si128((__m128i*)(dst + 32), x2);
+        _mm_stream_si128((__m128i*)(dst + 48), x3);
+        src += 64;
+        dst += 64;
+        nb -= 64;
+    }
+    _mm_sfence(); // make the streamed stores visible before any ordinary ones
+    memcpy(dst, src, nb);
+}
+#endif
+
+// memmove that streams past the cache for blocks larger than the last-level
+// cache (called from the bitstype fast paths of copyto! as well)
+JL_DLLEXPORT void *jl_memmove(void *dst, const void *src, size_t nb) JL_NOTSAFEPOINT
+{
+#if defined(_CPU_X86_64_)
+    if (nb >= nt_copy_threshold() &&
+        ((char*)dst + nb <= (const char*)src || (const char*)src + nb <= (char*)dst)) {
+        memcpy_stream((char*)dst, (const char*)src, nb);
+        return dst;
+    }
+#endif
+    return memmove(dst, src, nb);
+}
+
 // array constructors ---------------------------------------------------------
 JL_DLLEXPORT char *jl_array_typetagdata(jl_array_t *a) JL_NOTSAFEPOINT
 {
@@ -161,6 +222,7 @@ static jl_array_t *_new_array_(jl_value_t *atype, uint32_t ndims, size_t *dims,
     a->flags.hasptr = hasptr;
     a->elsize = elsz;
     a->flags.isshared = 0;
+    a->flags.iscow = 0;
     a->flags.isaligned = 1;
     a->offset = 0;
     if (ndims == 1) {
@@ -253,6 +315,7 @@ JL_DLLEXPORT jl_array_t *jl_reshape_array(jl_value_t *atype, jl_array_t *data,
     a->flags.how = 3;
     a->data = data->data;
     a->flags.isshared = 1;
+    a->flags.iscow = 0; // writes through a reshape alias the parent
     data->flags.isshared = 1;
 
     if (ndims == 1) {
@@ -285,6 +348,58 @@ JL_DLLEXPORT jl_array_t *jl_reshape_array(jl_value_t *atype, jl_array_t *data,
     return a;
 }
 
+// Make a 1-d copy-on-write view of `len` elements of `data` starting at
+// `offset` (in elements). The slice shares the parent's buffer until the
+// first store through the runtime write path (jl_arrayset, jl_arrayunset,
+// grow/delete), which materializes a private copy of the window; reads never
+// copy. Compiled code that stores into the buffer directly must call
+// jl_array_uncow first. The parent is marked shared but not copy-on-write:
+// its own writes stay in place and remain visible through slices that have
+// not copied yet.
+JL_DLLEXPORT jl_array_t *jl_array_slice(jl_array_t *data, size_t offset, size_t len)
+{
+    jl_task_t *ct = jl_current_task;
+    jl_value_t *eltype = jl_tparam0(jl_typeof(data));
+    if (!data->flags.ptrarray && jl_is_uniontype(eltype))
+        jl_exceptionf(jl_argumenterror_type,
+                      "slice: isbits union arrays store selector bytes after the "
+                      "elements, so a window cannot share the parent's buffer");
+    wideint_t last = (wideint_t)offset + (wideint_t)len;
+    if (last > (wideint_t)jl_array_len(data))
+        jl_bounds_error_int((jl_value_t*)data, (size_t)last);
+    jl_value_t *atype = jl_array_ndims(data) == 1 ? jl_typeof(data)
+                                                  : jl_apply_array_type(eltype, 1);
+    int ndimwords = jl_array_ndimwords(1);
+    int tsz = sizeof(jl_array_t) + ndimwords * sizeof(size_t) + sizeof(void*);
+    jl_array_t *a = (jl_array_t*)jl_gc_alloc(ct->ptls, tsz, atype);
+    // No allocation or safepoint allowed after this
+    a->flags.pooled = tsz <= GC_MAX_SZCLASS;
+    a->flags.ndims = 1;
+    a->offset = 0;
+    a->data = (char*)data->data + offset * data->elsize;
+    a->flags.isaligned = 0;
+    a->elsize = data->elsize;
+    a->flags.ptrarray = data->flags.ptrarray;
+    a->flags.hasptr = data->flags.hasptr;
+
+    // if data is itself a shared wrapper,
+    // owner should point back to the original array
+    jl_array_data_owner(a) = jl_array_owner(data);
+
+    a->flags.how = 3;
+    a->flags.isshared = 1;
+    a->flags.iscow = 1;
+    // marking the parent shared keeps its buffer in place: resizing it now
+    // copies to a fresh buffer instead of realloc'ing under the slice
+    data->flags.isshared = 1;
+
+#ifdef STORE_ARRAY_LEN
+    a->length = len;
+#endif
+    a->nrows = a->maxsize = len;
+    return a;
+}
+
 JL_DLLEXPORT jl_array_t *jl_string_to_array(jl_value_t *str)
 {
     jl_task_t *ct = jl_current_task;
@@ -304,6 +419,7 @@ JL_DLLEXPORT jl_array_t *jl_string_to_array(jl_value_t *str)
     jl_array_data_owner(a) = str;
     a->flags.how = 3;
     a->flags.isshared = 1;
+    a->flags.iscow = 0;
     size_t l = jl_string_len(str);
 #ifdef STORE_ARRAY_LEN
     a->length = l;
@@ -312,6 +428,24 @@ JL_DLLEXPORT jl_array_t *jl_string_to_array(jl_value_t *str)
     return a;
 }
 
+// C equivalent of Base's StringVector: a 1-d UInt8 array of `len` writable
+// (uninitialized) bytes whose buffer is an unpublished String, so a later
+// jl_array_to_string adopts the buffer without copying: the array
+// relinquishes ownership (length zeroed, marked shared) and the String is
+// returned as-is. This is the zero-copy way to build a payload that ends up
+// as a String; a plain Vector{UInt8} can never be adopted, because String
+// data lives inline after the object header rather than behind a pointer.
+// The buffer must be sized up front: growing the array past `len` copies it
+// to a fresh buffer and severs the String backing.
+JL_DLLEXPORT jl_array_t *jl_string_buffer_array(size_t len)
+{
+    jl_value_t *s = jl_alloc_string(len);
+    JL_GC_PUSH1(&s);
+    jl_array_t *a = jl_string_to_array(s);
+    JL_GC_POP();
+    return a;
+}
+
 // own_buffer != 0 iff GC should call free() on this pointer eventually
 JL_DLLEXPORT jl_array_t *jl_ptr_to_array_1d(jl_value_t *atype, void *data,
                                             size_t nel, int own_buffer)
@@ -351,6 +485,7 @@ JL_DLLEXPORT jl_array_t *jl_ptr_to_array_1d(jl_value_t *atype, void *data,
     a->flags.hasptr = isunboxed && (jl_is_datatype(eltype) && ((jl_datatype_t*)eltype)->layout->npointers > 0);
     a->flags.ndims = 1;
     a->flags.isshared = 1;
+    a->flags.iscow = 0;
     a->flags.isaligned = 0;  // TODO: allow passing memalign'd buffers
     if (own_buffer) {
         a->flags.how = 2;
@@ -419,6 +554,7 @@ JL_DLLEXPORT jl_array_t *jl_ptr_to_array(jl_value_t *atype, void *data,
     a->flags.ndims = ndims;
     a->offset = 0;
     a->flags.isshared = 1;
+    a->flags.iscow = 0;
     a->flags.isaligned = 0;
     if (own_buffer) {
         a->flags.how = 2;
@@ -478,7 +614,8 @@ JL_DLLEXPORT jl_value_t *jl_array_to_string(jl_array_t *a)
         // string also created the same way, where `a = StringVector(_)`.
         return jl_an_empty_string;
     }
-    if (a->flags.how == 3 && a->offset == 0 && a->elsize == 1 &&
+    // never steal a copy-on-write slice's buffer: the parent still owns it
+    if (a->flags.how == 3 && !a->flags.iscow && a->offset == 0 && a->elsize == 1 &&
         (jl_array_ndims(a) != 1 ||
          ((a->maxsize + sizeof(void*) + 1 <= GC_MAX_SZCLASS) == (len + sizeof(void*) + 1 <= GC_MAX_SZCLASS)))) {
         jl_value_t *o = jl_array_data_owner(a);
@@ -529,8 +666,28 @@ JL_DLLEXPORT jl_value_t *jl_alloc_string(size_t len)
     return s;
 }
 
+// Direct-mapped intern cache for strings of up to 7 bytes. Strings are egal
+// (and hash) by content, so handing out a previously allocated object for
+// identical bytes is unobservable, and short keys -- field names, dict keys,
+// tokens -- dominate string allocation in parsing-style workloads. Slots are
+// replaced on collision; entries stay alive through mark_roots until evicted.
+_Atomic(jl_value_t*) jl_small_string_cache[JL_N_SMALL_STRING_CACHE];
+
 JL_DLLEXPORT jl_value_t *jl_pchar_to_string(const char *str, size_t len)
 {
+    if (len > 0 && len <= 7) {
+        uint64_t word = 0;
+        memcpy(&word, str, len);
+        size_t i = inthash(word ^ ((uint64_t)len << 59)) & (JL_N_SMALL_STRING_CACHE - 1);
+        jl_value_t *s = jl_atomic_load_acquire(&jl_small_string_cache[i]);
+        if (s != NULL && jl_string_len(s) == len &&
+            !memcmp(jl_string_data(s), str, len))
+            return s;
+        s = jl_alloc_string(len);
+        memcpy(jl_string_data(s), str, len);
+        jl_atomic_store_release(&jl_small_string_cache[i], s);
+        return s;
+    }
     jl_value_t *s = jl_alloc_string(len);
     if (len > 0)
         memcpy(jl_string_data(s), str, len);
@@ -542,6 +699,92 @@ JL_DLLEXPORT jl_value_t *jl_cstr_to_string(const char *str)
     return jl_pchar_to_string(str, strlen(str));
 }
 
+// Three-way lexicographic comparison by bytes, with the shorter string
+// ordered first on a tie. On x86-64 the scan finds the first differing
+// byte via a 16-lane compare-and-movemask instead of memcmp's prologue.
+JL_DLLEXPORT int jl_string_cmp(jl_value_t *a, jl_value_t *b) JL_NOTSAFEPOINT
+{
+    if (a == b)
+        return 0;
+    size_t la = jl_string_len(a);
+    size_t lb = jl_string_len(b);
+    size_t lmin = la < lb ? la : lb;
+    const char *pa = jl_string_data(a);
+    const char *pb = jl_string_data(b);
+#if defined(_CPU_X86_64_)
+    size_t i = 0;
+    for (; i + 16 <= lmin; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(pa + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(pb + i));
+        uint32_t eq = _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+        if (eq != 0xffff) {
+            size_t j = i + __builtin_ctz(~eq);
+            return (uint8_t)pa[j] < (uint8_t)pb[j] ? -1 : 1;
+        }
+    }
+    for (; i < lmin; i++) {
+        if (pa[i] != pb[i])
+            return (uint8_t)pa[i] < (uint8_t)pb[i] ? -1 : 1;
+    }
+#else
+    int c = memcmp(pa, pb, lmin);
+    if (c != 0)
+        return c < 0 ? -1 : 1;
+#endif
+    return la == lb ? 0 : (la < lb ? -1 : 1);
+}
+
+// Find the first occurrence of `needle` at byte offset >= start in `hay`,
+// returning the 0-based offset of the match or (size_t)-1 if there is none.
+// The arguments are raw byte ranges so that Base can search SubStrings and
+// code unit vectors without copying them into a String first. On x86-64
+// candidate positions are screened 16 at a time by requiring a match on
+// both the first and the last needle byte; only the rare survivors reach
+// the memcmp of the needle interior.
+JL_DLLEXPORT size_t jl_string_find(const char *hay, size_t hlen,
+                                   const char *needle, size_t nlen,
+                                   size_t start) JL_NOTSAFEPOINT
+{
+    if (nlen == 0)
+        return start <= hlen ? start : (size_t)-1;
+    if (start >= hlen || hlen - start < nlen)
+        return (size_t)-1;
+    if (nlen == 1) {
+        const char *p = (const char*)memchr(hay + start, needle[0], hlen - start);
+        return p ? (size_t)(p - hay) : (size_t)-1;
+    }
+    size_t last = hlen - nlen; // last admissible match offset
+    size_t i = start;
+#if defined(_CPU_X86_64_)
+    const __m128i vfirst = _mm_set1_epi8(needle[0]);
+    const __m128i vlast = _mm_set1_epi8(needle[nlen - 1]);
+    for (; i + 16 <= last + 1; i += 16) {
+        // reads for the last-byte lane stay in bounds: i + 15 <= last, so the
+        // highest byte touched is hay[last + nlen - 1] == hay[hlen - 1]
+        __m128i h0 = _mm_loadu_si128((const __m128i*)(hay + i));
+        __m128i h1 = _mm_loadu_si128((const __m128i*)(hay + i + nlen - 1));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(h0, vfirst),
+                                                        _mm_cmpeq_epi8(h1, vlast)));
+        while (mask) {
+            size_t j = i + __builtin_ctz(mask);
+            if (!memcmp(hay + j + 1, needle + 1, nlen - 2))
+                return j;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    while (i <= last) {
+        const char *p = (const char*)memchr(hay + i, needle[0], last + 1 - i);
+        if (p == NULL)
+            break;
+        i = (size_t)(p - hay);
+        if (!memcmp(p + 1, needle + 1, nlen - 1))
+            return i;
+        i++;
+    }
+    return (size_t)-1;
+}
+
 JL_DLLEXPORT jl_array_t *jl_alloc_vec_any(size_t n)
 {
     return jl_alloc_array_1d(jl_array_any_type, n);
@@ -588,7 +831,9 @@ JL_DLLEXPORT jl_value_t *jl_arrayref(jl_array_t *a, size_t i)
     if (jl_is_uniontype(eltype)) {
         // isbits union selector bytes are always stored directly after the last array element
         uint8_t sel = jl_array_typetagdata(a)[i];
-        eltype = jl_nth_union_component(eltype, sel);
+        jl_union_components_t *comps = jl_union_components_flat(eltype);
+        // NULL means the cache slot belongs to a different union
+        eltype = comps ? comps->components[sel] : jl_nth_union_component(eltype, sel);
         if (jl_is_datatype_singleton((jl_datatype_t*)eltype))
             return ((jl_datatype_t*)eltype)->instance;
     }
@@ -612,6 +857,69 @@ JL_DLLEXPORT int jl_array_isassigned(jl_array_t *a, size_t i)
     return 1;
 }
 
+// bulk scans over the selector bytes of an isbits-union array, so loops that
+// skip one component (e.g. Missing) can classify elements a word at a time
+// instead of re-reading the tag per element
+
+#define TAG_ONES_BYTES ((size_t)-1 / 0xff) // 0x0101...01
+#define TAG_HIGH_BITS  (TAG_ONES_BYTES << 7) // 0x8080...80
+
+// number of elements in [0, len) whose selector byte equals sel
+JL_DLLEXPORT size_t jl_array_tag_count(jl_array_t *a, uint8_t sel) JL_NOTSAFEPOINT
+{
+    assert(jl_array_isbitsunion(a));
+    const char *tags = jl_array_typetagdata(a);
+    size_t len = jl_array_len(a);
+    size_t pat = TAG_ONES_BYTES * sel;
+    size_t n = 0, i = 0;
+    for (; i + sizeof(size_t) <= len; i += sizeof(size_t)) {
+        size_t w;
+        memcpy(&w, &tags[i], sizeof(size_t)); // tags are unaligned
+        w ^= pat;
+        // high bit set in each byte of w that was zero (i.e. matched sel)
+        size_t hits = (w - TAG_ONES_BYTES) & ~w & TAG_HIGH_BITS;
+        // sum the per-byte match bits into the top byte
+        n += ((hits >> 7) * TAG_ONES_BYTES) >> ((sizeof(size_t) - 1) * 8);
+    }
+    for (; i < len; i++)
+        n += (tags[i] == (char)sel);
+    return n;
+}
+
+// index of the first element at or after i whose selector equals sel,
+// or the array length if there is none
+JL_DLLEXPORT size_t jl_array_tag_find(jl_array_t *a, size_t i, uint8_t sel) JL_NOTSAFEPOINT
+{
+    assert(jl_array_isbitsunion(a));
+    const char *tags = jl_array_typetagdata(a);
+    size_t len = jl_array_len(a);
+    if (i >= len)
+        return len;
+    const char *p = (const char*)memchr(&tags[i], sel, len - i);
+    return p == NULL ? len : (size_t)(p - tags);
+}
+
+// index of the first element at or after i whose selector differs from sel,
+// or the array length if there is none
+JL_DLLEXPORT size_t jl_array_tag_find_not(jl_array_t *a, size_t i, uint8_t sel) JL_NOTSAFEPOINT
+{
+    assert(jl_array_isbitsunion(a));
+    const char *tags = jl_array_typetagdata(a);
+    size_t len = jl_array_len(a);
+    size_t pat = TAG_ONES_BYTES * sel;
+    for (; i + sizeof(size_t) <= len; i += sizeof(size_t)) {
+        size_t w;
+        memcpy(&w, &tags[i], sizeof(size_t));
+        if (w != pat)
+            break;
+    }
+    for (; i < len; i++) {
+        if (tags[i] != (char)sel)
+            return i;
+    }
+    return len;
+}
+
 JL_DLLEXPORT void jl_arrayset(jl_array_t *a JL_ROOTING_ARGUMENT, jl_value_t *rhs JL_ROOTED_ARGUMENT JL_MAYBE_UNROOTED, size_t i)
 {
     assert(i < jl_array_len(a));
@@ -622,13 +930,32 @@ JL_DLLEXPORT void jl_arrayset(jl_array_t *a JL_ROOTING_ARGUMENT, jl_value_t *rhs
             jl_type_error("arrayset", eltype, rhs);
         JL_GC_POP();
     }
+    if (__unlikely(a->flags.iscow)) {
+        // copy-on-write slice: take a private copy before the first store
+        JL_GC_PUSH1(&rhs);
+        jl_array_uncow(a);
+        JL_GC_POP();
+    }
     if (!a->flags.ptrarray) {
         int hasptr;
         if (jl_is_uniontype(eltype)) {
             uint8_t *psel = &((uint8_t*)jl_array_typetagdata(a))[i];
+            // the flattened list preserves jl_find_union_component's
+            // depth-first ordering, so a flat scan yields the same selector
+            jl_union_components_t *comps = jl_union_components_flat(eltype);
+            jl_value_t *rty = jl_typeof(rhs);
             unsigned nth = 0;
-            if (!jl_find_union_component(eltype, jl_typeof(rhs), &nth))
-                assert(0 && "invalid arrayset to isbits union");
+            if (comps) {
+                while (nth < comps->n && comps->components[nth] != rty)
+                    nth++;
+                assert(nth < comps->n && "invalid arrayset to isbits union");
+            }
+            else {
+                // cache slot belongs to a different union: walk the tree
+                int found = jl_find_union_component(eltype, rty, &nth);
+                assert(found && "invalid arrayset to isbits union");
+                (void)found;
+            }
             *psel = nth;
             if (jl_is_datatype_singleton((jl_datatype_t*)jl_typeof(rhs)))
                 return;
@@ -649,6 +976,8 @@ JL_DLLEXPORT void jl_arrayunset(jl_array_t *a, size_t i)
 {
     if (i >= jl_array_len(a))
         jl_bounds_error_int((jl_value_t*)a, i + 1);
+    if (__unlikely(a->flags.iscow))
+        jl_array_uncow(a);
     if (a->flags.ptrarray)
         jl_atomic_store_relaxed(((_Atomic(jl_value_t*)*)a->data) + i, NULL);
     else if (a->flags.hasptr) {
@@ -729,17 +1058,29 @@ static int NOINLINE array_resize_buffer(jl_array_t *a, size_t newlen)
     assert(oldlen == a->nrows &&
            "Race condition detected: recursive resizing on the same array.");
     a->flags.isshared = 0;
+    a->flags.iscow = 0; // a fresh or realloc'd buffer is always private
     a->maxsize = newlen;
     return newbuf;
 }
 
+// Resizing can move elements relative to the data pointer, which makes the
+// card indices recorded by `jl_gc_wb_array` stale. Falling back to the
+// whole-object remset keeps stale cards harmless: they are clipped to the
+// current length and only ever rescan valid slots.
+STATIC_INLINE void jl_array_invalidate_cards(jl_array_t *a)
+{
+    if (__unlikely(a->flags.ptrarray && jl_astaggedvalue(a)->bits.gc == 3))
+        jl_gc_queue_root((jl_value_t*)a);
+}
+
 static void NOINLINE array_try_unshare(jl_array_t *a)
 {
     if (a->flags.isshared) {
         if (a->flags.how != 3)
             jl_error("cannot resize array with shared data");
-        // allow resizing when data is shared with a String
-        if (jl_is_string(jl_array_data_owner(a)))
+        // allow resizing when data is shared with a String, unless this is a
+        // copy-on-write slice, which must never write through to the parent
+        if (jl_is_string(jl_array_data_owner(a)) && !a->flags.iscow)
             return;
         assert(a->offset == 0);
         size_t len = a->maxsize;
@@ -755,13 +1096,30 @@ static void NOINLINE array_try_unshare(jl_array_t *a)
     }
 }
 
+// Materialize a private copy of a copy-on-write slice's window; no-op for
+// anything else. Stores that bypass jl_arrayset (compiled code writing to
+// the data pointer directly) must call this first.
+JL_DLLEXPORT void jl_array_uncow(jl_array_t *a)
+{
+    if (__unlikely(a->flags.iscow)) {
+        jl_array_invalidate_cards(a); // the elements are about to move
+        array_try_unshare(a);
+    }
+}
+
 size_t overallocation(size_t maxsize)
 {
+    static int growth_divisor = 0;
+    if (__unlikely(growth_divisor == 0)) {
+        char *divstr = getenv(ARRAY_GROWTH_DIVISOR_NAME);
+        int div = divstr ? atoi(divstr) : 0;
+        growth_divisor = div > 0 ? div : 8;
+    }
     if (maxsize < 8)
         return 8;
-    // compute maxsize = maxsize + 4*maxsize^(7/8) + maxsize/8
+    // compute maxsize = maxsize + 4*maxsize^(7/8) + maxsize/divisor
     // for small n, we grow faster than O(n)
-    // for large n, we grow at O(n/8)
+    // for large n, we grow at O(n/divisor) (divisor = 8 unless overridden)
     // and as we reach O(memory) for memory>>1MB,
     // this means we end by adding about 10% of memory each time
     int exp2 = sizeof(maxsize) * 8 -
@@ -770,7 +1128,7 @@ size_t overallocation(size_t maxsize)
 #else
         __builtin_clz(maxsize);
 #endif
-    maxsize += ((size_t)1 << (exp2 * 7 / 8)) * 4 + maxsize / 8;
+    maxsize += ((size_t)1 << (exp2 * 7 / 8)) * 4 + maxsize / growth_divisor;
     return maxsize;
 }
 
@@ -778,6 +1136,7 @@ STATIC_INLINE void jl_array_grow_at_beg(jl_array_t *a, size_t idx, size_t inc,
                                         size_t n)
 {
     // designed to handle the case of growing and shrinking at both ends
+    jl_array_invalidate_cards(a);
     if (__unlikely(a->flags.isshared)) {
         if (a->flags.how != 3)
             jl_error("cannot resize array with shared data");
@@ -888,6 +1247,7 @@ STATIC_INLINE void jl_array_grow_at_end(jl_array_t *a, size_t idx,
                                         size_t inc, size_t n)
 {
     // optimized for the case of only growing and shrinking at the end
+    jl_array_invalidate_cards(a);
     if (__unlikely(a->flags.isshared)) {
         if (a->flags.how != 3)
             jl_error("cannot resize array with shared data");
@@ -1070,6 +1430,7 @@ STATIC_INLINE void jl_array_del_at_beg(jl_array_t *a, size_t idx, size_t dec,
 {
     // no error checking
     // assume inbounds, assume unshared
+    jl_array_invalidate_cards(a);
     size_t elsz = a->elsize;
     size_t offset = a->offset;
     int isbitsunion = jl_array_isbitsunion(a);
@@ -1214,7 +1575,7 @@ JL_DLLEXPORT jl_array_t *jl_array_copy(jl_array_t *ary)
     jl_array_t *new_ary = _new_array_(jl_typeof(ary), jl_array_ndims(ary),
                                       &ary->nrows, !ary->flags.ptrarray,
                                       ary->flags.hasptr, isunion, 0, elsz);
-    memcpy(new_ary->data, ary->data, len * elsz);
+    jl_memmove(new_ary->data, ary->data, len * elsz);
     // ensure isbits union arrays copy their selector bytes correctly
     if (jl_array_isbitsunion(ary))
         memcpy(jl_array_typetagdata(new_ary), jl_array_typetagdata(ary), len);
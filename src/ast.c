@@ -12,6 +12,7 @@
 #endif
 #include "julia.h"
 #include "julia_internal.h"
+#include "julia_gcext.h" // for jl_gc_pin_object
 #include "flisp.h"
 #include "julia_assert.h"
 
@@ -203,10 +204,24 @@ static const builtinspec_t julia_flisp_ast_ext[] = {
     { NULL, NULL }
 };
 
+// initial semispace size for each context's flisp heap; the heap doubles on
+// pressure, but lowering big files churns through several collect-and-grow
+// cycles first, which a larger starting size skips (JULIA_FLISP_HEAP_SIZE)
+static size_t flisp_heap_size(void) JL_NOTSAFEPOINT
+{
+    static size_t sz = 0;
+    if (__unlikely(sz == 0)) {
+        char *env = getenv(FLISP_HEAP_SIZE_NAME);
+        long mb = env != NULL ? atol(env) : 0;
+        sz = (mb > 0 ? (size_t)mb : 4) * 1024 * 1024;
+    }
+    return sz;
+}
+
 static void jl_init_ast_ctx(jl_ast_context_t *ctx) JL_NOTSAFEPOINT
 {
     fl_context_t *fl_ctx = &ctx->fl;
-    fl_init(fl_ctx, 4*1024*1024);
+    fl_init(fl_ctx, flisp_heap_size());
 
     if (fl_load_system_image_str(fl_ctx, (char*)flisp_system_image,
                                  sizeof(flisp_system_image))) {
@@ -761,6 +776,112 @@ static value_t julia_to_scm_(fl_context_t *fl_ctx, jl_value_t *v, int check_vali
     return julia_to_scm_noalloc2(fl_ctx, v, check_valid);
 }
 
+// Optional whole-file parse cache (set JULIA_PARSE_CACHE=1; see options.h).
+// Revise-style development re-includes mostly-unchanged files, and the parse
+// of a file depends only on its text and on the filename (which ends up in
+// the LineNumberNodes), so whole-file results are remembered under a content
+// hash. The cached tree is private -- callers routinely mutate what the
+// parser hands them (which is why jl_expand_with_loc copies before
+// expanding), so every hit is replayed through jl_copy_ast. Entries are kept
+// alive with jl_gc_pin_object and verified against the stored text, making a
+// hash collision merely a miss.
+
+typedef struct {
+    char *text; // owned copies, for verification
+    char *filename;
+    size_t text_len;
+    size_t filename_len;
+    jl_value_t *expr; // pinned; jl_nothing when the input parsed to EOF
+    size_t offset;
+} parse_cache_t;
+
+static htable_t parse_cache; // content hash -> parse_cache_t
+static jl_mutex_t parse_cache_lock;
+
+static int parse_cache_on(void)
+{
+    static int enabled = -1;
+    if (__unlikely(enabled == -1)) {
+        char *env = getenv(PARSE_CACHE_NAME);
+        enabled = env != NULL && atoi(env) != 0;
+    }
+    return enabled;
+}
+
+static uint64_t parse_cache_key(const char *text, size_t text_len,
+                                jl_value_t *filename)
+{
+    uint32_t seed = memhash32(jl_string_data(filename), jl_string_len(filename));
+    return memhash_seed(text, text_len, seed);
+}
+
+// svec(copied_expr, end_offset) for a remembered parse, or NULL on a miss
+static jl_value_t *parse_cache_lookup(uint64_t key, const char *text,
+                                      size_t text_len, jl_value_t *filename)
+{
+    jl_value_t *expr = NULL;
+    size_t offset = 0;
+    JL_LOCK_NOGC(&parse_cache_lock);
+    if (parse_cache.size > 0) {
+        parse_cache_t *e = (parse_cache_t*)ptrhash_get(&parse_cache,
+                                                       (void*)(uintptr_t)key);
+        if (e != (parse_cache_t*)HT_NOTFOUND && e->text_len == text_len &&
+            e->filename_len == jl_string_len(filename) &&
+            memcmp(e->text, text, text_len) == 0 &&
+            memcmp(e->filename, jl_string_data(filename), e->filename_len) == 0) {
+            expr = e->expr;
+            offset = e->offset;
+            if (expr != jl_nothing)
+                jl_gc_pin_object(expr); // hold it across the unlocked copy
+        }
+    }
+    JL_UNLOCK_NOGC(&parse_cache_lock);
+    if (expr == NULL)
+        return NULL;
+    jl_value_t *copy = NULL, *end_offset = NULL;
+    JL_GC_PUSH2(&copy, &end_offset);
+    copy = expr == jl_nothing ? jl_nothing : jl_copy_ast(expr);
+    if (expr != jl_nothing)
+        jl_gc_unpin_object(expr);
+    end_offset = jl_box_long(offset);
+    jl_value_t *result = (jl_value_t*)jl_svec2(copy, end_offset);
+    JL_GC_POP();
+    return result;
+}
+
+// expr must be rooted by the caller
+static void parse_cache_store(uint64_t key, const char *text, size_t text_len,
+                              jl_value_t *filename, jl_value_t *expr,
+                              size_t offset)
+{
+    jl_value_t *copy = expr == jl_nothing ? jl_nothing : jl_copy_ast(expr);
+    if (copy != jl_nothing)
+        jl_gc_pin_object(copy); // roots it; nothing can allocate before this
+    parse_cache_t *e = (parse_cache_t*)malloc_s(sizeof(parse_cache_t));
+    e->text = (char*)malloc_s(text_len);
+    memcpy(e->text, text, text_len);
+    e->filename_len = jl_string_len(filename);
+    e->filename = (char*)malloc_s(e->filename_len);
+    memcpy(e->filename, jl_string_data(filename), e->filename_len);
+    e->text_len = text_len;
+    e->expr = copy;
+    e->offset = offset;
+    JL_LOCK_NOGC(&parse_cache_lock);
+    if (parse_cache.size == 0)
+        htable_new(&parse_cache, 64);
+    void **bp = ptrhash_bp(&parse_cache, (void*)(uintptr_t)key);
+    if (*bp != HT_NOTFOUND) {
+        parse_cache_t *old = (parse_cache_t*)*bp;
+        if (old->expr != jl_nothing)
+            jl_gc_unpin_object(old->expr);
+        free(old->text);
+        free(old->filename);
+        free(old);
+    }
+    *bp = e;
+    JL_UNLOCK_NOGC(&parse_cache_lock);
+}
+
 // Parse `text` starting at 0-based `offset` and attributing the content to
 // `filename`. Return an svec of (parsed_expr, final_offset)
 JL_DLLEXPORT jl_value_t *jl_fl_parse(const char *text, size_t text_len,
@@ -781,6 +902,14 @@ JL_DLLEXPORT jl_value_t *jl_fl_parse(const char *text, size_t text_len,
         jl_error("Parse `all`: offset not supported");
     }
 
+    uint64_t cache_key = 0;
+    if (rule == jl_all_sym && parse_cache_on()) {
+        cache_key = parse_cache_key(text, text_len, filename);
+        jl_value_t *cached = parse_cache_lookup(cache_key, text, text_len, filename);
+        if (cached != NULL)
+            return cached;
+    }
+
     jl_ast_context_t *ctx = jl_ast_ctx_enter(NULL);
     fl_context_t *fl_ctx = &ctx->fl;
     value_t fl_text = cvalue_static_cstrn(fl_ctx, text, text_len);
@@ -811,6 +940,8 @@ JL_DLLEXPORT jl_value_t *jl_fl_parse(const char *text, size_t text_len,
     expr = fl_expr == fl_ctx->FL_EOF ? jl_nothing : scm_to_julia(fl_ctx, fl_expr, NULL);
     end_offset = jl_box_long(offset1);
     jl_ast_ctx_leave(ctx);
+    if (rule == jl_all_sym && parse_cache_on())
+        parse_cache_store(cache_key, text, text_len, filename, expr, offset1);
     jl_value_t *result = (jl_value_t*)jl_svec2(expr, end_offset);
     JL_GC_POP();
     return result;
@@ -0,0 +1,89 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+// Microbenchmark harness for hot runtime entry points.
+//
+// Build and run with `make -C src benchmark`. Each benchmark drives one
+// runtime primitive in a tight loop through the libjulia-internal entry point
+// a compiled caller would use, and reports wall time (jl_hrtime) and cycles
+// (cycleclock) per iteration as one JSON object per benchmark, so regressions
+// in these numbers can gate runtime changes without waiting for them to
+// surface in downstream workloads.
+//
+// The numbers are throughput measurements of the steady state: every
+// benchmark is run once untimed to compile its callees and warm the caches,
+// and allocation benchmarks deliberately include whatever GC work the
+// allocations trigger, since that cost is part of the primitive.
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "julia.h"
+#include "julia_internal.h"
+
+static int nreported = 0;
+
+static void report(const char *name, int64_t iters, uint64_t ns, uint64_t cycles)
+{
+    printf("%s  {\"name\": \"%s\", \"iterations\": %" PRId64
+           ", \"ns_per_iter\": %.2f, \"cycles_per_iter\": %.2f}",
+           nreported++ ? ",\n" : "", name, iters,
+           (double)ns / iters, (double)cycles / iters);
+}
+
+#define BENCH(name, iters, stmt) do {                                   \
+        int64_t n__ = (iters);                                          \
+        for (int64_t i = 0; i < n__ / 16 + 1; i++) { stmt; } /* warmup */ \
+        uint64_t ns__ = jl_hrtime();                                    \
+        uint64_t cy__ = cycleclock();                                   \
+        for (int64_t i = 0; i < n__; i++) { stmt; }                     \
+        cy__ = cycleclock() - cy__;                                     \
+        ns__ = jl_hrtime() - ns__;                                      \
+        report(name, n__, ns__, cy__);                                  \
+    } while (0)
+
+int main(int argc, char *argv[])
+{
+    jl_init();
+
+    jl_value_t *ident = NULL, *spawn = NULL, *f0 = NULL, *boxed = NULL,
+               *sub_a = NULL, *sub_b = NULL;
+    jl_array_t *eqtab = NULL;
+    JL_GC_PUSH7(&ident, &spawn, &f0, &boxed, &sub_a, &sub_b, &eqtab);
+
+    printf("[\n");
+
+    // generic dispatch: a one-argument call that always hits the method cache
+    ident = jl_eval_string("__bench_ident(x) = x");
+    boxed = jl_box_int64(42);
+    BENCH("jl_apply_generic", 1000000, jl_apply_generic(ident, &boxed, 1));
+
+    // pool allocation: a 16-byte box per iteration, GC pauses included
+    BENCH("jl_gc_pool_alloc", 1000000, boxed = jl_box_float64((double)i));
+
+    // subtyping: a non-trivial query that cannot take the egal fast path
+    sub_a = jl_eval_string("Tuple{Int, Vector{Float64}}");
+    sub_b = jl_eval_string("Tuple{Any, AbstractArray}");
+    BENCH("jl_subtype", 100000, jl_subtype(sub_a, sub_b));
+
+    // task round trip: jl_new_task, schedule, and both context switches of wait
+    spawn = jl_eval_string("__bench_spawn(f) = wait(schedule(Task(f)))");
+    f0 = jl_eval_string("() -> nothing");
+    BENCH("task_spawn", 10000, jl_apply_generic(spawn, &f0, 1));
+
+    // eqtable lookup over a table large enough to have rehashed a few times
+    eqtab = jl_alloc_vec_any(32);
+    jl_value_t *eqkeys[256];
+    for (int i = 0; i < 256; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "__bench_key_%d", i);
+        eqkeys[i] = (jl_value_t*)jl_symbol(name); // symbols are permanent
+        eqtab = jl_eqtable_put(eqtab, eqkeys[i], jl_true, NULL);
+    }
+    BENCH("jl_eqtable_get", 1000000, jl_eqtable_get(eqtab, eqkeys[i & 255], jl_nothing));
+
+    printf("\n]\n");
+
+    JL_GC_POP();
+    jl_atexit_hook(0);
+    return 0;
+}
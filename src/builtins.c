@@ -32,6 +32,42 @@ extern "C" {
 
 // egal and object_id ---------------------------------------------------------
 
+#if defined(_CPU_X86_64_)
+#include <emmintrin.h>
+// vector compare for flat isbits data of 16 bytes and up (e.g. static
+// arrays probed in dictionary lookups): xor 16-byte lanes, compare against
+// zero, and test the movemask, skipping memcmp's byte-granular prologue
+static int bits_equal_vec(const void *a, const void *b, size_t sz) JL_NOTSAFEPOINT
+{
+    const char *pa = (const char*)a, *pb = (const char*)b;
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 32 <= sz; i += 32) {
+        __m128i d0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(pa + i)),
+                                   _mm_loadu_si128((const __m128i*)(pb + i)));
+        __m128i d1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(pa + i + 16)),
+                                   _mm_loadu_si128((const __m128i*)(pb + i + 16)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(d0, d1), zero)) != 0xffff)
+            return 0;
+    }
+    if (i + 16 <= sz) {
+        __m128i d = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(pa + i)),
+                                  _mm_loadu_si128((const __m128i*)(pb + i)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(d, zero)) != 0xffff)
+            return 0;
+        i += 16;
+    }
+    if (i < sz) {
+        // trailing lane overlaps the previous one; sz >= 16 makes it valid
+        __m128i d = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(pa + sz - 16)),
+                                  _mm_loadu_si128((const __m128i*)(pb + sz - 16)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(d, zero)) != 0xffff)
+            return 0;
+    }
+    return 1;
+}
+#endif
+
 static int bits_equal(const void *a, const void *b, int sz) JL_NOTSAFEPOINT
 {
     switch (sz) {
@@ -40,7 +76,12 @@ static int bits_equal(const void *a, const void *b, int sz) JL_NOTSAFEPOINT
     case 2:  return memcmp(a, b, 2) == 0;
     case 4:  return memcmp(a, b, 4) == 0;
     case 8:  return memcmp(a, b, 8) == 0;
-    default: return memcmp(a, b, sz) == 0;
+    default:
+#if defined(_CPU_X86_64_)
+        if (sz >= 16)
+            return bits_equal_vec(a, b, (size_t)sz);
+#endif
+        return memcmp(a, b, sz) == 0;
     }
 }
 
@@ -254,6 +295,9 @@ static uintptr_t bits_hash(const void *b, size_t sz) JL_NOTSAFEPOINT
     case 8:  return int64to32hash(jl_load_unaligned_i64(b));
 #endif
     default:
+        // these hashes reach dt->hash for isbits type parameters and are
+        // serialized into sysimages, so this must remain the portable
+        // memhash rather than the cpu-dispatched fast variant (hashing.h)
 #ifdef _P64
         return memhash((const char*)b, sz);
 #else
@@ -791,8 +835,18 @@ JL_CALLABLE(jl_f_tuple)
         return tt->instance;
     jl_task_t *ct = jl_current_task;
     jl_value_t *jv = jl_gc_alloc(ct->ptls, jl_datatype_size(tt), tt);
-    for (i = 0; i < nargs; i++)
-        set_nth_field(tt, jv, i, args[i], 0);
+    // the tuple type was instantiated from the concrete types of the
+    // arguments, so every field type is concrete and never a union; and no
+    // safepoint separates the stores from the allocation above, so the tuple
+    // is still young and none of the stores needs a write barrier
+    for (i = 0; i < nargs; i++) {
+        size_t offs = jl_field_offset(tt, i);
+        if (jl_field_isptr(tt, i))
+            *(jl_value_t**)((char*)jl_data_ptr(jv) + offs) = args[i];
+        else
+            memcpy((char*)jl_data_ptr(jv) + offs, jl_data_ptr(args[i]),
+                   jl_field_size(tt, i));
+    }
     return jv;
 }
 
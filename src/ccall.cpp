@@ -1894,9 +1894,26 @@ jl_cgval_t function_sig_t::emit_a_ccall(
             llvmf = runtime_sym_lookup(ctx, funcptype, NULL, symarg.lib_expr, symarg.f_name, ctx.f);
         }
         else if (imaging_mode) {
+            // direct link-time binding (JULIA_SYSIMG_DIRECT_CCALLS): emit a
+            // plain reference to the symbol and let the image link step
+            // resolve it, so the call skips the lazy plt-slot load. This is
+            // only sound when the generated image is actually linked against
+            // every ccall'd library, hence opt-in.
+            static int direct_ccalls = -1;
+            if (direct_ccalls == -1) {
+                const char *env = getenv(SYSIMG_DIRECT_CCALLS_NAME);
+                direct_ccalls = env != NULL && atoi(env) != 0;
+            }
+            if (direct_ccalls) {
+                // a prior declaration with a different signature yields a
+                // bitcast constant; the call below supplies the type
+                llvmf = ctx.builder.CreateBitCast(
+                        jl_Module->getOrInsertFunction(symarg.f_name, functype).getCallee(),
+                        funcptype);
+            }
             // vararg requires musttail,
             // but musttail is incompatible with noreturn.
-            if (functype->isVarArg())
+            else if (functype->isVarArg())
                 llvmf = runtime_sym_lookup(ctx, funcptype, symarg.f_lib, NULL, symarg.f_name, ctx.f);
             else
                 llvmf = emit_plt(ctx, functype, attributes, cc, symarg.f_lib, symarg.f_name);
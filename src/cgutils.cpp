@@ -2569,7 +2569,7 @@ static Value *emit_arrayndims(jl_codectx_t &ctx, const jl_cgval_t &ary)
     Value *flags = emit_arrayflags(ctx, ary);
     cast<LoadInst>(flags)->setMetadata(LLVMContext::MD_invariant_load, MDNode::get(jl_LLVMContext, None));
     flags = ctx.builder.CreateLShr(flags, 2);
-    flags = ctx.builder.CreateAnd(flags, 0x1FF); // (1<<9) - 1
+    flags = ctx.builder.CreateAnd(flags, 0xFF); // (1<<8) - 1
     return flags;
 }
 
@@ -2869,9 +2869,10 @@ static Value *_boxed_special(jl_codectx_t &ctx, const jl_cgval_t &vinfo, Type *t
         box = call_with_attrs(ctx, box_int64_func, as_value(ctx, t, vinfo));
     else if (jb == jl_float32_type)
         box = ctx.builder.CreateCall(prepare_call(box_float32_func), as_value(ctx, t, vinfo));
-    //if (jb == jl_float64_type)
-    //  box = ctx.builder.CreateCall(box_float64_func, as_value(ctx, t, vinfo);
-    // for Float64, fall through to generic case below, to inline alloc & init of Float64 box. cheap, I know.
+    else if (jb == jl_float64_type)
+        // jl_box_float64 interns small integer-valued floats, so the call
+        // beats inline alloc & init for the union-return boxing this serves
+        box = ctx.builder.CreateCall(prepare_call(box_float64_func), as_value(ctx, t, vinfo));
     else if (jb == jl_uint8_type)
         box = track_pjlvalue(ctx, load_i8box(ctx, as_value(ctx, t, vinfo), jb));
     else if (jb == jl_uint16_type)
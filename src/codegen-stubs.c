@@ -47,6 +47,11 @@ JL_DLLEXPORT void jl_generate_fptr_for_unspecialized_fallback(jl_code_instance_t
     jl_atomic_store_release(&unspec->invoke, &jl_fptr_interpret_call);
 }
 
+JL_DLLEXPORT void jl_promote_codeinst_fallback(jl_code_instance_t *codeinst)
+{
+    (void)codeinst;
+}
+
 JL_DLLEXPORT uint32_t jl_get_LLVM_VERSION_fallback(void)
 {
     return 0;
@@ -66,6 +71,12 @@ JL_DLLEXPORT size_t jl_jit_total_bytes_fallback(void)
     return 0;
 }
 
+JL_DLLEXPORT void jl_jit_code_stats_fallback(size_t *bytes_used, size_t *bytes_reserved)
+{
+    *bytes_used = 0;
+    *bytes_reserved = 0;
+}
+
 JL_DLLEXPORT void jl_lock_profile_fallback(void)
 {
 }
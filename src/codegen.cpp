@@ -551,6 +551,73 @@ static const auto jlapplygeneric_func = new JuliaFunction{
     get_func_sig,
     get_func_attrs,
 };
+static const auto jlapplygenericsite_func = new JuliaFunction{
+    XSTR(jl_apply_generic_site),
+    [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
+                {T_prjlvalue, T_pprjlvalue, T_uint32, T_prjlvalue}, false); },
+    [](LLVMContext &C) { return AttributeList::get(C,
+            AttributeSet(),
+            Attributes(C, {Attribute::NonNull}),
+            None); },
+};
+// Register-based jlcall entries for dynamically dispatched call sites with up
+// to three arguments (see emit_apply_generic); the callee marshals and roots
+// the arguments, so the caller keeps them in registers. The site variants
+// carry the call site's inline-cache slot in a trailing argument.
+#define APPLYGENERIC_REG_ATTRS                                \
+    [](LLVMContext &C) { return AttributeList::get(C,         \
+            AttributeSet(),                                   \
+            Attributes(C, {Attribute::NonNull}),              \
+            None); }
+static const auto jlapplygeneric0_func = new JuliaFunction{
+    XSTR(jl_apply_generic0),
+    [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
+                {T_prjlvalue}, false); },
+    APPLYGENERIC_REG_ATTRS,
+};
+static const auto jlapplygeneric1_func = new JuliaFunction{
+    XSTR(jl_apply_generic1),
+    [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
+                {T_prjlvalue, T_prjlvalue}, false); },
+    APPLYGENERIC_REG_ATTRS,
+};
+static const auto jlapplygeneric2_func = new JuliaFunction{
+    XSTR(jl_apply_generic2),
+    [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
+                {T_prjlvalue, T_prjlvalue, T_prjlvalue}, false); },
+    APPLYGENERIC_REG_ATTRS,
+};
+static const auto jlapplygeneric3_func = new JuliaFunction{
+    XSTR(jl_apply_generic3),
+    [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
+                {T_prjlvalue, T_prjlvalue, T_prjlvalue, T_prjlvalue}, false); },
+    APPLYGENERIC_REG_ATTRS,
+};
+static const auto jlapplygenericsite0_func = new JuliaFunction{
+    XSTR(jl_apply_generic_site0),
+    [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
+                {T_prjlvalue, T_prjlvalue}, false); },
+    APPLYGENERIC_REG_ATTRS,
+};
+static const auto jlapplygenericsite1_func = new JuliaFunction{
+    XSTR(jl_apply_generic_site1),
+    [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
+                {T_prjlvalue, T_prjlvalue, T_prjlvalue}, false); },
+    APPLYGENERIC_REG_ATTRS,
+};
+static const auto jlapplygenericsite2_func = new JuliaFunction{
+    XSTR(jl_apply_generic_site2),
+    [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
+                {T_prjlvalue, T_prjlvalue, T_prjlvalue, T_prjlvalue}, false); },
+    APPLYGENERIC_REG_ATTRS,
+};
+static const auto jlapplygenericsite3_func = new JuliaFunction{
+    XSTR(jl_apply_generic_site3),
+    [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
+                {T_prjlvalue, T_prjlvalue, T_prjlvalue, T_prjlvalue, T_prjlvalue}, false); },
+    APPLYGENERIC_REG_ATTRS,
+};
+#undef APPLYGENERIC_REG_ATTRS
 static const auto jlinvoke_func = new JuliaFunction{
     XSTR(jl_invoke),
     [](LLVMContext &C) { return FunctionType::get(T_prjlvalue,
@@ -1815,6 +1882,7 @@ static std::pair<bool, bool> uses_specsig(jl_method_instance_t *lam, jl_value_t
 
 JL_DLLEXPORT void jl_coverage_alloc_line(StringRef filename, int line);
 JL_DLLEXPORT uint64_t *jl_coverage_data_pointer(StringRef filename, int line);
+JL_DLLEXPORT uint8_t *jl_coverage_counter_pointer(StringRef filename, int line);
 JL_DLLEXPORT uint64_t *jl_malloc_data_pointer(StringRef filename, int line);
 
 static void visitLine(jl_codectx_t &ctx, uint64_t *ptr, Value *addend, const char *name)
@@ -1835,6 +1903,24 @@ static void coverageVisitLine(jl_codectx_t &ctx, StringRef filename, int line)
     assert(!imaging_mode);
     if (filename == "" || filename == "none" || filename == "no file" || filename == "<missing>" || line < 0)
         return;
+    // cheap counter mode (JULIA_COVERAGE_COUNTERS): 8-bit saturating
+    // increment against a flat per-file buffer; see coverage.cpp
+    static int counter_mode = -1;
+    if (counter_mode == -1) {
+        const char *env = getenv(COVERAGE_COUNTERS_NAME);
+        counter_mode = env != NULL && atoi(env) != 0;
+    }
+    if (counter_mode) {
+        uint8_t *ptr = jl_coverage_counter_pointer(filename, line);
+        Value *pv = ConstantExpr::getIntToPtr(
+            ConstantInt::get(T_size, (uintptr_t)ptr),
+            T_pint8);
+        Value *v = ctx.builder.CreateLoad(T_int8, pv, true, "lcnt8");
+        Value *vinc = ctx.builder.CreateAdd(v, ConstantInt::get(T_int8, 1));
+        Value *notsat = ctx.builder.CreateICmpNE(v, ConstantInt::get(T_int8, 255));
+        ctx.builder.CreateStore(ctx.builder.CreateSelect(notsat, vinc, v), pv, true);
+        return;
+    }
     visitLine(ctx, jl_coverage_data_pointer(filename, line), ConstantInt::get(T_int64, 1), "lcnt");
 }
 
@@ -3289,6 +3375,45 @@ static CallInst *emit_jlcall(jl_codectx_t &ctx, JuliaFunction *theFptr, Value *t
     return emit_jlcall(ctx, prepare_call(theFptr), theF, argv, nargs, cc);
 }
 
+// emit a dynamically dispatched call. Outside of imaging mode each call site
+// gets its own inline-cache slot, which jl_apply_generic_site consults (and
+// the runtime re-patches) before probing the global call cache; the slot
+// pointer rides in the trailing JLCALL_F2_CC argument, like the method
+// instance does for jl_invoke.
+static CallInst *emit_apply_generic(jl_codectx_t &ctx, const jl_cgval_t *argv, size_t nargs)
+{
+    // Low-arity call sites use the register-based jlcall entries: F and the
+    // arguments are passed directly and the callee marshals them, so the
+    // JLCALL lowering does not have to spill them into this frame's GC roots.
+    if (nargs >= 1 && nargs <= 4) {
+        JuliaFunction *reg_funcs[4] = {jlapplygeneric0_func, jlapplygeneric1_func,
+                                       jlapplygeneric2_func, jlapplygeneric3_func};
+        JuliaFunction *site_funcs[4] = {jlapplygenericsite0_func, jlapplygenericsite1_func,
+                                        jlapplygenericsite2_func, jlapplygenericsite3_func};
+        SmallVector<Value*, 5> theArgs;
+        for (size_t i = 0; i < nargs; i++)
+            theArgs.push_back(boxed(ctx, argv[i]));
+        JuliaFunction *theFptr;
+        if (!imaging_mode) {
+            void *site = jl_alloc_callsite_cache();
+            theArgs.push_back(track_pjlvalue(ctx, literal_static_pointer_val(site)));
+            theFptr = site_funcs[nargs - 1];
+        }
+        else {
+            theFptr = reg_funcs[nargs - 1];
+        }
+        CallInst *result = ctx.builder.CreateCall(prepare_call(theFptr), theArgs);
+        add_return_attr(result, Attribute::NonNull);
+        return result;
+    }
+    if (!imaging_mode) {
+        void *site = jl_alloc_callsite_cache();
+        Value *siteval = track_pjlvalue(ctx, literal_static_pointer_val(site));
+        return emit_jlcall(ctx, jlapplygenericsite_func, siteval, argv, nargs, JLCALL_F2_CC);
+    }
+    return emit_jlcall(ctx, jlapplygeneric_func, nullptr, argv, nargs, JLCALL_F_CC);
+}
+
 
 static jl_cgval_t emit_call_specfun_other(jl_codectx_t &ctx, jl_method_instance_t *mi, jl_value_t *jlretty, StringRef specFunctionObject,
                                           const jl_cgval_t *argv, size_t nargs, jl_returninfo_t::CallingConv *cc, unsigned *return_roots, jl_value_t *inferred_retty)
@@ -3540,7 +3665,7 @@ static jl_cgval_t emit_invoke_modify(jl_codectx_t &ctx, jl_expr_t *ex, jl_value_
     }
 
     // emit function and arguments
-    Value *callval = emit_jlcall(ctx, jlapplygeneric_func, nullptr, argv, nargs, JLCALL_F_CC);
+    Value *callval = emit_apply_generic(ctx, argv, nargs);
     return mark_julia_type(ctx, callval, true, rt);
 }
 
@@ -3590,7 +3715,7 @@ static jl_cgval_t emit_call(jl_codectx_t &ctx, jl_expr_t *ex, jl_value_t *rt)
     }
 
     // emit function and arguments
-    Value *callval = emit_jlcall(ctx, jlapplygeneric_func, nullptr, generic_argv, n_generic_args, JLCALL_F_CC);
+    Value *callval = emit_apply_generic(ctx, generic_argv, n_generic_args);
     return mark_julia_type(ctx, callval, true, rt);
 }
 
@@ -4703,6 +4828,9 @@ static jl_cgval_t emit_expr(jl_codectx_t &ctx, jl_value_t *expr, ssize_t ssaval)
     }
     else if (head == jl_loopinfo_sym) {
         // parse Expr(:loopinfo, "julia.simdloop", ("llvm.loop.vectorize.width", 4))
+        // strings starting with "julia." are consumed by the LowerSIMDLoop pass
+        // ("julia.simdloop", "julia.ivdep", "julia.simdsearch"); everything else
+        // is attached to the loop as LLVM loop metadata
         SmallVector<Metadata *, 8> MDs;
         for (int i = 0, ie = nargs; i < ie; ++i) {
             Metadata *MD = to_md_tree(args[i]);
@@ -7898,6 +8026,15 @@ static void init_jit_functions(void)
     for (auto it : builtin_func_map)
         add_named_global(it.second, it.first);
     add_named_global(jlapplygeneric_func, &jl_apply_generic);
+    add_named_global(jlapplygenericsite_func, &jl_apply_generic_site);
+    add_named_global(jlapplygeneric0_func, &jl_apply_generic0);
+    add_named_global(jlapplygeneric1_func, &jl_apply_generic1);
+    add_named_global(jlapplygeneric2_func, &jl_apply_generic2);
+    add_named_global(jlapplygeneric3_func, &jl_apply_generic3);
+    add_named_global(jlapplygenericsite0_func, &jl_apply_generic_site0);
+    add_named_global(jlapplygenericsite1_func, &jl_apply_generic_site1);
+    add_named_global(jlapplygenericsite2_func, &jl_apply_generic_site2);
+    add_named_global(jlapplygenericsite3_func, &jl_apply_generic_site3);
     add_named_global(jlinvoke_func, &jl_invoke);
     add_named_global(jltopeval_func, &jl_toplevel_eval);
     add_named_global(jlcopyast_func, &jl_copy_ast);
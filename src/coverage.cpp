@@ -45,6 +45,53 @@ static uint64_t *allocLine(std::vector<logdata_block*> &vec, int line)
 
 static logdata_t coverageData;
 
+// Cheap counter mode (JULIA_COVERAGE_COUNTERS): 8-bit saturating per-line
+// counters in flat per-file byte buffers, allocated lazily in blocks with
+// stable addresses so codegen can embed them. Counts cap at 254, which is
+// plenty for hit/miss and hotness-style consumers, and the working set is 8x
+// smaller than the exact 64-bit counters. Merged into coverageData on dump so
+// the existing writers see it.
+const int counterdata_blocksize = 256;
+typedef uint8_t counterdata_block[counterdata_blocksize];
+typedef StringMap< std::vector<counterdata_block*> > counterdata_t;
+
+static counterdata_t coverageCounters;
+
+JL_DLLEXPORT uint8_t *jl_coverage_counter_pointer(StringRef filename, int line)
+{
+    std::vector<counterdata_block*> &vec = coverageCounters[filename];
+    unsigned block = line / counterdata_blocksize;
+    int offs = line % counterdata_blocksize;
+    if (vec.size() <= block)
+        vec.resize(block + 1);
+    if (vec[block] == NULL)
+        vec[block] = (counterdata_block*)calloc(1, sizeof(counterdata_block));
+    counterdata_block &data = *vec[block];
+    if (data[offs] == 0)
+        data[offs] = 1; // mark instrumented, mirroring allocLine
+    return &data[offs];
+}
+
+static void merge_counter_data(void)
+{
+    for (counterdata_t::iterator it = coverageCounters.begin(); it != coverageCounters.end(); it++) {
+        std::vector<logdata_block*> &lines = coverageData[it->first()];
+        const std::vector<counterdata_block*> &blocks = it->second;
+        for (size_t b = 0; b < blocks.size(); b++) {
+            if (blocks[b] == NULL)
+                continue;
+            for (int i = 0; i < counterdata_blocksize; i++) {
+                uint8_t v = (*blocks[b])[i];
+                if (v != 0) {
+                    uint64_t *p = allocLine(lines, (int)(b * counterdata_blocksize + i));
+                    if (*p < v)
+                        *p = v; // same value-1 encoding as allocLine
+                }
+            }
+        }
+    }
+}
+
 JL_DLLEXPORT void jl_coverage_alloc_line(StringRef filename, int line)
 {
     assert(!codegen_imaging_mode());
@@ -194,6 +241,7 @@ static void write_lcov_data(logdata_t &logData, const std::string &outfile)
 
 extern "C" JL_DLLEXPORT void jl_write_coverage_data(const char *output)
 {
+    merge_counter_data();
     if (output) {
         StringRef output_pattern(output);
         if (output_pattern.endswith(".info"))
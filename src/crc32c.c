@@ -428,6 +428,80 @@ JL_DLLEXPORT uint32_t jl_crc32c_sw(uint32_t crci, const char *buf, size_t len)
     return (uint32_t)crc ^ 0xffffffff;
 }
 
+/* Chaining and combination.
+
+   jl_crc32c already forms a streaming API: it both accepts and returns a
+   finalized CRC, so
+       jl_crc32c(jl_crc32c(0, a, la), b, lb) == jl_crc32c(0, ab, la + lb)
+   and a caller checksums an arbitrarily long stream by threading the value
+   through successive calls, with no buffering (init = 0, update = jl_crc32c,
+   final = the last return value).
+
+   jl_crc32c_combine covers the other direction: merging CRCs computed over
+   separate chunks, so a large file can be checksummed chunk-parallel and the
+   per-chunk results joined in O(log len2) instead of rescanned. The zeros
+   operator x^(8*len2) mod P is built by repeated squaring of the one-bit
+   shift operator over GF(2) -- the same construction as the fixed-distance
+   crc32c_long/crc32c_short tables above, but for an arbitrary distance. */
+
+static uint32_t crc32c_gf2_matrix_times(const uint32_t *mat, uint32_t vec)
+{
+    uint32_t sum = 0;
+    while (vec) {
+        if (vec & 1)
+            sum ^= *mat;
+        vec >>= 1;
+        mat++;
+    }
+    return sum;
+}
+
+static void crc32c_gf2_matrix_square(uint32_t *square, const uint32_t *mat)
+{
+    for (int n = 0; n < 32; n++)
+        square[n] = crc32c_gf2_matrix_times(mat, mat[n]);
+}
+
+/* Return the CRC-32C of the concatenation of two blocks, given each block's
+   CRC and the length of the second block. */
+JL_DLLEXPORT uint32_t jl_crc32c_combine(uint32_t crc1, uint32_t crc2, size_t len2)
+{
+    uint32_t even[32]; /* even-power-of-two zeros operator */
+    uint32_t odd[32];  /* odd-power-of-two zeros operator */
+
+    if (len2 == 0)
+        return crc1;
+
+    /* put operator for one zero bit in odd */
+    odd[0] = POLY;
+    uint32_t row = 1;
+    for (int n = 1; n < 32; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+
+    /* put operator for two zero bits in even, for four in odd */
+    crc32c_gf2_matrix_square(even, odd);
+    crc32c_gf2_matrix_square(odd, even);
+
+    /* apply len2 zero bytes to crc1 (the first square below makes `even`
+       the operator for one zero byte) */
+    do {
+        crc32c_gf2_matrix_square(even, odd);
+        if (len2 & 1)
+            crc1 = crc32c_gf2_matrix_times(even, crc1);
+        len2 >>= 1;
+        if (len2 == 0)
+            break;
+        crc32c_gf2_matrix_square(odd, even);
+        if (len2 & 1)
+            crc1 = crc32c_gf2_matrix_times(odd, crc1);
+        len2 >>= 1;
+    } while (len2);
+
+    return crc1 ^ crc2;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*****************************************************************************/
@@ -110,6 +110,41 @@ jl_datatype_t *jl_new_uninitialized_datatype(void)
     return t;
 }
 
+// Layout descriptors are immutable and thousands of instantiations share
+// identical ones (same field pattern under different type parameters), so
+// they are hash-consed: jl_get_layout builds a candidate in scratch space
+// and returns the interned copy, allocating a permanent one only for
+// layouts never seen before.
+
+static size_t layout_nbytes(const jl_datatype_layout_t *l) JL_NOTSAFEPOINT
+{
+    return sizeof(jl_datatype_layout_t) +
+        l->nfields * jl_fielddesc_size(l->fielddesc_type) +
+        ((size_t)l->npointers << l->fielddesc_type);
+}
+
+static uintptr_t layout_hash(uintptr_t key) JL_NOTSAFEPOINT
+{
+    jl_datatype_layout_t *l = (jl_datatype_layout_t*)key;
+    return memhash_fast((const char*)l, layout_nbytes(l));
+}
+
+static int layout_eq(void *ka, void *kb) JL_NOTSAFEPOINT
+{
+    jl_datatype_layout_t *a = (jl_datatype_layout_t*)ka;
+    jl_datatype_layout_t *b = (jl_datatype_layout_t*)kb;
+    size_t nb = layout_nbytes(a);
+    if (nb != layout_nbytes(b))
+        return 0;
+    return memcmp(a, b, nb) == 0;
+}
+
+#include "support/htable.inc"
+HTIMPL(layouthash, layout_hash, layout_eq)
+
+static htable_t layout_cache;
+static jl_mutex_t layout_cache_lock;
+
 static jl_datatype_layout_t *jl_get_layout(uint32_t nfields,
                                            uint32_t npointers,
                                            uint32_t alignment,
@@ -144,12 +179,13 @@ static jl_datatype_layout_t *jl_get_layout(uint32_t nfields,
         }
     }
 
-    // allocate a new descriptor
-    // TODO: lots of these are the same--take advantage of the fact these are immutable to combine them
+    // build the descriptor in scratch space (zeroed so the unused bitfield
+    // bits are deterministic for hashing) and intern it below
     uint32_t fielddesc_size = jl_fielddesc_size(fielddesc_type);
-    jl_datatype_layout_t *flddesc = (jl_datatype_layout_t*)jl_gc_perm_alloc(
-                sizeof(jl_datatype_layout_t) + nfields * fielddesc_size + (npointers << fielddesc_type),
-                0, 4, 0);
+    size_t nbytes = sizeof(jl_datatype_layout_t) + nfields * fielddesc_size +
+        ((size_t)npointers << fielddesc_type);
+    jl_datatype_layout_t *flddesc = (jl_datatype_layout_t*)malloc_s(nbytes);
+    memset(flddesc, 0, nbytes);
     flddesc->nfields = nfields;
     flddesc->alignment = alignment;
     flddesc->haspadding = haspadding;
@@ -192,7 +228,27 @@ static jl_datatype_layout_t *jl_get_layout(uint32_t nfields,
             ptrs32[i] = pointers[i];
         }
     }
-    return flddesc;
+
+    // return the interned copy, creating it if this layout is new
+    JL_LOCK_NOGC(&layout_cache_lock);
+    if (layout_cache.size == 0)
+        htable_new(&layout_cache, 4096);
+    void **bp = layouthash_bp(&layout_cache, flddesc);
+    jl_datatype_layout_t *ret;
+    if (*bp != HT_NOTFOUND) {
+        ret = (jl_datatype_layout_t*)*bp;
+    }
+    else {
+        ret = (jl_datatype_layout_t*)jl_gc_perm_alloc(nbytes, 0, 4, 0);
+        memcpy(ret, flddesc, nbytes);
+        // the lookup stored the scratch pointer as the key; keep the
+        // permanent copy there instead
+        bp[-1] = ret;
+        *bp = ret;
+    }
+    JL_UNLOCK_NOGC(&layout_cache_lock);
+    free(flddesc);
+    return ret;
 }
 
 // Determine if homogeneous tuple with fields of type t will have
@@ -1135,24 +1191,39 @@ UNBOX_FUNC(uint8pointer, uint8_t*)
         *(c_type*)jl_data_ptr(v) = x;                                   \
         return v;                                                       \
     }
-BOX_FUNC(float32, float,  jl_box, 1)
 BOX_FUNC(voidpointer, void*,  jl_box, 1)
 BOX_FUNC(uint8pointer, uint8_t*,  jl_box, 1)
-#ifdef _P64
-BOX_FUNC(float64, double, jl_box, 1)
-#else
-BOX_FUNC(float64, double, jl_box, 2)
-#endif
 
 #define NBOX_C 1024
 
+// Runtime size of the interned box caches below, so deployments whose
+// escaping integers mostly fall in a wider window can extend the covered
+// range (BOX_CACHE_SIZE_NAME). Read once before the caches are filled during
+// init; each entry is one permanently allocated box, so even a much larger
+// setting costs little memory. Kept even so the signed ranges stay symmetric,
+// and capped at 32768 so the int16 cache index arithmetic cannot alias.
+static int64_t jl_nbox_c = NBOX_C;
+
+static void jl_init_box_cache_size(void)
+{
+    const char *env = getenv(BOX_CACHE_SIZE_NAME);
+    if (env) {
+        int64_t n = atoll(env);
+        if (n < 64)
+            n = 64;
+        if (n > 32768)
+            n = 32768;
+        jl_nbox_c = n & ~(int64_t)1;
+    }
+}
+
 #define SIBOX_FUNC(typ,c_type,nw)\
-    static jl_value_t *boxed_##typ##_cache[NBOX_C];                     \
+    static jl_value_t **boxed_##typ##_cache;                            \
     JL_DLLEXPORT jl_value_t *jl_box_##typ(c_type x)                     \
     {                                                                   \
         jl_task_t *ct = jl_current_task;                                \
-        c_type idx = x+NBOX_C/2;                                        \
-        if ((u##c_type)idx < (u##c_type)NBOX_C)                         \
+        c_type idx = x+(c_type)(jl_nbox_c/2);                           \
+        if ((u##c_type)idx < (u##c_type)jl_nbox_c)                      \
             return boxed_##typ##_cache[idx];                            \
         jl_value_t *v = jl_gc_alloc(ct->ptls, nw * sizeof(void*),       \
                                     jl_##typ##_type);                   \
@@ -1160,11 +1231,11 @@ BOX_FUNC(float64, double, jl_box, 2)
         return v;                                                       \
     }
 #define UIBOX_FUNC(typ,c_type,nw)                                       \
-    static jl_value_t *boxed_##typ##_cache[NBOX_C];                     \
+    static jl_value_t **boxed_##typ##_cache;                            \
     JL_DLLEXPORT jl_value_t *jl_box_##typ(c_type x)                     \
     {                                                                   \
         jl_task_t *ct = jl_current_task;                                \
-        if (x < NBOX_C)                                                 \
+        if (x < (c_type)jl_nbox_c)                                      \
             return boxed_##typ##_cache[x];                              \
         jl_value_t *v = jl_gc_alloc(ct->ptls, nw * sizeof(void*),       \
                                     jl_##typ##_type);                   \
@@ -1185,6 +1256,35 @@ SIBOX_FUNC(int64,  int64_t, 2)
 UIBOX_FUNC(uint64, uint64_t, 2)
 #endif
 
+// Interned boxes for small integer-valued floats, mirroring the integer
+// caches above. Type-unstable code returning unions like
+// Union{Float64, Missing} has to box its result at the jlcall boundary, and
+// counts, sizes and indices promoted to float make up much of that traffic.
+// -0.0 is never interned since it is not egal to the cached 0.0.
+#define FBOX_FUNC(typ,c_type,bits_type,nw)                              \
+    static jl_value_t **boxed_##typ##_cache;                            \
+    JL_DLLEXPORT jl_value_t *jl_box_##typ(c_type x)                     \
+    {                                                                   \
+        jl_task_t *ct = jl_current_task;                                \
+        if (x >= -(c_type)(jl_nbox_c/2) && x < (c_type)(jl_nbox_c/2)) { \
+            int32_t i = (int32_t)x;                                     \
+            bits_type bits;                                             \
+            memcpy(&bits, &x, sizeof(bits));                            \
+            if ((c_type)i == x && !(i == 0 && bits != 0))               \
+                return boxed_##typ##_cache[i + jl_nbox_c/2];            \
+        }                                                               \
+        jl_value_t *v = jl_gc_alloc(ct->ptls, nw * sizeof(void*),       \
+                                    jl_##typ##_type);                   \
+        *(c_type*)jl_data_ptr(v) = x;                                   \
+        return v;                                                       \
+    }
+FBOX_FUNC(float32, float, uint32_t, 1)
+#ifdef _P64
+FBOX_FUNC(float64, double, uint64_t, 1)
+#else
+FBOX_FUNC(float64, double, uint64_t, 2)
+#endif
+
 static jl_value_t *boxed_char_cache[128];
 JL_DLLEXPORT jl_value_t *jl_box_char(uint32_t x)
 {
@@ -1208,12 +1308,22 @@ JL_DLLEXPORT jl_value_t *jl_box_uint8(uint8_t x)
     return jl_boxed_uint8_cache[x];
 }
 
+static jl_value_t **box_cache_alloc(void)
+{
+    return (jl_value_t**)malloc_s(jl_nbox_c * sizeof(jl_value_t*));
+}
+
 void jl_init_int32_int64_cache(void)
 {
+    jl_init_box_cache_size();
+    boxed_int32_cache = box_cache_alloc();
+    boxed_int64_cache = box_cache_alloc();
+    boxed_ssavalue_cache = box_cache_alloc();
+    boxed_slotnumber_cache = box_cache_alloc();
     int64_t i;
-    for(i=0; i < NBOX_C; i++) {
-        boxed_int32_cache[i]  = jl_permbox32(jl_int32_type, i-NBOX_C/2);
-        boxed_int64_cache[i]  = jl_permbox64(jl_int64_type, i-NBOX_C/2);
+    for(i=0; i < jl_nbox_c; i++) {
+        boxed_int32_cache[i]  = jl_permbox32(jl_int32_type, i-jl_nbox_c/2);
+        boxed_int64_cache[i]  = jl_permbox64(jl_int64_type, i-jl_nbox_c/2);
 #ifdef _P64
         boxed_ssavalue_cache[i] = jl_permbox64(jl_ssavalue_type, i);
         boxed_slotnumber_cache[i] = jl_permbox64(jl_slotnumber_type, i);
@@ -1229,6 +1339,12 @@ void jl_init_int32_int64_cache(void)
 
 void jl_init_box_caches(void)
 {
+    boxed_int16_cache = box_cache_alloc();
+    boxed_uint16_cache = box_cache_alloc();
+    boxed_uint32_cache = box_cache_alloc();
+    boxed_uint64_cache = box_cache_alloc();
+    boxed_float32_cache = box_cache_alloc();
+    boxed_float64_cache = box_cache_alloc();
     int64_t i;
     for(i=0; i < 128; i++) {
         boxed_char_cache[i] = jl_permbox32(jl_char_type, i << 24);
@@ -1236,11 +1352,19 @@ void jl_init_box_caches(void)
     for(i=0; i < 256; i++) {
         jl_boxed_int8_cache[i] = jl_permbox8(jl_int8_type, i);
     }
-    for(i=0; i < NBOX_C; i++) {
-        boxed_int16_cache[i]  = jl_permbox16(jl_int16_type, i-NBOX_C/2);
+    for(i=0; i < jl_nbox_c; i++) {
+        boxed_int16_cache[i]  = jl_permbox16(jl_int16_type, i-jl_nbox_c/2);
         boxed_uint16_cache[i] = jl_permbox16(jl_uint16_type, i);
         boxed_uint32_cache[i] = jl_permbox32(jl_uint32_type, i);
         boxed_uint64_cache[i] = jl_permbox64(jl_uint64_type, i);
+        float f = (float)(i - jl_nbox_c/2);
+        double d = (double)(i - jl_nbox_c/2);
+        int32_t fbits;
+        int64_t dbits;
+        memcpy(&fbits, &f, sizeof(fbits));
+        memcpy(&dbits, &d, sizeof(dbits));
+        boxed_float32_cache[i] = jl_permbox32(jl_float32_type, fbits);
+        boxed_float64_cache[i] = jl_permbox64(jl_float64_type, dbits);
     }
 }
 
@@ -1280,10 +1404,16 @@ JL_DLLEXPORT jl_value_t *jl_new_structv(jl_datatype_t *type, jl_value_t **args,
     size_t nf = jl_datatype_nfields(type);
     if (nf - type->name->n_uninitialized > na || na > nf)
         jl_error("invalid struct allocation");
+    // with no pointer, union, or atomic fields, every field is stored inline
+    // with concrete type, so after the type-check pass construction is a
+    // straight per-field blit with no write barriers and no rooting
+    int bulk = type->layout->npointers == 0 && type->name->atomicfields == NULL;
     for (size_t i = 0; i < na; i++) {
         jl_value_t *ft = jl_field_type_concrete(type, i);
         if (!jl_isa(args[i], ft))
             jl_type_error("new", ft, args[i]);
+        if (jl_is_uniontype(ft))
+            bulk = 0;
     }
     if (type->instance != NULL)
         return type->instance;
@@ -1292,16 +1422,24 @@ JL_DLLEXPORT jl_value_t *jl_new_structv(jl_datatype_t *type, jl_value_t **args,
         if (jl_field_offset(type, 0) != 0) {
             memset(jl_data_ptr(jv), 0, jl_field_offset(type, 0));
         }
-        JL_GC_PUSH1(&jv);
-        for (size_t i = 0; i < na; i++) {
-            set_nth_field(type, jv, i, args[i], 0);
+        if (bulk) {
+            char *data = (char*)jl_data_ptr(jv);
+            for (size_t i = 0; i < na; i++)
+                memcpy(data + jl_field_offset(type, i), jl_data_ptr(args[i]),
+                       jl_field_size(type, i));
+        }
+        else {
+            JL_GC_PUSH1(&jv);
+            for (size_t i = 0; i < na; i++) {
+                set_nth_field(type, jv, i, args[i], 0);
+            }
+            JL_GC_POP();
         }
         if (na < jl_datatype_nfields(type)) {
             char *data = (char*)jl_data_ptr(jv);
             size_t offs = jl_field_offset(type, na);
             memset(data + offs, 0, jl_datatype_size(type) - offs);
         }
-        JL_GC_POP();
     }
     return jv;
 }
@@ -1327,6 +1465,36 @@ JL_DLLEXPORT jl_value_t *jl_new_structt(jl_datatype_t *type, jl_value_t *tup)
         }
         return type->instance;
     }
+    // when neither side has pointer, union, or atomic fields, the per-field
+    // layouts coincide up to offsets and the fields can be blitted from the
+    // tuple without boxing each element through jl_get_nth_field
+    jl_datatype_t *tupt = (jl_datatype_t*)jl_typeof(tup);
+    if (nf > 0 && type->layout->npointers == 0 && type->name->atomicfields == NULL &&
+        tupt->layout->npointers == 0) {
+        int exact = 1;
+        for (size_t i = 0; i < nargs; i++) {
+            jl_value_t *ft = jl_field_type_concrete(type, i);
+            jl_value_t *et = jl_field_type_concrete(tupt, i);
+            if (jl_is_uniontype(ft) || jl_is_uniontype(et)) {
+                exact = 0;
+                break;
+            }
+            if (et != ft)
+                jl_type_error("new", ft, jl_get_nth_field(tup, i));
+        }
+        if (exact) {
+            size_t size = jl_datatype_size(type);
+            jl_value_t *jv = jl_gc_alloc(ct->ptls, size, type);
+            char *data = (char*)jl_data_ptr(jv);
+            if (jl_field_offset(type, 0) != 0)
+                memset(data, 0, jl_field_offset(type, 0));
+            for (size_t i = 0; i < nargs; i++)
+                memcpy(data + jl_field_offset(type, i),
+                       (char*)jl_data_ptr(tup) + jl_field_offset(tupt, i),
+                       jl_field_size(type, i));
+            return jv;
+        }
+    }
     size_t size = jl_datatype_size(type);
     jl_value_t *jv = jl_gc_alloc(ct->ptls, size, type);
     if (nf == 0)
@@ -1376,14 +1544,42 @@ JL_DLLEXPORT void jl_unlock_value(jl_value_t *v) JL_NOTSAFEPOINT
     JL_UNLOCK_NOGC((jl_mutex_t*)v);
 }
 
+// Dynamic field-name lookups are frequent enough (reflection, serialization
+// frameworks) that the linear scan over the field names shows up in profiles.
+// Cache recent (type, name) -> index resolutions in a small direct-mapped
+// table. Entries are hints only: a hit is re-verified against the type's own
+// field names before use, so the unlocked reads and racy writes are benign,
+// and stale pointers to freed types are compared but never dereferenced.
+#define FIELD_INDEX_CACHE_SIZE 512 // entries; must be a power of two
+static struct {
+    jl_datatype_t *type;
+    jl_sym_t *name;
+    uint32_t index;
+} field_index_cache[FIELD_INDEX_CACHE_SIZE];
+
+STATIC_INLINE size_t field_index_cache_slot(jl_datatype_t *t, jl_sym_t *fld) JL_NOTSAFEPOINT
+{
+    uintptr_t h = ((uintptr_t)t >> 4) * 31 + ((uintptr_t)fld >> 4);
+    return h & (FIELD_INDEX_CACHE_SIZE - 1);
+}
+
 JL_DLLEXPORT int jl_field_index(jl_datatype_t *t, jl_sym_t *fld, int err)
 {
+    size_t slot = field_index_cache_slot(t, fld);
+    size_t hint = (field_index_cache[slot].type == t &&
+                   field_index_cache[slot].name == fld) ?
+                  field_index_cache[slot].index : (size_t)-1;
     if (jl_is_namedtuple_type(t)) {
         jl_value_t *ns = jl_tparam0(t);
         if (jl_is_tuple(ns)) {
             size_t i, n = jl_nfields(ns);
+            if (hint < n && jl_get_nth_field(ns, hint) == (jl_value_t*)fld)
+                return (int)hint;
             for (i = 0; i < n; i++) {
                 if (jl_get_nth_field(ns, i) == (jl_value_t*)fld) {
+                    field_index_cache[slot].type = t;
+                    field_index_cache[slot].name = fld;
+                    field_index_cache[slot].index = (uint32_t)i;
                     return (int)i;
                 }
             }
@@ -1392,8 +1588,13 @@ JL_DLLEXPORT int jl_field_index(jl_datatype_t *t, jl_sym_t *fld, int err)
     else {
         jl_svec_t *fn = jl_field_names(t);
         size_t i, n = jl_svec_len(fn);
+        if (hint < n && jl_svecref(fn, hint) == (jl_value_t*)fld)
+            return (int)hint;
         for (i = 0; i < n; i++) {
             if (jl_svecref(fn, i) == (jl_value_t*)fld) {
+                field_index_cache[slot].type = t;
+                field_index_cache[slot].name = fld;
+                field_index_cache[slot].index = (uint32_t)i;
                 return (int)i;
             }
         }
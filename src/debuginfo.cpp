@@ -31,8 +31,10 @@ using namespace llvm;
 #endif
 #include "processor.h"
 
+#include <atomic>
 #include <string>
 #include <map>
+#include <tuple>
 #include <vector>
 #include <set>
 #include "julia_assert.h"
@@ -49,10 +51,14 @@ typedef object::SymbolRef SymRef;
 // Certain functions in this file might be called from an unmanaged thread
 // and cannot have any interaction with the julia runtime
 static uv_rwlock_t threadsafe;
+static uv_mutex_t in_flight_lock;
+static uv_mutex_t objfilemap_lock;
 
 void jl_init_debuginfo(void)
 {
     uv_rwlock_init(&threadsafe);
+    uv_mutex_init(&in_flight_lock);
+    uv_mutex_init(&objfilemap_lock);
 }
 
 extern "C" JL_DLLEXPORT void jl_lock_profile_impl(void)
@@ -98,6 +104,8 @@ struct ObjectInfo {
 // Maintain a mapping of unrealized function names -> linfo objects
 // so that when we see it get emitted, we can add a link back to the linfo
 // that it came from (providing name, type signature, file info, etc.)
+// Guarded by `in_flight_lock`: entries are consumed lazily on the first
+// lookup, which may run on a different thread than the compilation.
 static StringMap<jl_code_instance_t*> codeinst_in_flight;
 static std::string mangle(StringRef Name, const DataLayout &DL)
 {
@@ -110,7 +118,10 @@ static std::string mangle(StringRef Name, const DataLayout &DL)
 }
 void jl_add_code_in_flight(StringRef name, jl_code_instance_t *codeinst, const DataLayout &DL)
 {
-    codeinst_in_flight[mangle(name, DL)] = codeinst;
+    std::string mangled = mangle(name, DL);
+    uv_mutex_lock(&in_flight_lock);
+    codeinst_in_flight[mangled] = codeinst;
+    uv_mutex_unlock(&in_flight_lock);
 }
 
 
@@ -177,17 +188,205 @@ struct revcomp {
     { return lhs>rhs; }
 };
 
+// A flat, sorted copy of the JIT object map, republished under a seqlock
+// whenever the map changes. Address-to-object resolution runs on every frame
+// of every backtrace and, with a sampling profiler, thousands of times per
+// second; reading a snapshot validated by a sequence counter keeps those
+// lookups off the `threadsafe` lock entirely so they cannot contend with
+// compilation. Writers only run while holding the write lock.
+struct ObjectIndexEntry {
+    uint64_t addr;
+    size_t size;
+    ptrdiff_t slide;
+    const object::ObjectFile *object;
+    DIContext *context;
+    object::SectionRef section;
+};
+static std::atomic<uint32_t> objindex_seq{0};
+static std::atomic<ObjectIndexEntry*> objindex_data{nullptr};
+static std::atomic<size_t> objindex_len{0};
+static size_t objindex_cap = 0; // accessed by writers only
+
+// Rebuild and publish the flat index. The caller must hold the `threadsafe`
+// write lock.
+static void jl_rebuild_objindex(std::map<size_t, ObjectInfo, revcomp> &objmap) JL_NOTSAFEPOINT
+{
+    size_t n = objmap.size();
+    ObjectIndexEntry *data = objindex_data.load(std::memory_order_relaxed);
+    if (n > objindex_cap) {
+        size_t newcap = objindex_cap ? objindex_cap * 2 : 64;
+        while (newcap < n)
+            newcap *= 2;
+        // The previous array is deliberately not freed: a reader may still
+        // be scanning it and there is no grace period to wait out. Capacity
+        // doubling bounds the total leak to about twice the final size.
+        data = (ObjectIndexEntry*)malloc_s(newcap * sizeof(ObjectIndexEntry));
+        objindex_cap = newcap;
+    }
+    uint32_t seq = objindex_seq.load(std::memory_order_relaxed);
+    objindex_seq.store(seq + 1, std::memory_order_relaxed); // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    size_t i = 0;
+    for (auto &it : objmap) { // map order is descending, like the searches below
+        data[i].addr = it.first;
+        data[i].size = it.second.SectionSize;
+        data[i].slide = it.second.slide;
+        data[i].object = it.second.object;
+        data[i].context = it.second.context;
+        data[i].section = it.second.Section;
+        i++;
+    }
+    objindex_data.store(data, std::memory_order_relaxed);
+    objindex_len.store(n, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    objindex_seq.store(seq + 2, std::memory_order_relaxed);
+}
+
+// Per-thread direct-mapped cache of recently resolved frames, so a profiler
+// sampling the same hot addresses does not even touch the shared snapshot on
+// repeat frames. Entries are validated against the index generation, which
+// also invalidates them whenever a context pointer is (re)published.
+struct jit_frame_cache_entry {
+    uint64_t addr;
+    uint32_t seq;
+    ObjectIndexEntry val;
+};
+static const size_t n_frame_cache = 32;
+static thread_local jit_frame_cache_entry jit_frame_cache[n_frame_cache];
+
+static bool jl_lookup_objindex(uint64_t addr, ObjectIndexEntry *out) JL_NOTSAFEPOINT
+{
+    uint32_t seq0 = objindex_seq.load(std::memory_order_acquire);
+    jit_frame_cache_entry &cached = jit_frame_cache[(addr >> 4) % n_frame_cache];
+    if (cached.addr == addr && cached.seq == seq0 && !(seq0 & 1)) {
+        *out = cached.val;
+        return true;
+    }
+    for (;;) {
+        if (seq0 & 1) { // write in progress; reload
+            seq0 = objindex_seq.load(std::memory_order_acquire);
+            continue;
+        }
+        ObjectIndexEntry *data = objindex_data.load(std::memory_order_relaxed);
+        size_t n = objindex_len.load(std::memory_order_relaxed);
+        bool found = false;
+        ObjectIndexEntry tmp = {};
+        // first entry (in descending order) with entry.addr <= addr
+        size_t lo = 0, hi = n;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (data[mid].addr > addr)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < n && addr < data[lo].addr + data[lo].size) {
+            tmp = data[lo];
+            found = true;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t seq1 = objindex_seq.load(std::memory_order_relaxed);
+        if (seq1 == seq0) {
+            if (found) {
+                cached.addr = addr;
+                cached.seq = seq0;
+                cached.val = tmp;
+                *out = tmp;
+            }
+            return found;
+        }
+        seq0 = seq1;
+    }
+}
+
 class JuliaJITEventListener: public JITEventListener
 {
     std::map<size_t, ObjectInfo, revcomp> objectmap;
     std::map<size_t, std::pair<size_t, jl_method_instance_t *>, revcomp> linfomap;
 
+    // Objects whose symbol tables have not been parsed yet. Emission only
+    // pushes a stub here (lock-free, no symbol walk, no `threadsafe` lock):
+    // compilations are constant during warmup while backtraces are rare, so
+    // the parsing cost is paid on the first lookup instead.
+    struct PendingObj {
+        PendingObj *next;
+        const object::ObjectFile *debugObj;
+        // section name -> load address; the loaded object and its
+        // LoadedObjectInfo are gone by the time we parse the symbols
+        StringMap<uint64_t> loadAddrs;
+    };
+    std::atomic<PendingObj*> pending_objs{nullptr};
+
+    void materializeObject(PendingObj *pending) JL_NOTSAFEPOINT
+    {
+        const object::ObjectFile &debugObj = *pending->debugObj;
+        object::section_iterator EndSection = debugObj.section_end();
+        auto symbols = object::computeSymbolSizes(debugObj);
+        bool first = true;
+        for (const auto &sym_size : symbols) {
+            const object::SymbolRef &sym_iter = sym_size.first;
+            object::SymbolRef::Type SymbolType = cantFail(sym_iter.getType());
+            if (SymbolType != object::SymbolRef::ST_Function) continue;
+            uint64_t Addr = cantFail(sym_iter.getAddress());
+            auto Section = cantFail(sym_iter.getSection());
+            if (Section == EndSection) continue;
+            if (!Section->isText()) continue;
+            uint64_t SectionAddr = Section->getAddress();
+            StringRef secName = cantFail(Section->getName());
+            auto load_it = pending->loadAddrs.find(secName);
+            uint64_t SectionLoadAddr = load_it == pending->loadAddrs.end() ?
+                0 : load_it->second;
+            Addr -= SectionAddr - SectionLoadAddr;
+            StringRef sName = cantFail(sym_iter.getName());
+            uint64_t SectionSize = Section->getSize();
+            size_t Size = sym_size.second;
+            jl_code_instance_t *codeinst = NULL;
+            uv_mutex_lock(&in_flight_lock);
+            StringMap<jl_code_instance_t*>::iterator codeinst_it = codeinst_in_flight.find(sName);
+            if (codeinst_it != codeinst_in_flight.end()) {
+                codeinst = codeinst_it->second;
+                codeinst_in_flight.erase(codeinst_it);
+            }
+            uv_mutex_unlock(&in_flight_lock);
+            jl_profile_atomic([&]() {
+                if (codeinst)
+                    linfomap[Addr] = std::make_pair(Size, codeinst->def);
+                if (first) {
+                    ObjectInfo tmp = {&debugObj,
+                        (size_t)SectionSize,
+                        (ptrdiff_t)(SectionAddr - SectionLoadAddr),
+                        *Section,
+                        nullptr,
+                        };
+                    objectmap[SectionLoadAddr] = tmp;
+                    jl_rebuild_objindex(objectmap);
+                    first = false;
+                }
+            });
+        }
+    }
+
 public:
     JuliaJITEventListener(){}
     virtual ~JuliaJITEventListener() {}
 
+    // Parse and register any objects whose registration was deferred at
+    // emission. Must not be called with the `threadsafe` lock held or from
+    // a signal handler (it allocates and takes the write lock).
+    void materializePending() JL_NOTSAFEPOINT
+    {
+        PendingObj *head = pending_objs.exchange(nullptr, std::memory_order_acquire);
+        while (head) {
+            PendingObj *next = head->next;
+            materializeObject(head);
+            delete head;
+            head = next;
+        }
+    }
+
     jl_method_instance_t *lookupLinfo(size_t pointer) JL_NOTSAFEPOINT
     {
+        materializePending();
         uv_rwlock_rdlock(&threadsafe);
         auto region = linfomap.lower_bound(pointer);
         jl_method_instance_t *linfo = NULL;
@@ -352,6 +551,10 @@ public:
 #endif // defined(_OS_X86_64_)
 #endif // defined(_OS_WINDOWS_)
 
+#if defined(_OS_WINDOWS_)
+        // The function tables must be registered (and `__UnwindData` above
+        // written through the writable mapping, which only exists during
+        // emission) before this code can run, so registration stays eager.
         auto symbols = object::computeSymbolSizes(debugObj);
         bool first = true;
         for (const auto &sym_size : symbols) {
@@ -369,7 +572,6 @@ public:
             StringRef sName = cantFail(sym_iter.getName());
             uint64_t SectionSize = Section->getSize();
             size_t Size = sym_size.second;
-#if defined(_OS_WINDOWS_)
             if (SectionAddrCheck)
                 assert(SectionAddrCheck == SectionAddr &&
                        SectionLoadCheck == SectionLoadAddr);
@@ -378,13 +580,14 @@ public:
             create_PRUNTIME_FUNCTION(
                    (uint8_t*)(uintptr_t)Addr, (size_t)Size, sName,
                    (uint8_t*)(uintptr_t)SectionLoadAddr, (size_t)SectionSize, UnwindData);
-#endif
-            StringMap<jl_code_instance_t*>::iterator codeinst_it = codeinst_in_flight.find(sName);
             jl_code_instance_t *codeinst = NULL;
+            uv_mutex_lock(&in_flight_lock);
+            StringMap<jl_code_instance_t*>::iterator codeinst_it = codeinst_in_flight.find(sName);
             if (codeinst_it != codeinst_in_flight.end()) {
                 codeinst = codeinst_it->second;
                 codeinst_in_flight.erase(codeinst_it);
             }
+            uv_mutex_unlock(&in_flight_lock);
             jl_profile_atomic([&]() {
                 if (codeinst)
                     linfomap[Addr] = std::make_pair(Size, codeinst->def);
@@ -396,13 +599,51 @@ public:
                         nullptr,
                         };
                     objectmap[SectionLoadAddr] = tmp;
+                    jl_rebuild_objindex(objectmap);
                     first = false;
                 }
             });
         }
+#else
+        // Elsewhere nothing in the symbol table is needed until the first
+        // backtrace: record an address-range stub on the lock-free pending
+        // list and let `materializePending` parse it on the first lookup.
+        (void)EndSection;
+        (void)getLoadAddress;
+        PendingObj *pending = new PendingObj{nullptr, &debugObj, StringMap<uint64_t>()};
+        for (auto &entry : loadedSections)
+            pending->loadAddrs[entry.getKey()] = L.getSectionLoadAddress(entry.getValue());
+        PendingObj *head = pending_objs.load(std::memory_order_relaxed);
+        do {
+            pending->next = head;
+        } while (!pending_objs.compare_exchange_weak(head, pending,
+                                                     std::memory_order_release));
+#endif
         jl_gc_safe_leave(ptls, gc_state);
     }
 
+    // Emission notification for the JITLink object layer (see
+    // JLDebuginfoPlugin in jitlayers.cpp): `debugObj` is a copy of the input
+    // object and `loadAddrs` maps its section names to their final load
+    // addresses. Takes the same deferred-parse path as the RTDyld
+    // notification above; Windows and 32-bit ARM need the eager registration
+    // work of the RTDyld path and never get here.
+    void _NotifyJITLinkEmitted(std::unique_ptr<object::ObjectFile> debugObj,
+                               std::unique_ptr<MemoryBuffer> buffer,
+                               StringMap<uint64_t> &&loadAddrs)
+    {
+        // both leak by design, same as the RTDyld path: registered objects
+        // are never freed
+        buffer.release();
+        PendingObj *pending = new PendingObj{nullptr, debugObj.release(),
+                                             std::move(loadAddrs)};
+        PendingObj *head = pending_objs.load(std::memory_order_relaxed);
+        do {
+            pending->next = head;
+        } while (!pending_objs.compare_exchange_weak(head, pending,
+                                                     std::memory_order_release));
+    }
+
     // must implement if we ever start freeing code
     // virtual void NotifyFreeingObject(const ObjectImage &Object) {}
     // virtual void NotifyFreeingObject(const object::ObjectFile &Obj) {}
@@ -421,6 +662,16 @@ JL_DLLEXPORT void ORCNotifyObjectEmitted(JITEventListener *Listener,
     ((JuliaJITEventListener*)Listener)->_NotifyObjectEmitted(Object, L, memmgr);
 }
 
+JL_DLLEXPORT void ORCNotifyJITLinkEmitted(JITEventListener *Listener,
+                                          std::unique_ptr<object::ObjectFile> DebugObj,
+                                          std::unique_ptr<MemoryBuffer> DebugObjBuffer,
+                                          StringMap<uint64_t> SectionLoadAddresses)
+{
+    ((JuliaJITEventListener*)Listener)->_NotifyJITLinkEmitted(
+            std::move(DebugObj), std::move(DebugObjBuffer),
+            std::move(SectionLoadAddresses));
+}
+
 // TODO: convert the safe names from aotcomile.cpp:makeSafeName back into symbols
 static std::pair<char *, bool> jl_demangle(const char *name) JL_NOTSAFEPOINT
 {
@@ -461,6 +712,43 @@ JITEventListener *CreateJuliaJITEventListener(void)
     return jl_jit_events;
 }
 
+// Memoization for the DWARF line-table queries below: symbolizing a profile
+// looks up the same hot addresses thousands of times, and each evaluation of
+// the line program is costly, so repeated queries resolve to a map lookup
+// instead. Contexts are never freed once registered (see objfilemap and the
+// JIT event listener), so the keys cannot dangle. Guarded by `threadsafe`
+// held for writing, which the queries require anyway since DWARFContext
+// updates internal tables.
+typedef std::tuple<DIContext*, uint64_t, uint64_t> lineinfo_key_t;
+static std::map<lineinfo_key_t, DIInliningInfo> inlining_info_cache;
+static std::map<lineinfo_key_t, DILineInfo> line_info_cache;
+
+static DIInliningInfo getInliningInfoCached(DIContext *context, object::SectionedAddress addr,
+                                            DILineInfoSpecifier infoSpec) JL_NOTSAFEPOINT
+{
+    uv_rwlock_wrlock(&threadsafe);
+    lineinfo_key_t key{context, addr.SectionIndex, addr.Address};
+    auto it = inlining_info_cache.find(key);
+    if (it == inlining_info_cache.end())
+        it = inlining_info_cache.emplace(key, context->getInliningInfoForAddress(addr, infoSpec)).first;
+    DIInliningInfo inlineInfo = it->second;
+    uv_rwlock_wrunlock(&threadsafe);
+    return inlineInfo;
+}
+
+static DILineInfo getLineInfoCached(DIContext *context, object::SectionedAddress addr,
+                                    DILineInfoSpecifier infoSpec) JL_NOTSAFEPOINT
+{
+    uv_rwlock_wrlock(&threadsafe);
+    lineinfo_key_t key{context, addr.SectionIndex, addr.Address};
+    auto it = line_info_cache.find(key);
+    if (it == line_info_cache.end())
+        it = line_info_cache.emplace(key, context->getLineInfoForAddress(addr, infoSpec)).first;
+    DILineInfo info = it->second;
+    uv_rwlock_wrunlock(&threadsafe);
+    return info;
+}
+
 // *frames is a one element array containing whatever we could come up
 // with for the current frame. here we'll try to expand it using debug info
 // func_name and file_name are either NULL or malloc'd pointers
@@ -493,11 +781,7 @@ static int lookup_pointer(
     DILineInfoSpecifier infoSpec(DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath,
                                  DILineInfoSpecifier::FunctionNameKind::ShortName);
 
-    // DWARFContext/DWARFUnit update some internal tables during these queries, so
-    // a lock is needed.
-    uv_rwlock_wrlock(&threadsafe);
-    auto inlineInfo = context->getInliningInfoForAddress(makeAddress(Section, pointer + slide), infoSpec);
-    uv_rwlock_wrunlock(&threadsafe);
+    auto inlineInfo = getInliningInfoCached(context, makeAddress(Section, pointer + slide), infoSpec);
 
     int fromC = (*frames)[0].fromC;
     int n_frames = inlineInfo.getNumberOfFrames();
@@ -520,9 +804,7 @@ static int lookup_pointer(
             info = inlineInfo.getFrame(i);
         }
         else {
-            uv_rwlock_wrlock(&threadsafe);
-            info = context->getLineInfoForAddress(makeAddress(Section, pointer + slide), infoSpec);
-            uv_rwlock_wrunlock(&threadsafe);
+            info = getLineInfoCached(context, makeAddress(Section, pointer + slide), infoSpec);
         }
 
         jl_frame_t *frame = &(*frames)[i];
@@ -571,6 +853,8 @@ typedef struct {
     DIContext *ctx;
     int64_t slide;
 } objfileentry_t;
+// Guarded by `objfilemap_lock`. Entries are never removed, and std::map
+// nodes are stable, so a reference into the map remains valid once taken.
 typedef std::map<uint64_t, objfileentry_t, revcomp> obfiletype;
 static obfiletype objfilemap;
 
@@ -829,7 +1113,9 @@ static void get_function_name_and_base(llvm::object::SectionRef Section, size_t
 #endif
 }
 
-static objfileentry_t &find_object_file(uint64_t fbase, StringRef fname) JL_NOTSAFEPOINT
+// Read debuginfo for one object file from disk into `entry`. This does file
+// I/O and must not be called with any of the debuginfo locks held.
+static void resolve_object_file(uint64_t fbase, StringRef fname, objfileentry_t &entry) JL_NOTSAFEPOINT
 {
     int isdarwin = 0, islinux = 0, iswindows = 0;
 #if defined(_OS_DARWIN_)
@@ -841,14 +1127,6 @@ static objfileentry_t &find_object_file(uint64_t fbase, StringRef fname) JL_NOTS
 #endif
     (void)iswindows;
 
-// GOAL: Read debuginfo from file
-    // TODO: need read/write lock here for objfilemap synchronization
-    obfiletype::iterator it = objfilemap.find(fbase);
-    if (it != objfilemap.end())
-        // Return cached value
-        return it->second;
-    auto &entry = objfilemap[fbase]; // default initialized
-
 // GOAL: Assign errorobj
     StringRef objpath;
     std::string debuginfopath;
@@ -863,7 +1141,7 @@ static objfileentry_t &find_object_file(uint64_t fbase, StringRef fname) JL_NOTS
         auto origerrorobj = llvm::object::ObjectFile::createObjectFile(
             membuf->getMemBufferRef(), file_magic::unknown);
         if (!origerrorobj)
-            return entry;
+            return;
 
         llvm::object::MachOObjectFile *morigobj = (llvm::object::MachOObjectFile*)
             origerrorobj.get().get();
@@ -871,7 +1149,7 @@ static objfileentry_t &find_object_file(uint64_t fbase, StringRef fname) JL_NOTS
         // First find the uuid of the object file (we'll use this to make sure we find the
         // correct debug symbol file).
         if (!getObjUUID(morigobj, uuid))
-            return entry;
+            return;
 
         // On macOS, debug symbols are not contained in the dynamic library.
         // Use DBGCopyFullDSYMURLForUUID from the private DebugSymbols framework
@@ -998,7 +1276,7 @@ static objfileentry_t &find_object_file(uint64_t fbase, StringRef fname) JL_NOTS
             // verify the UUID matches
             if (!getObjUUID((llvm::object::MachOObjectFile*)debugobj, uuid2) ||
                     memcmp(uuid, uuid2, sizeof(uuid)) != 0) {
-                return entry;
+                return;
             }
         }
 
@@ -1023,6 +1301,41 @@ static objfileentry_t &find_object_file(uint64_t fbase, StringRef fname) JL_NOTS
         //       jl_error might run into the same error again...
         ignoreError(errorobj);
     }
+}
+
+static objfileentry_t &find_object_file(uint64_t fbase, StringRef fname) JL_NOTSAFEPOINT
+{
+    // Recently resolved libraries, cached per thread so that symbolizing many
+    // frames from the same library skips the lock. References into the map
+    // stay valid forever (see `objfilemap`), so cached entries never expire.
+    struct dylib_cache_entry {
+        uint64_t fbase;
+        objfileentry_t *entry;
+    };
+    static const size_t n_dylib_cache = 32;
+    static thread_local dylib_cache_entry dylib_cache[n_dylib_cache];
+    dylib_cache_entry &cached = dylib_cache[(fbase >> 12) % n_dylib_cache];
+    if (cached.entry && cached.fbase == fbase)
+        return *cached.entry;
+
+    uv_mutex_lock(&objfilemap_lock);
+    obfiletype::iterator it = objfilemap.find(fbase);
+    if (it == objfilemap.end()) {
+        // Resolution reads files from disk; drop the lock while doing so and
+        // insert the result afterwards. If another thread resolved the same
+        // library concurrently, keep the first entry (ours is leaked, but the
+        // race is rare and the underlying object memory is held for the
+        // lifetime of the process anyway).
+        uv_mutex_unlock(&objfilemap_lock);
+        objfileentry_t resolved = {};
+        resolve_object_file(fbase, fname, resolved);
+        uv_mutex_lock(&objfilemap_lock);
+        it = objfilemap.insert(std::make_pair(fbase, resolved)).first;
+    }
+    objfileentry_t &entry = it->second;
+    uv_mutex_unlock(&objfilemap_lock);
+    cached.fbase = fbase;
+    cached.entry = &entry;
     return entry;
 }
 
@@ -1184,25 +1497,32 @@ static int jl_getDylibFunctionInfo(jl_frame_t **frames, size_t pointer, int skip
 int jl_DI_for_fptr(uint64_t fptr, uint64_t *symsize, int64_t *slide,
         object::SectionRef *Section, llvm::DIContext **context) JL_NOTSAFEPOINT
 {
-    int found = 0;
-    uv_rwlock_wrlock(&threadsafe);
-    std::map<size_t, ObjectInfo, revcomp> &objmap = jl_jit_events->getObjectMap();
-    std::map<size_t, ObjectInfo, revcomp>::iterator fit = objmap.lower_bound(fptr);
-
+    jl_jit_events->materializePending();
     if (symsize)
         *symsize = 0;
-    if (fit != objmap.end() && fptr < fit->first + fit->second.SectionSize) {
-        *slide = fit->second.slide;
-        *Section = fit->second.Section;
-        if (context) {
-            if (fit->second.context == nullptr)
-                fit->second.context = DWARFContext::create(*fit->second.object).release();
-            *context = fit->second.context;
+    ObjectIndexEntry entry;
+    if (!jl_lookup_objindex(fptr, &entry))
+        return 0;
+    *slide = entry.slide;
+    *Section = entry.section;
+    if (context) {
+        if (entry.context == nullptr) {
+            // create the DWARF context under the write lock, then republish
+            // the index so later lookups stay lock-free
+            uv_rwlock_wrlock(&threadsafe);
+            std::map<size_t, ObjectInfo, revcomp> &objmap = jl_jit_events->getObjectMap();
+            auto fit = objmap.find(entry.addr);
+            if (fit != objmap.end()) {
+                if (fit->second.context == nullptr)
+                    fit->second.context = DWARFContext::create(*fit->second.object).release();
+                entry.context = fit->second.context;
+                jl_rebuild_objindex(objmap);
+            }
+            uv_rwlock_wrunlock(&threadsafe);
         }
-        found = 1;
+        *context = entry.context;
     }
-    uv_rwlock_wrunlock(&threadsafe);
-    return found;
+    return 1;
 }
 
 // Set *name and *filename to either NULL or malloc'd string
@@ -1650,13 +1970,9 @@ extern "C" JL_DLLEXPORT
 uint64_t jl_getUnwindInfo_impl(uint64_t dwAddr)
 {
     // Might be called from unmanaged thread
-    uv_rwlock_rdlock(&threadsafe);
-    std::map<size_t, ObjectInfo, revcomp> &objmap = jl_jit_events->getObjectMap();
-    std::map<size_t, ObjectInfo, revcomp>::iterator it = objmap.lower_bound(dwAddr);
-    uint64_t ipstart = 0; // ip of the start of the section (if found)
-    if (it != objmap.end() && dwAddr < it->first + it->second.SectionSize) {
-        ipstart = (uint64_t)(uintptr_t)(*it).first;
-    }
-    uv_rwlock_rdunlock(&threadsafe);
-    return ipstart;
+    jl_jit_events->materializePending();
+    ObjectIndexEntry entry;
+    if (jl_lookup_objindex(dwAddr, &entry))
+        return entry.addr; // ip of the start of the section
+    return 0;
 }
@@ -145,10 +145,106 @@ JL_DLLEXPORT int jl_dlclose(void *handle) JL_NOTSAFEPOINT
 #endif
 }
 
+/*
+  persistent path-resolution cache: probing a library means trying every
+  DL_LOAD_PATH directory and extension variant, and most attempts miss; on
+  networked storage each miss is a filesystem round trip. When
+  JULIA_DLOPEN_CACHE names a file, remember where each library was last found
+  and try that candidate first in later processes. Entries are verified with
+  one stat before use and self-correct: a stale entry just falls back to the
+  full probe, which then appends a fresh line.
+*/
+static htable_t dlcache_table;   // jl_sym_t *modname -> char *path
+static const char *dlcache_file;
+static int dlcache_initialized;
+static _Atomic(int) dlcache_lock;
+
+static void dlcache_acquire(void)
+{
+    int expected = 0;
+    while (!jl_atomic_cmpswap(&dlcache_lock, &expected, 1)) {
+        expected = 0;
+        jl_cpu_pause();
+    }
+}
+
+static void dlcache_release(void)
+{
+    jl_atomic_store_release(&dlcache_lock, 0);
+}
+
+// called with the lock held
+static void dlcache_init(void)
+{
+    dlcache_initialized = 1;
+    dlcache_file = getenv(DLOPEN_CACHE_NAME);
+    if (dlcache_file == NULL)
+        return;
+    htable_new(&dlcache_table, 0);
+    ios_t f;
+    if (ios_file(&f, dlcache_file, 1, 0, 0, 0) == NULL)
+        return;
+    char *line;
+    while ((line = ios_readline(&f)) != NULL) {
+        if (line[0] == '\0') {
+            free(line);
+            break;
+        }
+        char *tab = strchr(line, '\t');
+        char *nl = strchr(line, '\n');
+        if (tab != NULL && nl != NULL && nl > tab) {
+            // later lines override earlier ones, so re-resolves win
+            *tab = '\0';
+            *nl = '\0';
+            ptrhash_put(&dlcache_table, jl_symbol(line), strdup(tab + 1));
+        }
+        free(line);
+    }
+    ios_close(&f);
+}
+
+static void *dlcache_lookup(const char *modname, unsigned flags, jl_sym_t **keyp)
+{
+    uv_stat_t stbuf;
+    dlcache_acquire();
+    if (!dlcache_initialized)
+        dlcache_init();
+    char *cached = NULL;
+    if (dlcache_file != NULL) {
+        *keyp = jl_symbol(modname);
+        cached = (char*)ptrhash_get(&dlcache_table, *keyp);
+    }
+    dlcache_release();
+    if (cached == NULL || cached == HT_NOTFOUND)
+        return NULL;
+    if (jl_stat(cached, (char*)&stbuf) != 0)
+        return NULL;
+    return jl_dlopen(cached, flags);
+}
+
+static void dlcache_record(jl_sym_t *key, const char *modname, const char *path)
+{
+    dlcache_acquire();
+    void **bp = ptrhash_bp(&dlcache_table, key);
+    if (*bp == HT_NOTFOUND || strcmp((char*)*bp, path) != 0) {
+        // replaced entries are not freed: lookups hand out the pointer
+        // without copying, and re-resolves are rare
+        *bp = strdup(path);
+        ios_t f;
+        if (ios_file(&f, dlcache_file, 0, 1, 1, 0) != NULL) {
+            ios_seek_end(&f);
+            ios_printf(&f, "%s\t%s\n", modname, path);
+            ios_close(&f);
+        }
+    }
+    dlcache_release();
+}
+
 JL_DLLEXPORT void *jl_load_dynamic_library(const char *modname, unsigned flags, int throw_err)
 {
     char path[PATHBUF], relocated[PATHBUF];
     int i;
+    jl_sym_t *cachekey = NULL;
 #ifdef _OS_WINDOWS_
     int err;
 #endif
@@ -205,6 +301,10 @@ JL_DLLEXPORT void *jl_load_dynamic_library(const char *modname, unsigned flags,
       such as Windows, so we emulate them here.
     */
     if (!abspath && !is_atpath && jl_base_module != NULL) {
+        // try wherever this library was found last time first
+        handle = dlcache_lookup(modname, flags, &cachekey);
+        if (handle)
+            goto done;
         jl_binding_t *b = jl_get_module_binding(jl_base_module, jl_symbol("DL_LOAD_PATH"));
         jl_array_t *DL_LOAD_PATH = (jl_array_t*)(b ? jl_atomic_load_relaxed(&b->value) : NULL);
         if (DL_LOAD_PATH != NULL) {
@@ -234,8 +334,11 @@ JL_DLLEXPORT void *jl_load_dynamic_library(const char *modname, unsigned flags,
                     if (i == 0) { // LoadLibrary already tested the extensions, we just need to check the `stat` result
 #endif
                         handle = jl_dlopen(path, flags);
-                        if (handle)
+                        if (handle) {
+                            if (cachekey != NULL)
+                                dlcache_record(cachekey, modname, path);
                             goto done;
+                        }
 #ifdef _OS_WINDOWS_
                         err = GetLastError();
                     }
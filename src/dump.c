@@ -5,16 +5,22 @@
 */
 #include <stdlib.h>
 #include <string.h>
+#include <zlib.h>
 
 #include "julia.h"
 #include "julia_internal.h"
 #include "julia_gcext.h"
 #include "builtin_proto.h"
 #include "serialize.h"
+#include "processor.h"
 
 #ifndef _OS_WINDOWS_
 #include <dlfcn.h>
 #endif
+#ifdef _OS_LINUX_
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
 
 #include "valgrind.h"
 #include "julia_assert.h"
@@ -63,9 +69,28 @@ static jl_array_t *serializer_worklist JL_GLOBALLY_ROOTED;
 // inverse of backedges tree
 htable_t edges_map;
 
+// Scratch-table cardinality recorded by the previous jl_save_incremental in
+// this process. A save that follows another (precompile workers reused for
+// several packages) presizes its tables to the prior final size in one
+// allocation each, instead of rediscovering it through a dozen rehashes and
+// reallocs interleaved with serialization traffic.
+static size_t last_save_backrefs = 0;
+static size_t last_save_edges = 0;
+static size_t last_save_reinits = 0;
+
 // list of requested ccallable signatures
 static arraylist_t ccallable_list;
 
+// native code being saved alongside the .ji (set by jl_write_compiler_output
+// for --output-o --incremental); the serializer records each code instance's
+// fvar ids in the shard's function table
+void *jl_incremental_native_code = NULL;
+
+// restore side of the shard: the function table of <cachefile>.so if present,
+// and (codeinst, func_id, specfunc_id) triples collected while deserializing
+static jl_sysimg_fptrs_t shard_fptrs;
+static arraylist_t shard_fptr_list;
+
 typedef struct {
     ios_t *s;
     jl_ptls_t ptls;
@@ -341,6 +366,13 @@ static void jl_serialize_module(jl_serializer_state *s, jl_module_t *m)
     write_int8(s->s, 0);
     jl_serialize_value(s, m->parent);
     void **table = m->bindings.table;
+    // record the binding count so restoration can size the table up front
+    size_t nbindings = 0;
+    for (i = 0; i < m->bindings.size; i += 2) {
+        if (table[i+1] != HT_NOTFOUND)
+            nbindings++;
+    }
+    write_int32(s->s, nbindings);
     for (i = 0; i < m->bindings.size; i += 2) {
         if (table[i+1] != HT_NOTFOUND) {
             jl_serialize_value(s, (jl_value_t*)table[i]);
@@ -483,6 +515,13 @@ static void jl_serialize_code_instance(jl_serializer_state *s, jl_code_instance_
 
     write_uint8(s->s, TAG_CODE_INSTANCE);
     write_uint8(s->s, flags);
+    // fvar ids in the native code shard saved alongside this .ji
+    // (0 if there is no shard or no code was generated for this entry)
+    int32_t func_id = 0, specfunc_id = 0;
+    if (jl_incremental_native_code)
+        jl_get_function_id(jl_incremental_native_code, codeinst, &func_id, &specfunc_id);
+    write_int32(s->s, func_id);
+    write_int32(s->s, specfunc_id);
     jl_serialize_value(s, (jl_value_t*)codeinst->def);
     if (write_ret_type) {
         jl_serialize_value(s, codeinst->inferred);
@@ -503,6 +542,22 @@ enum METHOD_SERIALIZATION_MODE {
     METHOD_EXTERNAL_MT = 2,
 };
 
+// minimum run length before a TAG_ISBITS_BLOCK pays for its type reference
+#define ISBITS_BLOCK_MIN_LEN 8
+
+// Whether boxes of this type hold nothing but their element bytes, so a run
+// of them can be written as one raw block and restored with jl_new_bits.
+// Symbols and strings are variable-sized and have their own encodings, and
+// Ptr values must take the usual path so they are reset to C_NULL.
+static int isbits_block_eltype(jl_datatype_t *t) JL_NOTSAFEPOINT
+{
+    return jl_is_datatype(t) && !t->name->mutabl &&
+           t->layout && t->layout->npointers == 0 &&
+           jl_datatype_size(t) > 0 &&
+           !jl_is_cpointer_type((jl_value_t*)t) &&
+           t != jl_symbol_type && t != jl_string_type;
+}
+
 static void jl_serialize_value_(jl_serializer_state *s, jl_value_t *v, int as_literal) JL_GC_DISABLED
 {
     if (jl_serialize_generic(s, v)) {
@@ -556,6 +611,36 @@ static void jl_serialize_value_(jl_serializer_state *s, jl_value_t *v, int as_li
         if (ar->flags.ptrarray) {
             for (i = 0; i < l; i++) {
                 jl_value_t *e = jl_array_ptr_ref(v, i);
+                // Runs of boxed isbits values (common in abstractly-typed
+                // containers holding numeric or record data) are emitted as a
+                // single TAG_ISBITS_BLOCK -- one type reference, a count and
+                // the raw element bytes -- instead of one tagged entry per
+                // element. Block elements skip the backref table, so a later
+                // reference to the same box is serialized again; that only
+                // duplicates bytes, which is harmless for isbits values.
+                if (e && isbits_block_eltype((jl_datatype_t*)jl_typeof(e))) {
+                    jl_datatype_t *bt = (jl_datatype_t*)jl_typeof(e);
+                    size_t blocklen = 1;
+                    while (i + blocklen < l) {
+                        jl_value_t *en = jl_array_ptr_ref(v, i + blocklen);
+                        if (en == NULL || jl_typeof(en) != (jl_value_t*)bt)
+                            break;
+                        blocklen++;
+                    }
+                    // worklist types get uniqued while loading, which would
+                    // require retagging every block element; leave those to
+                    // the per-element path
+                    if (blocklen >= ISBITS_BLOCK_MIN_LEN && !type_in_worklist(bt)) {
+                        write_uint8(s->s, TAG_ISBITS_BLOCK);
+                        jl_serialize_value(s, bt);
+                        write_int32(s->s, blocklen);
+                        size_t j, nb = jl_datatype_size(bt);
+                        for (j = 0; j < blocklen; j++)
+                            ios_write(s->s, (char*)jl_data_ptr(jl_array_ptr_ref(v, i + j)), nb);
+                        i += blocklen - 1;
+                        continue;
+                    }
+                }
                 if (e && jl_is_cpointer(e) && jl_unbox_voidpointer(e) != (void*)-1 && jl_unbox_voidpointer(e) != NULL)
                     // reset Ptr elements to C_NULL (but keep MAP_FAILED / INVALID_HANDLE)
                     jl_serialize_cnull(s, jl_typeof(e));
@@ -656,8 +741,18 @@ static void jl_serialize_value_(jl_serializer_state *s, jl_value_t *v, int as_li
         }
         if (!(serialization_mode & METHOD_INTERNAL))
             return;
-        jl_serialize_value(s, m->specializations);
-        jl_serialize_value(s, jl_atomic_load_relaxed(&m->speckeyset));
+        if (m->is_for_opaque_closure) {
+            // specializations of an opaque-closure source are only an
+            // invocation cache (see jl_new_opaque_closure), and their
+            // MethodInstances cannot be serialized; write the cache empty
+            // and let it repopulate on first use after load
+            jl_serialize_value(s, jl_emptysvec);
+            jl_serialize_value(s, jl_an_empty_vec_any);
+        }
+        else {
+            jl_serialize_value(s, m->specializations);
+            jl_serialize_value(s, jl_atomic_load_relaxed(&m->speckeyset));
+        }
         jl_serialize_value(s, (jl_value_t*)m->name);
         jl_serialize_value(s, (jl_value_t*)m->file);
         write_int32(s->s, m->line);
@@ -1108,7 +1203,7 @@ static void write_mod_list(ios_t *s, jl_array_t *a)
 }
 
 // "magic" string and version header of .ji file
-static const int JI_FORMAT_VERSION = 11;
+static const int JI_FORMAT_VERSION = 14;
 static const char JI_MAGIC[] = "\373jli\r\n\032\n"; // based on PNG signature
 static const uint16_t BOM = 0xFEFF; // byte-order marker
 static void write_header(ios_t *s)
@@ -1441,6 +1536,21 @@ static jl_value_t *jl_deserialize_value_array(jl_serializer_state *s, uint8_t ta
         jl_value_t **data = (jl_value_t**)jl_array_data(a);
         size_t i, numel = jl_array_len(a);
         for (i = 0; i < numel; i++) {
+            if (ios_peekc(s->s) == TAG_ISBITS_BLOCK) {
+                // a run of same-typed isbits elements stored as raw bytes
+                read_uint8(s->s);
+                jl_datatype_t *bt = (jl_datatype_t*)jl_deserialize_value(s, NULL);
+                size_t j, blocklen = (uint32_t)read_int32(s->s);
+                size_t nb = jl_datatype_size(bt);
+                char *tmp = (char*)alloca(nb);
+                assert(i + blocklen <= numel);
+                for (j = 0; j < blocklen; j++) {
+                    ios_readall(s->s, tmp, nb);
+                    data[i + j] = jl_new_bits((jl_value_t*)bt, tmp);
+                }
+                i += blocklen - 1;
+                continue;
+            }
             data[i] = jl_deserialize_value(s, &data[i]);
             //if (data[i]) // not needed because `a` is new (gc is disabled)
             //    jl_gc_wb(a, data[i]);
@@ -1604,6 +1714,13 @@ static jl_value_t *jl_deserialize_value_code_instance(jl_serializer_state *s, jl
     int flags = read_uint8(s->s);
     int validate = (flags >> 0) & 3;
     int constret = (flags >> 2) & 1;
+    int32_t func_id = read_int32(s->s);
+    int32_t specfunc_id = read_int32(s->s);
+    if (shard_fptrs.base && func_id) {
+        arraylist_push(&shard_fptr_list, codeinst);
+        arraylist_push(&shard_fptr_list, (void*)(intptr_t)func_id);
+        arraylist_push(&shard_fptr_list, (void*)(intptr_t)specfunc_id);
+    }
     codeinst->def = (jl_method_instance_t*)jl_deserialize_value(s, (jl_value_t**)&codeinst->def);
     jl_gc_wb(codeinst, codeinst->def);
     codeinst->inferred = jl_deserialize_value(s, &codeinst->inferred);
@@ -1646,6 +1763,9 @@ static jl_value_t *jl_deserialize_value_module(jl_serializer_state *s) JL_GC_DIS
     m->parent = (jl_module_t*)jl_deserialize_value(s, (jl_value_t**)&m->parent);
     jl_gc_wb(m, m->parent);
 
+    // one rehash up front instead of incremental growth while the binding
+    // stream below is replayed
+    jl_module_presize_bindings(m, read_int32(s->s));
     while (1) {
         jl_sym_t *asname = (jl_sym_t*)jl_deserialize_value(s, NULL);
         if (asname == NULL)
@@ -1731,16 +1851,16 @@ static void jl_deserialize_struct(jl_serializer_state *s, jl_value_t *v) JL_GC_D
         ios_readall(s->s, start, data - start);
     if (dt == jl_typemap_entry_type) {
         jl_typemap_entry_t *entry = (jl_typemap_entry_t*)v;
-        if (entry->max_world == ~(size_t)0) {
-            if (entry->min_world > 1) {
+        if (jl_atomic_load_relaxed(&entry->max_world) == ~(size_t)0) {
+            if (jl_atomic_load_relaxed(&entry->min_world) > 1) {
                 // update world validity to reflect current state of the counter
-                entry->min_world = jl_atomic_load_acquire(&jl_world_counter);
+                jl_atomic_store_relaxed(&entry->min_world, jl_atomic_load_acquire(&jl_world_counter));
             }
         }
         else {
             // garbage entry - delete it :(
-            entry->min_world = 1;
-            entry->max_world = 0;
+            jl_atomic_store_relaxed(&entry->min_world, 1);
+            jl_atomic_store_relaxed(&entry->max_world, 0);
         }
     }
 }
@@ -1959,6 +2079,9 @@ static jl_value_t *jl_deserialize_value(jl_serializer_state *s, jl_value_t **loc
 static void jl_insert_methods(jl_array_t *list)
 {
     size_t i, l = jl_array_len(list);
+    // nothing runs at the new worlds until deserialization finishes, so the
+    // per-method invalidation passes can be batched into one
+    jl_method_table_batch_begin();
     for (i = 0; i < l; i += 2) {
         jl_method_t *meth = (jl_method_t*)jl_array_ptr_ref(list, i);
         assert(!meth->is_for_opaque_closure);
@@ -1968,6 +2091,7 @@ static void jl_insert_methods(jl_array_t *list)
         assert((jl_value_t*)mt != jl_nothing);
         jl_method_table_insert(mt, meth, simpletype);
     }
+    jl_method_table_batch_end();
 }
 
 // verify that these edges intersect with the same methods as before
@@ -1996,7 +2120,12 @@ static void jl_verify_edges(jl_array_t *targets, jl_array_t **pvalids)
         size_t max_valid = ~(size_t)0;
         int ambig = 0;
         // TODO: possibly need to included ambiguities too (for the optimizer correctness)?
-        jl_value_t *matches = jl_matching_methods((jl_tupletype_t*)sig, jl_nothing, -1, 0, jl_atomic_load_acquire(&jl_world_counter), &min_valid, &max_valid, &ambig);
+        // any result with more matches than were recorded is invalid anyway,
+        // so bound the search by the recorded count and let it bail out early
+        // (a capped search returning jl_false is handled below like a length
+        // mismatch)
+        int lim = (int)jl_array_len(expected);
+        jl_value_t *matches = jl_matching_methods((jl_tupletype_t*)sig, jl_nothing, lim, 0, jl_atomic_load_acquire(&jl_world_counter), &min_valid, &max_valid, &ambig);
         if (matches == jl_false || jl_array_len(matches) != jl_array_len(expected)) {
             valid = 0;
         }
@@ -2150,6 +2279,149 @@ JL_DLLEXPORT int jl_read_verify_header(ios_t *s)
             readstr_verify(s, jl_git_commit()) && !read_uint8(s));
 }
 
+// Fast dependency freshness check, available to Base ahead of its per-file
+// stale-cache scan. Returns 1 when every source file recorded in the cache
+// file's dependency list still matches its recorded mtime, 0 when one is
+// missing or changed, and -1 when the cache file cannot be opened or parsed
+// (the caller falls back to its own scan). Verdicts are memoized for the
+// process keyed by the cache file's own mtime, so after the first check a
+// single stat of the .ji answers repeat queries; a cold check issues the
+// per-file stats as one jl_stat_many batch instead of a blocking stat per
+// dependency, which is where loading many packages over NFS spends its time.
+
+static uint64_t depverify_hash(uintptr_t key)
+{
+    return memhash_fast((const char*)key, strlen((const char*)key));
+}
+
+static int depverify_eq(void *ka, void *kb)
+{
+    return strcmp((const char*)ka, (const char*)kb) == 0;
+}
+
+#include "support/htable.inc"
+HTIMPL(depverify, depverify_hash, depverify_eq)
+
+typedef struct {
+    double ji_mtime; // cache file mtime when the verdict was computed
+    int valid;
+} jl_depverify_t;
+
+static htable_t depverify_cache;
+static jl_mutex_t depverify_lock;
+
+static double depverify_stat_mtime(const char *statbuf) JL_NOTSAFEPOINT
+{
+    const uv_stat_t *st = (const uv_stat_t*)statbuf;
+    return (double)st->st_mtim.tv_sec + 1e-9 * (double)st->st_mtim.tv_nsec;
+}
+
+JL_DLLEXPORT int jl_verify_cache_deps(const char *cachefile)
+{
+    uv_stat_t ji_st;
+    if (jl_stat(cachefile, (char*)&ji_st) != 0)
+        return -1;
+    double ji_mtime = depverify_stat_mtime((char*)&ji_st);
+
+    JL_LOCK_NOGC(&depverify_lock);
+    if (depverify_cache.size == 0)
+        htable_new(&depverify_cache, 0);
+    jl_depverify_t *ent = (jl_depverify_t*)depverify_get(&depverify_cache, (void*)cachefile);
+    if (ent != HT_NOTFOUND && ent->ji_mtime == ji_mtime) {
+        int valid = ent->valid;
+        JL_UNLOCK_NOGC(&depverify_lock);
+        return valid;
+    }
+    JL_UNLOCK_NOGC(&depverify_lock);
+
+    int result = -1;
+    size_t i;
+    // entries are a recorded mtime followed by the nul-terminated path
+    arraylist_t deps;
+    arraylist_new(&deps, 0);
+    ios_t f;
+    if (ios_file(&f, cachefile, 1, 0, 0, 0) == NULL)
+        return -1;
+    if (!jl_read_verify_header(&f))
+        goto done;
+    { // skip the mod list
+        size_t len;
+        while ((len = read_int32(&f)))
+            ios_skip(&f, len + 3 * sizeof(uint64_t));
+    }
+    if (read_uint64(&f) == 0) { // total size of the dependency section
+        result = 1; // no recorded dependencies
+        goto done;
+    }
+    { // collect (recorded mtime, path) pairs
+        size_t slen;
+        while ((slen = read_int32(&f))) {
+            char *dep = (char*)malloc_s(sizeof(double) + slen + 1);
+            if (ios_read(&f, dep + sizeof(double), slen) != slen) {
+                free(dep);
+                goto done;
+            }
+            dep[sizeof(double) + slen] = '\0';
+            uint64_t mt = read_uint64(&f);
+            memcpy(dep, &mt, sizeof(double));
+            // skip the path of the module this file was included into
+            if (read_int32(&f) != 0) {
+                size_t complen;
+                while ((complen = read_int32(&f)))
+                    ios_skip(&f, complen);
+            }
+            arraylist_push(&deps, dep);
+        }
+    }
+    {
+        size_t n = deps.len;
+        if (n == 0) {
+            result = 1;
+            goto done;
+        }
+        const char **paths = (const char**)malloc_s(n * sizeof(char*));
+        char *statbufs = (char*)malloc_s(n * sizeof(uv_stat_t));
+        int32_t *rets = (int32_t*)malloc_s(n * sizeof(int32_t));
+        for (i = 0; i < n; i++)
+            paths[i] = (char*)deps.items[i] + sizeof(double);
+        jl_stat_many((int)n, paths, statbufs, rets);
+        result = 1;
+        for (i = 0; i < n; i++) {
+            double rec;
+            memcpy(&rec, deps.items[i], sizeof(double));
+            double now = rets[i] == 0 ?
+                depverify_stat_mtime(statbufs + i * sizeof(uv_stat_t)) : -1;
+            // same tolerance as Base's stale check: identical, or recorded
+            // ahead by under a microsecond (filesystems truncate timestamps)
+            if (rets[i] != 0 || !(now == rec || (rec - now > 0 && rec - now < 1e-6))) {
+                result = 0;
+                break;
+            }
+        }
+        free(paths);
+        free(statbufs);
+        free(rets);
+    }
+done:
+    ios_close(&f);
+    for (i = 0; i < deps.len; i++)
+        free(deps.items[i]);
+    arraylist_free(&deps);
+    if (result >= 0) {
+        JL_LOCK_NOGC(&depverify_lock);
+        ent = (jl_depverify_t*)depverify_get(&depverify_cache, (void*)cachefile);
+        if (ent == HT_NOTFOUND) {
+            ent = (jl_depverify_t*)malloc_s(sizeof(jl_depverify_t));
+            void **bp = depverify_bp(&depverify_cache, strdup(cachefile));
+            *bp = ent;
+        }
+        ent->ji_mtime = ji_mtime;
+        ent->valid = result;
+        JL_UNLOCK_NOGC(&depverify_lock);
+    }
+    return result;
+}
+
 static void jl_finalize_serializer(jl_serializer_state *s)
 {
     size_t i, l;
@@ -2178,6 +2450,20 @@ static void jl_reinit_item(jl_value_t *v, int how, arraylist_t *tracee_list)
         switch (how) {
             case 1: { // rehash IdDict
                 jl_array_t **a = (jl_array_t**)v;
+                jl_value_t *old = ((jl_value_t**)v)[3];
+                if (old != jl_nothing && jl_is_array(old)) {
+                    // finish an in-progress incremental resize so only the
+                    // current table needs rehashing (object ids are fresh
+                    // in this process, so rehash below re-disperses all keys)
+                    size_t i, l = jl_array_len(old);
+                    jl_value_t **ol = (jl_value_t**)((jl_array_t*)old)->data;
+                    for (i = 0; i < l; i += 2) {
+                        if (ol[i + 1] != NULL)
+                            *a = jl_eqtable_put(*a, ol[i], ol[i + 1], NULL);
+                    }
+                    ((jl_value_t**)v)[3] = jl_nothing;
+                    ((intptr_t*)v)[4] = 0;
+                }
                 // Assume *a don't need a write barrier
                 *a = jl_idtable_rehash(*a, jl_array_len(*a));
                 jl_gc_wb(v, *a);
@@ -2256,6 +2542,56 @@ JL_DLLEXPORT void jl_init_restored_modules(jl_array_t *init_order)
 
 // --- entry points ---
 
+// deflate/inflate filters for ios_layer: the serialized module graph in a
+// .ji file is streamed through zlib with a bounded staging buffer, so the
+// serializer never holds more than one buffer of compressed data in memory.
+// The plaintext header (work list, dependencies, preferences, module list)
+// and the trailing source-text section are not compressed: Base reads those
+// directly when checking cache staleness.
+typedef struct {
+    z_stream z;
+    char buf[IOS_BUFSIZE]; // staging between zlib and the underlying stream
+} jl_ji_zfilter_t;
+
+static int ji_deflate_write(ios_t *to, const char *data, size_t n, int finish, void *state)
+{
+    jl_ji_zfilter_t *zf = (jl_ji_zfilter_t*)state;
+    zf->z.next_in = (Bytef*)data;
+    zf->z.avail_in = n;
+    int ret = Z_OK;
+    do {
+        zf->z.next_out = (Bytef*)zf->buf;
+        zf->z.avail_out = sizeof(zf->buf);
+        ret = deflate(&zf->z, finish ? Z_FINISH : Z_NO_FLUSH);
+        if (ret == Z_STREAM_ERROR)
+            return -1;
+        size_t have = sizeof(zf->buf) - zf->z.avail_out;
+        if (have && ios_write(to, zf->buf, have) != have)
+            return -1;
+    } while (zf->z.avail_in != 0 || (finish && ret != Z_STREAM_END));
+    return 0;
+}
+
+static size_t ji_inflate_read(ios_t *from, char *dest, size_t n, void *state)
+{
+    jl_ji_zfilter_t *zf = (jl_ji_zfilter_t*)state;
+    zf->z.next_out = (Bytef*)dest;
+    zf->z.avail_out = n;
+    while (zf->z.avail_out != 0) {
+        if (zf->z.avail_in == 0) {
+            size_t got = ios_read(from, zf->buf, sizeof(zf->buf));
+            if (got == 0)
+                break;
+            zf->z.next_in = (Bytef*)zf->buf;
+            zf->z.avail_in = got;
+        }
+        int ret = inflate(&zf->z, Z_NO_FLUSH);
+        if (ret != Z_OK)
+            break; // end of stream, or corrupt data (caught by the decoder)
+    }
+    return n - zf->z.avail_out;
+}
+
 JL_DLLEXPORT int jl_save_incremental(const char *fname, jl_array_t *worklist)
 {
     JL_TIMING(SAVE_MODULE);
@@ -2265,6 +2601,8 @@ JL_DLLEXPORT int jl_save_incremental(const char *fname, jl_array_t *worklist)
         jl_printf(JL_STDERR, "Cannot open cache file \"%s\" for writing.\n", fname);
         return 1;
     }
+    // batch the serializer's buffer-sized writes into gathered writev calls
+    ios_gather_mode(&f, 1);
     JL_GC_PUSH2(&mod_array, &udeps);
     mod_array = jl_get_loaded_modules();
 
@@ -2279,9 +2617,22 @@ JL_DLLEXPORT int jl_save_incremental(const char *fname, jl_array_t *worklist)
     // best to keep it early (before any actual initialization)
     write_mod_list(&f, mod_array);
 
-    arraylist_new(&reinit_list, 0);
-    htable_new(&edges_map, 0);
-    htable_new(&backref_table, 5000);
+    // everything between here and the source-text section is streamed
+    // through a compressing layer with bounded buffering
+    jl_ji_zfilter_t *zout = (jl_ji_zfilter_t*)malloc_s(sizeof(jl_ji_zfilter_t));
+    memset(&zout->z, 0, sizeof(zout->z));
+    if (deflateInit(&zout->z, Z_DEFAULT_COMPRESSION) != Z_OK) {
+        free(zout);
+        ios_close(&f);
+        JL_GC_POP();
+        jl_error("failed to initialize compression for cache file");
+    }
+    ios_t fz;
+    ios_layer(&fz, &f, NULL, ji_deflate_write, zout);
+
+    arraylist_new(&reinit_list, last_save_reinits);
+    htable_new(&edges_map, last_save_edges);
+    htable_new(&backref_table, last_save_backrefs > 5000 ? last_save_backrefs : 5000);
     ptrhash_put(&backref_table, jl_main_module, (char*)HT_NOTFOUND + 1);
     backref_table_numel = 1;
     jl_idtable_type = jl_base_module ? jl_get_global(jl_base_module, jl_symbol("IdDict")) : NULL;
@@ -2313,7 +2664,7 @@ JL_DLLEXPORT int jl_save_incremental(const char *fname, jl_array_t *worklist)
     jl_collect_backedges(edges, targets);
 
     jl_serializer_state s = {
-        &f,
+        &fz,
         jl_current_task->ptls,
         mod_array
     };
@@ -2324,7 +2675,18 @@ JL_DLLEXPORT int jl_save_incremental(const char *fname, jl_array_t *worklist)
     jl_finalize_serializer(&s);
     serializer_worklist = NULL;
 
+    ios_close(&fz); // flushes the remaining deflate output into f
+    deflateEnd(&zout->z);
+    free(zout);
+
     jl_gc_enable(en);
+    last_save_backrefs = backref_table_numel;
+    // htable_new scales a cardinality hint up to the slot count, so record
+    // the hint that reproduces the final capacity
+    last_save_edges = edges_map.size / 4;
+    last_save_reinits = reinit_list.len;
+    // reset to the inline size: nothing lingers in the worker's heap
+    // between saves, and the next save presizes from the counts above
     htable_reset(&edges_map, 0);
     htable_reset(&backref_table, 0);
     arraylist_free(&reinit_list);
@@ -2622,6 +2984,55 @@ static int trace_method(jl_typemap_entry_t *entry, void *closure)
     return 1;
 }
 
+// if a native code shard was linked next to the cache file (from the object
+// file that jl_write_compiler_output emits for --output-o --incremental),
+// open it and locate its function table
+static void jl_open_native_shard(const char *fname)
+{
+    memset(&shard_fptrs, 0, sizeof(shard_fptrs));
+    size_t len = strlen(fname);
+    char *path = (char*)malloc_s(len + 4);
+    strcpy(path, fname);
+    if (len > 3 && strcmp(&path[len - 3], ".ji") == 0)
+        len -= 3;
+    strcpy(&path[len], ".so");
+    void *handle = jl_dlopen(path, JL_RTLD_LOCAL | JL_RTLD_LAZY);
+    free(path);
+    if (handle == NULL)
+        return;
+    shard_fptrs = jl_init_processor_sysimg(handle);
+    if (shard_fptrs.nclones != 0) {
+        // a multiversioned shard would need the clone merge done by
+        // jl_update_all_fptrs in staticdata.c; package shards are expected
+        // to be built for a single target
+        jl_printf(JL_STDERR, "WARNING: ignoring multi-target native code shard\n");
+        memset(&shard_fptrs, 0, sizeof(shard_fptrs));
+    }
+}
+
+// install the shard's function pointers into the restored code instances,
+// mirroring what jl_update_all_fptrs in staticdata.c does for the sysimage
+static void jl_wire_native_shard(void)
+{
+    size_t i;
+    for (i = 0; i < shard_fptr_list.len; i += 3) {
+        jl_code_instance_t *codeinst = (jl_code_instance_t*)shard_fptr_list.items[i];
+        int32_t func_id = (int32_t)(intptr_t)shard_fptr_list.items[i + 1];
+        int32_t specfunc_id = (int32_t)(intptr_t)shard_fptr_list.items[i + 2];
+        if (specfunc_id > 0) {
+            codeinst->specptr.fptr = (void*)(shard_fptrs.base + shard_fptrs.offsets[specfunc_id - 1]);
+            codeinst->isspecsig = 1; // TODO: set only if confirmed to be true
+        }
+        if (func_id == -1)
+            codeinst->invoke = jl_fptr_args;
+        else if (func_id == -2)
+            codeinst->invoke = jl_fptr_sparam;
+        else if (func_id > 0)
+            codeinst->invoke = (jl_callptr_t)(uintptr_t)(shard_fptrs.base + shard_fptrs.offsets[func_id - 1]);
+    }
+    memset(&shard_fptrs, 0, sizeof(shard_fptrs));
+}
+
 static jl_value_t *_jl_restore_incremental(ios_t *f, jl_array_t *mod_array)
 {
     JL_TIMING(LOAD_MODULE);
@@ -2654,6 +3065,19 @@ static jl_value_t *_jl_restore_incremental(ios_t *f, jl_array_t *mod_array)
         return verify_fail;
     }
 
+    // the serialized module graph below this point is deflate-compressed;
+    // inflate it on the fly with bounded buffering
+    jl_ji_zfilter_t *zin = (jl_ji_zfilter_t*)malloc_s(sizeof(jl_ji_zfilter_t));
+    memset(&zin->z, 0, sizeof(zin->z));
+    if (inflateInit(&zin->z) != Z_OK) {
+        free(zin);
+        ios_close(f);
+        return jl_get_exceptionf(jl_errorexception_type,
+                "Failed to initialize decompression for precompile file.");
+    }
+    ios_t fz;
+    ios_layer(&fz, f, ji_inflate_read, NULL, zin);
+
     // prepare to deserialize
     int en = jl_gc_enable(0);
     jl_gc_enable_finalizers(ct, 0);
@@ -2664,10 +3088,11 @@ static jl_value_t *_jl_restore_incremental(ios_t *f, jl_array_t *mod_array)
     arraylist_new(&flagref_list, 0);
     htable_new(&new_code_instance_validate, 0);
     arraylist_new(&ccallable_list, 0);
+    arraylist_new(&shard_fptr_list, 0);
     htable_new(&uniquing_table, 0);
 
     jl_serializer_state s = {
-        f,
+        &fz,
         ct->ptls,
         mod_array
     };
@@ -2692,6 +3117,9 @@ static jl_value_t *_jl_restore_incremental(ios_t *f, jl_array_t *mod_array)
     jl_recache_other(); // make all of the other objects identities correct (needs to be after insert methods)
     htable_free(&uniquing_table);
     jl_array_t *init_order = jl_finalize_deserializer(&s, tracee_list); // done with f and s (needs to be after recache)
+    ios_close(&fz);
+    inflateEnd(&zin->z);
+    free(zin);
     if (init_order == NULL)
         init_order = (jl_array_t*)jl_an_empty_vec_any;
     assert(jl_isa((jl_value_t*)init_order, jl_array_any_type));
@@ -2704,6 +3132,10 @@ static jl_value_t *_jl_restore_incremental(ios_t *f, jl_array_t *mod_array)
     // check new CodeInstances and validate any that lack external backedges
     validate_new_code_instances();
 
+    // install cached native code from the package's shard, if one was found
+    jl_wire_native_shard();
+    arraylist_free(&shard_fptr_list);
+
     serializer_worklist = NULL;
     htable_free(&new_code_instance_validate);
     arraylist_free(&flagref_list);
@@ -2738,16 +3170,31 @@ JL_DLLEXPORT jl_value_t *jl_restore_incremental_from_buf(const char *buf, size_t
 {
     ios_t f;
     ios_static_buffer(&f, (char*)buf, sz);
+    memset(&shard_fptrs, 0, sizeof(shard_fptrs)); // no path, so no shard
     return _jl_restore_incremental(&f, mod_array);
 }
 
 JL_DLLEXPORT jl_value_t *jl_restore_incremental(const char *fname, jl_array_t *mod_array)
 {
     ios_t f;
-    if (ios_file(&f, fname, 1, 0, 0, 0) == NULL) {
+    // map the cache file so deserialization reads straight from the page
+    // cache instead of copying through a stream buffer
+    if (ios_file_mmap(&f, fname) == NULL) {
         return jl_get_exceptionf(jl_errorexception_type,
             "Cache file \"%s\" not found.\n", fname);
     }
+#if defined(_OS_LINUX_)
+    // ask the kernel to read the rest of the file in the background while we
+    // deserialize the front, instead of stalling on each page fault or
+    // buffer refill
+    if (f.fd == -1)
+        posix_madvise(f.buf, (size_t)f.maxsize, POSIX_MADV_WILLNEED);
+#if defined(POSIX_FADV_WILLNEED)
+    else
+        posix_fadvise(f.fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+#endif
+    jl_open_native_shard(fname);
     return _jl_restore_incremental(&f, mod_array);
 }
 
@@ -322,7 +322,7 @@ static uintptr_t bounded_hash(fl_context_t *fl_ctx, value_t a, int bound, int *o
     case TAG_CVALUE:
         cv = (cvalue_t*)ptr(a);
         data = cv_data(cv);
-        return memhash((char*)data, cv_len(cv));
+        return memhash_fast((char*)data, cv_len(cv));
 
     case TAG_VECTOR:
         if (bound <= 0) {
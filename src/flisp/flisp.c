@@ -240,7 +240,7 @@ static symbol_t *mk_symbol(const char *str)
     }
     sym->type = NULL;
     sym->dlcache = NULL;
-    sym->hash = memhash32(str, len)^0xAAAAAAAA;
+    sym->hash = memhash32_fast(str, len)^0xAAAAAAAA;
     strcpy(&sym->name[0], str);
     return sym;
 }
@@ -13,8 +13,16 @@ enum {
 // an ordinary symbol character unless it's the first character.
 static inline int symchar(char c)
 {
-    static const char *special = "()[]'\";`,\\| \f\n\r\t\v";
-    return !strchr(special, c);
+    // table form of strchr("()[]'\";`,\\| \f\n\r\t\v", c): one load per byte
+    // instead of a strchr call in the lexer's innermost loop. '\0' is not a
+    // symbol character (strchr matches the terminator); bytes >= 0x80 (UTF-8
+    // sequences inside symbols) are.
+    static const unsigned char non_symchar[256] = {
+        [0]=1, ['(']=1, [')']=1, ['[']=1, [']']=1, ['\'']=1, ['"']=1,
+        [';']=1, ['`']=1, [',']=1, ['\\']=1, ['|']=1, [' ']=1, ['\f']=1,
+        ['\n']=1, ['\r']=1, ['\t']=1, ['\v']=1,
+    };
+    return !non_symchar[(unsigned char)c];
 }
 
 // like strtoull, but accepts "0b" prefix for base 2 and "0o" prefix for base 8
@@ -165,12 +173,27 @@ static void accumchar(fl_context_t *fl_ctx, char c, int *pi)
 static int read_token(fl_context_t *fl_ctx, char c, int digits)
 {
     int i=0, ch, escaped=0, issym=0, nc=0;
+    ios_t *f = readF(fl_ctx);
 
     while (1) {
         if (nc != 0) {
             if (nc != 1)
-                (void)ios_getc(readF(fl_ctx)); // consume ch
-            ch = ios_peekc(readF(fl_ctx));
+                (void)ios_getc(f); // consume ch
+            // batch plain token characters straight out of the stream
+            // buffer (cf. nextchar); symbol characters never include '\n',
+            // so this cannot skip line accounting. Escapes, delimiters and
+            // buffer refills drop through to the general path below.
+            if (!escaped) {
+                while (f->bpos < f->size) {
+                    char b = f->buf[f->bpos];
+                    if (!symchar(b) || (digits && !isdigit((unsigned char)b)))
+                        break;
+                    accumchar(fl_ctx, b, &i);
+                    f->bpos++;
+                    nc++;
+                }
+            }
+            ch = ios_peekc(f);
             if (ch == IOS_EOF)
                 goto terminate;
             c = (char)ch;
@@ -196,7 +219,7 @@ static int read_token(fl_context_t *fl_ctx, char c, int digits)
         nc++;
     }
     if (nc == 0)
-        ios_skip(readF(fl_ctx), -1); // rewind stream for the caller, to prepare for throwing an error
+        ios_skip(f, -1); // rewind stream for the caller, to prepare for throwing an error
  terminate:
     fl_ctx->readbuf[i++] = '\0';
     return issym;
@@ -478,6 +501,30 @@ static value_t read_string(fl_context_t *fl_ctx)
             }
             buf = temp;
         }
+        // bulk-copy plain bytes straight from the stream buffer: everything
+        // up to the closing quote or the next escape needs no per-byte
+        // processing, and data-heavy literals are almost entirely such runs
+        ios_t *f = readF(fl_ctx);
+        if (f->bpos < f->size) {
+            const char *start = &f->buf[f->bpos];
+            size_t avail = f->size - f->bpos;
+            if (avail > sz-4 - i)  // the loop above re-grows as needed
+                avail = sz-4 - i;
+            size_t n = 0;
+            while (n < avail && start[n] != '"' && start[n] != '\\')
+                n++;
+            if (n > 0) {
+                memcpy(&buf[i], start, n);
+                i += n;
+                f->bpos += n;
+                // ios_getc counts newlines; keep lineno in step
+                for (j = 0; j < n; j++) {
+                    if (start[j] == '\n')
+                        f->lineno++;
+                }
+                continue;
+            }
+        }
         c = ios_getc(readF(fl_ctx));
         if (c == IOS_EOF) {
             free(buf);
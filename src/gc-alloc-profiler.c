@@ -0,0 +1,111 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+#include "gc-alloc-profiler.h"
+#include "julia_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Deeper frames are truncated; this matches the depth the time profiler
+// typically records and keeps the stack footprint of a sample bounded.
+#define GC_ALLOC_PROFILE_MAXFRAMES 256
+
+typedef struct {
+    uintptr_t *data; // sample records, layout in gc-alloc-profiler.h
+    size_t len;      // in words
+    size_t cap;      // in words
+    size_t countdown; // bytes left until the next sample on this thread
+} gc_alloc_profile_buf_t;
+
+_Atomic(int) gc_alloc_profile_enabled = 0;
+static size_t gc_alloc_profile_sample_bytes = 0;
+// One buffer per thread, indexed by tid. Each buffer is written only by its
+// owning thread while the profiler runs and read only while it is stopped.
+static gc_alloc_profile_buf_t *gc_alloc_profile_bufs = NULL;
+static int gc_alloc_profile_nbufs = 0;
+
+JL_DLLEXPORT int jl_gc_alloc_profile_start(size_t sample_bytes)
+{
+    if (jl_atomic_load_relaxed(&gc_alloc_profile_enabled) || sample_bytes == 0)
+        return -1;
+    if (gc_alloc_profile_bufs == NULL) {
+        gc_alloc_profile_bufs = (gc_alloc_profile_buf_t*)calloc(
+            jl_n_threads, sizeof(gc_alloc_profile_buf_t));
+        if (gc_alloc_profile_bufs == NULL)
+            return -1;
+        gc_alloc_profile_nbufs = jl_n_threads;
+    }
+    gc_alloc_profile_sample_bytes = sample_bytes;
+    for (int i = 0; i < gc_alloc_profile_nbufs; i++)
+        gc_alloc_profile_bufs[i].countdown = sample_bytes;
+    jl_atomic_store_release(&gc_alloc_profile_enabled, 1);
+    return 0;
+}
+
+JL_DLLEXPORT void jl_gc_alloc_profile_stop(void)
+{
+    jl_atomic_store_release(&gc_alloc_profile_enabled, 0);
+}
+
+JL_DLLEXPORT uint8_t *jl_gc_alloc_profile_get_data(int tid, size_t *len)
+{
+    if (tid < 0 || tid >= gc_alloc_profile_nbufs) {
+        *len = 0;
+        return NULL;
+    }
+    gc_alloc_profile_buf_t *buf = &gc_alloc_profile_bufs[tid];
+    *len = buf->len * sizeof(uintptr_t);
+    return (uint8_t*)buf->data;
+}
+
+JL_DLLEXPORT void jl_gc_alloc_profile_clear(void)
+{
+    if (jl_atomic_load_relaxed(&gc_alloc_profile_enabled))
+        return;
+    for (int i = 0; i < gc_alloc_profile_nbufs; i++) {
+        free(gc_alloc_profile_bufs[i].data);
+        gc_alloc_profile_bufs[i].data = NULL;
+        gc_alloc_profile_bufs[i].len = 0;
+        gc_alloc_profile_bufs[i].cap = 0;
+    }
+}
+
+// Slow path of `gc_alloc_profile_maybe_sample`: charge `sz` against the
+// per-thread countdown and record a sample when it runs out. Must not
+// allocate GC memory since it runs inside the allocator.
+void gc_alloc_profile_record(jl_ptls_t ptls, size_t sz)
+{
+    int16_t tid = ptls->tid;
+    if (tid < 0 || tid >= gc_alloc_profile_nbufs)
+        return; // internal GC threads don't allocate Julia objects
+    gc_alloc_profile_buf_t *buf = &gc_alloc_profile_bufs[tid];
+    if (buf->countdown > sz) {
+        buf->countdown -= sz;
+        return;
+    }
+    buf->countdown = gc_alloc_profile_sample_bytes;
+    jl_bt_element_t frames[GC_ALLOC_PROFILE_MAXFRAMES];
+    // skip this function and the allocation entry point that called it
+    size_t nframes = rec_backtrace(frames, GC_ALLOC_PROFILE_MAXFRAMES, 2);
+    size_t need = buf->len + 2 + nframes;
+    if (need > buf->cap) {
+        size_t newcap = buf->cap ? buf->cap * 2 : 4096;
+        while (newcap < need)
+            newcap *= 2;
+        uintptr_t *newdata = (uintptr_t*)realloc(buf->data,
+                                                 newcap * sizeof(uintptr_t));
+        if (newdata == NULL)
+            return; // drop the sample rather than the process
+        buf->data = newdata;
+        buf->cap = newcap;
+    }
+    buf->data[buf->len++] = sz;
+    buf->data[buf->len++] = nframes;
+    memcpy(&buf->data[buf->len], frames, nframes * sizeof(jl_bt_element_t));
+    buf->len += nframes;
+}
+
+#ifdef __cplusplus
+}
+#endif
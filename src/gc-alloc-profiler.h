@@ -0,0 +1,48 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+#ifndef JL_GC_ALLOC_PROFILER_H
+#define JL_GC_ALLOC_PROFILER_H
+
+#include "julia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sampling allocation profiler. When running, the GC allocation entry
+// points take a statistical sample (a backtrace plus the requested size)
+// roughly every `sample_bytes` allocated bytes on each thread. Samples are
+// appended to a per-thread buffer that is written only by the owning
+// thread, so recording needs no synchronization.
+//
+// Each sample record in the buffer is a sequence of word-sized slots:
+//   [0]    allocation size in bytes
+//   [1]    number of backtrace entries that follow
+//   [2...] the backtrace (`jl_bt_element_t` words, see julia_internal.h)
+
+// Start sampling every `sample_bytes` allocated bytes per thread.
+// Returns 0 on success, -1 if the profiler is already running or the
+// buffers could not be allocated.
+JL_DLLEXPORT int jl_gc_alloc_profile_start(size_t sample_bytes);
+JL_DLLEXPORT void jl_gc_alloc_profile_stop(void);
+// Return the sample buffer of thread `tid` and its size in bytes.
+// Only valid while the profiler is stopped, until the next start or clear.
+JL_DLLEXPORT uint8_t *jl_gc_alloc_profile_get_data(int tid, size_t *len);
+JL_DLLEXPORT void jl_gc_alloc_profile_clear(void);
+
+// GC-internal entry points
+extern _Atomic(int) gc_alloc_profile_enabled;
+void gc_alloc_profile_record(jl_ptls_t ptls, size_t sz) JL_NOTSAFEPOINT;
+
+STATIC_INLINE void gc_alloc_profile_maybe_sample(jl_ptls_t ptls,
+                                                 size_t sz) JL_NOTSAFEPOINT
+{
+    if (__unlikely(jl_atomic_load_relaxed(&gc_alloc_profile_enabled)))
+        gc_alloc_profile_record(ptls, sz);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
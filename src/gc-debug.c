@@ -557,17 +557,22 @@ static void gc_scrub_range(char *low, char *high)
         // Make sure the sweep rebuild the freelist
         pg->has_marked = 1;
         pg->has_young = 1;
-        // Find the age bit
+        // Find the age field
         char *page_begin = gc_page_data(tag) + GC_PAGE_OFFSET;
         int obj_id = (((char*)tag) - page_begin) / osize;
-        uint8_t *ages = pg->ages + obj_id / 8;
+        uint8_t *ages = pg->ages + obj_id / 4;
         // Force this to be a young object to save some memory
         // (especially on 32bit where it's more likely to have pointer-like
         //  bit patterns)
-        *ages &= ~(1 << (obj_id % 8));
+        *ages &= ~(3 << ((obj_id % 4) * 2));
         memset(tag, 0xff, osize);
         // set mark to GC_MARKED (young and marked)
         tag->bits.gc = GC_MARKED;
+        // mirror the mark into the page's side bitmap, as gc_setmark_pool_
+        // does; the sweep consults only the bitmap and would otherwise link
+        // the scrubbed object onto the freelist
+        jl_atomic_fetch_or_relaxed((_Atomic(uint32_t)*)&pg->markbits[obj_id / 32],
+                                   (uint32_t)1 << (obj_id % 32));
     }
     jl_set_safe_restore(old_buf);
 }
@@ -21,21 +21,99 @@ extern "C" {
 static int block_pg_cnt = DEFAULT_BLOCK_PG_ALLOC;
 static size_t current_pg_count = 0;
 
+// Lazy page return (`JULIA_GC_LAZY_PAGE_RETURN=<MB>`). Freed pages are
+// normally decommitted eagerly, which makes allocation-heavy workloads pay a
+// soft fault for every page they touch again after a collection. In lazy
+// mode up to the configured amount of freed memory is kept "hot": the pages
+// are only advised with `MADV_FREE` (reclaimable under memory pressure but
+// cheap to reuse) and real decommit happens once the bound is exceeded.
+static size_t lazy_return_max_pg = 0; // bound of hot free pages, 0 = eager
+static size_t lazy_return_pg_count = 0; // current number of hot free pages
+
+#if defined(_OS_LINUX_)
+// Huge page backing (`JULIA_GC_HUGE_PAGES=1|hugetlb`). Pool page blocks
+// are usually several MB, so backing them with 2MB pages cuts the TLB
+// pressure of both the mark loop and pool allocation on large heaps. In
+// the default mode the block is reserved with huge page alignment and the
+// kernel is asked for transparent huge pages; `hugetlb` uses preallocated
+// `MAP_HUGETLB` pages directly and falls back to the transparent mode when
+// the pool is exhausted.
+#define GC_HUGE_PAGE_SZ ((size_t)2 * 1024 * 1024)
+static int huge_page_mode = 0; // 0: off, 1: transparent, 2: hugetlb
+#endif
+
 void jl_gc_init_page(void)
 {
     if (GC_PAGE_SZ * block_pg_cnt < jl_page_size)
         block_pg_cnt = jl_page_size / GC_PAGE_SZ; // exact division
+    char *cp = getenv("JULIA_GC_LAZY_PAGE_RETURN");
+    if (cp)
+        lazy_return_max_pg = strtoul(cp, NULL, 10) * 1024 * 1024 / GC_PAGE_SZ;
+#if defined(_OS_LINUX_)
+    cp = getenv("JULIA_GC_HUGE_PAGES");
+    if (cp) {
+        if (strcmp(cp, "hugetlb") == 0)
+            huge_page_mode = 2;
+        else if (strcmp(cp, "0") != 0)
+            huge_page_mode = 1;
+    }
+#endif
 }
 
 #ifndef MAP_NORESERVE // not defined in POSIX, FreeBSD, etc.
 #define MAP_NORESERVE (0)
 #endif
 
+#if defined(_OS_LINUX_)
+// Map `sz` bytes aligned to (and rounded up to a multiple of) the huge
+// page size so the kernel can back the whole block with 2MB pages.
+// Returns `NULL` on failure.
+static char *jl_gc_try_alloc_pages_huge(size_t sz) JL_NOTSAFEPOINT
+{
+    sz = LLT_ALIGN(sz, GC_HUGE_PAGE_SZ);
+#ifdef MAP_HUGETLB
+    if (huge_page_mode == 2) {
+        char *mem = (char*)mmap(0, sz, PROT_READ | PROT_WRITE,
+                                MAP_NORESERVE | MAP_PRIVATE | MAP_ANONYMOUS |
+                                MAP_HUGETLB, -1, 0);
+        if (mem != MAP_FAILED)
+            return mem;
+        // no preallocated huge pages left: fall back to transparent ones
+    }
+#endif
+    char *mem = (char*)mmap(0, sz + GC_HUGE_PAGE_SZ, PROT_READ | PROT_WRITE,
+                            MAP_NORESERVE | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+        return NULL;
+    // trim the reservation to huge page alignment; an aligned, sized and
+    // advised block is all THP needs to promote it
+    char *aligned = (char*)LLT_ALIGN((uintptr_t)mem, GC_HUGE_PAGE_SZ);
+    if (aligned != mem)
+        munmap(mem, aligned - mem);
+    size_t tail = GC_HUGE_PAGE_SZ - (aligned - mem);
+    if (tail > 0)
+        munmap(aligned + sz, tail);
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, sz, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+#endif
+
 // Try to allocate a memory block for multiple pages
 // Return `NULL` if allocation failed. Result is aligned to `GC_PAGE_SZ`.
 static char *jl_gc_try_alloc_pages(int pg_cnt) JL_NOTSAFEPOINT
 {
     size_t pages_sz = GC_PAGE_SZ * pg_cnt;
+#if defined(_OS_LINUX_)
+    if (huge_page_mode) {
+        // huge page alignment implies `GC_PAGE_SZ` alignment
+        char *mem = jl_gc_try_alloc_pages_huge(pages_sz);
+        if (mem)
+            return mem;
+        // fall through to the plain mapping on failure
+    }
+#endif
 #ifdef _OS_WINDOWS_
     char *mem = (char*)VirtualAlloc(NULL, pages_sz + GC_PAGE_SZ,
                                     MEM_RESERVE, PAGE_READWRITE);
@@ -166,13 +244,12 @@ static jl_gc_pagemeta_t *jl_gc_alloc_new_page(void) JL_NOTSAFEPOINT
     return page_meta;
 }
 
-// get a new page, either from the freemap
-// or from the kernel if none are available
-NOINLINE jl_gc_pagemeta_t *jl_gc_alloc_page(void) JL_NOTSAFEPOINT
+// get a new page from the freemap, or from the kernel if none are available
+// (unless `existing_only` is set, in which case `NULL` is returned instead).
+// Assumes `gc_perm_lock` is acquired.
+static jl_gc_pagemeta_t *jl_gc_alloc_page_nolock(int existing_only) JL_NOTSAFEPOINT
 {
     struct jl_gc_metadata_ext info;
-    uv_mutex_lock(&gc_perm_lock);
-
     int last_errno = errno;
 #ifdef _OS_WINDOWS_
     DWORD last_error = GetLastError();
@@ -219,6 +296,13 @@ NOINLINE jl_gc_pagemeta_t *jl_gc_alloc_page(void) JL_NOTSAFEPOINT
 
     // no existing pages found, allocate a new one
     {
+        if (existing_only) {
+#ifdef _OS_WINDOWS_
+            SetLastError(last_error);
+#endif
+            errno = last_errno;
+            return NULL;
+        }
         jl_gc_pagemeta_t *meta = jl_gc_alloc_new_page();
         info = page_metadata_ext(meta->data);
         assert(meta == info.meta);
@@ -232,6 +316,12 @@ NOINLINE jl_gc_pagemeta_t *jl_gc_alloc_page(void) JL_NOTSAFEPOINT
     }
 
 have_free_page:
+    // assume we just picked up one of the hot pages; the freemap scan is
+    // address ordered rather than LRU so this is only an approximation,
+    // but it keeps the hot pool bounded
+    if (lazy_return_pg_count > 0)
+        lazy_return_pg_count--;
+
     // in-use pages are now ending at min of ub and pagetable_i32
     if (memory_map.ub < info.pagetable_i32)
         memory_map.ub = info.pagetable_i32;
@@ -254,16 +344,53 @@ have_free_page:
 #endif
     errno = last_errno;
     current_pg_count++;
+    gc_phase_stats.pages_allocd++;
     gc_final_count_page(current_pg_count);
-    uv_mutex_unlock(&gc_perm_lock);
     return info.meta;
 }
 
+// get a new page for the current thread, preferably from its local cache.
+// On a cache miss the cache is batch-refilled from the global pagetable so
+// that allocation bursts only take the page manager lock once every
+// `JL_GC_PAGE_CACHE_SZ / 2` pages.
+NOINLINE jl_gc_pagemeta_t *jl_gc_alloc_page(void) JL_NOTSAFEPOINT
+{
+    jl_thread_heap_t *heap = &jl_current_task->ptls->heap;
+    if (heap->page_cache_len > 0)
+        return heap->page_cache[--heap->page_cache_len];
+    uv_mutex_lock(&gc_perm_lock);
+    jl_gc_pagemeta_t *meta = jl_gc_alloc_page_nolock(0);
+    // only refill from pages that already exist; growing the heap for
+    // pages nobody asked for yet would inflate fresh block allocations
+    for (int i = 0; i < JL_GC_PAGE_CACHE_SZ / 2; i++) {
+        jl_gc_pagemeta_t *extra = jl_gc_alloc_page_nolock(1);
+        if (!extra)
+            break;
+        heap->page_cache[heap->page_cache_len++] = extra;
+    }
+    uv_mutex_unlock(&gc_perm_lock);
+    return meta;
+}
+
+// return the pages cached by every thread to the page manager. Cached pages
+// are marked allocated in the pagetable but carry no pool metadata, so they
+// must not survive to the next pagetable sweep. Called with the world
+// stopped before the pool sweep starts.
+void jl_gc_flush_page_caches(void)
+{
+    for (int t_i = 0; t_i < jl_n_threads; t_i++) {
+        jl_thread_heap_t *heap = &jl_all_tls_states[t_i]->heap;
+        while (heap->page_cache_len > 0)
+            jl_gc_free_page(heap->page_cache[--heap->page_cache_len]->data);
+    }
+}
+
 // return a page to the freemap allocator
 void jl_gc_free_page(void *p) JL_NOTSAFEPOINT
 {
     // update the allocmap and freemap to indicate this contains a free entry
     struct jl_gc_metadata_ext info = page_metadata_ext(p);
+    gc_phase_stats.pages_freed++;
     uint32_t msk;
     msk = (uint32_t)(1u << info.pagetable0_i);
     assert(!(info.pagetable0->freemap[info.pagetable0_i32] & msk));
@@ -283,6 +410,8 @@ void jl_gc_free_page(void *p) JL_NOTSAFEPOINT
 
     free(info.meta->ages);
     info.meta->ages = NULL;
+    free(info.meta->markbits);
+    info.meta->markbits = NULL;
 
     // tell the OS we don't need these pages right now
     size_t decommit_size = GC_PAGE_SZ;
@@ -300,6 +429,16 @@ void jl_gc_free_page(void *p) JL_NOTSAFEPOINT
             otherp = (void*)((char*)otherp + GC_PAGE_SZ);
         }
     }
+    if (lazy_return_pg_count + decommit_size / GC_PAGE_SZ <= lazy_return_max_pg) {
+        // keep the page hot; the kernel may still reclaim it under pressure
+        lazy_return_pg_count += decommit_size / GC_PAGE_SZ;
+#ifdef _OS_WINDOWS_
+        VirtualAlloc(p, decommit_size, MEM_RESET, PAGE_READWRITE);
+#elif defined(MADV_FREE)
+        madvise(p, decommit_size, MADV_FREE);
+#endif
+        goto no_decommit;
+    }
 #ifdef _OS_WINDOWS_
     VirtualFree(p, decommit_size, MEM_DECOMMIT);
 #else
@@ -22,9 +22,60 @@
 // number of stacks to always keep available per pool
 #define MIN_STACK_MAPPINGS_PER_POOL 5
 
+// number of stacks to park in the shared cold cache per pool before excess
+// stacks are really unmapped
+#define MAX_COLD_STACKS_PER_POOL 16
+
 const size_t jl_guard_size = (4096 * 8);
 static _Atomic(uint32_t) num_stack_mappings = 0;
 
+#ifndef _OS_WINDOWS_
+// Cold stack cache. Excess stacks trimmed from the per-thread pools keep
+// their mapping (including the guard page) but have their contents
+// discarded with `MADV_DONTNEED`, so reusing one is just page faults
+// instead of mmap + mprotect. Since a cold stack has no resident pages,
+// first touch places its memory on the node of whichever thread pulls it
+// out, which keeps stack traffic local on multi-socket machines without a
+// NUMA library dependency. Shared across threads, hence the lock.
+static uv_mutex_t cold_stack_lock;
+static arraylist_t cold_stacks[JL_N_STACK_POOLS];
+
+// With `JULIA_NUMA_STACKS` set, a dead task's stack is demoted straight to
+// the cold cache when the task last ran on a thread other than the pool
+// owner: its pages may live on another node and rewarming them remotely is
+// worse than refaulting them locally.
+static int numa_stacks = 0;
+
+// Slab mode. With `JULIA_STACK_SLABS=<KiB>` set, stacks of up to <KiB>
+// kibibytes are carved out of shared slab mappings of STACK_SLAB_NSTACKS
+// stacks behind a single leading guard region, so spawning a million small
+// tasks costs one mmap + mprotect pair per slab instead of per stack and
+// consumes one VMA entry per slab (vm.max_map_count otherwise caps task
+// count). The tradeoff is that only the slab's lowest stack sits above a
+// guard region: an overflow in any other stack runs silently into its
+// lower neighbor. Slab stacks recycle through the warm and cold caches
+// like any other, but their mapping can never be returned to the kernel.
+#define STACK_SLAB_NSTACKS 32
+static size_t stack_slab_max = 0; // largest stack size served from slabs (0: disabled)
+static char *stack_slab_cursor[JL_N_STACK_POOLS];
+static unsigned stack_slab_remaining[JL_N_STACK_POOLS];
+#endif
+
+void jl_init_stack_pools(void)
+{
+#ifndef _OS_WINDOWS_
+    uv_mutex_init(&cold_stack_lock);
+    for (int i = 0; i < JL_N_STACK_POOLS; i++)
+        arraylist_new(&cold_stacks[i], 0);
+    char *cp = getenv("JULIA_NUMA_STACKS");
+    if (cp && strcmp(cp, "0") != 0)
+        numa_stacks = 1;
+    cp = getenv("JULIA_STACK_SLABS");
+    if (cp)
+        stack_slab_max = (size_t)atoll(cp) * 1024;
+#endif
+}
+
 #ifdef _OS_WINDOWS_
 #define MAP_FAILED NULL
 static void *malloc_stack(size_t bufsz) JL_NOTSAFEPOINT
@@ -103,6 +154,78 @@ static unsigned select_pool(size_t nb) JL_NOTSAFEPOINT
     return pool_id;
 }
 
+#ifndef _OS_WINDOWS_
+static int stack_uses_slab(unsigned pool_id) JL_NOTSAFEPOINT
+{
+    return pool_sizes[pool_id] <= stack_slab_max;
+}
+
+// Carve the next stack out of the pool's current slab, mapping a fresh slab
+// when it is exhausted. Each chunk keeps the usual jl_guard_size at its low
+// end, so the geometry handed to task setup is identical to malloc_stack's;
+// the region is merely unprotected for all but the slab's lowest stack.
+static void *slab_stack_alloc(unsigned pool_id) JL_NOTSAFEPOINT
+{
+    size_t ssize = pool_sizes[pool_id];
+    uv_mutex_lock(&cold_stack_lock);
+    if (stack_slab_remaining[pool_id] == 0) {
+        size_t mapsz = jl_guard_size + (size_t)STACK_SLAB_NSTACKS * ssize;
+        char *slab = (char*)mmap(0, mapsz, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (slab == MAP_FAILED) {
+            uv_mutex_unlock(&cold_stack_lock);
+            return NULL;
+        }
+#if !defined(JL_HAVE_UCONTEXT) && !defined(JL_HAVE_SIGALTSTACK)
+        if (mprotect(slab, jl_guard_size, PROT_NONE) == -1) {
+            munmap(slab, mapsz);
+            uv_mutex_unlock(&cold_stack_lock);
+            return NULL;
+        }
+#endif
+        stack_slab_cursor[pool_id] = slab + jl_guard_size;
+        stack_slab_remaining[pool_id] = STACK_SLAB_NSTACKS;
+        jl_atomic_fetch_add(&num_stack_mappings, 1);
+    }
+    void *stk = stack_slab_cursor[pool_id];
+    stack_slab_cursor[pool_id] += ssize;
+    stack_slab_remaining[pool_id]--;
+    uv_mutex_unlock(&cold_stack_lock);
+    return stk;
+}
+#endif
+
+
+#ifndef _OS_WINDOWS_
+// Discard the contents of a pool-sized stack and park its mapping in the
+// shared cold cache; unmap it instead when the cache is full.
+static void cold_stack_push(unsigned pool_id, void *stk)
+{
+    uv_mutex_lock(&cold_stack_lock);
+    // slab pools park everything: their stacks share one mapping and can
+    // never be unmapped individually, so discarding the pages is all the
+    // reclamation available to them
+    if (cold_stacks[pool_id].len < MAX_COLD_STACKS_PER_POOL ||
+        stack_uses_slab(pool_id)) {
+        madvise(stk, pool_sizes[pool_id], MADV_DONTNEED);
+        arraylist_push(&cold_stacks[pool_id], stk);
+        uv_mutex_unlock(&cold_stack_lock);
+        return;
+    }
+    uv_mutex_unlock(&cold_stack_lock);
+    free_stack(stk, pool_sizes[pool_id]);
+}
+
+static void *cold_stack_pop(unsigned pool_id)
+{
+    void *stk = NULL;
+    uv_mutex_lock(&cold_stack_lock);
+    if (cold_stacks[pool_id].len > 0)
+        stk = arraylist_pop(&cold_stacks[pool_id]);
+    uv_mutex_unlock(&cold_stack_lock);
+    return stk;
+}
+#endif
 
 static void _jl_free_stack(jl_ptls_t ptls, void *stkbuf, size_t bufsz)
 {
@@ -154,6 +277,13 @@ JL_DLLEXPORT void *jl_malloc_stack(size_t *bufsz, jl_task_t *owner) JL_NOTSAFEPO
         if (pool->len > 0) {
             stk = arraylist_pop(pool);
         }
+#ifndef _OS_WINDOWS_
+        else {
+            stk = cold_stack_pop(pool_id);
+            if (stk == NULL && stack_uses_slab(pool_id))
+                stk = slab_stack_alloc(pool_id);
+        }
+#endif
     }
     else {
         ssize = LLT_ALIGN(ssize, jl_page_size);
@@ -162,7 +292,6 @@ JL_DLLEXPORT void *jl_malloc_stack(size_t *bufsz, jl_task_t *owner) JL_NOTSAFEPO
         if (jl_atomic_load_relaxed(&num_stack_mappings) >= MAX_STACK_MAPPINGS)
             // we accept that this can go over by as much as nthreads since it's not a CAS
             return NULL;
-        // TODO: allocate blocks of stacks? but need to mprotect individually anyways
         stk = malloc_stack(ssize);
         if (stk == MAP_FAILED)
             return NULL;
@@ -205,7 +334,11 @@ void sweep_stack_pools(void)
             }
             for (int n = 0; n < n_to_free; n++) {
                 void *stk = arraylist_pop(al);
+#ifdef _OS_WINDOWS_
                 free_stack(stk, pool_sizes[p]);
+#else
+                cold_stack_push(p, stk);
+#endif
             }
         }
 
@@ -231,6 +364,16 @@ void sweep_stack_pools(void)
                 size_t bufsz = t->bufsz;
                 if (stkbuf) {
                     t->stkbuf = NULL;
+#ifndef _OS_WINDOWS_
+                    if (numa_stacks && jl_atomic_load_relaxed(&t->tid) != ptls2->tid &&
+                        bufsz <= pool_sizes[JL_N_STACK_POOLS - 1] &&
+                        pool_sizes[select_pool(bufsz)] == bufsz) {
+                        // last ran on another thread, possibly on another
+                        // node: demote instead of rewarming remote pages
+                        cold_stack_push(select_pool(bufsz), stkbuf);
+                    }
+                    else
+#endif
                     _jl_free_stack(ptls2, stkbuf, bufsz);
                 }
 #ifdef _COMPILER_TSAN_ENABLED_
@@ -1,6 +1,7 @@
 // This file is a part of Julia. License is MIT: https://julialang.org/license
 
 #include "gc.h"
+#include "gc-alloc-profiler.h"
 #include "julia_gcext.h"
 #include "julia_assert.h"
 #ifdef __GLIBC__
@@ -130,6 +131,92 @@ STATIC_INLINE void import_gc_state(jl_ptls_t ptls, jl_gc_mark_sp_t *sp) {
 static jl_mutex_t finalizers_lock;
 static uv_mutex_t gc_cache_lock;
 
+// Parallel marking
+//
+// When `jl_n_markthreads > 0`, dedicated helper threads are spawned at init
+// time and assist the thread driving the collection during the main mark
+// phase. Work is distributed through a global queue of `jl_gc_markwork_t`
+// items: either single objects to (re)scan or chunks split off large object
+// reference arrays. Every marker (the collecting thread and all helpers)
+// runs `gc_mark_loop` and pulls from the queue whenever its local mark stack
+// runs empty; `gc_setmark_tag` already tolerates concurrent marking so the
+// only shared mutable state is the queue itself and the per-marker caches,
+// which are folded back into the collecting thread when the phase ends.
+static int jl_n_markthreads = 0;
+
+// A unit of shareable mark work. `begin == NULL` denotes a single object:
+// it is rescanned without updating metadata if `scan_only` is 1 (remset
+// entries are premarked) and marked normally if `scan_only` is 0. With
+// `scan_only == 2` the item is a whole per-thread root set and `obj` is the
+// `jl_ptls_t` whose roots should be enumerated by whichever marker pops the
+// item. Otherwise the item is a chunk of the object reference array owned
+// by `obj`.
+typedef struct {
+    jl_value_t *obj;
+    jl_value_t **begin;
+    jl_value_t **end;
+    uint32_t step;
+    uint32_t scan_only;
+    uintptr_t nptr;
+} jl_gc_markwork_t;
+
+// All of the following are protected by `gc_markqueue_lock`.
+// `gc_mark_parallel` may additionally be read with relaxed loads as a
+// sharing heuristic outside the lock.
+static uv_mutex_t gc_markqueue_lock;
+static uv_cond_t gc_markqueue_cond;
+static arraylist_t gc_markqueue;
+static int gc_mark_nactive = 0;
+static _Atomic(int) gc_mark_parallel = 0;
+// Pseudo thread local states for the helpers; only the fields touched by
+// the mark path (`gc_cache`, `gc_mark_sp` and the `heap` remset and big
+// object lists) are initialized and used.
+static jl_ptls_t *gc_mark_helper_states;
+
+// Don't bother splitting object arrays smaller than this (in slots) and
+// don't grow the shared queue beyond this many items; past that point the
+// queue only adds synchronization traffic without improving balance.
+#define GC_MARK_SHARE_MIN_CHUNK 512
+#define GC_MARK_SHARE_MAX_QUEUE 256
+
+// Concurrent sweep
+//
+// When enabled (`JULIA_GC_CONCURRENT_SWEEP`), empty pool pages found by the
+// sweep are not returned to the page manager inside the stop-the-world
+// window. They are batched up and handed to a background thread that frees
+// them (including the madvise/decommit syscalls) after the mutators have
+// resumed. The pages are reachable from no freelist and their freemap bits
+// stay clear until `jl_gc_free_page` runs, so the allocator cannot observe
+// them; the only required synchronization is `gc_perm_lock` around the
+// pagetable update and a drain barrier before the next sweep starts.
+static int gc_concurrent_sweep = 0;
+static uv_mutex_t gc_sweep_lock;
+static uv_cond_t gc_sweep_cond;
+static arraylist_t gc_sweep_pending_pages;
+static int gc_sweep_inflight = 0;
+
+// Background finalizer thread
+//
+// When enabled (`JULIA_GC_FINALIZER_THREAD`), the C (`void *`) finalizers
+// scheduled by a collection are not run on the collecting thread. They are
+// moved to a bounded queue drained by a dedicated thread, so the mutator
+// that happened to trigger the collection resumes without paying for them.
+// Julia function finalizers still run synchronously since `jl_apply`
+// requires a task context that a plain runtime thread does not have, and
+// the explicit `jl_finalize` path stays synchronous as well. Entries are
+// removed from the queue only after their finalizer has returned so that
+// the mark phase, which scans the live tail of the queue, keeps the
+// objects alive until then.
+static int gc_finalizer_thread_enabled = 0;
+static uv_mutex_t gc_finalizer_queue_lock;
+static uv_cond_t gc_finalizer_queue_cond;
+static arraylist_t gc_finalizer_queue;
+static size_t gc_finalizer_queue_head = 0;
+
+// Past this many queued pairs, new C finalizers run synchronously again so
+// that a finalizer-heavy workload cannot grow the queue without bound.
+#define GC_FINALIZER_QUEUE_MAX 4096
+
 // Flag that tells us whether we need to support conservative marking
 // of objects.
 static _Atomic(int) support_conservative_marking = 0;
@@ -167,6 +254,8 @@ static _Atomic(int) support_conservative_marking = 0;
  */
 
 jl_gc_num_t gc_num = {0};
+jl_gc_phase_stats_t gc_phase_stats = {0};
+uint32_t gc_osize_inv[JL_GC_N_POOLS];
 static size_t last_long_collect_interval;
 
 pagetable_t memory_map;
@@ -190,8 +279,26 @@ NOINLINE uintptr_t gc_get_stack_ptr(void)
 
 #define should_timeout() 0
 
+// Log2-bucketed histogram (in ns) of how long the collector waited for all
+// other threads to acknowledge the safepoint, for monitoring time-to-safepoint
+// tails. Written only by the thread that won the race to run the collection.
+#define JL_TTSP_NBUCKETS 26
+static uint64_t ttsp_hist[JL_TTSP_NBUCKETS];
+
+// Copy up to `nbuckets` histogram counters into `counts`; bucket `i` counts
+// waits in [2^i, 2^(i+1)) ns, with the last bucket collecting everything
+// longer. Returns the number of buckets. Meant to be ccall'ed by monitoring.
+JL_DLLEXPORT int jl_safepoint_wait_histogram(uint64_t *counts, int nbuckets)
+{
+    int n = nbuckets < JL_TTSP_NBUCKETS ? nbuckets : JL_TTSP_NBUCKETS;
+    for (int i = 0; i < n; i++)
+        counts[i] = ttsp_hist[i];
+    return JL_TTSP_NBUCKETS;
+}
+
 static void jl_gc_wait_for_the_world(void)
 {
+    uint64_t t0 = jl_hrtime();
     if (jl_n_threads > 1)
         jl_wake_libuv();
     for (int i = 0; i < jl_n_threads; i++) {
@@ -205,6 +312,11 @@ static void jl_gc_wait_for_the_world(void)
         while (!jl_atomic_load_relaxed(&ptls2->gc_state) || !jl_atomic_load_acquire(&ptls2->gc_state))
             jl_cpu_pause(); // yield?
     }
+    uint64_t dt = jl_hrtime() - t0;
+    int b = 0;
+    while (b + 1 < JL_TTSP_NBUCKETS && (dt >> (b + 1)) != 0)
+        b++;
+    ttsp_hist[b]++;
 }
 
 // malloc wrappers, aligned allocation
@@ -258,6 +370,69 @@ STATIC_INLINE void jl_free_aligned(void *p) JL_NOTSAFEPOINT
 #define malloc_cache_align(sz) jl_malloc_aligned(sz, JL_CACHE_BYTE_ALIGNMENT)
 #define realloc_cache_align(p, sz, oldsz) jl_realloc_aligned(p, sz, oldsz, JL_CACHE_BYTE_ALIGNMENT)
 
+#ifdef _OS_LINUX_
+// Buffers at or above this size (matching MALLOC_THRESH in array.c) come from
+// mmap instead of malloc, so that growing them is an mremap — a page-table
+// update instead of a memcpy of the whole buffer. A side table maps the data
+// pointer to its mapping size; the free and realloc paths consult it to tell
+// mmap'd buffers apart from plain malloc'd ones, since the array flags have
+// no spare bit for that.
+#define BIGBUF_MMAP_THRESH 1048576
+
+static htable_t bigbuf_map; // data pointer -> mapped size
+static uv_mutex_t bigbuf_lock;
+
+static void *bigbuf_alloc(size_t allocsz) JL_NOTSAFEPOINT
+{
+    size_t mapsz = LLT_ALIGN(allocsz, jl_page_size);
+    void *b = mmap(NULL, mapsz, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (b == MAP_FAILED)
+        return NULL;
+    uv_mutex_lock(&bigbuf_lock);
+    ptrhash_put(&bigbuf_map, b, (void*)mapsz);
+    uv_mutex_unlock(&bigbuf_lock);
+    return b;
+}
+
+// mapping size if `p` is an mmap'd buffer, 0 if it came from malloc
+static size_t bigbuf_size(void *p) JL_NOTSAFEPOINT
+{
+    uv_mutex_lock(&bigbuf_lock);
+    void *sz = ptrhash_get(&bigbuf_map, p);
+    uv_mutex_unlock(&bigbuf_lock);
+    return sz == HT_NOTFOUND ? 0 : (size_t)sz;
+}
+
+static void *bigbuf_realloc(void *d, size_t oldmapsz, size_t allocsz) JL_NOTSAFEPOINT
+{
+    size_t mapsz = LLT_ALIGN(allocsz, jl_page_size);
+    if (mapsz == oldmapsz)
+        return d;
+    void *b = mremap(d, oldmapsz, mapsz, MREMAP_MAYMOVE);
+    if (b == MAP_FAILED)
+        return NULL;
+    uv_mutex_lock(&bigbuf_lock);
+    ptrhash_remove(&bigbuf_map, d);
+    ptrhash_put(&bigbuf_map, b, (void*)mapsz);
+    uv_mutex_unlock(&bigbuf_lock);
+    return b;
+}
+
+static int bigbuf_free(void *p) JL_NOTSAFEPOINT
+{
+    uv_mutex_lock(&bigbuf_lock);
+    void *sz = ptrhash_get(&bigbuf_map, p);
+    if (sz != HT_NOTFOUND)
+        ptrhash_remove(&bigbuf_map, p);
+    uv_mutex_unlock(&bigbuf_lock);
+    if (sz == HT_NOTFOUND)
+        return 0;
+    munmap(p, (size_t)sz);
+    return 1;
+}
+#endif
+
 static void schedule_finalization(void *o, void *f) JL_NOTSAFEPOINT
 {
     arraylist_push(&to_finalize, o);
@@ -371,6 +546,68 @@ static void jl_gc_run_finalizers_in_list(jl_task_t *ct, arraylist_t *list)
     JL_GC_POP();
 }
 
+// Entry point of the background finalizer thread. The pair being run stays
+// in the queue (`gc_finalizer_queue_head` is advanced only after the
+// finalizer returns) so that a concurrent collection still marks the object.
+static void gc_finalizer_threadfun(void *arg)
+{
+    (void)arg;
+    uv_mutex_lock(&gc_finalizer_queue_lock);
+    while (1) {
+        while (gc_finalizer_queue_head >= gc_finalizer_queue.len)
+            uv_cond_wait(&gc_finalizer_queue_cond, &gc_finalizer_queue_lock);
+        void *o = gc_finalizer_queue.items[gc_finalizer_queue_head];
+        void *f = gc_finalizer_queue.items[gc_finalizer_queue_head + 1];
+        uv_mutex_unlock(&gc_finalizer_queue_lock);
+        assert(gc_ptr_tag(o, 1));
+        ((void (*)(void*))f)(gc_ptr_clear_tag(o, 1));
+        uv_mutex_lock(&gc_finalizer_queue_lock);
+        gc_finalizer_queue_head += 2;
+        if (gc_finalizer_queue_head >= gc_finalizer_queue.len) {
+            gc_finalizer_queue.len = 0;
+            gc_finalizer_queue_head = 0;
+            uv_cond_broadcast(&gc_finalizer_queue_cond);
+        }
+    }
+}
+
+// Move the C (`void *`) finalizers out of `to_finalize` onto the background
+// queue. Requires the finalizers lock.
+static void gc_finalizer_queue_offload(void) JL_NOTSAFEPOINT
+{
+    uv_mutex_lock(&gc_finalizer_queue_lock);
+    size_t j = 0;
+    for (size_t i = 0; i < to_finalize.len; i += 2) {
+        void *o = to_finalize.items[i];
+        void *f = to_finalize.items[i + 1];
+        if (gc_ptr_tag(o, 1) &&
+            gc_finalizer_queue.len < 2 * GC_FINALIZER_QUEUE_MAX) {
+            arraylist_push(&gc_finalizer_queue, o);
+            arraylist_push(&gc_finalizer_queue, f);
+            continue;
+        }
+        to_finalize.items[j] = o;
+        to_finalize.items[j + 1] = f;
+        j += 2;
+    }
+    to_finalize.len = j;
+    uv_cond_broadcast(&gc_finalizer_queue_cond);
+    uv_mutex_unlock(&gc_finalizer_queue_lock);
+}
+
+// Stop offloading and wait for the background thread to finish everything
+// already queued. Used on exit so that no C finalizer is left pending.
+static void gc_finalizer_thread_drain(void)
+{
+    if (!gc_finalizer_thread_enabled)
+        return;
+    uv_mutex_lock(&gc_finalizer_queue_lock);
+    gc_finalizer_thread_enabled = 0;
+    while (gc_finalizer_queue_head < gc_finalizer_queue.len)
+        uv_cond_wait(&gc_finalizer_queue_cond, &gc_finalizer_queue_lock);
+    uv_mutex_unlock(&gc_finalizer_queue_lock);
+}
+
 static void run_finalizers(jl_task_t *ct)
 {
     // Racy fast path:
@@ -381,6 +618,8 @@ static void run_finalizers(jl_task_t *ct)
     if (to_finalize.len == 0)
         return;
     JL_LOCK_NOGC(&finalizers_lock);
+    if (gc_finalizer_thread_enabled)
+        gc_finalizer_queue_offload();
     if (to_finalize.len == 0) {
         JL_UNLOCK_NOGC(&finalizers_lock);
         return;
@@ -476,6 +715,9 @@ static void schedule_all_finalizers(arraylist_t *flist) JL_NOTSAFEPOINT
 
 void jl_gc_run_all_finalizers(jl_task_t *ct)
 {
+    // Flush the background thread first so nothing scheduled below is
+    // offloaded again and everything already queued has run.
+    gc_finalizer_thread_drain();
     schedule_all_finalizers(&finalizer_list_marked);
     for (int i = 0;i < jl_n_threads;i++) {
         jl_ptls_t ptls2 = jl_all_tls_states[i];
@@ -584,9 +826,13 @@ static int64_t last_gc_total_bytes = 0;
 #ifdef _P64
 #define default_collect_interval (5600*1024*sizeof(void*))
 static size_t max_collect_interval = 1250000000UL;
+// Soft limit on the total heap size; the pacer below scales the allocation
+// interval down and forces full collections as the live heap approaches it.
+static uint64_t max_total_memory = (uint64_t)2 << 40;
 #else
 #define default_collect_interval (3200*1024*sizeof(void*))
 static size_t max_collect_interval =  500000000UL;
+static uint64_t max_total_memory = (uint64_t)2 << 30;
 #endif
 
 // global variables for GC stats
@@ -639,9 +885,31 @@ static int mark_reset_age = 0;
 
 
 #define PROMOTE_AGE 1
-// this cannot be increased as is without changing :
-// - sweep_page which is specialized for 1bit age
-// - the size of the age storage in jl_gc_pagemeta_t
+// The effective threshold is `jl_gc_promote_age` and can be raised up to
+// `MAX_PROMOTE_AGE` with `JULIA_GC_PROMOTE_AGE`; the survival counters (2
+// bits per pool object in `jl_gc_pagemeta_t::ages`, 2 bits in
+// `bigval_t::age`) saturate there. A higher threshold keeps medium-lived
+// objects out of the old generation at the cost of rescanning them during
+// more quick sweeps.
+#define MAX_PROMOTE_AGE 3
+static int jl_gc_promote_age = PROMOTE_AGE;
+
+// Number of pool objects promoted to the old generation since startup, per
+// pool size class. Only written during the sweep, which is single threaded.
+static uint64_t gc_pool_promoted[JL_GC_N_POOLS];
+
+// Soft pause target (`JULIA_GC_MAX_PAUSE`, in milliseconds; 0 disables).
+// While the last full collection's pause exceeded the target, heuristic
+// escalations to a full collection are downgraded to quick collections,
+// which only mark through the remset frontier and sweep the young
+// generation. This trades memory for latency, so the downgrade is bounded:
+// it never overrides the soft heap limit and gives up after
+// `GC_MAX_PAUSE_DEFER_LIMIT` consecutive downgrades, since quick
+// collections cannot shrink the old generation at all.
+static uint64_t gc_max_pause_ns = 0;
+static uint64_t gc_last_full_pause = 0;
+static int gc_deferred_full = 0;
+#define GC_MAX_PAUSE_DEFER_LIMIT 8
 
 
 static int64_t scanned_bytes; // young bytes scanned while marking
@@ -781,6 +1049,12 @@ STATIC_INLINE void gc_setmark_pool_(jl_ptls_t ptls, jl_taggedvalue_t *o,
     gc_setmark_big(ptls, o, mark_mode);
 #else
     jl_assume(page);
+    char *page_begin = gc_page_data(o) + GC_PAGE_OFFSET;
+    int obj_id = (((char*)o) - page_begin) / page->osize;
+    // mirror the mark into the page's side bitmap for the sweep; the
+    // atomic or makes this safe against concurrent markers
+    jl_atomic_fetch_or_relaxed((_Atomic(uint32_t)*)&page->markbits[obj_id / 32],
+                               (uint32_t)1 << (obj_id % 32));
     if (mark_mode == GC_OLD_MARKED) {
         ptls->gc_cache.perm_scanned_bytes += page->osize;
         static_assert(sizeof(_Atomic(uint16_t)) == sizeof(page->nold), "");
@@ -790,10 +1064,8 @@ STATIC_INLINE void gc_setmark_pool_(jl_ptls_t ptls, jl_taggedvalue_t *o,
         ptls->gc_cache.scanned_bytes += page->osize;
         if (mark_reset_age) {
             page->has_young = 1;
-            char *page_begin = gc_page_data(o) + GC_PAGE_OFFSET;
-            int obj_id = (((char*)o) - page_begin) / page->osize;
-            uint8_t *ages = page->ages + obj_id / 8;
-            jl_atomic_fetch_and_relaxed((_Atomic(uint8_t)*)ages, ~(1 << (obj_id % 8)));
+            uint8_t *ages = page->ages + obj_id / 4;
+            jl_atomic_fetch_and_relaxed((_Atomic(uint8_t)*)ages, ~(3 << ((obj_id % 4) * 2)));
         }
     }
     objprofile_count(jl_typeof(jl_valueof(o)),
@@ -963,6 +1235,7 @@ JL_DLLEXPORT jl_value_t *jl_gc_big_alloc(jl_ptls_t ptls, size_t sz)
         jl_atomic_load_relaxed(&ptls->gc_num.allocd) + allocsz);
     jl_atomic_store_relaxed(&ptls->gc_num.bigalloc,
         jl_atomic_load_relaxed(&ptls->gc_num.bigalloc) + 1);
+    gc_alloc_profile_maybe_sample(ptls, allocsz);
 #ifdef MEMDEBUG
     memset(v, 0xee, allocsz);
 #endif
@@ -973,8 +1246,11 @@ JL_DLLEXPORT jl_value_t *jl_gc_big_alloc(jl_ptls_t ptls, size_t sz)
 }
 
 // Sweep list rooted at *pv, removing and freeing any unmarked objects.
-// Return pointer to last `next` field in the culled list.
-static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
+// Return pointer to last `next` field in the culled list. Freed and
+// promoted bytes are accumulated into the caller's tallies so that
+// parallel sweep workers can batch the global accounting.
+static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv,
+                                 size_t *freed, size_t *promoted) JL_NOTSAFEPOINT
 {
     bigval_t *v = *pv;
     while (v != NULL) {
@@ -984,13 +1260,15 @@ static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
         if (gc_marked(bits)) {
             pv = &v->next;
             int age = v->age;
-            if (age >= PROMOTE_AGE || bits == GC_OLD_MARKED) {
+            if (age >= jl_gc_promote_age || bits == GC_OLD_MARKED) {
                 if (sweep_full || bits == GC_MARKED) {
+                    if (bits == GC_MARKED)
+                        *promoted += v->sz;
                     bits = GC_OLD;
                 }
             }
             else {
-                inc_sat(age, PROMOTE_AGE);
+                inc_sat(age, MAX_PROMOTE_AGE);
                 v->age = age;
                 bits = GC_CLEAN;
             }
@@ -1001,7 +1279,7 @@ static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
             *pv = nxt;
             if (nxt)
                 nxt->prev = pv;
-            gc_num.freed += v->sz&~3;
+            *freed += v->sz&~3;
 #ifdef MEMDEBUG
             memset(v, 0xbb, v->sz&~3);
 #endif
@@ -1015,25 +1293,6 @@ static bigval_t **sweep_big_list(int sweep_full, bigval_t **pv) JL_NOTSAFEPOINT
     return pv;
 }
 
-static void sweep_big(jl_ptls_t ptls, int sweep_full) JL_NOTSAFEPOINT
-{
-    gc_time_big_start();
-    for (int i = 0;i < jl_n_threads;i++)
-        sweep_big_list(sweep_full, &jl_all_tls_states[i]->heap.big_objects);
-    if (sweep_full) {
-        bigval_t **last_next = sweep_big_list(sweep_full, &big_objects_marked);
-        // Move all survivors from big_objects_marked list to big_objects list.
-        if (ptls->heap.big_objects)
-            ptls->heap.big_objects->prev = last_next;
-        *last_next = ptls->heap.big_objects;
-        ptls->heap.big_objects = big_objects_marked;
-        if (ptls->heap.big_objects)
-            ptls->heap.big_objects->prev = &ptls->heap.big_objects;
-        big_objects_marked = NULL;
-    }
-    gc_time_big_end();
-}
-
 // tracking Arrays with malloc'd storage
 
 void jl_gc_track_malloced_array(jl_ptls_t ptls, jl_array_t *a) JL_NOTSAFEPOINT
@@ -1109,42 +1368,145 @@ size_t jl_array_nbytes(jl_array_t *a) JL_NOTSAFEPOINT
     return sz;
 }
 
-static void jl_gc_free_array(jl_array_t *a) JL_NOTSAFEPOINT
+// Returns the number of bytes freed; the caller is responsible for the
+// `gc_num.freed` accounting so that parallel sweep workers can batch it.
+static size_t jl_gc_free_array(jl_array_t *a) JL_NOTSAFEPOINT
 {
     if (a->flags.how == 2) {
         char *d = (char*)a->data - a->offset*a->elsize;
+#ifdef _OS_LINUX_
+        if (bigbuf_free(d))
+            return jl_array_nbytes(a);
+#endif
         if (a->flags.isaligned)
             jl_free_aligned(d);
         else
             free(d);
-        gc_num.freed += jl_array_nbytes(a);
+        return jl_array_nbytes(a);
+    }
+    return 0;
+}
+
+// Parallel sweep of the malloc'd array and big object lists. Each
+// per-thread pair of lists is an independent unit of work (only its
+// owner's `mallocarrays`/`mafreelist`/`big_objects` are touched), so when
+// helper mark threads are available they are woken a second time during
+// the sweep phase and claim whole heaps through an atomic cursor. A new
+// epoch number tells the helpers apart from a mark phase wakeup and keeps
+// each helper from participating twice in the same sweep. The GC_TIME
+// tallies are imprecise in this mode (debug builds only); the
+// `gc_num.freed` and promoted-bytes accounting stays exact.
+static _Atomic(int) gc_sweep_heaps_epoch = 0;
+static _Atomic(int) gc_sweep_heaps_next = 0;
+static _Atomic(int) gc_sweep_heaps_pending = 0;
+static int gc_sweep_heaps_full = 0;
+
+static size_t gc_sweep_mallocd_list(jl_ptls_t ptls2) JL_NOTSAFEPOINT
+{
+    size_t freed = 0;
+    mallocarray_t *ma = ptls2->heap.mallocarrays;
+    mallocarray_t **pma = &ptls2->heap.mallocarrays;
+    while (ma != NULL) {
+        mallocarray_t *nxt = ma->next;
+        int bits = jl_astaggedvalue(ma->a)->bits.gc;
+        if (gc_marked(bits)) {
+            pma = &ma->next;
+        }
+        else {
+            *pma = nxt;
+            assert(ma->a->flags.how == 2);
+            freed += jl_gc_free_array(ma->a);
+            ma->next = ptls2->heap.mafreelist;
+            ptls2->heap.mafreelist = ma;
+        }
+        gc_time_count_mallocd_array(bits);
+        ma = nxt;
     }
+    return freed;
+}
+
+// One stopped thread's share of the sweep: its malloc'd array list and its
+// big object list.
+static void gc_sweep_thread_heap(jl_ptls_t ptls2, int sweep_full,
+                                 size_t *freed, size_t *promoted) JL_NOTSAFEPOINT
+{
+    *freed += gc_sweep_mallocd_list(ptls2);
+    sweep_big_list(sweep_full, &ptls2->heap.big_objects, freed, promoted);
 }
 
-static void sweep_malloced_arrays(void) JL_NOTSAFEPOINT
+// Claim per-thread heaps until the cursor runs out, then fold the freed
+// and promoted bytes into the global tallies and report completion under
+// the queue lock.
+static void gc_sweep_heaps_worker(void) JL_NOTSAFEPOINT
+{
+    size_t freed = 0;
+    size_t promoted = 0;
+    int ndone = 0;
+    while (1) {
+        int t_i = jl_atomic_fetch_add(&gc_sweep_heaps_next, 1);
+        if (t_i >= jl_n_threads)
+            break;
+        gc_sweep_thread_heap(jl_all_tls_states[t_i], gc_sweep_heaps_full,
+                             &freed, &promoted);
+        ndone++;
+    }
+    uv_mutex_lock(&gc_markqueue_lock);
+    gc_num.freed += freed;
+    gc_phase_stats.promoted_bytes += promoted;
+    jl_atomic_store_relaxed(&gc_sweep_heaps_pending,
+        jl_atomic_load_relaxed(&gc_sweep_heaps_pending) - ndone);
+    uv_cond_broadcast(&gc_markqueue_cond);
+    uv_mutex_unlock(&gc_markqueue_lock);
+}
+
+static void sweep_malloced_arrays_and_big(jl_ptls_t ptls, int sweep_full) JL_NOTSAFEPOINT
 {
     gc_time_mallocd_array_start();
-    for (int t_i = 0;t_i < jl_n_threads;t_i++) {
-        jl_ptls_t ptls2 = jl_all_tls_states[t_i];
-        mallocarray_t *ma = ptls2->heap.mallocarrays;
-        mallocarray_t **pma = &ptls2->heap.mallocarrays;
-        while (ma != NULL) {
-            mallocarray_t *nxt = ma->next;
-            int bits = jl_astaggedvalue(ma->a)->bits.gc;
-            if (gc_marked(bits)) {
-                pma = &ma->next;
-            }
-            else {
-                *pma = nxt;
-                assert(ma->a->flags.how == 2);
-                jl_gc_free_array(ma->a);
-                ma->next = ptls2->heap.mafreelist;
-                ptls2->heap.mafreelist = ma;
-            }
-            gc_time_count_mallocd_array(bits);
-            ma = nxt;
-        }
+    gc_time_big_start();
+    if (jl_n_markthreads > 0 && jl_n_threads > 1) {
+        uv_mutex_lock(&gc_markqueue_lock);
+        gc_sweep_heaps_full = sweep_full;
+        jl_atomic_store_relaxed(&gc_sweep_heaps_next, 0);
+        jl_atomic_store_relaxed(&gc_sweep_heaps_pending, jl_n_threads);
+        jl_atomic_store_relaxed(&gc_sweep_heaps_epoch,
+            jl_atomic_load_relaxed(&gc_sweep_heaps_epoch) + 1);
+        uv_cond_broadcast(&gc_markqueue_cond);
+        uv_mutex_unlock(&gc_markqueue_lock);
+        gc_sweep_heaps_worker();
+        uv_mutex_lock(&gc_markqueue_lock);
+        while (jl_atomic_load_relaxed(&gc_sweep_heaps_pending) > 0)
+            uv_cond_wait(&gc_markqueue_cond, &gc_markqueue_lock);
+        uv_mutex_unlock(&gc_markqueue_lock);
+    }
+    else {
+        size_t freed = 0;
+        size_t promoted = 0;
+        for (int t_i = 0; t_i < jl_n_threads; t_i++)
+            gc_sweep_thread_heap(jl_all_tls_states[t_i], sweep_full,
+                                 &freed, &promoted);
+        gc_num.freed += freed;
+        gc_phase_stats.promoted_bytes += promoted;
+    }
+    if (sweep_full) {
+        // The collecting thread sweeps the global marked list only once the
+        // workers are done: the survivors are spliced onto its own
+        // `big_objects` list, which a worker may otherwise still be culling.
+        size_t freed = 0;
+        size_t promoted = 0;
+        bigval_t **last_next = sweep_big_list(sweep_full, &big_objects_marked,
+                                              &freed, &promoted);
+        gc_num.freed += freed;
+        gc_phase_stats.promoted_bytes += promoted;
+        // Move all survivors from big_objects_marked list to big_objects list.
+        if (ptls->heap.big_objects)
+            ptls->heap.big_objects->prev = last_next;
+        *last_next = ptls->heap.big_objects;
+        ptls->heap.big_objects = big_objects_marked;
+        if (ptls->heap.big_objects)
+            ptls->heap.big_objects->prev = &ptls->heap.big_objects;
+        big_objects_marked = NULL;
     }
+    gc_time_big_end();
     gc_time_mallocd_array_end();
 }
 
@@ -1155,7 +1517,8 @@ static inline jl_taggedvalue_t *reset_page(const jl_gc_pool_t *p, jl_gc_pagemeta
     pg->nfree = (GC_PAGE_SZ - GC_PAGE_OFFSET) / p->osize;
     jl_ptls_t ptls2 = jl_all_tls_states[pg->thread_n];
     pg->pool_n = p - ptls2->heap.norm_pools;
-    memset(pg->ages, 0, GC_PAGE_SZ / 8 / p->osize + 1);
+    memset(pg->ages, 0, GC_PAGE_SZ / 4 / p->osize + 1);
+    memset(pg->markbits, 0, GC_PAGE_MARKBITS_NW(p->osize) * sizeof(uint32_t));
     jl_taggedvalue_t *beg = (jl_taggedvalue_t*)(pg->data + GC_PAGE_OFFSET);
     jl_taggedvalue_t *next = (jl_taggedvalue_t*)pg->data;
     if (fl == NULL) {
@@ -1189,7 +1552,8 @@ static NOINLINE jl_taggedvalue_t *add_page(jl_gc_pool_t *p) JL_NOTSAFEPOINT
     jl_ptls_t ptls = jl_current_task->ptls;
     jl_gc_pagemeta_t *pg = jl_gc_alloc_page();
     pg->osize = p->osize;
-    pg->ages = (uint8_t*)malloc_s(GC_PAGE_SZ / 8 / p->osize + 1);
+    pg->ages = (uint8_t*)malloc_s(GC_PAGE_SZ / 4 / p->osize + 1);
+    pg->markbits = (uint32_t*)malloc_s(GC_PAGE_MARKBITS_NW(p->osize) * sizeof(uint32_t));
     pg->thread_n = ptls->tid;
     jl_taggedvalue_t *fl = reset_page(p, pg, NULL);
     p->newpages = fl;
@@ -1213,6 +1577,7 @@ JL_DLLEXPORT jl_value_t *jl_gc_pool_alloc(jl_ptls_t ptls, int pool_offset,
         jl_atomic_load_relaxed(&ptls->gc_num.allocd) + osize);
     jl_atomic_store_relaxed(&ptls->gc_num.poolalloc,
         jl_atomic_load_relaxed(&ptls->gc_num.poolalloc) + 1);
+    gc_alloc_profile_maybe_sample(ptls, osize);
     // first try to use the freelist
     jl_taggedvalue_t *v = p->freelist;
     if (v) {
@@ -1263,6 +1628,168 @@ int jl_gc_classify_pools(size_t sz, int *osize)
     return (int)(intptr_t)(&((jl_ptls_t)0)->heap.norm_pools[klass]);
 }
 
+// Arena (region) allocator
+//
+// Opt-in bump allocator for request-scoped object graphs that die together.
+// Objects are carved out of private malloc'd regions with their tag bits set
+// to `GC_OLD_MARKED`, so the collector never traces, ages or sweeps them and
+// `jl_gc_arena_end` releases the whole graph at once without a collection.
+// Storing a heap reference into an arena object is handled by the ordinary
+// write barrier (the arena object ends up in the remset like any other old
+// object), but a remset entry pointing into the arena must not dangle: the
+// check in `jl_gc_queue_root` flags the arena as escaped and its regions are
+// then retained for the lifetime of the process instead of being freed.
+// Publishing an arena reference from a GC-managed object is the caller's
+// responsibility to avoid; the write barrier cannot observe it.
+
+#define GC_ARENA_REGION_SZ (512 * 1024)
+
+typedef struct _gc_arena_region_t {
+    struct _gc_arena_region_t *next;
+    size_t sz;   // usable bytes following this header
+    size_t used;
+} gc_arena_region_t;
+
+struct _jl_gc_arena_t {
+    gc_arena_region_t *regions;
+    struct _jl_gc_arena_t *next; // next live arena
+    int escaped;
+};
+
+// Protects the live arena list, region lists and the bounds below.
+uv_mutex_t gc_arena_lock;
+static jl_gc_arena_t *gc_live_arenas = NULL;
+static gc_arena_region_t *gc_escaped_regions = NULL;
+// Conservative address bounds over all arena regions ever allocated, for the
+// fast path of the escape check. The bounds only grow, so a stale read can
+// at worst send a non-arena pointer down the (harmless) slow path.
+static _Atomic(uintptr_t) gc_arena_lo = UINTPTR_MAX;
+static _Atomic(uintptr_t) gc_arena_hi = 0;
+
+JL_DLLEXPORT jl_gc_arena_t *jl_gc_arena_begin(void)
+{
+    jl_gc_arena_t *a = (jl_gc_arena_t*)malloc_s(sizeof(jl_gc_arena_t));
+    a->regions = NULL;
+    a->escaped = 0;
+    uv_mutex_lock(&gc_arena_lock);
+    a->next = gc_live_arenas;
+    gc_live_arenas = a;
+    uv_mutex_unlock(&gc_arena_lock);
+    return a;
+}
+
+static NOINLINE gc_arena_region_t *gc_arena_add_region(jl_gc_arena_t *a, size_t min_sz)
+{
+    size_t sz = min_sz <= GC_ARENA_REGION_SZ ? GC_ARENA_REGION_SZ :
+        LLT_ALIGN(min_sz, jl_page_size);
+    gc_arena_region_t *r = (gc_arena_region_t*)malloc_s(sizeof(gc_arena_region_t) + sz);
+    r->sz = sz;
+    r->used = 0;
+    uv_mutex_lock(&gc_arena_lock);
+    r->next = a->regions;
+    a->regions = r;
+    if ((uintptr_t)r < jl_atomic_load_relaxed(&gc_arena_lo))
+        jl_atomic_store_release(&gc_arena_lo, (uintptr_t)r);
+    if ((uintptr_t)(r + 1) + sz > jl_atomic_load_relaxed(&gc_arena_hi))
+        jl_atomic_store_release(&gc_arena_hi, (uintptr_t)(r + 1) + sz);
+    uv_mutex_unlock(&gc_arena_lock);
+    return r;
+}
+
+// Size does not include the tag; mirrors `jl_gc_alloc_typed`.
+JL_DLLEXPORT jl_value_t *jl_gc_arena_alloc(jl_gc_arena_t *a, size_t sz, void *ty)
+{
+    size_t allocsz = LLT_ALIGN(sz + sizeof(jl_taggedvalue_t), JL_SMALL_BYTE_ALIGNMENT);
+    if (allocsz < sz) // overflow in adding tag, size was "negative"
+        jl_throw(jl_memory_exception);
+    gc_arena_region_t *r = a->regions;
+    if (__unlikely(r == NULL || r->sz - r->used < allocsz))
+        r = gc_arena_add_region(a, allocsz);
+    jl_taggedvalue_t *v = (jl_taggedvalue_t*)((char*)(r + 1) + r->used);
+    r->used += allocsz;
+    v->header = (uintptr_t)ty | GC_OLD_MARKED;
+    return jl_valueof(v);
+}
+
+JL_DLLEXPORT void jl_gc_arena_end(jl_gc_arena_t *a)
+{
+    uv_mutex_lock(&gc_arena_lock);
+    jl_gc_arena_t **pa = &gc_live_arenas;
+    while (*pa != a)
+        pa = &(*pa)->next;
+    *pa = a->next;
+    int escaped = a->escaped;
+    if (escaped && a->regions) {
+        // a reference into this arena may still be visible to the collector
+        // (through the remset); retain the regions instead of freeing memory
+        // that could still be traced
+        gc_arena_region_t *r = a->regions;
+        while (r->next)
+            r = r->next;
+        r->next = gc_escaped_regions;
+        gc_escaped_regions = a->regions;
+        a->regions = NULL;
+    }
+    uv_mutex_unlock(&gc_arena_lock);
+    gc_arena_region_t *r = a->regions;
+    while (r) {
+        gc_arena_region_t *next = r->next;
+        free(r);
+        r = next;
+    }
+    free(a);
+}
+
+// Per-task arenas. While attached the arena travels with the task (it is
+// stored in `jl_task_t` and mirrored in `ptls->task_arena` across context
+// switches), and `jl_gc_alloc_` turns every runtime allocation on the task
+// into a pointer bump. Anything that must outlive the task -- including its
+// result -- must not be allocated while the arena is attached; an arena left
+// attached when the task finishes is released in `jl_finish_task`.
+JL_DLLEXPORT jl_gc_arena_t *jl_gc_task_arena_begin(void)
+{
+    jl_task_t *ct = jl_current_task;
+    if (ct->arena == NULL) {
+        ct->arena = jl_gc_arena_begin();
+        ct->ptls->task_arena = ct->arena;
+    }
+    return ct->arena;
+}
+
+JL_DLLEXPORT void jl_gc_task_arena_end(void)
+{
+    jl_task_t *ct = jl_current_task;
+    jl_gc_arena_t *a = ct->arena;
+    if (a == NULL)
+        return;
+    ct->arena = NULL;
+    ct->ptls->task_arena = NULL;
+    jl_gc_arena_end(a);
+}
+
+static NOINLINE void gc_arena_note_escape(uintptr_t p) JL_NOTSAFEPOINT
+{
+    uv_mutex_lock(&gc_arena_lock);
+    for (jl_gc_arena_t *a = gc_live_arenas; a; a = a->next) {
+        for (gc_arena_region_t *r = a->regions; r; r = r->next) {
+            if (p >= (uintptr_t)(r + 1) && p < (uintptr_t)(r + 1) + r->sz) {
+                a->escaped = 1;
+                uv_mutex_unlock(&gc_arena_lock);
+                return;
+            }
+        }
+    }
+    uv_mutex_unlock(&gc_arena_lock);
+}
+
+STATIC_INLINE void gc_arena_check_escape(const void *ptr) JL_NOTSAFEPOINT
+{
+    uintptr_t p = (uintptr_t)ptr;
+    if (__unlikely(p >= jl_atomic_load_relaxed(&gc_arena_lo) &&
+                   p < jl_atomic_load_relaxed(&gc_arena_hi)))
+        gc_arena_note_escape(p);
+}
+
 // sweep phase
 
 int64_t lazy_freed_pages = 0;
@@ -1272,8 +1799,7 @@ static jl_taggedvalue_t **sweep_page(jl_gc_pool_t *p, jl_gc_pagemeta_t *pg, jl_t
 {
     char *data = pg->data;
     uint8_t *ages = pg->ages;
-    jl_taggedvalue_t *v = (jl_taggedvalue_t*)(data + GC_PAGE_OFFSET);
-    char *lim = (char*)v + GC_PAGE_SZ - GC_PAGE_OFFSET - osize;
+    jl_taggedvalue_t *v;
     size_t old_nfree = pg->nfree;
     size_t nfree;
 
@@ -1291,10 +1817,14 @@ static jl_taggedvalue_t **sweep_page(jl_gc_pool_t *p, jl_gc_pagemeta_t *pg, jl_t
             begin->next = (jl_taggedvalue_t*)0;
             lazy_freed_pages++;
         }
+        else if (gc_concurrent_sweep) {
+            // freed by the background sweep thread once the world restarts
+            arraylist_push(&gc_sweep_pending_pages, data);
+        }
         else {
             jl_gc_free_page(data);
         }
-        nfree = (GC_PAGE_SZ - GC_PAGE_OFFSET) / osize;
+        nfree = gc_div_osize(GC_PAGE_SZ - GC_PAGE_OFFSET, pg->pool_n);
         goto done;
     }
     // For quick sweep, we might be able to skip the page if the page doesn't
@@ -1321,21 +1851,51 @@ static jl_taggedvalue_t **sweep_page(jl_gc_pool_t *p, jl_gc_pagemeta_t *pg, jl_t
         int16_t prev_nold = 0;
         int pg_nfree = 0;
         jl_taggedvalue_t **pfl_begin = NULL;
-        uint8_t msk = 1; // mask for the age bit in the current age byte
-        while ((char*)v <= lim) {
-            int bits = v->bits.gc;
-            if (!gc_marked(bits)) {
+        // Walk the side mark bitmap a word (32 objects) at a time instead
+        // of every object's header: dead slots are linked into the
+        // freelist without their headers ever being loaded, and only live
+        // slots pay for the header and age updates. The bitmap is
+        // rewritten along the way so that it keeps mirroring
+        // `gc_marked(bits)` after the promotions and demotions below.
+        uint32_t *markbits = pg->markbits;
+        size_t nobj = gc_div_osize(GC_PAGE_SZ - GC_PAGE_OFFSET, pg->pool_n);
+        for (size_t w = 0; w * 32 < nobj; w++) {
+            size_t nw = nobj - w * 32 < 32 ? nobj - w * 32 : 32;
+            uint32_t valid = nw == 32 ? ~(uint32_t)0 : (((uint32_t)1 << nw) - 1);
+            uint32_t marked = markbits[w] & valid;
+            uint32_t still_marked = 0;
+            uint32_t line = ~marked & valid;
+            unsigned j;
+            for (j = 0; line; j++, line >>= 1) { // dead slots
+                unsigned next = ffs_u32(line);
+                j += next;
+                line >>= next;
+                size_t obj_id = w * 32 + j;
+                v = (jl_taggedvalue_t*)(data + GC_PAGE_OFFSET + obj_id * osize);
                 *pfl = v;
                 pfl = &v->next;
                 pfl_begin = pfl_begin ? pfl_begin : pfl;
                 pg_nfree++;
-                *ages &= ~msk;
+                ages[obj_id / 4] &= ~(3 << ((obj_id % 4) * 2));
             }
-            else { // marked young or old
-                if (*ages & msk || bits == GC_OLD_MARKED) { // old enough
+            line = marked;
+            for (j = 0; line; j++, line >>= 1) { // marked young or old
+                unsigned next = ffs_u32(line);
+                j += next;
+                line >>= next;
+                size_t obj_id = w * 32 + j;
+                unsigned age_shift = (obj_id % 4) * 2;
+                v = (jl_taggedvalue_t*)(data + GC_PAGE_OFFSET + obj_id * osize);
+                int bits = v->bits.gc;
+                int age = (ages[obj_id / 4] >> age_shift) & 3;
+                if (age >= jl_gc_promote_age || bits == GC_OLD_MARKED) { // old enough
                     // `!age && bits == GC_OLD_MARKED` is possible for
                     // non-first-class objects like `jl_binding_t`
                     if (sweep_full || bits == GC_MARKED) {
+                        if (bits == GC_MARKED) {
+                            gc_pool_promoted[pg->pool_n]++;
+                            gc_phase_stats.promoted_bytes += osize;
+                        }
                         bits = v->bits.gc = GC_OLD; // promote
                     }
                     prev_nold++;
@@ -1345,16 +1905,18 @@ static jl_taggedvalue_t **sweep_page(jl_gc_pool_t *p, jl_gc_pagemeta_t *pg, jl_t
                     bits = v->bits.gc = GC_CLEAN; // unmark
                     has_young = 1;
                 }
-                has_marked |= gc_marked(bits);
-                *ages |= msk;
+                if (gc_marked(bits)) {
+                    has_marked = 1;
+                    still_marked |= (uint32_t)1 << j;
+                }
+                // survived one more collection; a nonzero age also tells
+                // the conservative scan this is not a freelist entry
+                if (age < MAX_PROMOTE_AGE)
+                    ages[obj_id / 4] = (ages[obj_id / 4] & ~(3 << age_shift)) |
+                                       ((age + 1) << age_shift);
                 freedall = 0;
             }
-            v = (jl_taggedvalue_t*)((char*)v + osize);
-            msk <<= 1;
-            if (!msk) {
-                msk = 1;
-                ages++;
-            }
+            markbits[w] = still_marked;
         }
 
         assert(!freedall);
@@ -1474,8 +2036,7 @@ static void sweep_pool_pagetable(jl_taggedvalue_t ***pfl, int sweep_full) JL_NOT
 // sweep over all memory that is being used and not in a pool
 static void gc_sweep_other(jl_ptls_t ptls, int sweep_full) JL_NOTSAFEPOINT
 {
-    sweep_malloced_arrays();
-    sweep_big(ptls, sweep_full);
+    sweep_malloced_arrays_and_big(ptls, sweep_full);
 }
 
 static void gc_pool_sync_nfree(jl_gc_pagemeta_t *pg, jl_taggedvalue_t *last) JL_NOTSAFEPOINT
@@ -1494,12 +2055,66 @@ static void gc_pool_sync_nfree(jl_gc_pagemeta_t *pg, jl_taggedvalue_t *last) JL_
     pg->nfree = nfree;
 }
 
+// Entry point of the background sweep thread: frees the empty pages queued
+// by `sweep_page` while the mutators are running. `jl_gc_free_page` is
+// called one page at a time under `gc_perm_lock` so allocating threads are
+// never blocked for longer than a single pagetable update.
+static void gc_sweep_threadfun(void *arg)
+{
+    (void)arg;
+    while (1) {
+        uv_mutex_lock(&gc_sweep_lock);
+        while (!gc_sweep_inflight)
+            uv_cond_wait(&gc_sweep_cond, &gc_sweep_lock);
+        uv_mutex_unlock(&gc_sweep_lock);
+        size_t len = gc_sweep_pending_pages.len;
+        for (size_t i = 0; i < len; i++) {
+            uv_mutex_lock(&gc_perm_lock);
+            jl_gc_free_page(gc_sweep_pending_pages.items[i]);
+            uv_mutex_unlock(&gc_perm_lock);
+        }
+        uv_mutex_lock(&gc_sweep_lock);
+        gc_sweep_pending_pages.len = 0;
+        gc_sweep_inflight = 0;
+        uv_cond_broadcast(&gc_sweep_cond);
+        uv_mutex_unlock(&gc_sweep_lock);
+    }
+}
+
+// Wait for the background sweep of the previous collection to finish.
+// Pending pages still have their pagetable allocmap bits set, so the next
+// pagetable sweep would visit them again if we let it run early.
+static void gc_sweep_wait_concurrent(void)
+{
+    if (!gc_concurrent_sweep)
+        return;
+    uv_mutex_lock(&gc_sweep_lock);
+    while (gc_sweep_inflight)
+        uv_cond_wait(&gc_sweep_cond, &gc_sweep_lock);
+    uv_mutex_unlock(&gc_sweep_lock);
+}
+
+// Hand the batched empty pages over to the background sweep thread.
+static void gc_sweep_start_concurrent(void)
+{
+    if (!gc_concurrent_sweep || gc_sweep_pending_pages.len == 0)
+        return;
+    uv_mutex_lock(&gc_sweep_lock);
+    gc_sweep_inflight = 1;
+    uv_cond_signal(&gc_sweep_cond);
+    uv_mutex_unlock(&gc_sweep_lock);
+}
+
 // setup the data-structures for a sweep over all memory pools
 static void gc_sweep_pool(int sweep_full)
 {
     gc_time_pool_start();
     lazy_freed_pages = 0;
 
+    // cached pages carry no pool metadata and must not be seen by the
+    // pagetable walk below
+    jl_gc_flush_page_caches();
+
     // For the benfit of the analyzer, which doesn't know that jl_n_threads
     // doesn't change over the course of this function
     size_t n_threads = jl_n_threads;
@@ -1568,6 +2183,9 @@ JL_DLLEXPORT void jl_gc_queue_root(const jl_value_t *ptr)
     o->bits.gc = GC_MARKED;
     arraylist_push(ptls->heap.remset, (jl_value_t*)ptr);
     ptls->heap.remset_nptr++; // conservative
+    // an arena object acquiring a heap reference pins its arena, since the
+    // remset entry must stay valid (see the arena allocator above)
+    gc_arena_check_escape(ptr);
 }
 
 void jl_gc_queue_multiroot(const jl_value_t *parent, const jl_value_t *ptr) JL_NOTSAFEPOINT
@@ -1609,6 +2227,38 @@ void jl_gc_queue_multiroot(const jl_value_t *parent, const jl_value_t *ptr) JL_N
     }
 }
 
+// Number of object slots covered by one array card (512 bytes worth) and
+// the bound on recorded cards per thread before we give up on precision and
+// fall back to remembering the whole object.
+#define GC_ARRAY_CARD_SLOTS (512 / sizeof(void*))
+#define GC_ARRAY_CARD_MAX 8192
+
+// Card-granular variant of `jl_gc_queue_root` for stores into old object
+// arrays: instead of rescanning the whole array on every quick collection,
+// only the dirtied 512-byte card is rescanned. The object is deliberately
+// not put into the queued state, so later stores keep firing the write
+// barrier and record their own cards (or the whole object, through the
+// plain barrier paths emitted by codegen).
+JL_DLLEXPORT void jl_gc_queue_array_card(const jl_value_t *owner, size_t i) JL_NOTSAFEPOINT
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    arraylist_t *cards = &ptls->heap.rem_cards;
+    size_t card = i / GC_ARRAY_CARD_SLOTS;
+    size_t len = cards->len;
+    if (__unlikely(len >= 2 * GC_ARRAY_CARD_MAX)) {
+        // too many dirty cards; remember the whole object instead, which
+        // also stops the barrier from firing again
+        jl_gc_queue_root(owner);
+        return;
+    }
+    if (len && cards->items[len - 2] == (void*)owner &&
+        cards->items[len - 1] == (void*)card)
+        return;
+    arraylist_push(cards, (void*)owner);
+    arraylist_push(cards, (void*)card);
+    ptls->heap.remset_nptr += GC_ARRAY_CARD_SLOTS; // conservative
+}
+
 void gc_queue_binding(jl_binding_t *bnd)
 {
     jl_ptls_t ptls = jl_current_task->ptls;
@@ -1724,6 +2374,121 @@ STATIC_INLINE int gc_try_setmark(jl_value_t *obj, uintptr_t *nptr,
     return 0;
 }
 
+// Push a work item onto the shared mark queue and wake up an idle marker.
+static void gc_markwork_push(jl_gc_markwork_t *work)
+{
+    jl_gc_markwork_t *item = (jl_gc_markwork_t*)malloc_s(sizeof(jl_gc_markwork_t));
+    *item = *work;
+    uv_mutex_lock(&gc_markqueue_lock);
+    arraylist_push(&gc_markqueue, item);
+    uv_cond_signal(&gc_markqueue_cond);
+    uv_mutex_unlock(&gc_markqueue_lock);
+}
+
+// Offload the scanning of a premarked object (a remset entry) to the shared
+// mark queue.
+static void gc_markwork_share_scan_obj(jl_value_t *obj)
+{
+    jl_gc_markwork_t work = {obj, NULL, NULL, 0, 1, 0};
+    gc_markwork_push(&work);
+}
+
+// Split off the tail of a large object reference array range into the shared
+// mark queue and return the new end of the local range. Both halves keep
+// accumulating `nptr` independently, so the parent may end up in the remset
+// through more than one marker; remset entries are idempotent so this only
+// costs a duplicated entry, not correctness.
+static jl_value_t **gc_markwork_share_chunk(jl_value_t *parent, jl_value_t **begin,
+                                            jl_value_t **end, uint32_t step, uintptr_t nptr)
+{
+    if (gc_markqueue.len >= GC_MARK_SHARE_MAX_QUEUE)
+        return end;
+    size_t nslots = (end - begin) / step;
+    jl_value_t **mid = begin + (nslots / 2) * step;
+    jl_gc_markwork_t work = {parent, mid, end, step, 0, nptr};
+    gc_markwork_push(&work);
+    return mid;
+}
+
+static void jl_gc_queue_thread_local(jl_gc_mark_cache_t *gc_cache,
+                                     jl_gc_mark_sp_t *sp, jl_ptls_t ptls2);
+static void jl_gc_queue_remset(jl_gc_mark_cache_t *gc_cache,
+                               jl_gc_mark_sp_t *sp, jl_ptls_t ptls2);
+static void jl_gc_queue_bt_buf(jl_gc_mark_cache_t *gc_cache,
+                               jl_gc_mark_sp_t *sp, jl_ptls_t ptls2);
+
+// Called by `gc_mark_loop` when the local mark stack runs empty during a
+// parallel mark phase. `*active` tracks whether this marker is counted in
+// `gc_mark_nactive`; the last marker to go idle with an empty queue ends the
+// phase and releases everyone. Returns `1` with `*pnew_obj`/`*ptag`/`*pbits`
+// set if a queued object should be marked next, `-1` if work was pushed onto
+// the local mark stack instead, and `0` once the phase is over.
+static int gc_mark_loop_steal(jl_ptls_t ptls, jl_gc_mark_sp_t *sp, int *active,
+                              jl_value_t **pnew_obj, uintptr_t *ptag, uint8_t *pbits)
+{
+    uv_mutex_lock(&gc_markqueue_lock);
+    while (1) {
+        if (*active) {
+            *active = 0;
+            gc_mark_nactive--;
+            if (gc_mark_nactive == 0 && gc_markqueue.len == 0) {
+                // Nobody can produce more work: marking is done.
+                jl_atomic_store_relaxed(&gc_mark_parallel, 0);
+                uv_cond_broadcast(&gc_markqueue_cond);
+                break;
+            }
+        }
+        if (gc_markqueue.len) {
+            jl_gc_markwork_t *item = (jl_gc_markwork_t*)arraylist_pop(&gc_markqueue);
+            gc_mark_nactive++;
+            *active = 1;
+            uv_mutex_unlock(&gc_markqueue_lock);
+            jl_gc_markwork_t work = *item;
+            free(item);
+            if (work.begin) {
+                gc_mark_objarray_t data = {work.obj, work.begin, work.end,
+                                           work.step, work.nptr};
+                gc_mark_stack_push(&ptls->gc_cache, sp, gc_mark_label_addrs[GC_MARK_L_objarray],
+                                   &data, sizeof(data), 1);
+                return -1;
+            }
+            if (work.scan_only == 2) {
+                // A stopped thread's root set; enumerate it into our own
+                // mark stack (see step 2 of `_jl_gc_collect`). Only one
+                // marker processes a given thread, so the remset and
+                // binding list compaction stay single-writer.
+                jl_ptls_t ptls2 = (jl_ptls_t)work.obj;
+                jl_gc_queue_remset(&ptls->gc_cache, sp, ptls2);
+                jl_gc_queue_thread_local(&ptls->gc_cache, sp, ptls2);
+                jl_gc_queue_bt_buf(&ptls->gc_cache, sp, ptls2);
+                return -1;
+            }
+            if (work.scan_only) {
+                jl_taggedvalue_t *o = jl_astaggedvalue(work.obj);
+                uintptr_t tag = o->header;
+                gc_mark_marked_obj_t data = {work.obj, tag & ~(uintptr_t)0xf,
+                                             (uint8_t)(tag & 0xf)};
+                gc_mark_stack_push(&ptls->gc_cache, sp, gc_mark_label_addrs[GC_MARK_L_scan_only],
+                                   &data, sizeof(data), 1);
+                return -1;
+            }
+            uintptr_t nptr = 0;
+            if (gc_try_setmark(work.obj, &nptr, ptag, pbits)) {
+                *pnew_obj = work.obj;
+                return 1;
+            }
+            // Marked concurrently by another marker; look for more work.
+            uv_mutex_lock(&gc_markqueue_lock);
+            continue;
+        }
+        if (!jl_atomic_load_relaxed(&gc_mark_parallel))
+            break;
+        uv_cond_wait(&gc_markqueue_cond, &gc_markqueue_lock);
+    }
+    uv_mutex_unlock(&gc_markqueue_lock);
+    return 0;
+}
+
 // Queue a finalizer list to be scanned in the mark loop. Start marking from index `start`.
 void gc_mark_queue_finlist(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp,
                            arraylist_t *list, size_t start)
@@ -1809,19 +2574,74 @@ STATIC_INLINE void gc_mark_push_remset(jl_ptls_t ptls, jl_value_t *obj, uintptr_
 }
 
 // Scan a dense array of object references, see `gc_mark_objarray_t`
+// Software prefetch for the mark loop. Every `gc_try_setmark` starts with a
+// dependent load of the object header, so the scan loops below announce the
+// header they will visit a few slots ahead of the cursor; by the time the
+// cursor gets there the line is in flight or already present. The write
+// hint matches the header update in `gc_setmark_tag`. Prefetches never
+// fault, so candidate slots are not checked for `NULL`.
+#define GC_MARK_PREFETCH_DIST 8
+#if defined(__GNUC__)
+#define gc_mark_prefetch(obj) __builtin_prefetch(jl_astaggedvalue(obj), 1, 3)
+#else
+#define gc_mark_prefetch(obj) do { (void)(obj); } while (0)
+#endif
+
 STATIC_INLINE int gc_mark_scan_objarray(jl_ptls_t ptls, jl_gc_mark_sp_t *sp,
                                         gc_mark_objarray_t *objary,
                                         jl_value_t **begin, jl_value_t **end,
                                         jl_value_t **pnew_obj, uintptr_t *ptag, uint8_t *pbits)
 {
     (void)jl_assume(objary == (gc_mark_objarray_t*)sp->data);
+    if (__unlikely(jl_atomic_load_relaxed(&gc_mark_parallel)) &&
+        (size_t)(end - begin) >= GC_MARK_SHARE_MIN_CHUNK * objary->step) {
+        end = gc_markwork_share_chunk(objary->parent, begin, end,
+                                      objary->step, objary->nptr);
+        objary->end = end;
+    }
+    // cached page metadata for the leaf fast path below
+    char *leaf_page_data = NULL;
+    jl_gc_pagemeta_t *leaf_page_meta = NULL;
     for (; begin < end; begin += objary->step) {
+        if (begin + GC_MARK_PREFETCH_DIST * objary->step < end)
+            gc_mark_prefetch(begin[GC_MARK_PREFETCH_DIST * objary->step]);
         *pnew_obj = *begin;
         if (*pnew_obj)
             verify_parent2("obj array", objary->parent, begin, "elem(%d)",
                            gc_slot_to_arrayidx(objary->parent, begin));
         if (!gc_try_setmark(*pnew_obj, &objary->nptr, ptag, pbits))
             continue;
+        // Bulk fast path: a freshly marked object whose type holds no
+        // references needs no scanning, only its metadata update, so it is
+        // retired here instead of taking a round trip through the mark
+        // stack state machine. The page metadata lookup is cached across
+        // elements, which amortizes the pagetable walk when neighboring
+        // elements were allocated together (common for large arrays filled
+        // in order).
+        jl_datatype_t *vt = (jl_datatype_t*)*ptag;
+        if (!gc_verifying && vt->layout && vt->layout->npointers == 0 &&
+            vt->layout->fielddesc_type != 3 &&
+            vt != jl_simplevector_type && vt->name != jl_array_typename &&
+            vt != jl_module_type && vt != jl_task_type) {
+            jl_taggedvalue_t *o = jl_astaggedvalue(*pnew_obj);
+            if ((void*)o < sysimg_base || (void*)o >= sysimg_end) {
+                size_t dtsz = vt == jl_string_type ?
+                    jl_string_len(*pnew_obj) + sizeof(size_t) + 1 :
+                    jl_datatype_size(vt);
+                if (__likely(dtsz <= GC_MAX_SZCLASS)) {
+                    char *pd = gc_page_data(o);
+                    if (pd != leaf_page_data) {
+                        leaf_page_data = pd;
+                        leaf_page_meta = page_metadata(o);
+                    }
+                    gc_setmark_pool_(ptls, o, *pbits, leaf_page_meta);
+                }
+                else {
+                    gc_setmark_big(ptls, o, *pbits);
+                }
+            }
+            continue;
+        }
         begin += objary->step;
         // Found an object to mark
         if (begin < end) {
@@ -1851,6 +2671,8 @@ STATIC_INLINE int gc_mark_scan_array8(jl_ptls_t ptls, jl_gc_mark_sp_t *sp,
     size_t elsize = ((jl_array_t*)ary8->elem.parent)->elsize / sizeof(jl_value_t*);
     for (; begin < end; begin += elsize) {
         for (; elem_begin < elem_end; elem_begin++) {
+            if (elem_begin + GC_MARK_PREFETCH_DIST < elem_end)
+                gc_mark_prefetch(begin[elem_begin[GC_MARK_PREFETCH_DIST]]);
             jl_value_t **slot = &begin[*elem_begin];
             *pnew_obj = *slot;
             if (*pnew_obj)
@@ -1899,6 +2721,8 @@ STATIC_INLINE int gc_mark_scan_array16(jl_ptls_t ptls, jl_gc_mark_sp_t *sp,
     size_t elsize = ((jl_array_t*)ary16->elem.parent)->elsize / sizeof(jl_value_t*);
     for (; begin < end; begin += elsize) {
         for (; elem_begin < elem_end; elem_begin++) {
+            if (elem_begin + GC_MARK_PREFETCH_DIST < elem_end)
+                gc_mark_prefetch(begin[elem_begin[GC_MARK_PREFETCH_DIST]]);
             jl_value_t **slot = &begin[*elem_begin];
             *pnew_obj = *slot;
             if (*pnew_obj)
@@ -1945,6 +2769,8 @@ STATIC_INLINE int gc_mark_scan_obj8(jl_ptls_t ptls, jl_gc_mark_sp_t *sp, gc_mark
     (void)jl_assume(obj8 == (gc_mark_obj8_t*)sp->data);
     (void)jl_assume(begin < end);
     for (; begin < end; begin++) {
+        if (begin + GC_MARK_PREFETCH_DIST < end)
+            gc_mark_prefetch(((jl_value_t**)parent)[begin[GC_MARK_PREFETCH_DIST]]);
         jl_value_t **slot = &((jl_value_t**)parent)[*begin];
         *pnew_obj = *slot;
         if (*pnew_obj)
@@ -1978,6 +2804,8 @@ STATIC_INLINE int gc_mark_scan_obj16(jl_ptls_t ptls, jl_gc_mark_sp_t *sp, gc_mar
     (void)jl_assume(obj16 == (gc_mark_obj16_t*)sp->data);
     (void)jl_assume(begin < end);
     for (; begin < end; begin++) {
+        if (begin + GC_MARK_PREFETCH_DIST < end)
+            gc_mark_prefetch(((jl_value_t**)parent)[begin[GC_MARK_PREFETCH_DIST]]);
         jl_value_t **slot = &((jl_value_t**)parent)[*begin];
         *pnew_obj = *slot;
         if (*pnew_obj)
@@ -2011,6 +2839,8 @@ STATIC_INLINE int gc_mark_scan_obj32(jl_ptls_t ptls, jl_gc_mark_sp_t *sp, gc_mar
     (void)jl_assume(obj32 == (gc_mark_obj32_t*)sp->data);
     (void)jl_assume(begin < end);
     for (; begin < end; begin++) {
+        if (begin + GC_MARK_PREFETCH_DIST < end)
+            gc_mark_prefetch(((jl_value_t**)parent)[begin[GC_MARK_PREFETCH_DIST]]);
         jl_value_t **slot = &((jl_value_t**)parent)[*begin];
         *pnew_obj = *slot;
         if (*pnew_obj)
@@ -2161,6 +2991,11 @@ JL_EXTENSION NOINLINE void gc_mark_loop(jl_ptls_t ptls, jl_gc_mark_sp_t sp)
     uintptr_t tag = 0;
     uint8_t bits = 0;
     int meta_updated = 0;
+    // Whether this marker is counted in `gc_mark_nactive`. The collecting
+    // thread enters with queued roots and is pre-counted by
+    // `_jl_gc_collect`; helpers (negative `tid`) only become active once
+    // they take work from the shared queue.
+    int mark_active = ptls->tid >= 0;
 
     gc_mark_objarray_t *objary;
     jl_value_t **objary_begin;
@@ -2181,7 +3016,14 @@ JL_EXTENSION NOINLINE void gc_mark_loop(jl_ptls_t ptls, jl_gc_mark_sp_t sp)
 
 pop:
     if (sp.pc == sp.pc_start) {
-        // TODO: stealing form another thread
+        if (__unlikely(jl_atomic_load_relaxed(&gc_mark_parallel))) {
+            int ret = gc_mark_loop_steal(ptls, &sp, &mark_active,
+                                         &new_obj, &tag, &bits);
+            if (ret > 0)
+                goto mark;
+            if (ret < 0)
+                goto pop;
+        }
         return;
     }
     sp.pc--;
@@ -2687,6 +3529,14 @@ mark: {
                 gc_mark_stack_push(&ptls->gc_cache, &sp, gc_mark_laddr(excstack),
                                    &stackdata, sizeof(stackdata), 1);
             }
+            // the fast TLS slots live in the hidden part of the struct, so
+            // the layout-driven scan below does not cover them
+            objary_begin = ta->tls_slots;
+            objary_end = objary_begin + JL_TASK_TLS_NSLOTS;
+            gc_mark_objarray_t tlsdata = {new_obj, objary_begin, objary_end, 1,
+                                          (JL_TASK_TLS_NSLOTS << 2) | 1 | bits};
+            gc_mark_stack_push(&ptls->gc_cache, &sp, gc_mark_laddr(objarray),
+                               &tlsdata, sizeof(tlsdata), 1);
             const jl_datatype_layout_t *layout = jl_task_type->layout;
             assert(layout->fielddesc_type == 0);
             assert(layout->nfields > 0);
@@ -2787,9 +3637,275 @@ static void jl_gc_queue_thread_local(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp
         gc_mark_queue_obj(gc_cache, sp, ptls2->previous_exception);
 }
 
+// Entry point of the helper marker threads. They spend their life parked on
+// the queue condition and participate in every parallel mark phase by
+// running `gc_mark_loop` with an empty local stack, which sends them
+// straight to `gc_mark_loop_steal`. A bumped sweep epoch instead enlists
+// them in the parallel sweep of the malloc'd array and big object lists.
+static void gc_mark_threadfun(void *arg)
+{
+    jl_ptls_t ptls = (jl_ptls_t)arg;
+    int sweep_seen = 0;
+    while (1) {
+        uv_mutex_lock(&gc_markqueue_lock);
+        while (!jl_atomic_load_relaxed(&gc_mark_parallel) &&
+               jl_atomic_load_relaxed(&gc_sweep_heaps_epoch) == sweep_seen)
+            uv_cond_wait(&gc_markqueue_cond, &gc_markqueue_lock);
+        int sweep_epoch = jl_atomic_load_relaxed(&gc_sweep_heaps_epoch);
+        uv_mutex_unlock(&gc_markqueue_lock);
+        if (sweep_epoch != sweep_seen) {
+            sweep_seen = sweep_epoch;
+            gc_sweep_heaps_worker();
+            continue;
+        }
+        jl_gc_mark_sp_t sp;
+        gc_mark_sp_init(&ptls->gc_cache, &sp);
+        gc_mark_loop(ptls, sp);
+    }
+}
+
+// Allocate the pseudo thread local state for one helper marker. Only the
+// fields the mark path can touch are set up; the negative `tid` keeps the
+// helper from being pre-counted as active in `gc_mark_loop`.
+static jl_ptls_t gc_mark_helper_state_new(int i)
+{
+    jl_ptls_t ptls = (jl_ptls_t)malloc_s(sizeof(jl_tls_states_t));
+    memset(ptls, 0, sizeof(jl_tls_states_t));
+    ptls->tid = -(i + 2);
+    jl_thread_heap_t *heap = &ptls->heap;
+    heap->remset = &heap->_remset[0];
+    heap->last_remset = &heap->_remset[1];
+    arraylist_new(heap->remset, 0);
+    arraylist_new(heap->last_remset, 0);
+    jl_gc_mark_cache_t *gc_cache = &ptls->gc_cache;
+    size_t init_size = 1024;
+    gc_cache->pc_stack = (void**)malloc_s(init_size * sizeof(void*));
+    gc_cache->pc_stack_end = gc_cache->pc_stack + init_size;
+    gc_cache->data_stack = (jl_gc_mark_data_t *)malloc_s(init_size * sizeof(jl_gc_mark_data_t));
+    return ptls;
+}
+
+// Fold the helpers' marking state back into the collecting thread once the
+// parallel phase is over: flush their mark caches and hand over anything
+// they pushed onto their private remset and big object lists.
+static void gc_mark_parallel_finish(jl_ptls_t ptls)
+{
+    for (int i = 0; i < jl_n_markthreads; i++) {
+        jl_ptls_t ptls2 = gc_mark_helper_states[i];
+        gc_sync_cache_nolock(ptls, &ptls2->gc_cache);
+        arraylist_t *remset = ptls2->heap.remset;
+        for (size_t j = 0; j < remset->len; j++)
+            arraylist_push(ptls->heap.remset, remset->items[j]);
+        remset->len = 0;
+        ptls->heap.remset_nptr += ptls2->heap.remset_nptr;
+        ptls2->heap.remset_nptr = 0;
+        bigval_t *hdr = ptls2->heap.big_objects;
+        while (hdr) {
+            bigval_t *next = hdr->next;
+            gc_big_object_unlink(hdr);
+            gc_big_object_link(hdr, &ptls->heap.big_objects);
+            hdr = next;
+        }
+    }
+}
+
 void jl_gc_mark_enqueued_tasks(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp);
 extern jl_value_t *cmpswap_names JL_GLOBALLY_ROOTED;
 
+// Object pinning (see julia_gcext.h)
+//
+// A pinned object is treated as a global root, so foreign code can hold
+// pointers to it (or into its data, e.g. an array buffer handed to RDMA or
+// io_uring) without keeping a reference the collector can see. Since the
+// collector never relocates objects, a pin only has to keep its object
+// from being swept; the page it lives on needs no special treatment
+// because pages with live objects are never returned to the page manager.
+// Pins nest. The table maps the object to `count << 1` (a plain count
+// would collide with `HT_NOTFOUND`); the lock makes pinning safe from
+// threads the collector does not stop, so root marking takes it too.
+static htable_t gc_pinned_objects;
+static uv_mutex_t gc_pin_lock;
+
+JL_DLLEXPORT void jl_gc_pin_object(jl_value_t *obj)
+{
+    uv_mutex_lock(&gc_pin_lock);
+    void **bp = ptrhash_bp(&gc_pinned_objects, obj);
+    if (*bp == HT_NOTFOUND)
+        *bp = (void*)(uintptr_t)2;
+    else
+        *bp = (void*)((uintptr_t)*bp + 2);
+    uv_mutex_unlock(&gc_pin_lock);
+}
+
+JL_DLLEXPORT void jl_gc_unpin_object(jl_value_t *obj)
+{
+    uv_mutex_lock(&gc_pin_lock);
+    void **bp = ptrhash_bp(&gc_pinned_objects, obj);
+    assert(*bp != HT_NOTFOUND && "object is not pinned");
+    if ((uintptr_t)*bp <= 2)
+        ptrhash_remove(&gc_pinned_objects, obj);
+    else
+        *bp = (void*)((uintptr_t)*bp - 2);
+    uv_mutex_unlock(&gc_pin_lock);
+}
+
+// Optional per-datatype allocation accounting (see jl_gc_alloc_ in
+// julia_internal.h). Each thread owns an open-addressing table mapping the
+// type tag being written to an allocation count and byte total, so the
+// record path is a probe plus two relaxed increments with no locks. A table
+// grows (or is cleared) by publishing a replacement with a release store and
+// leaking the old one, so a concurrent query can finish scanning whatever
+// table it loaded; counter reads are racy, which is fine for statistics.
+JL_DLLEXPORT _Atomic(int) jl_alloc_count_enabled = 0;
+
+#define ALLOC_COUNT_INITIAL_SLOTS 512
+#define ALLOC_COUNT_MAX_PROBE 32
+
+typedef struct {
+    size_t nslots; // power of two
+    struct {
+        _Atomic(void*) ty;
+        _Atomic(uint64_t) count;
+        _Atomic(uint64_t) bytes;
+    } slots[];
+} jl_alloc_count_table_t;
+
+static _Atomic(jl_alloc_count_table_t*) *alloc_count_tables = NULL;
+
+static jl_alloc_count_table_t *alloc_count_table_new(size_t nslots) JL_NOTSAFEPOINT
+{
+    jl_alloc_count_table_t *t = (jl_alloc_count_table_t*)calloc(1,
+            sizeof(jl_alloc_count_table_t) + nslots * sizeof(t->slots[0]));
+    if (t == NULL)
+        abort();
+    t->nslots = nslots;
+    return t;
+}
+
+void jl_gc_count_alloc_typed(jl_ptls_t ptls, void *ty, size_t sz) JL_NOTSAFEPOINT
+{
+    if (alloc_count_tables == NULL)
+        return; // enabling flag was seen before the tables were published
+    _Atomic(jl_alloc_count_table_t*) *ptable = &alloc_count_tables[ptls->tid];
+    jl_alloc_count_table_t *t = jl_atomic_load_relaxed(ptable);
+    while (1) {
+        size_t mask = t->nslots - 1;
+        size_t i = (((uintptr_t)ty) >> 4) & mask;
+        for (size_t probes = 0; probes < ALLOC_COUNT_MAX_PROBE; probes++) {
+            void *k = jl_atomic_load_relaxed(&t->slots[i].ty);
+            if (k == NULL) {
+                // only the owning thread writes this table, so claiming the
+                // slot needs no cas; the release pairs with a query's
+                // acquire load of the table pointer
+                jl_atomic_store_release(&t->slots[i].ty, ty);
+                k = ty;
+            }
+            if (k == ty) {
+                jl_atomic_fetch_add_relaxed(&t->slots[i].count, 1);
+                jl_atomic_fetch_add_relaxed(&t->slots[i].bytes, sz);
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+        // probe limit hit: publish a table twice the size and retry there
+        jl_alloc_count_table_t *nt = alloc_count_table_new(t->nslots * 2);
+        for (i = 0; i < t->nslots; i++) {
+            void *k = jl_atomic_load_relaxed(&t->slots[i].ty);
+            if (k == NULL)
+                continue;
+            size_t j = (((uintptr_t)k) >> 4) & (nt->nslots - 1);
+            while (jl_atomic_load_relaxed(&nt->slots[j].ty) != NULL)
+                j = (j + 1) & (nt->nslots - 1);
+            jl_atomic_store_relaxed(&nt->slots[j].ty, k);
+            jl_atomic_store_relaxed(&nt->slots[j].count,
+                    jl_atomic_load_relaxed(&t->slots[i].count));
+            jl_atomic_store_relaxed(&nt->slots[j].bytes,
+                    jl_atomic_load_relaxed(&t->slots[i].bytes));
+        }
+        jl_atomic_store_release(ptable, nt);
+        t = nt;
+    }
+}
+
+JL_DLLEXPORT void jl_gc_alloc_counts_enable(int enable)
+{
+    if (enable && alloc_count_tables == NULL) {
+        _Atomic(jl_alloc_count_table_t*) *tables =
+            (_Atomic(jl_alloc_count_table_t*)*)calloc(jl_n_threads, sizeof(void*));
+        if (tables == NULL)
+            abort();
+        for (int t = 0; t < jl_n_threads; t++)
+            jl_atomic_store_relaxed(&tables[t], alloc_count_table_new(ALLOC_COUNT_INITIAL_SLOTS));
+        alloc_count_tables = tables;
+    }
+    jl_atomic_store_release(&jl_alloc_count_enabled, !!enable);
+}
+
+// drop all recorded counts; a thread racing with the reset may still add to
+// its superseded table, losing those events, which statistics can tolerate
+JL_DLLEXPORT void jl_gc_alloc_counts_clear(void)
+{
+    if (alloc_count_tables == NULL)
+        return;
+    for (int t = 0; t < jl_n_threads; t++)
+        jl_atomic_store_release(&alloc_count_tables[t],
+                alloc_count_table_new(ALLOC_COUNT_INITIAL_SLOTS));
+}
+
+// flat [type1, count1, bytes1, ...] snapshot merged over all threads,
+// mirroring the layout of the compile-time attribution queries in gf.c
+JL_DLLEXPORT jl_value_t *jl_gc_alloc_counts(void)
+{
+    typedef struct { void *ty; uint64_t count; uint64_t bytes; } snap_entry_t;
+    snap_entry_t *scratch = NULL;
+    size_t n = 0, cap = 0;
+    htable_t seen;
+    htable_new(&seen, 0);
+    if (alloc_count_tables != NULL) {
+        for (int t = 0; t < jl_n_threads; t++) {
+            jl_alloc_count_table_t *tab = jl_atomic_load_acquire(&alloc_count_tables[t]);
+            for (size_t i = 0; i < tab->nslots; i++) {
+                void *ty = jl_atomic_load_acquire(&tab->slots[i].ty);
+                // GC-internal buffers carry the buff tag, not a type
+                if (ty == NULL || ty == (void*)jl_buff_tag)
+                    continue;
+                uint64_t count = jl_atomic_load_relaxed(&tab->slots[i].count);
+                uint64_t bytes = jl_atomic_load_relaxed(&tab->slots[i].bytes);
+                if (count == 0)
+                    continue;
+                void *hit = ptrhash_get(&seen, ty);
+                if (hit == HT_NOTFOUND) {
+                    if (n == cap) {
+                        cap = cap ? cap * 2 : 64;
+                        scratch = (snap_entry_t*)realloc_s(scratch, cap * sizeof(snap_entry_t));
+                    }
+                    scratch[n].ty = ty;
+                    scratch[n].count = count;
+                    scratch[n].bytes = bytes;
+                    ptrhash_put(&seen, ty, (void*)(n + 1));
+                    n++;
+                }
+                else {
+                    size_t idx = (size_t)(uintptr_t)hit - 1;
+                    scratch[idx].count += count;
+                    scratch[idx].bytes += bytes;
+                }
+            }
+        }
+    }
+    htable_free(&seen);
+    jl_array_t *a = jl_alloc_vec_any(3 * n);
+    JL_GC_PUSH1(&a);
+    for (size_t i = 0; i < n; i++) {
+        jl_array_ptr_set(a, 3 * i, (jl_value_t*)scratch[i].ty);
+        jl_array_ptr_set(a, 3 * i + 1, jl_box_uint64(scratch[i].count));
+        jl_array_ptr_set(a, 3 * i + 2, jl_box_uint64(scratch[i].bytes));
+    }
+    JL_GC_POP();
+    free(scratch);
+    return (jl_value_t*)a;
+}
+
 // mark the initial root set
 static void mark_roots(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp)
 {
@@ -2810,13 +3926,86 @@ static void mark_roots(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp)
         }
     }
     gc_mark_queue_obj(gc_cache, sp, jl_anytuple_type_type);
-    for (size_t i = 0; i < N_CALL_CACHE; i++) {
+    for (size_t i = 0; i < jl_call_cache_size; i++) {
         jl_typemap_entry_t *v = jl_atomic_load_relaxed(&call_cache[i]);
         if (v != NULL)
             gc_mark_queue_obj(gc_cache, sp, v);
     }
+    for (jl_callsite_block_t *block = jl_atomic_load_relaxed(&jl_callsite_blocks);
+            block != NULL; block = block->next) {
+        for (size_t i = 0; i < block->used; i++) {
+            jl_typemap_entry_t *v = jl_atomic_load_relaxed(&block->slots[i]);
+            if (v != NULL)
+                gc_mark_queue_obj(gc_cache, sp, v);
+        }
+    }
+    for (size_t i = 0; i < JL_N_MATCH_CACHE; i++) {
+        jl_match_cache_entry_t *e = &jl_match_cache[i];
+        if (e->sig != NULL) {
+            gc_mark_queue_obj(gc_cache, sp, e->sig);
+            gc_mark_queue_obj(gc_cache, sp, e->matches);
+            gc_mark_queue_obj(gc_cache, sp, e->mt);
+        }
+    }
+    for (size_t i = 0; i < JL_N_SUBTYPE_CACHE; i++) {
+        jl_subtype_cache_entry_t *e = &jl_subtype_cache[i];
+        if (e->x != NULL) {
+            gc_mark_queue_obj(gc_cache, sp, e->x);
+            gc_mark_queue_obj(gc_cache, sp, e->y);
+        }
+    }
+    for (size_t i = 0; i < JL_N_INTERSECT_CACHE; i++) {
+        jl_intersect_cache_entry_t *e = &jl_intersect_cache[i];
+        if (e->a != NULL) {
+            gc_mark_queue_obj(gc_cache, sp, e->a);
+            gc_mark_queue_obj(gc_cache, sp, e->b);
+            gc_mark_queue_obj(gc_cache, sp, e->ti);
+            if (e->env != NULL)
+                gc_mark_queue_obj(gc_cache, sp, e->env);
+        }
+    }
+    for (size_t i = 0; i < JL_N_HAS_FREE_CACHE; i++) {
+        uintptr_t w = jl_atomic_load_relaxed(&jl_has_free_cache[i]);
+        if (w != 0)
+            gc_mark_queue_obj(gc_cache, sp, (jl_value_t*)(w & ~(uintptr_t)1));
+    }
+    for (size_t i = 0; i < JL_N_SMALL_STRING_CACHE; i++) {
+        jl_value_t *s = jl_atomic_load_relaxed(&jl_small_string_cache[i]);
+        if (s != NULL)
+            gc_mark_queue_obj(gc_cache, sp, s);
+    }
+    for (size_t i = 1; i < jl_compile_time_module_table.size; i += 2) {
+        if (jl_compile_time_module_table.table[i] != HT_NOTFOUND)
+            gc_mark_queue_obj(gc_cache, sp, jl_compile_time_module_table.table[i - 1]);
+    }
+    for (size_t i = 1; i < jl_compile_time_method_table.size; i += 2) {
+        if (jl_compile_time_method_table.table[i] != HT_NOTFOUND)
+            gc_mark_queue_obj(gc_cache, sp, jl_compile_time_method_table.table[i - 1]);
+    }
+    for (size_t i = 0; i < UNION_COMPONENT_CACHE_SIZE; i++) {
+        // pinning the key keeps its address from being recycled by another
+        // union, which is what makes the pointer-equality hit test sound
+        jl_union_components_t *fc = jl_atomic_load_relaxed(&jl_union_component_cache[i]);
+        if (fc != NULL)
+            gc_mark_queue_obj(gc_cache, sp, fc->u);
+    }
+    if (alloc_count_tables != NULL) {
+        // keep the recorded type tags valid for later queries
+        for (int t = 0; t < jl_n_threads; t++) {
+            jl_alloc_count_table_t *tab = jl_atomic_load_relaxed(&alloc_count_tables[t]);
+            for (size_t i = 0; i < tab->nslots; i++) {
+                void *ty = jl_atomic_load_relaxed(&tab->slots[i].ty);
+                if (ty != NULL && ty != (void*)jl_buff_tag)
+                    gc_mark_queue_obj(gc_cache, sp, ty);
+            }
+        }
+    }
     if (jl_all_methods != NULL)
         gc_mark_queue_obj(gc_cache, sp, jl_all_methods);
+    if (jl_method_batch != NULL)
+        gc_mark_queue_obj(gc_cache, sp, jl_method_batch);
+    if (jl_typemap_spares != NULL)
+        gc_mark_queue_obj(gc_cache, sp, jl_typemap_spares);
     if (_jl_debug_method_invalidation != NULL)
         gc_mark_queue_obj(gc_cache, sp, _jl_debug_method_invalidation);
 
@@ -2824,6 +4013,14 @@ static void mark_roots(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp)
     gc_mark_queue_obj(gc_cache, sp, jl_emptytuple_type);
     if (cmpswap_names != NULL)
         gc_mark_queue_obj(gc_cache, sp, cmpswap_names);
+
+    // pinned objects
+    uv_mutex_lock(&gc_pin_lock);
+    for (size_t i = 0; i < gc_pinned_objects.size; i += 2) {
+        if (gc_pinned_objects.table[i + 1] != HT_NOTFOUND)
+            gc_mark_queue_obj(gc_cache, sp, gc_pinned_objects.table[i]);
+    }
+    uv_mutex_unlock(&gc_pin_lock);
 }
 
 // find unmarked objects that need to be finalized from the finalizer list "list".
@@ -2843,9 +4040,16 @@ static void sweep_finalizer_list(arraylist_t *list)
 
         void *fin = items[i+1];
         int isfreed = !gc_marked(jl_astaggedvalue(v)->bits.gc);
+        // an entry moves to `finalizer_list_marked` (only swept at full
+        // collections) once everything it keeps alive is old. For tagged
+        // entries the finalizer is an unboxed C function pointer with no GC
+        // age at all, so only the object's age matters; without this check
+        // such entries read a bogus tag and mostly stay here, leaving large
+        // ptr-finalizer populations rescanned at every quick collection.
         int isold = (list != &finalizer_list_marked &&
                      jl_astaggedvalue(v)->bits.gc == GC_OLD_MARKED &&
-                     jl_astaggedvalue(fin)->bits.gc == GC_OLD_MARKED);
+                     (gc_ptr_tag(v0, 1) ||
+                      jl_astaggedvalue(fin)->bits.gc == GC_OLD_MARKED));
         if (isfreed || isold) {
             // remove from this list
         }
@@ -2972,8 +4176,43 @@ static void jl_gc_queue_remset(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp
 {
     size_t len = ptls2->heap.last_remset->len;
     void **items = ptls2->heap.last_remset->items;
-    for (size_t i = 0; i < len; i++)
-        gc_mark_queue_scan_obj(gc_cache, sp, (jl_value_t*)items[i]);
+    if (jl_atomic_load_relaxed(&gc_mark_parallel)) {
+        // Remset entries are premarked and scanned independently, which
+        // makes them the natural unit to hand out to the helper markers.
+        for (size_t i = 0; i < len; i++)
+            gc_markwork_share_scan_obj((jl_value_t*)items[i]);
+    }
+    else {
+        for (size_t i = 0; i < len; i++)
+            gc_mark_queue_scan_obj(gc_cache, sp, (jl_value_t*)items[i]);
+    }
+    // scan the dirtied cards of old object arrays; a card stays remembered
+    // as long as it still references young objects, mirroring the remset
+    // invariant at card granularity
+    len = ptls2->heap.rem_cards.len;
+    items = ptls2->heap.rem_cards.items;
+    size_t ncards = 0;
+    for (size_t i = 0; i < len; i += 2) {
+        jl_array_t *a = (jl_array_t*)items[i];
+        size_t card = (size_t)items[i + 1];
+        size_t begin = card * GC_ARRAY_CARD_SLOTS;
+        size_t end = begin + GC_ARRAY_CARD_SLOTS;
+        size_t alen = jl_array_len(a);
+        if (end > alen)
+            end = alen;
+        int refyoung = 0;
+        jl_value_t **data = (jl_value_t**)a->data;
+        for (size_t j = begin; j < end; j++) {
+            jl_value_t *v = data[j];
+            if (v && gc_mark_queue_obj(gc_cache, sp, v))
+                refyoung = 1;
+        }
+        if (refyoung) {
+            items[ncards++] = (void*)a;
+            items[ncards++] = (void*)card;
+        }
+    }
+    ptls2->heap.rem_cards.len = ncards;
     int n_bnd_refyoung = 0;
     len = ptls2->heap.rem_bindings.len;
     items = ptls2->heap.rem_bindings.items;
@@ -3023,8 +4262,27 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     for (int t_i = 0; t_i < jl_n_threads; t_i++)
         jl_gc_premark(jl_all_tls_states[t_i]);
 
+    if (jl_n_markthreads > 0) {
+        // Open the parallel mark phase. The helpers start pulling from the
+        // shared queue while this thread is still queueing roots; the
+        // premark above must be complete before any marking starts.
+        uv_mutex_lock(&gc_markqueue_lock);
+        gc_mark_nactive = 1; // the collecting thread
+        jl_atomic_store_relaxed(&gc_mark_parallel, 1);
+        uv_cond_broadcast(&gc_markqueue_cond);
+        uv_mutex_unlock(&gc_markqueue_lock);
+    }
+
     for (int t_i = 0; t_i < jl_n_threads; t_i++) {
         jl_ptls_t ptls2 = jl_all_tls_states[t_i];
+        if (jl_n_markthreads > 0) {
+            // 2. hand each stopped thread's root set to the marker pool as
+            // one work item, so root enumeration is partitioned across the
+            // markers instead of being serialized on this thread
+            jl_gc_markwork_t work = {(jl_value_t*)ptls2, NULL, NULL, 0, 2, 0};
+            gc_markwork_push(&work);
+            continue;
+        }
         // 2.1. mark every object in the `last_remsets` and `rem_binding`
         jl_gc_queue_remset(gc_cache, &sp, ptls2);
         // 2.2. mark every thread local root
@@ -3042,9 +4300,13 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
         import_gc_state(ptls, &sp);
     }
     gc_mark_loop(ptls, sp);
+    if (jl_n_markthreads > 0)
+        gc_mark_parallel_finish(ptls);
     gc_mark_sp_init(gc_cache, &sp);
     gc_num.since_sweep += gc_num.allocd;
     JL_PROBE_GC_MARK_END(scanned_bytes, perm_scanned_bytes);
+    gc_phase_stats.last_mark_time = jl_hrtime() - t0;
+    gc_phase_stats.total_mark_time += gc_phase_stats.last_mark_time;
     gc_settime_premark_end();
     gc_time_mark_pause(t0, scanned_bytes, perm_scanned_bytes);
     int64_t actual_allocd = gc_num.since_sweep;
@@ -3081,6 +4343,14 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     // and should not be referenced by any old objects so this won't break
     // the GC invariant.
     gc_mark_queue_finlist(gc_cache, &sp, &to_finalize, 0);
+    if (gc_finalizer_thread_enabled) {
+        // C finalizers waiting on (or currently run by) the background
+        // thread still reference their objects.
+        uv_mutex_lock(&gc_finalizer_queue_lock);
+        gc_mark_queue_finlist(gc_cache, &sp, &gc_finalizer_queue,
+                              gc_finalizer_queue_head);
+        uv_mutex_unlock(&gc_finalizer_queue_lock);
+    }
     gc_mark_loop(ptls, sp);
     mark_reset_age = 0;
     gc_settime_postmark_end();
@@ -3124,6 +4394,16 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
          grown_heap_age > 1) && gc_num.pause > 1) {
         sweep_full = 1;
     }
+    // pause-target mode: project the next full pause from the last one and
+    // keep collecting quickly while it would blow the budget (see the knob
+    // definition for the bounds on this deferral)
+    if (sweep_full && gc_max_pause_ns && collection == JL_GC_AUTO &&
+        gc_last_full_pause > gc_max_pause_ns &&
+        gc_deferred_full < GC_MAX_PAUSE_DEFER_LIMIT &&
+        live_bytes < (int64_t)(max_total_memory / 5 * 4)) {
+        sweep_full = 0;
+        gc_deferred_full++;
+    }
     // update heuristics only if this GC was automatically triggered
     if (collection == JL_GC_AUTO) {
         if (sweep_full) {
@@ -3145,6 +4425,11 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
                 gc_num.interval = default_collect_interval;
         }
     }
+    if (live_bytes >= (int64_t)(max_total_memory / 5 * 4)) {
+        // approaching the soft heap limit; only full collections can shrink
+        // the old generation, so stop deferring them
+        sweep_full = 1;
+    }
     if (gc_sweep_always_full) {
         sweep_full = 1;
     }
@@ -3160,8 +4445,11 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     }
     scanned_bytes = 0;
     // 5. start sweeping
+    uint64_t sweep_t0 = jl_hrtime();
     JL_PROBE_GC_SWEEP_BEGIN(sweep_full);
+    gc_sweep_wait_concurrent();
     sweep_weak_refs();
+    jl_free_retired_binding_caches();
     sweep_stack_pools();
     gc_sweep_foreign_objs();
     gc_sweep_other(ptls, sweep_full);
@@ -3170,7 +4458,10 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     gc_sweep_pool(sweep_full);
     if (sweep_full)
         gc_sweep_perm_alloc();
+    gc_sweep_start_concurrent();
     JL_PROBE_GC_SWEEP_END();
+    gc_phase_stats.last_sweep_time = jl_hrtime() - sweep_t0;
+    gc_phase_stats.total_sweep_time += gc_phase_stats.last_sweep_time;
     // sweeping is over
     // 6. if it is a quick sweep, put back the remembered objects in queued state
     // so that we don't trigger the barrier again on them.
@@ -3188,6 +4479,9 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
         else {
             ptls2->heap.remset->len = 0;
             ptls2->heap.rem_bindings.len = 0;
+            // a full sweep demotes the old generation, so the cards are
+            // re-discovered by the write barrier as needed
+            ptls2->heap.rem_cards.len = 0;
         }
     }
 
@@ -3205,6 +4499,17 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
 
     uint64_t gc_end_t = jl_hrtime();
     uint64_t pause = gc_end_t - t0;
+    if (sweep_full) {
+        gc_last_full_pause = pause;
+        gc_deferred_full = 0;
+    }
+    {
+        uint64_t us = pause / 1000;
+        int bucket = 0;
+        while (bucket < JL_GC_PAUSE_NBUCKETS - 1 && (us >> (bucket + 1)) != 0)
+            bucket++;
+        gc_phase_stats.pause_hist[bucket]++;
+    }
     gc_final_pause_end(t0, gc_end_t);
     gc_time_sweep_pause(gc_end_t, actual_allocd, live_bytes,
                         estimate_freed, sweep_full);
@@ -3212,6 +4517,15 @@ static int _jl_gc_collect(jl_ptls_t ptls, jl_gc_collection_t collection)
     gc_num.allocd = 0;
     last_live_bytes = live_bytes;
     live_bytes += -gc_num.freed + gc_num.since_sweep;
+    // pace the next collection so the heap stays under the soft limit
+    if (collection == JL_GC_AUTO && live_bytes + (int64_t)gc_num.interval > (int64_t)max_total_memory) {
+        if (live_bytes < (int64_t)max_total_memory)
+            gc_num.interval = max_total_memory - live_bytes;
+        else
+            // we cannot stay under the limit; re-trigger as soon as the
+            // next allocation burst starts
+            gc_num.interval = default_collect_interval / 8;
+    }
     if (prev_sweep_full) {
         last_full_live = live_bytes;
         grown_heap_age = 0;
@@ -3287,7 +4601,10 @@ JL_DLLEXPORT void jl_gc_collect(jl_gc_collection_t collection)
     if (!ptls->finalizers_inhibited && ptls->locks.len == 0) {
         int8_t was_in_finalizer = ptls->in_finalizer;
         ptls->in_finalizer = 1;
+        uint64_t fin_t0 = jl_hrtime();
         run_finalizers(ct);
+        gc_phase_stats.last_finalizer_time = jl_hrtime() - fin_t0;
+        gc_phase_stats.total_finalizer_time += gc_phase_stats.last_finalizer_time;
         ptls->in_finalizer = was_in_finalizer;
     }
     JL_PROBE_GC_FINALIZER();
@@ -3333,6 +4650,7 @@ void jl_init_thread_heap(jl_ptls_t ptls)
     heap->mafreelist = NULL;
     heap->big_objects = NULL;
     arraylist_new(&heap->rem_bindings, 0);
+    arraylist_new(&heap->rem_cards, 0);
     heap->remset = &heap->_remset[0];
     heap->last_remset = &heap->_remset[1];
     arraylist_new(heap->remset, 0);
@@ -3360,10 +4678,27 @@ void jl_gc_init(void)
     JL_MUTEX_INIT(&finalizers_lock);
     uv_mutex_init(&gc_cache_lock);
     uv_mutex_init(&gc_perm_lock);
+    uv_mutex_init(&gc_markqueue_lock);
+    uv_mutex_init(&gc_arena_lock);
+    uv_mutex_init(&gc_pin_lock);
+    htable_new(&gc_pinned_objects, 0);
+#ifdef _OS_LINUX_
+    uv_mutex_init(&bigbuf_lock);
+    htable_new(&bigbuf_map, 0);
+#endif
+    uv_cond_init(&gc_markqueue_cond);
+    arraylist_new(&gc_markqueue, 0);
 
     jl_gc_init_page();
+    jl_init_stack_pools();
     jl_gc_debug_init();
 
+    // rounded-up reciprocals for gc_div_osize; exact for dividends below
+    // 2^32 / osize, far beyond any in-page offset
+    for (int i = 0; i < JL_GC_N_POOLS; i++)
+        gc_osize_inv[i] = (uint32_t)((((uint64_t)1 << 32) + jl_gc_sizeclasses[i] - 1) /
+                                     jl_gc_sizeclasses[i]);
+
     arraylist_new(&finalizer_list_marked, 0);
     arraylist_new(&to_finalize, 0);
 
@@ -3383,6 +4718,90 @@ void jl_gc_init(void)
 #endif
     jl_gc_mark_sp_t sp = {NULL, NULL, NULL, NULL};
     gc_mark_loop(NULL, sp);
+
+    if (jl_options.heap_size_hint)
+        jl_gc_set_max_memory(jl_options.heap_size_hint);
+
+    char *cp = getenv("JULIA_GC_CONCURRENT_SWEEP");
+    if (cp && strcmp(cp, "0") != 0) {
+        uv_mutex_init(&gc_sweep_lock);
+        uv_cond_init(&gc_sweep_cond);
+        arraylist_new(&gc_sweep_pending_pages, 0);
+        uv_thread_t thread;
+        if (uv_thread_create(&thread, gc_sweep_threadfun, NULL) == 0)
+            gc_concurrent_sweep = 1;
+    }
+
+    cp = getenv("JULIA_GC_MAX_PAUSE");
+    if (cp) {
+        double ms = strtod(cp, NULL);
+        if (ms > 0)
+            gc_max_pause_ns = (uint64_t)(ms * 1e6);
+    }
+
+    cp = getenv("JULIA_GC_PROMOTE_AGE");
+    if (cp) {
+        int age = (int)strtol(cp, NULL, 10);
+        if (age < 1)
+            age = 1;
+        else if (age > MAX_PROMOTE_AGE)
+            age = MAX_PROMOTE_AGE;
+        jl_gc_promote_age = age;
+    }
+
+    cp = getenv("JULIA_GC_FINALIZER_THREAD");
+    if (cp && strcmp(cp, "0") != 0) {
+        uv_mutex_init(&gc_finalizer_queue_lock);
+        uv_cond_init(&gc_finalizer_queue_cond);
+        arraylist_new(&gc_finalizer_queue, 0);
+        uv_thread_t thread;
+        if (uv_thread_create(&thread, gc_finalizer_threadfun, NULL) == 0)
+            gc_finalizer_thread_enabled = 1;
+    }
+
+    // Spawn the parallel marker threads (after the label addresses above
+    // have been recorded).
+    cp = getenv("JULIA_GC_MARK_THREADS");
+    if (cp) {
+        int n = (int)strtol(cp, NULL, 10);
+        if (n > 0) {
+            jl_n_markthreads = n;
+            gc_mark_helper_states = (jl_ptls_t*)malloc_s(n * sizeof(jl_ptls_t));
+            for (int i = 0; i < n; i++) {
+                gc_mark_helper_states[i] = gc_mark_helper_state_new(i);
+                uv_thread_t thread;
+                if (uv_thread_create(&thread, gc_mark_threadfun,
+                                     gc_mark_helper_states[i]) != 0) {
+                    jl_n_markthreads = i;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+JL_DLLEXPORT void jl_gc_set_max_memory(uint64_t max_mem)
+{
+#ifndef _P64
+    if (max_mem > (uint64_t)2 << 30)
+        max_mem = (uint64_t)2 << 30;
+#endif
+    max_total_memory = max_mem;
+}
+
+JL_DLLEXPORT jl_gc_phase_stats_t jl_gc_phase_stats(void)
+{
+    return gc_phase_stats;
+}
+
+// Copy up to `n` of the per-pool promotion counters into `counts` and
+// return the number of pool size classes.
+JL_DLLEXPORT int jl_gc_get_pool_promoted(uint64_t *counts, int n)
+{
+    if (n > JL_GC_N_POOLS)
+        n = JL_GC_N_POOLS;
+    memcpy(counts, gc_pool_promoted, n * sizeof(uint64_t));
+    return JL_GC_N_POOLS;
 }
 
 // callback for passing OOM errors from gmp
@@ -3530,7 +4949,13 @@ JL_DLLEXPORT void *jl_gc_managed_malloc(size_t sz)
 #ifdef _OS_WINDOWS_
     DWORD last_error = GetLastError();
 #endif
-    void *b = malloc_cache_align(allocsz);
+    void *b = NULL;
+#ifdef _OS_LINUX_
+    if (allocsz >= BIGBUF_MMAP_THRESH)
+        b = bigbuf_alloc(allocsz);
+#endif
+    if (b == NULL)
+        b = malloc_cache_align(allocsz);
     if (b == NULL)
         jl_throw(jl_memory_exception);
 #ifdef _OS_WINDOWS_
@@ -3568,6 +4993,12 @@ static void *gc_managed_realloc_(jl_ptls_t ptls, void *d, size_t sz, size_t olds
     DWORD last_error = GetLastError();
 #endif
     void *b;
+#ifdef _OS_LINUX_
+    size_t oldmapsz = bigbuf_size(d);
+    if (oldmapsz != 0)
+        b = bigbuf_realloc(d, oldmapsz, allocsz);
+    else
+#endif
     if (isaligned)
         b = realloc_cache_align(d, allocsz, oldsz);
     else
@@ -3800,7 +5231,9 @@ JL_DLLEXPORT jl_value_t *jl_gc_internal_obj_base_ptr(void *p)
         // offset within object
         size_t off2 = (off - GC_PAGE_OFFSET);
         size_t osize = meta->osize;
-        off2 %= osize;
+        // off2 %= osize, with the divide replaced by a reciprocal multiply;
+        // this runs once per candidate pointer during conservative scans
+        off2 -= gc_div_osize(off2, meta->pool_n) * osize;
         if (off - off2 + osize > GC_PAGE_SZ)
             return NULL;
         jl_taggedvalue_t *cell = (jl_taggedvalue_t *)((char *)p - off2);
@@ -3850,11 +5283,11 @@ JL_DLLEXPORT jl_value_t *jl_gc_internal_obj_base_ptr(void *p)
         //   a lower address will be an allocated object, and for cells
         //   with the same or a higher address, the corresponding age
         //   bit will reflect whether it's on the freelist.
-        // Age bits are set in sweep_page() and are 0 for freelist
-        // entries and 1 for live objects. The above subcases arise
-        // because allocating a cell will not update the age bit, so we
+        // Age fields are set in sweep_page() and are 0 for freelist
+        // entries and nonzero for live objects. The above subcases arise
+        // because allocating a cell will not update the age field, so we
         // need extra logic for pages that have been allocated from.
-        unsigned obj_id = (off - off2) / osize;
+        unsigned obj_id = gc_div_osize(off - off2, meta->pool_n);
         // We now distinguish between the second and third subcase.
         // Freelist entries are consumed in ascending order. Anything
         // before the freelist pointer was either live during the last
@@ -3862,9 +5295,9 @@ JL_DLLEXPORT jl_value_t *jl_gc_internal_obj_base_ptr(void *p)
         if (gc_page_data(cell) == gc_page_data(pool->freelist)
             && (char *)cell < (char *)pool->freelist)
             goto valid_object;
-        // We know now that the age bit reflects liveness status during
+        // We know now that the age field reflects liveness status during
         // the last sweep and that the cell has not been reused since.
-        if (!(meta->ages[obj_id / 8] & (1 << (obj_id % 8)))) {
+        if (!(meta->ages[obj_id / 4] & (3 << ((obj_id % 4) * 2)))) {
             return NULL;
         }
         // Not a freelist entry, therefore a valid object.
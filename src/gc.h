@@ -73,6 +73,26 @@ typedef struct {
     int         full_sweep;
 } jl_gc_num_t;
 
+// Always-available GC phase statistics, queryable at runtime through
+// `jl_gc_phase_stats` (unlike the GC_TIME/GC_FINAL_STATS instrumentation,
+// which needs a rebuild). Times are in nanoseconds. The remset scan is
+// part of the mark phase in this collector, so it has no separate entry.
+#define JL_GC_PAUSE_NBUCKETS 16
+typedef struct {
+    uint64_t    last_mark_time;
+    uint64_t    last_sweep_time;
+    uint64_t    last_finalizer_time;
+    uint64_t    total_mark_time;
+    uint64_t    total_sweep_time;
+    uint64_t    total_finalizer_time;
+    uint64_t    promoted_bytes; // cumulative bytes promoted to the old generation
+    uint64_t    pages_allocd;   // cumulative pool pages handed to the pools
+    uint64_t    pages_freed;    // cumulative pool pages returned
+    // pause histogram: bucket `i` counts pauses in [2^i, 2^(i+1))
+    // microseconds; the last bucket also counts everything longer
+    uint64_t    pause_hist[JL_GC_PAUSE_NBUCKETS];
+} jl_gc_phase_stats_t;
+
 enum {
     GC_MARK_L_marked_obj,
     GC_MARK_L_scan_only,
@@ -265,7 +285,7 @@ typedef struct _mallocarray_t {
 } mallocarray_t;
 
 // pool page metadata
-typedef struct {
+typedef struct _jl_gc_pagemeta_t {
     // index of pool that owns this page
     uint8_t pool_n;
     // Whether any cell in the page is marked
@@ -298,8 +318,17 @@ typedef struct {
     uint16_t thread_n;        // thread id of the heap that owns this page
     char *data;
     uint8_t *ages;
+    // Side mark bitmap, 1 bit per object slot (set in `gc_setmark_pool_`,
+    // rewritten by `sweep_page`). At sweep time bit `i` equals
+    // `gc_marked(bits)` of the object at slot `i`, which lets the sweep
+    // walk mark state a word at a time without loading dead objects'
+    // headers.
+    uint32_t *markbits;
 } jl_gc_pagemeta_t;
 
+// number of 32-bit words in a page's side mark bitmap
+#define GC_PAGE_MARKBITS_NW(osize) ((GC_PAGE_SZ / (osize) + 31) / 32)
+
 // Page layout:
 //  Newpage freelist: sizeof(void*)
 //  Padding: GC_PAGE_OFFSET - sizeof(void*)
@@ -379,6 +408,17 @@ STATIC_INLINE unsigned ffs_u32(uint32_t bitvec)
 #endif
 
 extern jl_gc_num_t gc_num;
+extern jl_gc_phase_stats_t gc_phase_stats;
+// 32.32 fixed-point reciprocals of jl_gc_sizeclasses, filled in by
+// jl_gc_init; gc_div_osize below is exact for any offset within a page
+extern uint32_t gc_osize_inv[JL_GC_N_POOLS];
+// floor(off / jl_gc_sizeclasses[pool_n]) without a hardware divide, for
+// off < GC_PAGE_SZ (object-id and remainder math on sweep and the
+// conservative-scan base-pointer lookup)
+STATIC_INLINE unsigned gc_div_osize(size_t off, int pool_n) JL_NOTSAFEPOINT
+{
+    return (unsigned)(((uint64_t)off * gc_osize_inv[pool_n]) >> 32);
+}
 extern pagetable_t memory_map;
 extern bigval_t *big_objects_marked;
 extern arraylist_t finalizer_list_marked;
@@ -509,6 +549,7 @@ void gc_mark_queue_finlist(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp,
                            arraylist_t *list, size_t start);
 void gc_mark_loop(jl_ptls_t ptls, jl_gc_mark_sp_t sp);
 void sweep_stack_pools(void);
+void jl_init_stack_pools(void);
 void jl_gc_debug_init(void);
 
 extern void *gc_mark_label_addrs[_GC_MARK_L_MAX];
@@ -518,6 +559,7 @@ extern void *gc_mark_label_addrs[_GC_MARK_L_MAX];
 void jl_gc_init_page(void);
 NOINLINE jl_gc_pagemeta_t *jl_gc_alloc_page(void) JL_NOTSAFEPOINT;
 void jl_gc_free_page(void *p) JL_NOTSAFEPOINT;
+void jl_gc_flush_page_caches(void);
 
 // GC debug
 
@@ -24,7 +24,15 @@
 extern "C" {
 #endif
 
-JL_DLLEXPORT _Atomic(size_t) jl_world_counter = 1; // uses atomic acquire/release
+// The world counter is written by every method definition and read whenever a
+// thread enters a new world (task start, toplevel eval, invokelatest). Note
+// that dispatch itself never loads it: `jl_apply_generic` and the invoke
+// lookup paths use the task-local `world_age` snapshot, which changes only at
+// those entry points. Keep the counter on its own cache line so that the
+// remaining acquire loads do not ping-pong with writes to neighboring
+// mutable globals.
+JL_DLLEXPORT _Atomic(size_t) jl_world_counter
+    __attribute__((aligned(JL_CACHE_BYTE_ALIGNMENT))) = 1; // uses atomic acquire/release
 JL_DLLEXPORT size_t jl_get_world_counter(void) JL_NOTSAFEPOINT
 {
     return jl_atomic_load_acquire(&jl_world_counter);
@@ -98,6 +106,24 @@ static int speccache_eq(size_t idx, const void *ty, jl_svec_t *data, uint_t hv)
     return jl_types_equal(sig, (jl_value_t*)ty);
 }
 
+// Insertion-cursor hints for the hashed prefix of m->specializations: map a
+// method to the index of its first open slot, so that insertion-heavy loads
+// do not rescan the whole filled prefix for every new specialization. A hint
+// is verified against the svec contents before use (the first open slot is
+// the unique index that is jl_nothing with a non-jl_nothing predecessor), so
+// stale, torn or colliding entries are benign; relaxed atomics keep threads
+// inserting into different methods that share a slot from racing on it.
+#define SPECCACHE_CURSOR_SIZE 256
+static struct {
+    _Atomic(jl_method_t*) m;
+    _Atomic(size_t) idx;
+} speccache_cursor[SPECCACHE_CURSOR_SIZE];
+
+STATIC_INLINE size_t speccache_cursor_slot(jl_method_t *m) JL_NOTSAFEPOINT
+{
+    return ((uintptr_t)m >> 4) & (SPECCACHE_CURSOR_SIZE - 1);
+}
+
 // get or create the MethodInstance for a specialization
 JL_DLLEXPORT jl_method_instance_t *jl_specializations_get_linfo(jl_method_t *m JL_PROPAGATES_ROOT, jl_value_t *type, jl_svec_t *sparams)
 {
@@ -141,7 +167,16 @@ JL_DLLEXPORT jl_method_instance_t *jl_specializations_get_linfo(jl_method_t *m J
         else {
             if (hv) {
                 _Atomic(jl_method_instance_t*) *data = (_Atomic(jl_method_instance_t*)*)jl_svec_data(specializations);
-                for (i = 0; i < cl; i++) {
+                // start from the cached cursor when it demonstrably points
+                // at the first open slot; otherwise rescan from the front
+                size_t slot = speccache_cursor_slot(m);
+                i = jl_atomic_load_relaxed(&speccache_cursor[slot].m) == m ?
+                    jl_atomic_load_relaxed(&speccache_cursor[slot].idx) : 0;
+                if (i == 0 || i >= cl ||
+                        jl_atomic_load_relaxed(&data[i]) != (jl_method_instance_t*)jl_nothing ||
+                        jl_atomic_load_relaxed(&data[i - 1]) == (jl_method_instance_t*)jl_nothing)
+                    i = 0;
+                for (; i < cl; i++) {
                     jl_method_instance_t *mi = jl_atomic_load_relaxed(&data[i]);
                     if ((jl_value_t*)mi == jl_nothing)
                         break;
@@ -174,6 +209,9 @@ JL_DLLEXPORT jl_method_instance_t *jl_specializations_get_linfo(jl_method_t *m J
             if (hv) {
                 // TODO: fuse lookup and insert steps?
                 jl_smallintset_insert(&m->speckeyset, (jl_value_t*)m, speccache_hash, i, specializations);
+                size_t slot = speccache_cursor_slot(m);
+                jl_atomic_store_relaxed(&speccache_cursor[slot].m, m);
+                jl_atomic_store_relaxed(&speccache_cursor[slot].idx, i + 1);
             }
             JL_UNLOCK(&m->writelock);
             JL_GC_POP();
@@ -243,7 +281,7 @@ jl_datatype_t *jl_mk_builtin_func(jl_datatype_t *dt, const char *name, jl_fptr_a
             (jl_value_t*)mi, 1, ~(size_t)0);
     jl_typemap_insert(&mt->cache, (jl_value_t*)mt, newentry, 0);
 
-    mt->frozen = 1;
+    mt->frozen = JL_MT_FROZEN_BUILTIN;
     JL_GC_POP();
     return dt;
 }
@@ -265,6 +303,27 @@ jl_code_info_t *jl_type_infer(jl_method_instance_t *mi, size_t world, int force)
 
     jl_code_info_t *src = NULL;
 #ifdef ENABLE_INFERENCE
+    // Another worker may already have inferred this specialization while we
+    // were preparing to (method instances are uniqued per method and
+    // signature by jl_specializations_get_linfo, so a memo keyed on the
+    // signature collapses to the instance itself). Reuse the published
+    // result instead of re-running inference, unless its IR was discarded
+    // after compilation and the caller needs the source regenerated.
+    jl_value_t *ci = jl_rettype_inferred(mi, world, world);
+    if (ci != jl_nothing) {
+        jl_code_instance_t *codeinst = (jl_code_instance_t*)ci;
+        jl_value_t *inf = codeinst->inferred;
+        if (inf != NULL && inf != jl_nothing) {
+            if (jl_is_code_info(inf))
+                return (jl_code_info_t*)inf;
+            if (jl_is_method(mi->def.method)) {
+                JL_GC_PUSH1(&src);
+                src = jl_uncompress_ir(mi->def.method, codeinst, (jl_array_t*)inf);
+                JL_GC_POP();
+                return src;
+            }
+        }
+    }
     if (mi->inInference && !force)
         return NULL;
     if (jl_is_method(mi->def.method) && mi->def.method->unspecialized == mi)
@@ -287,6 +346,10 @@ jl_code_info_t *jl_type_infer(jl_method_instance_t *mi, size_t world, int force)
 #ifdef _OS_WINDOWS_
     DWORD last_error = GetLastError();
 #endif
+    uint64_t infer_start_time = 0;
+    uint8_t measure_compile_time_enabled = jl_atomic_load_relaxed(&jl_measure_compile_time_enabled);
+    if (measure_compile_time_enabled)
+        infer_start_time = jl_hrtime();
     size_t last_age = ct->world_age;
     ct->world_age = jl_typeinf_world;
     mi->inInference = 1;
@@ -308,6 +371,8 @@ jl_code_info_t *jl_type_infer(jl_method_instance_t *mi, size_t world, int force)
     SetLastError(last_error);
 #endif
     errno = last_errno;
+    if (measure_compile_time_enabled)
+        jl_record_compile_time_for(mi, jl_hrtime() - infer_start_time);
 
     if (src && !jl_is_code_info(src)) {
         src = NULL;
@@ -983,11 +1048,12 @@ static inline jl_typemap_entry_t *lookup_leafcache(jl_array_t *leafcache JL_PROP
     jl_typemap_entry_t *entry = (jl_typemap_entry_t*)jl_eqtable_get(leafcache, (jl_value_t*)tt, NULL);
     if (entry) {
         do {
-            if (entry->min_world <= world && world <= entry->max_world) {
+            if (jl_atomic_load_relaxed(&entry->min_world) <= world &&
+                world <= jl_atomic_load_relaxed(&entry->max_world)) {
                 if (entry->simplesig == (void*)jl_nothing || concretesig_equal(tt, (jl_value_t*)entry->simplesig))
                     return entry;
             }
-            entry = entry->next;
+            entry = jl_atomic_load_relaxed(&entry->next);
         } while ((jl_value_t*)entry != jl_nothing);
     }
     return NULL;
@@ -1217,7 +1283,8 @@ static int get_intersect_visitor(jl_typemap_entry_t *oldentry, struct typemap_in
     struct matches_env *closure = container_of(closure0, struct matches_env, match);
     if (oldentry == closure->newentry)
         return 1;
-    if (oldentry->max_world < ~(size_t)0 || oldentry->min_world == closure->newentry->min_world)
+    if (jl_atomic_load_relaxed(&oldentry->max_world) < ~(size_t)0 ||
+        jl_atomic_load_relaxed(&oldentry->min_world) == jl_atomic_load_relaxed(&closure->newentry->min_world))
         // skip if no world has both active
         // also be careful not to try to scan something from the current dump-reload though
         return 1;
@@ -1325,9 +1392,86 @@ JL_DLLEXPORT jl_value_t *jl_debug_method_invalidation(int state)
     return jl_nothing;
 }
 
+// Always-on binary audit log of invalidation waves, cheap enough to leave
+// enabled in production (one locked ring append per wave, two counter bumps
+// per invalidated instance). Unlike the debug array above it records no
+// per-instance detail, just enough per wave -- world, defining method,
+// instances invalidated, deepest backedge chain -- to correlate recompile
+// storms with deploys; consumers drain it with jl_method_inval_log_drain.
+#define JL_METHOD_INVAL_LOG_LEN 1024 // power of two
+static jl_method_inval_event_t method_inval_log[JL_METHOD_INVAL_LOG_LEN];
+static uint64_t method_inval_log_head = 0; // events ever recorded
+static jl_mutex_t method_inval_log_lock;
+
+// `wave` is a zero-initialized stack event threaded through the invalidation
+// calls of one wave; invalidate_method_instance bumps its accumulators.
+// Keeping it local means concurrent waves on different method tables (each
+// table has its own writelock) cannot race on or cross-contaminate it.
+static void method_inval_log_record(jl_method_t *method, size_t max_world,
+                                    const jl_method_inval_event_t *wave) JL_NOTSAFEPOINT
+{
+    JL_LOCK_NOGC(&method_inval_log_lock);
+    jl_method_inval_event_t *ev =
+        &method_inval_log[method_inval_log_head++ & (JL_METHOD_INVAL_LOG_LEN - 1)];
+    ev->timestamp = jl_hrtime();
+    ev->world = max_world;
+    // methods are rooted by their module, so the pointer stays valid; it is
+    // an identifier for the consumer to resolve, not a GC reference
+    ev->method = method;
+    ev->ninvalidated = wave->ninvalidated;
+    ev->maxdepth = wave->maxdepth;
+    JL_UNLOCK_NOGC(&method_inval_log_lock);
+}
+
+// copy up to `nmax` events recorded since `*cursor` (0 on first use) into
+// `out`, advancing the cursor; events that aged out of the ring before being
+// observed are skipped. Returns the number of events copied.
+JL_DLLEXPORT size_t jl_method_inval_log_drain(jl_method_inval_event_t *out, size_t nmax,
+                                              uint64_t *cursor) JL_NOTSAFEPOINT
+{
+    JL_LOCK_NOGC(&method_inval_log_lock);
+    uint64_t head = method_inval_log_head;
+    uint64_t from = *cursor;
+    if (head - from > JL_METHOD_INVAL_LOG_LEN)
+        from = head - JL_METHOD_INVAL_LOG_LEN; // overwritten; drop the oldest
+    size_t n = 0;
+    while (from < head && n < nmax)
+        out[n++] = method_inval_log[from++ & (JL_METHOD_INVAL_LOG_LEN - 1)];
+    *cursor = from;
+    JL_UNLOCK_NOGC(&method_inval_log_lock);
+    return n;
+}
+
 // call external callbacks registered with this method_instance
+// state for batched method insertion (see jl_method_table_batch_begin below)
+jl_array_t *jl_method_batch JL_GLOBALLY_ROOTED;
+static int method_batch_depth = 0;
+static jl_mutex_t method_batch_lock;
+static htable_t batch_invalidated;
+static _Atomic(int) method_batch_flushing = 0;
+// world shared by every method staged in the current batch; 0 until the
+// first insertion bumps the counter
+static size_t method_batch_world = 0;
+
+// during a batch flush, report (and record) whether this method instance's
+// invalidation callbacks have already run
+static int invalidate_external_seen(jl_method_instance_t *mi)
+{
+    if (!jl_atomic_load_relaxed(&method_batch_flushing))
+        return 0;
+    JL_LOCK_NOGC(&method_batch_lock);
+    void **bp = ptrhash_bp(&batch_invalidated, (void*)mi);
+    int seen = (*bp != HT_NOTFOUND);
+    if (!seen)
+        *bp = (void*)mi;
+    JL_UNLOCK_NOGC(&method_batch_lock);
+    return seen;
+}
+
 static void invalidate_external(jl_method_instance_t *mi, size_t max_world) {
     jl_array_t *callbacks = mi->callbacks;
+    if (callbacks && invalidate_external_seen(mi))
+        return;
     if (callbacks) {
         // AbstractInterpreter allows for MethodInstances to be present in non-local caches
         // inform those caches about the invalidation.
@@ -1361,7 +1505,8 @@ static void invalidate_external(jl_method_instance_t *mi, size_t max_world) {
 }
 
 // recursively invalidate cached methods that had an edge to a replaced method
-static void invalidate_method_instance(jl_method_instance_t *replaced, size_t max_world, int depth)
+static void invalidate_method_instance(jl_method_instance_t *replaced, size_t max_world, int depth,
+                                       jl_method_inval_event_t *wave)
 {
     if (_jl_debug_method_invalidation) {
         jl_value_t *boxeddepth = NULL;
@@ -1371,6 +1516,9 @@ static void invalidate_method_instance(jl_method_instance_t *replaced, size_t ma
         jl_array_ptr_1d_push(_jl_debug_method_invalidation, boxeddepth);
         JL_GC_POP();
     }
+    wave->ninvalidated++;
+    if ((uint32_t)depth > wave->maxdepth)
+        wave->maxdepth = depth;
     if (!jl_is_method(replaced->def.method))
         return; // shouldn't happen, but better to be safe
     JL_LOCK(&replaced->def.method->writelock);
@@ -1390,14 +1538,15 @@ static void invalidate_method_instance(jl_method_instance_t *replaced, size_t ma
         size_t i, l = jl_array_len(backedges);
         for (i = 0; i < l; i++) {
             jl_method_instance_t *replaced = (jl_method_instance_t*)jl_array_ptr_ref(backedges, i);
-            invalidate_method_instance(replaced, max_world, depth + 1);
+            invalidate_method_instance(replaced, max_world, depth + 1, wave);
         }
     }
     JL_UNLOCK(&replaced->def.method->writelock);
 }
 
 // invalidate cached methods that overlap this definition
-static void invalidate_backedges(jl_method_instance_t *replaced_mi, size_t max_world, const char *why)
+static void invalidate_backedges(jl_method_instance_t *replaced_mi, size_t max_world, const char *why,
+                                 jl_method_inval_event_t *wave)
 {
     JL_LOCK(&replaced_mi->def.method->writelock);
     jl_array_t *backedges = replaced_mi->backedges;
@@ -1407,7 +1556,7 @@ static void invalidate_backedges(jl_method_instance_t *replaced_mi, size_t max_w
         size_t i, l = jl_array_len(backedges);
         jl_method_instance_t **replaced = (jl_method_instance_t**)jl_array_ptr_data(backedges);
         for (i = 0; i < l; i++) {
-            invalidate_method_instance(replaced[i], max_world, 1);
+            invalidate_method_instance(replaced[i], max_world, 1, wave);
         }
     }
     JL_UNLOCK(&replaced_mi->def.method->writelock);
@@ -1431,14 +1580,14 @@ JL_DLLEXPORT void jl_method_instance_add_backedge(jl_method_instance_t *callee,
         jl_array_ptr_set(callee->backedges, 0, caller);
     }
     else {
-        size_t i, l = jl_array_len(callee->backedges);
-        for (i = 0; i < l; i++) {
-            if (jl_array_ptr_ref(callee->backedges, i) == (jl_value_t*)caller)
-                break;
-        }
-        if (i == l) {
+        // check only the last entry instead of scanning the whole array:
+        // inference emits the edges for one caller consecutively, so
+        // duplicates almost always arrive back-to-back, and a stray
+        // duplicate is harmless (invalidation is idempotent) while the
+        // full scan made repeated insertion quadratic.
+        size_t l = jl_array_len(callee->backedges);
+        if (l == 0 || jl_array_ptr_ref(callee->backedges, l - 1) != (jl_value_t*)caller)
             jl_array_ptr_1d_push(callee->backedges, (jl_value_t*)caller);
-        }
     }
     JL_UNLOCK(&callee->def.method->writelock);
 }
@@ -1455,16 +1604,18 @@ JL_DLLEXPORT void jl_method_table_add_backedge(jl_methtable_t *mt, jl_value_t *t
         jl_array_ptr_set(mt->backedges, 1, caller);
     }
     else {
-        size_t i, l = jl_array_len(mt->backedges);
-        for (i = 1; i < l; i += 2) {
-            if (jl_types_equal(jl_array_ptr_ref(mt->backedges, i - 1), typ)) {
-                if (jl_array_ptr_ref(mt->backedges, i) == caller) {
-                    JL_UNLOCK(&mt->writelock);
-                    return;
-                }
-                // reuse the already cached instance of this type
-                typ = jl_array_ptr_ref(mt->backedges, i - 1);
+        // check only the last (typ, caller) pair: a full scan costs a
+        // jl_types_equal (two subtype queries) per recorded pair on every
+        // insertion, which is quadratic while loading large packages, and
+        // the missed-call edges for one caller arrive consecutively.
+        size_t l = jl_array_len(mt->backedges);
+        if (jl_types_equal(jl_array_ptr_ref(mt->backedges, l - 2), typ)) {
+            if (jl_array_ptr_ref(mt->backedges, l - 1) == caller) {
+                JL_UNLOCK(&mt->writelock);
+                return;
             }
+            // reuse the already cached instance of this type
+            typ = jl_array_ptr_ref(mt->backedges, l - 2);
         }
         jl_array_ptr_1d_push(mt->backedges, typ);
         jl_array_ptr_1d_push(mt->backedges, caller);
@@ -1482,7 +1633,7 @@ static int invalidate_mt_cache(jl_typemap_entry_t *oldentry, void *closure0)
 {
     struct invalidate_mt_env *env = (struct invalidate_mt_env*)closure0;
     JL_GC_PROMISE_ROOTED(env->newentry);
-    if (oldentry->max_world == ~(size_t)0) {
+    if (jl_atomic_load_relaxed(&oldentry->max_world) == ~(size_t)0) {
         jl_method_instance_t *mi = oldentry->func.linfo;
         int intersects = 0;
         jl_method_instance_t **d = (jl_method_instance_t**)jl_array_ptr_data(env->shadowed);
@@ -1501,7 +1652,7 @@ static int invalidate_mt_cache(jl_typemap_entry_t *oldentry, void *closure0)
                 jl_array_ptr_1d_push(_jl_debug_method_invalidation, loctag);
                 JL_GC_POP();
             }
-            oldentry->max_world = env->max_world;
+            jl_atomic_store_relaxed(&oldentry->max_world, env->max_world);
             env->invalidated = 1;
         }
     }
@@ -1510,11 +1661,11 @@ static int invalidate_mt_cache(jl_typemap_entry_t *oldentry, void *closure0)
 static int disable_mt_cache(jl_typemap_entry_t *oldentry, void *closure0)
 {
     struct invalidate_mt_env *env = (struct invalidate_mt_env*)closure0;
-    if (oldentry->max_world < ~(size_t)0)
+    if (jl_atomic_load_relaxed(&oldentry->max_world) < ~(size_t)0)
         return 1;
     jl_method_t *m = oldentry->func.linfo->def.method;
     if (m == env->newentry->func.method)
-        oldentry->max_world = env->max_world;
+        jl_atomic_store_relaxed(&oldentry->max_world, env->max_world);
     return 1;
 }
 
@@ -1541,7 +1692,8 @@ static jl_typemap_entry_t *do_typemap_search(jl_methtable_t *mt JL_PROPAGATES_RO
 static void jl_method_table_invalidate(jl_methtable_t *mt, jl_typemap_entry_t *methodentry, jl_method_t *method, size_t max_world)
 {
     assert(!method->is_for_opaque_closure);
-    method->deleted_world = methodentry->max_world = max_world;
+    jl_atomic_store_relaxed(&methodentry->max_world, max_world);
+    method->deleted_world = max_world;
     // drop this method from mt->cache
     struct invalidate_mt_env mt_cache_env;
     mt_cache_env.max_world = max_world;
@@ -1555,35 +1707,60 @@ static void jl_method_table_invalidate(jl_methtable_t *mt, jl_typemap_entry_t *m
         jl_typemap_entry_t *oldentry = (jl_typemap_entry_t*)jl_array_ptr_ref(leafcache, i);
         if (oldentry) {
             while ((jl_value_t*)oldentry != jl_nothing) {
-                if (oldentry->max_world == ~(size_t)0)
-                    oldentry->max_world = mt_cache_env.max_world;
-                oldentry = oldentry->next;
+                if (jl_atomic_load_relaxed(&oldentry->max_world) == ~(size_t)0)
+                    jl_atomic_store_relaxed(&oldentry->max_world, mt_cache_env.max_world);
+                oldentry = jl_atomic_load_relaxed(&oldentry->next);
             }
         }
     }
     // Invalidate the backedges
     int invalidated = 0;
+    jl_method_inval_event_t wave = {0};
     jl_svec_t *specializations = methodentry->func.method->specializations;
     l = jl_svec_len(specializations);
     for (i = 0; i < l; i++) {
         jl_method_instance_t *mi = (jl_method_instance_t*)jl_svecref(specializations, i);
         if ((jl_value_t*)mi != jl_nothing) {
             invalidated = 1;
-            invalidate_external(mi, methodentry->max_world);
-            invalidate_backedges(mi, methodentry->max_world, "jl_method_table_disable");
+            invalidate_external(mi, max_world);
+            invalidate_backedges(mi, max_world, "jl_method_table_disable", &wave);
         }
     }
-    if (invalidated && _jl_debug_method_invalidation) {
-        jl_array_ptr_1d_push(_jl_debug_method_invalidation, (jl_value_t*)method);
-        jl_value_t *loctag = jl_cstr_to_string("jl_method_table_disable");
-        JL_GC_PUSH1(&loctag);
-        jl_array_ptr_1d_push(_jl_debug_method_invalidation, loctag);
-        JL_GC_POP();
+    if (invalidated) {
+        method_inval_log_record(methodentry->func.method, max_world, &wave);
+        if (_jl_debug_method_invalidation) {
+            jl_array_ptr_1d_push(_jl_debug_method_invalidation, (jl_value_t*)method);
+            jl_value_t *loctag = jl_cstr_to_string("jl_method_table_disable");
+            JL_GC_PUSH1(&loctag);
+            jl_array_ptr_1d_push(_jl_debug_method_invalidation, loctag);
+            JL_GC_POP();
+        }
     }
 }
 
+// Permanently seal a method table: after this, adding or deleting methods
+// throws. Builtin functions use the same flag from birth. Sealing does not
+// bump the world counter -- it only promises there will be no future bump
+// originating from this table, so a compiler that checks
+// jl_method_table_sealed may treat its current method matches as valid in
+// all future worlds and devirtualize accordingly.
+JL_DLLEXPORT void jl_method_table_seal(jl_methtable_t *mt)
+{
+    JL_LOCK(&mt->writelock);
+    if (!mt->frozen)
+        mt->frozen = JL_MT_FROZEN_SEALED;
+    JL_UNLOCK(&mt->writelock);
+}
+
+JL_DLLEXPORT int jl_method_table_sealed(jl_methtable_t *mt) JL_NOTSAFEPOINT
+{
+    return mt->frozen;
+}
+
 JL_DLLEXPORT void jl_method_table_disable(jl_methtable_t *mt, jl_method_t *method)
 {
+    if (mt->frozen)
+        jl_error("cannot delete methods from a sealed method table");
     if (jl_options.incremental && jl_generating_output())
         jl_printf(JL_STDERR, "WARNING: method deletion during Module precompile may lead to undefined behavior"
                              "\n  ** incremental compilation may be fatally broken for this module **\n\n");
@@ -1621,40 +1798,26 @@ static int jl_type_intersection2(jl_value_t *t1, jl_value_t *t2, jl_value_t **is
     return 1;
 }
 
-JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method, jl_tupletype_t *simpletype)
+// invalidation pass for a new (non-overwriting) method entry: scan the method
+// table's backedges and the intersecting methods' specializations and cap
+// everything the new method shadows at `max_world`.
+// caller must hold mt->writelock
+static void invalidate_for_new_method(jl_methtable_t *mt, jl_typemap_entry_t *newentry, size_t max_world)
 {
-    JL_TIMING(ADD_METHOD);
-    assert(jl_is_method(method));
-    assert(jl_is_mtable(mt));
+    jl_method_t *method = newentry->func.method;
     jl_value_t *type = method->sig;
     jl_value_t *oldvalue = NULL;
     jl_array_t *oldmi = NULL;
-    if (method->primary_world == 1)
-        method->primary_world = jl_atomic_fetch_add(&jl_world_counter, 1) + 1;
-    size_t max_world = method->primary_world - 1;
     jl_value_t *loctag = NULL;  // debug info for invalidation
     jl_value_t *isect = NULL;
     jl_value_t *isect2 = NULL;
     jl_value_t *isect3 = NULL;
-    jl_typemap_entry_t *newentry = NULL;
-    JL_GC_PUSH7(&oldvalue, &oldmi, &newentry, &loctag, &isect, &isect2, &isect3);
-    JL_LOCK(&mt->writelock);
-    // first find if we have an existing entry to delete
-    struct jl_typemap_assoc search = {(jl_value_t*)type, method->primary_world, NULL, 0, ~(size_t)0};
-    jl_typemap_entry_t *oldentry = jl_typemap_assoc_by_type(mt->defs, &search, /*offs*/0, /*subtype*/0);
-    // then add our new entry
-    newentry = jl_typemap_alloc((jl_tupletype_t*)type, simpletype, jl_emptysvec,
-            (jl_value_t*)method, method->primary_world, method->deleted_world);
-    jl_typemap_insert(&mt->defs, (jl_value_t*)mt, newentry, 0);
-    if (oldentry) {
-        jl_method_t *m = oldentry->func.method;
-        method_overwrite(newentry, m);
-        jl_method_table_invalidate(mt, oldentry, m, max_world);
-    }
-    else {
+    JL_GC_PUSH6(&oldvalue, &oldmi, &loctag, &isect, &isect2, &isect3);
+    {
         oldvalue = get_intersect_matches(mt->defs, newentry);
 
         int invalidated = 0;
+        jl_method_inval_event_t wave = {0};
         jl_method_t **d;
         size_t j, n;
         if (oldvalue == NULL) {
@@ -1701,7 +1864,7 @@ JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method
                 if (missing) {
                     jl_method_instance_t *backedge = (jl_method_instance_t*)backedges[i];
                     invalidate_external(backedge, max_world);
-                    invalidate_method_instance(backedge, max_world, 0);
+                    invalidate_method_instance(backedge, max_world, 0, &wave);
                     invalidated = 1;
                     if (_jl_debug_method_invalidation)
                         jl_array_ptr_1d_push(_jl_debug_method_invalidation, (jl_value_t*)backedgetyp);
@@ -1771,7 +1934,7 @@ JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method
                         invalidate_external(mi, max_world);
                         if (mi->backedges) {
                             invalidated = 1;
-                            invalidate_backedges(mi, max_world, "jl_method_table_insert");
+                            invalidate_backedges(mi, max_world, "jl_method_table_insert", &wave);
                         }
                     }
                 }
@@ -1799,11 +1962,115 @@ JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method
                 }
             }
         }
-        if (invalidated && _jl_debug_method_invalidation) {
-            jl_array_ptr_1d_push(_jl_debug_method_invalidation, (jl_value_t*)method);
-            loctag = jl_cstr_to_string("jl_method_table_insert");
-            jl_array_ptr_1d_push(_jl_debug_method_invalidation, loctag);
+        if (invalidated) {
+            method_inval_log_record(method, max_world, &wave);
+            if (_jl_debug_method_invalidation) {
+                jl_array_ptr_1d_push(_jl_debug_method_invalidation, (jl_value_t*)method);
+                loctag = jl_cstr_to_string("jl_method_table_insert");
+                jl_array_ptr_1d_push(_jl_debug_method_invalidation, loctag);
+            }
         }
+    }
+    JL_GC_POP();
+}
+
+// Batched insertion. Inside a batch, jl_method_table_insert defers the
+// invalidation pass above and records the new entry instead; the passes run
+// together when the outermost batch ends, with invalidation callbacks
+// deduplicated so a method instance shadowed by several new methods notifies
+// its external caches once. All methods staged in a batch also share one
+// world counter bump, since they become visible as a unit. A batch is only
+// sound when no code whose dispatch could depend on the new methods runs
+// before the batch ends, as sysimage and package-image deserialization
+// guarantees.
+JL_DLLEXPORT void jl_method_table_batch_begin(void)
+{
+    JL_LOCK(&method_batch_lock);
+    if (method_batch_depth++ == 0 && batch_invalidated.table == NULL)
+        htable_new(&batch_invalidated, 0);
+    JL_UNLOCK(&method_batch_lock);
+}
+
+JL_DLLEXPORT void jl_method_table_batch_end(void)
+{
+    jl_array_t *batch = NULL;
+    JL_LOCK(&method_batch_lock);
+    assert(method_batch_depth > 0);
+    if (--method_batch_depth == 0) {
+        batch = jl_method_batch;
+        jl_method_batch = NULL;
+        method_batch_world = 0;
+    }
+    JL_UNLOCK(&method_batch_lock);
+    if (batch == NULL)
+        return;
+    JL_GC_PUSH1(&batch);
+    jl_atomic_store_relaxed(&method_batch_flushing, 1);
+    size_t i, l = jl_array_len(batch);
+    for (i = 0; i < l; i += 2) {
+        jl_methtable_t *mt = (jl_methtable_t*)jl_array_ptr_ref(batch, i);
+        jl_typemap_entry_t *newentry = (jl_typemap_entry_t*)jl_array_ptr_ref(batch, i + 1);
+        size_t max_world = newentry->func.method->primary_world - 1;
+        JL_LOCK(&mt->writelock);
+        invalidate_for_new_method(mt, newentry, max_world);
+        JL_UNLOCK(&mt->writelock);
+    }
+    jl_atomic_store_relaxed(&method_batch_flushing, 0);
+    htable_reset(&batch_invalidated, 0);
+    JL_GC_POP();
+}
+
+JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method, jl_tupletype_t *simpletype)
+{
+    JL_TIMING(ADD_METHOD);
+    assert(jl_is_method(method));
+    assert(jl_is_mtable(mt));
+    jl_value_t *type = method->sig;
+    if (method->primary_world == 1) {
+        int batched = 0;
+        JL_LOCK(&method_batch_lock);
+        if (method_batch_depth > 0) {
+            // methods staged in one batch only become visible together when
+            // the batch ends, so they can share a single world counter bump
+            // instead of aging the world once per definition
+            if (method_batch_world == 0)
+                method_batch_world = jl_atomic_fetch_add(&jl_world_counter, 1) + 1;
+            method->primary_world = method_batch_world;
+            batched = 1;
+        }
+        JL_UNLOCK(&method_batch_lock);
+        if (!batched)
+            method->primary_world = jl_atomic_fetch_add(&jl_world_counter, 1) + 1;
+    }
+    size_t max_world = method->primary_world - 1;
+    jl_typemap_entry_t *newentry = NULL;
+    JL_GC_PUSH1(&newentry);
+    JL_LOCK(&mt->writelock);
+    // first find if we have an existing entry to delete
+    struct jl_typemap_assoc search = {(jl_value_t*)type, method->primary_world, NULL, 0, ~(size_t)0};
+    jl_typemap_entry_t *oldentry = jl_typemap_assoc_by_type(mt->defs, &search, /*offs*/0, /*subtype*/0);
+    // then add our new entry
+    newentry = jl_typemap_alloc((jl_tupletype_t*)type, simpletype, jl_emptysvec,
+            (jl_value_t*)method, method->primary_world, method->deleted_world);
+    jl_typemap_insert(&mt->defs, (jl_value_t*)mt, newentry, 0);
+    if (oldentry) {
+        jl_method_t *m = oldentry->func.method;
+        method_overwrite(newentry, m);
+        jl_method_table_invalidate(mt, oldentry, m, max_world);
+    }
+    else {
+        int deferred = 0;
+        JL_LOCK(&method_batch_lock);
+        if (method_batch_depth > 0) {
+            if (jl_method_batch == NULL)
+                jl_method_batch = jl_alloc_vec_any(0);
+            jl_array_ptr_1d_push(jl_method_batch, (jl_value_t*)mt);
+            jl_array_ptr_1d_push(jl_method_batch, (jl_value_t*)newentry);
+            deferred = 1;
+        }
+        JL_UNLOCK(&method_batch_lock);
+        if (!deferred)
+            invalidate_for_new_method(mt, newentry, max_world);
         update_max_args(mt, type);
     }
     JL_UNLOCK(&mt->writelock);
@@ -1882,6 +2149,16 @@ jl_method_instance_t *jl_method_lookup(jl_value_t **args, size_t nargs, size_t w
 //
 // lim is the max # of methods to return. if there are more, returns jl_false.
 // -1 for no limit.
+// Memoization for jl_matching_methods. Inference repeatedly queries the same
+// (often abstract) signatures, and each query re-runs the full typemap
+// intersection. Results are remembered in a direct-mapped table together with
+// their computed valid world range and the value of jl_world_counter at
+// computation time; since every method insertion or deletion advances the
+// world counter, a query at a world newer than the recorded counter simply
+// misses and recomputes, so no explicit invalidation hook is needed.
+jl_match_cache_entry_t jl_match_cache[JL_N_MATCH_CACHE];
+static jl_mutex_t match_cache_lock;
+
 JL_DLLEXPORT jl_value_t *jl_matching_methods(jl_tupletype_t *types, jl_value_t *mt, int lim, int include_ambiguous,
                                              size_t world, size_t *min_valid, size_t *max_valid, int *ambig)
 {
@@ -1895,7 +2172,51 @@ JL_DLLEXPORT jl_value_t *jl_matching_methods(jl_tupletype_t *types, jl_value_t *
         mt = (jl_value_t*)jl_method_table_for(unw);
     if ((jl_value_t*)mt == jl_nothing)
         return jl_false; // indeterminate - ml_matches can't deal with this case
-    return ml_matches((jl_methtable_t*)mt, 0, types, lim, include_ambiguous, 1, world, 1, min_valid, max_valid, ambig);
+    jl_match_cache_entry_t *slot = &jl_match_cache[
+        (jl_object_id((jl_value_t*)types) ^ (uintptr_t)(lim * 2 + include_ambiguous)) & (JL_N_MATCH_CACHE - 1)];
+    JL_LOCK_NOGC(&match_cache_lock);
+    if (slot->sig != NULL && slot->mt == (jl_methtable_t*)mt &&
+            slot->lim == lim && slot->include_ambiguous == include_ambiguous &&
+            slot->min_valid <= world && world <= slot->max_valid &&
+            world <= slot->world &&
+            // an open-ended max_valid is speculative: it is only known to hold
+            // through the world counter at computation time, and a later
+            // redefinition may have ended the range without touching this
+            // slot, so recompute once the counter advances. A finite range was
+            // ended by a specific insertion, covers only worlds that can no
+            // longer change, and stays exact forever.
+            (slot->max_valid <= slot->world ||
+             jl_atomic_load_acquire(&jl_world_counter) == slot->world) &&
+            jl_egal(slot->sig, (jl_value_t*)types)) {
+        jl_value_t *matches = slot->matches;
+        if (*min_valid < slot->min_valid)
+            *min_valid = slot->min_valid;
+        if (*max_valid > slot->max_valid)
+            *max_valid = slot->max_valid;
+        if (ambig != NULL)
+            *ambig = slot->has_ambiguity;
+        JL_UNLOCK_NOGC(&match_cache_lock);
+        return matches;
+    }
+    JL_UNLOCK_NOGC(&match_cache_lock);
+    size_t counter = jl_atomic_load_acquire(&jl_world_counter);
+    int has_ambiguity = 0;
+    jl_value_t *matches = ml_matches((jl_methtable_t*)mt, 0, types, lim, include_ambiguous, 1, world,
+                                     1, min_valid, max_valid, &has_ambiguity);
+    if (ambig != NULL)
+        *ambig = has_ambiguity;
+    JL_LOCK_NOGC(&match_cache_lock);
+    slot->sig = (jl_value_t*)types;
+    slot->matches = matches;
+    slot->mt = (jl_methtable_t*)mt;
+    slot->min_valid = *min_valid;
+    slot->max_valid = *max_valid;
+    slot->world = counter;
+    slot->lim = lim;
+    slot->include_ambiguous = include_ambiguous;
+    slot->has_ambiguity = has_ambiguity;
+    JL_UNLOCK_NOGC(&match_cache_lock);
+    return matches;
 }
 
 jl_method_instance_t *jl_get_unspecialized(jl_method_instance_t *method JL_PROPAGATES_ROOT)
@@ -2232,6 +2553,31 @@ JL_DLLEXPORT int jl_compile_hint(jl_tupletype_t *types)
     return 1;
 }
 
+// Compile a slice of an array of signature types without dispatching back
+// into julia for each entry. `Base.precompile_batch` uses this to drain a
+// recorded method set on background worker tasks while the main thread keeps
+// loading. Invalid or stale signatures are skipped rather than aborting the
+// rest of the batch. Returns the number of signatures compiled successfully.
+JL_DLLEXPORT size_t jl_compile_hint_batch(jl_array_t *sigs, size_t start, size_t stop)
+{
+    size_t len = jl_array_len(sigs);
+    if (stop > len)
+        stop = len;
+    size_t ncompiled = 0;
+    for (size_t i = start; i < stop; i++) {
+        jl_value_t *sig = jl_array_ptr_ref(sigs, i);
+        if (sig == NULL || !jl_is_type(sig))
+            continue;
+        JL_TRY {
+            ncompiled += jl_compile_hint((jl_tupletype_t*)sig);
+        }
+        JL_CATCH {
+            // a recorded signature that no longer makes sense; ignore it
+        }
+    }
+    return ncompiled;
+}
+
 // add type of `f` to front of argument tuple type
 static jl_value_t *jl_argtype_with_function(jl_function_t *f, jl_value_t *types0)
 {
@@ -2274,6 +2620,27 @@ STATIC_INLINE jl_value_t *verify_type(jl_value_t *v) JL_NOTSAFEPOINT
     return v;
 }
 
+// Tiered compilation (opt-in via JULIA_TIERED_COMPILATION=<threshold>): fresh
+// compiles run at -O0 and a code instance is recompiled at the session's full
+// optimization level once it has been invoked <threshold> times. Invocation
+// counts live in a fixed-size table indexed by a hash of the code instance
+// pointer; unrelated instances that collide merge their counts, which can
+// only promote a little early and is harmless.
+#define JL_N_TIER_COUNTERS 4096
+static _Atomic(uint32_t) tier_counters[JL_N_TIER_COUNTERS];
+static int jl_tier_promote_threshold = 0;
+
+STATIC_INLINE void tier_count_invocation(jl_code_instance_t *codeinst)
+{
+    uintptr_t key = (uintptr_t)codeinst;
+    size_t idx = (key ^ (key >> 9)) & (JL_N_TIER_COUNTERS - 1);
+    uint32_t n = jl_atomic_fetch_add_relaxed(&tier_counters[idx], 1);
+    // exact equality so a counter fires at most once per wraparound; the
+    // promotion itself is idempotent and tolerates being skipped
+    if (n + 1 == (uint32_t)jl_tier_promote_threshold)
+        jl_promote_codeinst(codeinst);
+}
+
 STATIC_INLINE jl_value_t *_jl_invoke(jl_value_t *F, jl_value_t **args, uint32_t nargs, jl_method_instance_t *mfunc, size_t world)
 {
     // manually inlined copy of jl_method_compiled
@@ -2282,6 +2649,8 @@ STATIC_INLINE jl_value_t *_jl_invoke(jl_value_t *F, jl_value_t **args, uint32_t
         if (codeinst->min_world <= world && world <= codeinst->max_world) {
             jl_callptr_t invoke = jl_atomic_load_relaxed(&codeinst->invoke);
             if (invoke != NULL) {
+                if (__unlikely(jl_tier_promote_threshold != 0))
+                    tier_count_invocation(codeinst);
                 jl_value_t *res = invoke(F, args, nargs, codeinst);
                 return verify_type(res);
             }
@@ -2331,27 +2700,118 @@ STATIC_INLINE int sig_match_fast(jl_value_t *arg1t, jl_value_t **args, jl_value_
     return 1;
 }
 
-_Atomic(jl_typemap_entry_t*) call_cache[N_CALL_CACHE] JL_GLOBALLY_ROOTED;
-static _Atomic(uint8_t) pick_which[N_CALL_CACHE];
+// The callsite cache probes four slots derived from different bytes of the
+// callsite hash (a skewed-associative layout), so its effective associativity
+// is already four ways. The table size defaults to N_CALL_CACHE and can be
+// overridden at startup with JULIA_CALL_CACHE_SIZE (rounded up to a power of
+// two) for workloads with unusually many hot callsites.
+static _Atomic(jl_typemap_entry_t*) default_call_cache[N_CALL_CACHE];
+static _Atomic(uint8_t) default_pick_which[N_CALL_CACHE];
+_Atomic(jl_typemap_entry_t*) *call_cache JL_GLOBALLY_ROOTED = default_call_cache;
+static _Atomic(uint8_t) *pick_which = default_pick_which;
+uint32_t jl_call_cache_size = N_CALL_CACHE;
+static uint32_t call_cache_mask = N_CALL_CACHE - 1;
+
+// Hit/miss/eviction counters for the callsite cache. The hit increment sits
+// on the dispatch fast path, so counting is only done while it has been
+// enabled with jl_call_cache_stats_enable (or JULIA_CALL_CACHE_STATS=1).
+static _Atomic(int) call_cache_stats_enabled = 0;
+static _Atomic(uint64_t) call_cache_hits;
+static _Atomic(uint64_t) call_cache_misses;
+static _Atomic(uint64_t) call_cache_evictions;
+
+void jl_init_call_cache(void)
+{
+    char *env = getenv("JULIA_CALL_CACHE_SIZE");
+    if (env) {
+        size_t request = (size_t)strtol(env, NULL, 10);
+        size_t sz = 256;
+        while (sz < request && sz < (size_t)1 << 22)
+            sz *= 2;
+        if (sz != N_CALL_CACHE) {
+            _Atomic(jl_typemap_entry_t*) *cache = (_Atomic(jl_typemap_entry_t*)*)malloc_s(
+                    sz * sizeof(jl_typemap_entry_t*));
+            _Atomic(uint8_t) *which = (_Atomic(uint8_t)*)malloc_s(sz * sizeof(uint8_t));
+            memset((void*)cache, 0, sz * sizeof(jl_typemap_entry_t*));
+            memset((void*)which, 0, sz * sizeof(uint8_t));
+            call_cache = cache;
+            pick_which = which;
+            jl_call_cache_size = (uint32_t)sz;
+            call_cache_mask = (uint32_t)sz - 1;
+        }
+    }
+    env = getenv("JULIA_CALL_CACHE_STATS");
+    if (env && atoi(env))
+        jl_atomic_store_relaxed(&call_cache_stats_enabled, 1);
+    // the JIT parses this independently (see jl_init_jit) so that the
+    // threshold need not be exported across the codegen boundary
+    env = getenv("JULIA_TIERED_COMPILATION");
+    if (env)
+        jl_tier_promote_threshold = atoi(env);
+}
+
+JL_DLLEXPORT void jl_call_cache_stats_enable(int enable)
+{
+    jl_atomic_store_relaxed(&call_cache_stats_enabled, !!enable);
+}
+
+JL_DLLEXPORT void jl_get_call_cache_stats(uint64_t *hits, uint64_t *misses, uint64_t *evictions)
+{
+    if (hits)
+        *hits = jl_atomic_load_relaxed(&call_cache_hits);
+    if (misses)
+        *misses = jl_atomic_load_relaxed(&call_cache_misses);
+    if (evictions)
+        *evictions = jl_atomic_load_relaxed(&call_cache_evictions);
+}
+
+// Per-call-site inline caches. Each dynamically dispatched call site that
+// codegen compiles in native code owns one slot holding the typemap entry
+// that last resolved a call from that site; jl_apply_generic_site checks the
+// slot before probing the global call cache and the lookup re-patches it on a
+// miss, so a monomorphic call site pays one load plus a signature check in
+// the steady state. Slots are handed out from blocks that are never freed
+// (compiled code keeps pointing at them) and that the GC scans as roots.
+_Atomic(jl_callsite_block_t*) jl_callsite_blocks;
+static jl_mutex_t callsite_cache_lock;
+
+JL_DLLEXPORT void *jl_alloc_callsite_cache(void)
+{
+    JL_LOCK_NOGC(&callsite_cache_lock);
+    jl_callsite_block_t *b = jl_atomic_load_relaxed(&jl_callsite_blocks);
+    if (b == NULL || b->used == JL_CALLSITE_CACHE_NSLOTS) {
+        b = (jl_callsite_block_t*)malloc_s(sizeof(jl_callsite_block_t));
+        memset(b, 0, sizeof(jl_callsite_block_t));
+        b->next = jl_atomic_load_relaxed(&jl_callsite_blocks);
+        // release so that the GC root scan sees a fully zeroed block
+        jl_atomic_store_release(&jl_callsite_blocks, b);
+    }
+    void *slot = (void*)&b->slots[b->used++];
+    JL_UNLOCK_NOGC(&callsite_cache_lock);
+    return slot;
+}
+
 #ifdef JL_GF_PROFILE
 size_t ncalls;
 void call_cache_stats()
 {
     int pick_which_stat[4] = {0, 0, 0, 0};
-    int i, count = 0;
-    for (i = 0; i < N_CALL_CACHE; i++) {
+    size_t i;
+    int count = 0;
+    for (i = 0; i < jl_call_cache_size; i++) {
         if (jl_atomic_load_relaxed(&call_cache[i]))
             count++;
         ++pick_which_stat[jl_atomic_load_relaxed(&pick_which[i]) & 3];
     }
     jl_safe_printf("cache occupied: %d / %d; pick_which stats: {%d, %d, %d, %d}\n",
-            count, N_CALL_CACHE,
+            count, (int)jl_call_cache_size,
             pick_which_stat[0], pick_which_stat[1], pick_which_stat[2], pick_which_stat[3]);
 }
 #endif
 
 STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t **args, uint32_t nargs,
-                                                       uint32_t callsite, size_t world)
+                                                       uint32_t callsite, size_t world,
+                                                       _Atomic(jl_typemap_entry_t*) *site)
 {
 #ifdef JL_GF_PROFILE
     ncalls++;
@@ -2366,6 +2826,7 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
 
     /*
       search order:
+      check the call site's inline cache, if it has one
       check associative hash based on callsite address for leafsig match
       look at concrete signatures
       if there is an exact match, return it
@@ -2379,13 +2840,23 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
     // so that a collision across all of
     // them is less likely
     uint32_t cache_idx[4] = {
-        (callsite) & (N_CALL_CACHE - 1),
-        (callsite >> 8) & (N_CALL_CACHE - 1),
-        (callsite >> 16) & (N_CALL_CACHE - 1),
-        (callsite >> 24 | callsite << 8) & (N_CALL_CACHE - 1)};
+        (callsite) & call_cache_mask,
+        (callsite >> 8) & call_cache_mask,
+        (callsite >> 16) & call_cache_mask,
+        (callsite >> 24 | callsite << 8) & call_cache_mask};
     jl_typemap_entry_t *entry = NULL;
     jl_methtable_t *mt = NULL;
     int i;
+    if (site) {
+        // monomorphic fast path: the entry that last resolved this call site
+        entry = jl_atomic_load_relaxed(site);
+        if (entry && nargs == jl_svec_len(entry->sig->parameters) &&
+            sig_match_fast(FT, args, jl_svec_data(entry->sig->parameters), nargs) &&
+            world >= jl_atomic_load_relaxed(&entry->min_world) &&
+            world <= jl_atomic_load_relaxed(&entry->max_world)) {
+            goto have_entry;
+        }
+    }
     // check each cache entry to see if it matches
     //#pragma unroll
     //for (i = 0; i < 4; i++) {
@@ -2396,7 +2867,12 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
             entry = jl_atomic_load_relaxed(&call_cache[cache_idx[i]]); \
             if (entry && nargs == jl_svec_len(entry->sig->parameters) && \
                 sig_match_fast(FT, args, jl_svec_data(entry->sig->parameters), nargs) && \
-                world >= entry->min_world && world <= entry->max_world) { \
+                world >= jl_atomic_load_relaxed(&entry->min_world) && \
+                world <= jl_atomic_load_relaxed(&entry->max_world)) { \
+                if (__unlikely(jl_atomic_load_relaxed(&call_cache_stats_enabled))) \
+                    jl_atomic_fetch_add_relaxed(&call_cache_hits, 1); \
+                if (site) \
+                    jl_atomic_store_release(site, entry); \
                 goto have_entry; \
             } \
         } while (0);
@@ -2410,13 +2886,19 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
     int64_t last_alloc;
     if (i == 4) {
         // if no method was found in the associative cache, check the full cache
+        if (__unlikely(jl_atomic_load_relaxed(&call_cache_stats_enabled)))
+            jl_atomic_fetch_add_relaxed(&call_cache_misses, 1);
         JL_TIMING(METHOD_LOOKUP_FAST);
         mt = jl_gf_mtable(F);
         jl_array_t *leafcache = jl_atomic_load_relaxed(&mt->leafcache);
         entry = NULL;
-        if (leafcache != (jl_array_t*)jl_an_empty_vec_any &&
-                jl_typeis(jl_atomic_load_relaxed(&mt->cache), jl_typemap_level_type)) {
-            // hashing args is expensive, but looking at mt->cache is probably even more expensive
+        if (leafcache != (jl_array_t*)jl_an_empty_vec_any) {
+            // hashing args is not free, but concrete (leafsig) entries are
+            // stored here rather than in mt->cache, so when any exist one
+            // probe of this table beats descending the typemap and then
+            // allocating the type tuple anyways for the fallback probe below;
+            // lookup_arg_type_tuple only peeks at the type cache and does not
+            // allocate, so a miss here costs just the hashing
             tt = lookup_arg_type_tuple(F, args, nargs);
             if (tt != NULL)
                 entry = lookup_leafcache(leafcache, (jl_value_t*)tt, world);
@@ -2434,12 +2916,29 @@ STATIC_INLINE jl_method_instance_t *jl_lookup_generic_(jl_value_t *F, jl_value_t
         }
         if (entry != NULL && entry->isleafsig && entry->simplesig == (void*)jl_nothing && entry->guardsigs == jl_emptysvec) {
             // put the entry into the cache if it's valid for a leafsig lookup,
-            // using pick_which to slightly randomize where it ends up
+            // preferring an empty or world-expired way among the four
+            // candidate slots; only when the whole set holds live entries do
+            // we fall back to pick_which to slightly randomize the eviction
             // (intentionally not atomically synchronized, since we're just using it for randomness)
             // TODO: use the thread's `cong` instead as a source of randomness
-            int which = jl_atomic_load_relaxed(&pick_which[cache_idx[0]]) + 1;
-            jl_atomic_store_relaxed(&pick_which[cache_idx[0]], which);
-            jl_atomic_store_release(&call_cache[cache_idx[which & 3]], entry);
+            int which = -1;
+            for (int k = 0; k < 4; k++) {
+                jl_typemap_entry_t *old = jl_atomic_load_relaxed(&call_cache[cache_idx[k]]);
+                if (old == NULL || jl_atomic_load_relaxed(&old->max_world) < world) {
+                    which = k;
+                    break;
+                }
+            }
+            if (which < 0) {
+                int pick = jl_atomic_load_relaxed(&pick_which[cache_idx[0]]) + 1;
+                jl_atomic_store_relaxed(&pick_which[cache_idx[0]], pick);
+                which = pick & 3;
+                if (__unlikely(jl_atomic_load_relaxed(&call_cache_stats_enabled)))
+                    jl_atomic_fetch_add_relaxed(&call_cache_evictions, 1);
+            }
+            jl_atomic_store_release(&call_cache[cache_idx[which]], entry);
+            if (site)
+                jl_atomic_store_release(site, entry);
         }
     }
 
@@ -2453,6 +2952,7 @@ have_entry:
         assert(tt);
         JL_LOCK(&mt->writelock);
         // cache miss case
+        JL_PROBE_MT_CACHE_MISS(mt, tt);
         JL_TIMING(METHOD_LOOKUP_SLOW);
         mfunc = jl_mt_assoc_by_type(mt, tt, world);
         JL_UNLOCK(&mt->writelock);
@@ -2481,11 +2981,119 @@ JL_DLLEXPORT jl_value_t *jl_apply_generic(jl_value_t *F, jl_value_t **args, uint
     size_t world = jl_current_task->world_age;
     jl_method_instance_t *mfunc = jl_lookup_generic_(F, args, nargs,
                                                      jl_int32hash_fast(jl_return_address()),
-                                                     world);
+                                                     world, NULL);
+    JL_GC_PROMISE_ROOTED(mfunc);
+    return _jl_invoke(F, args, nargs, mfunc, world);
+}
+
+// variant of jl_apply_generic used by codegen for call sites that own an
+// inline-cache slot (from jl_alloc_callsite_cache); the trailing argument
+// matches the JLCALL_F2_CC lowering, like jl_invoke
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site(jl_value_t *F, jl_value_t **args, uint32_t nargs, jl_value_t *site)
+{
+    size_t world = jl_current_task->world_age;
+    jl_method_instance_t *mfunc = jl_lookup_generic_(F, args, nargs,
+                                                     jl_int32hash_fast(jl_return_address()),
+                                                     world, (_Atomic(jl_typemap_entry_t*)*)site);
     JL_GC_PROMISE_ROOTED(mfunc);
     return _jl_invoke(F, args, nargs, mfunc, world);
 }
 
+// Register-based jlcall entries. Codegen calls these for dynamically
+// dispatched call sites with up to three arguments (see emit_apply_generic),
+// so the caller passes everything in registers instead of spilling an
+// argument array into its GC frame at every call site; the arguments are
+// marshalled and rooted here once, before the first safepoint.
+#define APPLY_GENERIC_REG_BODY(nargs, site)                                     \
+    do {                                                                        \
+        size_t world = jl_current_task->world_age;                              \
+        jl_method_instance_t *mfunc = jl_lookup_generic_(roots[0], &roots[1],   \
+                nargs, jl_int32hash_fast(jl_return_address()), world,           \
+                (_Atomic(jl_typemap_entry_t*)*)site);                           \
+        JL_GC_PROMISE_ROOTED(mfunc);                                            \
+        jl_value_t *ret = _jl_invoke(roots[0], &roots[1], nargs, mfunc, world); \
+        JL_GC_POP();                                                            \
+        return ret;                                                             \
+    } while (0)
+
+JL_DLLEXPORT jl_value_t *jl_apply_generic0(jl_value_t *F)
+{
+    jl_value_t **roots;
+    JL_GC_PUSHARGS(roots, 1);
+    roots[0] = F;
+    APPLY_GENERIC_REG_BODY(0, NULL);
+}
+
+JL_DLLEXPORT jl_value_t *jl_apply_generic1(jl_value_t *F, jl_value_t *a1)
+{
+    jl_value_t **roots;
+    JL_GC_PUSHARGS(roots, 2);
+    roots[0] = F;
+    roots[1] = a1;
+    APPLY_GENERIC_REG_BODY(1, NULL);
+}
+
+JL_DLLEXPORT jl_value_t *jl_apply_generic2(jl_value_t *F, jl_value_t *a1, jl_value_t *a2)
+{
+    jl_value_t **roots;
+    JL_GC_PUSHARGS(roots, 3);
+    roots[0] = F;
+    roots[1] = a1;
+    roots[2] = a2;
+    APPLY_GENERIC_REG_BODY(2, NULL);
+}
+
+JL_DLLEXPORT jl_value_t *jl_apply_generic3(jl_value_t *F, jl_value_t *a1, jl_value_t *a2, jl_value_t *a3)
+{
+    jl_value_t **roots;
+    JL_GC_PUSHARGS(roots, 4);
+    roots[0] = F;
+    roots[1] = a1;
+    roots[2] = a2;
+    roots[3] = a3;
+    APPLY_GENERIC_REG_BODY(3, NULL);
+}
+
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site0(jl_value_t *F, jl_value_t *site)
+{
+    jl_value_t **roots;
+    JL_GC_PUSHARGS(roots, 1);
+    roots[0] = F;
+    APPLY_GENERIC_REG_BODY(0, site);
+}
+
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site1(jl_value_t *F, jl_value_t *a1, jl_value_t *site)
+{
+    jl_value_t **roots;
+    JL_GC_PUSHARGS(roots, 2);
+    roots[0] = F;
+    roots[1] = a1;
+    APPLY_GENERIC_REG_BODY(1, site);
+}
+
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site2(jl_value_t *F, jl_value_t *a1, jl_value_t *a2, jl_value_t *site)
+{
+    jl_value_t **roots;
+    JL_GC_PUSHARGS(roots, 3);
+    roots[0] = F;
+    roots[1] = a1;
+    roots[2] = a2;
+    APPLY_GENERIC_REG_BODY(2, site);
+}
+
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site3(jl_value_t *F, jl_value_t *a1, jl_value_t *a2, jl_value_t *a3, jl_value_t *site)
+{
+    jl_value_t **roots;
+    JL_GC_PUSHARGS(roots, 4);
+    roots[0] = F;
+    roots[1] = a1;
+    roots[2] = a2;
+    roots[3] = a3;
+    APPLY_GENERIC_REG_BODY(3, site);
+}
+
+#undef APPLY_GENERIC_REG_BODY
+
 static jl_method_match_t *_gf_invoke_lookup(jl_value_t *types JL_PROPAGATES_ROOT, size_t world, size_t *min_valid, size_t *max_valid)
 {
     jl_value_t *unw = jl_unwrap_unionall((jl_value_t*)types);
@@ -2684,24 +3292,26 @@ static int ml_matches_visitor(jl_typemap_entry_t *ml, struct typemap_intersectio
     struct ml_matches_env *closure = container_of(closure0, struct ml_matches_env, match);
     if (closure->intersections == 0 && !closure0->issubty)
         return 1;
-    if (closure->world < ml->min_world) {
+    size_t ml_min_world = jl_atomic_load_relaxed(&ml->min_world);
+    size_t ml_max_world = jl_atomic_load_relaxed(&ml->max_world);
+    if (closure->world < ml_min_world) {
         // ignore method table entries that are part of a later world
-        if (closure->max_valid >= ml->min_world)
-            closure->max_valid = ml->min_world - 1;
+        if (closure->max_valid >= ml_min_world)
+            closure->max_valid = ml_min_world - 1;
         return 1;
     }
-    else if (closure->world > ml->max_world) {
+    else if (closure->world > ml_max_world) {
         // ignore method table entries that have been replaced in the current world
-        if (closure->min_valid <= ml->max_world)
-            closure->min_valid = ml->max_world + 1;
+        if (closure->min_valid <= ml_max_world)
+            closure->min_valid = ml_max_world + 1;
         return 1;
     }
     else {
         // intersect the env valid range with method's valid range
-        if (closure->min_valid < ml->min_world)
-            closure->min_valid = ml->min_world;
-        if (closure->max_valid > ml->max_world)
-            closure->max_valid = ml->max_world;
+        if (closure->min_valid < ml_min_world)
+            closure->min_valid = ml_min_world;
+        if (closure->max_valid > ml_max_world)
+            closure->max_valid = ml_max_world;
     }
     jl_method_t *meth = ml->func.method;
     if (closure->lim >= 0 && jl_is_dispatch_tupletype(meth->sig)) {
@@ -2784,10 +3394,10 @@ static jl_value_t *ml_matches(jl_methtable_t *mt, int offs,
                 env.match.env, meth, FULLY_COVERS);
             env.t = (jl_value_t*)jl_alloc_vec_any(1);
             jl_array_ptr_set(env.t, 0, env.matc);
-            if (*min_valid < entry->min_world)
-                *min_valid = entry->min_world;
-            if (*max_valid > entry->max_world)
-                *max_valid = entry->max_world;
+            if (*min_valid < jl_atomic_load_relaxed(&entry->min_world))
+                *min_valid = jl_atomic_load_relaxed(&entry->min_world);
+            if (*max_valid > jl_atomic_load_relaxed(&entry->max_world))
+                *max_valid = jl_atomic_load_relaxed(&entry->max_world);
             JL_GC_POP();
             return env.t;
         }
@@ -2810,8 +3420,8 @@ static jl_value_t *ml_matches(jl_methtable_t *mt, int offs,
                 env.match.env, meth, FULLY_COVERS);
             env.t = (jl_value_t*)jl_alloc_vec_any(1);
             jl_array_ptr_set(env.t, 0, env.matc);
-            *min_valid = entry->min_world;
-            *max_valid = entry->max_world;
+            *min_valid = jl_atomic_load_relaxed(&entry->min_world);
+            *max_valid = jl_atomic_load_relaxed(&entry->max_world);
             JL_GC_POP();
             return env.t;
         }
@@ -3220,6 +3830,108 @@ int jl_has_concrete_subtype(jl_value_t *typ)
 //static jl_mutex_t typeinf_lock;
 #define typeinf_lock jl_codegen_lock
 
+// Per-module and per-method attribution of compile and inference time.
+// jl_cumulative_compile_time answers "how much", these tables answer "who":
+// every measured inference invocation and every jl_generate_fptr compilation
+// adds its wall time under the defining method and its module. Only active
+// while jl_measure_compile_time_enabled is set, like the global counter.
+// Nested inference is included in its enclosing measurement, so entries are
+// inclusive and can overlap. Keys are scanned as GC roots so queries never
+// see dangling methods.
+htable_t jl_compile_time_module_table;
+htable_t jl_compile_time_method_table;
+static jl_mutex_t compile_time_attrib_lock;
+
+static void record_compile_time(htable_t *t, void *key, uint64_t ns)
+{
+    uint64_t **bp = (uint64_t**)ptrhash_bp(t, key);
+    if (*bp == (uint64_t*)HT_NOTFOUND) {
+        *bp = (uint64_t*)malloc_s(sizeof(uint64_t));
+        **bp = 0;
+    }
+    **bp += ns;
+}
+
+JL_DLLEXPORT void jl_record_compile_time_for(jl_method_instance_t *mi, uint64_t ns)
+{
+    if (mi == NULL || !jl_is_method(mi->def.value))
+        return;
+    jl_method_t *def = mi->def.method;
+    JL_LOCK_NOGC(&compile_time_attrib_lock);
+    if (jl_compile_time_module_table.size == 0) {
+        htable_new(&jl_compile_time_module_table, 0);
+        htable_new(&jl_compile_time_method_table, 0);
+    }
+    record_compile_time(&jl_compile_time_module_table, def->module, ns);
+    record_compile_time(&jl_compile_time_method_table, def, ns);
+    JL_UNLOCK_NOGC(&compile_time_attrib_lock);
+}
+
+static uint64_t compile_time_query(htable_t *t, void *key)
+{
+    uint64_t ns = 0;
+    JL_LOCK_NOGC(&compile_time_attrib_lock);
+    if (t->size != 0) {
+        uint64_t *cell = (uint64_t*)ptrhash_get(t, key);
+        if (cell != (uint64_t*)HT_NOTFOUND)
+            ns = *cell;
+    }
+    JL_UNLOCK_NOGC(&compile_time_attrib_lock);
+    return ns;
+}
+
+JL_DLLEXPORT uint64_t jl_module_compile_time_ns(jl_module_t *m)
+{
+    return compile_time_query(&jl_compile_time_module_table, m);
+}
+
+JL_DLLEXPORT uint64_t jl_method_compile_time_ns(jl_method_t *m)
+{
+    return compile_time_query(&jl_compile_time_method_table, m);
+}
+
+// flat [key1, ns1, key2, ns2, ...] snapshot for consumption from Base
+static jl_value_t *compile_time_snapshot(htable_t *t)
+{
+    typedef struct { void *key; uint64_t ns; } snap_entry_t;
+    snap_entry_t *scratch = NULL;
+    size_t n = 0, i, j = 0;
+    JL_LOCK_NOGC(&compile_time_attrib_lock);
+    for (i = 1; i < t->size; i += 2)
+        if (t->table[i] != HT_NOTFOUND)
+            n++;
+    if (n > 0) {
+        scratch = (snap_entry_t*)malloc_s(n * sizeof(snap_entry_t));
+        for (i = 1; i < t->size; i += 2) {
+            if (t->table[i] != HT_NOTFOUND) {
+                scratch[j].key = t->table[i - 1];
+                scratch[j].ns = *(uint64_t*)t->table[i];
+                j++;
+            }
+        }
+    }
+    JL_UNLOCK_NOGC(&compile_time_attrib_lock);
+    jl_array_t *a = jl_alloc_vec_any(2 * n);
+    JL_GC_PUSH1(&a);
+    for (i = 0; i < n; i++) {
+        jl_array_ptr_set(a, 2 * i, (jl_value_t*)scratch[i].key);
+        jl_array_ptr_set(a, 2 * i + 1, jl_box_uint64(scratch[i].ns));
+    }
+    JL_GC_POP();
+    free(scratch);
+    return (jl_value_t*)a;
+}
+
+JL_DLLEXPORT jl_value_t *jl_compile_time_by_module(void)
+{
+    return compile_time_snapshot(&jl_compile_time_module_table);
+}
+
+JL_DLLEXPORT jl_value_t *jl_compile_time_by_method(void)
+{
+    return compile_time_snapshot(&jl_compile_time_method_table);
+}
+
 static uint64_t inference_start_time = 0;
 static uint8_t inference_is_measuring_compile_time = 0;
 
@@ -5,7 +5,22 @@
 // compute empirical max-probe for a given size
 #define max_probe(size) ((size) <= 1024 ? 16 : (size) >> 6)
 
-#define keyhash(k) jl_object_id_(jl_typeof(k), k)
+// `jl_object_id_` is inlined here (this file is included from builtins.c),
+// so symbols, typenames, and concrete datatypes already hash through their
+// cached hash fields. Boxed small ints are the other common key class and
+// take the cold path there, so hash their payload directly; any two egal
+// ints have the same bits, which is all slot placement requires, and every
+// probe of a given table goes through this function so the choice is
+// self-consistent.
+static inline uint_t keyhash(jl_value_t *k) JL_NOTSAFEPOINT
+{
+    jl_value_t *t = jl_typeof(k);
+    if (t == (jl_value_t*)jl_int64_type)
+        return inthash((uintptr_t)*(int64_t*)jl_data_ptr(k));
+    if (t == (jl_value_t*)jl_int32_type)
+        return inthash((uintptr_t)(uint32_t)*(int32_t*)jl_data_ptr(k));
+    return jl_object_id_(t, k);
+}
 #define h2index(hv, sz) (size_t)(((hv) & ((sz)-1)) * 2)
 
 static inline int jl_table_assign_bp(jl_array_t **pa, jl_value_t *key, jl_value_t *val);
@@ -30,6 +45,35 @@ JL_DLLEXPORT jl_array_t *jl_idtable_rehash(jl_array_t *a, size_t newsz)
     return newa;
 }
 
+// Move up to `npairs` key/value pairs from the old table of an IdDict
+// mid-resize into the current one, starting at slot `*cursor`. Returns the
+// (possibly reallocated) current table and advances `*cursor`; the resize is
+// complete once `*cursor` reaches the old table's length. Migrated slots are
+// tombstoned in the old table so lookups and iteration over the unmigrated
+// remainder stay valid.
+JL_DLLEXPORT jl_array_t *jl_idtable_migrate(jl_array_t *oldt, jl_array_t *newt, size_t npairs, size_t *cursor)
+{
+    size_t sz = jl_array_len(oldt);
+    size_t i = *cursor & ~(size_t)1;
+    _Atomic(jl_value_t*) *ol = (_Atomic(jl_value_t*)*)oldt->data;
+    JL_GC_PUSH2(&newt, &oldt);
+    while (i < sz && npairs > 0) {
+        jl_value_t *val = jl_atomic_load_relaxed(&ol[i + 1]);
+        if (val != NULL) {
+            // an insertion made since the resize started removes the key from
+            // the old table first, so this cannot clobber a newer value
+            jl_table_assign_bp(&newt, jl_atomic_load_relaxed(&ol[i]), val);
+            jl_atomic_store_relaxed(&ol[i], jl_nothing); // tombstone the key
+            jl_atomic_store_relaxed(&ol[i + 1], NULL);   // and clear the value
+            npairs--;
+        }
+        i += 2;
+    }
+    *cursor = i;
+    JL_GC_POP();
+    return newt;
+}
+
 static inline int jl_table_assign_bp(jl_array_t **pa, jl_value_t *key, jl_value_t *val)
 {
     // pa points to a **un**rooted address
@@ -150,6 +194,21 @@ jl_array_t *jl_eqtable_put(jl_array_t *h, jl_value_t *key, jl_value_t *val, int
     return h;
 }
 
+// Pre-size the table for about `n` entries so that a bulk build does not
+// pay for the incremental doublings and their rehashes. Returns `h` itself
+// when it is already big enough, otherwise the rehashed replacement (the
+// caller must swap it in, as with jl_eqtable_put).
+JL_DLLEXPORT
+jl_array_t *jl_eqtable_sizehint(jl_array_t *h, size_t n)
+{
+    size_t newsz = next_power_of_two(n * 3); // keeps the table under ~2/3 full
+    if (newsz < HT_N_INLINE)
+        newsz = HT_N_INLINE;
+    if (jl_array_len(h) >= newsz)
+        return h;
+    return jl_idtable_rehash(h, newsz);
+}
+
 // Note: lookup in the IdDict is permitted concurrently, if you avoid deletions,
 // and assuming you do use an external lock around all insertions
 JL_DLLEXPORT
@@ -210,6 +210,7 @@ JL_DLLEXPORT void jl_atexit_hook(int exitcode)
         jl_write_coverage_data(jl_options.output_code_coverage);
     if (jl_options.malloc_log)
         jl_write_malloc_log();
+    jl_write_sysimg_page_trace();
     if (jl_base_module) {
         jl_value_t *f = jl_get_global(jl_base_module, jl_symbol("_atexit"));
         if (f != NULL) {
@@ -626,6 +627,7 @@ JL_DLLEXPORT void julia_init(JL_IMAGE_SEARCH rel)
     htable_new(&jl_current_modules, 0);
     JL_MUTEX_INIT(&jl_modules_mutex);
     ios_set_io_wait_func = jl_set_io_wait;
+    ios_prefault_func = jl_sysimg_prefault;
     jl_io_loop = uv_default_loop(); // this loop will internal events (spawning process etc.),
                                     // best to call this first, since it also initializes libuv
     jl_init_uv();
@@ -676,6 +678,7 @@ JL_DLLEXPORT void julia_init(JL_IMAGE_SEARCH rel)
     }
 
     jl_init_runtime_ccall();
+    jl_init_call_cache();
     jl_gc_init();
     jl_init_tasks();
     jl_init_threading();
@@ -23,6 +23,7 @@ typedef struct {
     size_t ip; // Leak the currently-evaluating statement index to backtrace capture
     int preevaluation; // use special rules for pre-evaluating expressions (deprecated--only for ccall handling)
     int continue_at; // statement index to jump to after leaving exception handler (0 if none)
+    const uint8_t *stmt_tags; // pre-decoded statement kinds (stmt_tag), one per statement
 } interpreter_state;
 
 
@@ -73,6 +74,65 @@ extern void JL_GC_ENABLEFRAME(interpreter_state*) JL_NOTSAFEPOINT;
 static jl_value_t *eval_value(jl_value_t *e, interpreter_state *s);
 static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip, int toplevel);
 
+// statement pre-decoding
+
+// Each statement is classified once per frame into one of these tags, so the
+// dispatch in `eval_body` is a switch over a dense byte (a jump table) instead
+// of re-running the jl_typeis / expr-head cascade on every executed statement.
+// This matters for loops run under `--compile=min`, where every iteration
+// otherwise pays for the full cascade.
+enum stmt_tag {
+    STMT_GENERIC = 0, // value-producing statement, handled by eval_stmt_value
+    STMT_GOTO,
+    STMT_GOTOIFNOT,
+    STMT_RETURN,
+    STMT_UPSILON,
+    STMT_PHI,         // only ever consumed by eval_phi, never dispatched
+    STMT_ASSIGN,
+    STMT_ENTER,
+    STMT_LEAVE,
+    STMT_POP_EXCEPTION,
+    STMT_EXPR_OTHER,  // expr heads with no fast path (method, toplevel, meta, ...)
+    STMT_NEWVAR,
+    STMT_LINENO,
+};
+
+static void decode_stmt_tags(jl_array_t *stmts, uint8_t *tags, size_t ns) JL_NOTSAFEPOINT
+{
+    for (size_t i = 0; i < ns; i++) {
+        jl_value_t *stmt = jl_array_ptr_ref(stmts, i);
+        uint8_t tag = STMT_GENERIC;
+        if (jl_is_expr(stmt)) {
+            jl_sym_t *head = ((jl_expr_t*)stmt)->head;
+            if (head == jl_assign_sym)
+                tag = STMT_ASSIGN;
+            else if (head == jl_enter_sym)
+                tag = STMT_ENTER;
+            else if (head == jl_leave_sym)
+                tag = STMT_LEAVE;
+            else if (head == jl_pop_exception_sym)
+                tag = STMT_POP_EXCEPTION;
+            else
+                tag = STMT_EXPR_OTHER;
+        }
+        else if (jl_is_gotonode(stmt))
+            tag = STMT_GOTO;
+        else if (jl_is_gotoifnot(stmt))
+            tag = STMT_GOTOIFNOT;
+        else if (jl_is_returnnode(stmt))
+            tag = STMT_RETURN;
+        else if (jl_is_upsilonnode(stmt))
+            tag = STMT_UPSILON;
+        else if (jl_is_phinode(stmt))
+            tag = STMT_PHI;
+        else if (jl_is_newvarnode(stmt))
+            tag = STMT_NEWVAR;
+        else if (jl_is_linenode(stmt))
+            tag = STMT_LINENO;
+        tags[i] = tag;
+    }
+}
+
 // method definition form
 
 static jl_value_t *eval_methoddef(jl_expr_t *ex, interpreter_state *s)
@@ -115,6 +175,8 @@ static jl_value_t *eval_methoddef(jl_expr_t *ex, interpreter_state *s)
 
 // expression evaluator
 
+extern jl_value_t *jl_builtin_tuple;
+
 static jl_value_t *do_call(jl_value_t **args, size_t nargs, interpreter_state *s)
 {
     jl_value_t **argv;
@@ -123,7 +185,13 @@ static jl_value_t *do_call(jl_value_t **args, size_t nargs, interpreter_state *s
     size_t i;
     for (i = 0; i < nargs; i++)
         argv[i] = eval_value(args[i], s);
-    jl_value_t *result = jl_apply(argv, nargs);
+    jl_value_t *result;
+    // lowered code builds many short-lived tuples for multiple-return
+    // emulation; construct them directly instead of dispatching
+    if (argv[0] == jl_builtin_tuple)
+        result = jl_f_tuple(NULL, &argv[1], nargs - 1);
+    else
+        result = jl_apply(argv, nargs);
     JL_GC_POP();
     return result;
 }
@@ -344,8 +412,7 @@ static size_t eval_phi(jl_array_t *stmts, interpreter_state *s, size_t ns, size_
     size_t ip = to;
     unsigned nphi = 0;
     for (ip = to; ip < ns; ip++) {
-        jl_value_t *e = jl_array_ptr_ref(stmts, ip);
-        if (!jl_is_phinode(e))
+        if (s->stmt_tags[ip] != STMT_PHI)
             break;
         nphi += 1;
     }
@@ -424,6 +491,7 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
     jl_handler_t __eh;
     size_t ns = jl_array_len(stmts);
     jl_task_t *ct = jl_current_task;
+    const uint8_t *tags = s->stmt_tags;
 
     while (1) {
         s->ip = ip;
@@ -432,13 +500,13 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
         if (toplevel)
             ct->world_age = jl_atomic_load_acquire(&jl_world_counter);
         jl_value_t *stmt = jl_array_ptr_ref(stmts, ip);
-        assert(!jl_is_phinode(stmt));
         size_t next_ip = ip + 1;
         assert(!jl_is_phinode(stmt) && !jl_is_phicnode(stmt) && "malformed IR");
-        if (jl_is_gotonode(stmt)) {
+        switch (tags[ip]) {
+        case STMT_GOTO:
             next_ip = jl_gotonode_label(stmt) - 1;
-        }
-        else if (jl_is_gotoifnot(stmt)) {
+            break;
+        case STMT_GOTOIFNOT: {
             jl_value_t *cond = eval_value(jl_gotoifnot_cond(stmt), s);
             if (cond == jl_false) {
                 next_ip = jl_gotoifnot_label(stmt) - 1;
@@ -446,11 +514,11 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
             else if (cond != jl_true) {
                 jl_type_error("if", (jl_value_t*)jl_bool_type, cond);
             }
+            break;
         }
-        else if (jl_is_returnnode(stmt)) {
+        case STMT_RETURN:
             return eval_value(jl_returnnode_value(stmt), s);
-        }
-        else if (jl_is_upsilonnode(stmt)) {
+        case STMT_UPSILON: {
             jl_value_t *val = jl_fieldref_noalloc(stmt, 0);
             if (val)
                 val = eval_value(val, s);
@@ -458,158 +526,165 @@ static jl_value_t *eval_body(jl_array_t *stmts, interpreter_state *s, size_t ip,
             assert(jl_is_ssavalue(phic));
             ssize_t id = ((jl_ssavalue_t*)phic)->id - 1;
             s->locals[jl_source_nslots(s->src) + id] = val;
+            break;
         }
-        else if (jl_is_expr(stmt)) {
-            // Most exprs are allowed to end a BB by fall through
-            jl_sym_t *head = ((jl_expr_t*)stmt)->head;
-            if (head == jl_assign_sym) {
-                jl_value_t *lhs = jl_exprarg(stmt, 0);
-                jl_value_t *rhs = eval_value(jl_exprarg(stmt, 1), s);
-                if (jl_is_slot(lhs)) {
-                    ssize_t n = jl_slot_number(lhs);
-                    assert(n <= jl_source_nslots(s->src) && n > 0);
-                    s->locals[n - 1] = rhs;
+        case STMT_ASSIGN: {
+            jl_value_t *lhs = jl_exprarg(stmt, 0);
+            jl_value_t *rhs = eval_value(jl_exprarg(stmt, 1), s);
+            if (jl_is_slot(lhs)) {
+                ssize_t n = jl_slot_number(lhs);
+                assert(n <= jl_source_nslots(s->src) && n > 0);
+                s->locals[n - 1] = rhs;
+            }
+            else {
+                jl_module_t *modu;
+                jl_sym_t *sym;
+                if (jl_is_globalref(lhs)) {
+                    modu = jl_globalref_mod(lhs);
+                    sym = jl_globalref_name(lhs);
                 }
                 else {
-                    jl_module_t *modu;
-                    jl_sym_t *sym;
-                    if (jl_is_globalref(lhs)) {
-                        modu = jl_globalref_mod(lhs);
-                        sym = jl_globalref_name(lhs);
-                    }
-                    else {
-                        assert(jl_is_symbol(lhs));
-                        modu = s->module;
-                        sym = (jl_sym_t*)lhs;
-                    }
-                    JL_GC_PUSH1(&rhs);
-                    jl_binding_t *b = jl_get_binding_wr(modu, sym, 1);
-                    jl_checked_assignment(b, rhs);
-                    JL_GC_POP();
+                    assert(jl_is_symbol(lhs));
+                    modu = s->module;
+                    sym = (jl_sym_t*)lhs;
                 }
+                JL_GC_PUSH1(&rhs);
+                jl_binding_t *b = jl_get_binding_wr(modu, sym, 1);
+                jl_checked_assignment(b, rhs);
+                JL_GC_POP();
             }
-            else if (head == jl_enter_sym) {
-                jl_enter_handler(&__eh);
-                // This is a bit tricky, but supports the implementation of PhiC nodes.
-                // They are conceptually slots, but the slot to store to doesn't get explicitly
-                // mentioned in the store (aka the "UpsilonNode") (this makes them integrate more
-                // nicely with the rest of the SSA representation). In a compiler, we would figure
-                // out which slot to store to at compile time when we encounter the statement. We
-                // can't quite do that here, but we do something similar: We scan the catch entry
-                // block (the only place where PhiC nodes may occur) to find all the Upsilons we
-                // can possibly encounter. Then, we remember which slot they store to (we abuse the
-                // SSA value result array for this purpose). TODO: We could do this only the first
-                // time we encounter a given enter.
-                size_t catch_ip = jl_unbox_long(jl_exprarg(stmt, 0)) - 1;
-                while (catch_ip < ns) {
-                    jl_value_t *phicnode = jl_array_ptr_ref(stmts, catch_ip);
-                    if (!jl_is_phicnode(phicnode))
-                        break;
-                    jl_array_t *values = (jl_array_t*)jl_fieldref_noalloc(phicnode, 0);
-                    for (size_t i = 0; i < jl_array_len(values); ++i) {
-                        jl_value_t *val = jl_array_ptr_ref(values, i);
-                        assert(jl_is_ssavalue(val));
-                        size_t upsilon = ((jl_ssavalue_t*)val)->id - 1;
-                        assert(jl_is_upsilonnode(jl_array_ptr_ref(stmts, upsilon)));
-                        s->locals[jl_source_nslots(s->src) + upsilon] = jl_box_ssavalue(catch_ip + 1);
-                    }
-                    s->locals[jl_source_nslots(s->src) + catch_ip] = NULL;
-                    catch_ip += 1;
-                }
-                // store current top of exception stack for restore in pop_exception.
-                s->locals[jl_source_nslots(s->src) + ip] = jl_box_ulong(jl_excstack_state());
-                if (!jl_setjmp(__eh.eh_ctx, 1)) {
-                    return eval_body(stmts, s, next_ip, toplevel);
-                }
-                else if (s->continue_at) { // means we reached a :leave expression
-                    ip = s->continue_at;
-                    s->continue_at = 0;
-                    continue;
-                }
-                else { // a real exception
-                    ip = catch_ip;
-                    continue;
+            break;
+        }
+        case STMT_ENTER: {
+            jl_enter_handler(&__eh);
+            // This is a bit tricky, but supports the implementation of PhiC nodes.
+            // They are conceptually slots, but the slot to store to doesn't get explicitly
+            // mentioned in the store (aka the "UpsilonNode") (this makes them integrate more
+            // nicely with the rest of the SSA representation). In a compiler, we would figure
+            // out which slot to store to at compile time when we encounter the statement. We
+            // can't quite do that here, but we do something similar: We scan the catch entry
+            // block (the only place where PhiC nodes may occur) to find all the Upsilons we
+            // can possibly encounter. Then, we remember which slot they store to (we abuse the
+            // SSA value result array for this purpose). TODO: We could do this only the first
+            // time we encounter a given enter.
+            size_t catch_ip = jl_unbox_long(jl_exprarg(stmt, 0)) - 1;
+            while (catch_ip < ns) {
+                jl_value_t *phicnode = jl_array_ptr_ref(stmts, catch_ip);
+                if (!jl_is_phicnode(phicnode))
+                    break;
+                jl_array_t *values = (jl_array_t*)jl_fieldref_noalloc(phicnode, 0);
+                for (size_t i = 0; i < jl_array_len(values); ++i) {
+                    jl_value_t *val = jl_array_ptr_ref(values, i);
+                    assert(jl_is_ssavalue(val));
+                    size_t upsilon = ((jl_ssavalue_t*)val)->id - 1;
+                    assert(jl_is_upsilonnode(jl_array_ptr_ref(stmts, upsilon)));
+                    s->locals[jl_source_nslots(s->src) + upsilon] = jl_box_ssavalue(catch_ip + 1);
                 }
+                s->locals[jl_source_nslots(s->src) + catch_ip] = NULL;
+                catch_ip += 1;
             }
-            else if (head == jl_leave_sym) {
-                int hand_n_leave = jl_unbox_long(jl_exprarg(stmt, 0));
-                assert(hand_n_leave > 0);
-                // equivalent to jl_pop_handler(hand_n_leave), but retaining eh for longjmp:
-                jl_handler_t *eh = ct->eh;
-                while (--hand_n_leave > 0)
-                    eh = eh->prev;
-                jl_eh_restore_state(eh);
-                // leave happens during normal control flow, but we must
-                // longjmp to pop the eval_body call for each enter.
-                s->continue_at = next_ip;
-                jl_longjmp(eh->eh_ctx, 1);
+            // store current top of exception stack for restore in pop_exception.
+            s->locals[jl_source_nslots(s->src) + ip] = jl_box_ulong(jl_excstack_state());
+            if (!jl_setjmp(__eh.eh_ctx, 1)) {
+                return eval_body(stmts, s, next_ip, toplevel);
             }
-            else if (head == jl_pop_exception_sym) {
-                size_t prev_state = jl_unbox_ulong(eval_value(jl_exprarg(stmt, 0), s));
-                jl_restore_excstack(prev_state);
+            else if (s->continue_at) { // means we reached a :leave expression
+                ip = s->continue_at;
+                s->continue_at = 0;
+                continue;
             }
-            else if (toplevel) {
-                if (head == jl_method_sym && jl_expr_nargs(stmt) > 1) {
-                    eval_methoddef((jl_expr_t*)stmt, s);
-                }
-                else if (head == jl_toplevel_sym) {
-                    jl_value_t *res = jl_toplevel_eval(s->module, stmt);
-                    s->locals[jl_source_nslots(s->src) + s->ip] = res;
+            else { // a real exception
+                ip = catch_ip;
+                continue;
+            }
+        }
+        case STMT_LEAVE: {
+            int hand_n_leave = jl_unbox_long(jl_exprarg(stmt, 0));
+            assert(hand_n_leave > 0);
+            // equivalent to jl_pop_handler(hand_n_leave), but retaining eh for longjmp:
+            jl_handler_t *eh = ct->eh;
+            while (--hand_n_leave > 0)
+                eh = eh->prev;
+            jl_eh_restore_state(eh);
+            // leave happens during normal control flow, but we must
+            // longjmp to pop the eval_body call for each enter.
+            s->continue_at = next_ip;
+            jl_longjmp(eh->eh_ctx, 1);
+        }
+        case STMT_POP_EXCEPTION: {
+            size_t prev_state = jl_unbox_ulong(eval_value(jl_exprarg(stmt, 0), s));
+            jl_restore_excstack(prev_state);
+            break;
+        }
+        case STMT_EXPR_OTHER: {
+            // Most exprs are allowed to end a BB by fall through
+            jl_sym_t *head = ((jl_expr_t*)stmt)->head;
+            if (!toplevel) {
+                eval_stmt_value(stmt, s);
+            }
+            else if (head == jl_method_sym && jl_expr_nargs(stmt) > 1) {
+                eval_methoddef((jl_expr_t*)stmt, s);
+            }
+            else if (head == jl_toplevel_sym) {
+                jl_value_t *res = jl_toplevel_eval(s->module, stmt);
+                s->locals[jl_source_nslots(s->src) + s->ip] = res;
+            }
+            else if (jl_is_toplevel_only_expr(stmt)) {
+                jl_toplevel_eval(s->module, stmt);
+            }
+            else if (head == jl_meta_sym) {
+                if (jl_expr_nargs(stmt) == 1 && jl_exprarg(stmt, 0) == (jl_value_t*)jl_nospecialize_sym) {
+                    jl_set_module_nospecialize(s->module, 1);
                 }
-                else if (jl_is_toplevel_only_expr(stmt)) {
-                    jl_toplevel_eval(s->module, stmt);
+                if (jl_expr_nargs(stmt) == 1 && jl_exprarg(stmt, 0) == (jl_value_t*)jl_specialize_sym) {
+                    jl_set_module_nospecialize(s->module, 0);
                 }
-                else if (head == jl_meta_sym) {
-                    if (jl_expr_nargs(stmt) == 1 && jl_exprarg(stmt, 0) == (jl_value_t*)jl_nospecialize_sym) {
-                        jl_set_module_nospecialize(s->module, 1);
-                    }
-                    if (jl_expr_nargs(stmt) == 1 && jl_exprarg(stmt, 0) == (jl_value_t*)jl_specialize_sym) {
-                        jl_set_module_nospecialize(s->module, 0);
-                    }
-                    if (jl_expr_nargs(stmt) == 2) {
-                        if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_optlevel_sym) {
-                            if (jl_is_long(jl_exprarg(stmt, 1))) {
-                                int n = jl_unbox_long(jl_exprarg(stmt, 1));
-                                jl_set_module_optlevel(s->module, n);
-                            }
+                if (jl_expr_nargs(stmt) == 2) {
+                    if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_optlevel_sym) {
+                        if (jl_is_long(jl_exprarg(stmt, 1))) {
+                            int n = jl_unbox_long(jl_exprarg(stmt, 1));
+                            jl_set_module_optlevel(s->module, n);
                         }
-                        else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_compile_sym) {
-                            if (jl_is_long(jl_exprarg(stmt, 1))) {
-                                jl_set_module_compile(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
-                            }
+                    }
+                    else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_compile_sym) {
+                        if (jl_is_long(jl_exprarg(stmt, 1))) {
+                            jl_set_module_compile(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
                         }
-                        else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_infer_sym) {
-                            if (jl_is_long(jl_exprarg(stmt, 1))) {
-                                jl_set_module_infer(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
-                            }
+                    }
+                    else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_infer_sym) {
+                        if (jl_is_long(jl_exprarg(stmt, 1))) {
+                            jl_set_module_infer(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
                         }
-                        else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_max_methods_sym) {
-                            if (jl_is_long(jl_exprarg(stmt, 1))) {
-                                jl_set_module_max_methods(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
-                            }
+                    }
+                    else if (jl_exprarg(stmt, 0) == (jl_value_t*)jl_max_methods_sym) {
+                        if (jl_is_long(jl_exprarg(stmt, 1))) {
+                            jl_set_module_max_methods(s->module, jl_unbox_long(jl_exprarg(stmt, 1)));
                         }
                     }
                 }
-                else {
-                    eval_stmt_value(stmt, s);
-                }
             }
             else {
                 eval_stmt_value(stmt, s);
             }
+            break;
         }
-        else if (jl_is_newvarnode(stmt)) {
+        case STMT_NEWVAR: {
             jl_value_t *var = jl_fieldref(stmt, 0);
             assert(jl_is_slot(var));
             ssize_t n = jl_slot_number(var);
             assert(n <= jl_source_nslots(s->src) && n > 0);
             s->locals[n - 1] = NULL;
+            break;
         }
-        else if (toplevel && jl_is_linenode(stmt)) {
-            jl_lineno = jl_linenode_line(stmt);
-        }
-        else {
+        case STMT_LINENO:
+            if (toplevel)
+                jl_lineno = jl_linenode_line(stmt);
+            else
+                eval_stmt_value(stmt, s);
+            break;
+        default:
             eval_stmt_value(stmt, s);
+            break;
         }
         ip = eval_phi(stmts, s, ns, next_ip);
     }
@@ -661,6 +736,10 @@ jl_value_t *NOINLINE jl_fptr_interpret_call(jl_value_t *f, jl_value_t **args, ui
     locals[1] = (jl_value_t*)stmts;
     s->locals = locals + 2;
     s->src = src;
+    uint8_t *stmt_tags;
+    JL_CPPALLOCA(stmt_tags, jl_array_len(stmts));
+    decode_stmt_tags(stmts, stmt_tags, jl_array_len(stmts));
+    s->stmt_tags = stmt_tags;
     if (jl_is_module(mi->def.value)) {
         s->module = mi->def.module;
     }
@@ -693,7 +772,18 @@ JL_DLLEXPORT jl_callptr_t jl_fptr_interpret_call_addr = &jl_fptr_interpret_call;
 jl_value_t *jl_interpret_opaque_closure(jl_opaque_closure_t *oc, jl_value_t **args, size_t nargs)
 {
     jl_method_t *source = oc->source;
-    jl_code_info_t *code = jl_uncompress_ir(source, NULL, (jl_array_t*)source->source);
+    // the closure carries its source's specialization; memoize the
+    // uncompressed IR there so only the first call pays for decompression
+    // (same benign race as jl_code_for_interpreter)
+    jl_method_instance_t *mi = (jl_method_instance_t*)oc->specptr;
+    jl_code_info_t *code = mi == NULL ? NULL : (jl_code_info_t*)mi->uninferred;
+    if (code == NULL || !jl_is_code_info(code)) {
+        code = jl_uncompress_ir(source, NULL, (jl_array_t*)source->source);
+        if (mi != NULL) {
+            mi->uninferred = (jl_value_t*)code;
+            jl_gc_wb(mi, code);
+        }
+    }
     interpreter_state *s;
     unsigned nroots = jl_source_nslots(code) + jl_source_nssavalues(code) + 2;
     jl_value_t **locals = NULL;
@@ -705,6 +795,10 @@ jl_value_t *jl_interpret_opaque_closure(jl_opaque_closure_t *oc, jl_value_t **ar
     locals[2] = (jl_value_t*)oc->captures;
     s->locals = locals + 2;
     s->src = code;
+    uint8_t *stmt_tags;
+    JL_CPPALLOCA(stmt_tags, jl_array_len(code->code));
+    decode_stmt_tags(code->code, stmt_tags, jl_array_len(code->code));
+    s->stmt_tags = stmt_tags;
     s->module = source->module;
     s->sparam_vals = NULL;
     s->preevaluation = 0;
@@ -734,6 +828,10 @@ jl_value_t *NOINLINE jl_interpret_toplevel_thunk(jl_module_t *m, jl_code_info_t
     jl_array_t *stmts = src->code;
     assert(jl_typeis(stmts, jl_array_any_type));
     s->src = src;
+    uint8_t *stmt_tags;
+    JL_CPPALLOCA(stmt_tags, jl_array_len(stmts));
+    decode_stmt_tags(stmts, stmt_tags, jl_array_len(stmts));
+    s->stmt_tags = stmt_tags;
     s->module = m;
     s->sparam_vals = jl_emptysvec;
     s->continue_at = 0;
@@ -757,6 +855,7 @@ jl_value_t *NOINLINE jl_interpret_toplevel_expr_in(jl_module_t *m, jl_value_t *e
     JL_GC_PUSHFRAME(s, locals, 0);
     (void)locals;
     s->src = src;
+    s->stmt_tags = NULL; // only eval_value below, no statement dispatch
     s->module = m;
     s->sparam_vals = sparam_vals;
     s->preevaluation = (sparam_vals != NULL);
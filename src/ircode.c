@@ -5,6 +5,7 @@
 */
 #include <stdlib.h>
 #include <string.h>
+#include <zlib.h>
 
 #include "julia.h"
 #include "julia_internal.h"
@@ -385,9 +386,15 @@ static jl_code_info_flags_t code_info_flags(uint8_t pure, uint8_t propagate_inbo
     flags.bits.inlineable = inlineable;
     flags.bits.inferred = inferred;
     flags.bits.constprop = constprop;
+    flags.bits.compressed = 0;
     return flags;
 }
 
+// Bodies at least this large get an extra deflate pass on top of the tag
+// encoding. Small methods dominate by count but not by bytes, and deflate's
+// fixed overhead makes them a net loss, so they stay as plain tag streams.
+#define IR_DEFLATE_THRESHOLD 512
+
 // --- decoding ---
 
 static jl_value_t *jl_decode_value(jl_ircode_state *s) JL_GC_DISABLED;
@@ -757,6 +764,32 @@ JL_DLLEXPORT jl_array_t *jl_compress_ir(jl_method_t *m, jl_code_info_t *code)
     }
 
     ios_flush(s.s);
+
+    // Entropy-compress the body. The plaintext prefix written above (flags,
+    // nslots, slotflags) stays uncompressed so that the jl_ir_ accessors can
+    // keep peeking at it; everything after it deflates well since the tag
+    // encoding leaves plenty of redundancy in larger methods. The deflated
+    // body is preceded by its original length, and the flag bit in byte 0
+    // tells jl_uncompress_ir which layout it is looking at.
+    size_t hdrlen = 1 + sizeof(int32_t) + nslots;
+    size_t bodylen = dest.size - hdrlen;
+    if (bodylen >= IR_DEFLATE_THRESHOLD) {
+        uLongf complen = compressBound(bodylen);
+        uint8_t *compbuf = (uint8_t*)malloc_s(complen);
+        if (compress2(compbuf, &complen, (Bytef*)&dest.buf[hdrlen], bodylen,
+                      Z_DEFAULT_COMPRESSION) == Z_OK &&
+                complen + sizeof(int32_t) < bodylen) {
+            flags.bits.compressed = 1;
+            dest.buf[0] = flags.packed;
+            dest.size = hdrlen;
+            ios_seek(&dest, hdrlen);
+            write_int32(&dest, bodylen);
+            ios_write(&dest, (char*)compbuf, complen);
+            ios_flush(&dest);
+        }
+        free(compbuf);
+    }
+
     jl_array_t *v = jl_take_buffer(&dest);
     ios_close(s.s);
     if (jl_array_len(m->roots) == 0) {
@@ -802,6 +835,24 @@ JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t
     code->slotflags = jl_alloc_array_1d(jl_array_uint8_type, nslots);
     ios_readall(s.s, (char*)jl_array_data(code->slotflags), nslots);
 
+    // inflate the body into a scratch buffer and decode from that instead
+    ios_t body;
+    uint8_t *inflated = NULL;
+    if (flags.bits.compressed) {
+        size_t bodylen = (uint32_t)read_int32(s.s);
+        uLongf rawlen = bodylen;
+        inflated = (uint8_t*)malloc_s(bodylen);
+        int ret = uncompress(inflated, &rawlen, (Bytef*)&src.buf[src.bpos],
+                             src.size - src.bpos);
+        assert(ret == Z_OK && rawlen == bodylen);
+        (void)ret;
+        ios_seek(&src, src.size);
+        ios_mem(&body, 0);
+        ios_setbuf(&body, (char*)inflated, rawlen, 0);
+        body.size = rawlen;
+        s.s = &body;
+    }
+
     for (i = 0; i < 6; i++) {
         if (i == 1)  // skip codelocs
             continue;
@@ -832,6 +883,11 @@ JL_DLLEXPORT jl_code_info_t *jl_uncompress_ir(jl_method_t *m, jl_code_instance_t
     }
 
     assert(ios_getc(s.s) == -1);
+    if (flags.bits.compressed) {
+        ios_close(&body);
+        free(inflated);
+        s.s = &src;
+    }
     ios_close(s.s);
     JL_GC_PUSH1(&code);
     jl_gc_enable(en);
@@ -6,6 +6,9 @@
 
 #include "llvm/IR/Mangler.h"
 #include <llvm/ADT/StringMap.h>
+#include <llvm/IR/PassTimingInfo.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/ExecutionEngine/Orc/CompileUtils.h>
@@ -24,15 +27,42 @@
 
 using namespace llvm;
 
+#include <atomic>
+
 #include "julia.h"
 #include "julia_internal.h"
 #include "codegen_shared.h"
 #include "jitlayers.h"
 #include "julia_assert.h"
 
+#ifdef JL_USE_JITLINK
+#include <llvm/ExecutionEngine/JITLink/EHFrameSupport.h>
+#include <llvm/ExecutionEngine/JITLink/JITLinkMemoryManager.h>
+#endif
+
 RTDyldMemoryManager* createRTDyldMemoryManager(void);
 
-void jl_init_jit(void) { }
+// Tiered compilation (opt-in): when JULIA_TIERED_COMPILATION=<threshold> is
+// set, freshly generated code instances are compiled at -O0 so first calls
+// start quickly, and the dispatch path in gf.c counts invocations and calls
+// jl_promote_codeinst once a code instance crosses the threshold, recompiling
+// it at the session's full optimization level.
+static int jl_tiered_threshold = 0;
+// per-batch optimization-level override, valid while the codegen lock is
+// held; read by compileModule, including from the compile thread pool
+static std::atomic<int> jl_jit_opt_override{-1};
+
+void jl_init_jit(void)
+{
+    if (char *cp = getenv("JULIA_TIERED_COMPILATION"))
+        jl_tiered_threshold = atoi(cp);
+    // Attribute JIT time to individual LLVM passes. The cached pipelines
+    // (see PipelineT) accumulate into LLVM's pass timers across their whole
+    // lifetime, and LLVM prints the report to stderr during shutdown.
+    const char *time_passes = getenv(LLVM_TIME_PASSES_NAME);
+    if (time_passes && strcmp(time_passes, "0") != 0)
+        TimePassesIsEnabled = true;
+}
 
 // Snooping on which functions are being compiled, and how long it takes
 JL_STREAM *dump_compiles_stream = NULL;
@@ -48,7 +78,7 @@ void jl_dump_llvm_opt(void *s)
     dump_llvm_opt_stream = (JL_STREAM*)s;
 }
 
-static void jl_add_to_ee(std::unique_ptr<Module> m);
+static void jl_add_to_ee(std::unique_ptr<Module> m, std::vector<std::unique_ptr<Module>> *pending = nullptr);
 static void jl_add_to_ee(std::unique_ptr<Module> &M, StringMap<std::unique_ptr<Module>*> &NewExports);
 static uint64_t getAddressForFunction(StringRef fname);
 
@@ -83,10 +113,17 @@ void jl_jit_globals(std::map<void *, GlobalVariable*> &globals)
 static jl_callptr_t _jl_compile_codeinst(
         jl_code_instance_t *codeinst,
         jl_code_info_t *src,
-        size_t world)
+        size_t world,
+        int promoting)
 {
     // caller must hold codegen_lock
     // and have disabled finalizers
+    // in tiered mode, fresh compiles run at -O0 and promotions at the
+    // session's optimization level (cleared again below)
+    if (jl_tiered_threshold > 0)
+        jl_jit_opt_override.store(promoting ? jl_options.opt_level : 0,
+                                  std::memory_order_relaxed);
+    JL_PROBE_JIT_COMPILE_BEGIN(codeinst->def);
     uint64_t start_time = 0;
     if (dump_compiles_stream != NULL)
         start_time = jl_hrtime();
@@ -162,6 +199,18 @@ static jl_callptr_t _jl_compile_codeinst(
             }
             jl_atomic_store_release(&this_code->invoke, addr);
         }
+        else if (promoting && this_code == codeinst) {
+            // tier promotion: the invoke-ptr must stay fixed (see above), so
+            // only the specptr may be replaced, and only when the recompiled
+            // code goes through the same trampoline as the old code, making
+            // the swap a single atomic store that any concurrent caller
+            // tolerates (both the old and the new code remain valid)
+            if ((addr == jl_fptr_args_addr || addr == jl_fptr_sparam_addr) &&
+                    jl_atomic_load_relaxed(&this_code->invoke) == addr &&
+                    !decls.specFunctionObject.empty()) {
+                jl_atomic_store_release(&this_code->specptr.fptr, (void*)getAddressForFunction(decls.specFunctionObject));
+            }
+        }
         else if (this_code->invoke == jl_fptr_const_return_addr && !decls.specFunctionObject.empty()) {
             // hack to export this pointer value to jl_dump_method_disasm
             jl_atomic_store_release(&this_code->specptr.fptr, (void*)getAddressForFunction(decls.specFunctionObject));
@@ -169,6 +218,8 @@ static jl_callptr_t _jl_compile_codeinst(
         if (this_code== codeinst)
             fptr = addr;
     }
+    if (jl_tiered_threshold > 0)
+        jl_jit_opt_override.store(-1, std::memory_order_relaxed);
 
     uint64_t end_time = 0;
     if (dump_compiles_stream != NULL)
@@ -184,6 +235,7 @@ static jl_callptr_t _jl_compile_codeinst(
             jl_printf(dump_compiles_stream, "\"\n");
         }
     }
+    JL_PROBE_JIT_COMPILE_END(codeinst->def);
     return fptr;
 }
 
@@ -311,18 +363,64 @@ jl_code_instance_t *jl_generate_fptr_impl(jl_method_instance_t *mi JL_PROPAGATES
             if (src->inferred && !codeinst->inferred)
                 codeinst->inferred = jl_nothing;
         }
-        _jl_compile_codeinst(codeinst, src, world);
+        _jl_compile_codeinst(codeinst, src, world, 0);
         if (codeinst->invoke == NULL)
             codeinst = NULL;
     }
     else {
         codeinst = NULL;
     }
+    if (jl_codegen_lock.count == 1 && measure_compile_time_enabled) {
+        uint64_t t_comp = jl_hrtime() - compiler_start_time;
+        jl_atomic_fetch_add_relaxed(&jl_cumulative_compile_time, t_comp);
+        jl_record_compile_time_for(mi, t_comp);
+    }
+    JL_UNLOCK(&jl_codegen_lock);
+    JL_GC_POP();
+    return codeinst;
+}
+
+// recompile a code instance at the session's full optimization level and
+// swap the better code in; called from the dispatch path in gf.c once an
+// -O0 baseline compile crosses the tiered-compilation hotness threshold
+extern "C" JL_DLLEXPORT
+void jl_promote_codeinst_impl(jl_code_instance_t *codeinst)
+{
+    if (jl_tiered_threshold <= 0)
+        return;
+    jl_callptr_t invoke = jl_atomic_load_relaxed(&codeinst->invoke);
+    // only code reached through the generic trampolines can be promoted: for
+    // everything else (specsig wrappers, constant returns, interpreted code)
+    // the invoke pointer itself would have to change, which concurrent
+    // callers cannot tolerate (see _jl_compile_codeinst)
+    if (invoke != jl_fptr_args_addr && invoke != jl_fptr_sparam_addr)
+        return;
+    jl_method_instance_t *mi = codeinst->def;
+    if (!jl_is_method(mi->def.method))
+        return;
+    JL_LOCK(&jl_codegen_lock);
+    uint64_t compiler_start_time = 0;
+    uint8_t measure_compile_time_enabled = jl_atomic_load_relaxed(&jl_measure_compile_time_enabled);
+    if (measure_compile_time_enabled)
+        compiler_start_time = jl_hrtime();
+    size_t world = codeinst->min_world;
+    jl_code_info_t *src = (jl_code_info_t*)codeinst->inferred;
+    JL_GC_PUSH1(&src);
+    if ((jl_value_t*)src == jl_nothing)
+        src = NULL;
+    else if (src != NULL)
+        src = jl_uncompress_ir(mi->def.method, codeinst, (jl_array_t*)src);
+    if (src == NULL && jl_symbol_name(mi->def.method->name)[0] != '@' &&
+            mi->def.method->source != jl_nothing) {
+        // the inferred IR was discarded after the baseline compile; redo it
+        src = jl_type_infer(mi, world, 0);
+    }
+    if (src && jl_is_code_info(src))
+        _jl_compile_codeinst(codeinst, src, world, 1);
     if (jl_codegen_lock.count == 1 && measure_compile_time_enabled)
         jl_atomic_fetch_add_relaxed(&jl_cumulative_compile_time, (jl_hrtime() - compiler_start_time));
     JL_UNLOCK(&jl_codegen_lock);
     JL_GC_POP();
-    return codeinst;
 }
 
 extern "C" JL_DLLEXPORT
@@ -355,7 +453,7 @@ void jl_generate_fptr_for_unspecialized_impl(jl_code_instance_t *unspec)
             src = (jl_code_info_t*)unspec->def->uninferred;
         }
         assert(src && jl_is_code_info(src));
-        _jl_compile_codeinst(unspec, src, unspec->min_world);
+        _jl_compile_codeinst(unspec, src, unspec->min_world, 0);
         if (unspec->invoke == NULL) {
             // if we hit a codegen bug (or ran into a broken generated function or llvmcall), fall back to the interpreter as a last resort
             jl_atomic_store_release(&unspec->invoke, jl_fptr_interpret_call_addr);
@@ -406,7 +504,7 @@ jl_value_t *jl_dump_method_asm_impl(jl_method_instance_t *mi, size_t world,
                 specfptr = (uintptr_t)jl_atomic_load_relaxed(&codeinst->specptr.fptr);
                 if (src && jl_is_code_info(src)) {
                     if (fptr == (uintptr_t)jl_fptr_const_return_addr && specfptr == 0) {
-                        fptr = (uintptr_t)_jl_compile_codeinst(codeinst, src, world);
+                        fptr = (uintptr_t)_jl_compile_codeinst(codeinst, src, world, 0);
                         specfptr = (uintptr_t)jl_atomic_load_relaxed(&codeinst->specptr.fptr);
                     }
                 }
@@ -427,6 +525,121 @@ jl_value_t *jl_dump_method_asm_impl(jl_method_instance_t *mi, size_t world,
     return jl_dump_function_asm(F, raw_mc, asm_variant, debuginfo, binary);
 }
 
+// Custom object emission notification handler for the JuliaOJIT
+extern JITEventListener *CreateJuliaJITEventListener();
+
+#ifdef JL_USE_JITLINK
+
+JL_DLLEXPORT void ORCNotifyJITLinkEmitted(JITEventListener *Listener,
+                                          std::unique_ptr<object::ObjectFile> DebugObj,
+                                          std::unique_ptr<MemoryBuffer> DebugObjBuffer,
+                                          StringMap<uint64_t> SectionLoadAddresses);
+
+namespace {
+
+// Hands each linked object over to debuginfo.cpp so backtraces and profile
+// attribution keep working under JITLink. We keep a copy of the input object
+// (and collect its section load addresses once allocation has run) because
+// JITLink, unlike RTDyld, does not keep an object-file representation of the
+// linked code around.
+struct JITObjectInfo {
+    std::unique_ptr<MemoryBuffer> BackingBuffer;
+    std::unique_ptr<object::ObjectFile> Object;
+    StringMap<uint64_t> SectionLoadAddresses;
+};
+
+class JLDebuginfoPlugin : public orc::ObjectLinkingLayer::Plugin {
+    JITEventListener *Listener;
+    std::mutex PluginMutex;
+    std::map<orc::MaterializationResponsibility *, std::unique_ptr<JITObjectInfo>> PendingObjs;
+
+public:
+    JLDebuginfoPlugin(JITEventListener *Listener) : Listener(Listener) {}
+
+    void notifyMaterializing(orc::MaterializationResponsibility &MR,
+                             jitlink::LinkGraph &G, jitlink::JITLinkContext &Ctx,
+                             MemoryBufferRef InputObject) override
+    {
+        // Keeping a copy of the object file around is wasteful, but it lets
+        // us reuse the existing debuginfo.cpp registration path unchanged.
+        auto NewBuffer =
+            MemoryBuffer::getMemBufferCopy(InputObject.getBuffer(), G.getName());
+        auto NewObj = cantFail(
+            object::ObjectFile::createObjectFile(NewBuffer->getMemBufferRef()));
+        std::lock_guard<std::mutex> lock(PluginMutex);
+        assert(PendingObjs.count(&MR) == 0);
+        PendingObjs[&MR] = std::unique_ptr<JITObjectInfo>(
+            new JITObjectInfo{std::move(NewBuffer), std::move(NewObj), {}});
+    }
+
+    Error notifyEmitted(orc::MaterializationResponsibility &MR) override
+    {
+        std::unique_ptr<JITObjectInfo> Info;
+        {
+            std::lock_guard<std::mutex> lock(PluginMutex);
+            auto It = PendingObjs.find(&MR);
+            if (It == PendingObjs.end())
+                return Error::success();
+            Info = std::move(It->second);
+            PendingObjs.erase(It);
+        }
+        ORCNotifyJITLinkEmitted(Listener, std::move(Info->Object),
+                                std::move(Info->BackingBuffer),
+                                std::move(Info->SectionLoadAddresses));
+        return Error::success();
+    }
+
+    Error notifyFailed(orc::MaterializationResponsibility &MR) override
+    {
+        std::lock_guard<std::mutex> lock(PluginMutex);
+        PendingObjs.erase(&MR);
+        return Error::success();
+    }
+
+    Error notifyRemovingResources(orc::ResourceKey K) override
+    {
+        return Error::success();
+    }
+
+    void notifyTransferringResources(orc::ResourceKey DstKey,
+                                     orc::ResourceKey SrcKey) override
+    {
+    }
+
+    void modifyPassConfig(orc::MaterializationResponsibility &MR,
+                          jitlink::LinkGraph &,
+                          jitlink::PassConfiguration &PassConfig) override
+    {
+        std::lock_guard<std::mutex> lock(PluginMutex);
+        auto It = PendingObjs.find(&MR);
+        if (It == PendingObjs.end())
+            return;
+        JITObjectInfo &Info = *It->second;
+        PassConfig.PostAllocationPasses.push_back(
+            [&Info, this](jitlink::LinkGraph &G) -> Error {
+                std::lock_guard<std::mutex> lock(PluginMutex);
+                for (const jitlink::Section &Sec : G.sections()) {
+#ifdef _OS_DARWIN_
+                    // Canonical JITLink section names include the segment,
+                    // e.g. "__TEXT,__text"; the object file only knows "__text".
+                    auto SecName = Sec.getName().split(',').second;
+                    if (SecName.empty())
+                        SecName = Sec.getName();
+#else
+                    auto SecName = Sec.getName();
+#endif
+                    Info.SectionLoadAddresses[SecName] =
+                        jitlink::SectionRange(Sec).getStart();
+                }
+                return Error::success();
+            });
+    }
+};
+
+}
+
+#else // !JL_USE_JITLINK
+
 // A simple forwarding class, since OrcJIT v2 needs a unique_ptr, while we have a shared_ptr
 class ForwardingMemoryManager : public RuntimeDyld::MemoryManager {
 private:
@@ -473,9 +686,6 @@ public:
 };
 
 
-// Custom object emission notification handler for the JuliaOJIT
-extern JITEventListener *CreateJuliaJITEventListener();
-
 JL_DLLEXPORT void ORCNotifyObjectEmitted(JITEventListener *Listener,
                                          const object::ObjectFile &obj,
                                          const RuntimeDyld::LoadedObjectInfo &L,
@@ -488,6 +698,8 @@ void JuliaOJIT::registerObject(const ObjT &Obj, const LoadResult &LO)
     ORCNotifyObjectEmitted(JuliaListener.get(), *Object, *LO, MemMgr.get());
 }
 
+#endif // !JL_USE_JITLINK
+
 CodeGenOpt::Level CodeGenOptLevelFor(int optlevel)
 {
 #ifdef DISABLE_OPT
@@ -515,6 +727,38 @@ static auto countBasicBlocks(const Function &F)
 
 CompilerResultT JuliaOJIT::CompilerT::operator()(Module &M)
 {
+    return jit.compileModule(M);
+}
+
+std::unique_ptr<JuliaOJIT::PipelineT> JuliaOJIT::acquirePipeline()
+{
+    {
+        std::lock_guard<std::mutex> lock(PipelineMutex);
+        if (!Pipelines.empty()) {
+            std::unique_ptr<PipelineT> P = std::move(Pipelines.back());
+            Pipelines.pop_back();
+            return P;
+        }
+    }
+    return std::make_unique<PipelineT>(TM);
+}
+
+void JuliaOJIT::releasePipeline(std::unique_ptr<PipelineT> P)
+{
+    std::lock_guard<std::mutex> lock(PipelineMutex);
+    Pipelines.push_back(std::move(P));
+}
+
+CompilerResultT JuliaOJIT::compileModule(Module &M)
+{
+    // the opt-dump stream emits one YAML document per module; hold a lock
+    // across the whole compilation so documents from concurrent compilations
+    // do not interleave
+    std::unique_lock<std::mutex> dump_lock;
+    if (dump_llvm_opt_stream != NULL) {
+        static std::mutex dump_mutex;
+        dump_lock = std::unique_lock<std::mutex>(dump_mutex);
+    }
     uint64_t start_time = 0;
     if (dump_llvm_opt_stream != NULL) {
         // Print LLVM function statistics _before_ optimization
@@ -559,17 +803,22 @@ CompilerResultT JuliaOJIT::CompilerT::operator()(Module &M)
         }
         optlevel = std::max(optlevel, optlevel_min);
     }
-    if (optlevel == 0)
-        jit.PM0.run(M);
+    int tier_override = jl_jit_opt_override.load(std::memory_order_relaxed);
+    if (tier_override >= 0)
+        optlevel = tier_override;
+    std::unique_ptr<PipelineT> Pipeline = acquirePipeline();
+    if (optlevel <= 0)
+        Pipeline->PMs[0].run(M);
     else if (optlevel == 1)
-        jit.PM1.run(M);
+        Pipeline->PMs[1].run(M);
     else if (optlevel == 2)
-        jit.PM2.run(M);
-    else if (optlevel >= 3)
-        jit.PM3.run(M);
+        Pipeline->PMs[2].run(M);
+    else
+        Pipeline->PMs[3].run(M);
 
     std::unique_ptr<MemoryBuffer> ObjBuffer(
-        new SmallVectorMemoryBuffer(std::move(jit.ObjBufferSV)));
+        new SmallVectorMemoryBuffer(std::move(Pipeline->ObjBufferSV)));
+    releasePipeline(std::move(Pipeline));
     auto Obj = object::ObjectFile::createObjectFile(ObjBuffer->getMemBufferRef());
 
     if (!Obj) {
@@ -603,11 +852,26 @@ CompilerResultT JuliaOJIT::CompilerT::operator()(Module &M)
     return CompilerResultT(std::move(ObjBuffer));
 }
 
+JuliaOJIT::PipelineT::PipelineT(TargetMachine &TM)
+  : ObjStream(ObjBufferSV)
+{
+    for (int i = 0; i < 4; i++) {
+        TMs[i] = TM.getTarget().createTargetMachine(TM.getTargetTriple().getTriple(), TM.getTargetCPU(),
+                TM.getTargetFeatureString(), TM.Options, Reloc::Static, TM.getCodeModel(),
+                CodeGenOptLevelFor(i), true);
+    }
+    addPassesForOptLevel(PMs[0], *TMs[0], ObjStream, Ctx, 0);
+    addPassesForOptLevel(PMs[1], *TMs[1], ObjStream, Ctx, 1);
+    addPassesForOptLevel(PMs[2], *TMs[2], ObjStream, Ctx, 2);
+    addPassesForOptLevel(PMs[3], *TMs[3], ObjStream, Ctx, 3);
+}
+
 JuliaOJIT::JuliaOJIT(TargetMachine &TM, LLVMContext *LLVMCtx)
   : TM(TM),
     DL(TM.createDataLayout()),
-    ObjStream(ObjBufferSV),
+#ifndef JL_USE_JITLINK
     MemMgr(createRTDyldMemoryManager()),
+#endif
     JuliaListener(CreateJuliaJITEventListener()),
     TSCtx(std::unique_ptr<LLVMContext>(LLVMCtx)),
 #if JL_LLVM_VERSION >= 130000
@@ -617,6 +881,12 @@ JuliaOJIT::JuliaOJIT(TargetMachine &TM, LLVMContext *LLVMCtx)
 #endif
     GlobalJD(ES.createBareJITDylib("JuliaGlobals")),
     JD(ES.createBareJITDylib("JuliaOJIT")),
+#ifdef JL_USE_JITLINK
+    // TODO: Port the cgmemmgr dual-mapping optimization to a custom
+    // JITLinkMemoryManager; the in-process default write-protects after
+    // finalization but has no separate writable mapping.
+    ObjectLayer(ES, cantFail(jitlink::InProcessMemoryManager::Create())),
+#else
     ObjectLayer(
             ES,
             [this]() {
@@ -624,23 +894,32 @@ JuliaOJIT::JuliaOJIT(TargetMachine &TM, LLVMContext *LLVMCtx)
                 return result;
             }
         ),
+#endif
     CompileLayer(ES, ObjectLayer, std::make_unique<CompilerT>(this))
 {
+#ifdef JL_USE_JITLINK
+    ObjectLayer.addPlugin(std::make_unique<JLDebuginfoPlugin>(JuliaListener.get()));
+    ObjectLayer.addPlugin(std::make_unique<orc::EHFrameRegistrationPlugin>(
+        ES, std::make_unique<jitlink::InProcessEHFrameRegistrar>()));
+#else
     ObjectLayer.setNotifyLoaded(
         [this](orc::MaterializationResponsibility &MR,
                const object::ObjectFile &Object,
                const RuntimeDyld::LoadedObjectInfo &LOS) {
             registerObject(Object, &LOS);
         });
-    for (int i = 0; i < 4; i++) {
-        TMs[i] = TM.getTarget().createTargetMachine(TM.getTargetTriple().getTriple(), TM.getTargetCPU(),
-                TM.getTargetFeatureString(), TM.Options, Reloc::Static, TM.getCodeModel(),
-                CodeGenOptLevelFor(i), true);
-    }
-    addPassesForOptLevel(PM0, *TMs[0], ObjStream, Ctx, 0);
-    addPassesForOptLevel(PM1, *TMs[1], ObjStream, Ctx, 1);
-    addPassesForOptLevel(PM2, *TMs[2], ObjStream, Ctx, 2);
-    addPassesForOptLevel(PM3, *TMs[3], ObjStream, Ctx, 3);
+#endif
+    // An optimization + codegen pipeline is created lazily per concurrent
+    // compilation (see acquirePipeline); with the pool disabled only one is
+    // ever built. The pool itself is opt-in: optimization and instruction
+    // selection parallelize across modules, but object linking stays on the
+    // caller's thread because the RTDyld memory manager finalizes all
+    // outstanding allocations at once.
+    int nthreads = 0;
+    if (char *cp = getenv("JULIA_NUM_COMPILE_THREADS"))
+        nthreads = atoi(cp);
+    if (nthreads > 1)
+        CompileThreads = std::make_unique<ThreadPool>(hardware_concurrency(nthreads));
 
     // Make sure SectionMemoryManager::getSymbolAddressInProcess can resolve
     // symbols in the program as well. The nullptr argument to the function
@@ -686,18 +965,11 @@ void JuliaOJIT::addGlobalMapping(StringRef Name, uint64_t Addr)
     cantFail(JD.define(orc::absoluteSymbols({{ES.intern(MangleName), JITEvaluatedSymbol::fromPointer((void*)Addr)}})));
 }
 
-void JuliaOJIT::addModule(std::unique_ptr<Module> M)
+void JuliaOJIT::validateRelocations(Module &M)
 {
-    JL_TIMING(LLVM_MODULE_FINISH);
-    std::vector<std::string> NewExports;
-    for (auto &F : M->global_values()) {
-        if (!F.isDeclaration() && F.getLinkage() == GlobalValue::ExternalLinkage) {
-            NewExports.push_back(getMangledName(F.getName()));
-        }
-    }
 #ifndef JL_NDEBUG
-    // validate the relocations for M
-    for (Module::global_object_iterator I = M->global_objects().begin(), E = M->global_objects().end(); I != E; ) {
+    // validate the relocations for M (also deletes unused declarations)
+    for (Module::global_object_iterator I = M.global_objects().begin(), E = M.global_objects().end(); I != E; ) {
         GlobalObject *F = &*I;
         ++I;
         if (F->isDeclaration()) {
@@ -715,6 +987,18 @@ void JuliaOJIT::addModule(std::unique_ptr<Module> M)
         }
     }
 #endif
+}
+
+void JuliaOJIT::addModule(std::unique_ptr<Module> M)
+{
+    JL_TIMING(LLVM_MODULE_FINISH);
+    std::vector<std::string> NewExports;
+    for (auto &F : M->global_values()) {
+        if (!F.isDeclaration() && F.getLinkage() == GlobalValue::ExternalLinkage) {
+            NewExports.push_back(getMangledName(F.getName()));
+        }
+    }
+    validateRelocations(*M);
     // TODO: what is the performance characteristics of this?
     cantFail(CompileLayer.add(JD, orc::ThreadSafeModule(std::move(M), TSCtx)));
     // force eager compilation (for now), due to memory management specifics
@@ -724,6 +1008,54 @@ void JuliaOJIT::addModule(std::unique_ptr<Module> M)
 
 }
 
+void JuliaOJIT::addModules(std::vector<std::unique_ptr<Module>> Ms)
+{
+    if (CompileThreads == nullptr || Ms.size() < 2) {
+        for (auto &M : Ms)
+            addModule(std::move(M));
+        return;
+    }
+    JL_TIMING(LLVM_MODULE_FINISH);
+    // Optimization and instruction selection dominate first-call latency and
+    // are independent per module, so run them on the compile thread pool.
+    // The modules all live in the shared codegen LLVMContext, which the
+    // passes mutate, so each is first round-tripped through bitcode into a
+    // private context. The resulting objects are then added and linked
+    // serially on this thread: RTDyld links cannot overlap because the
+    // shared memory manager finalizes all outstanding allocations at once.
+    size_t n = Ms.size();
+    std::vector<std::string> NewExports;
+    std::vector<SmallVector<char, 0>> BCs(n);
+    for (size_t i = 0; i < n; i++) {
+        Module &M = *Ms[i];
+        for (auto &F : M.global_values()) {
+            if (!F.isDeclaration() && F.getLinkage() == GlobalValue::ExternalLinkage) {
+                NewExports.push_back(getMangledName(F.getName()));
+            }
+        }
+        validateRelocations(M);
+        raw_svector_ostream OS(BCs[i]);
+        WriteBitcodeToFile(M, OS);
+    }
+    std::vector<std::unique_ptr<MemoryBuffer>> Objs(n);
+    for (size_t i = 0; i < n; i++) {
+        CompileThreads->async([this, &BCs, &Objs, i]() {
+            LLVMContext Ctx;
+            std::unique_ptr<Module> M = cantFail(parseBitcodeFile(
+                    MemoryBufferRef(StringRef(BCs[i].data(), BCs[i].size()), "jl_jit_module"),
+                    Ctx), "failed to round-trip module through bitcode");
+            Objs[i] = cantFail(compileModule(*M), "failed to compile LLVM module");
+        });
+    }
+    CompileThreads->wait();
+    Ms.clear();
+    for (size_t i = 0; i < n; i++)
+        cantFail(ObjectLayer.add(JD, std::move(Objs[i])));
+    // force eager linking, as in addModule
+    for (auto Name : NewExports)
+        cantFail(ES.lookup({&JD}, Name));
+}
+
 JL_JITSymbol JuliaOJIT::findSymbol(StringRef Name, bool ExportedSymbolsOnly)
 {
     orc::JITDylib* SearchOrders[2] = {&GlobalJD, &JD};
@@ -791,9 +1123,13 @@ StringRef JuliaOJIT::getFunctionAtAddress(uint64_t Addr, jl_code_instance_t *cod
 
 void JuliaOJIT::RegisterJITEventListener(JITEventListener *L)
 {
+#ifndef JL_USE_JITLINK
+    // externally attached listeners (perf, vtune, oprofile) are only
+    // supported through the RTDyld object layer
     if (!L)
         return;
     this->ObjectLayer.registerJITEventListener(*L);
+#endif
 }
 
 const DataLayout& JuliaOJIT::getDataLayout() const
@@ -818,6 +1154,22 @@ std::string JuliaOJIT::getMangledName(const GlobalValue *GV)
     return getMangledName(GV->getName());
 }
 
+#ifdef JL_USE_JITLINK
+
+size_t JuliaOJIT::getTotalBytes() const
+{
+    // TODO: track allocations through a custom JITLinkMemoryManager
+    return 0;
+}
+
+void JuliaOJIT::getCodeStats(size_t *bytes_used, size_t *bytes_reserved) const
+{
+    *bytes_used = 0;
+    *bytes_reserved = 0;
+}
+
+#else
+
 size_t getRTDyldMemoryManagerTotalBytes(RTDyldMemoryManager *mm);
 
 size_t JuliaOJIT::getTotalBytes() const
@@ -825,6 +1177,16 @@ size_t JuliaOJIT::getTotalBytes() const
     return getRTDyldMemoryManagerTotalBytes(MemMgr.get());
 }
 
+void getRTDyldMemoryManagerCodeStats(RTDyldMemoryManager *mm, size_t *bytes_used,
+                                     size_t *bytes_reserved);
+
+void JuliaOJIT::getCodeStats(size_t *bytes_used, size_t *bytes_reserved) const
+{
+    getRTDyldMemoryManagerCodeStats(MemMgr.get(), bytes_used, bytes_reserved);
+}
+
+#endif
+
 JuliaOJIT *jl_ExecutionEngine;
 
 // destructively move the contents of src into dest
@@ -960,7 +1322,7 @@ void jl_jit_share_data(Module &M)
         GV->eraseFromParent();
 }
 
-static void jl_add_to_ee(std::unique_ptr<Module> m)
+static void jl_add_to_ee(std::unique_ptr<Module> m, std::vector<std::unique_ptr<Module>> *pending)
 {
 #if defined(_CPU_X86_64_) && defined(_OS_WINDOWS_)
     // Add special values used by debuginfo to build the UnwindData table registration for Win64
@@ -979,7 +1341,10 @@ static void jl_add_to_ee(std::unique_ptr<Module> m)
 #endif
     jl_jit_share_data(*m);
     assert(jl_ExecutionEngine);
-    jl_ExecutionEngine->addModule(std::move(m));
+    if (pending)
+        pending->push_back(std::move(m));
+    else
+        jl_ExecutionEngine->addModule(std::move(m));
 }
 
 static int jl_add_to_ee(
@@ -987,6 +1352,7 @@ static int jl_add_to_ee(
         StringMap<std::unique_ptr<Module>*> &NewExports,
         DenseMap<Module*, int> &Queued,
         std::vector<std::vector<std::unique_ptr<Module>*>> &ToMerge,
+        std::vector<std::unique_ptr<Module>> &Pending,
         int depth)
 {
     // DAG-sort (post-dominator) the compile to compute the minimum
@@ -1008,7 +1374,7 @@ static int jl_add_to_ee(
             auto Callee = NewExports.find(F.getName());
             if (Callee != NewExports.end()) {
                 auto &CM = Callee->second;
-                int Down = jl_add_to_ee(*CM, NewExports, Queued, ToMerge, depth + 1);
+                int Down = jl_add_to_ee(*CM, NewExports, Queued, ToMerge, Pending, depth + 1);
                 assert(Down <= depth);
                 if (Down && Down < MergeUp)
                     MergeUp = Down;
@@ -1023,7 +1389,7 @@ static int jl_add_to_ee(
             Queued.erase(CM->get());
             jl_merge_module(M.get(), std::move(*CM));
         }
-        jl_add_to_ee(std::move(M));
+        jl_add_to_ee(std::move(M), &Pending);
         MergeUp = 0;
     }
     else {
@@ -1045,8 +1411,13 @@ static void jl_add_to_ee(std::unique_ptr<Module> &M, StringMap<std::unique_ptr<M
 {
     DenseMap<Module*, int> Queued;
     std::vector<std::vector<std::unique_ptr<Module>*>> ToMerge;
-    jl_add_to_ee(M, NewExports, Queued, ToMerge, 1);
+    // the DAG sort pushes dependencies before their dependents, so handing
+    // the batch over in order preserves the old one-at-a-time semantics when
+    // the compile thread pool is disabled
+    std::vector<std::unique_ptr<Module>> Pending;
+    jl_add_to_ee(M, NewExports, Queued, ToMerge, Pending, 1);
     assert(!M);
+    jl_ExecutionEngine->addModules(std::move(Pending));
 }
 
 
@@ -1068,3 +1439,9 @@ size_t jl_jit_total_bytes_impl(void)
 {
     return jl_ExecutionEngine->getTotalBytes();
 }
+
+extern "C" JL_DLLEXPORT
+void jl_jit_code_stats_impl(size_t *bytes_used, size_t *bytes_reserved)
+{
+    jl_ExecutionEngine->getCodeStats(bytes_used, bytes_reserved);
+}
@@ -1,5 +1,8 @@
 // This file is a part of Julia. License is MIT: https://julialang.org/license
 
+#include "llvm-version.h"
+#include "platform.h"
+
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Module.h>
@@ -11,9 +14,27 @@
 #include <llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h>
 #include <llvm/ExecutionEngine/JITEventListener.h>
 
+// Link objects through ORC JITLink where it is mature enough: it links each
+// object graph independently instead of serializing every link through one
+// shared RTDyld memory manager, which is what per-object concurrent linking
+// needs. RTDyld stays the default elsewhere, and keeps the dual-mapping
+// support from cgmemmgr.cpp (not yet ported to a custom JITLinkMemoryManager).
+#if defined(JL_FORCE_JITLINK) || \
+    (JL_LLVM_VERSION >= 140000 && defined(_OS_DARWIN_) && defined(_CPU_AARCH64_))
+#define JL_USE_JITLINK
+#endif
+
+#ifdef JL_USE_JITLINK
+#include <llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h>
+#endif
+
+#include <llvm/Support/ThreadPool.h>
 #include <llvm/Target/TargetMachine.h>
 #include "julia_assert.h"
 
+#include <memory>
+#include <mutex>
+
 using namespace llvm;
 
 extern "C" jl_cgparams_t jl_default_cgparams;
@@ -154,12 +175,18 @@ class JuliaOJIT {
     private:
         JuliaOJIT &jit;
     };
+#ifndef JL_USE_JITLINK
     // Custom object emission notification handler for the JuliaOJIT
     template <typename ObjT, typename LoadResult>
     void registerObject(const ObjT &Obj, const LoadResult &LO);
+#endif
 
 public:
+#ifdef JL_USE_JITLINK
+    typedef orc::ObjectLinkingLayer ObjLayerT;
+#else
     typedef orc::RTDyldObjectLinkingLayer ObjLayerT;
+#endif
     typedef orc::IRCompileLayer CompileLayerT;
     typedef object::OwningBinary<object::ObjectFile> OwningObj;
 
@@ -168,6 +195,10 @@ public:
     void RegisterJITEventListener(JITEventListener *L);
     void addGlobalMapping(StringRef Name, uint64_t Addr);
     void addModule(std::unique_ptr<Module> M);
+    // Add a batch of mutually-dependent modules. When the compile thread
+    // pool is enabled (JULIA_NUM_COMPILE_THREADS), the modules are optimized
+    // and codegen'd concurrently before being linked serially.
+    void addModules(std::vector<std::unique_ptr<Module>> Ms);
 
     JL_JITSymbol findSymbol(StringRef Name, bool ExportedSymbolsOnly);
     JL_JITSymbol findUnmangledSymbol(StringRef Name);
@@ -177,23 +208,38 @@ public:
     const DataLayout& getDataLayout() const;
     const Triple& getTargetTriple() const;
     size_t getTotalBytes() const;
+    void getCodeStats(size_t *bytes_used, size_t *bytes_reserved) const;
 private:
+    // A complete optimization + MC-emission pipeline. Instances are handed
+    // out by acquirePipeline and may be used by only one thread at a time;
+    // each owns its TargetMachines because codegen through a TargetMachine
+    // is not thread-safe.
+    struct PipelineT {
+        PipelineT(TargetMachine &TM);
+        // Should be big enough that in the common case, The
+        // object fits in its entirety
+        SmallVector<char, 4096> ObjBufferSV;
+        raw_svector_ostream ObjStream;
+        legacy::PassManager PMs[4];  // per-optlevel pass managers
+        TargetMachine *TMs[4];
+        MCContext *Ctx;
+    };
+    std::unique_ptr<PipelineT> acquirePipeline();
+    void releasePipeline(std::unique_ptr<PipelineT> P);
+    CompilerResultT compileModule(Module &M);
+    void validateRelocations(Module &M);
+
     std::string getMangledName(StringRef Name);
     std::string getMangledName(const GlobalValue *GV);
 
     TargetMachine &TM;
     const DataLayout DL;
-    // Should be big enough that in the common case, The
-    // object fits in its entirety
-    SmallVector<char, 4096> ObjBufferSV;
-    raw_svector_ostream ObjStream;
-    legacy::PassManager PM0;  // per-optlevel pass managers
-    legacy::PassManager PM1;
-    legacy::PassManager PM2;
-    legacy::PassManager PM3;
-    TargetMachine *TMs[4];
-    MCContext *Ctx;
+    std::mutex PipelineMutex;
+    SmallVector<std::unique_ptr<PipelineT>, 4> Pipelines; // idle pipelines
+    std::unique_ptr<ThreadPool> CompileThreads;
+#ifndef JL_USE_JITLINK
     std::shared_ptr<RTDyldMemoryManager> MemMgr;
+#endif
     std::unique_ptr<JITEventListener> JuliaListener;
 
 
@@ -17,6 +17,22 @@
 #include <sys/socket.h>
 #endif
 
+#ifdef _OS_LINUX_
+#include <sys/syscall.h>
+#endif
+
+#if defined(_OS_LINUX_) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define JL_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <linux/stat.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
+#endif
+
 #include "julia.h"
 #include "julia_internal.h"
 #include "support/ios.h"
@@ -46,9 +62,196 @@ void jl_wake_libuv(void)
 
 jl_mutex_t jl_uv_mutex;
 
+JL_DLLEXPORT void jl_uv_writecb(uv_write_t *req, int status);
+
+// Write-behind buffers for runtime printing to libuv streams. jl_uv_puts
+// (and through it jl_printf, jl_uv_putb, ...) emits many tiny fragments, each
+// of which used to cost a malloc, the uv lock and a uv_write; fragments up to
+// PUTBUF_MAX_COALESCE bytes are instead appended to a per-stream buffer here.
+// The buffer drains when it fills, before any direct write to the same stream
+// (including every jl_uv_write from Base, which keeps output ordered), when
+// the stream closes, and from a prepare handle on each loop iteration so
+// nothing sits unflushed while the loop blocks for I/O. All access is under
+// jl_uv_mutex, matching every other use of the uv structures.
+#define N_PUTBUF 4
+#define PUTBUF_SIZE 8192
+#define PUTBUF_MAX_COALESCE 512
+typedef struct {
+    uv_stream_t *stream; // NULL when the slot is free
+    size_t len;
+    char buf[PUTBUF_SIZE];
+} jl_putbuf_t;
+static jl_putbuf_t *put_buffers[N_PUTBUF];
+static uv_prepare_t put_buffers_prepare;
+
+static jl_putbuf_t *jl_putbuf_get(uv_stream_t *stream, int create)
+{
+    int free_slot = -1;
+    for (int i = 0; i < N_PUTBUF; i++) {
+        jl_putbuf_t *pb = put_buffers[i];
+        if (pb == NULL || pb->stream == NULL) {
+            if (free_slot == -1)
+                free_slot = i;
+        }
+        else if (pb->stream == stream) {
+            return pb;
+        }
+    }
+    if (!create || free_slot == -1)
+        return NULL;
+    jl_putbuf_t *pb = put_buffers[free_slot];
+    if (pb == NULL)
+        put_buffers[free_slot] = pb = (jl_putbuf_t*)malloc_s(sizeof(jl_putbuf_t));
+    pb->stream = stream;
+    pb->len = 0;
+    return pb;
+}
+
+// caller must hold jl_uv_mutex
+static void jl_putbuf_flush(jl_putbuf_t *pb)
+{
+    if (pb->len == 0)
+        return;
+    uv_write_t *req = (uv_write_t*)malloc_s(sizeof(uv_write_t) + pb->len);
+    char *data = (char*)(req + 1);
+    memcpy(data, pb->buf, pb->len);
+    uv_buf_t buf[1];
+    buf[0].base = data;
+    buf[0].len = pb->len;
+    req->data = NULL;
+    pb->len = 0;
+    int status = uv_write(req, pb->stream, buf, 1, (uv_write_cb)jl_uv_writecb);
+    if (status < 0)
+        jl_uv_writecb(req, status);
+}
+
+static void jl_putbuf_prepare_cb(uv_prepare_t *hdl)
+{
+    // the loop only runs with jl_uv_mutex held (it is recursive), so the
+    // buffers may be touched here directly
+    (void)hdl;
+    for (int i = 0; i < N_PUTBUF; i++) {
+        jl_putbuf_t *pb = put_buffers[i];
+        if (pb != NULL && pb->stream != NULL)
+            jl_putbuf_flush(pb);
+    }
+}
+
+// hashed timer wheel //
+//
+// libuv keeps every timer in one binary heap, so workloads with very many
+// outstanding coarse timeouts (one idle-deadline per connection) pay
+// O(log n) heap maintenance on each arm and disarm even though almost all
+// of them are cancelled long before they fire. The wheel hashes deadlines
+// into slots of `timer_wheel_granularity_ms` (tunable via
+// $JULIA_TIMER_WHEEL_MS, default 16); add and cancel are O(1) list splices
+// and the loop carries a single uv_timer ticking at the granularity while
+// any entry is pending. Deadlines fire up to one granularity late, which
+// is the contract for using the wheel instead of uv_timer. All calls must
+// hold jl_uv_mutex, matching every other use of the uv structures; a
+// handle is invalidated when its callback runs or it is cancelled.
+
+typedef struct jl_wheel_timer_tag {
+    uint64_t deadline_ms; // loop time (uv_now) when due
+    void (*cb)(void*);
+    void *data;
+    struct jl_wheel_timer_tag *next;
+    struct jl_wheel_timer_tag **prev; // link pointing at us, for O(1) unlink
+} jl_wheel_timer_t;
+
+#define TIMER_WHEEL_NSLOTS 512 // power of two
+static jl_wheel_timer_t *timer_wheel[TIMER_WHEEL_NSLOTS];
+static uint64_t timer_wheel_granularity_ms = 16;
+static size_t timer_wheel_count = 0;
+static uint64_t timer_wheel_last_ms;
+static uv_timer_t timer_wheel_timer;
+
+static void jl_timer_wheel_advance(uint64_t now_ms)
+{
+    uint64_t tick = timer_wheel_last_ms / timer_wheel_granularity_ms;
+    uint64_t now_tick = now_ms / timer_wheel_granularity_ms;
+    // after a long block, one revolution covers every slot
+    if (now_tick - tick > TIMER_WHEEL_NSLOTS)
+        tick = now_tick - TIMER_WHEEL_NSLOTS;
+    for (; tick <= now_tick && timer_wheel_count > 0; tick++) {
+        jl_wheel_timer_t **pt = &timer_wheel[tick & (TIMER_WHEEL_NSLOTS - 1)];
+        while (*pt) {
+            jl_wheel_timer_t *t = *pt;
+            if (t->deadline_ms <= now_ms) {
+                *pt = t->next;
+                if (t->next)
+                    t->next->prev = pt;
+                timer_wheel_count--;
+                void (*cb)(void*) = t->cb;
+                void *data = t->data;
+                free(t);
+                cb(data);
+            }
+            else {
+                // same slot, a later revolution; leave it in place
+                pt = &t->next;
+            }
+        }
+    }
+    timer_wheel_last_ms = now_ms;
+}
+
+static void jl_timer_wheel_tick_cb(uv_timer_t *hdl)
+{
+    (void)hdl;
+    jl_timer_wheel_advance(uv_now(jl_io_loop));
+    if (timer_wheel_count == 0)
+        uv_timer_stop(&timer_wheel_timer);
+}
+
+JL_DLLEXPORT void *jl_timer_wheel_add(uint64_t timeout_ms, void (*cb)(void*), void *data)
+{
+    jl_wheel_timer_t *t = (jl_wheel_timer_t*)malloc_s(sizeof(jl_wheel_timer_t));
+    uint64_t now_ms = uv_now(jl_io_loop);
+    t->deadline_ms = now_ms + timeout_ms;
+    t->cb = cb;
+    t->data = data;
+    jl_wheel_timer_t **slot =
+        &timer_wheel[(t->deadline_ms / timer_wheel_granularity_ms) &
+                     (TIMER_WHEEL_NSLOTS - 1)];
+    t->next = *slot;
+    if (t->next)
+        t->next->prev = &t->next;
+    t->prev = slot;
+    *slot = t;
+    if (timer_wheel_count++ == 0) {
+        timer_wheel_last_ms = now_ms;
+        uv_timer_start(&timer_wheel_timer, jl_timer_wheel_tick_cb,
+                       timer_wheel_granularity_ms, timer_wheel_granularity_ms);
+    }
+    return t;
+}
+
+JL_DLLEXPORT void jl_timer_wheel_cancel(void *handle)
+{
+    jl_wheel_timer_t *t = (jl_wheel_timer_t*)handle;
+    *t->prev = t->next;
+    if (t->next)
+        t->next->prev = t->prev;
+    free(t);
+    if (--timer_wheel_count == 0)
+        uv_timer_stop(&timer_wheel_timer);
+}
+
 void jl_init_uv(void)
 {
     uv_async_init(jl_io_loop, &signal_async, jl_signal_async_cb);
+    uv_prepare_init(jl_io_loop, &put_buffers_prepare);
+    uv_prepare_start(&put_buffers_prepare, jl_putbuf_prepare_cb);
+    // the drain handle must not keep the loop alive by itself
+    uv_unref((uv_handle_t*)&put_buffers_prepare);
+    uv_timer_init(jl_io_loop, &timer_wheel_timer);
+    char *cp = getenv("JULIA_TIMER_WHEEL_MS");
+    if (cp) {
+        uint64_t ms = (uint64_t)atoll(cp);
+        if (ms > 0)
+            timer_wheel_granularity_ms = ms;
+    }
     JL_MUTEX_INIT(&jl_uv_mutex); // a file-scope initializer can be used instead
 }
 
@@ -198,6 +401,18 @@ JL_DLLEXPORT void *jl_uv_write_handle(uv_write_t *req) { return req->handle; }
 
 extern _Atomic(unsigned) _threadedregion;
 
+// Pacing for the scheduler's idle passes: spinning threads call
+// jl_process_events on every loop iteration, and an empty UV_RUN_NOWAIT
+// sweep still walks the whole backend under jl_uv_mutex. A sweep that
+// returns almost instantly ran no callbacks, so consecutive empty sweeps
+// widen the gap between passes (doubling from 20us up to 1ms, well under
+// the timer wheel granularity); any sweep that does real work resets the
+// gap to zero. Both fields are only touched while holding jl_uv_mutex.
+#define PROCESS_EVENTS_EMPTY_NS    5000     // below this, the sweep did nothing
+#define PROCESS_EVENTS_MAX_GAP_NS  1000000  // 1 ms
+static uint64_t process_events_next_ns;
+static uint64_t process_events_gap_ns;
+
 JL_DLLEXPORT int jl_process_events(void)
 {
     jl_task_t *ct = jl_current_task;
@@ -205,8 +420,22 @@ JL_DLLEXPORT int jl_process_events(void)
     jl_gc_safepoint_(ct->ptls);
     if (loop && (jl_atomic_load_relaxed(&_threadedregion) || jl_atomic_load_relaxed(&ct->tid) == 0)) {
         if (jl_atomic_load(&jl_uv_n_waiters) == 0 && jl_mutex_trylock(&jl_uv_mutex)) {
+            uint64_t t0 = jl_hrtime();
+            if (t0 < process_events_next_ns) {
+                JL_UV_UNLOCK();
+                return 0;
+            }
             loop->stop_flag = 0;
             int r = uv_run(loop, UV_RUN_NOWAIT);
+            if (jl_hrtime() - t0 < PROCESS_EVENTS_EMPTY_NS) {
+                process_events_gap_ns = process_events_gap_ns == 0 ? 20000 :
+                    (process_events_gap_ns < PROCESS_EVENTS_MAX_GAP_NS ?
+                     process_events_gap_ns * 2 : PROCESS_EVENTS_MAX_GAP_NS);
+            }
+            else {
+                process_events_gap_ns = 0;
+            }
+            process_events_next_ns = t0 + process_events_gap_ns;
             JL_UV_UNLOCK();
             return r;
         }
@@ -243,6 +472,11 @@ JL_DLLEXPORT void jl_close_uv(uv_handle_t *handle)
     }
 
     if (handle->type == UV_NAMED_PIPE || handle->type == UV_TCP || handle->type == UV_TTY) {
+        jl_putbuf_t *pb = jl_putbuf_get((uv_stream_t*)handle, 0);
+        if (pb != NULL) {
+            jl_putbuf_flush(pb);
+            pb->stream = NULL; // release the slot
+        }
         uv_write_t *req = (uv_write_t*)malloc_s(sizeof(uv_write_t));
         req->handle = (uv_stream_t*)handle;
         jl_uv_flush_close_callback(req, 0);
@@ -262,6 +496,10 @@ JL_DLLEXPORT void jl_forceclose_uv(uv_handle_t *handle)
     // avoid double-closing the stream
     if (!uv_is_closing(handle)) {
         JL_UV_LOCK();
+        // discard (not flush) any pending prints: the handle is going away now
+        jl_putbuf_t *pb = jl_putbuf_get((uv_stream_t*)handle, 0);
+        if (pb != NULL)
+            pb->stream = NULL;
         if (!uv_is_closing(handle)) {
             uv_close(handle, &jl_uv_closeHandle);
         }
@@ -332,6 +570,251 @@ JL_DLLEXPORT uv_loop_t *jl_global_event_loop(void)
     return jl_io_loop;
 }
 
+#ifdef JL_HAVE_IO_URING
+// Opt-in io_uring backend for the jl_fs_read/jl_fs_write wrappers below
+// (set JULIA_IO_URING=1; see options.h). The wrappers are synchronous --
+// they pass a NULL callback, so uv_fs_* runs the syscall inline rather than
+// on the threadpool -- which means the gain here is not asynchrony but
+// syscall cost: with IORING_SETUP_SQPOLL the kernel polls the submission
+// queue from its own thread and a small cached read completes while we spin
+// on the completion queue, without entering the kernel at all. When SQPOLL
+// is unavailable a single io_uring_enter both submits and waits, which costs
+// the same one syscall as the plain read/write it replaces.
+
+typedef struct {
+    int ring_fd;
+    int sqpoll;
+    unsigned sq_mask;
+    unsigned cq_mask;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_flags;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    uv_mutex_t lock;
+} jl_fs_ring_t;
+
+static jl_fs_ring_t fs_ring;
+static int fs_ring_state = 0; // 0 uninitialized, 1 ready, -1 unavailable
+static uv_once_t fs_ring_once = UV_ONCE_INIT;
+
+static void fs_ring_init(void)
+{
+    fs_ring_state = -1;
+    char *env = getenv(IO_URING_NAME);
+    if (env == NULL || atoi(env) == 0)
+        return;
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    p.flags = IORING_SETUP_SQPOLL;
+    p.sq_thread_idle = 50; // msec before the kernel-side poller sleeps
+    int fd = (int)syscall(SYS_io_uring_setup, 32, &p);
+    if (fd == -1) {
+        // SQPOLL needs CAP_SYS_NICE before linux 5.13
+        memset(&p, 0, sizeof(p));
+        fd = (int)syscall(SYS_io_uring_setup, 32, &p);
+    }
+    if (fd == -1)
+        return;
+    // IORING_OP_READ/WRITE and offset -1 (current position) arrived together
+    // in 5.6, so this one feature bit covers everything we use
+    if (!(p.features & IORING_FEAT_RW_CUR_POS)) {
+        close(fd);
+        return;
+    }
+    size_t sq_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    size_t cq_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if ((p.features & IORING_FEAT_SINGLE_MMAP) && cq_sz > sq_sz)
+        sq_sz = cq_sz;
+    char *sq = (char*)mmap(NULL, sq_sz, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    char *cq = sq;
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP) && sq != MAP_FAILED)
+        cq = (char*)mmap(NULL, cq_sz, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    struct io_uring_sqe *sqes = (struct io_uring_sqe*)
+        mmap(NULL, p.sq_entries * sizeof(struct io_uring_sqe),
+             PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+             IORING_OFF_SQES);
+    if (sq == MAP_FAILED || cq == MAP_FAILED || sqes == MAP_FAILED) {
+        close(fd);
+        return;
+    }
+    fs_ring.ring_fd = fd;
+    fs_ring.sqpoll = (p.flags & IORING_SETUP_SQPOLL) != 0;
+    fs_ring.sq_head = (unsigned*)(sq + p.sq_off.head);
+    fs_ring.sq_tail = (unsigned*)(sq + p.sq_off.tail);
+    fs_ring.sq_mask = *(unsigned*)(sq + p.sq_off.ring_mask);
+    fs_ring.sq_flags = (unsigned*)(sq + p.sq_off.flags);
+    fs_ring.sq_array = (unsigned*)(sq + p.sq_off.array);
+    fs_ring.cq_head = (unsigned*)(cq + p.cq_off.head);
+    fs_ring.cq_tail = (unsigned*)(cq + p.cq_off.tail);
+    fs_ring.cq_mask = *(unsigned*)(cq + p.cq_off.ring_mask);
+    fs_ring.sqes = sqes;
+    fs_ring.cqes = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+    uv_mutex_init(&fs_ring.lock);
+    fs_ring_state = 1;
+}
+
+// submit one read or write and wait for its completion; returns 1 with the
+// result (a count, or a negative errno exactly as libuv reports it) in *res,
+// or 0 if the ring is unavailable and the caller should use the uv_fs path
+static int fs_ring_rw(uint8_t opcode, uv_os_fd_t fd, char *data, size_t len,
+                      int64_t offset, ssize_t *res)
+{
+    uv_once(&fs_ring_once, fs_ring_init);
+    if (fs_ring_state != 1)
+        return 0;
+    jl_fs_ring_t *r = &fs_ring;
+    uv_mutex_lock(&r->lock);
+    // the lock serializes submissions, so at most one entry is ever in flight
+    // and the queues cannot fill
+again:;
+    unsigned tail = *r->sq_tail;
+    unsigned idx = tail & r->sq_mask;
+    struct io_uring_sqe *sqe = &r->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = (uintptr_t)data;
+    sqe->len = (unsigned)len;
+    sqe->off = (uint64_t)offset; // -1 means the fd's current position
+    r->sq_array[idx] = idx;
+    __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    if (r->sqpoll) {
+        if (__atomic_load_n(r->sq_flags, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP)
+            syscall(SYS_io_uring_enter, r->ring_fd, 0, 0,
+                    IORING_ENTER_SQ_WAKEUP, NULL, 0);
+        // small cached operations complete within the spin, syscall-free
+        for (int spin = 0; spin < 4096; spin++) {
+            if (__atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE) != *r->cq_head)
+                goto reap;
+            jl_cpu_pause();
+        }
+    }
+    while (__atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE) == *r->cq_head) {
+        long ret = syscall(SYS_io_uring_enter, r->ring_fd, r->sqpoll ? 0 : 1, 1,
+                           IORING_ENTER_GETEVENTS, NULL, 0);
+        if (ret == -1 && errno != EINTR) {
+            uv_mutex_unlock(&r->lock);
+            *res = -errno;
+            return 1;
+        }
+    }
+reap:;
+    unsigned head = *r->cq_head;
+    ssize_t cres = r->cqes[head & r->cq_mask].res;
+    __atomic_store_n(r->cq_head, head + 1, __ATOMIC_RELEASE);
+    if (cres == -EINTR)
+        goto again; // libuv also retries interrupted reads and writes
+    uv_mutex_unlock(&r->lock);
+    *res = cres;
+    return 1;
+}
+
+static void statx_to_uv_stat(const struct statx *sx, uv_stat_t *dst)
+{
+    memset(dst, 0, sizeof(*dst));
+    dst->st_dev = makedev(sx->stx_dev_major, sx->stx_dev_minor);
+    dst->st_mode = sx->stx_mode;
+    dst->st_nlink = sx->stx_nlink;
+    dst->st_uid = sx->stx_uid;
+    dst->st_gid = sx->stx_gid;
+    dst->st_rdev = makedev(sx->stx_rdev_major, sx->stx_rdev_minor);
+    dst->st_ino = sx->stx_ino;
+    dst->st_size = sx->stx_size;
+    dst->st_blksize = sx->stx_blksize;
+    dst->st_blocks = sx->stx_blocks;
+    dst->st_atim.tv_sec = sx->stx_atime.tv_sec;
+    dst->st_atim.tv_nsec = sx->stx_atime.tv_nsec;
+    dst->st_mtim.tv_sec = sx->stx_mtime.tv_sec;
+    dst->st_mtim.tv_nsec = sx->stx_mtime.tv_nsec;
+    dst->st_ctim.tv_sec = sx->stx_ctime.tv_sec;
+    dst->st_ctim.tv_nsec = sx->stx_ctime.tv_nsec;
+    dst->st_birthtim.tv_sec = sx->stx_btime.tv_sec;
+    dst->st_birthtim.tv_nsec = sx->stx_btime.tv_nsec;
+}
+
+// stat a batch of paths with the ring so the kernel can work on them
+// concurrently (IORING_OP_STATX is available whenever init succeeded; see the
+// feature gate there); returns 1 with rets[i] set to 0 or a negative errno
+// (bufs[i] valid when 0), or 0 when the ring is unavailable and the caller
+// should stat sequentially
+int jl_stat_many_uring(int n, const char **paths, uv_stat_t *bufs, int32_t *rets)
+{
+    uv_once(&fs_ring_once, fs_ring_init);
+    if (fs_ring_state != 1)
+        return 0;
+    jl_fs_ring_t *r = &fs_ring;
+    struct statx *sxs = (struct statx*)malloc_s(n * sizeof(struct statx));
+    uv_mutex_lock(&r->lock);
+    int done = 0;
+    while (done < n) {
+        int batch = n - done;
+        if ((unsigned)batch > r->sq_mask + 1)
+            batch = (int)(r->sq_mask + 1);
+        unsigned tail = *r->sq_tail;
+        for (int i = 0; i < batch; i++) {
+            unsigned idx = (tail + i) & r->sq_mask;
+            struct io_uring_sqe *sqe = &r->sqes[idx];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_STATX;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (uintptr_t)paths[done + i];
+            sqe->len = STATX_BASIC_STATS | STATX_BTIME;
+            sqe->off = (uintptr_t)&sxs[done + i];
+            sqe->user_data = (uint64_t)(done + i); // completions may reorder
+            r->sq_array[idx] = idx;
+        }
+        __atomic_store_n(r->sq_tail, tail + batch, __ATOMIC_RELEASE);
+        unsigned to_submit = r->sqpoll ? 0 : (unsigned)batch;
+        if (r->sqpoll &&
+            (__atomic_load_n(r->sq_flags, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP))
+            syscall(SYS_io_uring_enter, r->ring_fd, 0, 0,
+                    IORING_ENTER_SQ_WAKEUP, NULL, 0);
+        int reaped = 0;
+        while (reaped < batch) {
+            while (__atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE) == *r->cq_head) {
+                long ret = syscall(SYS_io_uring_enter, r->ring_fd, to_submit,
+                                   (unsigned)(batch - reaped),
+                                   IORING_ENTER_GETEVENTS, NULL, 0);
+                if (ret >= 0)
+                    to_submit = 0;
+                else if (errno != EINTR) {
+                    // should not happen; report the batch as failed
+                    for (int i = done; i < n; i++)
+                        rets[i] = -errno;
+                    n = done;
+                    goto out;
+                }
+            }
+            unsigned head = *r->cq_head;
+            const struct io_uring_cqe *cqe = &r->cqes[head & r->cq_mask];
+            rets[cqe->user_data] = cqe->res;
+            __atomic_store_n(r->cq_head, head + 1, __ATOMIC_RELEASE);
+            reaped++;
+        }
+        done += batch;
+    }
+out:
+    uv_mutex_unlock(&r->lock);
+    for (int i = 0; i < n; i++)
+        if (rets[i] == 0)
+            statx_to_uv_stat(&sxs[i], &bufs[i]);
+    free(sxs);
+    return 1;
+}
+#else
+int jl_stat_many_uring(int n, const char **paths, uv_stat_t *bufs, int32_t *rets)
+{
+    (void)n; (void)paths; (void)bufs; (void)rets;
+    return 0;
+}
+#endif
+
 JL_DLLEXPORT int jl_fs_unlink(char *path)
 {
     uv_fs_t req;
@@ -357,6 +840,31 @@ JL_DLLEXPORT int jl_fs_sendfile(uv_os_fd_t src_fd, uv_os_fd_t dst_fd,
 {
     uv_fs_t req;
     JL_SIGATOMIC_BEGIN();
+#if defined(_OS_LINUX_) && defined(SYS_copy_file_range)
+    // file-to-file transfers can stay entirely in the kernel, and on
+    // reflink-capable or network filesystems never touch the data at all;
+    // socket destinations reject this and take the sendfile path below,
+    // which already moves the data without a round-trip through userspace
+    static int have_cfr = 1;
+    if (have_cfr) {
+        int64_t off_in = in_offset;
+        ssize_t cfr = syscall(SYS_copy_file_range, src_fd, &off_in,
+                              dst_fd, NULL, len, 0);
+        if (cfr >= 0) {
+            JL_SIGATOMIC_END();
+            return (int)cfr;
+        }
+        if (errno == ENOSYS)
+            have_cfr = 0;
+        else if (errno != EINVAL && errno != EXDEV && errno != EBADF &&
+                 errno != ETXTBSY && errno != EOPNOTSUPP) {
+            JL_SIGATOMIC_END();
+            return -errno;
+        }
+        // otherwise the descriptor pair (or a cross-filesystem copy on an
+        // older kernel) is not eligible: fall through
+    }
+#endif
     int ret = uv_fs_sendfile(unused_uv_loop_arg, &req, dst_fd, src_fd,
                              in_offset, len, NULL);
     uv_fs_req_cleanup(&req);
@@ -407,6 +915,9 @@ JL_DLLEXPORT int jl_fs_access(char *path, int mode)
 JL_DLLEXPORT int jl_fs_write(uv_os_fd_t handle, const char *data, size_t len,
                              int64_t offset) JL_NOTSAFEPOINT
 {
+    // the kernel reports EFAULT for still-protected sysimage pages instead
+    // of faulting them in
+    jl_sysimg_prefault(data, len);
     jl_task_t *ct = jl_get_current_task();
     // TODO: fix this cheating
     if (jl_get_safe_restore() || ct == NULL || jl_atomic_load_relaxed(&ct->tid) != 0)
@@ -414,6 +925,11 @@ JL_DLLEXPORT int jl_fs_write(uv_os_fd_t handle, const char *data, size_t len,
         return WriteFile(handle, data, len, NULL, NULL);
 #else
         return write(handle, data, len);
+#endif
+#ifdef JL_HAVE_IO_URING
+    ssize_t uring_res;
+    if (fs_ring_rw(IORING_OP_WRITE, handle, (char*)data, len, offset, &uring_res))
+        return (int)uring_res;
 #endif
     uv_fs_t req;
     uv_buf_t buf[1];
@@ -428,6 +944,11 @@ JL_DLLEXPORT int jl_fs_write(uv_os_fd_t handle, const char *data, size_t len,
 
 JL_DLLEXPORT int jl_fs_read(uv_os_fd_t handle, char *data, size_t len)
 {
+#ifdef JL_HAVE_IO_URING
+    ssize_t uring_res;
+    if (fs_ring_rw(IORING_OP_READ, handle, data, len, -1, &uring_res))
+        return (int)uring_res;
+#endif
     uv_fs_t req;
     uv_buf_t buf[1];
     buf[0].base = data;
@@ -439,15 +960,27 @@ JL_DLLEXPORT int jl_fs_read(uv_os_fd_t handle, char *data, size_t len)
 
 JL_DLLEXPORT int jl_fs_read_byte(uv_os_fd_t handle)
 {
-    uv_fs_t req;
     unsigned char c;
+    int ret;
+#ifdef JL_HAVE_IO_URING
+    ssize_t uring_res;
+    if (fs_ring_rw(IORING_OP_READ, handle, (char*)&c, 1, -1, &uring_res)) {
+        ret = (int)uring_res;
+        goto done;
+    }
+#endif
+    uv_fs_t req;
     uv_buf_t buf[1];
     buf[0].base = (char*)&c;
     buf[0].len = 1;
-    int ret = uv_fs_read(unused_uv_loop_arg, &req, handle, buf, 1, -1, NULL);
+    ret = uv_fs_read(unused_uv_loop_arg, &req, handle, buf, 1, -1, NULL);
     uv_fs_req_cleanup(&req);
+#ifdef JL_HAVE_IO_URING
+done:
+#endif
+    if (ret < 0)
+        return ret;
     switch (ret) {
-    case -1: return ret;
     case  0: jl_eof_error();
     case  1: return (int)c;
     default:
@@ -470,8 +1003,13 @@ JL_DLLEXPORT int jl_uv_write(uv_stream_t *stream, const char *data, size_t n,
     uv_buf_t buf[1];
     buf[0].base = (char*)data;
     buf[0].len = n;
+    jl_sysimg_prefault(data, n); // uv_write hands the buffer straight to writev
     JL_UV_LOCK();
     JL_SIGATOMIC_BEGIN();
+    // drain pending runtime prints first so output stays ordered
+    jl_putbuf_t *pb = jl_putbuf_get(stream, 0);
+    if (pb != NULL)
+        jl_putbuf_flush(pb);
     int err = uv_write(uvw, stream, buf, 1, writecb);
     JL_UV_UNLOCK();
     JL_SIGATOMIC_END();
@@ -529,7 +1067,28 @@ JL_DLLEXPORT void jl_uv_puts(uv_stream_t *stream, const char *str, size_t n)
         // and cvalue_printdata() passes ios_t* to jl_static_show().
         ios_write((ios_t*)stream, str, n);
     }
+    else if (n <= PUTBUF_MAX_COALESCE) {
+        // Coalesce into the stream's write-behind buffer...
+        JL_UV_LOCK();
+        JL_SIGATOMIC_BEGIN();
+        jl_putbuf_t *pb = jl_putbuf_get(stream, 1);
+        if (pb != NULL) {
+            if (pb->len + n > PUTBUF_SIZE)
+                jl_putbuf_flush(pb);
+            memcpy(pb->buf + pb->len, str, n);
+            pb->len += n;
+            JL_UV_UNLOCK();
+            JL_SIGATOMIC_END();
+        }
+        else {
+            // no slot free: write through directly
+            JL_UV_UNLOCK();
+            JL_SIGATOMIC_END();
+            goto direct;
+        }
+    }
     else {
+direct:;
         // Write to libuv stream...
         uv_write_t *req = (uv_write_t*)malloc_s(sizeof(uv_write_t) + n);
         char *data = (char*)(req + 1);
@@ -540,6 +1099,9 @@ JL_DLLEXPORT void jl_uv_puts(uv_stream_t *stream, const char *str, size_t n)
         req->data = NULL;
         JL_UV_LOCK();
         JL_SIGATOMIC_BEGIN();
+        jl_putbuf_t *pb = jl_putbuf_get(stream, 0);
+        if (pb != NULL)
+            jl_putbuf_flush(pb); // keep byte order across the buffer
         int status = uv_write(req, stream, buf, 1, (uv_write_cb)jl_uv_writecb);
         JL_UV_UNLOCK();
         JL_SIGATOMIC_END();
@@ -81,6 +81,7 @@ JL_DLLEXPORT void jl_init_options(void)
                         0, // rr-detach
                         0, // strip-metadata
                         0, // strip-ir
+                        0, // heap-size-hint
     };
     jl_options_initialized = 1;
 }
@@ -176,6 +177,10 @@ static const char opts_hidden[]  =
     " --trace-compile={stderr,name}\n"
     "                           Print precompile statements for methods compiled during execution or save to a path\n\n"
     " --image-codegen           Force generate code in imaging mode\n"
+
+    // memory options
+    " --heap-size-hint=<size>   Forces garbage collection if memory usage is higher than that value.\n"
+    "                           The memory hint might be specified in megabytes (500M) or gigabytes (1.5G)\n"
 ;
 
 JL_DLLEXPORT void jl_parse_opts(int *argcp, char ***argvp)
@@ -218,6 +223,7 @@ JL_DLLEXPORT void jl_parse_opts(int *argcp, char ***argvp)
            opt_rr_detach,
            opt_strip_metadata,
            opt_strip_ir,
+           opt_heap_size_hint,
     };
     static const char* const shortopts = "+vhqH:e:E:L:J:C:it:p:O:g:";
     static const struct option longopts[] = {
@@ -273,6 +279,7 @@ JL_DLLEXPORT void jl_parse_opts(int *argcp, char ***argvp)
         { "rr-detach",       no_argument,       0, opt_rr_detach },
         { "strip-metadata",  no_argument,       0, opt_strip_metadata },
         { "strip-ir",        no_argument,       0, opt_strip_ir },
+        { "heap-size-hint",  required_argument, 0, opt_heap_size_hint },
         { 0, 0, 0, 0 }
     };
 
@@ -703,6 +710,35 @@ restart_switch:
         case opt_strip_ir:
             jl_options.strip_ir = 1;
             break;
+        case opt_heap_size_hint:
+            if (optarg != NULL) {
+                size_t endof = strlen(optarg);
+                long double value = 0.0;
+                if (sscanf(optarg, "%Lf", &value) == 1 && value > 0) {
+                    char unit = optarg[endof - 1];
+                    uint64_t multiplier = 1ull;
+                    switch (unit) {
+                    case 'k': case 'K':
+                        multiplier <<= 10;
+                        break;
+                    case 'm': case 'M':
+                        multiplier <<= 20;
+                        break;
+                    case 'g': case 'G':
+                        multiplier <<= 30;
+                        break;
+                    case 't': case 'T':
+                        multiplier <<= 40;
+                        break;
+                    default:
+                        break;
+                    }
+                    jl_options.heap_size_hint = (uint64_t)(value * multiplier);
+                }
+            }
+            if (jl_options.heap_size_hint == 0)
+                jl_errorf("julia: invalid argument to --heap-size-hint (%s)", optarg);
+            break;
         default:
             jl_errorf("julia: unhandled option -- %c\n"
                       "This is a bug, please report it.", c);
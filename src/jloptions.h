@@ -53,6 +53,7 @@ typedef struct {
     int8_t rr_detach;
     int8_t strip_metadata;
     int8_t strip_ir;
+    uint64_t heap_size_hint;
 } jl_options_t;
 
 #endif
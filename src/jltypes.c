@@ -79,9 +79,15 @@ static int has_free_typevars(jl_value_t *v, jl_typeenv_t *env) JL_NOTSAFEPOINT
     if (jl_typeis(v, jl_tvar_type)) {
         return !typeenv_has(env, (jl_tvar_t*)v);
     }
-    if (jl_is_uniontype(v))
+    if (jl_is_uniontype(v)) {
+        if (env == NULL)
+            // route through the memoizing entry point so that each member of
+            // a large union is answered from its own cache slot
+            return jl_has_free_typevars(((jl_uniontype_t*)v)->a) ||
+                jl_has_free_typevars(((jl_uniontype_t*)v)->b);
         return has_free_typevars(((jl_uniontype_t*)v)->a, env) ||
             has_free_typevars(((jl_uniontype_t*)v)->b, env);
+    }
     if (jl_is_vararg(v)) {
         jl_vararg_t *vm = (jl_vararg_t*)v;
         if (vm->T) {
@@ -110,9 +116,31 @@ static int has_free_typevars(jl_value_t *v, jl_typeenv_t *env) JL_NOTSAFEPOINT
     return 0;
 }
 
+// Datatypes carry a precomputed hasfreetypevars bit, but Union, UnionAll and
+// Vararg have no spare room in their (Julia-visible) layout, so the query
+// walks their whole tree. Memoize those forms in a small direct-mapped
+// table: types are immutable, so an answer never goes stale, and the 1-bit
+// result is packed into the low bit of the pointer-aligned key so that a
+// lookup is a single tear-free atomic load. The keys are marked as roots by
+// the GC, so a cached pointer can never be recycled for a new object.
+_Atomic(uintptr_t) jl_has_free_cache[JL_N_HAS_FREE_CACHE];
+
 JL_DLLEXPORT int jl_has_free_typevars(jl_value_t *v) JL_NOTSAFEPOINT
 {
-    return has_free_typevars(v, NULL);
+    if (jl_typeis(v, jl_tvar_type))
+        return 1;
+    if (jl_is_datatype(v))
+        return ((jl_datatype_t*)v)->hasfreetypevars;
+    if (!jl_is_uniontype(v) && !jl_is_unionall(v) && !jl_is_vararg(v))
+        return 0;
+    uintptr_t key = (uintptr_t)v;
+    _Atomic(uintptr_t) *slot = &jl_has_free_cache[(key ^ (key >> 9)) & (JL_N_HAS_FREE_CACHE - 1)];
+    uintptr_t w = jl_atomic_load_relaxed(slot);
+    if ((w & ~(uintptr_t)1) == key)
+        return (int)(w & 1);
+    int res = has_free_typevars(v, NULL);
+    jl_atomic_store_relaxed(slot, key | (uintptr_t)(res != 0));
+    return res;
 }
 
 static void find_free_typevars(jl_value_t *v, jl_typeenv_t *env, jl_array_t *out)
@@ -330,6 +358,51 @@ int jl_find_union_component(jl_value_t *haystack, jl_value_t *needle, unsigned *
     return 0;
 }
 
+_Atomic(jl_union_components_t*) jl_union_component_cache[UNION_COMPONENT_CACHE_SIZE] JL_GLOBALLY_ROOTED;
+
+static void flatten_union_components(jl_value_t *v, jl_union_components_t *fc) JL_NOTSAFEPOINT
+{
+    if (jl_is_uniontype(v)) {
+        flatten_union_components(((jl_uniontype_t*)v)->a, fc);
+        flatten_union_components(((jl_uniontype_t*)v)->b, fc);
+    }
+    else {
+        fc->components[fc->n++] = v;
+    }
+}
+
+// Memoized flattened view of union type `u`, so isbits-union array accesses
+// can turn a selector byte into its component type with one indexed load and
+// a component type into its selector with a flat pointer scan, instead of
+// walking the union tree per element (see jl_arrayref/jl_arrayset in
+// array.c). Slots are direct mapped and write-once: a slot claimed by one
+// union is never replaced, so a concurrent reader's pointer stays valid
+// without any reclamation, and returns NULL when the slot is already held by
+// a different union, in which case the caller walks the union tree instead.
+// The cached union types are scanned as GC roots (see mark_roots in gc.c),
+// so a pointer-equal key can never be a recycled address describing some
+// other union.
+jl_union_components_t *jl_union_components_flat(jl_value_t *u) JL_NOTSAFEPOINT
+{
+    size_t slot = (((uintptr_t)u) >> 4) & (UNION_COMPONENT_CACHE_SIZE - 1);
+    jl_union_components_t *fc = jl_atomic_load_acquire(&jl_union_component_cache[slot]);
+    if (fc != NULL)
+        return fc->u == u ? fc : NULL;
+    int n = jl_count_union_components(u);
+    fc = (jl_union_components_t*)malloc_s(sizeof(jl_union_components_t) + n * sizeof(jl_value_t*));
+    fc->u = u;
+    fc->n = 0;
+    flatten_union_components(u, fc);
+    assert(fc->n == (uint32_t)n);
+    jl_union_components_t *expected = NULL;
+    if (!jl_atomic_cmpswap(&jl_union_component_cache[slot], &expected, fc)) {
+        // lost the race to claim the slot
+        free(fc);
+        return expected->u == u ? expected : NULL;
+    }
+    return fc;
+}
+
 static void flatten_type_union(jl_value_t **types, size_t n, jl_value_t **out, size_t *idx) JL_NOTSAFEPOINT
 {
     size_t i;
@@ -699,6 +772,32 @@ static ssize_t lookup_type_idx_linearvalue(jl_svec_t *cache, jl_value_t *key1, j
     return ~cl;
 }
 
+// The linear cache holds exactly the keys whose semantic equality
+// (jl_types_equal) admits no stable hash, so it can only be searched by
+// scanning; to keep hot lookups from paying the full scan, a found entry is
+// promoted toward the front by halving its index. Order carries no meaning —
+// insertion just fills the first NULL slot — so swapping entries is
+// semantically free. Swaps run under typecache_lock, and a lock-free reader
+// that misses an entry mid-swap falls through to the insertion path, which
+// re-checks under the same lock before creating a duplicate.
+#define LINEARCACHE_PROMOTE_MIN 8
+static void linearcache_promote(jl_svec_t *cache, ssize_t idx)
+{
+    if (idx < LINEARCACHE_PROMOTE_MIN)
+        return;
+    if (!jl_mutex_trylock_nogc(&typecache_lock))
+        return; // contended; promotion is only a heuristic
+    _Atomic(jl_value_t*) *data = (_Atomic(jl_value_t*)*)jl_svec_data(cache);
+    ssize_t dst = idx / 2;
+    jl_value_t *hit = jl_atomic_load_relaxed(&data[idx]);
+    jl_value_t *other = jl_atomic_load_relaxed(&data[dst]);
+    if (hit != NULL && other != NULL) {
+        jl_atomic_store_release(&data[dst], hit);
+        jl_atomic_store_release(&data[idx], other);
+    }
+    jl_mutex_unlock_nogc(&typecache_lock);
+}
+
 static jl_value_t *lookup_type(jl_typename_t *tn JL_PROPAGATES_ROOT, jl_value_t **key, size_t n)
 {
     JL_TIMING(TYPE_CACHE_LOOKUP);
@@ -710,7 +809,11 @@ static jl_value_t *lookup_type(jl_typename_t *tn JL_PROPAGATES_ROOT, jl_value_t
     else {
         jl_svec_t *linearcache = jl_atomic_load_relaxed(&tn->linearcache);
         ssize_t idx = lookup_type_idx_linear(linearcache, key, n);
-        return (idx < 0) ? NULL : jl_svecref(linearcache, idx);
+        if (idx < 0)
+            return NULL;
+        jl_value_t *t = jl_svecref(linearcache, idx);
+        linearcache_promote(linearcache, idx);
+        return t;
     }
 }
 
@@ -726,7 +829,11 @@ static jl_value_t *lookup_typevalue(jl_typename_t *tn, jl_value_t *key1, jl_valu
         assert(leaf);
         jl_svec_t *linearcache = jl_atomic_load_relaxed(&tn->linearcache);
         ssize_t idx = lookup_type_idx_linearvalue(linearcache, key1, key, n);
-        return (idx < 0) ? NULL : jl_svecref(linearcache, idx);
+        if (idx < 0)
+            return NULL;
+        jl_value_t *t = jl_svecref(linearcache, idx);
+        linearcache_promote(linearcache, idx);
+        return t;
     }
 }
 
@@ -1461,9 +1568,22 @@ static jl_value_t *inst_datatype_inner(jl_datatype_t *dt, jl_svec_t *p, jl_value
             jl_svecset(p, i, iparams[i]);
     }
 
+    jl_datatype_t *primarydt = ((jl_datatype_t*)jl_unwrap_unionall(tn->wrapper));
+
+    // Tuple and NamedTuple instantiation never recurses through the
+    // in-progress type, so the (often expensive) construction and layout work
+    // can run outside typecache_lock; the lock is then only taken around a
+    // final lookup-or-publish step, and losing that race just discards our
+    // copy and returns the winner. Other types can leak the in-progress type
+    // globally via the instantiation stack (inner cacheable types may be
+    // published holding a reference to it), so they must hold the lock across
+    // construction to guarantee they win.
+    int publish_optimistic = cacheable && (istuple || isnamedtuple) &&
+        dt->super != NULL && (dt->types != NULL || primarydt->types != NULL);
+
     // acquire the write lock now that we know we need a new object
     // since we're going to immediately leak it globally via the instantiation stack
-    if (cacheable) {
+    if (cacheable && !publish_optimistic) {
         JL_LOCK(&typecache_lock); // Might GC
         jl_value_t *lkup = (jl_value_t*)lookup_type(tn, iparams, ntp);
         if (lkup != NULL) {
@@ -1517,7 +1637,6 @@ static jl_value_t *inst_datatype_inner(jl_datatype_t *dt, jl_svec_t *p, jl_value
         }
     }
 
-    jl_datatype_t *primarydt = ((jl_datatype_t*)jl_unwrap_unionall(tn->wrapper));
     jl_precompute_memoized_dt(ndt, cacheable);
     ndt->size = 0;
     if (primarydt->layout)
@@ -1565,6 +1684,17 @@ static jl_value_t *inst_datatype_inner(jl_datatype_t *dt, jl_svec_t *p, jl_value
     if (cacheable) {
         if (ndt->layout == NULL && ndt->types != NULL && ndt->isconcretetype)
             jl_compute_field_offsets(ndt);
+        if (publish_optimistic) {
+            JL_LOCK(&typecache_lock); // Might GC
+            jl_value_t *lkup = (jl_value_t*)lookup_type(tn, iparams, ntp);
+            if (lkup != NULL) {
+                // another thread constructed this type concurrently and won
+                // the publication race; discard ours and return the winner
+                JL_UNLOCK(&typecache_lock); // Might GC
+                JL_GC_POP();
+                return lkup;
+            }
+        }
         jl_cache_type_(ndt);
         JL_UNLOCK(&typecache_lock); // Might GC
     }
@@ -163,11 +163,12 @@ typedef struct {
       3 = has a pointer to the object that owns the data
     */
     uint16_t how:2;
-    uint16_t ndims:9;
+    uint16_t ndims:8;
     uint16_t pooled:1;
     uint16_t ptrarray:1; // representation is pointer array
     uint16_t hasptr:1; // representation has embedded pointers
     uint16_t isshared:1; // data is shared by multiple Arrays
+    uint16_t iscow:1; // shared data is copy-on-write: copy before the first store
     uint16_t isaligned:1; // data allocated with memalign
 } jl_array_flags_t;
 
@@ -529,6 +530,9 @@ typedef struct _jl_module_t {
     struct _jl_module_t *parent;
     // hidden fields:
     htable_t bindings;
+    // lock-free read cache over `bindings`: a self-describing open-addressed
+    // array published atomically (see module.c); not serialized
+    _Atomic(void**) bindingcache;
     arraylist_t usings;  // modules with all bindings potentially imported
     uint64_t build_id;
     jl_uuid_t uuid;
@@ -550,8 +554,10 @@ typedef struct _jl_typemap_entry_t {
     jl_tupletype_t *sig; // the type signature for this entry
     jl_tupletype_t *simplesig; // a simple signature for fast rejection
     jl_svec_t *guardsigs;
-    size_t min_world;
-    size_t max_world;
+    // world bounds are mutated in place by invalidation while lock-free
+    // readers are testing them, so they need atomic accesses
+    _Atomic(size_t) min_world;
+    _Atomic(size_t) max_world;
     union {
         jl_value_t *value; // generic accessor
         jl_method_instance_t *linfo; // [nullable] for guard entries
@@ -594,9 +600,14 @@ typedef struct _jl_methtable_t {
     jl_array_t *backedges;
     jl_mutex_t writelock;
     uint8_t offs;  // 0, or 1 to skip splitting typemap on first (function) argument
-    uint8_t frozen; // whether this accepts adding new methods
+    // 0 if this accepts adding new methods, else one of the JL_MT_FROZEN_*
+    // reasons below (insertion and deletion throw either way)
+    uint8_t frozen;
 } jl_methtable_t;
 
+#define JL_MT_FROZEN_BUILTIN 1 // the method table of a builtin function
+#define JL_MT_FROZEN_SEALED  2 // sealed by jl_method_table_seal
+
 typedef struct {
     JL_DATA_TYPE
     jl_sym_t *head;
@@ -825,6 +836,7 @@ extern void JL_GC_POP() JL_NOTSAFEPOINT;
 
 JL_DLLEXPORT int jl_gc_enable(int on);
 JL_DLLEXPORT int jl_gc_is_enabled(void);
+JL_DLLEXPORT void jl_gc_set_max_memory(uint64_t max_mem);
 
 typedef enum {
     JL_GC_AUTO = 0,         // use heuristics to determine the collection type
@@ -852,6 +864,7 @@ JL_DLLEXPORT void jl_clear_malloc_data(void);
 // GC write barriers
 JL_DLLEXPORT void jl_gc_queue_root(const jl_value_t *root) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jl_gc_queue_multiroot(const jl_value_t *root, const jl_value_t *stored) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_gc_queue_array_card(const jl_value_t *owner, size_t i) JL_NOTSAFEPOINT;
 
 STATIC_INLINE void jl_gc_wb(const void *parent, const void *ptr) JL_NOTSAFEPOINT
 {
@@ -861,6 +874,16 @@ STATIC_INLINE void jl_gc_wb(const void *parent, const void *ptr) JL_NOTSAFEPOINT
         jl_gc_queue_root((jl_value_t*)parent);
 }
 
+// Card-granular write barrier for stores into object arrays: records the
+// dirtied 512-byte card of `a` instead of remembering the whole array, so
+// quick collections only rescan the cards that were actually written.
+STATIC_INLINE void jl_gc_wb_array(const void *a, size_t i, const void *ptr) JL_NOTSAFEPOINT
+{
+    if (__unlikely(jl_astaggedvalue(a)->bits.gc == 3 && // array is old and not in remset
+                   (jl_astaggedvalue(ptr)->bits.gc & 1) == 0)) // ptr is young
+        jl_gc_queue_array_card((jl_value_t*)a, i);
+}
+
 STATIC_INLINE void jl_gc_wb_back(const void *ptr) JL_NOTSAFEPOINT // ptr isa jl_value_t*
 {
     // if ptr is old
@@ -886,6 +909,14 @@ JL_DLLEXPORT void *jl_gc_managed_malloc(size_t sz);
 JL_DLLEXPORT void *jl_gc_managed_realloc(void *d, size_t sz, size_t oldsz,
                                          int isaligned, jl_value_t *owner);
 
+// arena (region) allocation for object graphs that die together; see gc.c
+typedef struct _jl_gc_arena_t jl_gc_arena_t;
+JL_DLLEXPORT jl_gc_arena_t *jl_gc_arena_begin(void);
+JL_DLLEXPORT jl_value_t *jl_gc_arena_alloc(jl_gc_arena_t *arena, size_t sz, void *ty);
+JL_DLLEXPORT void jl_gc_arena_end(jl_gc_arena_t *arena);
+JL_DLLEXPORT jl_gc_arena_t *jl_gc_task_arena_begin(void);
+JL_DLLEXPORT void jl_gc_task_arena_end(void);
+
 // object accessors -----------------------------------------------------------
 
 #define jl_svec_len(t)              (((jl_svec_t*)(t))->length)
@@ -935,6 +966,10 @@ JL_DLLEXPORT size_t jl_array_len_(jl_array_t *a);
 #define jl_array_data_owner(a) (*((jl_value_t**)((char*)a + jl_array_data_owner_offset(jl_array_ndims(a)))))
 
 JL_DLLEXPORT char *jl_array_typetagdata(jl_array_t *a) JL_NOTSAFEPOINT;
+// word-at-a-time scans over an isbits-union array's selector bytes
+JL_DLLEXPORT size_t jl_array_tag_count(jl_array_t *a, uint8_t sel) JL_NOTSAFEPOINT;
+JL_DLLEXPORT size_t jl_array_tag_find(jl_array_t *a, size_t i, uint8_t sel) JL_NOTSAFEPOINT;
+JL_DLLEXPORT size_t jl_array_tag_find_not(jl_array_t *a, size_t i, uint8_t sel) JL_NOTSAFEPOINT;
 
 #ifdef __clang_gcanalyzer__
 jl_value_t **jl_array_ptr_data(jl_array_t *a JL_PROPAGATES_ROOT) JL_NOTSAFEPOINT;
@@ -959,9 +994,14 @@ STATIC_INLINE jl_value_t *jl_array_ptr_set(
     jl_atomic_store_relaxed(((_Atomic(jl_value_t*)*)(jl_array_data(a))) + i, (jl_value_t*)x);
     if (x) {
         if (((jl_array_t*)a)->flags.how == 3) {
+            // the data belongs to another array; the card index would not
+            // be meaningful for the owner, so remember the whole object
             a = jl_array_data_owner(a);
+            jl_gc_wb(a, x);
+        }
+        else {
+            jl_gc_wb_array(a, i, x);
         }
-        jl_gc_wb(a, x);
     }
     return (jl_value_t*)x;
 }
@@ -1501,6 +1541,9 @@ JL_DLLEXPORT int jl_islayout_inline(jl_value_t *eltype, size_t *fsz, size_t *al)
 JL_DLLEXPORT jl_array_t *jl_new_array(jl_value_t *atype, jl_value_t *dims);
 JL_DLLEXPORT jl_array_t *jl_reshape_array(jl_value_t *atype, jl_array_t *data,
                                           jl_value_t *dims);
+JL_DLLEXPORT jl_array_t *jl_array_slice(jl_array_t *data, size_t offset,
+                                        size_t len);
+JL_DLLEXPORT void jl_array_uncow(jl_array_t *a);
 JL_DLLEXPORT jl_array_t *jl_ptr_to_array_1d(jl_value_t *atype, void *data,
                                             size_t nel, int own_buffer);
 JL_DLLEXPORT jl_array_t *jl_ptr_to_array(jl_value_t *atype, void *data,
@@ -1514,8 +1557,13 @@ JL_DLLEXPORT jl_array_t *jl_alloc_array_3d(jl_value_t *atype, size_t nr,
 JL_DLLEXPORT jl_array_t *jl_pchar_to_array(const char *str, size_t len);
 JL_DLLEXPORT jl_value_t *jl_pchar_to_string(const char *str, size_t len);
 JL_DLLEXPORT jl_value_t *jl_cstr_to_string(const char *str);
+JL_DLLEXPORT int jl_string_cmp(jl_value_t *a, jl_value_t *b) JL_NOTSAFEPOINT;
+JL_DLLEXPORT size_t jl_string_find(const char *hay, size_t hlen,
+                                   const char *needle, size_t nlen,
+                                   size_t start) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_value_t *jl_alloc_string(size_t len);
 JL_DLLEXPORT jl_value_t *jl_array_to_string(jl_array_t *a);
+JL_DLLEXPORT jl_array_t *jl_string_buffer_array(size_t len);
 JL_DLLEXPORT jl_array_t *jl_alloc_vec_any(size_t n);
 JL_DLLEXPORT jl_value_t *jl_arrayref(jl_array_t *a, size_t i);  // 0-indexed
 JL_DLLEXPORT jl_value_t *jl_ptrarrayref(jl_array_t *a JL_PROPAGATES_ROOT, size_t i) JL_NOTSAFEPOINT;  // 0-indexed
@@ -1531,6 +1579,9 @@ JL_DLLEXPORT void jl_array_ptr_1d_push(jl_array_t *a, jl_value_t *item);
 JL_DLLEXPORT void jl_array_ptr_1d_append(jl_array_t *a, jl_array_t *a2);
 JL_DLLEXPORT jl_value_t *jl_apply_array_type(jl_value_t *type, size_t dim);
 JL_DLLEXPORT int jl_array_validate_dims(size_t *nel, size_t *tot, uint32_t ndims, size_t *dims, size_t elsz);
+// memmove that uses non-temporal stores for blocks larger than the last-level
+// cache, so huge copies don't evict the working set
+JL_DLLEXPORT void *jl_memmove(void *dst, const void *src, size_t nb) JL_NOTSAFEPOINT;
 // property access
 JL_DLLEXPORT void *jl_array_ptr(jl_array_t *a);
 JL_DLLEXPORT void *jl_array_eltype(jl_value_t *a);
@@ -1587,6 +1638,7 @@ STATIC_INLINE jl_function_t *jl_get_function(jl_module_t *m, const char *name)
 
 // eq hash tables
 JL_DLLEXPORT jl_array_t *jl_eqtable_put(jl_array_t *h, jl_value_t *key, jl_value_t *val, int *inserted);
+JL_DLLEXPORT jl_array_t *jl_eqtable_sizehint(jl_array_t *h, size_t n);
 JL_DLLEXPORT jl_value_t *jl_eqtable_get(jl_array_t *h, jl_value_t *key, jl_value_t *deflt) JL_NOTSAFEPOINT;
 
 // system information
@@ -1601,6 +1653,7 @@ JL_DLLEXPORT jl_sym_t *jl_get_UNAME(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_sym_t *jl_get_ARCH(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT jl_value_t *jl_get_libllvm(void) JL_NOTSAFEPOINT;
 extern JL_DLLIMPORT int jl_n_threads;
+extern JL_DLLIMPORT int jl_sched_depth_first;
 
 // environment entries
 JL_DLLEXPORT jl_value_t *jl_environ(int i);
@@ -1823,6 +1876,22 @@ typedef struct _jl_handler_t {
     size_t world_age;
 } jl_handler_t;
 
+// hardware performance counter slots (perf-counters.c); counts are accrued
+// to the running task across context switches so a single task can be
+// measured independently of which threads it ran on
+typedef enum {
+    JL_PERF_CYCLES = 0,
+    JL_PERF_INSTRUCTIONS,
+    JL_PERF_CACHE_MISSES,
+    JL_PERF_BRANCH_MISSES,
+    JL_PERF_NCOUNTERS
+} jl_perf_counter_t;
+JL_DLLEXPORT int jl_perf_counters_enabled(void);
+JL_DLLEXPORT int jl_perf_task_counters(uint64_t counts[JL_PERF_NCOUNTERS]);
+
+// number of fixed fast task-local storage slots in every task
+#define JL_TASK_TLS_NSLOTS 4
+
 typedef struct _jl_task_t {
     JL_DATA_TYPE
     jl_value_t *next; // invasive linked list for scheduler
@@ -1854,6 +1923,21 @@ typedef struct _jl_task_t {
     jl_excstack_t *excstack;
     // current exception handler
     jl_handler_t *eh;
+    // fixed fast task-local storage slots for runtime instrumentation and
+    // context propagation, inherited from the parent at task creation (NULL
+    // when unset); accessed via jl_get_task_tls/jl_set_task_tls. Not part of
+    // the type's layout, so the GC scans them explicitly.
+    jl_value_t *tls_slots[JL_TASK_TLS_NSLOTS];
+    // attached bump-allocation arena, mirrored in `ptls->task_arena` while
+    // the task runs (NULL unless opted in via `jl_gc_task_arena_begin`)
+    jl_gc_arena_t *arena;
+    // hardware counters accrued while this task was running (jl_perf_counter_t
+    // slots; all zero unless counting is enabled, see perf-counters.c)
+    uint64_t perf_counts[JL_PERF_NCOUNTERS];
+    // jl_hrtime() when the task was last pushed onto a scheduler deque (0 if
+    // it has never been queued); consumed by the scheduler to build the
+    // enqueue-to-run latency histogram (see jl_sched_stats)
+    uint64_t enqueue_tstamp;
     // saved thread state
     jl_ucontext_t ctx;
     void *stkbuf; // malloc'd memory (either copybuf or stack)
@@ -1869,7 +1953,10 @@ typedef struct _jl_task_t {
 JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t*, jl_value_t*, size_t);
 JL_DLLEXPORT void jl_switchto(jl_task_t **pt);
 JL_DLLEXPORT int jl_set_task_tid(jl_task_t *task, int tid) JL_NOTSAFEPOINT;
+JL_DLLEXPORT jl_value_t *jl_get_task_tls(size_t i) JL_NOTSAFEPOINT;
+JL_DLLEXPORT void jl_set_task_tls(size_t i, jl_value_t *v);
 JL_DLLEXPORT void JL_NORETURN jl_throw(jl_value_t *e JL_MAYBE_UNROOTED);
+JL_DLLEXPORT void JL_NORETURN jl_throw_nobt(jl_value_t *e JL_MAYBE_UNROOTED);
 JL_DLLEXPORT void JL_NORETURN jl_rethrow(void);
 JL_DLLEXPORT void JL_NORETURN jl_sig_throw(void);
 JL_DLLEXPORT void JL_NORETURN jl_rethrow_other(jl_value_t *e JL_MAYBE_UNROOTED);
@@ -1966,6 +2053,10 @@ typedef int jl_uv_os_fd_t;
 #define JL_STDIN  jl_uv_stdin
 
 JL_DLLEXPORT int jl_process_events(void);
+// O(1) coarse timeouts on the event loop (see jl_uv.c); callers must hold
+// the iolock. The handle returned by add is consumed by firing or cancel.
+JL_DLLEXPORT void *jl_timer_wheel_add(uint64_t timeout_ms, void (*cb)(void*), void *data);
+JL_DLLEXPORT void jl_timer_wheel_cancel(void *handle);
 
 JL_DLLEXPORT struct uv_loop_s *jl_global_event_loop(void);
 
@@ -81,6 +81,17 @@ JL_DLLEXPORT void jl_gc_mark_queue_objarray(jl_ptls_t ptls, jl_value_t *parent,
 // done right after allocating the object.
 JL_DLLEXPORT void jl_gc_schedule_foreign_sweepfunc(jl_ptls_t ptls, jl_value_t * bj);
 
+// Pin and unpin an object. A pinned object is kept alive like a global
+// root, so foreign code may retain pointers to it (or into its data, such
+// as an array buffer handed to RDMA or io_uring) without keeping a
+// reference that is otherwise visible to the collector. Julia's collector
+// does not relocate objects, so a pinned object's address and data pointer
+// are stable for its whole lifetime anyway; pinning only extends that
+// lifetime. Pins nest: an object stays pinned until every
+// jl_gc_pin_object() call has been matched by a jl_gc_unpin_object().
+JL_DLLEXPORT void jl_gc_pin_object(jl_value_t *obj);
+JL_DLLEXPORT void jl_gc_unpin_object(jl_value_t *obj);
+
 // The following functions enable support for conservative marking. This
 // functionality allows the user to determine if a machine word can be
 // interpreted as a pointer to an object (including the interior of an
@@ -221,7 +221,84 @@ extern jl_array_t *_jl_debug_method_invalidation JL_GLOBALLY_ROOTED;
 extern JL_DLLEXPORT size_t jl_page_size;
 extern jl_function_t *jl_typeinf_func;
 extern JL_DLLEXPORT size_t jl_typeinf_world;
-extern _Atomic(jl_typemap_entry_t*) call_cache[N_CALL_CACHE] JL_GLOBALLY_ROOTED;
+extern _Atomic(jl_typemap_entry_t*) *call_cache JL_GLOBALLY_ROOTED;
+extern uint32_t jl_call_cache_size;
+void jl_init_call_cache(void);
+JL_DLLEXPORT void jl_call_cache_stats_enable(int enable);
+JL_DLLEXPORT void jl_get_call_cache_stats(uint64_t *hits, uint64_t *misses, uint64_t *evictions);
+// per-call-site inline-cache slots for dynamic dispatch (see gf.c); slots are
+// allocated in blocks that are never freed and scanned as GC roots
+#define JL_CALLSITE_CACHE_NSLOTS 1024
+typedef struct _jl_callsite_block_t {
+    struct _jl_callsite_block_t *next;
+    size_t used;
+    _Atomic(jl_typemap_entry_t*) slots[JL_CALLSITE_CACHE_NSLOTS];
+} jl_callsite_block_t;
+extern _Atomic(jl_callsite_block_t*) jl_callsite_blocks;
+JL_DLLEXPORT void *jl_alloc_callsite_cache(void);
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site(jl_value_t *F, jl_value_t **args, uint32_t nargs, jl_value_t *site);
+// register-based jlcall entries for low-arity dynamic call sites
+JL_DLLEXPORT jl_value_t *jl_apply_generic0(jl_value_t *F);
+JL_DLLEXPORT jl_value_t *jl_apply_generic1(jl_value_t *F, jl_value_t *a1);
+JL_DLLEXPORT jl_value_t *jl_apply_generic2(jl_value_t *F, jl_value_t *a1, jl_value_t *a2);
+JL_DLLEXPORT jl_value_t *jl_apply_generic3(jl_value_t *F, jl_value_t *a1, jl_value_t *a2, jl_value_t *a3);
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site0(jl_value_t *F, jl_value_t *site);
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site1(jl_value_t *F, jl_value_t *a1, jl_value_t *site);
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site2(jl_value_t *F, jl_value_t *a1, jl_value_t *a2, jl_value_t *site);
+JL_DLLEXPORT jl_value_t *jl_apply_generic_site3(jl_value_t *F, jl_value_t *a1, jl_value_t *a2, jl_value_t *a3, jl_value_t *site);
+// memoized jl_matching_methods results (see gf.c); scanned as GC roots
+#define JL_N_MATCH_CACHE 1024
+typedef struct {
+    jl_value_t *sig;
+    jl_value_t *matches;
+    jl_methtable_t *mt;
+    size_t min_valid;
+    size_t max_valid;
+    size_t world; // jl_world_counter when the result was computed
+    int lim;
+    int include_ambiguous;
+    int has_ambiguity;
+} jl_match_cache_entry_t;
+extern jl_match_cache_entry_t jl_match_cache[JL_N_MATCH_CACHE];
+// memoized subtyping verdicts for typevar-free pairs (see subtype.c); the
+// keys are scanned as GC roots
+#define JL_N_SUBTYPE_CACHE 8192
+typedef struct {
+    jl_value_t *x;
+    jl_value_t *y;
+    int result;
+} jl_subtype_cache_entry_t;
+extern jl_subtype_cache_entry_t jl_subtype_cache[JL_N_SUBTYPE_CACHE];
+JL_DLLEXPORT void jl_get_subtype_cache_stats(uint64_t *hits, uint64_t *misses, uint64_t *evictions);
+// memoized type-intersection results (see subtype.c); scanned as GC roots
+#define JL_N_INTERSECT_CACHE 4096
+typedef struct {
+    jl_value_t *a;
+    jl_value_t *b;
+    jl_value_t *ti;
+    jl_svec_t *env; // NULL when the entry was computed without an environment
+    int issubty;
+} jl_intersect_cache_entry_t;
+extern jl_intersect_cache_entry_t jl_intersect_cache[JL_N_INTERSECT_CACHE];
+// memoized jl_has_free_typevars answers for Union/UnionAll/Vararg (see
+// jltypes.c); each slot packs the 1-bit answer into the low bit of the
+// pointer-aligned key so a lookup is a single atomic load. The keys are
+// scanned as GC roots.
+#define JL_N_HAS_FREE_CACHE 2048
+extern _Atomic(uintptr_t) jl_has_free_cache[JL_N_HAS_FREE_CACHE];
+// per-module and per-method compile/inference time attribution (see gf.c);
+// values are malloc'd uint64 cells, keys are scanned as GC roots
+extern htable_t jl_compile_time_module_table;
+extern htable_t jl_compile_time_method_table;
+JL_DLLEXPORT void jl_record_compile_time_for(jl_method_instance_t *mi, uint64_t ns);
+JL_DLLEXPORT uint64_t jl_module_compile_time_ns(jl_module_t *m);
+JL_DLLEXPORT uint64_t jl_method_compile_time_ns(jl_method_t *m);
+JL_DLLEXPORT jl_value_t *jl_compile_time_by_module(void);
+JL_DLLEXPORT jl_value_t *jl_compile_time_by_method(void);
+// interned <= 7-byte strings (see jl_pchar_to_string in array.c); entries are
+// replaced on collision and scanned as GC roots until evicted
+#define JL_N_SMALL_STRING_CACHE 1024
+extern _Atomic(jl_value_t*) jl_small_string_cache[JL_N_SMALL_STRING_CACHE];
 extern jl_array_t *jl_all_methods JL_GLOBALLY_ROOTED;
 
 JL_DLLEXPORT extern int jl_lineno;
@@ -238,6 +315,13 @@ void *jl_gc_perm_alloc(size_t sz, int zero,
     unsigned align, unsigned offset) JL_NOTSAFEPOINT;
 void jl_gc_force_mark_old(jl_ptls_t ptls, jl_value_t *v);
 void gc_sweep_sysimg(void);
+// lazily relocate a system image page on first access (staticdata.c); called
+// from the SIGSEGV handler, returns 1 if the fault was an image page
+JL_DLLEXPORT int jl_sysimg_materialize_page(void *addr) JL_NOTSAFEPOINT;
+// materialize every still-protected image page overlapping [data, data+n);
+// required before handing the range to a syscall, which reports EFAULT
+// instead of faulting the page in
+JL_DLLEXPORT void jl_sysimg_prefault(const void *data, size_t n) JL_NOTSAFEPOINT;
 
 
 // pools are 16376 bytes large (GC_POOL_SZ - GC_PAGE_OFFSET)
@@ -348,9 +432,16 @@ STATIC_INLINE uint8_t JL_CONST_FUNC jl_gc_szclass_align8(unsigned sz)
 #define GC_MAX_SZCLASS (2032-sizeof(void*))
 static_assert(ARRAY_CACHE_ALIGN_THRESHOLD > GC_MAX_SZCLASS, "");
 
+// optional per-datatype allocation accounting (see gc.c): per-thread tables
+// of count and bytes keyed by the type tag, merged by jl_gc_alloc_counts
+extern JL_DLLEXPORT _Atomic(int) jl_alloc_count_enabled;
+void jl_gc_count_alloc_typed(jl_ptls_t ptls, void *ty, size_t sz) JL_NOTSAFEPOINT;
+
 STATIC_INLINE jl_value_t *jl_gc_alloc_(jl_ptls_t ptls, size_t sz, void *ty)
 {
     jl_value_t *v;
+    if (__unlikely(ptls->task_arena != NULL))
+        return jl_gc_arena_alloc(ptls->task_arena, sz, ty);
     const size_t allocsz = sz + sizeof(jl_taggedvalue_t);
     if (sz <= GC_MAX_SZCLASS) {
         int pool_id = jl_gc_szclass(allocsz);
@@ -364,6 +455,8 @@ STATIC_INLINE jl_value_t *jl_gc_alloc_(jl_ptls_t ptls, size_t sz, void *ty)
         v = jl_gc_big_alloc(ptls, allocsz);
     }
     jl_set_typeof(v, ty);
+    if (__unlikely(jl_atomic_load_relaxed(&jl_alloc_count_enabled)))
+        jl_gc_count_alloc_typed(ptls, ty, sz);
     return v;
 }
 
@@ -498,6 +591,7 @@ typedef struct {
     uint8_t inlineable:1;
     uint8_t inferred:1;
     uint8_t constprop:2; // 0 = use heuristic; 1 = aggressive; 2 = none
+    uint8_t compressed:1; // whether the ircode body is deflate-compressed
 } jl_code_info_flags_bitfield_t;
 
 typedef union {
@@ -512,12 +606,15 @@ JL_DLLEXPORT jl_code_info_t *jl_type_infer(jl_method_instance_t *li, size_t worl
 JL_DLLEXPORT jl_code_instance_t *jl_compile_method_internal(jl_method_instance_t *meth JL_PROPAGATES_ROOT, size_t world);
 jl_code_instance_t *jl_generate_fptr(jl_method_instance_t *mi JL_PROPAGATES_ROOT, size_t world);
 void jl_generate_fptr_for_unspecialized(jl_code_instance_t *unspec);
+void jl_promote_codeinst(jl_code_instance_t *codeinst);
 JL_DLLEXPORT jl_code_instance_t *jl_get_method_inferred(
         jl_method_instance_t *mi JL_PROPAGATES_ROOT, jl_value_t *rettype,
         size_t min_world, size_t max_world);
 jl_method_instance_t *jl_get_unspecialized(jl_method_instance_t *method JL_PROPAGATES_ROOT);
 
 JL_DLLEXPORT int jl_compile_hint(jl_tupletype_t *types);
+JL_DLLEXPORT size_t jl_compile_hint_batch(jl_array_t *sigs, size_t start, size_t stop);
+JL_DLLEXPORT void jl_compile_all_defs_batch(jl_array_t *found, size_t start, size_t stop);
 jl_code_info_t *jl_code_for_interpreter(jl_method_instance_t *lam JL_PROPAGATES_ROOT);
 int jl_code_requires_compiler(jl_code_info_t *src);
 jl_code_info_t *jl_new_code_info_from_ir(jl_expr_t *ast);
@@ -566,6 +663,13 @@ int jl_has_concrete_subtype(jl_value_t *typ);
 jl_tupletype_t *jl_inst_arg_tuple_type(jl_value_t *arg1, jl_value_t **args, size_t nargs, int leaf);
 jl_tupletype_t *jl_lookup_arg_tuple_type(jl_value_t *arg1 JL_PROPAGATES_ROOT, jl_value_t **args, size_t nargs, int leaf);
 JL_DLLEXPORT void jl_method_table_insert(jl_methtable_t *mt, jl_method_t *method, jl_tupletype_t *simpletype);
+JL_DLLEXPORT void jl_method_table_seal(jl_methtable_t *mt);
+JL_DLLEXPORT int jl_method_table_sealed(jl_methtable_t *mt) JL_NOTSAFEPOINT;
+// defer invalidation for a run of insertions with no intervening execution
+// (e.g. deserialization); see gf.c
+JL_DLLEXPORT void jl_method_table_batch_begin(void);
+JL_DLLEXPORT void jl_method_table_batch_end(void);
+extern jl_array_t *jl_method_batch JL_GLOBALLY_ROOTED;
 jl_datatype_t *jl_mk_builtin_func(jl_datatype_t *dt, const char *name, jl_fptr_args_t fptr) JL_GC_DISABLED;
 int jl_obviously_unequal(jl_value_t *a, jl_value_t *b);
 JL_DLLEXPORT jl_array_t *jl_find_free_typevars(jl_value_t *v);
@@ -587,6 +691,16 @@ JL_DLLEXPORT jl_value_t *jl_rewrap_unionall(jl_value_t *t, jl_value_t *u);
 int jl_count_union_components(jl_value_t *v);
 JL_DLLEXPORT jl_value_t *jl_nth_union_component(jl_value_t *v JL_PROPAGATES_ROOT, int i) JL_NOTSAFEPOINT;
 int jl_find_union_component(jl_value_t *haystack, jl_value_t *needle, unsigned *nth) JL_NOTSAFEPOINT;
+// memoized flattened view of a union type (see jltypes.c): components in
+// jl_nth_union_component order, so a selector byte is one indexed load
+typedef struct {
+    jl_value_t *u;            // the union type this entry describes
+    uint32_t n;               // number of leaves
+    jl_value_t *components[]; // leaves, in selector order
+} jl_union_components_t;
+#define UNION_COMPONENT_CACHE_SIZE 128
+extern _Atomic(jl_union_components_t*) jl_union_component_cache[UNION_COMPONENT_CACHE_SIZE] JL_GLOBALLY_ROOTED;
+jl_union_components_t *jl_union_components_flat(jl_value_t *u) JL_NOTSAFEPOINT;
 jl_datatype_t *jl_new_abstracttype(jl_value_t *name, jl_module_t *module,
                                    jl_datatype_t *super, jl_svec_t *parameters);
 jl_datatype_t *jl_new_uninitialized_datatype(void);
@@ -606,6 +720,7 @@ jl_function_t *jl_new_generic_function_with_supertype(jl_sym_t *name, jl_module_
 void jl_foreach_reachable_mtable(void (*visit)(jl_methtable_t *mt, void *env), void *env);
 void jl_init_main_module(void);
 JL_DLLEXPORT int jl_is_submodule(jl_module_t *child, jl_module_t *parent) JL_NOTSAFEPOINT;
+void jl_module_presize_bindings(jl_module_t *m, size_t nb);
 jl_array_t *jl_get_loaded_modules(void);
 JL_DLLEXPORT int jl_datatype_isinlinealloc(jl_datatype_t *ty, int pointerfree);
 
@@ -642,6 +757,7 @@ jl_array_t *jl_new_array_for_deserialization(jl_value_t *atype, uint32_t ndims,
                                              int isunboxed, int hasptr, int isunion, int elsz);
 void jl_module_run_initializer(jl_module_t *m);
 jl_binding_t *jl_get_module_binding(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var);
+void jl_free_retired_binding_caches(void) JL_NOTSAFEPOINT;
 JL_DLLEXPORT void jl_binding_deprecation_warning(jl_module_t *m, jl_binding_t *b);
 extern jl_array_t *jl_module_init_order JL_GLOBALLY_ROOTED;
 extern htable_t jl_current_modules JL_GLOBALLY_ROOTED;
@@ -750,6 +866,11 @@ extern JL_DLLEXPORT const int jl_tls_elf_support;
 void jl_init_threading(void);
 void jl_start_threads(void);
 
+// hardware performance counters (perf-counters.c)
+void jl_perf_init(void);
+void jl_perf_init_thread(jl_ptls_t ptls);
+void jl_perf_task_switch(jl_ptls_t ptls, jl_task_t *lastt) JL_NOTSAFEPOINT;
+
 // Whether the GC is running
 extern char *jl_safepoint_pages;
 STATIC_INLINE int jl_addr_is_safepoint(uintptr_t addr)
@@ -826,6 +947,8 @@ JL_DLLEXPORT jl_value_t *jl_dump_function_ir(void *f, char strip_ir_metadata, ch
 JL_DLLEXPORT jl_value_t *jl_dump_function_asm(void *F, char raw_mc, const char* asm_variant, const char *debuginfo, char binary);
 
 void *jl_create_native(jl_array_t *methods, const jl_cgparams_t *cgparams, int policy);
+// native code being saved alongside an incremental .ji (see dump.c)
+extern void *jl_incremental_native_code;
 void jl_dump_native(void *native_code,
         const char *bc_fname, const char *unopt_bc_fname, const char *obj_fname, const char *asm_fname,
         const char *sysimg_data, size_t sysimg_len);
@@ -836,6 +959,7 @@ JL_DLLEXPORT void jl_get_function_id(void *native_code, jl_code_instance_t *ncod
 // the first argument to jl_idtable_rehash is used to return a value
 // make sure it is rooted if it is used after the function returns
 JL_DLLEXPORT jl_array_t *jl_idtable_rehash(jl_array_t *a, size_t newsz);
+JL_DLLEXPORT jl_array_t *jl_idtable_migrate(jl_array_t *oldt, jl_array_t *newt, size_t npairs, size_t *cursor);
 _Atomic(jl_value_t*) *jl_table_peek_bp(jl_array_t *a, jl_value_t *key) JL_NOTSAFEPOINT;
 
 JL_DLLEXPORT jl_method_t *jl_new_method_uninit(jl_module_t*);
@@ -1009,10 +1133,24 @@ typedef int bt_context_t;
 typedef int bt_cursor_t;
 #endif
 size_t rec_backtrace(jl_bt_element_t *bt_data, size_t maxsize, int skip) JL_NOTSAFEPOINT;
+// Fast frame-pointer-chasing variant of rec_backtrace for the exception throw
+// path; falls back to rec_backtrace on platforms without support (see stackwalk.c).
+size_t rec_backtrace_fp(jl_bt_element_t *bt_data, size_t maxsize, int skip) JL_NOTSAFEPOINT;
 // Record backtrace from a signal handler. `ctx` is the context of the code
 // which was asynchronously interrupted.
 size_t rec_backtrace_ctx(jl_bt_element_t *bt_data, size_t maxsize, bt_context_t *ctx,
                          jl_gcframe_t *pgcstack) JL_NOTSAFEPOINT;
+// Fast frame-pointer-chasing variant for the sampling profiler; falls back to
+// rec_backtrace_ctx on platforms without support (see stackwalk.c).
+size_t rec_backtrace_ctx_fp(jl_bt_element_t *bt_data, size_t maxsize, bt_context_t *ctx,
+                            jl_gcframe_t *pgcstack) JL_NOTSAFEPOINT;
+extern int jl_profile_fp_unwind;
+// Deduplicated storage for retained backtraces (see stackwalk.c). Traces with
+// extended (non-native) entries cannot be interned and yield a NULL handle.
+JL_DLLEXPORT void *jl_bt_intern(jl_bt_element_t *bt_data, size_t bt_size) JL_NOTSAFEPOINT;
+JL_DLLEXPORT size_t jl_bt_intern_size(void *handle) JL_NOTSAFEPOINT;
+JL_DLLEXPORT size_t jl_bt_intern_unpack(void *handle, jl_bt_element_t *bt_data,
+                                        size_t maxsize) JL_NOTSAFEPOINT;
 #ifdef LLVMLIBUNWIND
 size_t rec_backtrace_ctx_dwarf(jl_bt_element_t *bt_data, size_t maxsize, bt_context_t *ctx, jl_gcframe_t *pgcstack) JL_NOTSAFEPOINT;
 #endif
@@ -1125,6 +1263,42 @@ JL_DLLEXPORT jl_value_t *jl_get_cfunction_trampoline(
     jl_value_t *fobj, jl_datatype_t *result, htable_t *cache, jl_svec_t *fill,
     void *(*init_trampoline)(void *tramp, void **nval),
     jl_unionall_t *env, jl_value_t **vals);
+JL_DLLEXPORT void jl_cfunction_trampoline_stats(size_t *nalloc, size_t *nfree,
+                                                size_t *npages);
+JL_DLLEXPORT void jl_copy_stack_stats(uint64_t *saves, uint64_t *save_bytes,
+                                      uint64_t *promotions);
+
+// Always-on scheduler counters, one block per thread, maintained with
+// relaxed atomics on the scheduling paths in partr.c. `latency_hist` bucket
+// `i` counts enqueue-to-run latencies in [2^i, 2^(i+1)) microseconds; the
+// last bucket also counts everything longer.
+#define JL_SCHED_LAT_NBUCKETS 16
+typedef struct {
+    uint64_t enqueues;     // tasks pushed onto this thread's deque
+    uint64_t pops;         // tasks this thread popped from its own deque
+    uint64_t steal_hits;   // tasks this thread stole from other threads
+    uint64_t steal_misses; // full victim scans that found nothing to steal
+    uint64_t steal_probes; // victims probed across all scans
+    uint64_t sleeps;       // times this thread blocked on its wake signal
+    uint64_t wakes;        // wakeups delivered to this thread by others
+    uint64_t latency_hist[JL_SCHED_LAT_NBUCKETS];
+} jl_sched_stats_t;
+JL_DLLEXPORT int jl_sched_stats(int16_t tid, jl_sched_stats_t *out) JL_NOTSAFEPOINT;
+
+// One entry per method-invalidation wave, recorded unconditionally in gf.c
+// and kept in a fixed-size ring. `method` is the method whose insertion or
+// deletion triggered the wave (an identifier, not a root; it is kept alive
+// by its module). Drain incrementally with a caller-held cursor that starts
+// at 0; the drain skips over entries already overwritten by newer waves.
+typedef struct {
+    uint64_t timestamp;    // jl_hrtime() when the wave completed
+    uint64_t world;        // max_world assigned to the invalidated code
+    jl_method_t *method;   // method that triggered the wave
+    uint32_t ninvalidated; // method instances invalidated by the wave
+    uint32_t maxdepth;     // longest backedge chain followed
+} jl_method_inval_event_t;
+JL_DLLEXPORT size_t jl_method_inval_log_drain(jl_method_inval_event_t *out, size_t nmax,
+                                              uint64_t *cursor) JL_NOTSAFEPOINT;
 
 
 // Windows only
@@ -1135,6 +1309,17 @@ JL_DLLEXPORT const char *jl_dlfind_win32(const char *name);
 
 // libuv wrappers:
 JL_DLLEXPORT int jl_fs_rename(const char *src_path, const char *dst_path);
+// in-kernel data transfer between descriptors (copy_file_range/sendfile,
+// with a read/write fallback inside libuv); returns bytes moved or -errno
+JL_DLLEXPORT int jl_fs_sendfile(uv_os_fd_t src_fd, uv_os_fd_t dst_fd,
+                                int64_t in_offset, size_t len);
+int jl_stat_many_uring(int n, const char **paths, uv_stat_t *bufs,
+                       int32_t *rets);
+JL_DLLEXPORT void jl_stat_many(int n, const char **paths, char *statbufs,
+                               int32_t *rets);
+// batched + memoized freshness check of a .ji's recorded source mtimes
+// (see dump.c); 1 fresh, 0 stale, -1 unknown
+JL_DLLEXPORT int jl_verify_cache_deps(const char *cachefile);
 int jl_getpid(void) JL_NOTSAFEPOINT;
 
 #ifdef SEGV_EXCEPTION
@@ -1241,6 +1426,10 @@ JL_DLLEXPORT jl_value_t *jl_flipsign_int(jl_value_t *a, jl_value_t *b);
 
 JL_DLLEXPORT jl_value_t *jl_arraylen(jl_value_t *a);
 JL_DLLEXPORT jl_value_t *jl_have_fma(jl_value_t *a);
+// bulk elementwise application of a binary intrinsic (`enum intrinsic` value)
+// over packed primitive arrays; returns 0 if `f`/`elsz` has no bulk handler
+JL_DLLEXPORT int jl_intrinsic_map_binary(unsigned f, void *dest, void *a, void *b,
+                                         size_t elsz, size_t n);
 JL_DLLEXPORT int jl_stored_inline(jl_value_t *el_type);
 JL_DLLEXPORT jl_value_t *(jl_array_data_owner)(jl_array_t *a);
 JL_DLLEXPORT int jl_array_isassigned(jl_array_t *a, size_t i);
@@ -1270,6 +1459,7 @@ void jl_smallintset_insert(_Atomic(jl_array_t*) *pcache, jl_value_t *parent, sma
 
 void jl_typemap_insert(_Atomic(jl_typemap_t*) *cache, jl_value_t *parent,
         jl_typemap_entry_t *newrec, int8_t offs);
+extern jl_array_t *jl_typemap_spares JL_GLOBALLY_ROOTED;
 jl_typemap_entry_t *jl_typemap_alloc(
         jl_tupletype_t *type, jl_tupletype_t *simpletype, jl_svec_t *guardsigs,
         jl_value_t *newvalue, size_t min_world, size_t max_world);
@@ -1461,6 +1651,7 @@ void jl_register_fptrs(uint64_t sysimage_base, const struct _jl_sysimg_fptrs_t *
                        jl_method_instance_t **linfos, size_t n);
 void jl_write_coverage_data(const char*);
 void jl_write_malloc_log(void);
+void jl_write_sysimg_page_trace(void);
 void jl_write_compiler_output(void);
 
 #if jl_has_builtin(__builtin_unreachable) || defined(_COMPILER_GCC_) || defined(_COMPILER_INTEL_)
@@ -1532,6 +1723,14 @@ uint16_t __gnu_f2h_ieee(float param) JL_NOTSAFEPOINT;
 #define JL_PROBE_GC_SWEEP_END() do ; while (0)
 #define JL_PROBE_GC_END() do ; while (0)
 #define JL_PROBE_GC_FINALIZER() do ; while (0)
+#define JL_PROBE_MT_CACHE_MISS(mt, tt) do ; while (0)
+#define JL_PROBE_MT_TYPEMAP_INSERT(parent, entry) do ; while (0)
+#define JL_PROBE_RT_TASK_SPAWN(task, tid) do ; while (0)
+#define JL_PROBE_RT_TASK_STEAL(victim_tid, thief_tid, task) do ; while (0)
+#define JL_PROBE_RT_TASK_SLEEP(tid) do ; while (0)
+#define JL_PROBE_RT_TASK_WAKE(tid) do ; while (0)
+#define JL_PROBE_JIT_COMPILE_BEGIN(method_instance) do ; while (0)
+#define JL_PROBE_JIT_COMPILE_END(method_instance) do ; while (0)
 
 #define JL_PROBE_GC_BEGIN_ENABLED() (0)
 #define JL_PROBE_GC_STOP_THE_WORLD_ENABLED() (0)
@@ -1541,6 +1740,14 @@ uint16_t __gnu_f2h_ieee(float param) JL_NOTSAFEPOINT;
 #define JL_PROBE_GC_SWEEP_END_ENABLED()  (0)
 #define JL_PROBE_GC_END_ENABLED() (0)
 #define JL_PROBE_GC_FINALIZER_ENABLED() (0)
+#define JL_PROBE_MT_CACHE_MISS_ENABLED() (0)
+#define JL_PROBE_MT_TYPEMAP_INSERT_ENABLED() (0)
+#define JL_PROBE_RT_TASK_SPAWN_ENABLED() (0)
+#define JL_PROBE_RT_TASK_STEAL_ENABLED() (0)
+#define JL_PROBE_RT_TASK_SLEEP_ENABLED() (0)
+#define JL_PROBE_RT_TASK_WAKE_ENABLED() (0)
+#define JL_PROBE_JIT_COMPILE_BEGIN_ENABLED() (0)
+#define JL_PROBE_JIT_COMPILE_END_ENABLED() (0)
 #endif
 
 #endif
@@ -17,6 +17,17 @@ extern "C" {
 // The JL_LOCK* and JL_UNLOCK* macros are no-op for non-threading build
 // while the jl_mutex_* functions are always locking and unlocking the locks.
 
+// Failed acquire attempts before a contended lock parks the thread in the
+// global parking table (threading.c) instead of burning CPU spinning.
+#define JL_MUTEX_SPIN_LIMIT 256
+
+// number of threads parked across all locks; checked on unlock (paired with
+// jl_fence, see jl_mutex_park) to decide whether a wakeup is needed
+extern JL_DLLEXPORT _Atomic(int32_t) jl_lock_nwaiters;
+JL_DLLEXPORT void jl_mutex_park(jl_mutex_t *lock, int safepoint);
+JL_DLLEXPORT void jl_mutex_wakeup(jl_mutex_t *lock) JL_NOTSAFEPOINT;
+JL_DLLEXPORT uint64_t jl_mutex_ncontended(jl_mutex_t *lock) JL_NOTSAFEPOINT;
+
 static inline void jl_mutex_wait(jl_mutex_t *lock, int safepoint)
 {
     jl_task_t *self = jl_current_task;
@@ -25,6 +36,7 @@ static inline void jl_mutex_wait(jl_mutex_t *lock, int safepoint)
         lock->count++;
         return;
     }
+    int spins = 0;
     while (1) {
         if (owner == NULL && jl_atomic_cmpswap(&lock->owner, &owner, self)) {
             lock->count = 1;
@@ -33,7 +45,10 @@ static inline void jl_mutex_wait(jl_mutex_t *lock, int safepoint)
         if (safepoint) {
             jl_gc_safepoint_(self->ptls);
         }
-        jl_cpu_pause();
+        if (++spins < JL_MUTEX_SPIN_LIMIT)
+            jl_cpu_pause();
+        else
+            jl_mutex_park(lock, safepoint);
         owner = jl_atomic_load_relaxed(&lock->owner);
     }
 }
@@ -118,6 +133,9 @@ static inline void jl_mutex_unlock_nogc(jl_mutex_t *lock) JL_NOTSAFEPOINT
     if (--lock->count == 0) {
         jl_atomic_store_release(&lock->owner, (jl_task_t*)NULL);
         jl_cpu_wake();
+        jl_fence(); // store to owner must happen-before the waiter check
+        if (__unlikely(jl_atomic_load_relaxed(&jl_lock_nwaiters) != 0))
+            jl_mutex_wakeup(lock);
     }
 #endif
 }
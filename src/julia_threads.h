@@ -32,6 +32,13 @@ JL_DLLEXPORT void jl_threading_profile(void);
 // JL_HAVE_ASYNCIFY -- task switching based on the binary asyncify transform
 // JL_HAVE_UCONTEXT -- posix standard API, requires syscall for resume
 // JL_HAVE_SIGALTSTACK -- requires several syscall for start, setjmp for resume
+//
+// JL_HAVE_ASM is the default on every unix CPU we have assembly for (x86,
+// x86_64, aarch64, arm, ppc64) and is entirely syscall-free per switch:
+// context save/restore goes through sigsetjmp(buf, 0)/siglongjmp, which with
+// a zero savemask never touches the signal mask (no sigprocmask), and task
+// entry jumps onto the new stack directly (see jl_start_fiber_set in task.c).
+// The mask-preserving ucontext path remains only where required (Windows).
 
 #ifdef _OS_WINDOWS_
 #define JL_HAVE_UCONTEXT
@@ -148,6 +155,9 @@ typedef struct {
 
     // variables for tracking "remembered set"
     arraylist_t rem_bindings;
+    // (array, card index) pairs recording dirtied 512-byte spans of old
+    // object arrays, see `jl_gc_queue_array_card`
+    arraylist_t rem_cards;
     arraylist_t _remset[2]; // contains jl_value_t*
     // lower bound of the number of pointers inside remembered values
     int remset_nptr;
@@ -164,6 +174,12 @@ typedef struct {
 #endif
     jl_gc_pool_t norm_pools[JL_GC_N_POOLS];
 
+    // cache of free pages batch-refilled from the global pagetable so the
+    // common page acquisition path does not touch the page manager lock
+#define JL_GC_PAGE_CACHE_SZ 16
+    struct _jl_gc_pagemeta_t *page_cache[JL_GC_PAGE_CACHE_SZ];
+    int page_cache_len;
+
 #define JL_N_STACK_POOLS 16
     arraylist_t free_stacks[JL_N_STACK_POOLS];
 } jl_thread_heap_t;
@@ -206,6 +222,7 @@ struct _jl_bt_element_t;
 #define JL_MAX_BT_SIZE 80000
 typedef struct _jl_tls_states_t {
     int16_t tid;
+    int16_t numa_node; // NUMA node this thread is pinned to (0 if unpinned)
     uint64_t rngseed;
     volatile size_t *safepoint;
     _Atomic(int8_t) sleep_check_state; // read/write from foreign threads
@@ -233,7 +250,16 @@ typedef struct _jl_tls_states_t {
     struct _jl_task_t *next_task;
     struct _jl_task_t *previous_task;
     struct _jl_task_t *root_task;
+    // bump-allocation arena of the running task (current_task->arena),
+    // mirrored here so the allocation fast path can find it without
+    // dereferencing the task
+    struct _jl_gc_arena_t *task_arena;
     struct _jl_timing_block_t *timing_stack;
+    // this thread's event-trace ring buffer (see timing.c), lazily allocated
+    struct _jl_trace_buf_t *trace_buf;
+    // this thread's hardware performance counters, or NULL when counting is
+    // disabled (see perf-counters.c)
+    struct _jl_perf_thread_t *perf;
     void *stackbase;
     size_t stacksize;
     union {
@@ -363,6 +389,7 @@ JL_DLLEXPORT void jl_gc_run_pending_finalizers(struct _jl_task_t *ct);
 extern JL_DLLEXPORT _Atomic(int) jl_gc_have_pending_finalizers;
 
 JL_DLLEXPORT void jl_wakeup_thread(int16_t tid);
+JL_DLLEXPORT int16_t jl_io_thread_tid(void);
 
 #ifdef __cplusplus
 }
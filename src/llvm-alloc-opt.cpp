@@ -20,6 +20,7 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Operator.h>
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/Pass.h>
 #include <llvm/Support/Debug.h>
 #include <llvm/Transforms/Utils/PromoteMemToReg.h>
@@ -58,6 +59,45 @@ static void removeGCPreserve(CallInst *call, Instruction *val)
     call->eraseFromParent();
 }
 
+// same as the helper in llvm-late-gc-lowering.cpp
+static bool isTBAA(MDNode *TBAA, std::initializer_list<const char*> const strset)
+{
+    if (!TBAA)
+        return false;
+    while (TBAA->getNumOperands() > 1) {
+        TBAA = cast<MDNode>(TBAA->getOperand(1).get());
+        auto str = cast<MDString>(TBAA->getOperand(0))->getString();
+        for (auto str2 : strset) {
+            if (str == str2) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Maximum data size for an array allocation that may be moved to the stack.
+static const size_t max_stack_array_nbytes = 1024;
+
+// Unwrap the `ConstantExpr` pointer casts codegen emits for literal runtime
+// pointers (`inttoptr`, possibly wrapped in `addrspacecast`/`bitcast`) back
+// to the session pointer they encode.
+static void *literalPointerVal(Value *v)
+{
+    while (auto CE = dyn_cast<ConstantExpr>(v)) {
+        auto opcode = CE->getOpcode();
+        if (opcode == Instruction::IntToPtr) {
+            if (auto CI = dyn_cast<ConstantInt>(CE->getOperand(0)))
+                return (void*)(uintptr_t)CI->getZExtValue();
+            return nullptr;
+        }
+        if (opcode != Instruction::BitCast && opcode != Instruction::AddrSpaceCast)
+            return nullptr;
+        v = CE->getOperand(0);
+    }
+    return nullptr;
+}
+
 static bool hasObjref(Type *ty)
 {
     if (auto ptrty = dyn_cast<PointerType>(ty))
@@ -76,6 +116,9 @@ static bool hasObjref(Type *ty)
 
 /**
  * Promote `julia.gc_alloc_obj` which do not have escaping root to a alloca.
+ * Also promotes fixed-size array allocations (`jl_alloc_array_1d` etc. with
+ * constant type and dimensions) whose object does not escape to an alloca
+ * holding both the data and a synthesized `jl_array_t` header.
  * Uses that are not considered to escape the object (i.e. heap address) includes,
  *
  * * load
@@ -147,10 +190,27 @@ private:
 
     void checkInst(Instruction *I);
 
+    // Layout of an array allocation with statically known type and dimensions,
+    // mirroring what `_new_array_` in array.c computes for inline-data arrays.
+    struct ArrayAllocInfo {
+        uint32_t ndims;
+        size_t dims[3];
+        size_t nel;
+        size_t elsz;
+        size_t tot;   // data bytes (including the trailing NUL byte for elsz == 1)
+        size_t doffs; // data offset from the start of the object
+        int zeroinit;
+        uint16_t flags; // assembled jl_array_flags_t bits
+    };
+    bool getArrayAllocInfo(CallInst *call, ArrayAllocInfo *info);
+
     void replaceIntrinsicUseWith(IntrinsicInst *call, Intrinsic::ID ID,
                                  Instruction *orig_i, Instruction *new_i);
     void removeAlloc(CallInst *orig_inst);
     void moveToStack(CallInst *orig_inst, size_t sz, bool has_ref);
+    void moveArrayToStack(CallInst *orig_inst, const ArrayAllocInfo &info);
+    void replaceUsesOnStack(CallInst *orig_inst, Instruction *new_inst, Value *tag,
+                            AllocaInst *buff, bool has_ref, bool strip_const_aa);
     void splitOnStack(CallInst *orig_inst);
     void optimizeTag(CallInst *orig_inst);
 
@@ -291,6 +351,7 @@ private:
     };
 
     SetVector<std::pair<CallInst*,size_t>> worklist;
+    SetVector<CallInst*> array_worklist;
     SmallVector<CallInst*,6> removed;
     AllocUseInfo use_info;
     CheckInst::Stack check_stack;
@@ -304,6 +365,13 @@ void Optimizer::pushInstruction(Instruction *I)
     ssize_t sz = getGCAllocSize(I);
     if (sz != -1) {
         worklist.insert(std::make_pair(cast<CallInst>(I), sz));
+        return;
+    }
+    if (auto call = dyn_cast<CallInst>(I)) {
+        ArrayAllocInfo ainfo;
+        if (getArrayAllocInfo(call, &ainfo)) {
+            array_worklist.insert(call);
+        }
     }
 }
 
@@ -363,6 +431,19 @@ void Optimizer::optimizeAll()
         // The object has no fields with mix reference access
         moveToStack(orig, sz, has_ref);
     }
+    while (!array_worklist.empty()) {
+        auto orig = array_worklist.pop_back_val();
+        ArrayAllocInfo info;
+        if (!getArrayAllocInfo(orig, &info))
+            continue;
+        checkInst(orig);
+        // The data area only ever holds bits by construction, so there are no
+        // object references the GC would need to see; anything more surprising
+        // going on with the header means we just leave the allocation alone.
+        if (use_info.escaped || use_info.refload || use_info.refstore)
+            continue;
+        moveArrayToStack(orig, info);
+    }
 }
 
 bool Optimizer::finalize()
@@ -423,6 +504,90 @@ ssize_t Optimizer::getGCAllocSize(Instruction *I)
     return -1;
 }
 
+bool Optimizer::getArrayAllocInfo(CallInst *call, ArrayAllocInfo *info)
+{
+    // In the JIT, the `ccall`s in the array constructors emit the callee as a
+    // literal pointer constant, so match it against the runtime entry points.
+    // (Under imaging mode the callee is a PLT thunk instead and we never
+    // match, keeping this a JIT-only optimization.)
+    void *fptr = literalPointerVal(call->getCalledOperand());
+    if (!fptr)
+        return false;
+    uint32_t ndims;
+    if (fptr == (void*)&jl_alloc_array_1d)
+        ndims = 1;
+    else if (fptr == (void*)&jl_alloc_array_2d)
+        ndims = 2;
+    else if (fptr == (void*)&jl_alloc_array_3d)
+        ndims = 3;
+    else
+        return false;
+    if (call->getNumArgOperands() != 1 + ndims)
+        return false;
+    auto atype = (jl_value_t*)literalPointerVal(call->getArgOperand(0));
+    if (!atype || !jl_is_array_type(atype))
+        return false;
+    jl_value_t *eltype = jl_tparam0(atype);
+    if (jl_is_uniontype(eltype))
+        return false;
+    size_t elsz = 0, al = 0;
+    if (!jl_islayout_inline(eltype, &elsz, &al))
+        return false;
+    // No object references allowed in the data area; the GC would not see
+    // them in a plain alloca.
+    if (jl_is_datatype(eltype) && (((jl_datatype_t*)eltype)->layout == NULL ||
+                                   ((jl_datatype_t*)eltype)->layout->npointers > 0))
+        return false;
+    elsz = LLT_ALIGN(elsz, al);
+    size_t nel = 1;
+    for (uint32_t i = 0; i < ndims; i++) {
+        auto CI = dyn_cast<ConstantInt>(call->getArgOperand(i + 1));
+        if (!CI)
+            return false;
+        int64_t d = CI->getSExtValue();
+        if (d < 0 || (size_t)d > max_stack_array_nbytes)
+            return false;
+        info->dims[i] = (size_t)d;
+        nel *= (size_t)d;
+        if (nel > max_stack_array_nbytes)
+            return false;
+    }
+    size_t tot = elsz * nel;
+    if (elsz == 1) {
+        // extra byte for all julia allocated byte arrays (JL_ARRAY_IMPL_NUL)
+        tot++;
+    }
+    if (tot > max_stack_array_nbytes)
+        return false;
+    // Compute the same inline data layout `_new_array_` uses.
+    size_t tsz = sizeof(jl_array_t) + jl_array_ndimwords(ndims) * sizeof(size_t);
+    if (tot >= ARRAY_CACHE_ALIGN_THRESHOLD)
+        tsz = LLT_ALIGN(tsz, JL_CACHE_BYTE_ALIGNMENT);
+    else if (elsz >= 4)
+        tsz = LLT_ALIGN(tsz, JL_SMALL_BYTE_ALIGNMENT);
+    info->ndims = ndims;
+    info->nel = nel;
+    info->elsz = elsz;
+    info->tot = tot;
+    info->doffs = tsz;
+    info->zeroinit = jl_is_datatype(eltype) && ((jl_datatype_t*)eltype)->zeroinit;
+    // This pass runs in the same process as the runtime, so assembling the
+    // flag bits through the host bitfield gives the exact runtime layout.
+    jl_array_flags_t flags;
+    memset(&flags, 0, sizeof(flags));
+    flags.how = 0;
+    flags.ndims = ndims;
+    flags.pooled = tsz + tot <= GC_MAX_SZCLASS;
+    flags.ptrarray = 0;
+    flags.hasptr = 0;
+    flags.isshared = 0;
+    flags.isaligned = 1;
+    static_assert(sizeof(jl_array_flags_t) == sizeof(uint16_t),
+                  "jl_array_flags_t is not a single 16bit word");
+    memcpy(&info->flags, &flags, sizeof(uint16_t));
+    return true;
+}
+
 std::pair<const uint32_t,Optimizer::Field>&
 Optimizer::AllocUseInfo::getField(uint32_t offset, uint32_t size, Type *elty)
 {
@@ -955,7 +1120,15 @@ void Optimizer::moveToStack(CallInst *orig_inst, size_t sz, bool has_ref)
     insertLifetime(ptr, ConstantInt::get(pass.T_int64, sz), orig_inst);
     auto new_inst = cast<Instruction>(prolog_builder.CreateBitCast(ptr, pass.T_pjlvalue));
     new_inst->takeName(orig_inst);
+    replaceUsesOnStack(orig_inst, new_inst, tag, buff, has_ref, false);
+}
 
+// Replace all uses of `orig_inst` (an allocation in the tracked address space)
+// with `new_inst` (the corresponding stack memory in addrspace 0), rewriting
+// the instructions in the use chains as needed.
+void Optimizer::replaceUsesOnStack(CallInst *orig_inst, Instruction *new_inst, Value *tag,
+                                   AllocaInst *buff, bool has_ref, bool strip_const_aa)
+{
     auto simple_replace = [&] (Instruction *orig_i, Instruction *new_i) {
         if (orig_i->user_empty()) {
             if (orig_i != orig_inst)
@@ -995,6 +1168,22 @@ void Optimizer::moveToStack(CallInst *orig_inst, size_t sz, bool has_ref)
         Instruction *new_i = cur.new_i;
         if (isa<LoadInst>(user) || isa<StoreInst>(user)) {
             user->replaceUsesOfWith(orig_i, new_i);
+            if (strip_const_aa && isa<LoadInst>(user)) {
+                // codegen tags loads of constshape array headers `tbaa_const`
+                // and `invariant.load`; the synthesized header on the alloca
+                // is filled in with plain stores, so keeping those assertions
+                // would license hoisting the loads above the initialization.
+                // (llvm-late-gc-lowering strips them too, but only after the
+                // scalar optimizations have already run on this function.)
+                user->setMetadata(LLVMContext::MD_invariant_load, NULL);
+                if (MDNode *TBAA = user->getMetadata(LLVMContext::MD_tbaa)) {
+                    if (TBAA->getNumOperands() == 4 && isTBAA(TBAA, {"jtbaa_const"})) {
+                        MDNode *MutableTBAA =
+                            MDBuilder(TBAA->getContext()).createMutableTBAAAccessTag(TBAA);
+                        user->setMetadata(LLVMContext::MD_tbaa, MutableTBAA);
+                    }
+                }
+            }
         }
         else if (auto call = dyn_cast<CallInst>(user)) {
             auto callee = call->getCalledOperand();
@@ -1071,6 +1260,70 @@ void Optimizer::moveToStack(CallInst *orig_inst, size_t sz, bool has_ref)
     }
 }
 
+// Lower a non-escaping, fixed-size array allocation to an entry block alloca
+// holding both the data and a synthesized `jl_array_t` header. The header is
+// initialized at the allocation site the same way `_new_array_` in array.c
+// fills it in for arrays with inline data, so the loads codegen emits for the
+// data pointer, sizes and flags all keep working unchanged. Like `moveToStack`
+// this must not erase any safepoint.
+void Optimizer::moveArrayToStack(CallInst *orig_inst, const ArrayAllocInfo &info)
+{
+    auto tag = orig_inst->getArgOperand(0);
+    removed.push_back(orig_inst);
+    auto &ctx = pass.getLLVMContext();
+    size_t sz = info.doffs + info.tot;
+    size_t align = info.tot >= ARRAY_CACHE_ALIGN_THRESHOLD ? JL_CACHE_BYTE_ALIGNMENT :
+        JL_SMALL_BYTE_ALIGNMENT;
+    // No debug info for prolog instructions
+    IRBuilder<> prolog_builder(&F.getEntryBlock().front());
+    AllocaInst *buff = prolog_builder.CreateAlloca(ArrayType::get(pass.T_int8, sz));
+    buff->setAlignment(Align(align));
+    auto ptr = cast<Instruction>(prolog_builder.CreateBitCast(buff, pass.T_pint8));
+    insertLifetime(ptr, ConstantInt::get(pass.T_int64, sz), orig_inst);
+    // The header fields are loop invariant, but the data pointer refers to the
+    // alloca so the stores cannot be folded into constant initialized memory;
+    // emit them at the allocation site, after the lifetime start.
+    IRBuilder<> builder(orig_inst);
+    auto store_field = [&] (size_t offset, Value *val, size_t field_align) {
+        Value *addr = builder.CreateConstInBoundsGEP1_32(pass.T_int8, ptr, offset);
+        addr = builder.CreateBitCast(addr, val->getType()->getPointerTo());
+        builder.CreateAlignedStore(val, addr, Align(field_align));
+    };
+    Value *data = builder.CreateConstInBoundsGEP1_32(pass.T_int8, ptr, info.doffs);
+    store_field(offsetof(jl_array_t, data), data, sizeof(void*));
+#ifdef STORE_ARRAY_LEN
+    store_field(offsetof(jl_array_t, length), ConstantInt::get(pass.T_size, info.nel),
+                sizeof(size_t));
+#endif
+    store_field(offsetof(jl_array_t, flags),
+                ConstantInt::get(Type::getInt16Ty(ctx), info.flags), sizeof(uint16_t));
+    store_field(offsetof(jl_array_t, elsize),
+                ConstantInt::get(Type::getInt16Ty(ctx), info.elsz), sizeof(uint16_t));
+    store_field(offsetof(jl_array_t, offset),
+                ConstantInt::get(Type::getInt32Ty(ctx), 0), sizeof(uint32_t));
+    if (info.ndims == 1) {
+        store_field(offsetof(jl_array_t, nrows), ConstantInt::get(pass.T_size, info.nel),
+                    sizeof(size_t));
+        store_field(offsetof(jl_array_t, maxsize), ConstantInt::get(pass.T_size, info.nel),
+                    sizeof(size_t));
+    }
+    else {
+        for (uint32_t i = 0; i < info.ndims; i++)
+            store_field(offsetof(jl_array_t, nrows) + i * sizeof(size_t),
+                        ConstantInt::get(pass.T_size, info.dims[i]), sizeof(size_t));
+    }
+    if (info.zeroinit && info.tot > 0)
+        builder.CreateMemSet(data, ConstantInt::get(pass.T_int8, 0), info.tot, MaybeAlign(1));
+    if (info.elsz == 1) {
+        // extra NUL byte for all julia allocated byte arrays (JL_ARRAY_IMPL_NUL)
+        Value *nul = builder.CreateConstInBoundsGEP1_32(pass.T_int8, data, info.tot - 1);
+        builder.CreateAlignedStore(ConstantInt::get(pass.T_int8, 0), nul, Align(1));
+    }
+    auto new_inst = cast<Instruction>(prolog_builder.CreateBitCast(ptr, pass.T_pjlvalue));
+    new_inst->takeName(orig_inst);
+    replaceUsesOnStack(orig_inst, new_inst, tag, nullptr, false, true);
+}
+
 // This function should not erase any safepoint so that the lifetime marker can find and cache
 // all the original safepoints.
 void Optimizer::removeAlloc(CallInst *orig_inst)
@@ -1510,9 +1763,9 @@ cleanup:
 bool AllocOpt::doInitialization(Module &M)
 {
     initAll(M);
-    if (!alloc_obj_func)
-        return false;
-
+    // Array allocations are recognized by their callee address rather than
+    // `alloc_obj_func`, so initialize even when the module allocates no
+    // objects.
     DL = &M.getDataLayout();
 
     T_int64 = Type::getInt64Ty(getLLVMContext());
@@ -1525,8 +1778,6 @@ bool AllocOpt::doInitialization(Module &M)
 
 bool AllocOpt::runOnFunction(Function &F)
 {
-    if (!alloc_obj_func)
-        return false;
     Optimizer optimizer(F, *this);
     optimizer.initialize();
     optimizer.optimizeAll();
@@ -6,10 +6,13 @@
 #include <llvm/Analysis/LoopPass.h>
 #include "llvm/Analysis/LoopIterator.h"
 #include <llvm/IR/Dominators.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/Transforms/Utils/LoopUtils.h>
 
 #include "llvm-pass-helpers.h"
+#include "codegen_shared.h"
 #include "julia.h"
 
 #define DEBUG_TYPE "julia-licm"
@@ -21,10 +24,83 @@ using namespace llvm;
  * This takes care of some julia intrinsics that is safe to move around/out of loops but
  * can't be handled by LLVM's LICM. These intrinsics can be moved outside of
  * loop context as well but it is inside a loop where they matter the most.
+ * In addition to the preserve intrinsics this hoists loop-invariant
+ * `julia.gc_alloc_obj` calls, reusing a single object across iterations when
+ * no reference to it survives an iteration, and sinks allocations into the
+ * conditional block that uses them.
  */
 
 namespace {
 
+static bool hasObjref(Type *ty)
+{
+    if (auto ptrty = dyn_cast<PointerType>(ty))
+        return ptrty->getAddressSpace() == AddressSpace::Tracked;
+    if (isa<ArrayType>(ty) || isa<VectorType>(ty))
+        return hasObjref(GetElementPtrInst::getTypeAtIndex(ty, (uint64_t)0));
+    if (auto structty = dyn_cast<StructType>(ty)) {
+        for (auto elty: structty->elements()) {
+            if (hasObjref(elty)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Check that one object can be reused for `alloc` across loop iterations:
+// every transitive use must stay inside the loop and be a load, a store of a
+// bits value into the object, a pointer cast/GEP (scanned recursively), or a
+// julia intrinsic that does not capture the address. Phi and select uses are
+// rejected since they could carry a reference from one iteration to the
+// next. Stores of object references are rejected as well: codegen elides the
+// write barrier when storing a boxed value into a freshly allocated object,
+// and hoisting the allocation across the backedge (and thus across
+// safepoints) would invalidate that.
+static bool allocCanBeReused(CallInst *alloc, Loop *L, JuliaPassContext &jctx)
+{
+    SmallVector<Instruction*, 16> worklist{alloc};
+    SmallSet<Instruction*, 16> seen;
+    while (!worklist.empty()) {
+        auto cur = worklist.pop_back_val();
+        for (Use &U: cur->uses()) {
+            auto user = dyn_cast<Instruction>(U.getUser());
+            if (!user || !L->contains(user))
+                return false;
+            if (isa<LoadInst>(user))
+                continue;
+            if (auto store = dyn_cast<StoreInst>(user)) {
+                if (U.getOperandNo() != StoreInst::getPointerOperandIndex())
+                    return false;
+                if (hasObjref(store->getValueOperand()->getType()))
+                    return false;
+                continue;
+            }
+            if (isa<BitCastInst>(user) || isa<AddrSpaceCastInst>(user) ||
+                isa<GetElementPtrInst>(user)) {
+                if (seen.insert(user).second)
+                    worklist.push_back(user);
+                continue;
+            }
+            if (auto call = dyn_cast<CallInst>(user)) {
+                auto callee = call->getCalledOperand();
+                if (callee && (callee == jctx.write_barrier_func ||
+                               callee == jctx.typeof_func))
+                    continue;
+                if (auto II = dyn_cast<IntrinsicInst>(call)) {
+                    if (II->getIntrinsicID() == Intrinsic::lifetime_start ||
+                        II->getIntrinsicID() == Intrinsic::lifetime_end ||
+                        isa<DbgInfoIntrinsic>(II))
+                        continue;
+                }
+                return false;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
 struct JuliaLICMPass : public LoopPass, public JuliaPassContext {
     static char ID;
     JuliaLICMPass() : LoopPass(ID) {};
@@ -38,10 +114,10 @@ struct JuliaLICMPass : public LoopPass, public JuliaPassContext {
             return false;
         BasicBlock *header = L->getHeader();
         initFunctions(*header->getModule());
-        // Also require `gc_preserve_begin_func` whereas
+        // Require `gc_preserve_begin_func` or `alloc_obj_func`;
         // `gc_preserve_end_func` is optional since the input to
         // `gc_preserve_end_func` must be from `gc_preserve_begin_func`.
-        if (!gc_preserve_begin_func)
+        if (!gc_preserve_begin_func && !alloc_obj_func)
             return false;
         auto LI = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
         auto DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
@@ -112,6 +188,65 @@ struct JuliaLICMPass : public LoopPass, public JuliaPassContext {
                         CallInst::Create(call, {}, exit_pts[i]);
                     }
                 }
+                else if (alloc_obj_func && callee == alloc_obj_func) {
+                    BasicBlock *latch = L->getLoopLatch();
+                    if (!latch)
+                        continue;
+                    bool invariant_args = true;
+                    for (Use &U : call->arg_operands()) {
+                        auto origin = dyn_cast<Instruction>(U.get());
+                        if (!origin)
+                            continue;
+                        if (!DT->properlyDominates(origin->getParent(), header)) {
+                            invariant_args = false;
+                            break;
+                        }
+                    }
+                    // Hoist the allocation and reuse one object across
+                    // iterations when it is allocated every iteration anyway
+                    // and no reference to it survives an iteration. Reads of
+                    // fields that were not yet stored to in the current
+                    // iteration see the previous iteration's values instead
+                    // of fresh memory, which only refines undef.
+                    if (invariant_args && DT->dominates(call->getParent(), latch) &&
+                        allocCanBeReused(call, L, *this)) {
+                        call->moveBefore(preheader->getTerminator());
+                        changed = true;
+                        continue;
+                    }
+                    // Otherwise, sink an unconditional allocation into the
+                    // conditional block that uses it, so iterations that do
+                    // not take that path do not pay for the allocation.
+                    BasicBlock *target = nullptr;
+                    bool sinkable = true;
+                    for (auto user: call->users()) {
+                        auto I = dyn_cast<Instruction>(user);
+                        if (!I || (target && I->getParent() != target)) {
+                            sinkable = false;
+                            break;
+                        }
+                        target = I->getParent();
+                    }
+                    if (!sinkable || !target || target == call->getParent() ||
+                        !L->contains(target) || !DT->dominates(call->getParent(), target) ||
+                        !DT->dominates(call->getParent(), latch) ||
+                        DT->dominates(target, latch))
+                        continue;
+                    Instruction *first_user = nullptr;
+                    for (auto &I: *target) {
+                        for (Use &U: I.operands()) {
+                            if (U.get() == call) {
+                                first_user = &I;
+                                break;
+                            }
+                        }
+                        if (first_user)
+                            break;
+                    }
+                    assert(first_user);
+                    call->moveBefore(first_user);
+                    changed = true;
+                }
             }
         }
         return changed;
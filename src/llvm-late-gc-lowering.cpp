@@ -356,7 +356,7 @@ private:
     void NoteUseChain(State &S, BBState &BBS, User *TheUser);
     SmallVector<int, 1> GetPHIRefinements(PHINode *phi, State &S);
     void FixUpRefinements(ArrayRef<int> PHINumbers, State &S);
-    void RefineLiveSet(BitVector &LS, State &S, const std::vector<int> &CalleeRoots);
+    void RefineLiveSet(BitVector &LS, State &S, Instruction *Safepoint, const std::vector<int> &CalleeRoots);
     Value *EmitTagPtr(IRBuilder<> &builder, Type *T, Value *V);
     Value *EmitLoadTag(IRBuilder<> &builder, Value *V);
 };
@@ -1915,7 +1915,7 @@ JL_USED_FUNC static void dumpSafepointsForBBName(Function &F, State &S, const ch
     }
 }
 
-void LateLowerGCFrame::RefineLiveSet(BitVector &LS, State &S, const std::vector<int> &CalleeRoots)
+void LateLowerGCFrame::RefineLiveSet(BitVector &LS, State &S, Instruction *Safepoint, const std::vector<int> &CalleeRoots)
 {
     BitVector FullLS(S.MaxPtrNumber + 1, false);
     FullLS |= LS;
@@ -1967,6 +1967,42 @@ void LateLowerGCFrame::RefineLiveSet(BitVector &LS, State &S, const std::vector<
             LS[Idx] = 0;
         }
     }
+    // A value whose only refinement target is dead at this safepoint still
+    // needs a root of its own even though rooting the base it was derived
+    // from (e.g. the immutable object it was loaded from) would keep it alive
+    // just as well. When several live values share such a base, root the base
+    // instead and drop all of them from the live set, so a single frame slot
+    // replaces one per derived value. The base's frame store is emitted right
+    // before this safepoint by `PlaceGCFrameStores`, which only requires that
+    // the base's definition dominates it. The GC does not move objects, so
+    // the dropped SSA values themselves remain valid without re-deriving
+    // them after the safepoint.
+    std::map<int, SmallVector<int, 2>> RematBases;
+    for (int Idx = LS.find_first(); Idx >= 0; Idx = LS.find_next(Idx)) {
+        auto it = S.Refinements.find(Idx);
+        if (it == S.Refinements.end() || it->second.size() != 1)
+            continue;
+        int Base = it->second[0];
+        if (Base < 0 || HasBitSet(FullLS, Base))
+            continue; // live bases were already handled by the loop above
+        RematBases[Base].push_back(Idx);
+    }
+    for (auto &kv: RematBases) {
+        // Rooting the base costs one slot itself; this only pays off when it
+        // releases at least two dependent values.
+        if (kv.second.size() < 2)
+            continue;
+        int Base = kv.first;
+        if (auto BI = dyn_cast<Instruction>(S.ReversePtrNumbering[Base])) {
+            if (!S.DT)
+                S.DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+            if (!S.DT->dominates(BI, Safepoint))
+                continue;
+        }
+        LS[Base] = 1;
+        for (auto Idx: kv.second)
+            LS[Idx] = 0;
+    }
     for (auto Num: CalleeRoots) {
         // Now unmark all values that are rooted by the callee after
         // refining other values to them.
@@ -1990,7 +2026,7 @@ void LateLowerGCFrame::ComputeLiveSets(State &S) {
             if (HasBitSet(BBS.LiveOut, Live))
                 LS[Live] = 1;
         }
-        RefineLiveSet(LS, S, S.CalleeRoots[idx]);
+        RefineLiveSet(LS, S, Safepoint, S.CalleeRoots[idx]);
         // If the function has GC preserves, figure out whether we need to
         // add in any extra live values.
         if (!S.GCPreserves.empty()) {
@@ -20,6 +20,7 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/Analysis/LoopInfo.h>
 #include <llvm/Analysis/CallGraph.h>
+#include <llvm/Support/MathExtras.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/DebugInfoMetadata.h>
@@ -30,6 +31,7 @@
 #include "processor.h"
 #include "support/dtypes.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
@@ -46,6 +48,18 @@ namespace {
 constexpr uint32_t clone_mask =
     JL_TARGET_CLONE_LOOP | JL_TARGET_CLONE_SIMD | JL_TARGET_CLONE_MATH | JL_TARGET_CLONE_CPU;
 
+// Per-target budget on partial cloning, in IR instructions
+// (JULIA_CLONE_BUDGET); 0 or unset clones every flagged function as before.
+static uint32_t clone_budget(void)
+{
+    static int budget = -1;
+    if (budget == -1) {
+        const char *env = getenv(CLONE_BUDGET_NAME);
+        budget = env ? atoi(env) : 0;
+    }
+    return budget < 0 ? 0 : (uint32_t)budget;
+}
+
 struct MultiVersioning;
 
 // Treat identical mapping as missing and return `def` in that case.
@@ -542,9 +556,34 @@ void CloneCtx::check_partial(Group &grp, Target &tgt)
 
     std::set<Function*> all_origs;
     // Use a simple heuristic to decide which function we need to clone.
+    std::vector<uint32_t> candidates;
     for (uint32_t i = 0; i < nfuncs; i++) {
-        if (!(func_infos[i] & flag))
-            continue;
+        if (func_infos[i] & flag)
+            candidates.push_back(i);
+    }
+    if (uint32_t budget = clone_budget()) {
+        // Prefer functions with more reasons to clone, then smaller bodies, so
+        // the budget buys as many profitable clones as possible. The caller
+        // expansion below may still exceed the budget slightly; it only pulls
+        // in what is needed to keep dispatch off the cloned call paths.
+        std::stable_sort(candidates.begin(), candidates.end(), [&] (uint32_t a, uint32_t b) {
+            unsigned na = countPopulation(func_infos[a] & flag);
+            unsigned nb = countPopulation(func_infos[b] & flag);
+            if (na != nb)
+                return na > nb;
+            return orig_funcs[a]->getInstructionCount() <
+                orig_funcs[b]->getInstructionCount();
+        });
+        uint32_t total = 0;
+        uint32_t nsel = 0;
+        for (; nsel < candidates.size(); nsel++) {
+            total += orig_funcs[candidates[nsel]]->getInstructionCount();
+            if (total > budget)
+                break;
+        }
+        candidates.resize(nsel);
+    }
+    for (uint32_t i: candidates) {
         auto orig_f = orig_funcs[i];
         // Fill in old->new mapping. We need to do this before cloning the function so that
         // the intra target calls are automatically fixed up on cloning.
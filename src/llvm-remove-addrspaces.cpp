@@ -2,6 +2,7 @@
 
 #include "llvm-version.h"
 
+#include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/IR/Constants.h>
@@ -42,6 +43,14 @@ public:
         if (DstTy)
             return DstTy;
 
+        // Types that don't mention a remapped address space map to themselves;
+        // in particular this keeps named structs (and everything referring to
+        // them) their identity instead of cloning the whole type graph.
+        if (!typeNeedsRemap(SrcTy)) {
+            MappedTypes[SrcTy] = SrcTy;
+            return SrcTy;
+        }
+
         DstTy = SrcTy;
         if (auto Ty = dyn_cast<PointerType>(SrcTy))
             DstTy = PointerType::get(
@@ -104,7 +113,39 @@ public:
         return DstTy;
     }
 
+    // Pure check (no new types created): does `Ty` transitively contain a
+    // pointer whose address space gets remapped?
+    bool typeNeedsRemap(Type *Ty)
+    {
+        auto It = NeedsRemap.find(Ty);
+        if (It != NeedsRemap.end())
+            return It->second;
+        SmallPtrSet<Type *, 8> Visited;
+        bool Res = typeNeedsRemap(Ty, Visited);
+        NeedsRemap[Ty] = Res;
+        return Res;
+    }
+
 private:
+    bool typeNeedsRemap(Type *Ty, SmallPtrSetImpl<Type *> &Visited)
+    {
+        auto It = NeedsRemap.find(Ty);
+        if (It != NeedsRemap.end())
+            return It->second;
+        // Break self-referential struct cycles; if the remap need comes from
+        // elsewhere in the cycle, the outer query still finds it.
+        if (!Visited.insert(Ty).second)
+            return false;
+        if (auto PTy = dyn_cast<PointerType>(Ty))
+            if (ASRemapper(PTy->getAddressSpace()) != PTy->getAddressSpace())
+                return true;
+        for (Type *SubTy : Ty->subtypes())
+            if (typeNeedsRemap(SubTy, Visited))
+                return true;
+        return false;
+    }
+
+    DenseMap<Type *, bool> NeedsRemap;
     static DenseMap<Type *, Type *> MappedTypes;
 };
 
@@ -249,12 +290,101 @@ bool RemoveAddrspacesPass::runOnModule(Module &M)
     AddrspaceRemoveValueMaterializer Materializer(
             VMap, RF_None, &TypeRemapper);
 
-    // Loop over all of the global variables, creating versions without address
-    // spaces. We only add the new globals to the VMap, attributes and
-    // initializers come later.
+    // Decide which globals actually need rewriting: anything whose type (or
+    // body, or initializer) mentions a remapped address space, plus
+    // transitively everything referencing such a global since the rewrite
+    // gives it a new identity. Everything else is left in place, so the peak
+    // memory of this pass is proportional to the affected subset of the
+    // module, not to the whole module.
+    SmallPtrSet<const GlobalValue *, 16> Changed;
+    std::vector<GlobalValue *> Worklist;
+    auto markChanged = [&] (GlobalValue *GV) {
+        if (Changed.insert(GV).second)
+            Worklist.push_back(GV);
+    };
+    auto constantNeedsRemap = [&] (Constant *C) {
+        SmallVector<Constant *, 8> Stack{C};
+        SmallPtrSet<Constant *, 8> Visited;
+        while (!Stack.empty()) {
+            Constant *Cur = Stack.pop_back_val();
+            if (!Visited.insert(Cur).second)
+                continue;
+            if (TypeRemapper.typeNeedsRemap(Cur->getType()))
+                return true;
+            if (isa<GlobalValue>(Cur))
+                continue; // handled by use propagation below
+            for (Value *Op : Cur->operands())
+                if (auto COp = dyn_cast<Constant>(Op))
+                    Stack.push_back(COp);
+        }
+        return false;
+    };
+    for (GlobalVariable &GV : M.globals())
+        if (TypeRemapper.typeNeedsRemap(GV.getValueType()) ||
+            (GV.hasInitializer() && constantNeedsRemap(GV.getInitializer())))
+            markChanged(&GV);
+    for (GlobalAlias &GA : M.aliases())
+        if (TypeRemapper.typeNeedsRemap(GA.getValueType()) ||
+            (GA.getAliasee() && constantNeedsRemap(GA.getAliasee())))
+            markChanged(&GA);
+    for (Function &F : M) {
+        bool Needs = TypeRemapper.typeNeedsRemap(F.getFunctionType());
+        for (auto II = inst_begin(F), IE = inst_end(F); !Needs && II != IE; ++II) {
+            if (TypeRemapper.typeNeedsRemap(II->getType())) {
+                Needs = true;
+                break;
+            }
+            for (Value *Op : II->operands()) {
+                if (auto C = dyn_cast<Constant>(Op)) {
+                    if (!isa<GlobalValue>(C) && constantNeedsRemap(C)) {
+                        Needs = true;
+                        break;
+                    }
+                }
+                else if (TypeRemapper.typeNeedsRemap(Op->getType())) {
+                    Needs = true;
+                    break;
+                }
+            }
+        }
+        if (Needs)
+            markChanged(&F);
+    }
+    while (!Worklist.empty()) {
+        GlobalValue *GV = Worklist.back();
+        Worklist.pop_back();
+        SmallPtrSet<User *, 8> Visited;
+        std::vector<User *> Users(GV->user_begin(), GV->user_end());
+        while (!Users.empty()) {
+            User *U = Users.back();
+            Users.pop_back();
+            if (!Visited.insert(U).second)
+                continue;
+            if (auto I = dyn_cast<Instruction>(U)) {
+                if (I->getFunction())
+                    markChanged(I->getFunction());
+            }
+            else if (auto G = dyn_cast<GlobalValue>(U)) {
+                markChanged(G);
+            }
+            else {
+                // look through constant expressions to their users
+                for (User *UU : U->users())
+                    Users.push_back(UU);
+            }
+        }
+    }
+    if (Changed.empty())
+        return false;
+
+    // Loop over the affected global variables, creating versions without
+    // address spaces. We only add the new globals to the VMap, attributes and
+    // initializers come later. Untouched globals map to themselves (the
+    // identity default of MapValue).
     SmallVector<GlobalVariable *, 4> Globals;
     for (auto &GV : M.globals())
-        Globals.push_back(&GV);
+        if (Changed.count(&GV))
+            Globals.push_back(&GV);
     for (auto &GV : Globals) {
         std::string Name;
         if (GV->hasName()) {
@@ -278,10 +408,11 @@ bool RemoveAddrspacesPass::runOnModule(Module &M)
         VMap[GV] = NGV;
     }
 
-    // Loop over the aliases in the module.
+    // Loop over the affected aliases in the module.
     SmallVector<GlobalAlias *, 4> Aliases;
     for (auto &GA : M.aliases())
-        Aliases.push_back(&GA);
+        if (Changed.count(&GA))
+            Aliases.push_back(&GA);
     for (auto &GA : Aliases) {
         std::string Name;
         if (GA->hasName()) {
@@ -301,10 +432,11 @@ bool RemoveAddrspacesPass::runOnModule(Module &M)
         VMap[GA] = NGA;
     }
 
-    // Loop over the functions in the module, creating new ones as before.
+    // Loop over the affected functions in the module, creating new ones as before.
     SmallVector<Function *, 4> Functions;
     for (Function &F : M)
-        Functions.push_back(&F);
+        if (Changed.count(&F))
+            Functions.push_back(&F);
     for (Function *F : Functions) {
         std::string Name;
         if (F->hasName()) {
@@ -10,6 +10,11 @@
 //    floating-point operations as fast-math. `See enableUnsafeAlgebraIfReduction`.
 // 3. If the metadata contains `julia.ivdep` marks all memory accesses in the loop
 //    as independent of each other.
+// 4. If the metadata contains `julia.simdsearch` and the loop matches a simple
+//    findfirst-style search (load an element, compare, exit the loop on a hit),
+//    emits a speculative vector preloop that scans a full vector block per
+//    iteration and breaks to the scalar loop to recompute the exact index as
+//    soon as any lane matches. See `vectorizeEarlyExitSearch`.
 //
 // The pass hinges on a call to a marker function that has metadata attached to it.
 // To construct the pass call `createLowerSimdLoopPass`.
@@ -20,6 +25,7 @@
 #include <llvm-c/Types.h>
 
 #include <llvm/Analysis/LoopPass.h>
+#include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/LLVMContext.h>
@@ -105,7 +111,168 @@ static void enableUnsafeAlgebraIfReduction(PHINode *Phi, Loop *L)
     }
 }
 
-static bool markLoopInfo(Module &M, Function *marker, function_ref<LoopInfo &(Function &)> GetLI)
+/// Speculatively vectorize a findfirst/any-style search loop of the form
+///
+///   header:                                   ; preds: preheader, latch
+///     %i = phi i64 [ %start, %preheader ], [ %i.next, %latch ]
+///     %p = getelementptr T, T* %base, i64 %i
+///     %x = load T, T* %p
+///     %c = {i,f}cmp pred %x, %needle
+///     br i1 %c, label %found, label %latch    ; (or with successors swapped)
+///   latch:
+///     %i.next = add i64 %i, 1
+///     %cond = icmp {slt,ult,ne} %i.next, %n
+///     br i1 %cond, label %header, label %notfound
+///
+/// by inserting a preloop that loads and compares a full vector block per
+/// iteration and breaks to the unmodified scalar loop as soon as any lane
+/// matches (resuming at the start of the block, so the scalar loop recomputes
+/// the exact hit index) or fewer than a full block remains. The vector loads
+/// touch up to a block of elements beyond the one the scalar loop would have
+/// stopped at; the `julia.simdsearch` annotation is the user's assertion that
+/// the whole range is dereferenceable, much like `julia.ivdep` asserts the
+/// absence of memory dependencies.
+static bool vectorizeEarlyExitSearch(Loop *L)
+{
+    BasicBlock *preheader = L->getLoopPreheader();
+    BasicBlock *Lh = L->getHeader();
+    BasicBlock *latch = L->getLoopLatch();
+    if (!preheader || !latch || latch == Lh || L->getNumBlocks() != 2)
+        return false;
+    // Match the header: induction phi, gep, load, compare, early-exit branch.
+    auto it = Lh->begin();
+    PHINode *iv = dyn_cast<PHINode>(&*it);
+    if (!iv || !iv->getType()->isIntegerTy() || iv->getNumIncomingValues() != 2)
+        return false;
+    ++it;
+    auto gep = dyn_cast<GetElementPtrInst>(&*it);
+    if (!gep || gep->getNumIndices() != 1 || gep->getOperand(1) != iv)
+        return false;
+    Value *base = gep->getPointerOperand();
+    if (auto basei = dyn_cast<Instruction>(base))
+        if (L->contains(basei))
+            return false;
+    ++it;
+    auto load = dyn_cast<LoadInst>(&*it);
+    if (!load || load->getPointerOperand() != gep || !load->isSimple())
+        return false;
+    Type *elty = load->getType();
+    if (gep->getSourceElementType() != elty)
+        return false;
+    unsigned elbits = elty->getPrimitiveSizeInBits();
+    if (!(elty->isIntegerTy() || elty->isFloatingPointTy()) ||
+        (elbits != 8 && elbits != 16 && elbits != 32 && elbits != 64))
+        return false;
+    ++it;
+    auto cmp = dyn_cast<CmpInst>(&*it);
+    if (!cmp || (cmp->getOperand(0) != load && cmp->getOperand(1) != load))
+        return false;
+    Value *needle = cmp->getOperand(cmp->getOperand(0) == load ? 1 : 0);
+    if (auto ni = dyn_cast<Instruction>(needle))
+        if (L->contains(ni))
+            return false;
+    ++it;
+    auto hbr = dyn_cast<BranchInst>(&*it);
+    if (!hbr || ++it != Lh->end() || !hbr->isConditional() ||
+        hbr->getCondition() != cmp)
+        return false;
+    bool hit_on_true = hbr->getSuccessor(0) != latch;
+    BasicBlock *found = hbr->getSuccessor(hit_on_true ? 0 : 1);
+    if (hbr->getSuccessor(hit_on_true ? 1 : 0) != latch || L->contains(found))
+        return false;
+    // Match the latch: unit-step increment and the counted exit.
+    auto lit = latch->begin();
+    auto step = dyn_cast<BinaryOperator>(&*lit);
+    if (!step || step->getOpcode() != Instruction::Add)
+        return false;
+    auto stepc = dyn_cast<ConstantInt>(step->getOperand(step->getOperand(0) == iv ? 1 : 0));
+    if (step->getOperand(step->getOperand(0) == iv ? 0 : 1) != iv ||
+        !stepc || !stepc->isOne())
+        return false;
+    ++lit;
+    auto bound = dyn_cast<ICmpInst>(&*lit);
+    if (!bound || bound->getOperand(0) != step)
+        return false;
+    ICmpInst::Predicate pred = bound->getPredicate();
+    if (pred != ICmpInst::ICMP_SLT && pred != ICmpInst::ICMP_ULT &&
+        pred != ICmpInst::ICMP_NE)
+        return false;
+    Value *n = bound->getOperand(1);
+    if (auto ni = dyn_cast<Instruction>(n))
+        if (L->contains(ni))
+            return false;
+    ++lit;
+    auto lbr = dyn_cast<BranchInst>(&*lit);
+    if (!lbr || ++lit != latch->end() || !lbr->isConditional() ||
+        lbr->getCondition() != bound || lbr->getSuccessor(0) != Lh)
+        return false;
+    if (iv->getIncomingValueForBlock(latch) != step)
+        return false;
+
+    LLVM_DEBUG(dbgs() << "LSL: vectorizing search loop on " << *elty << "\n");
+    LLVMContext &ctx = Lh->getContext();
+    Function *F = Lh->getParent();
+    Value *start = iv->getIncomingValueForBlock(preheader);
+    Type *ivty = iv->getType();
+    // Process one 128-bit block per iteration; wider ISAs can still unroll
+    // and fuse these, and 128 bits keeps the mask test cheap everywhere.
+    unsigned VF = 128 / elbits;
+    auto vecty = FixedVectorType::get(elty, VF);
+    auto maskty = IntegerType::get(ctx, VF);
+    Constant *vfc = ConstantInt::get(ivty, VF);
+    ICmpInst::Predicate gepred =
+        pred == ICmpInst::ICMP_SLT ? ICmpInst::ICMP_SGE : ICmpInst::ICMP_UGE;
+
+    BasicBlock *guard = BasicBlock::Create(ctx, "searchvec.guard", F, Lh);
+    BasicBlock *vecbody = BasicBlock::Create(ctx, "searchvec.body", F, Lh);
+    BasicBlock *resume = BasicBlock::Create(ctx, "searchvec.resume", F, Lh);
+    preheader->getTerminator()->replaceSuccessorWith(Lh, guard);
+
+    // Enter the vector loop only when at least one full block remains.
+    IRBuilder<> builder(guard);
+    Value *nonempty = builder.CreateICmp(pred, start, n);
+    Value *len = builder.CreateSub(n, start);
+    Value *haveblock = builder.CreateICmp(gepred, len, vfc);
+    builder.CreateCondBr(builder.CreateAnd(nonempty, haveblock), vecbody, Lh);
+
+    builder.SetInsertPoint(vecbody);
+    PHINode *viv = builder.CreatePHI(ivty, 2, "searchvec.iv");
+    viv->addIncoming(start, guard);
+    Value *vgep = gep->isInBounds() ?
+        builder.CreateInBoundsGEP(elty, base, viv) :
+        builder.CreateGEP(elty, base, viv);
+    unsigned AS = cast<PointerType>(gep->getType())->getAddressSpace();
+    Value *vptr = builder.CreateBitCast(vgep, PointerType::get(vecty, AS));
+    LoadInst *vload = builder.CreateAlignedLoad(vecty, vptr, load->getAlign());
+    vload->setMetadata(LLVMContext::MD_tbaa,
+                       load->getMetadata(LLVMContext::MD_tbaa));
+    Value *splat = builder.CreateVectorSplat(VF, needle);
+    Value *lhs = cmp->getOperand(0) == load ? vload : splat;
+    Value *rhs = cmp->getOperand(0) == load ? splat : vload;
+    Value *vcmp = isa<FCmpInst>(cmp) ?
+        builder.CreateFCmp(cmp->getPredicate(), lhs, rhs) :
+        builder.CreateICmp(cmp->getPredicate(), lhs, rhs);
+    // Some lane takes the found edge iff the mask is not all-miss.
+    Value *bits = builder.CreateBitCast(vcmp, maskty);
+    Value *any = builder.CreateICmpNE(bits, hit_on_true ?
+        ConstantInt::get(maskty, 0) : Constant::getAllOnesValue(maskty));
+    Value *vivnext = builder.CreateAdd(viv, vfc, "searchvec.iv.next");
+    Value *rem = builder.CreateSub(n, vivnext);
+    Value *more = builder.CreateICmp(gepred, rem, vfc);
+    Value *cont = builder.CreateAnd(builder.CreateNot(any), more);
+    // On a hit, rescan the current block scalarly to get the exact index.
+    Value *residx = builder.CreateSelect(any, viv, vivnext, "searchvec.resume.idx");
+    builder.CreateCondBr(cont, vecbody, resume);
+    viv->addIncoming(vivnext, vecbody);
+
+    builder.SetInsertPoint(resume);
+    builder.CreateBr(Lh);
+    iv->replaceIncomingBlockWith(preheader, guard);
+    iv->addIncoming(residx, resume);
+    return true;
+}
+
+static bool markLoopInfo(Module &M, Function *marker, function_ref<LoopInfo &(Function &)> GetLI, bool &CFGChanged)
 {
     bool Changed = false;
     std::vector<Instruction*> ToDelete;
@@ -122,6 +289,7 @@ static bool markLoopInfo(Module &M, Function *marker, function_ref<LoopInfo &(Fu
         LLVM_DEBUG(dbgs() << "LSL: loopinfo marker found\n");
         bool simd = false;
         bool ivdep = false;
+        bool search = false;
         SmallVector<Metadata *, 8> MDs;
 
         BasicBlock *Lh = L->getHeader();
@@ -146,6 +314,8 @@ static bool markLoopInfo(Module &M, Function *marker, function_ref<LoopInfo &(Fu
                                 simd = true;
                             if (S->getString().equals("julia.ivdep"))
                                 ivdep = true;
+                            if (S->getString().equals("julia.simdsearch"))
+                                search = true;
                             continue;
                         }
                     }
@@ -154,7 +324,7 @@ static bool markLoopInfo(Module &M, Function *marker, function_ref<LoopInfo &(Fu
             }
         }
 
-        LLVM_DEBUG(dbgs() << "LSL: simd: " << simd << " ivdep: " << ivdep << "\n");
+        LLVM_DEBUG(dbgs() << "LSL: simd: " << simd << " ivdep: " << ivdep << " search: " << search << "\n");
 
         MDNode *n = L->getLoopID();
         if (n) {
@@ -197,6 +367,13 @@ static bool markLoopInfo(Module &M, Function *marker, function_ref<LoopInfo &(Fu
             }
         }
 
+        if (search) {
+            if (vectorizeEarlyExitSearch(L))
+                CFGChanged = true;
+            else
+                LLVM_DEBUG(dbgs() << "LSL: loop did not match the search idiom\n");
+        }
+
         Changed = true;
     }
 
@@ -232,9 +409,10 @@ PreservedAnalyses LowerSIMDLoop::run(Module &M, ModuleAnalysisManager &AM)
         return FAM.getResult<LoopAnalysis>(F);
     };
 
-    markLoopInfo(M, loopinfo_marker, GetLI);
+    bool CFGChanged = false;
+    markLoopInfo(M, loopinfo_marker, GetLI, CFGChanged);
 
-    return PreservedAnalyses::all();
+    return CFGChanged ? PreservedAnalyses::none() : PreservedAnalyses::all();
 }
 
 namespace {
@@ -256,18 +434,19 @@ public:
         return getAnalysis<LoopInfoWrapperPass>(F).getLoopInfo();
     };
 
+    bool CFGChanged = false;
     if (loopinfo_marker)
-        Changed |= markLoopInfo(M, loopinfo_marker, GetLI);
+        Changed |= markLoopInfo(M, loopinfo_marker, GetLI, CFGChanged);
 
     return Changed;
   }
 
   void getAnalysisUsage(AnalysisUsage &AU) const override
   {
+      // `vectorizeEarlyExitSearch` inserts new blocks and loops,
+      // so neither the CFG nor LoopInfo can be marked preserved.
       ModulePass::getAnalysisUsage(AU);
       AU.addRequired<LoopInfoWrapperPass>();
-      AU.addPreserved<LoopInfoWrapperPass>();
-      AU.setPreservesCFG();
   }
 };
 
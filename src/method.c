@@ -896,7 +896,9 @@ JL_DLLEXPORT jl_method_t* jl_method_def(jl_svec_t *argdata,
     if ((jl_value_t*)mt == jl_nothing)
         jl_error("Method dispatch is unimplemented currently for this method signature");
     if (mt->frozen)
-        jl_error("cannot add methods to a builtin function");
+        jl_error(mt->frozen == JL_MT_FROZEN_BUILTIN ?
+                 "cannot add methods to a builtin function" :
+                 "cannot add methods to a sealed method table");
 
     // TODO: derive our debug name from the syntax instead of the type
     name = mt->name;
@@ -36,6 +36,7 @@ JL_DLLEXPORT jl_module_t *jl_new_module_(jl_sym_t *name, uint8_t default_names)
     m->max_methods = -1;
     JL_MUTEX_INIT(&m->lock);
     htable_new(&m->bindings, 0);
+    jl_atomic_store_relaxed(&m->bindingcache, NULL);
     arraylist_new(&m->usings, 0);
     JL_GC_PUSH1(&m);
     if (jl_core_module && default_names) {
@@ -74,6 +75,31 @@ JL_DLLEXPORT jl_value_t *jl_f_new_module(jl_sym_t *name, uint8_t std_imports, ui
     return (jl_value_t*)m;
 }
 
+// Pre-size a module's bindings table for `nb` expected bindings, so a
+// deserializer about to replay a known number of bindings rehashes at most
+// once up front instead of growing the table incrementally.
+void jl_module_presize_bindings(jl_module_t *m, size_t nb)
+{
+    if (nb <= HT_N_INLINE / 2)
+        return; // would stay in the inline space; nothing to re-size
+    JL_LOCK(&m->lock);
+    htable_t fresh;
+    htable_new(&fresh, nb);
+    // `fresh` is heap-allocated (nb is above the inline threshold), so its
+    // probe arrays can be handed over to `m` by pointer
+    assert(fresh.table != &fresh._space[0]);
+    htable_t *old = &m->bindings;
+    for (size_t i = 0; i < old->size; i += 2) {
+        if (old->table[i + 1] != HT_NOTFOUND)
+            ptrhash_put(&fresh, old->table[i], old->table[i + 1]);
+    }
+    htable_free(old);
+    old->size = fresh.size;
+    old->table = fresh.table;
+    old->ctrl = fresh.ctrl;
+    JL_UNLOCK(&m->lock);
+}
+
 JL_DLLEXPORT void jl_set_module_nospecialize(jl_module_t *self, int on)
 {
     self->nospecialize = (on ? -1 : 0);
@@ -171,6 +197,9 @@ static jl_binding_t *new_binding(jl_sym_t *name)
     return b;
 }
 
+static jl_binding_t *binding_cache_lookup(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var) JL_NOTSAFEPOINT;
+static void binding_cache_put(jl_module_t *m, jl_sym_t *var, jl_binding_t *b) JL_NOTSAFEPOINT;
+
 // get binding for assignment
 JL_DLLEXPORT jl_binding_t *jl_get_binding_wr(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var, int error)
 {
@@ -196,6 +225,7 @@ JL_DLLEXPORT jl_binding_t *jl_get_binding_wr(jl_module_t *m JL_PROPAGATES_ROOT,
         *bp = b;
         JL_GC_PROMISE_ROOTED(b);
         jl_gc_wb_buf(m, b, sizeof(jl_binding_t));
+        binding_cache_put(m, var, b);
     }
 
     JL_UNLOCK(&m->lock);
@@ -220,6 +250,120 @@ static inline jl_binding_t **_jl_get_module_binding_bp(jl_module_t *m JL_PROPAGA
 #endif
 
 
+// Lock-free read cache over `m->bindings` -----------------------------------
+//
+// The binding htable is only probed while holding `m->lock`, which turns every
+// dynamic global access that codegen didn't resolve into a lock acquisition,
+// and a `using`-chain miss into one acquisition per used module. Bindings are
+// never removed and a name's binding pointer never changes once entered (only
+// fields of the binding itself are mutated in place), so resolved
+// (name, binding) pairs can be memoized in an open-addressed array that
+// readers probe without the lock. Writers (all holding `m->lock`) publish an
+// entry value-first with a release store on the key; a grown table is
+// published with a release store on `m->bindingcache`, and the old array is
+// retired to a global list that is freed during GC, when every thread is
+// parked at a safepoint and no lock-free reader can still be mid-probe.
+//
+// Layout: slot 0 holds the capacity (entries, a power of two), slot 1 the
+// writer-side fill count, then (name, binding) pairs.
+
+#define BINDING_CACHE_INIT_SZ 32
+
+static arraylist_t retired_binding_caches;
+static jl_mutex_t retired_binding_caches_lock;
+
+static jl_binding_t *binding_cache_lookup(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var) JL_NOTSAFEPOINT
+{
+    _Atomic(void*) *tab = (_Atomic(void*)*)jl_atomic_load_acquire(&m->bindingcache);
+    if (tab == NULL)
+        return NULL;
+    size_t mask = (size_t)jl_atomic_load_relaxed(&tab[0]) - 1;
+    size_t i = inthash((uintptr_t)var) & mask;
+    while (1) {
+        void *k = jl_atomic_load_acquire(&tab[2 + 2 * i]);
+        if (k == (void*)var)
+            return (jl_binding_t*)jl_atomic_load_relaxed(&tab[3 + 2 * i]);
+        if (k == NULL)
+            return NULL;
+        i = (i + 1) & mask;
+    }
+}
+
+// caller must hold m->lock (writers never race each other, only readers)
+static void binding_cache_insert(_Atomic(void*) *tab, jl_sym_t *var, jl_binding_t *b) JL_NOTSAFEPOINT
+{
+    size_t mask = (size_t)jl_atomic_load_relaxed(&tab[0]) - 1;
+    size_t i = inthash((uintptr_t)var) & mask;
+    while (1) {
+        void *k = jl_atomic_load_relaxed(&tab[2 + 2 * i]);
+        if (k == (void*)var)
+            return; // already memoized by an earlier locked lookup
+        if (k == NULL) {
+            jl_atomic_store_relaxed(&tab[3 + 2 * i], (void*)b);
+            jl_atomic_store_release(&tab[2 + 2 * i], (void*)var);
+            jl_atomic_store_relaxed(&tab[1], (void*)((size_t)jl_atomic_load_relaxed(&tab[1]) + 1));
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+// caller must hold m->lock
+static void binding_cache_put(jl_module_t *m, jl_sym_t *var, jl_binding_t *b) JL_NOTSAFEPOINT
+{
+    _Atomic(void*) *tab = (_Atomic(void*)*)jl_atomic_load_relaxed(&m->bindingcache);
+    size_t sz = tab == NULL ? 0 : (size_t)jl_atomic_load_relaxed(&tab[0]);
+    size_t count = tab == NULL ? 0 : (size_t)jl_atomic_load_relaxed(&tab[1]);
+    if (tab == NULL || (count + 1) * 4 > sz * 3) {
+        size_t newsz = tab == NULL ? BINDING_CACHE_INIT_SZ : sz * 2;
+        _Atomic(void*) *newtab = (_Atomic(void*)*)calloc(2 + 2 * newsz, sizeof(void*));
+        if (newtab == NULL)
+            return; // cache is best-effort; the htable stays authoritative
+        jl_atomic_store_relaxed(&newtab[0], (void*)newsz);
+        for (size_t i = 0; tab != NULL && i < sz; i++) {
+            void *k = jl_atomic_load_relaxed(&tab[2 + 2 * i]);
+            if (k != NULL)
+                binding_cache_insert(newtab, (jl_sym_t*)k,
+                                     (jl_binding_t*)jl_atomic_load_relaxed(&tab[3 + 2 * i]));
+        }
+        jl_atomic_store_release(&m->bindingcache, (void**)newtab);
+        if (tab != NULL) {
+            // lock-free readers may still be probing the old array
+            JL_LOCK_NOGC(&retired_binding_caches_lock);
+            if (retired_binding_caches.items == NULL)
+                arraylist_new(&retired_binding_caches, 0);
+            arraylist_push(&retired_binding_caches, (void*)tab);
+            JL_UNLOCK_NOGC(&retired_binding_caches_lock);
+        }
+        tab = newtab;
+    }
+    binding_cache_insert(tab, var, b);
+}
+
+// called by GC while the world is stopped, so no reader holds a retired table
+void jl_free_retired_binding_caches(void) JL_NOTSAFEPOINT
+{
+    for (size_t i = 0; i < retired_binding_caches.len; i++)
+        free(retired_binding_caches.items[i]);
+    retired_binding_caches.len = 0;
+}
+
+// probe `m->bindings` without taking `m->lock` when the cache already knows
+// the name; the locked fallback memoizes its result for later readers
+static jl_binding_t *jl_get_module_binding_fast(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var)
+{
+    jl_binding_t *b = binding_cache_lookup(m, var);
+    if (b != NULL)
+        return b;
+    JL_LOCK(&m->lock);
+    b = _jl_get_module_binding(m, var);
+    if (b != HT_NOTFOUND)
+        binding_cache_put(m, var, b);
+    JL_UNLOCK(&m->lock);
+    return b;
+}
+
+
 // return module of binding
 JL_DLLEXPORT jl_module_t *jl_get_module_of_binding(jl_module_t *m, jl_sym_t *var)
 {
@@ -262,6 +406,7 @@ JL_DLLEXPORT jl_binding_t *jl_get_binding_for_method_def(jl_module_t *m, jl_sym_
         b->owner = m;
         *bp = b;
         jl_gc_wb_buf(m, b, sizeof(jl_binding_t));
+        binding_cache_put(m, var, b);
     }
 
     JL_UNLOCK(&m->lock);
@@ -297,10 +442,13 @@ static jl_binding_t *using_resolve_binding(jl_module_t *m JL_PROPAGATES_ROOT, jl
     jl_module_t *owner = NULL;
     for(int i=(int)m->usings.len-1; i >= 0; --i) {
         jl_module_t *imp = module_usings_getidx(m, i);
-        // TODO: make sure this can't deadlock
-        JL_LOCK(&imp->lock);
-        jl_binding_t *tempb = _jl_get_module_binding(imp, var);
-        JL_UNLOCK(&imp->lock);
+        jl_binding_t *tempb = binding_cache_lookup(imp, var);
+        if (tempb == NULL) {
+            // TODO: make sure this can't deadlock
+            JL_LOCK(&imp->lock);
+            tempb = _jl_get_module_binding(imp, var);
+            JL_UNLOCK(&imp->lock);
+        }
         if (tempb != HT_NOTFOUND && tempb->exportp) {
             tempb = jl_get_binding_(imp, var, st);
             if (tempb == NULL || tempb->owner == NULL)
@@ -343,21 +491,25 @@ static jl_binding_t *jl_get_binding_(jl_module_t *m, jl_sym_t *var, modstack_t *
         }
         tmp = tmp->prev;
     }
-    JL_LOCK(&m->lock);
-    jl_binding_t *b = _jl_get_module_binding(m, var);
-    if (b == HT_NOTFOUND || b->owner == NULL) {
-        b = using_resolve_binding(m, var, &top, 1);
-        JL_UNLOCK(&m->lock);
-        if (b != NULL) {
-            // do a full import to prevent the result of this lookup
-            // from changing, for example if this var is assigned to
-            // later.
-            module_import_(m, b->owner, var, var, 0);
-            return b;
+    jl_binding_t *b = binding_cache_lookup(m, var);
+    if (b == NULL || b->owner == NULL) {
+        JL_LOCK(&m->lock);
+        b = _jl_get_module_binding(m, var);
+        if (b == HT_NOTFOUND || b->owner == NULL) {
+            b = using_resolve_binding(m, var, &top, 1);
+            JL_UNLOCK(&m->lock);
+            if (b != NULL) {
+                // do a full import to prevent the result of this lookup
+                // from changing, for example if this var is assigned to
+                // later.
+                module_import_(m, b->owner, var, var, 0);
+                return b;
+            }
+            return NULL;
         }
-        return NULL;
+        binding_cache_put(m, var, b);
+        JL_UNLOCK(&m->lock);
     }
-    JL_UNLOCK(&m->lock);
     if (b->owner != m || b->name != var)
         return jl_get_binding_(b->owner, b->name, &top);
     return b;
@@ -366,11 +518,14 @@ static jl_binding_t *jl_get_binding_(jl_module_t *m, jl_sym_t *var, modstack_t *
 // get owner of binding when accessing m.var, without resolving the binding
 JL_DLLEXPORT jl_value_t *jl_binding_owner(jl_module_t *m, jl_sym_t *var)
 {
-    JL_LOCK(&m->lock);
-    jl_binding_t *b = (jl_binding_t*)ptrhash_get(&m->bindings, var);
-    if (b == HT_NOTFOUND || b->owner == NULL)
-        b = using_resolve_binding(m, var, NULL, 0);
-    JL_UNLOCK(&m->lock);
+    jl_binding_t *b = binding_cache_lookup(m, var);
+    if (b == NULL || b->owner == NULL) {
+        JL_LOCK(&m->lock);
+        b = (jl_binding_t*)ptrhash_get(&m->bindings, var);
+        if (b == HT_NOTFOUND || b->owner == NULL)
+            b = using_resolve_binding(m, var, NULL, 0);
+        JL_UNLOCK(&m->lock);
+    }
     if (b == NULL || b->owner == NULL)
         return jl_nothing;
     return (jl_value_t*)b->owner;
@@ -393,6 +548,12 @@ JL_DLLEXPORT jl_binding_t *jl_get_binding_or_error(jl_module_t *m, jl_sym_t *var
 
 JL_DLLEXPORT jl_value_t *jl_module_globalref(jl_module_t *m, jl_sym_t *var)
 {
+    jl_binding_t *cached = binding_cache_lookup(m, var);
+    if (cached != NULL) {
+        jl_value_t *globalref = jl_atomic_load_relaxed(&cached->globalref);
+        if (globalref != NULL)
+            return globalref;
+    }
     JL_LOCK(&m->lock);
     jl_binding_t *b = (jl_binding_t*)ptrhash_get(&m->bindings, var);
     if (b == HT_NOTFOUND) {
@@ -423,9 +584,7 @@ static int eq_bindings(jl_binding_t *a, jl_binding_t *b)
 // does module m explicitly import s?
 JL_DLLEXPORT int jl_is_imported(jl_module_t *m, jl_sym_t *s)
 {
-    JL_LOCK(&m->lock);
-    jl_binding_t *b = (jl_binding_t*)ptrhash_get(&m->bindings, s);
-    JL_UNLOCK(&m->lock);
+    jl_binding_t *b = jl_get_module_binding_fast(m, s);
     return (b != HT_NOTFOUND && b->imported);
 }
 
@@ -520,6 +679,7 @@ static void module_import_(jl_module_t *to, jl_module_t *from, jl_sym_t *s, jl_s
             nb->deprecated = b->deprecated;
             *bp = nb;
             jl_gc_wb_buf(to, nb, sizeof(jl_binding_t));
+            binding_cache_put(to, asname, nb);
         }
         JL_UNLOCK(&to->lock);
     }
@@ -556,6 +716,22 @@ JL_DLLEXPORT void jl_module_using(jl_module_t *to, jl_module_t *from)
             return;
         }
     }
+    // the conflict scan below walks every binding exported by `from`; a
+    // freshly created module (e.g. during deserialization, before any
+    // bindings are replayed) has nothing to conflict with, so skip it
+    int to_empty = 1;
+    for (size_t i = 1; i < to->bindings.size; i += 2) {
+        if (to->bindings.table[i] != HT_NOTFOUND) {
+            to_empty = 0;
+            break;
+        }
+    }
+    if (to_empty) {
+        arraylist_push(&to->usings, from);
+        jl_gc_wb(to, from);
+        JL_UNLOCK(&to->lock);
+        return;
+    }
     // TODO: make sure this can't deadlock
     JL_LOCK(&from->lock);
     // print a warning if something visible via this "using" conflicts with
@@ -599,6 +775,7 @@ JL_DLLEXPORT void jl_module_export(jl_module_t *from, jl_sym_t *s)
         b->owner = NULL;
         *bp = b;
         jl_gc_wb_buf(from, b, sizeof(jl_binding_t));
+        binding_cache_put(from, s, b);
     }
     assert(*bp != HT_NOTFOUND);
     (*bp)->exportp = 1;
@@ -613,33 +790,25 @@ JL_DLLEXPORT int jl_boundp(jl_module_t *m, jl_sym_t *var)
 
 JL_DLLEXPORT int jl_defines_or_exports_p(jl_module_t *m, jl_sym_t *var)
 {
-    JL_LOCK(&m->lock);
-    jl_binding_t *b = (jl_binding_t*)ptrhash_get(&m->bindings, var);
-    JL_UNLOCK(&m->lock);
+    jl_binding_t *b = jl_get_module_binding_fast(m, var);
     return b != HT_NOTFOUND && (b->exportp || b->owner==m);
 }
 
 JL_DLLEXPORT int jl_module_exports_p(jl_module_t *m, jl_sym_t *var)
 {
-    JL_LOCK(&m->lock);
-    jl_binding_t *b = _jl_get_module_binding(m, var);
-    JL_UNLOCK(&m->lock);
+    jl_binding_t *b = jl_get_module_binding_fast(m, var);
     return b != HT_NOTFOUND && b->exportp;
 }
 
 JL_DLLEXPORT int jl_binding_resolved_p(jl_module_t *m, jl_sym_t *var)
 {
-    JL_LOCK(&m->lock);
-    jl_binding_t *b = _jl_get_module_binding(m, var);
-    JL_UNLOCK(&m->lock);
+    jl_binding_t *b = jl_get_module_binding_fast(m, var);
     return b != HT_NOTFOUND && b->owner != NULL;
 }
 
 JL_DLLEXPORT jl_binding_t *jl_get_module_binding(jl_module_t *m JL_PROPAGATES_ROOT, jl_sym_t *var)
 {
-    JL_LOCK(&m->lock);
-    jl_binding_t *b = _jl_get_module_binding(m, var);
-    JL_UNLOCK(&m->lock);
+    jl_binding_t *b = jl_get_module_binding_fast(m, var);
     return b == HT_NOTFOUND ? NULL : b;
 }
 
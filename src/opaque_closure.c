@@ -5,12 +5,20 @@
 
 JL_DLLEXPORT jl_value_t *jl_invoke_opaque_closure(jl_opaque_closure_t *oc, jl_value_t **args, size_t nargs)
 {
+    jl_method_instance_t *mi = (jl_method_instance_t*)oc->specptr;
     jl_value_t *ret = NULL;
     JL_GC_PUSH1(&ret);
     jl_task_t *ct = jl_current_task;
     size_t last_age = ct->world_age;
     ct->world_age = oc->world;
-    ret = jl_interpret_opaque_closure(oc, args, nargs);
+    jl_code_instance_t *ci = mi == NULL ? NULL : jl_method_compiled(mi, oc->world);
+    if (ci != NULL) {
+        jl_callptr_t invoke = jl_atomic_load_relaxed(&ci->invoke);
+        ret = invoke((jl_value_t*)oc, args, nargs, ci);
+    }
+    else {
+        ret = jl_interpret_opaque_closure(oc, args, nargs);
+    }
     jl_typeassert(ret, jl_tparam1(jl_typeof(oc)));
     ct->world_age = last_age;
     JL_GC_POP();
@@ -34,14 +42,31 @@ jl_opaque_closure_t *jl_new_opaque_closure(jl_tupletype_t *argt, jl_value_t *isv
     jl_value_t *captures = NULL;
     JL_GC_PUSH1(&captures);
     captures = jl_f_tuple(NULL, env, nenv);
+    // One specialization per closure source, cached in source->specializations,
+    // so repeat constructions and invocations share the method instance (and,
+    // through it, the uncompressed IR memoized by the interpreter). It is kept
+    // alive by the source method, so stashing it in the non-scanned specptr
+    // slot is fine.
+    jl_method_instance_t *mi = jl_specializations_get_linfo((jl_method_t*)source,
+        ((jl_method_t*)source)->sig, jl_emptysvec);
     jl_opaque_closure_t *oc = (jl_opaque_closure_t*)jl_gc_alloc(ct->ptls, sizeof(jl_opaque_closure_t), oc_type);
     JL_GC_POP();
     oc->source = (jl_method_t*)source;
     oc->isva = jl_unbox_bool(isva);
     oc->invoke = (jl_fptr_args_t)jl_invoke_opaque_closure;
-    oc->specptr = NULL;
+    oc->specptr = (void*)mi;
     oc->captures = captures;
     oc->world = jl_atomic_load_acquire(&jl_world_counter);
+    // if this source already has native code whose return type satisfies the
+    // declared bound, calls can go straight through one indirect jump instead
+    // of the generic invoke machinery
+    jl_code_instance_t *ci = jl_method_compiled(mi, oc->world);
+    if (ci != NULL && jl_atomic_load_relaxed(&ci->invoke) == jl_fptr_args_addr &&
+        jl_subtype(ci->rettype, rt_ub)) {
+        jl_fptr_args_t fptr = jl_atomic_load_relaxed(&ci->specptr.fptr1);
+        if (fptr != NULL)
+            oc->invoke = fptr;
+    }
     return oc;
 }
 
@@ -10,6 +10,8 @@
 // Build-time options for debugging, tweaking, and selecting alternative
 // implementations of core features.
 
+// default number of slots in the global callsite cache; can be overridden at
+// startup with the JULIA_CALL_CACHE_SIZE environment variable (see gf.c)
 #define N_CALL_CACHE 4096
 
 // object layout options ------------------------------------------------------
@@ -86,6 +88,119 @@
 // Automatic Instrumenting Profiler
 //#define ENABLE_TIMINGS
 
+// event tracer: setting this environment variable to a path enables tracing
+// at startup and dumps a Chrome trace there at exit (see timing.c)
+#define TIMING_TRACE_NAME "JULIA_TIMING_TRACE"
+
+// have the sampling profiler unwind by chasing frame pointers instead of
+// stepping through libunwind (see rec_backtrace_ctx_fp in stackwalk.c)
+#define PROFILE_FP_UNWIND_NAME "JULIA_PROFILE_FP_UNWIND"
+
+// report a breakdown of JIT time by LLVM pass to stderr at exit (uses LLVM's
+// pass timers; see jl_init_jit in jitlayers.cpp)
+#define LLVM_TIME_PASSES_NAME "JULIA_LLVM_TIME_PASSES"
+
+// capture exception backtraces by chasing frame pointers instead of stepping
+// through libunwind, making throw-heavy code much cheaper at the cost of
+// truncating the trace at frames compiled without frame pointers (see
+// rec_backtrace_fp in stackwalk.c)
+#define THROW_FP_UNWIND_NAME "JULIA_THROW_FP_UNWIND"
+
+// skip backtrace capture entirely when the thrown exception is an immutable
+// singleton (see jl_throw in task.c): such exceptions are typically
+// control-flow sentinels whose handler never inspects the trace, and the
+// stack unwind is nearly the whole cost of the throw; off by default since
+// catch_backtrace() then sees an empty trace for them
+#define THROW_SINGLETON_NOBT_NAME "JULIA_THROW_SINGLETON_NOBT"
+
+// count hardware events (cycles, instructions, cache and branch misses) per
+// thread and attribute them to the running task (see perf-counters.c)
+#define PERF_COUNTERS_NAME "JULIA_PERF_COUNTERS"
+
+// defer system image pointer relocation until a page is first touched, so
+// untouched image pages stay shared between processes (Linux only; set to 0
+// to apply all relocations at startup as before)
+#define SYSIMG_LAZY_RELOCS_NAME "JULIA_SYSIMG_LAZY_RELOCS"
+
+// when building a system image, sort objects that are only needed when code
+// gets (re)compiled (method sources and roots, inference results) behind
+// everything else, so the startup-hot part of the image stays contiguous
+// (set to 0 to keep pure serialization order)
+#define SYSIMG_COLD_LAYOUT_NAME "JULIA_SYSIMG_COLD_LAYOUT"
+
+// write the order in which system image pages are first touched to the named
+// file at exit (requires lazy relocation; see staticdata.c); used to size and
+// validate the layout produced by JULIA_SYSIMG_COLD_LAYOUT
+#define SYSIMG_PAGE_TRACE_NAME "JULIA_SYSIMG_PAGE_TRACE"
+
+// persistent library path-resolution cache (see jl_load_dynamic_library in
+// dlload.c): names a file remembering where each library was last found, so
+// later processes skip the DL_LOAD_PATH/extension probe walk
+#define DLOPEN_CACHE_NAME "JULIA_DLOPEN_CACHE"
+
+// divisor for the large-array growth policy (see overallocation in array.c):
+// big arrays grow by roughly maxsize/divisor per resize; smaller values trade
+// memory for fewer resizes, the default is 8
+#define ARRAY_GROWTH_DIVISOR_NAME "JULIA_ARRAY_GROWTH_DIVISOR"
+
+// number of interned boxes per primitive-type cache (see datatype.c): values
+// in the covered range are returned as preallocated permanent boxes instead
+// of heap allocations when they escape to a jl_value_t*; each entry costs one
+// 16-byte box at startup, the default is 1024, clamped to [64, 32768]
+#define BOX_CACHE_SIZE_NAME "JULIA_BOX_CACHE_SIZE"
+
+// route the synchronous jl_fs_read/jl_fs_write wrappers through an io_uring
+// (Linux only; see jl_uv.c): with a kernel-side submission poller small cached
+// file operations complete without entering the kernel; off by default
+#define IO_URING_NAME "JULIA_IO_URING"
+
+// cache stat() misses keyed by the containing directory's mtime (see jl_stat
+// in sys.c): code loading probes many paths that do not exist, and on
+// network filesystems a negative lookup costs far more than rechecking the
+// directory; off by default
+#define STAT_CACHE_NAME "JULIA_STAT_CACHE"
+
+// remember whole-file parse results under a content hash (see jl_fl_parse in
+// ast.c), so re-including an unchanged file skips the flisp parser; intended
+// for revise-style development loops, off by default
+#define PARSE_CACHE_NAME "JULIA_PARSE_CACHE"
+
+// initial flisp heap size per ast context, in MiB (see jl_init_ast_ctx in
+// ast.c): the heap grows on demand, but starting larger avoids repeated
+// collect-and-grow cycles inside parsing and lowering; the default is 4
+#define FLISP_HEAP_SIZE_NAME "JULIA_FLISP_HEAP_SIZE"
+
+// interpreter time budget for loop-containing top-level thunks, in ms (see
+// jl_toplevel_eval_flex in toplevel.c): such thunks are interpreted first and
+// later ones are promoted to codegen only after a measured run exceeds the
+// budget; 0 restores eager compilation, the default is 50
+#define TOPLEVEL_INTERP_BUDGET_NAME "JULIA_TOPLEVEL_INTERP_BUDGET"
+#define TOPLEVEL_INTERP_BUDGET_DEFAULT 50
+
+// cheap code-coverage counters (see coverageVisitLine in codegen.cpp):
+// 8-bit saturating per-line counters in flat per-file buffers instead of
+// 64-bit exact ones, merged into the regular coverage data on dump; counts
+// cap at 254 but the working set shrinks 8x; off by default
+#define COVERAGE_COUNTERS_NAME "JULIA_COVERAGE_COUNTERS"
+
+// per-target budget for partial multiversioning clones, in LLVM IR
+// instructions (see check_partial in llvm-multiversioning.cpp): only the most
+// profitable flagged functions are cloned until the budget is spent, trading
+// a little dispatch for a smaller system image; unset or 0 clones every
+// flagged function
+#define CLONE_BUDGET_NAME "JULIA_CLONE_BUDGET"
+
+// bind statically-known ccall targets as direct symbol references when
+// compiling a system image (see emit_ccall in ccall.cpp), so the link step
+// resolves them and calls skip the lazy plt-slot load; only valid when the
+// image is linked against every ccall'd library, off by default
+#define SYSIMG_DIRECT_CCALLS_NAME "JULIA_SYSIMG_DIRECT_CCALLS"
+
+// print which multiversioning target the system image selected at load time
+// and how many function clones it relocated (see parse_sysimg in
+// processor.cpp); used to check what JULIA_CLONE_BUDGET actually bought
+#define SYSIMG_CLONE_REPORT_NAME "JULIA_SYSIMG_CLONE_REPORT"
+
 
 // method dispatch profiling --------------------------------------------------
 
@@ -128,6 +243,12 @@
 #define THREAD_SLEEP_THRESHOLD_NAME     "JULIA_THREAD_SLEEP_THRESHOLD"
 #define DEFAULT_THREAD_SLEEP_THRESHOLD  16*1000 // nanoseconds (16us)
 
+// opt-in depth-first scheduling for spawned tasks
+#define SCHED_DEPTH_FIRST_NAME          "JULIA_SCHED_DEPTH_FIRST"
+
+// opt-in dedicated I/O thread that owns the libuv event loop
+#define IO_THREAD_NAME                  "JULIA_IO_THREAD"
+
 // defaults for # threads
 #define NUM_THREADS_NAME                "JULIA_NUM_THREADS"
 #ifndef JULIA_NUM_THREADS
@@ -137,6 +258,7 @@
 // affinitization behavior
 #define MACHINE_EXCLUSIVE_NAME          "JULIA_EXCLUSIVE"
 #define DEFAULT_MACHINE_EXCLUSIVE       0
+#define MACHINE_AFFINITY_NAME           "JULIA_THREAD_AFFINITY"
 
 // partr -- parallel tasks runtime options ------------------------------------
 
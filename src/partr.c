@@ -20,6 +20,11 @@ extern "C" {
 // default to DEFAULT_THREAD_SLEEP_THRESHOLD; set via $JULIA_THREAD_SLEEP_THRESHOLD
 uint64_t sleep_threshold;
 
+// depth-first scheduling: `@spawn` switches to the child immediately and
+// leaves the parent's continuation stealable, so nested spawn trees unwind
+// depth-first instead of materializing every sibling; default to 0 (off);
+// set via $JULIA_SCHED_DEPTH_FIRST
+
 // thread should not be sleeping--it might need to do work.
 static const int16_t not_sleeping = 0;
 
@@ -42,6 +47,17 @@ uint64_t io_wakeup_leave;
 uv_mutex_t *sleep_locks;
 uv_cond_t *wake_signals;
 
+// when JULIA_IO_THREAD is set (and more than one thread exists), the last
+// thread exclusively drives the libuv event loop instead of scheduling
+// compute tasks, so I/O completions make progress during compute bursts
+static int16_t io_thread_tid = -1;
+
+// number of threads currently in (or entering) the sleeping state, so that
+// an enqueue can skip the wake scan entirely when every thread is busy;
+// incremented with the transition to sleeping and decremented by whoever
+// transitions the thread back to not_sleeping
+static _Atomic(int32_t) n_threads_sleeping;
+
 JL_DLLEXPORT int jl_set_task_tid(jl_task_t *task, int tid) JL_NOTSAFEPOINT
 {
     // Try to acquire the lock on this task.
@@ -57,171 +73,269 @@ JL_DLLEXPORT int jl_set_task_tid(jl_task_t *task, int tid) JL_NOTSAFEPOINT
 extern int jl_gc_mark_queue_obj_explicit(jl_gc_mark_cache_t *gc_cache,
                                          jl_gc_mark_sp_t *sp, jl_value_t *obj) JL_NOTSAFEPOINT;
 
-// multiq
+// work-stealing deques
 // ---
 
-/* a task heap */
-typedef struct taskheap_tag {
-    uv_mutex_t lock;
-    jl_task_t **tasks;
-    _Atomic(int32_t) ntasks;
-    _Atomic(int16_t) prio;
-} taskheap_t;
-
-/* multiqueue parameters */
-static const int32_t heap_d = 8;
-static const int heap_c = 2;
-
-/* size of each heap */
-static const int tasks_per_heap = 65536; // TODO: this should be smaller by default, but growable!
-
-/* the multiqueue's heaps */
-static taskheap_t *heaps;
-static int32_t heap_p;
-
-/* unbias state for the RNG */
+// Each thread owns a Chase-Lev deque: the owner pushes and pops at the
+// bottom (LIFO, for locality with fine-grained spawns) and thieves take
+// from the top (FIFO, stealing the oldest and typically largest work)
+// with a single CAS. This replaces the randomized multiqueue of locked
+// heaps, whose pops scanned and try-locked random heaps; task priorities
+// are no longer used for ordering (the multiqueue only ever approximated
+// them). The sticky-task path is unaffected: sticky tasks go through the
+// Julia-side per-thread workqueues and never reach these deques.
+
+/* a growable ring buffer, published to thieves as a unit so that the
+ * entries and their capacity are always read consistently */
+typedef struct wsbuf_tag {
+    int64_t capacity; // power of two
+    jl_task_t *tasks[];
+} wsbuf_t;
+
+typedef struct wsdeque_tag {
+    _Atomic(int64_t) top;    // next index to steal (oldest task)
+    _Atomic(int64_t) bottom; // next index to push (owner only)
+    _Atomic(wsbuf_t*) buf;
+} wsdeque_t;
+
+static const int64_t wsdeque_init_capacity = 256;
+
+/* one deque per thread */
+static wsdeque_t *wsdeques;
+
+/* unbias state for the RNG, for victim selection */
 static uint64_t cong_unbias;
 
-
-static inline void multiq_init(void)
+// scheduler counters behind jl_sched_stats: one block per thread, padded
+// out to a cache-line multiple so the owner-side increments never
+// false-share. All updates are relaxed; every counter except `wakes` is
+// written only by its own thread, and readers only want statistically
+// meaningful totals, not a consistent cut.
+typedef struct {
+    _Atomic(uint64_t) enqueues;
+    _Atomic(uint64_t) pops;
+    _Atomic(uint64_t) steal_hits;
+    _Atomic(uint64_t) steal_misses;
+    _Atomic(uint64_t) steal_probes;
+    _Atomic(uint64_t) sleeps;
+    _Atomic(uint64_t) wakes;
+    _Atomic(uint64_t) latency_hist[JL_SCHED_LAT_NBUCKETS];
+    char _pad[JL_CACHE_BYTE_ALIGNMENT -
+              ((7 + JL_SCHED_LAT_NBUCKETS) * sizeof(uint64_t)) % JL_CACHE_BYTE_ALIGNMENT];
+} sched_stats_block_t;
+
+static sched_stats_block_t *sched_stats;
+
+
+static wsbuf_t *wsbuf_alloc(int64_t capacity)
 {
-    heap_p = heap_c * jl_n_threads;
-    heaps = (taskheap_t *)calloc(heap_p, sizeof(taskheap_t));
-    for (int32_t i = 0; i < heap_p; ++i) {
-        uv_mutex_init(&heaps[i].lock);
-        heaps[i].tasks = (jl_task_t **)calloc(tasks_per_heap, sizeof(jl_task_t*));
-        jl_atomic_store_relaxed(&heaps[i].ntasks, 0);
-        jl_atomic_store_relaxed(&heaps[i].prio, INT16_MAX);
-    }
-    unbias_cong(heap_p, &cong_unbias);
+    wsbuf_t *buf = (wsbuf_t *)malloc_s(sizeof(wsbuf_t) + capacity * sizeof(jl_task_t*));
+    buf->capacity = capacity;
+    return buf;
 }
 
-
-static inline void sift_up(taskheap_t *heap, int32_t idx)
+static inline void wsdeque_init(void)
 {
-    if (idx > 0) {
-        int32_t parent = (idx-1)/heap_d;
-        if (heap->tasks[idx]->prio < heap->tasks[parent]->prio) {
-            jl_task_t *t = heap->tasks[parent];
-            heap->tasks[parent] = heap->tasks[idx];
-            heap->tasks[idx] = t;
-            sift_up(heap, parent);
-        }
-    }
+    wsdeques = (wsdeque_t *)calloc(jl_n_threads, sizeof(wsdeque_t));
+    for (int i = 0; i < jl_n_threads; ++i)
+        jl_atomic_store_relaxed(&wsdeques[i].buf, wsbuf_alloc(wsdeque_init_capacity));
+    sched_stats = (sched_stats_block_t *)calloc(jl_n_threads, sizeof(sched_stats_block_t));
+    unbias_cong(jl_n_threads, &cong_unbias);
 }
 
 
-static inline void sift_down(taskheap_t *heap, int32_t idx)
+// owner only; returns the buffer to push into
+static wsbuf_t *wsdeque_grow(wsdeque_t *q, wsbuf_t *buf, int64_t top, int64_t bottom)
 {
-    if (idx < jl_atomic_load_relaxed(&heap->ntasks)) {
-        for (int32_t child = heap_d*idx + 1;
-                child < tasks_per_heap && child <= heap_d*idx + heap_d;
-                ++child) {
-            if (heap->tasks[child]
-                    && heap->tasks[child]->prio < heap->tasks[idx]->prio) {
-                jl_task_t *t = heap->tasks[idx];
-                heap->tasks[idx] = heap->tasks[child];
-                heap->tasks[child] = t;
-                sift_down(heap, child);
-            }
-        }
-    }
+    wsbuf_t *newbuf = wsbuf_alloc(buf->capacity * 2);
+    for (int64_t i = top; i < bottom; ++i)
+        newbuf->tasks[i & (newbuf->capacity - 1)] = buf->tasks[i & (buf->capacity - 1)];
+    jl_atomic_store_release(&q->buf, newbuf);
+    // deliberately leak the old buffer: a thief that read it before the
+    // publish may still be loading an entry from it, and there is no
+    // grace period to wait out; doubling bounds the total leak to about
+    // the size of the final buffer
+    return newbuf;
 }
 
 
-static inline int multiq_insert(jl_task_t *task, int16_t priority)
+// push `task` onto the bottom of the current thread's deque
+static inline void wsdeque_push(jl_task_t *task)
 {
-    jl_ptls_t ptls = jl_current_task->ptls;
-    uint64_t rn;
+    int16_t tid = jl_atomic_load_relaxed(&jl_current_task->tid);
+    wsdeque_t *q = &wsdeques[tid];
+    int64_t b = jl_atomic_load_relaxed(&q->bottom);
+    int64_t t = jl_atomic_load_acquire(&q->top);
+    wsbuf_t *buf = jl_atomic_load_relaxed(&q->buf);
+    if (b - t >= buf->capacity)
+        buf = wsdeque_grow(q, buf, t, b);
+    buf->tasks[b & (buf->capacity - 1)] = task;
+    jl_fence_release();
+    jl_atomic_store_relaxed(&q->bottom, b + 1);
+    jl_atomic_fetch_add_relaxed(&sched_stats[tid].enqueues, 1);
+}
 
-    task->prio = priority;
-    do {
-        rn = cong(heap_p, cong_unbias, &ptls->rngseed);
-    } while (uv_mutex_trylock(&heaps[rn].lock) != 0);
 
-    if (jl_atomic_load_relaxed(&heaps[rn].ntasks) >= tasks_per_heap) {
-        uv_mutex_unlock(&heaps[rn].lock);
-        // multiq insertion failed, increase #tasks per heap
-        return -1;
+// pop from the bottom of the current thread's deque (most recently pushed)
+static inline jl_task_t *wsdeque_pop(void)
+{
+    wsdeque_t *q = &wsdeques[jl_atomic_load_relaxed(&jl_current_task->tid)];
+    int64_t b = jl_atomic_load_relaxed(&q->bottom) - 1;
+    wsbuf_t *buf = jl_atomic_load_relaxed(&q->buf);
+    jl_atomic_store_relaxed(&q->bottom, b);
+    jl_fence();
+    int64_t t = jl_atomic_load_relaxed(&q->top);
+    if (t > b) {
+        // deque was empty
+        jl_atomic_store_relaxed(&q->bottom, b + 1);
+        return NULL;
     }
+    jl_task_t *task = buf->tasks[b & (buf->capacity - 1)];
+    if (t == b) {
+        // last task: race against thieves for it
+        if (!jl_atomic_cmpswap(&q->top, &t, t + 1))
+            task = NULL;
+        jl_atomic_store_relaxed(&q->bottom, b + 1);
+    }
+    return task;
+}
 
-    int32_t ntasks = jl_atomic_load_relaxed(&heaps[rn].ntasks);
-    jl_atomic_store_relaxed(&heaps[rn].ntasks, ntasks + 1);
-    heaps[rn].tasks[ntasks] = task;
-    sift_up(&heaps[rn], ntasks);
-    int16_t prio = jl_atomic_load_relaxed(&heaps[rn].prio);
-    if (task->prio < prio)
-        jl_atomic_store_relaxed(&heaps[rn].prio, task->prio);
-    uv_mutex_unlock(&heaps[rn].lock);
 
-    return 0;
+// steal from the top of the deque of thread `tid` (oldest task)
+static inline jl_task_t *wsdeque_steal(int16_t tid)
+{
+    wsdeque_t *q = &wsdeques[tid];
+    while (1) {
+        int64_t t = jl_atomic_load_acquire(&q->top);
+        jl_fence();
+        int64_t b = jl_atomic_load_acquire(&q->bottom);
+        if (t >= b)
+            return NULL;
+        wsbuf_t *buf = jl_atomic_load_acquire(&q->buf);
+        jl_task_t *task = buf->tasks[t & (buf->capacity - 1)];
+        if (jl_atomic_cmpswap(&q->top, &t, t + 1))
+            return task;
+        // lost the race; reload and retry
+    }
 }
 
 
-static inline jl_task_t *multiq_deletemin(void)
+// pop from the local deque, or steal from a random victim
+static jl_task_t *wsdeque_pop_or_steal(void)
 {
     jl_ptls_t ptls = jl_current_task->ptls;
-    uint64_t rn1 = 0, rn2;
-    int32_t i;
-    int16_t prio1, prio2;
+    sched_stats_block_t *stats = &sched_stats[ptls->tid];
     jl_task_t *task;
  retry:
     jl_gc_safepoint();
-    for (i = 0; i < heap_p; ++i) {
-        rn1 = cong(heap_p, cong_unbias, &ptls->rngseed);
-        rn2 = cong(heap_p, cong_unbias, &ptls->rngseed);
-        prio1 = jl_atomic_load_relaxed(&heaps[rn1].prio);
-        prio2 = jl_atomic_load_relaxed(&heaps[rn2].prio);
-        if (prio1 > prio2) {
-            prio1 = prio2;
-            rn1 = rn2;
-        }
-        else if (prio1 == prio2 && prio1 == INT16_MAX)
-            continue;
-        if (uv_mutex_trylock(&heaps[rn1].lock) == 0) {
-            if (prio1 == jl_atomic_load_relaxed(&heaps[rn1].prio))
-                break;
-            uv_mutex_unlock(&heaps[rn1].lock);
+    task = wsdeque_pop();
+    if (task != NULL) {
+        jl_atomic_fetch_add_relaxed(&stats->pops, 1);
+    }
+    else if (jl_n_threads > 1) {
+        // try each victim once, starting at a random thread, but prefer
+        // victims on our own NUMA node so that memory-bandwidth-bound work
+        // does not bounce across sockets (without pinning all threads are
+        // on node 0 and the first pass covers everyone)
+        int16_t self_node = ptls->numa_node;
+        uint64_t rn = cong(jl_n_threads, cong_unbias, &ptls->rngseed);
+        for (int pass = 0; pass < 2 && task == NULL; ++pass) {
+            for (int i = 0; i < jl_n_threads; ++i) {
+                int16_t vid = (int16_t)((rn + i) % jl_n_threads);
+                if (vid == ptls->tid)
+                    continue;
+                int same_node = jl_thread_numa_nodes[vid] == self_node;
+                if (pass == 0 ? !same_node : same_node)
+                    continue;
+                jl_atomic_fetch_add_relaxed(&stats->steal_probes, 1);
+                task = wsdeque_steal(vid);
+                if (task) {
+                    JL_PROBE_RT_TASK_STEAL(vid, ptls->tid, task);
+                    jl_atomic_fetch_add_relaxed(&stats->steal_hits, 1);
+                    break;
+                }
+            }
         }
+        if (task == NULL)
+            jl_atomic_fetch_add_relaxed(&stats->steal_misses, 1);
     }
-    if (i == heap_p)
+    if (task == NULL)
         return NULL;
-
-    task = heaps[rn1].tasks[0];
     if (!jl_set_task_tid(task, ptls->tid)) {
-        uv_mutex_unlock(&heaps[rn1].lock);
+        // someone else claimed the task while it was queued (e.g. it was
+        // made sticky to another thread); put it back and look again
+        wsdeque_push(task);
         goto retry;
     }
-    int32_t ntasks = jl_atomic_load_relaxed(&heaps[rn1].ntasks) - 1;
-    jl_atomic_store_relaxed(&heaps[rn1].ntasks, ntasks);
-    heaps[rn1].tasks[0] = heaps[rn1].tasks[ntasks];
-    heaps[rn1].tasks[ntasks] = NULL;
-    prio1 = INT16_MAX;
-    if (ntasks > 0) {
-        sift_down(&heaps[rn1], 0);
-        prio1 = heaps[rn1].tasks[0]->prio;
+    if (task->enqueue_tstamp) {
+        // the timestamp was published by the release of the deque slot the
+        // task was read from, so a plain load is ordered here
+        uint64_t us = (jl_hrtime() - task->enqueue_tstamp) / 1000;
+        int bucket = 0;
+        while (bucket < JL_SCHED_LAT_NBUCKETS - 1 && (us >> (bucket + 1)) != 0)
+            bucket++;
+        jl_atomic_fetch_add_relaxed(&stats->latency_hist[bucket], 1);
+        task->enqueue_tstamp = 0;
     }
-    jl_atomic_store_relaxed(&heaps[rn1].prio, prio1);
-    uv_mutex_unlock(&heaps[rn1].lock);
-
     return task;
 }
 
 
 void jl_gc_mark_enqueued_tasks(jl_gc_mark_cache_t *gc_cache, jl_gc_mark_sp_t *sp)
 {
-    int32_t i, j;
-    for (i = 0; i < heap_p; ++i)
-        for (j = 0; j < jl_atomic_load_relaxed(&heaps[i].ntasks); ++j)
-            jl_gc_mark_queue_obj_explicit(gc_cache, sp, (jl_value_t *)heaps[i].tasks[j]);
+    // called with the world stopped, so the deques are quiescent
+    for (int i = 0; i < jl_n_threads; ++i) {
+        wsdeque_t *q = &wsdeques[i];
+        wsbuf_t *buf = jl_atomic_load_relaxed(&q->buf);
+        int64_t t = jl_atomic_load_relaxed(&q->top);
+        int64_t b = jl_atomic_load_relaxed(&q->bottom);
+        for (int64_t j = t; j < b; ++j)
+            jl_gc_mark_queue_obj_explicit(gc_cache, sp,
+                    (jl_value_t *)buf->tasks[j & (buf->capacity - 1)]);
+    }
+}
+
+
+// queue-depth metric for thread `tid`'s ready-task deque, for load
+// inspection from Base (ccall); racy by nature, the answer can be stale by
+// the time the caller looks at it
+JL_DLLEXPORT int64_t jl_tasks_queued(int16_t tid) JL_NOTSAFEPOINT
+{
+    if (wsdeques == NULL || tid < 0 || tid >= jl_n_threads)
+        return 0;
+    int64_t t = jl_atomic_load_relaxed(&wsdeques[tid].top);
+    int64_t b = jl_atomic_load_relaxed(&wsdeques[tid].bottom);
+    return b > t ? b - t : 0;
+}
+
+
+// snapshot thread `tid`'s scheduler counters into `*out`; returns 1 on
+// success, 0 if the scheduler is not initialized yet or `tid` is out of
+// range. The loads are relaxed, so the fields are individually current but
+// not a mutually consistent cut.
+JL_DLLEXPORT int jl_sched_stats(int16_t tid, jl_sched_stats_t *out) JL_NOTSAFEPOINT
+{
+    if (sched_stats == NULL || tid < 0 || tid >= jl_n_threads)
+        return 0;
+    sched_stats_block_t *stats = &sched_stats[tid];
+    out->enqueues = jl_atomic_load_relaxed(&stats->enqueues);
+    out->pops = jl_atomic_load_relaxed(&stats->pops);
+    out->steal_hits = jl_atomic_load_relaxed(&stats->steal_hits);
+    out->steal_misses = jl_atomic_load_relaxed(&stats->steal_misses);
+    out->steal_probes = jl_atomic_load_relaxed(&stats->steal_probes);
+    out->sleeps = jl_atomic_load_relaxed(&stats->sleeps);
+    out->wakes = jl_atomic_load_relaxed(&stats->wakes);
+    for (int i = 0; i < JL_SCHED_LAT_NBUCKETS; ++i)
+        out->latency_hist[i] = jl_atomic_load_relaxed(&stats->latency_hist[i]);
+    return 1;
 }
 
 
-static int multiq_check_empty(void)
+static int wsdeque_check_empty(void)
 {
-    int32_t i;
-    for (i = 0; i < heap_p; ++i) {
-        if (jl_atomic_load_relaxed(&heaps[i].ntasks) != 0)
+    for (int i = 0; i < jl_n_threads; ++i) {
+        if (jl_atomic_load_relaxed(&wsdeques[i].top) <
+                jl_atomic_load_relaxed(&wsdeques[i].bottom))
             return 0;
     }
     return 1;
@@ -236,8 +350,8 @@ static int multiq_check_empty(void)
 // (used only by the main thread)
 void jl_init_threadinginfra(void)
 {
-    /* initialize the synchronization trees pool and the multiqueue */
-    multiq_init();
+    /* initialize the per-thread work-stealing deques */
+    wsdeque_init();
 
     sleep_threshold = DEFAULT_THREAD_SLEEP_THRESHOLD;
     char *cp = getenv(THREAD_SLEEP_THRESHOLD_NAME);
@@ -248,6 +362,19 @@ void jl_init_threadinginfra(void)
             sleep_threshold = (uint64_t)strtol(cp, NULL, 10);
     }
 
+    cp = getenv(SCHED_DEPTH_FIRST_NAME);
+    if (cp && strcmp(cp, "0") != 0)
+        jl_sched_depth_first = 1;
+
+    cp = getenv(IO_THREAD_NAME);
+    if (cp && strcmp(cp, "0") != 0) {
+        if (jl_n_threads > 1)
+            io_thread_tid = jl_n_threads - 1;
+        else
+            jl_safe_printf("WARNING: %s requires more than one thread\n",
+                           IO_THREAD_NAME);
+    }
+
     jl_ptls_t ptls = jl_current_task->ptls;
     jl_install_thread_signal_handler(ptls);
 
@@ -292,8 +419,9 @@ void jl_threadfun(void *arg)
 // enqueue the specified task for execution
 JL_DLLEXPORT int jl_enqueue_task(jl_task_t *task)
 {
-    if (multiq_insert(task, task->prio) == -1)
-        return 1;
+    JL_PROBE_RT_TASK_SPAWN(task, jl_atomic_load_relaxed(&jl_current_task->tid));
+    task->enqueue_tstamp = jl_hrtime();
+    wsdeque_push(task);
     return 0;
 }
 
@@ -348,15 +476,42 @@ static int sleep_check_after_threshold(uint64_t *start_cycles)
 }
 
 
-static void wake_thread(int16_t tid)
+static int wake_thread(int16_t tid)
 {
     jl_ptls_t other = jl_all_tls_states[tid];
     int8_t state = sleeping;
-    jl_atomic_cmpswap(&other->sleep_check_state, &state, not_sleeping);
-    if (state == sleeping) {
+    if (jl_atomic_cmpswap(&other->sleep_check_state, &state, not_sleeping)) {
+        JL_PROBE_RT_TASK_WAKE(tid);
+        jl_atomic_fetch_add_relaxed(&sched_stats[tid].wakes, 1);
+        jl_atomic_fetch_add(&n_threads_sleeping, -1);
         uv_mutex_lock(&sleep_locks[tid]);
         uv_cond_signal(&wake_signals[tid]);
         uv_mutex_unlock(&sleep_locks[tid]);
+        return 1;
+    }
+    return 0;
+}
+
+
+// transition the current thread out of the sleeping state, if needed
+static void wake_self(jl_ptls_t ptls)
+{
+    int8_t state = sleeping;
+    if (jl_atomic_cmpswap(&ptls->sleep_check_state, &state, not_sleeping))
+        jl_atomic_fetch_add(&n_threads_sleeping, -1);
+}
+
+
+// wake one sleeping thread other than `self`, if there is one; the woken
+// thread passes the wake along from jl_task_get_next if it finds more work
+static void wake_one_thread(int16_t self)
+{
+    if (jl_atomic_load_relaxed(&n_threads_sleeping) == 0)
+        return;
+    for (int i = 0; i < jl_n_threads; i++) {
+        int16_t tid = (int16_t)((self + 1 + i) % jl_n_threads);
+        if (tid != self && wake_thread(tid))
+            return;
     }
 }
 
@@ -378,8 +533,7 @@ JL_DLLEXPORT void jl_wakeup_thread(int16_t tid)
     JULIA_DEBUG_SLEEPWAKE( wakeup_enter = cycleclock() );
     if (tid == self || tid == -1) {
         // we're already awake, but make sure we'll exit uv_run
-        if (jl_atomic_load_relaxed(&ptls->sleep_check_state) == sleeping)
-            jl_atomic_store(&ptls->sleep_check_state, not_sleeping);
+        wake_self(ptls);
         if (uvlock == ct)
             uv_stop(jl_global_event_loop());
     }
@@ -393,13 +547,13 @@ JL_DLLEXPORT void jl_wakeup_thread(int16_t tid)
     }
     // check if the other threads might be sleeping
     if (tid == -1) {
-        // something added to the multi-queue: notify all threads
-        // in the future, we might want to instead wake some fraction of threads,
-        // and let each of those wake additional threads if they find work
-        for (tid = 0; tid < jl_n_threads; tid++) {
-            if (tid != self)
-                wake_thread(tid);
-        }
+        // something was added to the work-stealing deques: wake exactly one
+        // sleeping thread to claim it; if that thread finds more work, it
+        // wakes another (see jl_task_get_next). The fence orders the enqueue
+        // against the sleeper-count check in wake_one_thread, pairing with
+        // the fence a sleeper issues after announcing itself.
+        jl_fence();
+        wake_one_thread(self);
         // check if we need to notify uv_run too
         if (uvlock != ct && jl_atomic_load(&jl_uv_mutex.owner) != NULL)
             wake_libuv();
@@ -408,7 +562,7 @@ JL_DLLEXPORT void jl_wakeup_thread(int16_t tid)
 }
 
 
-// get the next runnable task from the multiq
+// get the next runnable task
 static jl_task_t *get_next_task(jl_value_t *trypoptask, jl_value_t *q)
 {
     jl_gc_safepoint();
@@ -419,7 +573,7 @@ static jl_task_t *get_next_task(jl_value_t *trypoptask, jl_value_t *q)
         jl_set_task_tid(task, self);
         return task;
     }
-    return multiq_deletemin();
+    return wsdeque_pop_or_steal();
 }
 
 static int may_sleep(jl_ptls_t ptls) JL_NOTSAFEPOINT
@@ -432,19 +586,66 @@ static int may_sleep(jl_ptls_t ptls) JL_NOTSAFEPOINT
 
 extern _Atomic(unsigned) _threadedregion;
 
+JL_DLLEXPORT int16_t jl_io_thread_tid(void)
+{
+    return io_thread_tid;
+}
+
+// scheduler loop of the dedicated I/O thread: run tasks queued to this
+// thread (uv callbacks schedule continuations) and otherwise block in the
+// event loop. Compute tasks in the deques are never popped or stolen here;
+// completions reach the worker threads through the ordinary task wakeup
+// path when a callback schedules or notifies a task.
+static jl_task_t *io_thread_get_next(jl_value_t *trypoptask, jl_value_t *q)
+{
+    jl_task_t *ct = jl_current_task;
+    jl_ptls_t ptls = ct->ptls;
+    while (1) {
+        jl_gc_safepoint();
+        jl_value_t *args[2] = { trypoptask, q };
+        jl_task_t *task = (jl_task_t*)jl_apply(args, 2);
+        if (jl_typeis(task, jl_task_type)) {
+            int self = jl_atomic_load_relaxed(&ct->tid);
+            jl_set_task_tid(task, self);
+            return task;
+        }
+        // drive the event loop, blocking in the OS until I/O arrives; GC
+        // interrupts the poll through jl_wake_libuv, and waiters for the uv
+        // lock do the same, so neither can be blocked by a long poll
+        if (jl_atomic_load(&jl_uv_n_waiters) == 0 && jl_mutex_trylock(&jl_uv_mutex)) {
+            uv_loop_t *loop = jl_global_event_loop();
+            loop->stop_flag = 0;
+            uv_run(loop, UV_RUN_ONCE);
+            JL_UV_UNLOCK();
+        }
+        else {
+            // someone else briefly owns the loop (e.g. a blocking write)
+            jl_cpu_pause();
+        }
+    }
+}
+
 JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q)
 {
     jl_task_t *ct = jl_current_task;
     uint64_t start_cycles = 0;
 
+    if (jl_atomic_load_relaxed(&ct->tid) == io_thread_tid)
+        return io_thread_get_next(trypoptask, q);
+
     while (1) {
         jl_task_t *task = get_next_task(trypoptask, q);
-        if (task)
+        if (task) {
+            // if there are both sleeping threads and more queued work, pass
+            // the wake along instead of letting it die with us
+            if (jl_atomic_load_relaxed(&n_threads_sleeping) > 0 && !wsdeque_check_empty())
+                wake_one_thread(jl_atomic_load_relaxed(&ct->tid));
             return task;
+        }
 
         // quick, race-y check to see if there seems to be any stuff in there
         jl_cpu_pause();
-        if (!multiq_check_empty()) {
+        if (!wsdeque_check_empty()) {
             start_cycles = 0;
             continue;
         }
@@ -453,17 +654,19 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q)
         jl_ptls_t ptls = ct->ptls;
         if (sleep_check_after_threshold(&start_cycles) || (!jl_atomic_load_relaxed(&_threadedregion) && ptls->tid == 0)) {
             jl_atomic_store(&ptls->sleep_check_state, sleeping); // acquire sleep-check lock
-            if (!multiq_check_empty()) {
-                if (jl_atomic_load_relaxed(&ptls->sleep_check_state) != not_sleeping)
-                    jl_atomic_store(&ptls->sleep_check_state, not_sleeping); // let other threads know they don't need to wake us
+            jl_atomic_fetch_add(&n_threads_sleeping, 1);
+            // order the sleeper-count announcement against the re-check of
+            // the deques, pairing with the fence in jl_wakeup_thread
+            jl_fence();
+            if (!wsdeque_check_empty()) {
+                wake_self(ptls); // let other threads know they don't need to wake us
                 continue;
             }
             task = get_next_task(trypoptask, q); // WARNING: this should not yield
             if (ptls != ct->ptls)
                 continue; // oops, get_next_task did yield--start over
             if (task) {
-                if (jl_atomic_load_relaxed(&ptls->sleep_check_state) != not_sleeping)
-                    jl_atomic_store(&ptls->sleep_check_state, not_sleeping); // let other threads know they don't need to wake us
+                wake_self(ptls); // let other threads know they don't need to wake us
                 return task;
             }
 
@@ -473,7 +676,10 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q)
             // outside of threaded regions, all IO is permitted,
             // but only on thread 1
             int uvlock = 0;
-            if (jl_atomic_load_relaxed(&_threadedregion)) {
+            if (io_thread_tid >= 0) {
+                // the dedicated I/O thread owns the event loop; just sleep
+            }
+            else if (jl_atomic_load_relaxed(&_threadedregion)) {
                 uvlock = jl_mutex_trylock(&jl_uv_mutex);
             }
             else if (ptls->tid == 0) {
@@ -518,8 +724,7 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q)
                 if (!jl_atomic_load_relaxed(&_threadedregion) && active && ptls->tid == 0) {
                     // thread 0 is the only thread permitted to run the event loop
                     // so it needs to stay alive
-                    if (jl_atomic_load_relaxed(&ptls->sleep_check_state) != not_sleeping)
-                        jl_atomic_store(&ptls->sleep_check_state, not_sleeping); // let other threads know they don't need to wake us
+                    wake_self(ptls); // let other threads know they don't need to wake us
                     start_cycles = 0;
                     continue;
                 }
@@ -527,6 +732,8 @@ JL_DLLEXPORT jl_task_t *jl_task_get_next(jl_value_t *trypoptask, jl_value_t *q)
 
             // the other threads will just wait for on signal to resume
             JULIA_DEBUG_SLEEPWAKE( ptls->sleep_enter = cycleclock() );
+            JL_PROBE_RT_TASK_SLEEP(ptls->tid);
+            jl_atomic_fetch_add_relaxed(&sched_stats[ptls->tid].sleeps, 1);
             int8_t gc_state = jl_gc_safe_enter(ptls);
             uv_mutex_lock(&sleep_locks[ptls->tid]);
             while (may_sleep(ptls)) {
@@ -0,0 +1,171 @@
+// This file is a part of Julia. License is MIT: https://julialang.org/license
+
+// Hardware performance counters, virtualized across task switches.
+//
+// When enabled (see `PERF_COUNTERS_NAME` in options.h), every thread opens a
+// small group of hardware counters over itself at startup and the scheduler
+// charges the counts elapsed on a thread to whichever task was running there
+// (`jl_perf_task_switch`, called from `ctx_switch` in task.c). That makes
+// cycle / instruction / cache-miss attribution follow a task as it migrates
+// between threads, so e.g. the IPC of a single task can be measured without
+// system-wide profiling. Only Linux perf_event is implemented; on other
+// platforms the API reports counters as unavailable.
+
+#include "julia.h"
+#include "julia_internal.h"
+#include "threading.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static int perf_counters_enabled = 0;
+
+#ifdef _OS_LINUX_
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+typedef struct _jl_perf_thread_t {
+    int fds[JL_PERF_NCOUNTERS];
+    // raw counter values at the point the running task was last charged
+    uint64_t base[JL_PERF_NCOUNTERS];
+} jl_perf_thread_t;
+
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} perf_counter_ids[JL_PERF_NCOUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+static int perf_event_open(struct perf_event_attr *attr, pid_t pid, int cpu,
+                           int group_fd, unsigned long flags)
+{
+    return syscall(SYS_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+static int jl_perf_read_raw(jl_perf_thread_t *perf, uint64_t vals[JL_PERF_NCOUNTERS]) JL_NOTSAFEPOINT
+{
+    for (int i = 0; i < JL_PERF_NCOUNTERS; i++) {
+        if (read(perf->fds[i], &vals[i], sizeof(uint64_t)) != sizeof(uint64_t))
+            return -1;
+    }
+    return 0;
+}
+
+void jl_perf_init(void)
+{
+    char *cp = getenv(PERF_COUNTERS_NAME);
+    perf_counters_enabled = (cp && strcmp(cp, "0") != 0);
+}
+
+void jl_perf_init_thread(jl_ptls_t ptls)
+{
+    if (!perf_counters_enabled)
+        return;
+    jl_perf_thread_t *perf = (jl_perf_thread_t*)malloc_s(sizeof(jl_perf_thread_t));
+    memset(perf, 0, sizeof(jl_perf_thread_t));
+    for (int i = 0; i < JL_PERF_NCOUNTERS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = perf_counter_ids[i].type;
+        attr.size = sizeof(attr);
+        attr.config = perf_counter_ids[i].config;
+        attr.exclude_kernel = 1; // no privileges required
+        attr.exclude_hv = 1;
+        // group the counters under the cycle counter so the kernel schedules
+        // them onto the PMU together and their ratios stay meaningful
+        int group_fd = i == 0 ? -1 : perf->fds[0];
+        perf->fds[i] = perf_event_open(&attr, 0, -1, group_fd, 0);
+        if (perf->fds[i] == -1) {
+            if (ptls->tid == 0)
+                jl_safe_printf("WARNING: could not open hardware performance "
+                               "counters; counting disabled\n");
+            while (--i >= 0)
+                close(perf->fds[i]);
+            free(perf);
+            return;
+        }
+    }
+    ioctl(perf->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    jl_perf_read_raw(perf, perf->base);
+    ptls->perf = perf;
+}
+
+// charge the counts elapsed on this thread since the last switch to the task
+// that accumulated them, and restart counting for the incoming task
+void jl_perf_task_switch(jl_ptls_t ptls, jl_task_t *lastt) JL_NOTSAFEPOINT
+{
+    jl_perf_thread_t *perf = ptls->perf;
+    if (perf == NULL)
+        return;
+    uint64_t now[JL_PERF_NCOUNTERS];
+    if (jl_perf_read_raw(perf, now))
+        return;
+    for (int i = 0; i < JL_PERF_NCOUNTERS; i++) {
+        lastt->perf_counts[i] += now[i] - perf->base[i];
+        perf->base[i] = now[i];
+    }
+}
+
+JL_DLLEXPORT int jl_perf_counters_enabled(void)
+{
+    return jl_current_task->ptls->perf != NULL;
+}
+
+JL_DLLEXPORT int jl_perf_task_counters(uint64_t counts[JL_PERF_NCOUNTERS])
+{
+    jl_task_t *ct = jl_current_task;
+    jl_perf_thread_t *perf = ct->ptls->perf;
+    if (perf == NULL)
+        return -1;
+    uint64_t now[JL_PERF_NCOUNTERS];
+    if (jl_perf_read_raw(perf, now))
+        return -1;
+    for (int i = 0; i < JL_PERF_NCOUNTERS; i++)
+        counts[i] = ct->perf_counts[i] + (now[i] - perf->base[i]);
+    return 0;
+}
+
+#else // !_OS_LINUX_
+
+void jl_perf_init(void)
+{
+    (void)perf_counters_enabled;
+}
+
+void jl_perf_init_thread(jl_ptls_t ptls)
+{
+    (void)ptls;
+}
+
+void jl_perf_task_switch(jl_ptls_t ptls, jl_task_t *lastt) JL_NOTSAFEPOINT
+{
+    (void)ptls;
+    (void)lastt;
+}
+
+JL_DLLEXPORT int jl_perf_counters_enabled(void)
+{
+    return 0;
+}
+
+JL_DLLEXPORT int jl_perf_task_counters(uint64_t counts[JL_PERF_NCOUNTERS])
+{
+    (void)counts;
+    return -1;
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -21,6 +21,7 @@ JL_DLLEXPORT int jl_generating_output(void)
 }
 
 static void *jl_precompile(int all);
+static void *jl_precompile_worklist(jl_array_t *worklist);
 
 void jl_write_compiler_output(void)
 {
@@ -61,13 +62,20 @@ void jl_write_compiler_output(void)
     }
 
     if (jl_options.incremental) {
+        if (jl_options.outputo)
+            // per-package native code shard; generated before the .ji so the
+            // serializer can record each code instance's fvar ids, and linked
+            // by the caller into a shared library next to the .ji
+            jl_incremental_native_code = jl_precompile_worklist(worklist);
         if (jl_options.outputji)
             if (jl_save_incremental(jl_options.outputji, worklist))
                 jl_exit(1);
+        if (jl_options.outputo && jl_incremental_native_code)
+            jl_dump_native(jl_incremental_native_code, NULL, NULL,
+                           jl_options.outputo, NULL, NULL, 0);
+        jl_incremental_native_code = NULL;
         if (jl_options.outputbc || jl_options.outputunoptbc)
             jl_printf(JL_STDERR, "WARNING: incremental output to a .bc file is not implemented\n");
-        if (jl_options.outputo)
-            jl_printf(JL_STDERR, "WARNING: incremental output to a .o file is not implemented\n");
         if (jl_options.outputasm)
             jl_printf(JL_STDERR, "WARNING: incremental output to a .s file is not implemented\n");
     }
@@ -246,16 +254,28 @@ static void _compile_all_union(jl_value_t *sig)
     JL_GC_POP();
 }
 
-static void _compile_all_deq(jl_array_t *found)
+// progress shared between the compile-all workers, for the log ticker
+static _Atomic(size_t) compile_all_progress;
+static size_t compile_all_total;
+
+// Compile a slice of the method-table entries collected by the enqueue
+// phase. `Base._compile_all_parallel` calls this on worker tasks when
+// threads are available; _compile_all_deq below is the serial fallback.
+// Safe to run concurrently: these are the same inference and codegen paths
+// that ordinary threaded julia code compiles through, and the backend is
+// still serialized by the codegen lock.
+JL_DLLEXPORT void jl_compile_all_defs_batch(jl_array_t *found, size_t start, size_t stop)
 {
-    int found_i, found_l = jl_array_len(found);
-    jl_printf(JL_STDERR, "found %d uncompiled methods for compile-all\n", (int)found_l);
+    size_t found_l = jl_array_len(found);
+    if (stop > found_l)
+        stop = found_l;
     jl_method_instance_t *mi = NULL;
     jl_value_t *src = NULL;
     JL_GC_PUSH2(&mi, &src);
-    for (found_i = 0; found_i < found_l; found_i++) {
-        if (found_i % (1 + found_l / 300) == 0 || found_i == found_l - 1) // show 300 progress steps, to show progress without overwhelming log files
-            jl_printf(JL_STDERR, " %d / %d\r", found_i + 1, found_l);
+    for (size_t found_i = start; found_i < stop; found_i++) {
+        size_t done = jl_atomic_fetch_add_relaxed(&compile_all_progress, 1) + 1;
+        if (done % (1 + compile_all_total / 300) == 0 || done == compile_all_total) // show 300 progress steps, to show progress without overwhelming log files
+            jl_printf(JL_STDERR, " %d / %d\r", (int)done, (int)compile_all_total);
         jl_typemap_entry_t *ml = (jl_typemap_entry_t*)jl_array_ptr_ref(found, found_i);
         jl_method_t *m = ml->func.method;
         if (m->source == NULL) // TODO: generic implementations of generated functions
@@ -278,6 +298,32 @@ static void _compile_all_deq(jl_array_t *found)
         jl_generate_fptr_for_unspecialized(ucache);
     }
     JL_GC_POP();
+}
+
+static void _compile_all_deq(jl_array_t *found)
+{
+    size_t found_l = jl_array_len(found);
+    jl_printf(JL_STDERR, "found %d uncompiled methods for compile-all\n", (int)found_l);
+    jl_atomic_store_relaxed(&compile_all_progress, 0);
+    compile_all_total = found_l;
+    // with threads available, let worker tasks drain the queue in contiguous
+    // chunks (entries from the same module stay on the same worker, so
+    // inference dependencies are mostly worker-local); otherwise compile
+    // everything on this task
+    jl_value_t *parallel = NULL;
+    if (jl_n_threads > 1 && jl_base_module)
+        parallel = jl_get_global(jl_base_module, jl_symbol("_compile_all_parallel"));
+    if (parallel) {
+        jl_task_t *ct = jl_current_task;
+        size_t last_age = ct->world_age;
+        ct->world_age = jl_atomic_load_acquire(&jl_world_counter);
+        jl_value_t *args[2] = {parallel, (jl_value_t*)found};
+        jl_apply(args, 2);
+        ct->world_age = last_age;
+    }
+    else {
+        jl_compile_all_defs_batch(found, 0, found_l);
+    }
     jl_printf(JL_STDERR, "\n");
 }
 
@@ -368,17 +414,11 @@ static void precompile_enq_all_specializations_(jl_methtable_t *mt, void *env)
     jl_typemap_visitor(mt->defs, precompile_enq_all_specializations__, env);
 }
 
-static void *jl_precompile(int all)
+static void *jl_precompile_(jl_array_t *m)
 {
-    if (all)
-        jl_compile_all_defs();
-    // this "found" array will contain function
-    // type signatures that were inferred but haven't been compiled
-    jl_array_t *m = jl_alloc_vec_any(0);
     jl_array_t *m2 = NULL;
     jl_method_instance_t *mi = NULL;
-    JL_GC_PUSH3(&m, &m2, &mi);
-    jl_foreach_reachable_mtable(precompile_enq_all_specializations_, m);
+    JL_GC_PUSH2(&m2, &mi);
     m2 = jl_alloc_vec_any(0);
     for (size_t i = 0; i < jl_array_len(m); i++) {
         jl_value_t *item = jl_array_ptr_ref(m, i);
@@ -397,12 +437,67 @@ static void *jl_precompile(int all)
             jl_array_ptr_1d_push(m2, item);
         }
     }
-    m = NULL;
     void *native_code = jl_create_native(m2, NULL, 0);
     JL_GC_POP();
     return native_code;
 }
 
+static void *jl_precompile(int all)
+{
+    if (all)
+        jl_compile_all_defs();
+    // this "found" array will contain function
+    // type signatures that were inferred but haven't been compiled
+    jl_array_t *m = jl_alloc_vec_any(0);
+    JL_GC_PUSH1(&m);
+    jl_foreach_reachable_mtable(precompile_enq_all_specializations_, m);
+    void *native_code = jl_precompile_(m);
+    JL_GC_POP();
+    return native_code;
+}
+
+static int module_in_list(jl_module_t *mod, jl_array_t *worklist)
+{
+    while (1) {
+        size_t i, l = jl_array_len(worklist);
+        for (i = 0; i < l; i++) {
+            if ((jl_module_t*)jl_ptrarrayref(worklist, i) == mod)
+                return 1;
+        }
+        if (mod->parent == mod)
+            return 0;
+        mod = mod->parent;
+    }
+}
+
+// like jl_precompile, but only generating code for the methods defined by the
+// modules being saved incrementally; the resulting shard supplies the fvar
+// ids recorded with each code instance in the .ji (see dump.c)
+static void *jl_precompile_worklist(jl_array_t *worklist)
+{
+    if (jl_array_len(worklist) == 0)
+        return NULL;
+    jl_array_t *m = jl_alloc_vec_any(0);
+    JL_GC_PUSH1(&m);
+    jl_foreach_reachable_mtable(precompile_enq_all_specializations_, m);
+    size_t i, j = 0, n = jl_array_len(m);
+    for (i = 0; i < n; i++) {
+        jl_value_t *item = jl_ptrarrayref(m, i);
+        // @ccallable entry points (svec items) only matter for sysimages
+        if (!jl_is_method_instance(item))
+            continue;
+        jl_method_instance_t *mi = (jl_method_instance_t*)item;
+        if (!jl_is_method(mi->def.value) ||
+                !module_in_list(mi->def.method->module, worklist))
+            continue;
+        jl_array_ptr_set(m, j++, item);
+    }
+    jl_array_del_end(m, n - j);
+    void *native_code = jl_precompile_(m);
+    JL_GC_POP();
+    return native_code;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -691,6 +691,15 @@ static inline jl_sysimg_fptrs_t parse_sysimg(void *hdl, F &&callback)
         res.clone_offsets = clone_offsets;
         res.clone_idxs = clone_idxs;
     }
+    const char *report = getenv(SYSIMG_CLONE_REPORT_NAME);
+    if (report && atoi(report) != 0) {
+        if (clone_all)
+            jl_safe_printf("sysimg dispatch: selected target %u (fully cloned, %u functions)\n",
+                           target_idx, nfunc);
+        else
+            jl_safe_printf("sysimg dispatch: selected target %u, %u of %u functions cloned\n",
+                           target_idx, jl_sysimg_val_mask & tag_len, nfunc);
+    }
     // Do relocation
     uint32_t reloc_i = 0;
     uint32_t len = jl_sysimg_val_mask & tag_len;
@@ -168,6 +168,33 @@ JL_DLLEXPORT jl_value_t *jl_get_cpu_name(void);
 // For debugging only
 JL_DLLEXPORT void jl_dump_host_cpu(void);
 
+// Host cache sizes, in bytes. Fields that cannot be determined are left `0`.
+typedef struct {
+    uint32_t l1d_size;
+    uint32_t l1i_size;
+    uint32_t l2_size;
+    uint32_t l3_size;
+    // line size of the L1 data cache
+    uint32_t line_size;
+} jl_cpu_cache_info_t;
+
+// Host core/thread layout. Fields that cannot be determined are left `0`,
+// except `threads_per_core` which defaults to `1`.
+typedef struct {
+    // logical processors visible to this process
+    uint32_t logical_cpus;
+    // SMT width (`1` when SMT is off or undetectable)
+    uint32_t threads_per_core;
+    // physical cores (`logical_cpus / threads_per_core`)
+    uint32_t cores;
+} jl_cpu_topology_info_t;
+
+// Query the cache hierarchy and core/thread layout of the host.
+// Intended to be `ccall`ed from Base (with a `Ref`) to parameterize
+// cache-size- and core-count-sensitive algorithms at runtime.
+JL_DLLEXPORT void jl_cpu_cache_sizes(jl_cpu_cache_info_t *info);
+JL_DLLEXPORT void jl_cpu_topology(jl_cpu_topology_info_t *info);
+
 JL_DLLEXPORT int32_t jl_set_zero_subnormals(int8_t isZero);
 JL_DLLEXPORT int32_t jl_get_zero_subnormals(void);
 JL_DLLEXPORT int32_t jl_set_default_nans(int8_t isDefault);
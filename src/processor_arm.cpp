@@ -1741,6 +1741,67 @@ JL_DLLEXPORT jl_value_t *jl_get_cpu_name(void)
     return jl_cstr_to_string(host_cpu_name().c_str());
 }
 
+JL_DLLEXPORT void jl_cpu_cache_sizes(jl_cpu_cache_info_t *info)
+{
+    memset(info, 0, sizeof(*info));
+    // no architectural way to get cache sizes; ask libc (glibc fills these
+    // from the kernel's cache description, other libcs return -1/0)
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    long v;
+    if ((v = sysconf(_SC_LEVEL1_DCACHE_SIZE)) > 0)
+        info->l1d_size = (uint32_t)v;
+    if ((v = sysconf(_SC_LEVEL1_ICACHE_SIZE)) > 0)
+        info->l1i_size = (uint32_t)v;
+    if ((v = sysconf(_SC_LEVEL2_CACHE_SIZE)) > 0)
+        info->l2_size = (uint32_t)v;
+    if ((v = sysconf(_SC_LEVEL3_CACHE_SIZE)) > 0)
+        info->l3_size = (uint32_t)v;
+    if ((v = sysconf(_SC_LEVEL1_DCACHE_LINESIZE)) > 0)
+        info->line_size = (uint32_t)v;
+#endif
+#ifdef _CPU_AARCH64_
+    if (info->line_size == 0) {
+        // CTR_EL0.DminLine: log2 of the smallest data cache line, in words
+        uint64_t ctr;
+        asm("mrs %0, ctr_el0" : "=r"(ctr));
+        info->line_size = 4u << ((ctr >> 16) & 0xf);
+    }
+#endif
+}
+
+JL_DLLEXPORT void jl_cpu_topology(jl_cpu_topology_info_t *info)
+{
+    memset(info, 0, sizeof(*info));
+    int ncpu = jl_cpu_threads();
+    info->logical_cpus = ncpu < 1 ? 1 : (uint32_t)ncpu;
+    uint32_t smt = 1;
+#ifdef _OS_LINUX_
+    // SMT width = number of entries in cpu0's sibling list ("0" / "0-1" / "0,64")
+    std::ifstream siblings("/sys/devices/system/cpu/cpu0/topology/thread_siblings_list");
+    std::string list;
+    if (siblings && std::getline(siblings, list)) {
+        uint32_t n = 0;
+        size_t pos = 0;
+        while (pos < list.size()) {
+            size_t end = list.find(',', pos);
+            if (end == std::string::npos)
+                end = list.size();
+            size_t dash = list.find('-', pos);
+            if (dash != std::string::npos && dash < end)
+                n += (uint32_t)(strtoul(&list[dash + 1], nullptr, 10) -
+                                strtoul(&list[pos], nullptr, 10) + 1);
+            else
+                n += 1;
+            pos = end + 1;
+        }
+        if (n > 1)
+            smt = n;
+    }
+#endif
+    info->threads_per_core = smt;
+    info->cores = info->logical_cpus < smt ? 1 : info->logical_cpus / smt;
+}
+
 jl_sysimg_fptrs_t jl_init_processor_sysimg(void *hdl)
 {
     if (!jit_targets.empty())
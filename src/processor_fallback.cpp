@@ -145,6 +145,33 @@ JL_DLLEXPORT void jl_dump_host_cpu(void)
     jl_safe_printf("Features: %s\n", jl_get_cpu_features_llvm().c_str());
 }
 
+JL_DLLEXPORT void jl_cpu_cache_sizes(jl_cpu_cache_info_t *info)
+{
+    memset(info, 0, sizeof(*info));
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    long v;
+    if ((v = sysconf(_SC_LEVEL1_DCACHE_SIZE)) > 0)
+        info->l1d_size = (uint32_t)v;
+    if ((v = sysconf(_SC_LEVEL1_ICACHE_SIZE)) > 0)
+        info->l1i_size = (uint32_t)v;
+    if ((v = sysconf(_SC_LEVEL2_CACHE_SIZE)) > 0)
+        info->l2_size = (uint32_t)v;
+    if ((v = sysconf(_SC_LEVEL3_CACHE_SIZE)) > 0)
+        info->l3_size = (uint32_t)v;
+    if ((v = sysconf(_SC_LEVEL1_DCACHE_LINESIZE)) > 0)
+        info->line_size = (uint32_t)v;
+#endif
+}
+
+JL_DLLEXPORT void jl_cpu_topology(jl_cpu_topology_info_t *info)
+{
+    memset(info, 0, sizeof(*info));
+    int ncpu = jl_cpu_threads();
+    info->logical_cpus = ncpu < 1 ? 1 : (uint32_t)ncpu;
+    info->threads_per_core = 1; // no generic way to detect SMT
+    info->cores = info->logical_cpus;
+}
+
 extern "C" int jl_test_cpu_feature(jl_cpu_feature_t)
 {
     return 0;
@@ -994,6 +994,101 @@ JL_DLLEXPORT jl_value_t *jl_get_cpu_name(void)
     return jl_cstr_to_string(host_cpu_name().c_str());
 }
 
+JL_DLLEXPORT void jl_cpu_cache_sizes(jl_cpu_cache_info_t *info)
+{
+    memset(info, 0, sizeof(*info));
+    int32_t info0[4];
+    jl_cpuid(info0, 0);
+    uint32_t max_leaf = (uint32_t)info0[0];
+    bool amd = info0[1] == 0x68747541; // "Auth"
+    // Deterministic cache parameters: leaf 4 on Intel, leaf 0x8000001d on AMD
+    // with topology extensions. Both use the same encoding.
+    int32_t leaf = 0;
+    if (amd) {
+        jl_cpuid(info0, 0x80000000);
+        if ((uint32_t)info0[0] >= 0x8000001d) {
+            jl_cpuid(info0, 0x80000001);
+            if (info0[2] & (1 << 22)) // topoext
+                leaf = 0x8000001d;
+        }
+    }
+    else if (max_leaf >= 4) {
+        leaf = 4;
+    }
+    if (leaf != 0) {
+        for (int32_t subleaf = 0; ; subleaf++) {
+            jl_cpuidex(info0, leaf, subleaf);
+            uint32_t type = info0[0] & 0x1f;
+            if (type == 0)
+                break;
+            uint32_t level = (info0[0] >> 5) & 0x7;
+            uint32_t line = (info0[1] & 0xfff) + 1;
+            uint32_t partitions = ((info0[1] >> 12) & 0x3ff) + 1;
+            uint32_t ways = (((uint32_t)info0[1] >> 22) & 0x3ff) + 1;
+            uint32_t sets = (uint32_t)info0[2] + 1;
+            uint32_t size = ways * partitions * line * sets;
+            if (level == 1 && type == 1) { // data
+                info->l1d_size = size;
+                info->line_size = line;
+            }
+            else if (level == 1 && type == 2) { // instruction
+                info->l1i_size = size;
+            }
+            else if (level == 2) {
+                info->l2_size = size;
+            }
+            else if (level == 3) {
+                info->l3_size = size;
+            }
+        }
+        return;
+    }
+    if (amd) {
+        // legacy AMD leaves report sizes directly (in KiB; L3 in 512KiB units)
+        jl_cpuid(info0, 0x80000000);
+        uint32_t max_ext = (uint32_t)info0[0];
+        if (max_ext >= 0x80000005) {
+            jl_cpuid(info0, 0x80000005);
+            info->l1d_size = (((uint32_t)info0[2] >> 24) & 0xff) << 10;
+            info->l1i_size = (((uint32_t)info0[3] >> 24) & 0xff) << 10;
+            info->line_size = info0[2] & 0xff;
+        }
+        if (max_ext >= 0x80000006) {
+            jl_cpuid(info0, 0x80000006);
+            info->l2_size = (((uint32_t)info0[2] >> 16) & 0xffff) << 10;
+            info->l3_size = (((uint32_t)info0[3] >> 18) & 0x3fff) << 19;
+        }
+    }
+}
+
+JL_DLLEXPORT void jl_cpu_topology(jl_cpu_topology_info_t *info)
+{
+    memset(info, 0, sizeof(*info));
+    int ncpu = jl_cpu_threads();
+    info->logical_cpus = ncpu < 1 ? 1 : (uint32_t)ncpu;
+    uint32_t smt = 0;
+    int32_t info0[4];
+    jl_cpuid(info0, 0);
+    bool amd = info0[1] == 0x68747541; // "Auth"
+    if ((uint32_t)info0[0] >= 0xb) {
+        // extended topology: subleaf 0 is the SMT level on all known CPUs
+        jl_cpuidex(info0, 0xb, 0);
+        if (((info0[2] >> 8) & 0xff) == 1) // level type SMT
+            smt = info0[1] & 0xffff;
+    }
+    if (smt == 0 && amd) {
+        jl_cpuid(info0, 0x80000000);
+        if ((uint32_t)info0[0] >= 0x8000001e) {
+            jl_cpuid(info0, 0x8000001e);
+            smt = ((info0[1] >> 8) & 0xff) + 1; // threads per compute unit
+        }
+    }
+    if (smt == 0)
+        smt = 1;
+    info->threads_per_core = smt;
+    info->cores = info->logical_cpus < smt ? 1 : info->logical_cpus / smt;
+}
+
 jl_sysimg_fptrs_t jl_init_processor_sysimg(void *hdl)
 {
     if (!jit_targets.empty())
@@ -820,16 +820,24 @@ static size_t jl_static_show_x_(JL_STREAM *out, jl_value_t *v, jl_datatype_t *vt
         n += jl_printf(out, "#<intrinsic #%d %s>", f, jl_intrinsic_name(f));
     }
     else if (vt == jl_int64_type) {
-        n += jl_printf(out, "%" PRId64, *(int64_t*)v);
+        char buf[22];
+        size_t len = jl_format_int64(buf, *(int64_t*)v);
+        jl_uv_puts(out, buf, len); n += len;
     }
     else if (vt == jl_int32_type) {
-        n += jl_printf(out, "%" PRId32, *(int32_t*)v);
+        char buf[22];
+        size_t len = jl_format_int64(buf, *(int32_t*)v);
+        jl_uv_puts(out, buf, len); n += len;
     }
     else if (vt == jl_int16_type) {
-        n += jl_printf(out, "%" PRId16, *(int16_t*)v);
+        char buf[22];
+        size_t len = jl_format_int64(buf, *(int16_t*)v);
+        jl_uv_puts(out, buf, len); n += len;
     }
     else if (vt == jl_int8_type) {
-        n += jl_printf(out, "%" PRId8, *(int8_t*)v);
+        char buf[22];
+        size_t len = jl_format_int64(buf, *(int8_t*)v);
+        jl_uv_puts(out, buf, len); n += len;
     }
     else if (vt == jl_uint64_type) {
         n += jl_printf(out, "0x%016" PRIx64, *(uint64_t*)v);
@@ -1,6 +1,8 @@
 // This file is a part of Julia. License is MIT: https://julialang.org/license
 
 #include "llvm-version.h"
+#include <atomic>
+#include <cstring>
 #include <map>
 #include <string>
 #include <llvm/ADT/StringMap.h>
@@ -26,6 +28,45 @@ using namespace llvm;
 // map from user-specified lib names to handles
 static std::map<std::string, void*> libMap;
 static jl_mutex_t libmap_lock;
+
+// Lock-free read path in front of `libMap`: every ccall resolution (and the
+// interpreter's cglobal fallback) goes through jl_get_library_, so loaded
+// (name, handle) pairs are appended here under `libmap_lock` and looked up
+// without it. A process loads a bounded number of libraries; if the table
+// ever fills, later libraries simply keep taking the locked path.
+static const size_t N_LIBCACHE = 128;
+static std::atomic<const char*> libcache_names[N_LIBCACHE];
+static std::atomic<void*> libcache_handles[N_LIBCACHE];
+
+static void *libcache_find(const char *f_lib)
+{
+    for (size_t i = 0; i < N_LIBCACHE; i++) {
+        const char *name = libcache_names[i].load(std::memory_order_acquire);
+        if (name == NULL)
+            return NULL;
+        if (name == f_lib || strcmp(name, f_lib) == 0)
+            return libcache_handles[i].load(std::memory_order_relaxed);
+    }
+    return NULL;
+}
+
+// caller must hold `libmap_lock`
+static void libcache_insert(const char *f_lib, void *hnd)
+{
+    for (size_t i = 0; i < N_LIBCACHE; i++) {
+        const char *name = libcache_names[i].load(std::memory_order_relaxed);
+        if (name != NULL) {
+            if (strcmp(name, f_lib) == 0)
+                return;
+            continue;
+        }
+        libcache_handles[i].store(hnd, std::memory_order_relaxed);
+        // the handle must be visible before the name claims the slot
+        libcache_names[i].store(strdup(f_lib), std::memory_order_release);
+        return;
+    }
+}
+
 extern "C"
 void *jl_get_library_(const char *f_lib, int throw_err)
 {
@@ -39,28 +80,82 @@ void *jl_get_library_(const char *f_lib, int throw_err)
     if (f_lib == JL_LIBJULIA_DL_LIBNAME)
         return jl_libjulia_handle;
 #endif
+    void *hnd = libcache_find(f_lib);
+    if (hnd != NULL)
+        return hnd;
     JL_LOCK(&libmap_lock);
     // This is the only operation we do on the map, which doesn't invalidate
     // any references or iterators.
     void **map_slot = &libMap[f_lib];
-    void *hnd = *map_slot;
+    hnd = *map_slot;
     if (hnd == NULL) {
         hnd = jl_load_dynamic_library(f_lib, JL_RTLD_DEFAULT, throw_err);
         if (hnd != NULL)
             *map_slot = hnd;
     }
+    if (hnd != NULL)
+        libcache_insert(f_lib, hnd);
     JL_UNLOCK(&libmap_lock);
     return hnd;
 }
 
+// Cache of resolved (handle, symbol) pairs, so that repeated runtime
+// resolutions of the same symbol (multiple call sites, computed library
+// names) skip dlsym. Slots are direct mapped and write-once: a slot claimed
+// by one symbol is never overwritten, so a reader only needs an acquire load
+// of the name to see a consistent (handle, pointer) pair, and a colliding
+// symbol just falls through to jl_dlsym. Writers serialize under
+// `libmap_lock`; each unique symbol is inserted at most once.
+static const size_t N_SYMCACHE = 512;
+typedef struct {
+    std::atomic<const char*> name;
+    std::atomic<void*> handle;
+    std::atomic<void*> ptr;
+} symcache_entry_t;
+static symcache_entry_t symcache[N_SYMCACHE];
+
+static size_t symcache_slot(void *handle, const char *f_name)
+{
+    size_t h = (size_t)handle / sizeof(void*);
+    for (const char *p = f_name; *p; p++)
+        h = h * 33 + (unsigned char)*p;
+    return h % N_SYMCACHE;
+}
+
+static void *symcache_find(void *handle, const char *f_name)
+{
+    symcache_entry_t &e = symcache[symcache_slot(handle, f_name)];
+    const char *name = e.name.load(std::memory_order_acquire);
+    if (name != NULL && e.handle.load(std::memory_order_relaxed) == handle &&
+            strcmp(name, f_name) == 0)
+        return e.ptr.load(std::memory_order_relaxed);
+    return NULL;
+}
+
+static void symcache_insert(void *handle, const char *f_name, void *ptr)
+{
+    symcache_entry_t &e = symcache[symcache_slot(handle, f_name)];
+    JL_LOCK(&libmap_lock);
+    if (e.name.load(std::memory_order_relaxed) == NULL) {
+        e.handle.store(handle, std::memory_order_relaxed);
+        e.ptr.store(ptr, std::memory_order_relaxed);
+        // the name both claims the slot and publishes the pair above
+        e.name.store(strdup(f_name), std::memory_order_release);
+    }
+    JL_UNLOCK(&libmap_lock);
+}
+
 extern "C" JL_DLLEXPORT
 void *jl_load_and_lookup(const char *f_lib, const char *f_name, _Atomic(void*) *hnd)
 {
     void *handle = jl_atomic_load_acquire(hnd);
     if (!handle)
         jl_atomic_store_release(hnd, (handle = jl_get_library(f_lib)));
-    void * ptr;
-    jl_dlsym(handle, f_name, &ptr, 1);
+    void *ptr = symcache_find(handle, f_name);
+    if (ptr == NULL) {
+        jl_dlsym(handle, f_name, &ptr, 1);
+        symcache_insert(handle, f_name, ptr);
+    }
     return ptr;
 }
 
@@ -76,8 +171,12 @@ void *jl_lazy_load_and_lookup(jl_value_t *lib_val, const char *f_name)
         f_lib = jl_string_data(lib_val);
     else
         jl_type_error("ccall", (jl_value_t*)jl_symbol_type, lib_val);
-    void *ptr;
-    jl_dlsym(jl_get_library(f_lib), f_name, &ptr, 1);
+    void *handle = jl_get_library(f_lib);
+    void *ptr = symcache_find(handle, f_name);
+    if (ptr == NULL) {
+        jl_dlsym(handle, f_name, &ptr, 1);
+        symcache_insert(handle, f_name, ptr);
+    }
     return ptr;
 }
 
@@ -208,48 +307,115 @@ extern "C" JL_DLLEXPORT char *jl_format_filename(const char *output_pattern)
 }
 
 
-static uv_mutex_t trampoline_lock; // for accesses to the cache and freelist
+static uv_mutex_t trampoline_lock; // for accesses to the cache and the global freelist
 
 static void *trampoline_freelist;
 
-static void *trampoline_alloc() JL_NOTSAFEPOINT // lock taken by caller
+// Allocation statistics (see jl_cfunction_trampoline_stats): total
+// trampolines handed out, total returned, and executable pages mapped.
+// Live count is n_alloc - n_free; churn well above the mapped capacity
+// means the freelists are doing their job.
+static std::atomic<size_t> trampoline_n_alloc{0};
+static std::atomic<size_t> trampoline_n_free{0};
+static std::atomic<size_t> trampoline_n_pages{0};
+
+const int trampoline_sz = 64; // oversized for most platforms. todo: use precise value?
+// Trampolines move between the global and the per-thread freelists a batch
+// at a time, so callback-heavy threads touch `trampoline_lock` on roughly
+// one allocation in `trampoline_batch`.
+static const size_t trampoline_batch = 16;
+static const size_t trampoline_tl_max = 2 * trampoline_batch;
+static thread_local void *trampoline_tl_freelist;
+static thread_local size_t trampoline_tl_nfree;
+
+// Map fresh executable pages in bulk and carve them into the global
+// freelist. Caller must hold `trampoline_lock`.
+static void trampoline_provision(void)
 {
-    const int sz = 64; // oversized for most platforms. todo: use precise value?
-    if (!trampoline_freelist) {
-        int last_errno = errno;
+    const int sz = trampoline_sz;
+    const size_t npages = 4;
+    size_t len = npages * jl_page_size;
+    int last_errno = errno;
 #ifdef _OS_WINDOWS_
-        DWORD last_error = GetLastError();
-        void *mem = VirtualAlloc(NULL, jl_page_size,
-                MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE);
-        if (mem == NULL)
-            jl_throw(jl_memory_exception);
-        SetLastError(last_error);
+    DWORD last_error = GetLastError();
+    void *mem = VirtualAlloc(NULL, len,
+            MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+    if (mem == NULL)
+        jl_throw(jl_memory_exception);
+    SetLastError(last_error);
 #else
-        void *mem = mmap(0, jl_page_size, PROT_READ | PROT_WRITE | PROT_EXEC,
-                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-        errno = last_errno;
-        if (mem == MAP_FAILED)
-            jl_throw(jl_memory_exception);
+    void *mem = mmap(0, len, PROT_READ | PROT_WRITE | PROT_EXEC,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    errno = last_errno;
+    if (mem == MAP_FAILED)
+        jl_throw(jl_memory_exception);
 #endif
-        errno = last_errno;
-        void *next = NULL;
-        assert(sz < jl_page_size);
-        for (size_t i = 0; i + sz <= jl_page_size; i += sz) {
-            void **curr = (void**)((char*)mem + i);
-            *curr = next;
-            next = (void*)curr;
+    errno = last_errno;
+    void *next = trampoline_freelist;
+    assert(sz < jl_page_size);
+    for (size_t i = 0; i + sz <= len; i += sz) {
+        void **curr = (void**)((char*)mem + i);
+        *curr = next;
+        next = (void*)curr;
+    }
+    trampoline_freelist = next;
+    trampoline_n_pages.fetch_add(npages, std::memory_order_relaxed);
+}
+
+static void *trampoline_alloc(void) JL_NOTSAFEPOINT
+{
+    if (!trampoline_tl_freelist) {
+        // refill the thread-local list from the global one in one batch
+        uv_mutex_lock(&trampoline_lock);
+        if (!trampoline_freelist)
+            trampoline_provision();
+        void *head = trampoline_freelist;
+        void *tail = head;
+        size_t n = 1;
+        while (n < trampoline_batch && *(void**)tail) {
+            tail = *(void**)tail;
+            n++;
         }
-        trampoline_freelist = next;
+        trampoline_freelist = *(void**)tail;
+        uv_mutex_unlock(&trampoline_lock);
+        *(void**)tail = NULL;
+        trampoline_tl_freelist = head;
+        trampoline_tl_nfree = n;
     }
-    void *tramp = trampoline_freelist;
-    trampoline_freelist = *(void**)tramp;
+    void *tramp = trampoline_tl_freelist;
+    trampoline_tl_freelist = *(void**)tramp;
+    trampoline_tl_nfree--;
+    trampoline_n_alloc.fetch_add(1, std::memory_order_relaxed);
     return tramp;
 }
 
-static void trampoline_free(void *tramp)    // lock taken by caller
+static void trampoline_free(void *tramp) JL_NOTSAFEPOINT
 {
-    *(void**)tramp = trampoline_freelist;
-    trampoline_freelist = tramp;
+    *(void**)tramp = trampoline_tl_freelist;
+    trampoline_tl_freelist = tramp;
+    trampoline_n_free.fetch_add(1, std::memory_order_relaxed);
+    if (++trampoline_tl_nfree >= trampoline_tl_max) {
+        // keep half locally and return the rest so that a thread whose
+        // callbacks are freed elsewhere does not starve the others
+        void *head = trampoline_tl_freelist;
+        void *tail = head;
+        for (size_t n = 1; n < trampoline_batch; n++)
+            tail = *(void**)tail;
+        trampoline_tl_freelist = *(void**)tail;
+        trampoline_tl_nfree -= trampoline_batch;
+        uv_mutex_lock(&trampoline_lock);
+        *(void**)tail = trampoline_freelist;
+        trampoline_freelist = head;
+        uv_mutex_unlock(&trampoline_lock);
+    }
+}
+
+extern "C" JL_DLLEXPORT
+void jl_cfunction_trampoline_stats(size_t *nalloc, size_t *nfree, size_t *npages)
+{
+    *nalloc = trampoline_n_alloc.load(std::memory_order_relaxed);
+    *nfree = trampoline_n_free.load(std::memory_order_relaxed);
+    *npages = trampoline_n_pages.load(std::memory_order_relaxed);
 }
 
 static void trampoline_deleter(void **f)
@@ -261,14 +427,15 @@ static void trampoline_deleter(void **f)
     f[0] = NULL;
     f[2] = NULL;
     f[3] = NULL;
-    uv_mutex_lock(&trampoline_lock);
     if (tramp)
         trampoline_free(tramp);
-    if (fobj && cache)
+    if (fobj && cache) {
+        uv_mutex_lock(&trampoline_lock);
         ptrhash_remove((htable_t*)cache, fobj);
+        uv_mutex_unlock(&trampoline_lock);
+    }
     if (nval)
         free(nval);
-    uv_mutex_unlock(&trampoline_lock);
 }
 
 typedef void *(*init_trampoline_t)(void *tramp, void **nval) JL_NOTSAFEPOINT;
@@ -350,10 +517,10 @@ jl_value_t *jl_get_cfunction_trampoline(
         free(nval);
         jl_rethrow();
     }
-    uv_mutex_lock(&trampoline_lock);
     tramp = trampoline_alloc();
     ((void**)result)[0] = tramp;
     tramp = init_trampoline(tramp, nval);
+    uv_mutex_lock(&trampoline_lock);
     ptrhash_put(cache, (void*)fobj, result);
     uv_mutex_unlock(&trampoline_lock);
     return result;
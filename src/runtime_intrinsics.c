@@ -11,6 +11,7 @@
 #include "julia.h"
 #include "julia_internal.h"
 #include "APInt-C.h"
+#include "intrinsics.h"
 
 const unsigned int host_char_bit = 8;
 
@@ -895,6 +896,16 @@ SELECTOR_FUNC(intrinsic_2)
 #define bi_iintrinsic(name, u, cvtb) \
 JL_DLLEXPORT jl_value_t *jl_##name(jl_value_t *a, jl_value_t *b) \
 { \
+    /* fast path for the overwhelmingly common case in dynamic code: both */ \
+    /* operands are Int64, so operate directly and box through the Int64 */ \
+    /* cache, skipping the size dispatch and sign extension of the generic */ \
+    /* path (the shifts with cvtb only convert when the widths differ) */ \
+    if (jl_typeof(a) == (jl_value_t*)jl_int64_type && \
+        jl_typeof(b) == (jl_value_t*)jl_int64_type) { \
+        int64_t r; \
+        jl_##name##64(64, jl_data_ptr(a), jl_data_ptr(b), &r); \
+        return jl_box_int64(r); \
+    } \
     return jl_iintrinsic_2(a, b, #name, u##signbitbyte, jl_intrinsiclambda_2, name##_list, cvtb); \
 }
 #define bi_iintrinsic_cnvtb_fast(LLVMOP, OP, name, u, cvtb) \
@@ -918,6 +929,10 @@ SELECTOR_FUNC(intrinsic_cmp)
 #define cmp_iintrinsic(name, u) \
 JL_DLLEXPORT jl_value_t *jl_##name(jl_value_t *a, jl_value_t *b) \
 { \
+    /* fast path as in bi_iintrinsic; comparisons additionally skip boxing */ \
+    if (jl_typeof(a) == (jl_value_t*)jl_int64_type && \
+        jl_typeof(b) == (jl_value_t*)jl_int64_type) \
+        return jl_##name##64(64, jl_data_ptr(a), jl_data_ptr(b)) ? jl_true : jl_false; \
     return jl_iintrinsic_2(a, b, #name, u##signbitbyte, jl_intrinsiclambda_cmp, name##_list, 0); \
 }
 #define bool_iintrinsic_fast(LLVMOP, OP, name, u) \
@@ -1057,6 +1072,12 @@ JL_DLLEXPORT jl_value_t *jl_##name(jl_value_t *a, jl_value_t *b) \
 { \
     jl_task_t *ct = jl_current_task; \
     jl_value_t *ty = jl_typeof(a); \
+    /* fast path for the common Float64 pair, skipping the size dispatch */ \
+    if (ty == (jl_value_t*)jl_float64_type && jl_typeof(b) == ty) { \
+        double r; \
+        jl_##name##64(64, jl_data_ptr(a), jl_data_ptr(b), &r); \
+        return jl_box_float64(r); \
+    } \
     if (jl_typeof(b) != ty) \
         jl_error(#name ": types of a and b must match"); \
     if (!jl_is_primitivetype(ty)) \
@@ -1356,3 +1377,60 @@ JL_DLLEXPORT jl_value_t *jl_have_fma(jl_value_t *typ)
     // TODO: run-time feature check?
     return jl_false;
 }
+
+// bulk variants for the interpreter //
+
+// Whole-array fallback for dynamic code (--compile=min, interpreted
+// top-level loops): apply the binary intrinsic `f` elementwise over `n`
+// packed elements of `elsz` bytes, reading from `a` and `b` and writing
+// `dest` (which may alias either input). The loops are plain C over fixed
+// c-types, so the compiler vectorizes them; one call replaces `n` round
+// trips through unbox/dispatch/rebox. Returns 1 on success and 0 when the
+// intrinsic or element size has no bulk handler, in which case the caller
+// falls back to the scalar intrinsic per element.
+#define bulk_map_ctype(OP, c_type) { \
+        c_type *restrict r = (c_type*)dest; \
+        const c_type *restrict x = (const c_type*)a; \
+        const c_type *restrict y = (const c_type*)b; \
+        for (size_t i = 0; i < n; i++) \
+            r[i] = (c_type)OP(x[i], y[i]); \
+        return 1; \
+    }
+
+#define bulk_map_iintrinsic(OP) \
+    switch (elsz) { \
+    case 1: bulk_map_ctype(OP, uint8_t) \
+    case 2: bulk_map_ctype(OP, uint16_t) \
+    case 4: bulk_map_ctype(OP, uint32_t) \
+    case 8: bulk_map_ctype(OP, uint64_t) \
+    } \
+    return 0;
+
+#define bulk_map_fintrinsic(OP) \
+    switch (elsz) { \
+    case 4: bulk_map_ctype(OP, float) \
+    case 8: bulk_map_ctype(OP, double) \
+    } \
+    return 0;
+
+JL_DLLEXPORT int jl_intrinsic_map_binary(unsigned f, void *dest, void *a, void *b,
+                                         size_t elsz, size_t n)
+{
+    switch ((enum intrinsic)f) {
+    case add_int:   bulk_map_iintrinsic(add)
+    case sub_int:   bulk_map_iintrinsic(sub)
+    case mul_int:   bulk_map_iintrinsic(mul)
+    case and_int:   bulk_map_iintrinsic(and_op)
+    case or_int:    bulk_map_iintrinsic(or_op)
+    case xor_int:   bulk_map_iintrinsic(xor_op)
+    case add_float: bulk_map_fintrinsic(add)
+    case sub_float: bulk_map_fintrinsic(sub)
+    case mul_float: bulk_map_fintrinsic(mul)
+    case div_float: bulk_map_fintrinsic(div)
+    default:
+        // division and shifts are excluded: integer division can trap and
+        // shift semantics depend on signedness the element size alone
+        // cannot recover
+        return 0;
+    }
+}
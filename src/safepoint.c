@@ -4,6 +4,7 @@
 #include "julia_internal.h"
 #include "threading.h"
 #ifndef _OS_WINDOWS_
+#include <sched.h>
 #include <sys/mman.h>
 #if defined(_OS_DARWIN_) && !defined(MAP_ANONYMOUS)
 #define MAP_ANONYMOUS MAP_ANON
@@ -44,6 +45,21 @@ uint8_t jl_safepoint_enable_cnt[3] = {0, 0, 0};
 // fight on the safepoint lock...
 uv_mutex_t safepoint_lock;
 
+// flip the protection of `npages` safepoint pages starting at page `idx`;
+// each call costs a TLB shootdown across all threads, so callers flipping
+// adjacent pages should do it in one call
+static void jl_safepoint_protect(int idx, int npages, int protect) JL_NOTSAFEPOINT
+{
+    char *pageaddr = jl_safepoint_pages + jl_page_size * idx;
+#ifdef _OS_WINDOWS_
+    DWORD old_prot;
+    VirtualProtect(pageaddr, jl_page_size * npages,
+                   protect ? PAGE_NOACCESS : PAGE_READONLY, &old_prot);
+#else
+    mprotect(pageaddr, jl_page_size * npages, protect ? PROT_NONE : PROT_READ);
+#endif
+}
+
 static void jl_safepoint_enable(int idx) JL_NOTSAFEPOINT
 {
     // safepoint_lock should be held
@@ -56,13 +72,7 @@ static void jl_safepoint_enable(int idx) JL_NOTSAFEPOINT
         return;
     }
     // Now that we are requested to mprotect the page and it wasn't already.
-    char *pageaddr = jl_safepoint_pages + jl_page_size * idx;
-#ifdef _OS_WINDOWS_
-    DWORD old_prot;
-    VirtualProtect(pageaddr, jl_page_size, PAGE_NOACCESS, &old_prot);
-#else
-    mprotect(pageaddr, jl_page_size, PROT_NONE);
-#endif
+    jl_safepoint_protect(idx, 1, 1);
 }
 
 static void jl_safepoint_disable(int idx) JL_NOTSAFEPOINT
@@ -75,13 +85,40 @@ static void jl_safepoint_disable(int idx) JL_NOTSAFEPOINT
     }
     // Now that we are requested to un-mprotect the page and no one else
     // want it to be kept protected.
-    char *pageaddr = jl_safepoint_pages + jl_page_size * idx;
-#ifdef _OS_WINDOWS_
-    DWORD old_prot;
-    VirtualProtect(pageaddr, jl_page_size, PAGE_READONLY, &old_prot);
-#else
-    mprotect(pageaddr, jl_page_size, PROT_READ);
-#endif
+    jl_safepoint_protect(idx, 1, 0);
+}
+
+// enable both GC pages (the master page and the page for the other threads)
+// with a single protection change spanning the two adjacent pages whenever
+// both actually need to flip, halving the shootdown traffic per collection
+static void jl_safepoint_enable_gc_pages(void) JL_NOTSAFEPOINT
+{
+    // safepoint_lock should be held
+    int flip1 = jl_safepoint_enable_cnt[1]++ == 0;
+    int flip2 = jl_safepoint_enable_cnt[2]++ == 0;
+    assert(jl_safepoint_enable_cnt[1] <= 2);
+    assert(jl_safepoint_enable_cnt[2] <= 2);
+    if (flip1 && flip2)
+        jl_safepoint_protect(1, 2, 1);
+    else if (flip1)
+        jl_safepoint_protect(1, 1, 1);
+    else if (flip2)
+        jl_safepoint_protect(2, 1, 1);
+}
+
+static void jl_safepoint_disable_gc_pages(void) JL_NOTSAFEPOINT
+{
+    // safepoint_lock should be held
+    assert(jl_safepoint_enable_cnt[1] > 0);
+    assert(jl_safepoint_enable_cnt[2] > 0);
+    int flip1 = --jl_safepoint_enable_cnt[1] == 0;
+    int flip2 = --jl_safepoint_enable_cnt[2] == 0;
+    if (flip1 && flip2)
+        jl_safepoint_protect(1, 2, 0);
+    else if (flip1)
+        jl_safepoint_protect(1, 1, 0);
+    else if (flip2)
+        jl_safepoint_protect(2, 1, 0);
 }
 
 void jl_safepoint_init(void)
@@ -126,8 +163,7 @@ int jl_safepoint_start_gc(void)
         jl_safepoint_wait_gc();
         return 0;
     }
-    jl_safepoint_enable(1);
-    jl_safepoint_enable(2);
+    jl_safepoint_enable_gc_pages();
     uv_mutex_unlock(&safepoint_lock);
     return 1;
 }
@@ -143,8 +179,7 @@ void jl_safepoint_end_gc(void)
     // Need to reset the page protection before resetting the flag since
     // the thread will trigger a segfault immediately after returning from
     // the signal handler.
-    jl_safepoint_disable(2);
-    jl_safepoint_disable(1);
+    jl_safepoint_disable_gc_pages();
     jl_atomic_store_release(&jl_gc_running, 0);
 #  ifdef __APPLE__
     // This wakes up other threads on mac.
@@ -157,10 +192,26 @@ void jl_safepoint_wait_gc(void)
 {
     // The thread should have set this is already
     assert(jl_atomic_load_relaxed(&jl_current_task->ptls->gc_state) != 0);
+    // Busy-wait briefly so that collections shorter than the spin budget
+    // resume without a syscall, then start yielding the CPU: with many
+    // threads, a pack of spinning waiters competes for cores with the
+    // stragglers the collector is still waiting for and with the collector
+    // itself. This runs in the segfault handler, so it must not take locks
+    // or block on a condition variable.
+    int spins = 0;
     // Use normal volatile load in the loop for speed until GC finishes.
     // Then use an acquire load to make sure the GC result is visible on this thread.
     while (jl_atomic_load_relaxed(&jl_gc_running) || jl_atomic_load_acquire(&jl_gc_running)) {
-        jl_cpu_pause(); // yield?
+        if (++spins < 100000) {
+            jl_cpu_pause();
+        }
+        else {
+#ifdef _OS_WINDOWS_
+            SwitchToThread();
+#else
+            sched_yield();
+#endif
+        }
     }
 }
 
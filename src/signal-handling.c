@@ -28,6 +28,8 @@ static const    uint64_t GIGA = 1000000000ULL;
 static uint64_t profile_cong_rng_seed = 0;
 static uint64_t profile_cong_rng_unbias = 0;
 static volatile uint64_t *profile_round_robin_thread_order = NULL;
+// whether the profiler unwinds by chasing frame pointers instead of libunwind
+int jl_profile_fp_unwind = 0;
 // Timers to take samples at intervals
 JL_DLLEXPORT void jl_profile_stop_timer(void);
 JL_DLLEXPORT int jl_profile_start_timer(void);
@@ -35,16 +37,57 @@ void jl_lock_profile(void);
 void jl_unlock_profile(void);
 void jl_shuffle_int_array_inplace(volatile uint64_t *carray, size_t size, uint64_t *seed);
 
+// Per-thread profile sample buffers
+//
+// Each sampled thread's blocks go into its own fixed-size buffer, written
+// only by the sampling thread and merged into `bt_data_prof` when the data
+// is read, so long captures on many threads neither contend on one cursor
+// nor stop as soon as a single busy thread fills the shared buffer. A
+// sample that does not fit in its thread's buffer is dropped and counted
+// in that buffer's overflow counter.
+typedef struct {
+    jl_bt_element_t *data;
+    size_t size;
+    _Atomic(size_t) n;            // elements written (single writer)
+    _Atomic(uint64_t) noverflows; // samples dropped because the buffer was full
+} jl_profile_buf_t;
+static jl_profile_buf_t *profile_bufs = NULL;
+static int profile_nbufs = 0;
+// elements reserved per sample for the 4 metadata entries + 2 terminators
+#define PROFILE_SAMPLE_OVERHEAD 6
+
+// Reserve space for one sample in `tid`'s buffer. Returns the number of
+// elements available for backtrace data (with `*dest` pointing at them), or
+// 0 after counting an overflow if another sample cannot fit.
+static size_t jl_profile_reserve_sample(int tid, jl_bt_element_t **dest)
+{
+    jl_profile_buf_t *buf = &profile_bufs[tid];
+    size_t n = jl_atomic_load_relaxed(&buf->n);
+    if (n + (JL_BT_MAX_ENTRY_SIZE + 1) + PROFILE_SAMPLE_OVERHEAD > buf->size) {
+        jl_atomic_fetch_add_relaxed(&buf->noverflows, 1);
+        return 0;
+    }
+    *dest = buf->data + n;
+    return buf->size - n - PROFILE_SAMPLE_OVERHEAD;
+}
+
+// Publish a reserved sample of `nelems` elements (backtrace + overhead).
+static void jl_profile_commit_sample(int tid, size_t nelems)
+{
+    jl_profile_buf_t *buf = &profile_bufs[tid];
+    jl_atomic_store_release(&buf->n, jl_atomic_load_relaxed(&buf->n) + nelems);
+}
+
 JL_DLLEXPORT int jl_profile_is_buffer_full(void)
 {
-    // declare buffer full if there isn't enough room to take samples across all threads
-    #if defined(_OS_WINDOWS_)
-        uint64_t nthreads = 1; // windows only profiles the main thread
-    #else
-        uint64_t nthreads = jl_n_threads;
-    #endif
-    // the `+ 6` is for the two block terminators `0` plus 4 metadata entries
-    return bt_size_cur + (((JL_BT_MAX_ENTRY_SIZE + 1) + 6) * nthreads) > bt_size_max;
+    // full only once no thread's buffer has room for another sample
+    for (int i = 0; i < profile_nbufs; i++) {
+        jl_profile_buf_t *buf = &profile_bufs[i];
+        if (jl_atomic_load_relaxed(&buf->n) + (JL_BT_MAX_ENTRY_SIZE + 1) +
+                PROFILE_SAMPLE_OVERHEAD <= buf->size)
+            return 0;
+    }
+    return 1;
 }
 
 static uint64_t jl_last_sigint_trigger = 0;
@@ -298,6 +341,13 @@ JL_DLLEXPORT int jl_profile_init(size_t maxsize, uint64_t delay_nsec)
     nsecprof = delay_nsec;
     if (bt_data_prof != NULL)
         free((void*)bt_data_prof);
+    if (profile_bufs != NULL) {
+        for (int i = 0; i < profile_nbufs; i++)
+            free(profile_bufs[i].data);
+        free(profile_bufs);
+        profile_bufs = NULL;
+        profile_nbufs = 0;
+    }
     if (profile_round_robin_thread_order == NULL) {
         // NOTE: We currently only allocate this once, since jl_n_threads cannot change
         // during execution of a julia process. If/when this invariant changes in the
@@ -309,9 +359,27 @@ JL_DLLEXPORT int jl_profile_init(size_t maxsize, uint64_t delay_nsec)
     }
     seed_cong(&profile_cong_rng_seed);
     unbias_cong(jl_n_threads, &profile_cong_rng_unbias);
+    const char *fp_unwind = getenv(PROFILE_FP_UNWIND_NAME);
+    jl_profile_fp_unwind = (fp_unwind && strcmp(fp_unwind, "0") != 0);
+    // merge-on-read target for jl_profile_get_data
     bt_data_prof = (jl_bt_element_t*) calloc(maxsize, sizeof(jl_bt_element_t));
     if (bt_data_prof == NULL && maxsize > 0)
         return -1;
+    // split the same budget across the per-thread sample buffers
+    profile_nbufs = jl_n_threads;
+    profile_bufs = (jl_profile_buf_t*) calloc(profile_nbufs, sizeof(jl_profile_buf_t));
+    if (profile_bufs == NULL)
+        return -1;
+    size_t each = maxsize / profile_nbufs;
+    size_t min_each = (JL_BT_MAX_ENTRY_SIZE + 1) + PROFILE_SAMPLE_OVERHEAD;
+    if (each < min_each)
+        each = min_each;
+    for (int i = 0; i < profile_nbufs; i++) {
+        profile_bufs[i].data = (jl_bt_element_t*) calloc(each, sizeof(jl_bt_element_t));
+        if (profile_bufs[i].data == NULL)
+            return -1;
+        profile_bufs[i].size = each;
+    }
     bt_size_cur = 0;
     return 0;
 }
@@ -327,16 +395,45 @@ void jl_shuffle_int_array_inplace(volatile uint64_t *carray, size_t size, uint64
     }
 }
 
+// Merge the per-thread buffers into `bt_data_prof`. Each sample block
+// already records its thread id, so concatenation suffices; the profile
+// lock keeps the sampler from publishing partial blocks meanwhile.
+static void jl_profile_merge(void)
+{
+    jl_lock_profile();
+    size_t total = 0;
+    for (int i = 0; i < profile_nbufs; i++) {
+        size_t n = jl_atomic_load_acquire(&profile_bufs[i].n);
+        if (total + n > bt_size_max)
+            n = bt_size_max - total;
+        memcpy((void*)(bt_data_prof + total), profile_bufs[i].data,
+               n * sizeof(jl_bt_element_t));
+        total += n;
+    }
+    bt_size_cur = total;
+    jl_unlock_profile();
+}
+
 JL_DLLEXPORT uint8_t *jl_profile_get_data(void)
 {
+    jl_profile_merge();
     return (uint8_t*) bt_data_prof;
 }
 
 JL_DLLEXPORT size_t jl_profile_len_data(void)
 {
+    jl_profile_merge();
     return bt_size_cur;
 }
 
+JL_DLLEXPORT uint64_t jl_profile_overflow_count(void)
+{
+    uint64_t total = 0;
+    for (int i = 0; i < profile_nbufs; i++)
+        total += jl_atomic_load_relaxed(&profile_bufs[i].noverflows);
+    return total;
+}
+
 JL_DLLEXPORT size_t jl_profile_maxlen_data(void)
 {
     return bt_size_max;
@@ -349,7 +446,13 @@ JL_DLLEXPORT uint64_t jl_profile_delay_nsec(void)
 
 JL_DLLEXPORT void jl_profile_clear_data(void)
 {
+    jl_lock_profile();
+    for (int i = 0; i < profile_nbufs; i++) {
+        jl_atomic_store_relaxed(&profile_bufs[i].n, 0);
+        jl_atomic_store_relaxed(&profile_bufs[i].noverflows, 0);
+    }
     bt_size_cur = 0;
+    jl_unlock_profile();
 }
 
 JL_DLLEXPORT int jl_profile_is_running(void)
@@ -554,7 +554,12 @@ void *mach_profile_listener(void *arg)
             jl_thread_suspend_and_get_state2(i, &state);
             unw_context_t *uc = (unw_context_t*)&state;
 
-            if (running) {
+            jl_bt_element_t *dest = NULL;
+            size_t room = 0, sz = 0;
+            if (running)
+                room = jl_profile_reserve_sample(i, &dest);
+            // if room == 0, this thread's buffer is full: drop the sample
+            if (running && room > 0) {
 #ifdef LLVMLIBUNWIND
                 /*
                  *  Unfortunately compact unwind info is incorrectly generated for quite a number of
@@ -575,10 +580,10 @@ void *mach_profile_listener(void *arg)
 
                 if (forceDwarf == 0) {
                     // Save the backtrace
-                    bt_size_cur += rec_backtrace_ctx((jl_bt_element_t*)bt_data_prof + bt_size_cur, bt_size_max - bt_size_cur - 1, uc, NULL);
+                    sz = rec_backtrace_ctx(dest, room, uc, NULL);
                 }
                 else if (forceDwarf == 1) {
-                    bt_size_cur += rec_backtrace_ctx_dwarf((jl_bt_element_t*)bt_data_prof + bt_size_cur, bt_size_max - bt_size_cur - 1, uc, NULL);
+                    sz = rec_backtrace_ctx_dwarf(dest, room, uc, NULL);
                 }
                 else if (forceDwarf == -1) {
                     jl_safe_printf("WARNING: profiler attempt to access an invalid memory location\n");
@@ -586,25 +591,26 @@ void *mach_profile_listener(void *arg)
 
                 forceDwarf = -2;
 #else
-                bt_size_cur += rec_backtrace_ctx((jl_bt_element_t*)bt_data_prof + bt_size_cur, bt_size_max - bt_size_cur - 1, uc, NULL);
+                sz = rec_backtrace_ctx(dest, room, uc, NULL);
 #endif
                 jl_ptls_t ptls = jl_all_tls_states[i];
 
                 // store threadid but add 1 as 0 is preserved to indicate end of block
-                bt_data_prof[bt_size_cur++].uintptr = ptls->tid + 1;
+                dest[sz++].uintptr = ptls->tid + 1;
 
                 // store task id
-                bt_data_prof[bt_size_cur++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls->current_task);
+                dest[sz++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls->current_task);
 
                 // store cpu cycle clock
-                bt_data_prof[bt_size_cur++].uintptr = cycleclock();
+                dest[sz++].uintptr = cycleclock();
 
                 // store whether thread is sleeping but add 1 as 0 is preserved to indicate end of block
-                bt_data_prof[bt_size_cur++].uintptr = jl_atomic_load_relaxed(&ptls->sleep_check_state) + 1;
+                dest[sz++].uintptr = jl_atomic_load_relaxed(&ptls->sleep_check_state) + 1;
 
                 // Mark the end of this block with two 0's
-                bt_data_prof[bt_size_cur++].uintptr = 0;
-                bt_data_prof[bt_size_cur++].uintptr = 0;
+                dest[sz++].uintptr = 0;
+                dest[sz++].uintptr = 0;
+                jl_profile_commit_sample(i, sz);
             }
             // We're done! Resume the thread.
             jl_thread_resume(i, 0);
@@ -313,6 +313,31 @@ static int jl_is_on_sigstack(jl_ptls_t ptls, void *ptr, void *context)
 
 static void segv_handler(int sig, siginfo_t *info, void *context)
 {
+    // Safepoint faults are by far the most frequent reason to be here, and
+    // the faulting thread only needs to identify itself and park until the
+    // GC finishes, so test for them first: a single range check, with no
+    // allocation and no locks on the whole path. The safepoint pages cannot
+    // alias a system image page or the safe_restore regions, so this check
+    // can soundly precede both.
+    if (jl_addr_is_safepoint((uintptr_t)info->si_addr)) {
+        jl_task_t *ct = jl_get_current_task();
+        if (ct != NULL) {
+            jl_set_gc_and_wait();
+            // Do not raise sigint on worker thread
+            if (jl_atomic_load_relaxed(&ct->tid) != 0)
+                return;
+            if (ct->ptls->defer_signal) {
+                jl_safepoint_defer_sigint();
+            }
+            else if (jl_safepoint_consume_sigint()) {
+                jl_clear_force_sigint();
+                jl_throw_in_ctx(ct, jl_interrupt_exception, sig, context);
+            }
+            return;
+        }
+    }
+    if (jl_sysimg_materialize_page(info->si_addr))
+        return; // lazily relocated a system image page; retry the access
     if (jl_get_safe_restore()) { // restarting jl_ or profile
         jl_call_in_ctx(NULL, &jl_sig_throw, sig, context);
         return;
@@ -323,20 +348,6 @@ static void segv_handler(int sig, siginfo_t *info, void *context)
         return;
     }
     assert(sig == SIGSEGV || sig == SIGBUS);
-    if (jl_addr_is_safepoint((uintptr_t)info->si_addr)) {
-        jl_set_gc_and_wait();
-        // Do not raise sigint on worker thread
-        if (jl_atomic_load_relaxed(&ct->tid) != 0)
-            return;
-        if (ct->ptls->defer_signal) {
-            jl_safepoint_defer_sigint();
-        }
-        else if (jl_safepoint_consume_sigint()) {
-            jl_clear_force_sigint();
-            jl_throw_in_ctx(ct, jl_interrupt_exception, sig, context);
-        }
-        return;
-    }
     if (is_addr_on_stack(ct, info->si_addr)) { // stack overflow
         jl_throw_in_ctx(ct, jl_stackovf_exception, sig, context);
     }
@@ -501,42 +512,151 @@ void usr2_handler(int sig, siginfo_t *info, void *ctx)
     errno = errno_save;
 }
 
+#if !defined(JL_DISABLE_LIBUNWIND)
+// Suspend every thread in turn and record one profile sample from its
+// context. Runs outside signal context, either on the signal listener (BSD
+// itimer ticks) or on the Linux profiler-tick thread below; `sig` is the
+// signal used to wake a thread parked in the usr2 handler (see
+// jl_thread_resume).
+static void jl_profile_sample_all_threads(int sig)
+{
+    unw_context_t *signal_context;
+    jl_lock_profile();
+    // sample each thread, round-robin style in reverse order
+    // (so that thread zero gets notified last)
+    jl_shuffle_int_array_inplace(profile_round_robin_thread_order, jl_n_threads, &profile_cong_rng_seed);
+    for (int idx = jl_n_threads; idx-- > 0; ) {
+        // Stop the threads in the random round-robin order.
+        int i = profile_round_robin_thread_order[idx];
+        // notify thread to stop
+        jl_thread_suspend_and_get_state(i, &signal_context);
+        if (signal_context == NULL)
+            continue;
+        if (running) {
+            if (jl_profile_is_buffer_full()) {
+                // every thread's buffer is full: Delete the timer
+                jl_profile_stop_timer();
+            }
+            else {
+                jl_bt_element_t *dest;
+                size_t room = jl_profile_reserve_sample(i, &dest);
+                // if room == 0, this thread's buffer is full: drop the sample
+                if (room > 0) {
+                    // unwinding can fail, so keep track of the current state
+                    // and restore from the SEGV handler if anything happens.
+                    jl_jmp_buf *old_buf = jl_get_safe_restore();
+                    jl_jmp_buf buf;
+
+                    size_t sz = 0;
+                    jl_set_safe_restore(&buf);
+                    if (jl_setjmp(buf, 0)) {
+                        jl_safe_printf("WARNING: profiler attempt to access an invalid memory location\n");
+                    } else {
+                        // Get backtrace data
+                        if (jl_profile_fp_unwind)
+                            sz = rec_backtrace_ctx_fp(dest, room, signal_context, NULL);
+                        else
+                            sz = rec_backtrace_ctx(dest, room, signal_context, NULL);
+                    }
+                    jl_set_safe_restore(old_buf);
+
+                    jl_ptls_t ptls2 = jl_all_tls_states[i];
+
+                    // store threadid but add 1 as 0 is preserved to indicate end of block
+                    dest[sz++].uintptr = ptls2->tid + 1;
+
+                    // store task id
+                    dest[sz++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls2->current_task);
+
+                    // store cpu cycle clock
+                    dest[sz++].uintptr = cycleclock();
+
+                    // store whether thread is sleeping but add 1 as 0 is preserved to indicate end of block
+                    dest[sz++].uintptr = jl_atomic_load_relaxed(&ptls2->sleep_check_state) + 1;
+
+                    // Mark the end of this block with two 0's
+                    dest[sz++].uintptr = 0;
+                    dest[sz++].uintptr = 0;
+                    jl_profile_commit_sample(i, sz);
+                }
+            }
+        }
+        // notify thread to resume
+        jl_thread_resume(i, sig);
+    }
+    jl_unlock_profile();
+}
+#endif
+
 #if defined(HAVE_TIMER)
-// Linux-style
+// Linux: drive profile ticks from a timerfd serviced by a dedicated thread
+// instead of a POSIX timer signal. This keeps the tick out of signal
+// delivery entirely -- no async signal, no sigwait wakeup in the listener,
+// and no one-shot re-arm syscall after every sample since the timerfd is
+// periodic. The sampling round itself is unchanged: each thread is still
+// suspended and resumed individually to capture its context.
 #include <time.h>
 #include <string.h>  // for memset
+#include <sys/timerfd.h>
 
-static timer_t timerprof;
-static struct itimerspec itsprof;
+static int profile_timer_fd = -1;
+static pthread_t profile_timer_thread;
 
-JL_DLLEXPORT int jl_profile_start_timer(void)
+static void *profile_timer_loop(void *arg)
 {
-    struct sigevent sigprof;
+    (void)arg;
+    int fd = profile_timer_fd;
+    uint64_t expirations;
+    while (read(fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+        if (!running)
+            break;
+#if !defined(JL_DISABLE_LIBUNWIND)
+        jl_profile_sample_all_threads(SIGUSR1);
+#endif
+    }
+    // only close our own fd: a new timer may already have been started and
+    // stored its fd in profile_timer_fd by the time we get here
+    close(fd);
+    return NULL;
+}
 
-    // Establish the signal event
-    memset(&sigprof, 0, sizeof(struct sigevent));
-    sigprof.sigev_notify = SIGEV_SIGNAL;
-    sigprof.sigev_signo = SIGUSR1;
-    sigprof.sigev_value.sival_ptr = &timerprof;
-    if (timer_create(CLOCK_REALTIME, &sigprof, &timerprof) == -1)
+JL_DLLEXPORT int jl_profile_start_timer(void)
+{
+    struct itimerspec its;
+    profile_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (profile_timer_fd == -1)
         return -2;
-
-    // Start the timer
-    itsprof.it_interval.tv_sec = 0;
-    itsprof.it_interval.tv_nsec = 0;
-    itsprof.it_value.tv_sec = nsecprof / GIGA;
-    itsprof.it_value.tv_nsec = nsecprof % GIGA;
-    if (timer_settime(timerprof, 0, &itsprof, NULL) == -1)
+    its.it_interval.tv_sec = nsecprof / GIGA;
+    its.it_interval.tv_nsec = nsecprof % GIGA;
+    its.it_value = its.it_interval;
+    if (timerfd_settime(profile_timer_fd, 0, &its, NULL) == -1) {
+        close(profile_timer_fd);
+        profile_timer_fd = -1;
         return -3;
+    }
     running = 1;
+    if (pthread_create(&profile_timer_thread, NULL, profile_timer_loop, NULL) != 0) {
+        running = 0;
+        close(profile_timer_fd);
+        profile_timer_fd = -1;
+        return -3;
+    }
+    pthread_detach(profile_timer_thread);
     return 0;
 }
 
 JL_DLLEXPORT void jl_profile_stop_timer(void)
 {
-    if (running)
-        timer_delete(timerprof);
+    if (!running)
+        return;
     running = 0;
+    // wake the profiler thread so it can observe the stop; it owns the fd
+    // and closes it on exit (this may run on the profiler thread itself,
+    // when the sample buffers fill up)
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_nsec = 1;
+    timerfd_settime(profile_timer_fd, 0, &its, NULL);
 }
 
 #elif defined(HAVE_ITIMER)
@@ -623,9 +743,7 @@ static void jl_sigsetset(sigset_t *sset)
 #else
     sigaddset(sset, SIGUSR1);
 #endif
-#if defined(HAVE_TIMER)
-    sigaddset(sset, SIGUSR1);
-#elif defined(HAVE_ITIMER)
+#if defined(HAVE_ITIMER)
     sigaddset(sset, SIGPROF);
 #endif
 }
@@ -673,9 +791,7 @@ static void *signal_listener(void *arg)
 #else
         kqueue_signal(&sigqueue, &ev, SIGUSR1);
 #endif
-#if defined(HAVE_TIMER)
-        kqueue_signal(&sigqueue, &ev, SIGUSR1);
-#elif defined(HAVE_ITIMER)
+#if defined(HAVE_ITIMER)
         kqueue_signal(&sigqueue, &ev, SIGPROF);
 #endif
     }
@@ -712,17 +828,11 @@ static void *signal_listener(void *arg)
             sig = SIGABRT; // this branch can't occur, unless we had stack memory corruption of sset
         }
         profile = 0;
-#ifndef HAVE_MACH
-#if defined(HAVE_TIMER)
-        profile = (sig == SIGUSR1);
-#if _POSIX_C_SOURCE >= 199309L
-        if (profile && !(info.si_code == SI_TIMER &&
-	            info.si_value.sival_ptr == &timerprof))
-            profile = 0;
-#endif
-#elif defined(HAVE_ITIMER)
+        // On Linux (HAVE_TIMER) profile ticks come in over a timerfd handled
+        // by a dedicated thread (see profile_timer_loop above), so they never
+        // reach this listener; SIGUSR1 keeps its status-dump meaning.
+#if !defined(HAVE_MACH) && defined(HAVE_ITIMER)
         profile = (sig == SIGPROF);
-#endif
 #endif
 
         if (sig == SIGINT) {
@@ -761,16 +871,10 @@ static void *signal_listener(void *arg)
 
         bt_size = 0;
 #if !defined(JL_DISABLE_LIBUNWIND)
-        unw_context_t *signal_context;
-        // sample each thread, round-robin style in reverse order
-        // (so that thread zero gets notified last)
-        if (critical || profile) {
+        if (critical) {
+            unw_context_t *signal_context;
             jl_lock_profile();
-            if (!critical)
-                jl_shuffle_int_array_inplace(profile_round_robin_thread_order, jl_n_threads, &profile_cong_rng_seed);
-            for (int idx = jl_n_threads; idx-- > 0; ) {
-                // Stop the threads in the random round-robin order.
-                int i = critical ? idx : profile_round_robin_thread_order[idx];
+            for (int i = jl_n_threads; i-- > 0; ) {
                 // notify thread to stop
                 jl_thread_suspend_and_get_state(i, &signal_context);
                 if (signal_context == NULL)
@@ -778,67 +882,22 @@ static void *signal_listener(void *arg)
 
                 // do backtrace on thread contexts for critical signals
                 // this part must be signal-handler safe
-                if (critical) {
-                    bt_size += rec_backtrace_ctx(bt_data + bt_size,
-                            JL_MAX_BT_SIZE / jl_n_threads - 1,
-                            signal_context, NULL);
-                    bt_data[bt_size++].uintptr = 0;
-                }
-
-                // do backtrace for profiler
-                if (profile && running) {
-                    if (jl_profile_is_buffer_full()) {
-                        // Buffer full: Delete the timer
-                        jl_profile_stop_timer();
-                    }
-                    else {
-                        // unwinding can fail, so keep track of the current state
-                        // and restore from the SEGV handler if anything happens.
-                        jl_jmp_buf *old_buf = jl_get_safe_restore();
-                        jl_jmp_buf buf;
-
-                        jl_set_safe_restore(&buf);
-                        if (jl_setjmp(buf, 0)) {
-                            jl_safe_printf("WARNING: profiler attempt to access an invalid memory location\n");
-                        } else {
-                            // Get backtrace data
-                            bt_size_cur += rec_backtrace_ctx((jl_bt_element_t*)bt_data_prof + bt_size_cur,
-                                    bt_size_max - bt_size_cur - 1, signal_context, NULL);
-                        }
-                        jl_set_safe_restore(old_buf);
-
-                        jl_ptls_t ptls2 = jl_all_tls_states[i];
-
-                        // store threadid but add 1 as 0 is preserved to indicate end of block
-                        bt_data_prof[bt_size_cur++].uintptr = ptls2->tid + 1;
-
-                        // store task id
-                        bt_data_prof[bt_size_cur++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls2->current_task);
-
-                        // store cpu cycle clock
-                        bt_data_prof[bt_size_cur++].uintptr = cycleclock();
-
-                        // store whether thread is sleeping but add 1 as 0 is preserved to indicate end of block
-                        bt_data_prof[bt_size_cur++].uintptr = jl_atomic_load_relaxed(&ptls2->sleep_check_state) + 1;
-
-                        // Mark the end of this block with two 0's
-                        bt_data_prof[bt_size_cur++].uintptr = 0;
-                        bt_data_prof[bt_size_cur++].uintptr = 0;
-                    }
-                }
+                bt_size += rec_backtrace_ctx(bt_data + bt_size,
+                        JL_MAX_BT_SIZE / jl_n_threads - 1,
+                        signal_context, NULL);
+                bt_data[bt_size++].uintptr = 0;
 
                 // notify thread to resume
                 jl_thread_resume(i, sig);
             }
             jl_unlock_profile();
         }
-#ifndef HAVE_MACH
+        else if (profile) {
+            jl_profile_sample_all_threads(sig);
+        }
+#if !defined(HAVE_MACH) && defined(HAVE_ITIMER)
         if (profile && running) {
-#if defined(HAVE_TIMER)
-            timer_settime(timerprof, 0, &itsprof, NULL);
-#elif defined(HAVE_ITIMER)
             setitimer(ITIMER_PROF, &timerprof, NULL);
-#endif
         }
 #endif
 #endif
@@ -359,26 +359,31 @@ static DWORD WINAPI profile_bt( LPVOID lparam )
                 }
                 else {
                     // Get backtrace data
-                    bt_size_cur += rec_backtrace_ctx((jl_bt_element_t*)bt_data_prof + bt_size_cur,
-                            bt_size_max - bt_size_cur - 1, &ctxThread, NULL);
+                    jl_bt_element_t *dest;
+                    size_t room = jl_profile_reserve_sample(0, &dest);
+                    // if room == 0, the buffer is full: drop the sample
+                    if (room > 0) {
+                        size_t sz = rec_backtrace_ctx(dest, room, &ctxThread, NULL);
 
-                    jl_ptls_t ptls = jl_all_tls_states[0]; // given only profiling hMainThread
+                        jl_ptls_t ptls = jl_all_tls_states[0]; // given only profiling hMainThread
 
-                    // store threadid but add 1 as 0 is preserved to indicate end of block
-                    bt_data_prof[bt_size_cur++].uintptr = ptls->tid + 1;
+                        // store threadid but add 1 as 0 is preserved to indicate end of block
+                        dest[sz++].uintptr = ptls->tid + 1;
 
-                    // store task id
-                    bt_data_prof[bt_size_cur++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls->current_task);
+                        // store task id
+                        dest[sz++].jlvalue = (jl_value_t*)jl_atomic_load_relaxed(&ptls->current_task);
 
-                    // store cpu cycle clock
-                    bt_data_prof[bt_size_cur++].uintptr = cycleclock();
+                        // store cpu cycle clock
+                        dest[sz++].uintptr = cycleclock();
 
-                    // store whether thread is sleeping but add 1 as 0 is preserved to indicate end of block
-                    bt_data_prof[bt_size_cur++].uintptr = jl_atomic_load_relaxed(&ptls->sleep_check_state) + 1;
+                        // store whether thread is sleeping but add 1 as 0 is preserved to indicate end of block
+                        dest[sz++].uintptr = jl_atomic_load_relaxed(&ptls->sleep_check_state) + 1;
 
-                    // Mark the end of this block with two 0's
-                    bt_data_prof[bt_size_cur++].uintptr = 0;
-                    bt_data_prof[bt_size_cur++].uintptr = 0;
+                        // Mark the end of this block with two 0's
+                        dest[sz++].uintptr = 0;
+                        dest[sz++].uintptr = 0;
+                        jl_profile_commit_sample(0, sz);
+                    }
                 }
                 jl_unlock_profile();
                 uv_mutex_unlock(&jl_in_stackwalk);
@@ -56,9 +56,31 @@ JL_DLLEXPORT jl_svec_t *jl_svec2(void *a, void *b)
 JL_DLLEXPORT jl_svec_t *jl_alloc_svec_uninit(size_t n)
 {
     jl_task_t *ct = jl_current_task;
+    jl_svec_t *jv;
     if (n == 0) return jl_emptysvec;
-    jl_svec_t *jv = (jl_svec_t*)jl_gc_alloc(ct->ptls, (n + 1) * sizeof(void*),
-                                            jl_simplevector_type);
+    // lengths 1-8 dominate (type parameters, method signatures) and churn
+    // hard during inference; allocate them with constant sizes so the pool
+    // id and object size constant-fold into the inlined per-thread pool
+    // freelist pop instead of calling out through the generic allocator
+#define SVEC_SMALL_CASE(N)                                                  \
+    case N: jv = (jl_svec_t*)jl_gc_alloc(ct->ptls, ((N) + 1) * sizeof(void*), \
+                                         jl_simplevector_type);             \
+        break;
+    switch (n) {
+    SVEC_SMALL_CASE(1)
+    SVEC_SMALL_CASE(2)
+    SVEC_SMALL_CASE(3)
+    SVEC_SMALL_CASE(4)
+    SVEC_SMALL_CASE(5)
+    SVEC_SMALL_CASE(6)
+    SVEC_SMALL_CASE(7)
+    SVEC_SMALL_CASE(8)
+    default:
+        jv = (jl_svec_t*)jl_gc_alloc(ct->ptls, (n + 1) * sizeof(void*),
+                                     jl_simplevector_type);
+        break;
+    }
+#undef SVEC_SMALL_CASE
     jl_svec_set_len_unsafe(jv, n);
     return jv;
 }
@@ -67,8 +89,8 @@ JL_DLLEXPORT jl_svec_t *jl_alloc_svec(size_t n)
 {
     if (n == 0) return jl_emptysvec;
     jl_svec_t *jv = jl_alloc_svec_uninit(n);
-    for(size_t i=0; i < n; i++)
-        jl_svecset(jv, i, NULL);
+    // NULL stores need no write barrier
+    memset(jl_svec_data(jv), 0, n * sizeof(void*));
     return jv;
 }
 
@@ -11,7 +11,9 @@
 
 // compute empirical max-probe for a given size
 #define max_probe(size) ((size) <= 1024 ? 16 : (size) >> 6)
-#define h2index(hv, sz) (size_t)((hv) & ((sz)-1))
+// fold the high bits into the index so that keys whose hashes differ only
+// above the mask do not share a probe sequence
+#define h2index(hv, sz) (size_t)((((hv) >> 16) ^ (hv)) & ((sz)-1))
 
 #ifdef __cplusplus
 extern "C" {
@@ -92,19 +94,36 @@ ssize_t jl_smallintset_lookup(jl_array_t *cache, smallintset_eq eq, const void *
     size_t index = h2index(hv, sz);
     size_t orig = index;
     size_t iter = 0;
-    do {
-        size_t val1 = jl_intref(cache, index);
-        if (val1 == 0) {
-            JL_GC_POP();
-            return -1;
-        }
-        if (eq(val1 - 1, key, data, hv)) {
-            JL_GC_POP();
-            return val1 - 1;
-        }
-        index = (index + 1) & (sz - 1);
-        iter++;
-    } while (iter <= maxprobe && index != orig);
+    // dispatch on the slot encoding once, outside the probe loop, so each
+    // probe is a plain typed load; jl_intref would redo the dispatch per slot
+    // (and the compiler cannot hoist it past the opaque eq callback)
+#define probe_loop(T) \
+    do { \
+        const T *slots = (const T*)jl_array_data(cache); \
+        do { \
+            size_t val1 = slots[index]; \
+            if (val1 == 0) { \
+                JL_GC_POP(); \
+                return -1; \
+            } \
+            if (eq(val1 - 1, key, data, hv)) { \
+                JL_GC_POP(); \
+                return val1 - 1; \
+            } \
+            index = (index + 1) & (sz - 1); \
+            iter++; \
+        } while (iter <= maxprobe && index != orig); \
+    } while (0)
+    jl_value_t *el = jl_tparam0(jl_typeof(cache));
+    if (el == (jl_value_t*)jl_uint8_type)
+        probe_loop(uint8_t);
+    else if (el == (jl_value_t*)jl_uint16_type)
+        probe_loop(uint16_t);
+    else if (el == (jl_value_t*)jl_uint32_type)
+        probe_loop(uint32_t);
+    else
+        abort();
+#undef probe_loop
     JL_GC_POP();
     return -1;
 }
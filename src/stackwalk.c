@@ -202,6 +202,88 @@ NOINLINE size_t rec_backtrace_ctx(jl_bt_element_t *bt_data, size_t maxsize,
     return bt_size;
 }
 
+// Frame-pointer-chasing unwinder for the sampling profiler.
+//
+// Stepping with libunwind is accurate but costly at high sampling rates.
+// Since codegen always preserves frame pointers, the profiler can instead
+// chase the (caller fp, return address) records directly. C frames compiled
+// without frame pointers terminate the walk early, which is an accepted
+// trade-off for profiling; `rec_backtrace_ctx` remains the accurate slow
+// path and is used on platforms without support below.
+#if defined(_OS_LINUX_) && (defined(_CPU_X86_64_) || defined(_CPU_AARCH64_))
+#define JL_HAVE_FP_UNWIND
+#include <ucontext.h>
+
+static void jl_unw_get_ip_fp_sp(bt_context_t *context, uintptr_t *ip,
+                                uintptr_t *fp, uintptr_t *sp) JL_NOTSAFEPOINT
+{
+    ucontext_t *uc = (ucontext_t*)context;
+#if defined(_CPU_X86_64_)
+    *ip = uc->uc_mcontext.gregs[REG_RIP];
+    *fp = uc->uc_mcontext.gregs[REG_RBP];
+    *sp = uc->uc_mcontext.gregs[REG_RSP];
+#else
+    *ip = uc->uc_mcontext.pc;
+    *fp = uc->uc_mcontext.regs[29];
+    *sp = uc->uc_mcontext.sp;
+#endif
+}
+#endif
+
+NOINLINE size_t rec_backtrace_ctx_fp(jl_bt_element_t *bt_data, size_t maxsize,
+                                     bt_context_t *context, jl_gcframe_t *pgcstack) JL_NOTSAFEPOINT
+{
+#ifndef JL_HAVE_FP_UNWIND
+    return rec_backtrace_ctx(bt_data, maxsize, context, pgcstack);
+#else
+    uintptr_t ip, fp, sp;
+    jl_unw_get_ip_fp_sp(context, &ip, &fp, &sp);
+    volatile size_t n = 0;
+    jl_jmp_buf *old_buf = jl_get_safe_restore();
+    jl_jmp_buf buf;
+    jl_set_safe_restore(&buf);
+    if (!jl_setjmp(buf, 0)) {
+        int from_signal_handler = 1;
+        while (n + JL_BT_MAX_ENTRY_SIZE + 1 <= maxsize) {
+            // adjust to the call instruction, as in jl_unw_stepn
+            uintptr_t call_ip = ip;
+            if (!from_signal_handler)
+                call_ip -= 1;
+            from_signal_handler = 0;
+            if (call_ip == JL_BT_NON_PTR_ENTRY || call_ip == 0)
+                break;
+            jl_bt_element_t *bt_entry = bt_data + n;
+            jl_gcframe_t *pgc;
+            if ((pgc = is_enter_interpreter_frame(&pgcstack, fp ? fp : sp))) {
+                size_t add = jl_capture_interp_frame(bt_entry, (void*)((char*)pgc - sizeof(void*)), maxsize - n);
+                n += add;
+                bt_entry += add;
+            }
+            bt_entry->uintptr = call_ip;
+            n++;
+            // both ABIs store the frame record as (caller fp, return address)
+            if (fp == 0 || (fp & (sizeof(void*) - 1)) || fp <= sp)
+                break;
+            uintptr_t next_fp = ((uintptr_t*)fp)[0];
+            ip = ((uintptr_t*)fp)[1];
+            if (ip == 0)
+                break;
+            if (next_fp <= fp) // must strictly move towards the stack base
+                break;
+            sp = fp;
+            fp = next_fp;
+        }
+    }
+    else {
+        // invalid memory read: back off the frame that caused it
+        if (n > 0)
+            n -= 1;
+    }
+    jl_set_safe_restore(old_buf);
+    return n;
+#endif
+}
+
 // Record backtrace into buffer `bt_data`, using a maximum of `maxsize`
 // elements, and returning the number of elements written.
 //
@@ -223,6 +305,171 @@ NOINLINE size_t rec_backtrace(jl_bt_element_t *bt_data, size_t maxsize, int skip
     return bt_size;
 }
 
+// Variant of `rec_backtrace` that chases frame pointers from the current
+// frame instead of stepping through libunwind, with the same trade-off as
+// `rec_backtrace_ctx_fp` above. Used for the exception throw path when
+// JULIA_THROW_FP_UNWIND is set, where unwind cost dominates throw-heavy code.
+NOINLINE size_t rec_backtrace_fp(jl_bt_element_t *bt_data, size_t maxsize, int skip) JL_NOTSAFEPOINT
+{
+#ifndef JL_HAVE_FP_UNWIND
+    return rec_backtrace(bt_data, maxsize, skip);
+#else
+    // our frame record holds (caller fp, return address), so the walk below
+    // starts at our caller and this frame is omitted for free
+    uintptr_t fp = (uintptr_t)__builtin_frame_address(0);
+    jl_gcframe_t *pgcstack = jl_pgcstack;
+    volatile size_t n = 0;
+    volatile int skipped = skip;
+    jl_jmp_buf *old_buf = jl_get_safe_restore();
+    jl_jmp_buf buf;
+    jl_set_safe_restore(&buf);
+    if (!jl_setjmp(buf, 0)) {
+        uintptr_t sp = fp;
+        while (n + JL_BT_MAX_ENTRY_SIZE + 1 <= maxsize) {
+            if (fp == 0 || (fp & (sizeof(void*) - 1)) || fp < sp)
+                break;
+            uintptr_t next_fp = ((uintptr_t*)fp)[0];
+            uintptr_t ret_ip = ((uintptr_t*)fp)[1];
+            // adjust to the call instruction, as in jl_unw_stepn
+            uintptr_t call_ip = ret_ip - 1;
+            if (ret_ip == 0 || call_ip == JL_BT_NON_PTR_ENTRY)
+                break;
+            if (skipped > 0) {
+                skipped -= 1;
+            }
+            else {
+                jl_bt_element_t *bt_entry = bt_data + n;
+                jl_gcframe_t *pgc;
+                if ((pgc = is_enter_interpreter_frame(&pgcstack, fp))) {
+                    size_t add = jl_capture_interp_frame(bt_entry, (void*)((char*)pgc - sizeof(void*)), maxsize - n);
+                    n += add;
+                    bt_entry += add;
+                }
+                bt_entry->uintptr = call_ip;
+                n++;
+            }
+            if (next_fp <= fp) // must strictly move towards the stack base
+                break;
+            sp = fp;
+            fp = next_fp;
+        }
+    }
+    else {
+        // invalid memory read: back off the frame that caused it
+        if (n > 0)
+            n -= 1;
+    }
+    jl_set_safe_restore(old_buf);
+    return n;
+#endif
+}
+
+// Interned backtrace storage
+//
+// Error-heavy services that retain many captured traces (telemetry, logging)
+// pay for a full copy of every trace even though most traces share their
+// outer frames. The arena below deduplicates traces made up entirely of
+// native frames into a prefix tree keyed from the outermost frame inward,
+// so two traces that diverge only near the leaf share all of their common
+// suffix. A retained trace is then a single node pointer instead of a
+// buffer copy.
+//
+// Only native entries can be interned: extended entries embed jl_value_t
+// pointers which would have to be rooted for the lifetime of the arena.
+// jl_bt_intern returns NULL for such traces and the caller keeps its copy.
+// Nodes are allocated from malloc'd blocks that are never freed, matching
+// the trace handles' unbounded lifetime.
+
+typedef struct _jl_bt_intern_node_t {
+    uintptr_t ip;
+    struct _jl_bt_intern_node_t *parent;  // next outer frame, NULL at the outermost
+    struct _jl_bt_intern_node_t *sibling; // next node sharing `parent`
+    struct _jl_bt_intern_node_t *child;   // first interned frame inside this one
+    uint32_t depth;                       // number of frames from here to the outermost
+} jl_bt_intern_node_t;
+
+#define BT_INTERN_BLOCK_NNODES 4096
+
+static jl_mutex_t bt_intern_lock;
+static jl_bt_intern_node_t *bt_intern_block = NULL;
+static size_t bt_intern_block_used = BT_INTERN_BLOCK_NNODES;
+static jl_bt_intern_node_t *bt_intern_roots = NULL;
+
+static jl_bt_intern_node_t *bt_intern_node_new(void) JL_NOTSAFEPOINT
+{
+    if (bt_intern_block_used == BT_INTERN_BLOCK_NNODES) {
+        bt_intern_block = (jl_bt_intern_node_t*)malloc_s(
+                BT_INTERN_BLOCK_NNODES * sizeof(jl_bt_intern_node_t));
+        bt_intern_block_used = 0;
+    }
+    return &bt_intern_block[bt_intern_block_used++];
+}
+
+// Intern the trace in `bt_data` and return an opaque handle for it, or NULL
+// if the trace contains extended (non-native) entries and cannot be interned.
+// Equal traces always return the same handle, so handles may be compared for
+// pointer equality to deduplicate on the consumer side as well.
+JL_DLLEXPORT void *jl_bt_intern(jl_bt_element_t *bt_data, size_t bt_size) JL_NOTSAFEPOINT
+{
+    if (bt_size == 0)
+        return NULL;
+    for (size_t i = 0; i < bt_size; i++) {
+        if (!jl_bt_is_native(&bt_data[i]))
+            return NULL;
+    }
+    JL_LOCK_NOGC(&bt_intern_lock);
+    jl_bt_intern_node_t *parent = NULL;
+    jl_bt_intern_node_t **list = &bt_intern_roots;
+    // bt_data[0] is the innermost frame; walk from the outermost end so that
+    // traces entering through the same outer frames share tree nodes.
+    for (size_t i = bt_size; i-- > 0; ) {
+        uintptr_t ip = bt_data[i].uintptr;
+        jl_bt_intern_node_t **pnode = list;
+        while (*pnode && (*pnode)->ip != ip)
+            pnode = &(*pnode)->sibling;
+        jl_bt_intern_node_t *node = *pnode;
+        if (node == NULL) {
+            node = bt_intern_node_new();
+            node->ip = ip;
+            node->parent = parent;
+            node->child = NULL;
+            node->depth = parent ? parent->depth + 1 : 1;
+        }
+        else {
+            *pnode = node->sibling;
+        }
+        // move-to-front: repeated captures of similar stacks find their
+        // frames at the head of each sibling list
+        node->sibling = *list;
+        *list = node;
+        parent = node;
+        list = &node->child;
+    }
+    JL_UNLOCK_NOGC(&bt_intern_lock);
+    return parent;
+}
+
+// Number of frames in an interned trace.
+JL_DLLEXPORT size_t jl_bt_intern_size(void *handle) JL_NOTSAFEPOINT
+{
+    return handle ? ((jl_bt_intern_node_t*)handle)->depth : 0;
+}
+
+// Expand an interned trace back into `bt_data` (innermost frame first, the
+// same order rec_backtrace produces). Returns the number of frames written,
+// truncated to `maxsize`.
+JL_DLLEXPORT size_t jl_bt_intern_unpack(void *handle, jl_bt_element_t *bt_data,
+                                        size_t maxsize) JL_NOTSAFEPOINT
+{
+    size_t n = 0;
+    // the parent chain is immutable once published, so no lock is needed
+    for (jl_bt_intern_node_t *node = (jl_bt_intern_node_t*)handle;
+         node && n < maxsize; node = node->parent) {
+        bt_data[n++].uintptr = node->ip;
+    }
+    return n;
+}
+
 static jl_value_t *array_ptr_void_type JL_ALWAYS_LEAFTYPE = NULL;
 // Return backtrace information as an svec of (bt1, bt2, [sp])
 //
@@ -221,6 +221,12 @@ static htable_t backref_table;
 static int backref_table_numel;
 static arraylist_t layout_table;
 
+// objects that are only loaded when a method gets (re)compiled (sources,
+// method roots, inference results); sysimg_sort_order places these behind
+// everything else so startup never pages them in
+static htable_t cold_set;
+static int cold_layout_enabled;
+
 // list of (size_t pos, (void *f)(jl_value_t*)) entries
 // for the serializer to mark values in need of rework by function f
 // during deserialization later
@@ -468,6 +474,27 @@ static void jl_serialize_value_(jl_serializer_state *s, jl_value_t *v, int recur
     jl_datatype_t *t = (jl_datatype_t*)jl_typeof(v);
     jl_serialize_value(s, t);
 
+    if (cold_layout_enabled) {
+        // feed the layout pass: these fields are only ever loaded when their
+        // method gets (re)compiled, so their containers can live at the back
+        // of the image (only the containers themselves are marked; anything
+        // shared with hot objects is reached on another path and stays put)
+        if (jl_is_method(v)) {
+            jl_method_t *m = (jl_method_t*)v;
+            if (m->source)
+                ptrhash_put(&cold_set, m->source, m->source);
+            if (m->roots)
+                ptrhash_put(&cold_set, m->roots, m->roots);
+            if (m->slot_syms)
+                ptrhash_put(&cold_set, m->slot_syms, m->slot_syms);
+        }
+        else if (jl_is_code_instance(v)) {
+            jl_code_instance_t *ci = (jl_code_instance_t*)v;
+            if (ci->inferred)
+                ptrhash_put(&cold_set, ci->inferred, ci->inferred);
+        }
+    }
+
     if (t->layout->npointers == 0) {
         // skip it
     }
@@ -683,6 +710,7 @@ static void jl_write_module(jl_serializer_state *s, uintptr_t item, jl_module_t
     newm->bindings.size = count; // stash the count in newm->size
     newm->bindings.table = NULL;
     memset(&newm->bindings._space, 0, sizeof(newm->bindings._space));
+    jl_atomic_store_relaxed(&newm->bindingcache, NULL); // rebuilt lazily on load
 
     // write out the usings list
     memset(&newm->usings._space, 0, sizeof(newm->usings._space));
@@ -731,8 +759,15 @@ static size_t jl_sort_size(jl_datatype_t *dt)
 
 static int sysimg_sort_order(const void *pa, const void *pb)
 {
+    // serialization (traversal) order, except that objects in cold_set all
+    // sort after the last hot one; item indexes stay below
+    // 1 << RELOC_TAG_OFFSET (asserted above) so the flag bit cannot collide
     uintptr_t sa = ((uintptr_t*)pa)[1];
     uintptr_t sb = ((uintptr_t*)pb)[1];
+    if (ptrhash_get(&cold_set, ((void**)pa)[0]) != HT_NOTFOUND)
+        sa |= (uintptr_t)1 << RELOC_TAG_OFFSET;
+    if (ptrhash_get(&cold_set, ((void**)pb)[0]) != HT_NOTFOUND)
+        sb |= (uintptr_t)1 << RELOC_TAG_OFFSET;
     return (sa > sb ? 1 : (sa < sb ? -1 : 0));
 #if 0
     jl_value_t *a = *(jl_value_t**)pa;
@@ -820,6 +855,7 @@ static void jl_write_values(jl_serializer_state *s)
             newa->flags.how = 0;
             newa->flags.pooled = 0;
             newa->flags.isshared = 0;
+            newa->flags.iscow = 0;
 
             // write data
             if (!ar->flags.ptrarray && !ar->flags.hasptr) {
@@ -1263,6 +1299,295 @@ static inline uintptr_t get_item_for_reloc(jl_serializer_state *s, uintptr_t bas
 }
 
 
+// --- lazy page-at-a-time relocation ---
+//
+// Applying both relocation streams eagerly writes into nearly every page of
+// the image, which forces the kernel to unshare (copy-on-write) those pages
+// and defeats page-cache sharing of the image across processes. Objects are
+// already stored at their final offsets relative to the image base, so on
+// Linux we instead decode the (sorted) offset streams once, protect the
+// page-aligned interior of the image, and patch each page on first access
+// from the SIGSEGV handler. Startup then dirties only the pages it actually
+// touches and untouched pages stay shared until first use. Disable by
+// setting SYSIMG_LAZY_RELOCS_NAME (options.h) to 0.
+
+#ifdef _OS_LINUX_
+
+#include <signal.h>
+#include <sys/mman.h>
+
+static uintptr_t lazy_reloc_lo;      // page-aligned interior of the image
+static uintptr_t lazy_reloc_hi;      // (0, 0 unless lazy relocation is active)
+static uintptr_t lazy_img_base;
+static size_t lazy_img_size;
+static uint32_t *lazy_reloc_tags;    // ascending image offsets of gc-tagged words
+static size_t lazy_reloc_ntags;
+static uint32_t *lazy_reloc_data;    // ascending image offsets of pointer words
+static size_t lazy_reloc_ndata;
+static uint32_t *lazy_reloc_done;    // bitmap: page has been materialized
+static uint32_t *lazy_reloc_touch_order; // page indexes in first-touch order
+static size_t lazy_reloc_ntouched;
+static _Atomic(int) lazy_reloc_lock;
+static jl_serializer_state lazy_reloc_s;
+static ios_t lazy_reloc_const_data;
+static struct sigaction lazy_reloc_prev_segv;
+
+STATIC_INLINE int jl_lazy_reloc_pending(uintptr_t a) JL_NOTSAFEPOINT
+{
+    return a >= lazy_reloc_lo && a < lazy_reloc_hi;
+}
+
+STATIC_INLINE int jl_lazy_reloc_materialized(uintptr_t a) JL_NOTSAFEPOINT
+{
+    if (!jl_lazy_reloc_pending(a))
+        return 1;
+    size_t pageno = (a - lazy_reloc_lo) / jl_page_size;
+    return (lazy_reloc_done[pageno / 32] >> (pageno % 32)) & 1;
+}
+
+static void lazy_reloc_segv(int sig, siginfo_t *info, void *context)
+{
+    if (jl_sysimg_materialize_page(info->si_addr))
+        return; // retry the faulting access
+    // not an image page: put back the previous disposition, which the
+    // re-executed access then faults into
+    sigaction(SIGSEGV, &lazy_reloc_prev_segv, NULL);
+}
+
+// decode one 0-terminated stream of ascending uint32 offsets, without
+// consuming it; returns 0 (leaving `*listp` alone) if the stream turns out
+// not to be sorted, in which case the caller falls back to eager application
+static int jl_lazy_reloc_decode(uintptr_t *pos, uint32_t **listp, size_t *np)
+{
+    uintptr_t p = *pos;
+    size_t n = 0;
+    uint32_t prev = 0;
+    while (1) {
+        uint32_t offset = load_uint32(&p);
+        if (offset == 0)
+            break;
+        if (offset <= prev)
+            return 0;
+        prev = offset;
+        n++;
+    }
+    uint32_t *list = (uint32_t*)malloc_s(n * sizeof(uint32_t));
+    p = *pos;
+    for (size_t i = 0; i < n; i++)
+        list[i] = load_uint32(&p);
+    *pos = p + sizeof(uint32_t); // skip the terminator
+    *listp = list;
+    *np = n;
+    return 1;
+}
+
+// if usable, set up lazy relocation for the image in `s->s` and protect its
+// interior pages; the caller must then skip every relocation whose target is
+// jl_lazy_reloc_pending. returns 0 when the relocations have to be applied
+// eagerly instead (non-Linux, opted out, tiny image, ...)
+static int jl_lazy_reloc_begin(jl_serializer_state *s)
+{
+    char *cp = getenv(SYSIMG_LAZY_RELOCS_NAME);
+    if (cp && strcmp(cp, "0") == 0)
+        return 0;
+    uintptr_t base = (uintptr_t)&s->s->buf[0];
+    uintptr_t lo = LLT_ALIGN(base, jl_page_size);
+    uintptr_t hi = (base + s->s->size) & ~(uintptr_t)(jl_page_size - 1);
+    if (hi <= lo)
+        return 0;
+    uintptr_t pos = (uintptr_t)&s->relocs->buf[s->relocs->bpos];
+    if (!jl_lazy_reloc_decode(&pos, &lazy_reloc_tags, &lazy_reloc_ntags))
+        return 0;
+    if (!jl_lazy_reloc_decode(&pos, &lazy_reloc_data, &lazy_reloc_ndata)) {
+        free(lazy_reloc_tags);
+        lazy_reloc_tags = NULL;
+        return 0;
+    }
+    size_t npages = (hi - lo) / jl_page_size;
+    lazy_reloc_done = (uint32_t*)malloc_s(((npages + 31) / 32) * sizeof(uint32_t));
+    memset(lazy_reloc_done, 0, ((npages + 31) / 32) * sizeof(uint32_t));
+    if (getenv(SYSIMG_PAGE_TRACE_NAME))
+        // sized for every page up front: the fault handler cannot malloc
+        lazy_reloc_touch_order = (uint32_t*)malloc_s(npages * sizeof(uint32_t));
+    // copy what get_item_for_reloc needs at fault time (the caller's ios
+    // structs are stack-allocated; their static buffers stay mapped)
+    lazy_reloc_const_data = *s->const_data;
+    lazy_reloc_s = *s;
+    lazy_reloc_s.const_data = &lazy_reloc_const_data;
+    lazy_img_base = base;
+    lazy_img_size = s->s->size;
+    // handle faults for the remainder of startup; the handlers installed
+    // later by jl_install_default_signal_handlers route image faults back to
+    // jl_sysimg_materialize_page themselves
+    struct sigaction act;
+    memset(&act, 0, sizeof(act));
+    sigemptyset(&act.sa_mask);
+    act.sa_sigaction = lazy_reloc_segv;
+    act.sa_flags = SA_SIGINFO;
+    if (sigaction(SIGSEGV, &act, &lazy_reloc_prev_segv) != 0 ||
+            mprotect((void*)lo, hi - lo, PROT_NONE) != 0) {
+        free(lazy_reloc_tags);
+        free(lazy_reloc_data);
+        free(lazy_reloc_done);
+        free(lazy_reloc_touch_order);
+        lazy_reloc_tags = lazy_reloc_data = lazy_reloc_done = NULL;
+        lazy_reloc_touch_order = NULL;
+        return 0;
+    }
+    lazy_reloc_lo = lo;
+    lazy_reloc_hi = hi;
+    return 1;
+}
+
+// apply the relocations landing in image range [lo, hi), writing each word
+// at `delta` bytes from its image address (the page being patched may be
+// temporarily mapped at a scratch address)
+static void jl_lazy_reloc_apply_page(uint32_t *list, size_t n, uintptr_t lo,
+                                     uintptr_t hi, uint8_t bits, intptr_t delta) JL_NOTSAFEPOINT
+{
+    uintptr_t base = lazy_img_base;
+    // find the first offset landing in [lo, hi) (the list is ascending)
+    size_t l = 0, r = n;
+    while (l < r) {
+        size_t m = l + (r - l) / 2;
+        if (base + list[m] < lo)
+            l = m + 1;
+        else
+            r = m;
+    }
+    for (; l < n && base + list[l] < hi; l++) {
+        uintptr_t *pv = (uintptr_t*)(base + list[l] + delta);
+        *pv = get_item_for_reloc(&lazy_reloc_s, base, lazy_img_size, *pv) | bits;
+    }
+}
+
+// called from the SIGSEGV handler: if `addr` is in a not-yet-relocated image
+// page, materialize that page and return 1 so the faulting access can be
+// retried
+JL_DLLEXPORT int jl_sysimg_materialize_page(void *addr) JL_NOTSAFEPOINT
+{
+    uintptr_t a = (uintptr_t)addr;
+    if (!jl_lazy_reloc_pending(a))
+        return 0;
+    uintptr_t page = a & ~(uintptr_t)(jl_page_size - 1);
+    size_t pageno = (page - lazy_reloc_lo) / jl_page_size;
+    int expected = 0;
+    while (!jl_atomic_cmpswap(&lazy_reloc_lock, &expected, 1)) {
+        expected = 0;
+        jl_cpu_pause();
+    }
+    if (!((lazy_reloc_done[pageno / 32] >> (pageno % 32)) & 1)) {
+        // The page must never be readable in place before its relocations
+        // have all landed: another running thread would then read serialized
+        // offset tags where pointers belong without faulting. Move the page
+        // to a scratch address, patch it there, and publish it back in a
+        // single mremap; any thread touching the hole in the meantime faults
+        // into this handler and waits on lazy_reloc_lock above.
+        void *scratch = mremap((void*)page, jl_page_size, jl_page_size,
+                               MREMAP_MAYMOVE);
+        if (scratch == MAP_FAILED ||
+                mprotect(scratch, jl_page_size, PROT_READ | PROT_WRITE) != 0) {
+            // out of memory for a VMA split; nothing sensible left to do in
+            // a fault handler
+            jl_safe_printf("fatal: failed to materialize sysimage page\n");
+            abort();
+        }
+        intptr_t delta = (intptr_t)((uintptr_t)scratch - page);
+        jl_lazy_reloc_apply_page(lazy_reloc_tags, lazy_reloc_ntags,
+                                 page, page + jl_page_size, GC_OLD_MARKED, delta);
+        jl_lazy_reloc_apply_page(lazy_reloc_data, lazy_reloc_ndata,
+                                 page, page + jl_page_size, 0, delta);
+        if (mremap(scratch, jl_page_size, jl_page_size,
+                   MREMAP_MAYMOVE | MREMAP_FIXED, (void*)page) == MAP_FAILED) {
+            jl_safe_printf("fatal: failed to materialize sysimage page\n");
+            abort();
+        }
+        lazy_reloc_done[pageno / 32] |= 1u << (pageno % 32);
+        if (lazy_reloc_touch_order)
+            lazy_reloc_touch_order[lazy_reloc_ntouched++] = (uint32_t)pageno;
+    }
+    jl_atomic_store_release(&lazy_reloc_lock, 0);
+    return 1;
+}
+
+// Make [data, data+n) safe to hand to a syscall. The kernel reports EFAULT
+// for a still-protected page instead of delivering SIGSEGV, so e.g. write(2)
+// on sysimage string data would fail rather than materialize it; callers
+// that pass possibly-image memory to the kernel directly (ios.c large
+// writes, the libuv write paths) prefault the range first.
+JL_DLLEXPORT void jl_sysimg_prefault(const void *data, size_t n) JL_NOTSAFEPOINT
+{
+    if (n == 0 || lazy_reloc_hi == 0)
+        return;
+    uintptr_t a = (uintptr_t)data;
+    uintptr_t end = a + n;
+    if (a < lazy_reloc_lo)
+        a = lazy_reloc_lo;
+    if (end > lazy_reloc_hi)
+        end = lazy_reloc_hi;
+    for (a &= ~(uintptr_t)(jl_page_size - 1); a < end; a += jl_page_size) {
+        if (!jl_lazy_reloc_materialized(a))
+            jl_sysimg_materialize_page((void*)a);
+    }
+}
+
+// write the first-touch page trace to the file named by
+// JULIA_SYSIMG_PAGE_TRACE, one page index per line in touch order
+// (called from jl_atexit_hook)
+void jl_write_sysimg_page_trace(void)
+{
+    char *fname = getenv(SYSIMG_PAGE_TRACE_NAME);
+    if (fname == NULL || lazy_reloc_touch_order == NULL)
+        return;
+    ios_t f;
+    if (ios_file(&f, fname, 1, 1, 1, 1) == NULL) {
+        jl_printf(JL_STDERR, "error writing sysimg page trace to \"%s\"\n", fname);
+        return;
+    }
+    for (size_t i = 0; i < lazy_reloc_ntouched; i++)
+        ios_printf(&f, "%u\n", (unsigned)lazy_reloc_touch_order[i]);
+    ios_close(&f);
+}
+
+#else
+
+STATIC_INLINE int jl_lazy_reloc_pending(uintptr_t a) JL_NOTSAFEPOINT
+{
+    (void)a;
+    return 0;
+}
+
+STATIC_INLINE int jl_lazy_reloc_materialized(uintptr_t a) JL_NOTSAFEPOINT
+{
+    (void)a;
+    return 1;
+}
+
+static int jl_lazy_reloc_begin(jl_serializer_state *s)
+{
+    (void)s;
+    return 0;
+}
+
+JL_DLLEXPORT int jl_sysimg_materialize_page(void *addr) JL_NOTSAFEPOINT
+{
+    (void)addr;
+    return 0;
+}
+
+JL_DLLEXPORT void jl_sysimg_prefault(const void *data, size_t n) JL_NOTSAFEPOINT
+{
+    (void)data;
+    (void)n;
+}
+
+void jl_write_sysimg_page_trace(void)
+{
+}
+
+#endif
+
+
 static void jl_write_skiplist(ios_t *s, char *base, size_t size, arraylist_t *list)
 {
     size_t i;
@@ -1300,6 +1625,8 @@ static void jl_read_relocations(jl_serializer_state *s, uint8_t bits)
         if (offset == 0)
             break;
         uintptr_t *pv = (uintptr_t*)(base + offset);
+        if (jl_lazy_reloc_pending((uintptr_t)pv))
+            continue; // applied when the page is first touched
         uintptr_t v = *pv;
         v = get_item_for_reloc(s, base, size, v);
         *pv = v | bits;
@@ -1319,6 +1646,11 @@ void gc_sweep_sysimg(void)
         if (offset == 0)
             break;
         jl_taggedvalue_t *o = (jl_taggedvalue_t*)(base + offset);
+        // objects on still-protected pages were not reached this cycle and
+        // keep their as-serialized GC_OLD_MARKED bits; writing to them here
+        // would materialize (and unshare) the page for nothing
+        if (!jl_lazy_reloc_materialized((uintptr_t)o))
+            continue;
         o->bits.gc = GC_OLD;
     }
 }
@@ -1445,6 +1777,19 @@ static void jl_reinit_item(jl_value_t *v, int how) JL_GC_DISABLED
         case 1: { // rehash IdDict
             jl_array_t **a = (jl_array_t**)v;
             assert(jl_is_array(*a));
+            jl_value_t *old = ((jl_value_t**)v)[3];
+            if (old != jl_nothing && jl_is_array(old)) {
+                // finish an in-progress incremental resize so only the
+                // current table needs rehashing
+                size_t i, l = jl_array_len(old);
+                jl_value_t **ol = (jl_value_t**)((jl_array_t*)old)->data;
+                for (i = 0; i < l; i += 2) {
+                    if (ol[i + 1] != NULL)
+                        *a = jl_eqtable_put(*a, ol[i], ol[i + 1], NULL);
+                }
+                ((jl_value_t**)v)[3] = jl_nothing;
+                ((intptr_t*)v)[4] = 0;
+            }
             // Assume *a don't need a write barrier
             *a = jl_idtable_rehash(*a, jl_array_len(*a));
             jl_gc_wb(v, *a);
@@ -1678,6 +2023,8 @@ static void jl_save_system_image_to_stream(ios_t *f) JL_GC_DISABLED
     int en = jl_gc_enable(0);
     jl_init_serializer2(1);
     htable_reset(&backref_table, 250000);
+    char *cold = getenv(SYSIMG_COLD_LAYOUT_NAME);
+    cold_layout_enabled = !(cold && strcmp(cold, "0") == 0);
     arraylist_new(&reinit_list, 0);
     arraylist_new(&ccallable_list, 0);
     backref_table_numel = 0;
@@ -1954,6 +2301,7 @@ static void jl_restore_system_image_from_stream(ios_t *f) JL_GC_DISABLED
     jl_gc_set_permalloc_region((void*)sysimg_base, (void*)(sysimg_base + sysimg.size));
 
     s.s = &sysimg;
+    jl_lazy_reloc_begin(&s); // may protect the image and defer interior relocations
     jl_read_relocations(&s, GC_OLD_MARKED); // gctags
     size_t sizeof_tags = ios_pos(&relocs);
     (void)sizeof_tags;
@@ -2054,6 +2402,7 @@ static void jl_init_serializer2(int for_serialize)
         htable_new(&symbol_table, 0);
         htable_new(&fptr_to_id, sizeof(id_to_fptrs) / sizeof(*id_to_fptrs));
         htable_new(&backref_table, 0);
+        htable_new(&cold_set, 0);
         uintptr_t i;
         for (i = 0; id_to_fptrs[i] != NULL; i++) {
             ptrhash_put(&fptr_to_id, (void*)(uintptr_t)id_to_fptrs[i], (void*)(i + 2));
@@ -2070,6 +2419,7 @@ static void jl_cleanup_serializer2(void)
     htable_reset(&symbol_table, 0);
     htable_reset(&fptr_to_id, 0);
     htable_reset(&backref_table, 0);
+    htable_reset(&cold_set, 0);
     arraylist_free(&deser_sym);
 }
 
@@ -1842,6 +1842,32 @@ JL_DLLEXPORT int jl_obvious_subtype(jl_value_t *x, jl_value_t *y, int *subtype)
 // points to a rooted array of length `jl_subtype_env_size(y)`.
 // This will be populated with the values of variables from unionall
 // types at the outer level of `y`.
+// Bounded memoization of full subtyping verdicts. Inference asks the same
+// (sub, super) questions over and over, and jl_obvious_subtype only settles
+// the trivial ones; this table remembers constraint-solver verdicts for
+// typevar-free pairs, which are world-independent and depend only on the
+// (immutable) type objects. Keys are compared by pointer, so a hit requires
+// the same objects to be re-queried — which is the common case, since type
+// objects are widely shared — and the entries root their keys so a stale
+// pointer can never alias a newly allocated type. The lock only guards
+// queries that were about to run the solver anyway, so it is not on any
+// fast path.
+jl_subtype_cache_entry_t jl_subtype_cache[JL_N_SUBTYPE_CACHE];
+static jl_mutex_t subtype_cache_lock;
+static _Atomic(uint64_t) subtype_cache_hits;
+static _Atomic(uint64_t) subtype_cache_misses;
+static _Atomic(uint64_t) subtype_cache_evictions;
+
+JL_DLLEXPORT void jl_get_subtype_cache_stats(uint64_t *hits, uint64_t *misses, uint64_t *evictions)
+{
+    if (hits)
+        *hits = jl_atomic_load_relaxed(&subtype_cache_hits);
+    if (misses)
+        *misses = jl_atomic_load_relaxed(&subtype_cache_misses);
+    if (evictions)
+        *evictions = jl_atomic_load_relaxed(&subtype_cache_evictions);
+}
+
 JL_DLLEXPORT int jl_subtype_env(jl_value_t *x, jl_value_t *y, jl_value_t **env, int envsz)
 {
     jl_stenv_t e;
@@ -1874,6 +1900,20 @@ JL_DLLEXPORT int jl_subtype_env(jl_value_t *x, jl_value_t *y, jl_value_t **env,
     else {
         obvious_subtype = 3;
     }
+    jl_subtype_cache_entry_t *slot = NULL;
+    if (envsz == 0 && obvious_subtype == 3 &&
+            !jl_has_free_typevars(x) && !jl_has_free_typevars(y)) {
+        slot = &jl_subtype_cache[bitmix(x, y) & (JL_N_SUBTYPE_CACHE - 1)];
+        JL_LOCK_NOGC(&subtype_cache_lock);
+        if (slot->x == x && slot->y == y) {
+            int result = slot->result;
+            JL_UNLOCK_NOGC(&subtype_cache_lock);
+            jl_atomic_fetch_add_relaxed(&subtype_cache_hits, 1);
+            return result;
+        }
+        JL_UNLOCK_NOGC(&subtype_cache_lock);
+        jl_atomic_fetch_add_relaxed(&subtype_cache_misses, 1);
+    }
     init_stenv(&e, env, envsz);
     int subtype = forall_exists_subtype(x, y, &e, 0);
     assert(obvious_subtype == 3 || obvious_subtype == subtype || jl_has_free_typevars(x) || jl_has_free_typevars(y));
@@ -1881,6 +1921,15 @@ JL_DLLEXPORT int jl_subtype_env(jl_value_t *x, jl_value_t *y, jl_value_t **env,
     if (obvious_subtype == 0 || (obvious_subtype == 1 && envsz == 0))
         subtype = obvious_subtype; // this ensures that running in a debugger doesn't change the result
 #endif
+    if (slot) {
+        JL_LOCK_NOGC(&subtype_cache_lock);
+        if (slot->x != NULL && !(slot->x == x && slot->y == y))
+            jl_atomic_fetch_add_relaxed(&subtype_cache_evictions, 1);
+        slot->x = x;
+        slot->y = y;
+        slot->result = subtype;
+        JL_UNLOCK_NOGC(&subtype_cache_lock);
+    }
     return subtype;
 }
 
@@ -3376,7 +3425,7 @@ static int might_intersect_concrete(jl_value_t *a)
 }
 
 // sets *issubty to 1 iff `a` is a subtype of `b`
-jl_value_t *jl_type_intersection_env_s(jl_value_t *a, jl_value_t *b, jl_svec_t **penv, int *issubty)
+static jl_value_t *type_intersection_env_s(jl_value_t *a, jl_value_t *b, jl_svec_t **penv, int *issubty)
 {
     if (issubty) *issubty = 0;
     if (obviously_disjoint(a, b, 0)) {
@@ -3465,6 +3514,50 @@ jl_value_t *jl_type_intersection_env_s(jl_value_t *a, jl_value_t *b, jl_svec_t *
     return *ans;
 }
 
+// Memoized intersection results, companion to jl_subtype_cache above. Method
+// matching intersects the same method-signature x query-signature pairs over
+// and over while sorting applicable methods; like subtyping verdicts, the
+// results for typevar-free inputs depend only on the two (immutable) type
+// objects. The typevar environment is part of the cached result, so a query
+// that needs the environment can only be served by an entry that computed it.
+jl_intersect_cache_entry_t jl_intersect_cache[JL_N_INTERSECT_CACHE];
+static jl_mutex_t intersect_cache_lock;
+
+jl_value_t *jl_type_intersection_env_s(jl_value_t *a, jl_value_t *b, jl_svec_t **penv, int *issubty)
+{
+    jl_intersect_cache_entry_t *slot = NULL;
+    if (!jl_has_free_typevars(a) && !jl_has_free_typevars(b)) {
+        slot = &jl_intersect_cache[bitmix(a, b) & (JL_N_INTERSECT_CACHE - 1)];
+        JL_LOCK_NOGC(&intersect_cache_lock);
+        if (slot->a == a && slot->b == b &&
+                (penv == NULL || slot->env != NULL || slot->ti == jl_bottom_type)) {
+            jl_value_t *ti = slot->ti;
+            if (penv && slot->env != NULL)
+                *penv = slot->env;
+            if (issubty)
+                *issubty = slot->issubty;
+            JL_UNLOCK_NOGC(&intersect_cache_lock);
+            return ti;
+        }
+        JL_UNLOCK_NOGC(&intersect_cache_lock);
+    }
+    int subty = 0;
+    jl_value_t *ti = type_intersection_env_s(a, b, penv, &subty);
+    if (issubty)
+        *issubty = subty;
+    if (slot) {
+        JL_LOCK_NOGC(&intersect_cache_lock);
+        slot->a = a;
+        slot->b = b;
+        slot->ti = ti;
+        // the environment is only produced for non-bottom results
+        slot->env = (penv && ti != jl_bottom_type) ? *penv : NULL;
+        slot->issubty = subty;
+        JL_UNLOCK_NOGC(&intersect_cache_lock);
+    }
+    return ti;
+}
+
 jl_value_t *jl_type_intersection_env(jl_value_t *a, jl_value_t *b, jl_svec_t **penv)
 {
     return jl_type_intersection_env_s(a, b, penv, NULL);
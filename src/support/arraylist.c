@@ -42,24 +42,25 @@ void arraylist_grow(arraylist_t *a, size_t n)
     size_t len = a->len;
     size_t newlen = len + n;
     if (newlen > a->max) {
+        size_t nm = a->max * 2;
+        if (nm == 0)
+            nm = 1;
+        while (newlen > nm)
+            nm *= 2;
         if (a->items == &a->_space[0]) {
-            void **p = (void**)LLT_ALLOC((a->len+n)*sizeof(void*));
+            // grow geometrically here too, so lists that immediately outgrow
+            // the inline space don't reallocate on every subsequent push
+            void **p = (void**)LLT_ALLOC(nm*sizeof(void*));
             if (p == NULL) return;
             memcpy(p, a->items, len * sizeof(void*));
             a->items = p;
-            a->max = newlen;
         }
         else {
-            size_t nm = a->max * 2;
-            if (nm == 0)
-                nm = 1;
-            while (newlen > nm)
-                nm *= 2;
             void **p = (void**)LLT_REALLOC(a->items, nm * sizeof(void*));
             if (p == NULL) return;
             a->items = p;
-            a->max = nm;
         }
+        a->max = nm;
     }
     a->len = newlen;
 }
@@ -109,24 +110,24 @@ JL_DLLEXPORT void small_arraylist_grow(small_arraylist_t *a, uint32_t n)
     size_t len = a->len;
     size_t newlen = len + n;
     if (newlen > a->max) {
+        size_t nm = a->max * 2;
+        if (nm == 0)
+            nm = 1;
+        while (newlen > nm)
+            nm *= 2;
         if (a->items == &a->_space[0]) {
-            void **p = (void**)LLT_ALLOC((a->len+n)*sizeof(void*));
+            // see arraylist_grow: first heap allocation also grows geometrically
+            void **p = (void**)LLT_ALLOC(nm*sizeof(void*));
             if (p == NULL) return;
             memcpy(p, a->items, len * sizeof(void*));
             a->items = p;
-            a->max = newlen;
         }
         else {
-            size_t nm = a->max * 2;
-            if (nm == 0)
-                nm = 1;
-            while (newlen > nm)
-                nm *= 2;
             void **p = (void**)LLT_REALLOC(a->items, nm * sizeof(void*));
             if (p == NULL) return;
             a->items = p;
-            a->max = nm;
         }
+        a->max = nm;
     }
     a->len = newlen;
 }
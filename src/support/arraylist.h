@@ -3,9 +3,15 @@
 #ifndef JL_ARRAYLIST_H
 #define JL_ARRAYLIST_H
 
+// inline capacities; may be overridden at build time for workloads whose
+// hot lists are consistently larger (or smaller) than the defaults
+#ifndef AL_N_INLINE
 #define AL_N_INLINE 29
+#endif
 
+#ifndef SMALL_AL_N_INLINE
 #define SMALL_AL_N_INLINE 6
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -56,6 +56,87 @@ uint32_t bitvector_get(uint32_t *b, uint64_t n)
     return b[n>>5] & (1<<(n&31));
 }
 
+// mask covering bits [n0&31, 31] resp. [0, n1&31] of a word
+#define lomask(n0) (~(uint32_t)0 << ((n0) & 31))
+#define himask(n1) (~(uint32_t)0 >> (31 - ((n1) & 31)))
+
+#ifdef __GNUC__
+#define count_bits(w) ((uint64_t)__builtin_popcount(w))
+#else
+static uint64_t count_bits(uint32_t w)
+{
+    w = w - ((w >> 1) & 0x55555555);
+    w = (w & 0x33333333) + ((w >> 2) & 0x33333333);
+    w = (w + (w >> 4)) & 0x0f0f0f0f;
+    return (w * 0x01010101) >> 24;
+}
+#endif
+
+// range kernels: all operate on the bit range [n0, n1] (inclusive), handling
+// misaligned ends with masked first/last words so the interior runs as plain
+// full-word operations the compiler can vectorize
+
+uint64_t bitvector_count(uint32_t *b, uint64_t n0, uint64_t n1)
+{
+    if (n1 < n0)
+        return 0;
+    size_t i = n0 >> 5, j = n1 >> 5;
+    if (i == j)
+        return count_bits(b[i] & lomask(n0) & himask(n1));
+    uint64_t c = count_bits(b[i] & lomask(n0));
+    for (i++; i < j; i++)
+        c += count_bits(b[i]);
+    return c + count_bits(b[j] & himask(n1));
+}
+
+int bitvector_any1(uint32_t *b, uint64_t n0, uint64_t n1)
+{
+    if (n1 < n0)
+        return 0;
+    size_t i = n0 >> 5, j = n1 >> 5;
+    if (i == j)
+        return (b[i] & lomask(n0) & himask(n1)) != 0;
+    if (b[i] & lomask(n0))
+        return 1;
+    for (i++; i < j; i++)
+        if (b[i])
+            return 1;
+    return (b[j] & himask(n1)) != 0;
+}
+
+void bitvector_fill(uint32_t *b, uint64_t n0, uint64_t n1, uint32_t c)
+{
+    if (n1 < n0)
+        return;
+    size_t i = n0 >> 5, j = n1 >> 5;
+    if (i == j) {
+        uint32_t m = lomask(n0) & himask(n1);
+        b[i] = c ? (b[i] | m) : (b[i] & ~m);
+        return;
+    }
+    b[i] = c ? (b[i] | lomask(n0)) : (b[i] & ~lomask(n0));
+    if (j > i + 1)
+        memset(&b[i + 1], c ? 0xff : 0, (j - i - 1) * sizeof(uint32_t));
+    b[j] = c ? (b[j] | himask(n1)) : (b[j] & ~himask(n1));
+}
+
+// copy bits [n0, n1] of src to the same positions in dest
+void bitvector_copy(uint32_t *dest, uint32_t *src, uint64_t n0, uint64_t n1)
+{
+    if (n1 < n0)
+        return;
+    size_t i = n0 >> 5, j = n1 >> 5;
+    if (i == j) {
+        uint32_t m = lomask(n0) & himask(n1);
+        dest[i] = (dest[i] & ~m) | (src[i] & m);
+        return;
+    }
+    dest[i] = (dest[i] & ~lomask(n0)) | (src[i] & lomask(n0));
+    if (j > i + 1)
+        memcpy(&dest[i + 1], &src[i + 1], (j - i - 1) * sizeof(uint32_t));
+    dest[j] = (dest[j] & ~himask(n1)) | (src[j] & himask(n1));
+}
+
 #ifdef __cplusplus
 }
 #endif
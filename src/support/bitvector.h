@@ -15,6 +15,13 @@ size_t bitvector_nwords(uint64_t nbits);
 JL_DLLEXPORT void bitvector_set(uint32_t *b, uint64_t n, uint32_t c);
 JL_DLLEXPORT uint32_t bitvector_get(uint32_t *b, uint64_t n);
 
+// range kernels over the inclusive bit range [n0, n1]; misaligned ends are
+// handled with masked first/last words, the interior as full words
+JL_DLLEXPORT uint64_t bitvector_count(uint32_t *b, uint64_t n0, uint64_t n1);
+JL_DLLEXPORT int bitvector_any1(uint32_t *b, uint64_t n0, uint64_t n1);
+JL_DLLEXPORT void bitvector_fill(uint32_t *b, uint64_t n0, uint64_t n1, uint32_t c);
+JL_DLLEXPORT void bitvector_copy(uint32_t *dest, uint32_t *src, uint64_t n0, uint64_t n1);
+
 #ifdef __cplusplus
 }
 #endif
@@ -94,6 +94,76 @@ uint32_t memhash32_seed(const char *buf, size_t n, uint32_t seed)
     return out;
 }
 
+// fast process-local hashing --------------------------------------------------
+
+// memhash_fast is for hashes that never leave the process (in-memory table
+// probing); it may produce different values on different CPUs, so call sites
+// whose hashes are persisted (symbol/object ids, anything reachable from a
+// system image) must keep using memhash.
+
+#if defined(_CPU_X86_64_) && defined(__GNUC__)
+
+// two interleaved CRC32C lanes (~16 bytes/cycle on most cores), combined and
+// finalized with int64hash to spread the 32-bit lane results over 64 bits
+__attribute__((target("sse4.2")))
+static uint64_t memhash_crc(const char *buf, size_t n) JL_NOTSAFEPOINT
+{
+    uint64_t c1 = 0xcafe8881u ^ n;
+    uint64_t c2 = 0x9e3779b97f4a7c15ULL + n;
+    const char *end = buf + (n & ~(size_t)15);
+    while (buf < end) {
+        uint64_t a, b;
+        memcpy(&a, buf, 8);
+        memcpy(&b, buf + 8, 8);
+        c1 = __builtin_ia32_crc32di(c1, a);
+        c2 = __builtin_ia32_crc32di(c2, b);
+        buf += 16;
+    }
+    n &= 15;
+    if (n >= 8) {
+        uint64_t a;
+        memcpy(&a, buf, 8);
+        c1 = __builtin_ia32_crc32di(c1, a);
+        buf += 8;
+        n -= 8;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, buf, n);
+    c2 = __builtin_ia32_crc32di(c2, tail);
+    return int64hash((c1 << 32) | c2);
+}
+
+static uint64_t memhash_dispatch(const char *buf, size_t n) JL_NOTSAFEPOINT;
+static uint64_t (*memhash_fast_ptr)(const char *buf, size_t n) JL_NOTSAFEPOINT = memhash_dispatch;
+
+static uint64_t memhash_dispatch(const char *buf, size_t n)
+{
+    // racing initializations store the same value, so this needs no locking
+    uint64_t (*f)(const char*, size_t) =
+        __builtin_cpu_supports("sse4.2") ? memhash_crc : memhash;
+    memhash_fast_ptr = f;
+    return f(buf, n);
+}
+
+uint64_t memhash_fast(const char *buf, size_t n)
+{
+    return memhash_fast_ptr(buf, n);
+}
+
+#else
+
+uint64_t memhash_fast(const char *buf, size_t n)
+{
+    return memhash(buf, n);
+}
+
+#endif
+
+uint32_t memhash32_fast(const char *buf, size_t n)
+{
+    return (uint32_t)memhash_fast(buf, n);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,11 @@ JL_DLLEXPORT uint64_t memhash(const char *buf, size_t n) JL_NOTSAFEPOINT;
 JL_DLLEXPORT uint64_t memhash_seed(const char *buf, size_t n, uint32_t seed) JL_NOTSAFEPOINT;
 JL_DLLEXPORT uint32_t memhash32(const char *buf, size_t n) JL_NOTSAFEPOINT;
 JL_DLLEXPORT uint32_t memhash32_seed(const char *buf, size_t n, uint32_t seed) JL_NOTSAFEPOINT;
+// runtime-dispatched (CRC32C where available) variants for hashes that never
+// leave the process; values may differ between CPUs, so anything persisted
+// (object ids, symbol hashes in a system image) must use memhash above
+uint64_t memhash_fast(const char *buf, size_t n) JL_NOTSAFEPOINT;
+uint32_t memhash32_fast(const char *buf, size_t n) JL_NOTSAFEPOINT;
 
 #ifdef _P64
 STATIC_INLINE uint64_t bitmix(uint64_t a, uint64_t b) JL_NOTSAFEPOINT
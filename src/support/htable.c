@@ -18,31 +18,59 @@
 extern "C" {
 #endif
 
+#define HT_CACHE_ALIGNMENT 64
+
+void *htable_aligned_alloc(size_t n)
+{
+#if defined(_OS_WINDOWS_)
+    return _aligned_malloc(n, HT_CACHE_ALIGNMENT);
+#else
+    void *p;
+    if (posix_memalign(&p, HT_CACHE_ALIGNMENT, n))
+        return NULL;
+    return p;
+#endif
+}
+
+void htable_aligned_free(void *p)
+{
+#if defined(_OS_WINDOWS_)
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
 htable_t *htable_new(htable_t *h, size_t size)
 {
     if (size <= HT_N_INLINE / 2) {
         h->size = size = HT_N_INLINE;
         h->table = &h->_space[0];
+        h->ctrl = &h->_cspace[0];
     }
     else {
         size = next_power_of_two(size);
         size *= 2;  // 2 pointers per key/value pair
         size *= 2;  // aim for 50% occupancy
         h->size = size;
-        h->table = (void**)LLT_ALLOC(size * sizeof(void*));
+        h->table = (void**)htable_aligned_alloc(size * sizeof(void*));
+        h->ctrl = (uint8_t*)htable_aligned_alloc(size / 2);
     }
-    if (h->table == NULL)
+    if (h->table == NULL || h->ctrl == NULL)
         return NULL;
     size_t i;
     for (i = 0; i < size; i++)
         h->table[i] = HT_NOTFOUND;
+    memset(h->ctrl, 0, size / 2);
     return h;
 }
 
 void htable_free(htable_t *h)
 {
-    if (h->table != &h->_space[0])
-        LLT_FREE(h->table);
+    if (h->table != &h->_space[0]) {
+        htable_aligned_free(h->table);
+        htable_aligned_free(h->ctrl);
+    }
 }
 
 // empty and reduce size
@@ -50,8 +78,10 @@ void htable_reset(htable_t *h, size_t sz)
 {
     sz = next_power_of_two(sz);
     if (h->size > sz * 4 && h->size > HT_N_INLINE) {
-        LLT_FREE(h->table);
+        htable_aligned_free(h->table);
+        htable_aligned_free(h->ctrl);
         h->table = NULL;
+        h->ctrl = NULL;
         if (htable_new(h, sz) == NULL)
             htable_new(h, 0);
     }
@@ -59,6 +89,7 @@ void htable_reset(htable_t *h, size_t sz)
         size_t i, hsz = h->size;
         for (i = 0; i < hsz; i++)
             h->table[i] = HT_NOTFOUND;
+        memset(h->ctrl, 0, hsz / 2);
     }
 }
 
@@ -3,10 +3,16 @@
 #ifndef JL_HTABLE_H
 #define JL_HTABLE_H
 
+// number of inline table slots (HT_N_INLINE/2 key/value pairs); may be
+// overridden at build time to trade struct size against heap traffic for
+// workloads dominated by tiny tables
+#ifndef HT_N_INLINE
 #define HT_N_INLINE 32
+#endif
 
 #include "analyzer_annotations.h"
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,11 +26,21 @@ extern "C" {
 // where `2*i < size`. An empty slot at index `i` is indicated with
 // `value == HT_NOTFOUND`.
 //
-// `_space` is reserved space for efficiently allocating small tables.
+// `ctrl` holds one control byte per slot: 0 for a slot with no key, else the
+// top 7 bits of the key's hash with the high bit set. Probes scan this dense
+// byte array and only touch `table` when the byte matches, so long probe
+// chains stay within a cache line or two instead of striding through the
+// 16-bytes-per-slot table. Code that rewrites keys in place (the flisp GC)
+// stays correct because the replacement key hashes identically.
+//
+// `_space`/`_cspace` are reserved space for efficiently allocating small
+// tables.
 typedef struct {
     size_t size;
     void **table;
+    uint8_t *ctrl;
     void *_space[HT_N_INLINE];
+    uint8_t _cspace[HT_N_INLINE / 2];
 } htable_t;
 
 // define this to be an invalid key/value
@@ -35,6 +51,12 @@ typedef struct {
 htable_t *htable_new(htable_t *h, size_t size) JL_NOTSAFEPOINT;
 void htable_free(htable_t *h);
 
+// cache-line-aligned allocation for the probe arrays, so each group of
+// control bytes or buckets starts on a line boundary; pointers from this
+// must be released with htable_aligned_free
+void *htable_aligned_alloc(size_t n) JL_NOTSAFEPOINT;
+void htable_aligned_free(void *p) JL_NOTSAFEPOINT;
+
 // clear and (possibly) change size
 void htable_reset(htable_t *h, size_t sz);
 
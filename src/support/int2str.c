@@ -1,6 +1,7 @@
 // This file is a part of Julia. License is MIT: https://julialang.org/license
 
 #include <stdlib.h>
+#include <string.h>
 #include "dtypes.h"
 #include "utils.h"
 
@@ -8,12 +9,34 @@
 extern "C" {
 #endif
 
+// all two-digit decimal numbers, for emitting base-10 output two digits at
+// a time (one strength-reduced division per pair instead of per digit)
+static const char digits2[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
 char *uint2str(char *dest, size_t len, uint64_t num, uint32_t base)
 {
     int i = len-1;
     uint64_t b = (uint64_t)base;
     char ch;
     dest[i--] = '\0';
+    if (base == 10) {
+        while (i >= 1 && num >= 100) {
+            const char *d = &digits2[(num % 100) * 2];
+            num /= 100;
+            dest[i--] = d[1];
+            dest[i--] = d[0];
+        }
+    }
     while (i >= 0) {
         ch = (char)(num % b);
         if (ch < 10)
@@ -28,6 +51,46 @@ char *uint2str(char *dest, size_t len, uint64_t num, uint32_t base)
     return &dest[i+1];
 }
 
+// write num in decimal (plus a terminating NUL) at the start of dest and
+// return the length, excluding the NUL. dest must hold at least 21 bytes.
+JL_DLLEXPORT size_t jl_format_uint64(char *dest, uint64_t num)
+{
+    char buf[20];
+    char *p = &buf[sizeof(buf)];
+    size_t n;
+    while (num >= 100) {
+        const char *d = &digits2[(num % 100) * 2];
+        num /= 100;
+        *--p = d[1];
+        *--p = d[0];
+    }
+    if (num >= 10) {
+        const char *d = &digits2[num * 2];
+        *--p = d[1];
+        *--p = d[0];
+    }
+    else {
+        *--p = '0' + (char)num;
+    }
+    n = (size_t)(&buf[sizeof(buf)] - p);
+    memcpy(dest, p, n);
+    dest[n] = '\0';
+    return n;
+}
+
+// signed variant; dest must hold at least 22 bytes
+JL_DLLEXPORT size_t jl_format_int64(char *dest, int64_t num)
+{
+    uint64_t u = (uint64_t)num;
+    size_t neg = 0;
+    if (num < 0) {
+        dest[0] = '-';
+        u = -u;
+        neg = 1;
+    }
+    return neg + jl_format_uint64(dest + neg, u);
+}
+
 int isdigit_base(char c, int base)
 {
     if (base < 11)
@@ -22,6 +22,8 @@
 #include <sys/time.h>
 #include <sys/select.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #endif
 
@@ -45,6 +47,18 @@ static void set_io_wait_begin(int v)
     }
 }
 
+// called with user buffers about to be handed to a write syscall, which
+// reports EFAULT for protected pages instead of faulting them in (the julia
+// runtime points this at jl_sysimg_prefault for lazily-relocated sysimage
+// memory)
+void (*ios_prefault_func)(const void*, size_t) = NULL;
+static void prefault(const void *buf, size_t n)
+{
+    if (__unlikely(ios_prefault_func)) {
+        ios_prefault_func(buf, n);
+    }
+}
+
 /* OS-level primitive wrappers */
 
 #if defined(__APPLE__) || defined(_OS_WINDOWS_)
@@ -178,6 +192,92 @@ int _os_write_all(long fd, const void *buf, size_t n, size_t *nwritten)
     return 0;
 }
 
+#if !defined(_OS_WINDOWS_)
+// like _os_write_all, but for an iovec array. iov is clobbered as partial
+// writes are consumed.
+static int _os_writev_all(long fd, struct iovec *iov, int iovcnt, size_t *nwritten)
+{
+    ssize_t r;
+
+    *nwritten = 0;
+
+    while (iovcnt > 0) {
+        set_io_wait_begin(1);
+        r = writev((int)fd, iov, iovcnt);
+        set_io_wait_begin(0);
+        if (r < 0) {
+            if (!_enonfatal(errno))
+                return errno;
+            sleep_ms(SLEEP_TIME);
+            continue;
+        }
+        *nwritten += (size_t)r;
+        while (iovcnt > 0 && (size_t)r >= iov->iov_len) {
+            r -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (char*)iov->iov_base + r;
+            iov->iov_len -= (size_t)r;
+        }
+    }
+    return 0;
+}
+#endif
+
+// layered streams route device I/O through a filter callback into another
+// stream instead of a file descriptor (see ios_layer)
+typedef struct {
+    ios_t *stream;
+    ios_layer_readcb_t readcb;
+    ios_layer_writecb_t writecb;
+    void *state;
+} ios_layer_state_t;
+
+static int _dev_read(ios_t *s, void *buf, size_t n, size_t *nread)
+{
+    if (s->layered) {
+        ios_layer_state_t *l = (ios_layer_state_t*)(uintptr_t)s->userdata;
+        *nread = l->readcb(l->stream, (char*)buf, n, l->state);
+        return 0;
+    }
+    return _os_read(s->fd, buf, n, nread);
+}
+
+static int _dev_read_all(ios_t *s, void *buf, size_t n, size_t *nread)
+{
+    if (s->layered) {
+        ios_layer_state_t *l = (ios_layer_state_t*)(uintptr_t)s->userdata;
+        size_t got;
+        *nread = 0;
+        while (n > 0) {
+            got = l->readcb(l->stream, (char*)buf, n, l->state);
+            if (got == 0)
+                break;
+            n -= got;
+            *nread += got;
+            buf = (char*)buf + got;
+        }
+        return 0;
+    }
+    return _os_read_all(s->fd, buf, n, nread);
+}
+
+static int _dev_write_all(ios_t *s, const void *buf, size_t n, size_t *nwritten)
+{
+    prefault(buf, n);
+    if (s->layered) {
+        ios_layer_state_t *l = (ios_layer_state_t*)(uintptr_t)s->userdata;
+        *nwritten = 0;
+        if (l->writecb(l->stream, (const char*)buf, n, 0, l->state))
+            return -1;
+        *nwritten = n;
+        return 0;
+    }
+    return _os_write_all(s->fd, buf, n, nwritten);
+}
+
 
 /* internal utility functions */
 
@@ -253,6 +353,147 @@ static size_t _write_grow(ios_t *s, const char *data, size_t n)
 }
 
 
+/* gathered writes (see ios_gather_mode) */
+
+// full buffers are parked here instead of being written out one at a time;
+// the whole queue goes to the device in a single writev. queueing only
+// happens for pure sequential writes on a block-buffered fd stream, so while
+// the queue is non-empty the current buffer is always a plain append buffer
+// (bpos == ndirty == size). any read or seek flushes first and drains it.
+#define IOS_GATHER_MAXIOV 16
+
+typedef struct {
+    int nqueued;                      // buffers filled, in write order
+    int nspare;                       // drained buffers kept for reuse
+    size_t bufsize;                   // allocation size of every buffer
+    char *queued[IOS_GATHER_MAXIOV];
+    size_t len[IOS_GATHER_MAXIOV];
+    char *spare[IOS_GATHER_MAXIOV];
+} ios_gather_t;
+
+static size_t _gather_queued_bytes(ios_t *s)
+{
+    ios_gather_t *g = (ios_gather_t*)s->gather;
+    size_t tot = 0;
+    int i;
+    for (i = 0; i < g->nqueued; i++)
+        tot += g->len[i];
+    return tot;
+}
+
+// write the queued buffers plus the current dirty region in one writev
+static int _gather_flush(ios_t *s)
+{
+    ios_gather_t *g = (ios_gather_t*)s->gather;
+    size_t ntowrite = _gather_queued_bytes(s) + (size_t)s->ndirty;
+    size_t nw = 0;
+    int err = 0, i;
+    s->fpos = -1;
+#if !defined(_OS_WINDOWS_)
+    struct iovec iov[IOS_GATHER_MAXIOV + 1];
+    int cnt = 0;
+    for (i = 0; i < g->nqueued; i++) {
+        iov[cnt].iov_base = g->queued[i];
+        iov[cnt].iov_len = g->len[i];
+        cnt++;
+    }
+    if (s->ndirty > 0) {
+        iov[cnt].iov_base = s->buf;
+        iov[cnt].iov_len = (size_t)s->ndirty;
+        cnt++;
+    }
+    if (cnt > 0)
+        err = _os_writev_all(s->fd, iov, cnt, &nw);
+#else
+    size_t w;
+    for (i = 0; i < g->nqueued && !err; i++) {
+        err = _os_write_all(s->fd, g->queued[i], g->len[i], &w);
+        nw += w;
+    }
+    if (s->ndirty > 0 && !err) {
+        err = _os_write_all(s->fd, s->buf, (size_t)s->ndirty, &w);
+        nw += w;
+    }
+#endif
+    for (i = 0; i < g->nqueued; i++) {
+        if (g->nspare < IOS_GATHER_MAXIOV)
+            g->spare[g->nspare++] = g->queued[i];
+        else
+            LLT_FREE(g->queued[i]);
+    }
+    g->nqueued = 0;
+    // queueing implies a pure append buffer, so nothing to preserve
+    s->bpos = s->size = s->ndirty = 0;
+    if (err)
+        return err;
+    if (nw < ntowrite)
+        return -1;
+    return 0;
+}
+
+// whether the current buffer can be queued whole once it fills
+static int _gather_active(ios_t *s)
+{
+    ios_gather_t *g = (ios_gather_t*)s->gather;
+    return g != NULL && !s->layered && s->fd != -1 && s->bm == bm_block &&
+        s->ownbuf && s->buf != &s->local[0] &&
+        g->bufsize == (size_t)s->maxsize &&
+        s->ndirty == s->bpos && s->size == s->bpos;
+}
+
+// park the (full) current buffer on the queue and swap in an empty one;
+// drains everything instead if the queue is full or no buffer is available
+static int _gather_push(ios_t *s)
+{
+    ios_gather_t *g = (ios_gather_t*)s->gather;
+    char *fresh;
+    if (g->nqueued == IOS_GATHER_MAXIOV)
+        return _gather_flush(s);
+    fresh = g->nspare ? g->spare[--g->nspare] : (char*)LLT_ALLOC(g->bufsize);
+    if (fresh == NULL)
+        return _gather_flush(s);
+    g->queued[g->nqueued] = s->buf;
+    g->len[g->nqueued] = (size_t)s->ndirty;
+    g->nqueued++;
+    s->buf = fresh;
+    s->bpos = s->size = s->ndirty = 0;
+    return 0;
+}
+
+static void _gather_free(ios_t *s)
+{
+    ios_gather_t *g = (ios_gather_t*)s->gather;
+    assert(g->nqueued == 0);
+    while (g->nspare > 0)
+        LLT_FREE(g->spare[--g->nspare]);
+    LLT_FREE(g);
+    s->gather = NULL;
+}
+
+int ios_gather_mode(ios_t *s, int enable)
+{
+    if (enable) {
+        ios_gather_t *g;
+        if (s->gather != NULL)
+            return 0;
+        if (s->fd == -1 || s->layered || s->bm == bm_mem || !s->writable)
+            return -1;
+        g = (ios_gather_t*)LLT_ALLOC(sizeof(ios_gather_t));
+        if (g == NULL)
+            return -1;
+        g->nqueued = g->nspare = 0;
+        g->bufsize = (size_t)s->maxsize;
+        s->gather = g;
+    }
+    else if (s->gather != NULL) {
+        int err = ios_flush(s);
+        _gather_free(s);
+        return err;
+    }
+    return 0;
+}
+
+
 /* interface functions, low level */
 
 static size_t _ios_read(ios_t *s, char *dest, size_t n, int all)
@@ -276,7 +517,7 @@ static size_t _ios_read(ios_t *s, char *dest, size_t n, int all)
             if (ncopy >= n)
                 return tot+ncopy;
         }
-        if (s->bm == bm_mem || s->fd == -1) {
+        if (s->bm == bm_mem || (s->fd == -1 && !s->layered)) {
             // can't get any more data
             if (avail == 0)
                 s->_eof = 1;
@@ -295,12 +536,12 @@ static size_t _ios_read(ios_t *s, char *dest, size_t n, int all)
         if (n > MOST_OF(s->maxsize)) {
             // doesn't fit comfortably in buffer; go direct
             if (all) {
-                //result = _os_read_all(s->fd, dest, n, &got);
-                _os_read_all(s->fd, dest, n, &got);
+                //result = _dev_read_all(s, dest, n, &got);
+                _dev_read_all(s, dest, n, &got);
             }
             else {
-                //result = _os_read(s->fd, dest, n, &got);
-                _os_read(s->fd, dest, n, &got);
+                //result = _dev_read(s, dest, n, &got);
+                _dev_read(s, dest, n, &got);
             }
             tot += got;
             if (got == 0)
@@ -309,7 +550,7 @@ static size_t _ios_read(ios_t *s, char *dest, size_t n, int all)
         }
         else {
             // refill buffer
-            if (_os_read(s->fd, s->buf, (size_t)s->maxsize, &got)) {
+            if (_dev_read(s, s->buf, (size_t)s->maxsize, &got)) {
                 s->_eof = 1;
                 return tot;
             }
@@ -343,7 +584,7 @@ size_t ios_readprep(ios_t *s, size_t n)
     }
     size_t space = (size_t)(s->size - s->bpos);
     s->state = bst_rd;
-    if (space >= n || s->bm == bm_mem || s->fd == -1)
+    if (space >= n || s->bm == bm_mem || (s->fd == -1 && !s->layered))
         return space;
     if (s->maxsize < s->bpos+n) {
         // it won't fit. grow buffer or move data back.
@@ -360,7 +601,7 @@ size_t ios_readprep(ios_t *s, size_t n)
     }
     size_t got;
     s->fpos = -1;
-    int result = _os_read(s->fd, s->buf+s->size, (size_t)(s->maxsize - s->size), &got);
+    int result = _dev_read(s, s->buf+s->size, (size_t)(s->maxsize - s->size), &got);
     if (result)
         return space;
     s->size += got;
@@ -413,7 +654,7 @@ size_t ios_write(ios_t *s, const char *data, size_t n)
     }
     else if (s->bm == bm_none) {
         s->fpos = -1;
-        _os_write_all(s->fd, data, n, &wrote);
+        _dev_write_all(s, data, n, &wrote);
         return wrote;
     }
     else if (n <= space) {
@@ -433,11 +674,39 @@ size_t ios_write(ios_t *s, const char *data, size_t n)
         s->bpos += n;
         wrote += n;
     }
+    else if (s->gather != NULL && _gather_active(s)) {
+        // top off the current buffer, queue it for a gathered writev, and
+        // keep filling fresh buffers instead of paying a write() per buffer
+        while (n > space) {
+            if (space > 0) {
+                memcpy(s->buf + s->bpos, data, space);
+                s->bpos += space;
+                s->size = s->ndirty = s->bpos;
+                data += space;
+                n -= space;
+                wrote += space;
+            }
+            if (n > MOST_OF(s->maxsize)) {
+                // doesn't fit comfortably in a buffer; drain the queue and
+                // write the rest directly
+                size_t direct;
+                _gather_flush(s);
+                s->fpos = -1;
+                _dev_write_all(s, data, n, &direct);
+                return wrote + direct;
+            }
+            _gather_push(s);
+            space = (size_t)s->maxsize;
+        }
+        memcpy(s->buf + s->bpos, data, n);
+        s->bpos += n;
+        wrote += n;
+    }
     else {
         ios_flush(s);
         if (n > MOST_OF(s->maxsize)) {
             s->fpos = -1;
-            _os_write_all(s->fd, data, n, &wrote);
+            _dev_write_all(s, data, n, &wrote);
             return wrote;
         }
         return ios_write(s, data, n);
@@ -539,8 +808,11 @@ int64_t ios_pos(ios_t *s)
         s->fpos = fdpos;
     }
 
-    if (s->state == bst_wr)
+    if (s->state == bst_wr) {
         fdpos += s->bpos;
+        if (s->gather != NULL)
+            fdpos += _gather_queued_bytes(s);
+    }
     else if (s->state == bst_rd)
         fdpos -= (s->size - s->bpos);
     return fdpos;
@@ -599,7 +871,7 @@ int ios_eof(ios_t *s)
         return 0;
     if (s->bm == bm_mem)
         return (s->_eof ? 1 : 0);
-    if (s->fd == -1)
+    if (s->fd == -1 && !s->layered)
         return 1;
     if (s->_eof)
         return 1;
@@ -618,7 +890,7 @@ int ios_eof_blocking(ios_t *s)
         return 0;
     if (s->bm == bm_mem)
         return (s->_eof ? 1 : 0);
-    if (s->fd == -1)
+    if (s->fd == -1 && !s->layered)
         return 1;
 
     if (ios_readprep(s, 1) < 1)
@@ -628,27 +900,29 @@ int ios_eof_blocking(ios_t *s)
 
 int ios_flush(ios_t *s)
 {
+    if (s->gather != NULL && ((ios_gather_t*)s->gather)->nqueued > 0)
+        return _gather_flush(s);
     if (s->ndirty == 0 || s->bm == bm_mem || s->buf == NULL)
         return 0;
-    if (s->fd == -1)
+    if (s->fd == -1 && !s->layered)
         return -1;
 
-    if (s->state == bst_rd) {
+    if (s->state == bst_rd && !s->layered) {
         if (lseek(s->fd, -(off_t)s->size, SEEK_CUR) == (off_t)-1) {
         }
     }
 
     size_t nw, ntowrite=s->ndirty;
     s->fpos = -1;
-    int err = _os_write_all(s->fd, s->buf, ntowrite, &nw);
+    int err = _dev_write_all(s, s->buf, ntowrite, &nw);
     // todo: try recovering from some kinds of errors (e.g. retry)
 
-    if (s->state == bst_rd) {
+    if (s->state == bst_rd && !s->layered) {
         if (lseek(s->fd, (off_t)(s->size - nw), SEEK_CUR) == (off_t)-1) {
         }
     }
     else if (s->state == bst_wr) {
-        if (s->bpos != nw &&
+        if (!s->layered && s->bpos != nw &&
             lseek(s->fd, (off_t)(s->bpos - nw), SEEK_CUR) == (off_t)-1) {
         }
         // now preserve the invariant that data to write
@@ -673,13 +947,27 @@ int ios_flush(ios_t *s)
 
 int ios_close(ios_t *s)
 {
-    int err = ios_flush(s);
+    int err;
+    if (s->layered)
+        err = ios_layer_release(s);
+    else
+        err = ios_flush(s);
     if (s->fd != -1 && s->ownfd) {
         int err2 = close(s->fd);
         if (err2 != 0)
             err = err2;
     }
     s->fd = -1;
+    if (s->gather != NULL)
+        _gather_free(s);
+#if !defined(_OS_WINDOWS_)
+    if (s->buf != NULL && s->mapped) {
+        munmap(s->buf, (size_t)s->maxsize);
+        s->mapped = 0;
+        s->buf = NULL;
+        s->ownbuf = 0;
+    }
+#endif
     if (s->buf!=NULL && s->ownbuf && s->buf!=&s->local[0]) {
         LLT_FREE(s->buf);
     }
@@ -733,6 +1021,14 @@ char *ios_take_buffer(ios_t *s, size_t *psize)
 
     *psize = s->size + 1;
 
+#if !defined(_OS_WINDOWS_)
+    if (s->buf != NULL && s->mapped) {
+        munmap(s->buf, (size_t)s->maxsize);
+        s->mapped = 0;
+        s->buf = NULL;
+    }
+#endif
+
     /* empty stream and reinitialize */
     _buf_init(s, s->bm);
 
@@ -753,6 +1049,13 @@ int ios_setbuf(ios_t *s, char *buf, size_t size, int own)
     }
     s->size = nvalid;
 
+#if !defined(_OS_WINDOWS_)
+    if (s->buf != NULL && s->mapped) {
+        munmap(s->buf, (size_t)s->maxsize);
+        s->mapped = 0;
+    }
+    else
+#endif
     if (s->buf!=NULL && s->ownbuf && s->buf!=&s->local[0]) {
         LLT_FREE(s->buf);
     }
@@ -892,6 +1195,9 @@ static void _ios_init(ios_t *s)
     s->readable = 1;
     s->writable = 1;
     s->rereadable = 0;
+    s->layered = 0;
+    s->mapped = 0;
+    s->gather = NULL;
 }
 
 /* stream object initializers. we do no allocation. */
@@ -1042,6 +1348,73 @@ ios_t *ios_fd(ios_t *s, long fd, int isfile, int own)
     return s;
 }
 
+ios_t *ios_file_mmap(ios_t *s, const char *fname)
+{
+#if !defined(_OS_WINDOWS_)
+    int fd;
+    struct stat sb;
+    do
+        fd = open_cloexec(fname, O_RDONLY, 0);
+    while (-1 == fd && _enonfatal(errno));
+    if (fd == -1) {
+        s->fd = -1;
+        return NULL;
+    }
+    if (fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode) && sb.st_size > 0) {
+        char *m = (char*)mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m != MAP_FAILED) {
+            // the mapping outlives the descriptor
+            close(fd);
+            ios_static_buffer(s, m, (size_t)sb.st_size);
+            s->mapped = 1;
+            return s;
+        }
+    }
+    // empty, not a regular file, or the mapping failed: plain buffered reads
+    s = ios_fd(s, fd, 1, 1);
+    s->fpos = 0;
+    s->writable = 0;
+    return s;
+#else
+    return ios_file(s, fname, 1, 0, 0, 0);
+#endif
+}
+
+ios_t *ios_layer(ios_t *s, ios_t *underlying, ios_layer_readcb_t readcb,
+                 ios_layer_writecb_t writecb, void *state)
+{
+    ios_layer_state_t *l = (ios_layer_state_t*)LLT_ALLOC(sizeof(ios_layer_state_t));
+    if (l == NULL)
+        return NULL;
+    l->stream = underlying;
+    l->readcb = readcb;
+    l->writecb = writecb;
+    l->state = state;
+    _ios_init(s);
+    _buf_init(s, bm_block);
+    s->layered = 1;
+    s->userdata = (int64_t)(uintptr_t)l;
+    s->readable = (readcb != NULL);
+    s->writable = (writecb != NULL);
+    return s;
+}
+
+int ios_layer_release(ios_t *s)
+{
+    if (!s->layered)
+        return 0;
+    int err = ios_flush(s);
+    ios_layer_state_t *l = (ios_layer_state_t*)(uintptr_t)s->userdata;
+    // let the filter emit any trailing data (e.g. end a compressed stream)
+    if (s->writable && l->writecb(l->stream, NULL, 0, 1, l->state))
+        err = -1;
+    LLT_FREE(l);
+    s->layered = 0;
+    s->userdata = 0;
+    s->state = bst_none;
+    return err;
+}
+
 ios_t *ios_stdin = NULL;
 ios_t *ios_stdout = NULL;
 ios_t *ios_stderr = NULL;
@@ -64,6 +64,15 @@ JL_ATTRIBUTE_ALIGN_PTRSIZE(typedef struct {
     // again any number of times. usually only true for files and strings.
     unsigned char rereadable:1;
 
+    // the device of this stream is another ios_t with a filter callback in
+    // between, instead of a file descriptor (see ios_layer). userdata holds
+    // the filter bookkeeping while this is set.
+    unsigned char layered:1;
+
+    // buf is a read-only file mapping (see ios_file_mmap); ios_close
+    // unmaps it instead of freeing
+    unsigned char mapped:1;
+
     // this enables "stenciled writes". you can alternately write and
     // seek without flushing in between. this performs read-before-write
     // to populate the buffer, so "rereadable" capability is required.
@@ -74,12 +83,16 @@ JL_ATTRIBUTE_ALIGN_PTRSIZE(typedef struct {
     // unsigned char durable:1;
 
     int64_t userdata;
+    // queued full write buffers awaiting a gathered writev (see
+    // ios_gather_mode); NULL unless gather mode is enabled
+    void *gather;
     char local[IOS_INLSIZE];
 } ios_t);
 
 #undef ON_P64
 
 extern void (*ios_set_io_wait_func)(int);
+extern void (*ios_prefault_func)(const void*, size_t);
 /* low-level interface functions */
 JL_DLLEXPORT size_t ios_read(ios_t *s, char *dest, size_t n) JL_NOTSAFEPOINT;
 JL_DLLEXPORT size_t ios_readall(ios_t *s, char *dest, size_t n) JL_NOTSAFEPOINT;
@@ -119,6 +132,32 @@ JL_DLLEXPORT ios_t *ios_mem(ios_t *s, size_t initsize) JL_NOTSAFEPOINT;
 ios_t *ios_str(ios_t *s, char *str);
 ios_t *ios_static_buffer(ios_t *s, char *buf, size_t sz);
 JL_DLLEXPORT ios_t *ios_fd(ios_t *s, long fd, int isfile, int own);
+// read-only stream over a private mapping of an existing file: reads are
+// served straight out of the page cache, and consumers that want the whole
+// file (ios_readprep/ios_fillbuf) get pointers into the mapping with no
+// copies. falls back to an ordinary buffered fd stream when the file cannot
+// be mapped (empty, not regular, or no mmap on this platform).
+JL_DLLEXPORT ios_t *ios_file_mmap(ios_t *s, const char *fname);
+// batch writes on a block-buffered fd stream: full buffers are queued
+// instead of written out one by one, and the queue drains in a single
+// writev on flush (or when it fills). reads and seeks drain implicitly.
+// returns -1 if the stream cannot gather (memory/layered/unbuffered).
+JL_DLLEXPORT int ios_gather_mode(ios_t *s, int enable);
+// layered streams: device I/O goes through a filter callback into another
+// (still open) stream instead of a file descriptor, e.g. for compression.
+// layered streams are strictly sequential; seeking is not supported. the
+// write callback is invoked once more with n == 0 and finish == 1 when the
+// layer is released so the filter can emit any trailing data; the read
+// callback returns the number of bytes produced, with 0 meaning end of
+// stream. callbacks return into the layer's bounded buffer, so memory use
+// stays constant no matter how much data passes through.
+typedef size_t (*ios_layer_readcb_t)(ios_t *from, char *dest, size_t n, void *state);
+typedef int (*ios_layer_writecb_t)(ios_t *to, const char *data, size_t n, int finish, void *state);
+JL_DLLEXPORT ios_t *ios_layer(ios_t *s, ios_t *underlying, ios_layer_readcb_t readcb,
+                              ios_layer_writecb_t writecb, void *state);
+// flush buffered data through the filter and detach from the underlying
+// stream (which stays open); called implicitly by ios_close if needed
+JL_DLLEXPORT int ios_layer_release(ios_t *s);
 // todo: ios_socket
 extern JL_DLLEXPORT ios_t *ios_stdin;
 extern JL_DLLEXPORT ios_t *ios_stdout;
@@ -37,10 +37,46 @@
 
 #include "utf8.h"
 
+#if defined(_CPU_X86_64_) && defined(__GNUC__)
+#include <emmintrin.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// number of UTF-8 continuation bytes in an 8-byte chunk: a byte continues a
+// sequence iff its top bits are 10, i.e. bit 7 is set and bit 6 is clear,
+// which `w & ~(w << 1)` leaves in bit 7; the multiply sums the eight flags
+#define count_cont_bytes(w) \
+    ((size_t)((((w) & ~((w) << 1) & 0x8080808080808080ULL) >> 7) * 0x0101010101010101ULL >> 56))
+
+// return a pointer to the first byte in [pnt, pend) with the high bit set,
+// or pend if there is none
+static const unsigned char *u8_scan_ascii(const unsigned char *pnt,
+                                          const unsigned char *pend)
+{
+#if defined(_CPU_X86_64_) && defined(__GNUC__)
+    while (pnt + 16 <= pend) {
+        __m128i v = _mm_loadu_si128((const __m128i*)pnt);
+        int m = _mm_movemask_epi8(v);
+        if (m)
+            return pnt + __builtin_ctz(m);
+        pnt += 16;
+    }
+#endif
+    while (pnt + sizeof(uint64_t) <= pend) {
+        uint64_t w;
+        memcpy(&w, pnt, sizeof(uint64_t));
+        if (w & 0x8080808080808080ULL)
+            break;
+        pnt += sizeof(uint64_t);
+    }
+    while (pnt < pend && !(*pnt & 0x80))
+        pnt++;
+    return pnt;
+}
+
 static const uint32_t offsetsFromUTF8[6] = {
     0x00000000UL, 0x00003080UL, 0x000E2080UL,
     0x03C82080UL, 0xFA082080UL, 0x82082080UL
@@ -211,6 +247,19 @@ size_t u8_offset(const char *s, size_t charnum)
 {
     size_t i=0;
 
+    // consume eight bytes at a time while they cannot contain more character
+    // starts than we still need to skip (a word has at most 8 starts)
+    while (charnum >= sizeof(uint64_t)) {
+        uint64_t w;
+        memcpy(&w, s + i, sizeof(uint64_t));
+        charnum -= sizeof(uint64_t) - count_cont_bytes(w);
+        i += sizeof(uint64_t);
+    }
+    if (i) {
+        // finish a character the word loop may have split
+        while ((s[i] & 0xc0) == 0x80)
+            i++;
+    }
     while (charnum > 0) {
         if (s[i++] & 0x80) {
             (void)(isutf(s[++i]) || isutf(s[++i]) || ++i);
@@ -223,15 +272,19 @@ size_t u8_offset(const char *s, size_t charnum)
 /* byte offset => charnum */
 size_t u8_charnum(const char *s, size_t offset)
 {
-    size_t charnum = 0;
-    if (offset) {
-       do {
-          // Simply not count continuation bytes
-          // Since we are not doing validation anyway, we can just
-          // assume this is a valid UTF-8 string
-          charnum += ((*(unsigned char *)s++ & 0xc0) != 0x80);
-       } while (--offset);
+    // Simply not count continuation bytes
+    // Since we are not doing validation anyway, we can just
+    // assume this is a valid UTF-8 string
+    size_t charnum = offset;
+    while (offset >= sizeof(uint64_t)) {
+        uint64_t w;
+        memcpy(&w, s, sizeof(uint64_t));
+        charnum -= count_cont_bytes(w);
+        s += sizeof(uint64_t);
+        offset -= sizeof(uint64_t);
     }
+    while (offset--)
+        charnum -= ((*(unsigned char *)s++ & 0xc0) == 0x80);
     return charnum;
 }
 
@@ -544,56 +597,53 @@ int u8_isvalid(const char *str, size_t len)
     const unsigned char *pnt;   // Current pointer in string
     const unsigned char *pend;  // End of string
     unsigned char       byt;    // Current byte
+    int ret = 1;                // 1 while pure ASCII, 2 after a multibyte char
 
     // Empty strings can be considered valid ASCII
     if (!len) return 1;
     pnt = (unsigned char *)str;
     pend = (unsigned char *)str + len;
-    // First scan for non-ASCII characters as fast as possible
-    do {
-        if (*pnt++ & 0x80) goto chkutf8;
-    } while (pnt < pend);
-    return 1;
-
-    // Check validity of UTF-8 sequences
-chkutf8:
-    if (pnt == pend) return 0;    // Last byte can't be > 127
-    byt = pnt[-1];
-    // Must be between 0xc2 and 0xf4 inclusive to be valid
-    if (((uint32_t)byt - 0xc2) > (0xf4-0xc2)) return 0;
-    if (byt < 0xe0) {               // 2-byte sequence
-        // Must have valid continuation character
-        if ((*pnt++ & 0xc0) != 0x80) return 0;
-    } else if (byt < 0xf0) {        // 3-byte sequence
-        if ((pnt + 1 >= pend)
-              || (*pnt & 0xc0) != 0x80
-              || (pnt[1] & 0xc0) != 0x80)
-            return 0;
-        // Check for surrogate chars
-        if (byt == 0xed && *pnt > 0x9f) return 0;
-	// Check for overlong encoding
-	if (byt == 0xe0 && *pnt < 0xa0) return 0;
-        pnt += 2;
-    } else {                        // 4-byte sequence
-        // Must have 3 valid continuation characters
-        if ((pnt + 2 >= pend)
-              || (*pnt & 0xc0) != 0x80
-              || (pnt[1] & 0xc0) != 0x80
-              || (pnt[2] & 0xc0) != 0x80)
-            return 0;
-        // Make sure in correct range (0x10000 - 0x10ffff)
-        if (byt == 0xf0) {
-            if (*pnt < 0x90) return 0;
-        } else if (byt == 0xf4) {
-            if (*pnt > 0x8f) return 0;
+    for (;;) {
+        // Scan for non-ASCII characters as fast as possible
+        pnt = u8_scan_ascii(pnt, pend);
+        if (pnt == pend) return ret;
+        ret = 2;
+        pnt++;
+
+        // Check validity of the UTF-8 sequence
+        if (pnt == pend) return 0;    // Last byte can't be > 127
+        byt = pnt[-1];
+        // Must be between 0xc2 and 0xf4 inclusive to be valid
+        if (((uint32_t)byt - 0xc2) > (0xf4-0xc2)) return 0;
+        if (byt < 0xe0) {               // 2-byte sequence
+            // Must have valid continuation character
+            if ((*pnt++ & 0xc0) != 0x80) return 0;
+        } else if (byt < 0xf0) {        // 3-byte sequence
+            if ((pnt + 1 >= pend)
+                  || (*pnt & 0xc0) != 0x80
+                  || (pnt[1] & 0xc0) != 0x80)
+                return 0;
+            // Check for surrogate chars
+            if (byt == 0xed && *pnt > 0x9f) return 0;
+            // Check for overlong encoding
+            if (byt == 0xe0 && *pnt < 0xa0) return 0;
+            pnt += 2;
+        } else {                        // 4-byte sequence
+            // Must have 3 valid continuation characters
+            if ((pnt + 2 >= pend)
+                  || (*pnt & 0xc0) != 0x80
+                  || (pnt[1] & 0xc0) != 0x80
+                  || (pnt[2] & 0xc0) != 0x80)
+                return 0;
+            // Make sure in correct range (0x10000 - 0x10ffff)
+            if (byt == 0xf0) {
+                if (*pnt < 0x90) return 0;
+            } else if (byt == 0xf4) {
+                if (*pnt > 0x8f) return 0;
+            }
+            pnt += 3;
         }
-        pnt += 3;
-    }
-    // Find next non-ASCII characters as fast as possible
-    while (pnt < pend) {
-        if (*pnt++ & 0x80) goto chkutf8;
     }
-    return 2;   // Valid UTF-8
 }
 #ifdef __cplusplus
 }
@@ -8,6 +8,10 @@ extern "C" {
 #endif
 
 char *uint2str(char *dest, size_t len, uint64_t num, uint32_t base);
+// decimal formatting without per-digit division; both write a trailing NUL
+// and return the length excluding it (dest: >= 21 resp. 22 bytes)
+JL_DLLEXPORT size_t jl_format_uint64(char *dest, uint64_t num);
+JL_DLLEXPORT size_t jl_format_int64(char *dest, int64_t num);
 int str2int(char *str, size_t len, int64_t *res, uint32_t base);
 int isdigit_base(char c, int base);
 
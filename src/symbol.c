@@ -17,6 +17,84 @@ extern "C" {
 
 static _Atomic(jl_sym_t*) symtab = NULL;
 
+// Lock-free hash index over the interned symbols. The tree rooted at `symtab`
+// remains the canonical structure (the serializers enumerate it through
+// jl_get_root_symbol), but intern hits resolve with a single open-addressing
+// probe here instead of an O(log n) pointer chase. Insertions (under
+// gc_perm_lock) go into the current table; a full table is replaced by a
+// rehashed copy published with a release store, and readers holding the old
+// table simply miss recently added symbols and fall back to the locked path.
+// Old tables are never freed since lock-free readers may still hold them;
+// the geometric growth bounds the waste to less than the final table's size.
+typedef struct {
+    size_t size; // power of two
+    _Atomic(jl_sym_t*) tab[1];
+} jl_symtab_hash_t;
+
+static _Atomic(jl_symtab_hash_t*) symtab_hash = NULL;
+static size_t symtab_count = 0; // symbols interned; writes hold gc_perm_lock
+
+static jl_symtab_hash_t *symtab_hash_alloc(size_t size) JL_NOTSAFEPOINT
+{
+    jl_symtab_hash_t *t = (jl_symtab_hash_t*)malloc_s(
+            offsetof(jl_symtab_hash_t, tab) + size * sizeof(jl_sym_t*));
+    t->size = size;
+    memset((void*)t->tab, 0, size * sizeof(jl_sym_t*));
+    return t;
+}
+
+// requires gc_perm_lock (no concurrent writers) and a free slot in `t`
+static void symtab_hash_insert(jl_symtab_hash_t *t, jl_sym_t *sym) JL_NOTSAFEPOINT
+{
+    size_t mask = t->size - 1;
+    size_t i = sym->hash & mask;
+    while (jl_atomic_load_relaxed(&t->tab[i]) != NULL)
+        i = (i + 1) & mask;
+    jl_atomic_store_release(&t->tab[i], sym);
+}
+
+static jl_sym_t *symtab_hash_lookup(const char *str, size_t len, uintptr_t h) JL_NOTSAFEPOINT
+{
+    jl_symtab_hash_t *t = jl_atomic_load_acquire(&symtab_hash);
+    if (t == NULL)
+        return NULL;
+    size_t mask = t->size - 1;
+    size_t i = h & mask;
+    jl_sym_t *sym;
+    // acquire pairs with the release store in symtab_hash_insert, making the
+    // symbol's name and hash visible
+    while ((sym = jl_atomic_load_acquire(&t->tab[i])) != NULL) {
+        if (sym->hash == h && strncmp(str, jl_symbol_name(sym), len) == 0 &&
+                jl_symbol_name(sym)[len] == 0)
+            return sym;
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+// requires gc_perm_lock; grows (and publishes) the table at 75% occupancy so
+// probe chains and lock-free readers always find a terminating empty slot
+static void symtab_hash_add(jl_sym_t *sym) JL_NOTSAFEPOINT
+{
+    jl_symtab_hash_t *t = jl_atomic_load_relaxed(&symtab_hash);
+    if (t == NULL || symtab_count + 1 > t->size - t->size / 4) {
+        size_t newsz = t == NULL ? 1024 : t->size * 2;
+        jl_symtab_hash_t *newt = symtab_hash_alloc(newsz);
+        if (t != NULL) {
+            size_t i;
+            for (i = 0; i < t->size; i++) {
+                jl_sym_t *s = jl_atomic_load_relaxed(&t->tab[i]);
+                if (s != NULL)
+                    symtab_hash_insert(newt, s);
+            }
+        }
+        jl_atomic_store_release(&symtab_hash, newt);
+        t = newt;
+    }
+    symtab_hash_insert(t, sym);
+    symtab_count++;
+}
+
 #define MAX_SYM_LEN ((size_t)INTPTR_MAX - sizeof(jl_taggedvalue_t) - sizeof(jl_sym_t) - 1)
 
 static uintptr_t hash_symbol(const char *str, size_t len) JL_NOTSAFEPOINT
@@ -85,17 +163,20 @@ jl_sym_t *_jl_symbol(const char *str, size_t len) JL_NOTSAFEPOINT // (or throw)
         jl_exceptionf(jl_argumenterror_type, "Symbol name too long");
 #endif
     assert(!memchr(str, 0, len));
-    _Atomic(jl_sym_t*) *slot;
-    jl_sym_t *node = symtab_lookup(&symtab, str, len, &slot);
+    jl_sym_t *node = symtab_hash_lookup(str, len, hash_symbol(str, len));
     if (node == NULL) {
+        _Atomic(jl_sym_t*) *slot;
         uv_mutex_lock(&gc_perm_lock);
-        // Someone might have updated it, check and look up again
-        if (jl_atomic_load_relaxed(slot) != NULL && (node = symtab_lookup(slot, str, len, &slot))) {
+        // our table snapshot may predate a recent insertion; the tree is
+        // authoritative, so check it again under the lock
+        node = symtab_lookup(&symtab, str, len, &slot);
+        if (node != NULL) {
             uv_mutex_unlock(&gc_perm_lock);
             return node;
         }
         node = mk_symbol(str, len);
         jl_atomic_store_release(slot, node);
+        symtab_hash_add(node);
         uv_mutex_unlock(&gc_perm_lock);
     }
     return node;
@@ -108,7 +189,11 @@ JL_DLLEXPORT jl_sym_t *jl_symbol(const char *str) JL_NOTSAFEPOINT // (or throw)
 
 JL_DLLEXPORT jl_sym_t *jl_symbol_lookup(const char *str) JL_NOTSAFEPOINT
 {
-    return symtab_lookup(&symtab, str, strlen(str), NULL);
+    size_t len = strlen(str);
+    jl_sym_t *node = symtab_hash_lookup(str, len, hash_symbol(str, len));
+    if (node == NULL) // may predate a concurrent insertion; the tree is authoritative
+        node = symtab_lookup(&symtab, str, len, NULL);
+    return node;
 }
 
 JL_DLLEXPORT jl_sym_t *jl_symbol_n(const char *str, size_t len)
@@ -112,17 +112,141 @@ JL_DLLEXPORT char *jl_uv_fs_t_path(uv_fs_t *req) { return (char*)req->path; }
 // --- stat ---
 JL_DLLEXPORT int jl_sizeof_stat(void) { return sizeof(uv_stat_t); }
 
+// Optional cache of stat() misses (set JULIA_STAT_CACHE=1; see options.h).
+// Code loading probes many candidate paths that do not exist, and on network
+// filesystems a negative lookup typically costs far more than rechecking the
+// (attribute-cached) directory. A miss is remembered along with the mtime of
+// the directory that would contain the path; while that directory is
+// unchanged the miss is answered from the table, and once it changes the
+// entry is dropped and the path is stat'ed for real again.
+
+typedef struct {
+    char *parent;
+    uv_timespec_t mtim;
+} neg_stat_t;
+
+static uint64_t path_hash(uintptr_t key)
+{
+    return memhash_fast((const char*)key, strlen((const char*)key));
+}
+
+static int path_eq(void *ka, void *kb)
+{
+    return strcmp((const char*)ka, (const char*)kb) == 0;
+}
+
+#include "support/htable.inc"
+HTIMPL(pathhash, path_hash, path_eq)
+
+static htable_t neg_stat_cache;
+static jl_mutex_t neg_stat_cache_lock;
+
+static int neg_stat_cache_on(void) JL_NOTSAFEPOINT
+{
+    static int enabled = -1;
+    if (__unlikely(enabled == -1)) {
+        char *env = getenv(STAT_CACHE_NAME);
+        enabled = env != NULL && atoi(env) != 0;
+    }
+    return enabled;
+}
+
+// path's containing directory, malloc'd ("." for a bare filename)
+static char *stat_parent_dir(const char *path) JL_NOTSAFEPOINT
+{
+    const char *sep = strrchr(path, '/');
+#ifdef _OS_WINDOWS_
+    const char *alt = strrchr(path, '\\');
+    if (alt != NULL && (sep == NULL || alt > sep))
+        sep = alt;
+#endif
+    if (sep == NULL)
+        return strdup(".");
+    size_t n = sep == path ? 1 : (size_t)(sep - path);
+    char *parent = (char*)malloc_s(n + 1);
+    memcpy(parent, path, n);
+    parent[n] = '\0';
+    return parent;
+}
+
+static int stat_dir_mtime(const char *dir, uv_timespec_t *mtim) JL_NOTSAFEPOINT
+{
+    uv_fs_t req;
+    int ret = uv_fs_stat(unused_uv_loop_arg, &req, dir, NULL);
+    if (ret == 0)
+        *mtim = ((uv_stat_t*)req.ptr)->st_mtim;
+    uv_fs_req_cleanup(&req);
+    return ret;
+}
+
+// 1 if a remembered miss for path is still valid
+static int neg_stat_check(const char *path) JL_NOTSAFEPOINT
+{
+    int hit = 0;
+    JL_LOCK_NOGC(&neg_stat_cache_lock);
+    if (neg_stat_cache.size > 0) {
+        neg_stat_t *e = (neg_stat_t*)pathhash_get(&neg_stat_cache, (void*)path);
+        if (e != HT_NOTFOUND) {
+            uv_timespec_t now;
+            if (stat_dir_mtime(e->parent, &now) == 0 &&
+                now.tv_sec == e->mtim.tv_sec &&
+                now.tv_nsec == e->mtim.tv_nsec) {
+                hit = 1;
+            }
+            else {
+                // directory changed (or vanished): the path may exist now
+                pathhash_remove(&neg_stat_cache, (void*)path);
+                free(e->parent);
+                free(e);
+            }
+        }
+    }
+    JL_UNLOCK_NOGC(&neg_stat_cache_lock);
+    return hit;
+}
+
+static void neg_stat_insert(const char *path) JL_NOTSAFEPOINT
+{
+    char *parent = stat_parent_dir(path);
+    uv_timespec_t mtim;
+    if (stat_dir_mtime(parent, &mtim) != 0) {
+        // cannot validate misses under a directory we cannot stat
+        free(parent);
+        return;
+    }
+    neg_stat_t *e = (neg_stat_t*)malloc_s(sizeof(neg_stat_t));
+    e->parent = parent;
+    e->mtim = mtim;
+    JL_LOCK_NOGC(&neg_stat_cache_lock);
+    if (neg_stat_cache.size == 0)
+        htable_new(&neg_stat_cache, 256);
+    void **bp = pathhash_bp(&neg_stat_cache, (void*)path);
+    if (bp[-1] == (void*)path)
+        bp[-1] = strdup(path); // own the key; lookup stored the probe pointer
+    if (*bp != HT_NOTFOUND) {
+        free(((neg_stat_t*)*bp)->parent);
+        free(*bp);
+    }
+    *bp = e;
+    JL_UNLOCK_NOGC(&neg_stat_cache_lock);
+}
+
 JL_DLLEXPORT int32_t jl_stat(const char *path, char *statbuf) JL_NOTSAFEPOINT
 {
     uv_fs_t req;
     int ret;
 
+    if (neg_stat_cache_on() && neg_stat_check(path))
+        return UV_ENOENT;
+
     // Ideally one would use the statbuf for the storage in req, but
     // it's not clear that this is possible using libuv
     ret = uv_fs_stat(unused_uv_loop_arg, &req, path, NULL);
     if (ret == 0)
         memcpy(statbuf, req.ptr, sizeof(uv_stat_t));
     uv_fs_req_cleanup(&req);
+    if (ret == UV_ENOENT && neg_stat_cache_on())
+        neg_stat_insert(path);
     return ret;
 }
 
@@ -150,6 +274,20 @@ JL_DLLEXPORT int32_t jl_fstat(uv_os_fd_t fd, char *statbuf)
     return ret;
 }
 
+// stat n paths at once: statbufs is n * jl_sizeof_stat() bytes and rets[i]
+// receives 0 or a negative uv error for paths[i]. Batches go through the
+// io_uring when it is enabled (see jl_uv.c) so the kernel resolves the paths
+// concurrently -- which is where cold-start probing on network filesystems
+// spends its time -- and fall back to sequential jl_stat otherwise.
+JL_DLLEXPORT void jl_stat_many(int n, const char **paths, char *statbufs,
+                               int32_t *rets)
+{
+    if (jl_stat_many_uring(n, paths, (uv_stat_t*)statbufs, rets))
+        return;
+    for (int i = 0; i < n; i++)
+        rets[i] = jl_stat(paths[i], statbufs + i * sizeof(uv_stat_t));
+}
+
 JL_DLLEXPORT unsigned int jl_stat_dev(char *statbuf)
 {
     return ((uv_stat_t*)statbuf)->st_dev;
@@ -546,6 +684,30 @@ JL_DLLEXPORT jl_value_t *jl_readuntil(ios_t *s, uint8_t delim, uint8_t str, uint
     return (jl_value_t*)a;
 }
 
+// Zero-copy variant of jl_readuntil for an mmap-backed ios (see
+// ios_file_mmap): the whole file sits in the mapped window, so the span up to
+// the delimiter is returned as a Vector{UInt8} aliasing the window instead of
+// being copied out. The view is only valid while the stream stays open. On
+// any other stream -- or for the final unterminated span -- this behaves
+// exactly like jl_readuntil with str = 0.
+JL_DLLEXPORT jl_value_t *jl_readuntil_view(ios_t *s, uint8_t delim, uint8_t chomp)
+{
+    if (!s->mapped)
+        return jl_readuntil(s, delim, 0, chomp);
+    char *start = s->buf + s->bpos;
+    char *pd = (char*)memchr(start, delim, (size_t)(s->size - s->bpos));
+    if (pd == NULL)
+        return jl_readuntil(s, delim, 0, chomp);
+    size_t n = pd - start + 1;
+    size_t nchomp = 0;
+    if (chomp) {
+        nchomp = chomp == 2 ? ios_nchomp(s, n) : 1;
+    }
+    jl_array_t *a = jl_ptr_to_array_1d(jl_array_uint8_type, start, n - nchomp, 0);
+    s->bpos += n;
+    return (jl_value_t*)a;
+}
+
 JL_DLLEXPORT int jl_ios_buffer_n(ios_t *s, const size_t n)
 {
     size_t space, ret;
@@ -133,7 +133,44 @@ static int always_copy_stacks = 1;
 static int always_copy_stacks = 0;
 #endif
 
+// adaptive copy-stacks: when enabled via JULIA_COPY_STACK_THRESHOLD=<bytes>,
+// tasks with an unspecified stack size start as copy-stacks (avoiding a full
+// stack mapping for each of possibly millions of tiny tasks), and every stack
+// save whose copied size crosses the threshold grants one subsequently
+// created task a dedicated stack. A task that already started cannot be
+// promoted in place--its saved frames are bound to the addresses of the
+// thread's shared stack--so deep-yielding workloads instead drift back to
+// dedicated stacks at the same rate that they hit the threshold.
+// counters for jl_copy_stack_stats
+static _Atomic(uint64_t) n_stack_saves;
+static _Atomic(uint64_t) n_stack_save_bytes;
+static _Atomic(uint64_t) n_stack_promotions;
+
+JL_DLLEXPORT void jl_copy_stack_stats(uint64_t *saves, uint64_t *save_bytes,
+                                      uint64_t *promotions)
+{
+    *saves = jl_atomic_load_relaxed(&n_stack_saves);
+    *save_bytes = jl_atomic_load_relaxed(&n_stack_save_bytes);
+    *promotions = jl_atomic_load_relaxed(&n_stack_promotions);
+}
+
 #ifdef COPY_STACKS
+static size_t copy_stack_threshold; // 0 = disabled
+static _Atomic(int32_t) promote_stack_grants;
+
+// take one dedicated-stack grant, if any are outstanding
+static int claim_promote_stack_grant(void)
+{
+    int32_t g = jl_atomic_load_relaxed(&promote_stack_grants);
+    while (g > 0) {
+        if (jl_atomic_cmpswap(&promote_stack_grants, &g, g - 1)) {
+            jl_atomic_fetch_add_relaxed(&n_stack_promotions, 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
 static void memcpy_a16(uint64_t *to, uint64_t *from, size_t nb)
 {
     memcpy((char*)jl_assume_aligned(to, 16), (char*)jl_assume_aligned(from, 16), nb);
@@ -160,6 +197,16 @@ static void NOINLINE save_stack(jl_ptls_t ptls, jl_task_t *lastt, jl_task_t **pt
     *pt = NULL; // clear the gc-root for the target task before copying the stack for saving
     lastt->copy_stack = nb;
     lastt->sticky = 1;
+    jl_atomic_fetch_add_relaxed(&n_stack_saves, 1);
+    jl_atomic_fetch_add_relaxed(&n_stack_save_bytes, nb);
+    if (copy_stack_threshold && nb >= copy_stack_threshold) {
+        // this save is expensive; grant the next default-sized task a
+        // dedicated stack instead (bounded so that a long-lived deep task
+        // cannot bank unlimited grants)
+        int32_t g = jl_atomic_load_relaxed(&promote_stack_grants);
+        if (g < 1024)
+            jl_atomic_fetch_add_relaxed(&promote_stack_grants, 1);
+    }
     memcpy_a16((uint64_t*)buf, (uint64_t*)frame_addr, nb);
     // this task's stack could have been modified after
     // it was marked by an incremental collection
@@ -236,6 +283,14 @@ void JL_NORETURN jl_finish_task(jl_task_t *t)
         jl_atomic_store_release(&t->_state, JL_TASK_STATE_DONE);
     if (t->copy_stack) // early free of stkbuf
         t->stkbuf = NULL;
+    if (t->arena) {
+        // release a bump region the task never detached; by the arena
+        // contract nothing allocated in it can outlive the task
+        jl_gc_arena_t *a = t->arena;
+        t->arena = NULL;
+        ct->ptls->task_arena = NULL;
+        jl_gc_arena_end(a);
+    }
     // ensure that state is cleared
     ct->ptls->in_finalizer = 0;
     ct->ptls->in_pure_callback = 0;
@@ -340,8 +395,16 @@ JL_DLLEXPORT void jl_active_task_stack(jl_task_t *task,
 // `skip` is number of additional frames to skip.
 NOINLINE static void record_backtrace(jl_ptls_t ptls, int skip) JL_NOTSAFEPOINT
 {
+    static int fp_unwind = -1;
+    if (fp_unwind == -1) {
+        const char *env = getenv(THROW_FP_UNWIND_NAME);
+        fp_unwind = (env && strcmp(env, "0") != 0);
+    }
     // storing bt_size in ptls ensures roots in bt_data will be found
-    ptls->bt_size = rec_backtrace(ptls->bt_data, JL_MAX_BT_SIZE, skip + 1);
+    if (fp_unwind)
+        ptls->bt_size = rec_backtrace_fp(ptls->bt_data, JL_MAX_BT_SIZE, skip + 1);
+    else
+        ptls->bt_size = rec_backtrace(ptls->bt_data, JL_MAX_BT_SIZE, skip + 1);
 }
 
 JL_DLLEXPORT void jl_set_next_task(jl_task_t *task) JL_NOTSAFEPOINT
@@ -427,7 +490,9 @@ static void ctx_switch(jl_task_t *lastt)
 
     // set up global state for new task and clear global state for old task
     t->ptls = ptls;
+    jl_perf_task_switch(ptls, lastt); // charge hardware counters to the outgoing task
     jl_atomic_store_relaxed(&ptls->current_task, t);
+    ptls->task_arena = t->arena; // activate the incoming task's bump region, if any
     JL_GC_PROMISE_ROOTED(t);
     jl_signal_fence();
     jl_set_pgcstack(&t->gcstack);
@@ -646,7 +711,34 @@ JL_DLLEXPORT void jl_throw(jl_value_t *e JL_MAYBE_UNROOTED)
     if (ct == NULL) // During startup
         jl_no_exc_handler(e);
     JL_GC_PROMISE_ROOTED(ct);
-    record_backtrace(ct->ptls, 1);
+    static int singleton_nobt = -1;
+    if (singleton_nobt == -1) {
+        const char *env = getenv(THROW_SINGLETON_NOBT_NAME);
+        singleton_nobt = env != NULL && atoi(env) != 0;
+    }
+    if (singleton_nobt && jl_is_datatype_singleton((jl_datatype_t*)jl_typeof(e)))
+        ct->ptls->bt_size = 0;
+    else
+        record_backtrace(ct->ptls, 1);
+    throw_internal(ct, e);
+}
+
+// Throw a pre-allocated exception without capturing a backtrace. For
+// singleton exceptions used as control flow (iteration-termination
+// sentinels in ported code), unwinding the stack is nearly the entire cost
+// of the throw; the handler sees an empty trace and nothing is allocated
+// on this path.
+JL_DLLEXPORT void jl_throw_nobt(jl_value_t *e JL_MAYBE_UNROOTED)
+{
+    assert(e != NULL);
+    jl_jmp_buf *safe_restore = jl_get_safe_restore();
+    if (safe_restore)
+        jl_longjmp(*safe_restore, 1);
+    jl_task_t *ct = jl_get_current_task();
+    if (ct == NULL) // During startup
+        jl_no_exc_handler(e);
+    JL_GC_PROMISE_ROOTED(ct);
+    ct->ptls->bt_size = 0;
     throw_internal(ct, e);
 }
 
@@ -760,6 +852,14 @@ JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t *start, jl_value_t *completion
             t->copy_stack = 1;
             t->bufsz = 0;
         }
+#ifdef COPY_STACKS
+        else if (copy_stack_threshold && !claim_promote_stack_grant()) {
+            // adaptive mode: start as a copy-stack unless deep-yielding
+            // tasks have recently granted dedicated stacks
+            t->copy_stack = 1;
+            t->bufsz = 0;
+        }
+#endif
         else {
             t->bufsz = JL_STACK_SIZE;
         }
@@ -784,6 +884,9 @@ JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t *start, jl_value_t *completion
     jl_atomic_store_relaxed(&t->_isexception, 0);
     // Inherit logger state from parent task
     t->logstate = ct->logstate;
+    // Inherit the fast TLS slots from the parent so that context (tracing
+    // spans, request ids) propagates into spawned tasks without any dict walk
+    memcpy(t->tls_slots, ct->tls_slots, sizeof(t->tls_slots));
     // Fork task-local random state from parent
     rng_split(ct, t);
     // there is no active exception handler available on this stack yet
@@ -791,6 +894,9 @@ JL_DLLEXPORT jl_task_t *jl_new_task(jl_function_t *start, jl_value_t *completion
     t->sticky = 1;
     t->gcstack = NULL;
     t->excstack = NULL;
+    t->arena = NULL;
+    memset(t->perf_counts, 0, sizeof(t->perf_counts));
+    t->enqueue_tstamp = 0;
     t->started = 0;
     t->prio = -1;
     jl_atomic_store_relaxed(&t->tid, t->copy_stack ? jl_atomic_load_relaxed(&ct->tid) : -1); // copy_stacks are always pinned since they can't be moved
@@ -823,6 +929,28 @@ JL_DLLEXPORT jl_task_t *jl_get_current_task(void)
     return pgcstack == NULL ? NULL : container_of(pgcstack, jl_task_t, gcstack);
 }
 
+// Fixed fast task-local storage. Unlike `task.storage`, which is an IdDict
+// and costs a hash lookup per access, these are plain slots in jl_task_t,
+// so instrumentation that needs task context on every event pays one load.
+// A slot that was never set reads as NULL.
+JL_DLLEXPORT jl_value_t *jl_get_task_tls(size_t i) JL_NOTSAFEPOINT
+{
+    jl_task_t *ct = jl_current_task;
+    if (i >= JL_TASK_TLS_NSLOTS)
+        return NULL;
+    return ct->tls_slots[i];
+}
+
+JL_DLLEXPORT void jl_set_task_tls(size_t i, jl_value_t *v)
+{
+    jl_task_t *ct = jl_current_task;
+    if (i >= JL_TASK_TLS_NSLOTS)
+        jl_bounds_error_int((jl_value_t*)ct, i + 1);
+    ct->tls_slots[i] = v;
+    if (v)
+        jl_gc_wb(ct, v);
+}
+
 #ifdef JL_HAVE_ASYNCIFY
 JL_DLLEXPORT jl_ucontext_t *task_ctx_ptr(jl_task_t *t)
 {
@@ -883,6 +1011,15 @@ void jl_init_tasks(void) JL_GC_DISABLED
         exit(1);
     }
 #endif
+    char *cst = getenv("JULIA_COPY_STACK_THRESHOLD");
+    if (cst) {
+#ifdef COPY_STACKS
+        copy_stack_threshold = (size_t)strtol(cst, NULL, 10);
+#else
+        jl_safe_printf("Julia built without COPY_STACKS support");
+        exit(1);
+#endif
+    }
 }
 
 STATIC_OR_JS void NOINLINE JL_NORETURN start_task(void)
@@ -1350,6 +1487,7 @@ jl_task_t *jl_init_root_task(jl_ptls_t ptls, void *stack_lo, void *stack_hi)
     ct->donenotify = jl_nothing;
     jl_atomic_store_relaxed(&ct->_isexception, 0);
     ct->logstate = jl_nothing;
+    memset(ct->tls_slots, 0, sizeof(ct->tls_slots));
     ct->eh = NULL;
     ct->gcstack = NULL;
     ct->excstack = NULL;
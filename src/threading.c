@@ -314,6 +314,7 @@ jl_ptls_t jl_init_threadtls(int16_t tid)
     }
 #endif
     ptls->tid = tid;
+    ptls->numa_node = jl_thread_numa_nodes ? jl_thread_numa_nodes[tid] : 0;
     jl_atomic_store_relaxed(&ptls->gc_state, 0); // GC unsafe
     // Conditionally initialize the safepoint address. See comment in
     // `safepoint.c`
@@ -330,6 +331,7 @@ jl_ptls_t jl_init_threadtls(int16_t tid)
     ptls->bt_data = bt_data;
     small_arraylist_new(&ptls->locks, 0);
     jl_init_thread_heap(ptls);
+    jl_perf_init_thread(ptls);
 
     jl_all_tls_states[tid] = ptls;
 
@@ -442,9 +444,191 @@ static void jl_check_tls(void)
 JL_DLLEXPORT const int jl_tls_elf_support = 0;
 #endif
 
+// CPU topology, filled in by jl_init_topology
+static int topology_ncpus = 1;
+static int topology_nnodes = 1;
+static int16_t *cpu_node_map;   // cpu index -> NUMA node
+int16_t *jl_thread_numa_nodes;  // tid -> NUMA node (all zero without pinning)
+
+#ifdef _OS_LINUX_
+// parse a sysfs cpulist file ("0-3,8-11") and tag the listed cpus with `node`
+static int jl_parse_cpulist(const char *path, int16_t *map, int ncpus, int16_t node)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+        return 0;
+    char buf[1024];
+    size_t got = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[got] = '\0';
+    char *p = buf;
+    while (*p) {
+        char *end;
+        long lo = strtol(p, &end, 10);
+        if (end == p)
+            break;
+        long hi = lo;
+        p = end;
+        if (*p == '-') {
+            hi = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for (long c = lo; c <= hi && c < ncpus; c++)
+            if (c >= 0)
+                map[c] = node;
+        if (*p == ',')
+            p++;
+    }
+    return 1;
+}
+#endif
+
+// enumerate NUMA nodes and the cpus belonging to each; on platforms without
+// a topology source every cpu lands on node 0
+static void jl_init_topology(void)
+{
+    topology_ncpus = jl_cpu_threads();
+    if (topology_ncpus < 1)
+        topology_ncpus = 1;
+    cpu_node_map = (int16_t*)calloc(topology_ncpus, sizeof(int16_t));
+#ifdef _OS_LINUX_
+    char path[128];
+    int node = 0;
+    while (node < INT16_MAX) {
+        snprintf(path, sizeof(path),
+                 "/sys/devices/system/node/node%d/cpulist", node);
+        if (!jl_parse_cpulist(path, cpu_node_map, topology_ncpus, (int16_t)node))
+            break;
+        node++;
+    }
+    if (node > 1)
+        topology_nnodes = node;
+#endif
+}
+
+JL_DLLEXPORT int jl_topology_nnodes(void)
+{
+    return topology_nnodes;
+}
+
+JL_DLLEXPORT int16_t jl_thread_node(int16_t tid)
+{
+    if (jl_thread_numa_nodes == NULL || tid < 0 || tid >= jl_n_threads)
+        return 0;
+    return jl_thread_numa_nodes[tid];
+}
+
+// Parking table for contended jl_mutex_t locks
+//
+// jl_mutex_t is two words whose layout is frozen by the objects it is
+// embedded in (e.g. MethodTable), so waiters cannot be tracked in the lock
+// itself. Instead a contended lock hashes to one of a fixed set of buckets
+// and parks on that bucket's condition variable after its spin budget runs
+// out (see jl_mutex_wait in julia_locks.h). Collisions only cost spurious
+// wakeups: jl_mutex_wakeup broadcasts to the whole bucket and the woken
+// threads re-contend. Each bucket also keeps per-lock park counts (keyed by
+// lock address) so contention on the named runtime locks is observable.
+
+#define LOCK_PARK_BUCKETS 64 // power of two
+#define LOCK_PARK_ENTRIES 8  // contention counts tracked per bucket
+
+typedef struct {
+    uv_mutex_t mutex;
+    uv_cond_t cond;
+    // park counts for the locks that have parked in this bucket; locks
+    // beyond LOCK_PARK_ENTRIES are accounted to `other` (under `mutex`)
+    jl_mutex_t *keys[LOCK_PARK_ENTRIES];
+    uint64_t counts[LOCK_PARK_ENTRIES];
+    uint64_t other;
+} jl_lock_bucket_t;
+
+static jl_lock_bucket_t lock_park_buckets[LOCK_PARK_BUCKETS];
+JL_DLLEXPORT _Atomic(int32_t) jl_lock_nwaiters = 0;
+
+static jl_lock_bucket_t *lock_park_bucket(jl_mutex_t *lock) JL_NOTSAFEPOINT
+{
+    uintptr_t h = (uintptr_t)lock / sizeof(jl_mutex_t);
+    h ^= h >> 16;
+    return &lock_park_buckets[h & (LOCK_PARK_BUCKETS - 1)];
+}
+
+static void lock_park_count(jl_lock_bucket_t *b, jl_mutex_t *lock) JL_NOTSAFEPOINT
+{
+    for (int i = 0; i < LOCK_PARK_ENTRIES; i++) {
+        if (b->keys[i] == lock || b->keys[i] == NULL) {
+            b->keys[i] = lock;
+            b->counts[i]++;
+            return;
+        }
+    }
+    b->other++;
+}
+
+JL_DLLEXPORT void jl_mutex_park(jl_mutex_t *lock, int safepoint)
+{
+    jl_lock_bucket_t *b = lock_park_bucket(lock);
+    uv_mutex_lock(&b->mutex);
+    lock_park_count(b, lock);
+    jl_atomic_fetch_add_relaxed(&jl_lock_nwaiters, 1);
+    // pairs with the fence in jl_mutex_unlock_nogc: either we see the lock
+    // released here, or the releasing thread sees our waiter count
+    jl_fence();
+    if (jl_atomic_load_relaxed(&lock->owner) != NULL) {
+        int8_t gc_state = 0;
+        jl_ptls_t ptls = NULL;
+        if (safepoint) {
+            ptls = jl_current_task->ptls;
+            gc_state = jl_gc_safe_enter(ptls);
+        }
+        uv_cond_wait(&b->cond, &b->mutex);
+        jl_atomic_fetch_add_relaxed(&jl_lock_nwaiters, -1);
+        uv_mutex_unlock(&b->mutex);
+        // not under the bucket mutex: leaving gc-safe can wait for the GC
+        if (safepoint)
+            jl_gc_safe_leave(ptls, gc_state);
+        return;
+    }
+    // the lock was released while we registered; retry the acquire
+    jl_atomic_fetch_add_relaxed(&jl_lock_nwaiters, -1);
+    uv_mutex_unlock(&b->mutex);
+}
+
+JL_DLLEXPORT void jl_mutex_wakeup(jl_mutex_t *lock) JL_NOTSAFEPOINT
+{
+    jl_lock_bucket_t *b = lock_park_bucket(lock);
+    uv_mutex_lock(&b->mutex);
+    uv_cond_broadcast(&b->cond);
+    uv_mutex_unlock(&b->mutex);
+}
+
+JL_DLLEXPORT uint64_t jl_mutex_ncontended(jl_mutex_t *lock) JL_NOTSAFEPOINT
+{
+    jl_lock_bucket_t *b = lock_park_bucket(lock);
+    uint64_t n = 0;
+    uv_mutex_lock(&b->mutex);
+    for (int i = 0; i < LOCK_PARK_ENTRIES; i++) {
+        if (b->keys[i] == lock) {
+            n = b->counts[i];
+            break;
+        }
+    }
+    uv_mutex_unlock(&b->mutex);
+    return n;
+}
+
+static void jl_init_lock_parking(void)
+{
+    for (int i = 0; i < LOCK_PARK_BUCKETS; i++) {
+        uv_mutex_init(&lock_park_buckets[i].mutex);
+        uv_cond_init(&lock_park_buckets[i].cond);
+    }
+}
+
 // interface to Julia; sets up to make the runtime thread-safe
 void jl_init_threading(void)
 {
+    jl_init_lock_parking();
+    jl_perf_init();
     char *cp;
 
 #ifdef JL_ELF_TLS_VARIANT
@@ -470,10 +654,19 @@ void jl_init_threading(void)
 #ifndef __clang_gcanalyzer__
     jl_all_tls_states = (jl_ptls_t*)calloc(jl_n_threads, sizeof(void*));
 #endif
+    jl_init_topology();
+    jl_thread_numa_nodes = (int16_t*)calloc(jl_n_threads, sizeof(int16_t));
 }
 
 static uv_barrier_t thread_init_done;
 
+// affinity policies for placing thread i on a cpu
+enum jl_affinity_policy {
+    AFFINITY_NONE,    // no pinning; let the kernel move threads about
+    AFFINITY_COMPACT, // thread i on cpu i, filling one node before the next
+    AFFINITY_SCATTER, // threads round-robined across NUMA nodes
+};
+
 void jl_start_threads(void)
 {
     int cpumasksize = uv_cpumask_size();
@@ -482,6 +675,8 @@ void jl_start_threads(void)
     uv_thread_t uvtid;
     if (cpumasksize < jl_n_threads) // also handles error case
         cpumasksize = jl_n_threads;
+    if (cpumasksize < topology_ncpus)
+        cpumasksize = topology_ncpus;
     char *mask = (char*)alloca(cpumasksize);
 
     // do we have exclusive use of the machine? default is no
@@ -490,24 +685,70 @@ void jl_start_threads(void)
     if (cp && strcmp(cp, "0") != 0)
         exclusive = 1;
 
-    // exclusive use: affinitize threads, master thread on proc 0, rest
-    // according to a 'compact' policy
-    // non-exclusive: no affinity settings; let the kernel move threads about
-    if (exclusive) {
-        if (jl_n_threads > jl_cpu_threads()) {
-            jl_printf(JL_STDERR, "ERROR: Too many threads requested for %s option.\n", MACHINE_EXCLUSIVE_NAME);
+    // select the placement policy: JULIA_EXCLUSIVE implies 'compact' (the
+    // historical behavior); JULIA_THREAD_AFFINITY overrides it either way
+    int policy = exclusive ? AFFINITY_COMPACT : AFFINITY_NONE;
+    cp = getenv(MACHINE_AFFINITY_NAME);
+    if (cp) {
+        if (!strcmp(cp, "compact"))
+            policy = AFFINITY_COMPACT;
+        else if (!strcmp(cp, "scatter"))
+            policy = AFFINITY_SCATTER;
+        else if (!strcmp(cp, "none"))
+            policy = AFFINITY_NONE;
+        else {
+            jl_printf(JL_STDERR, "ERROR: invalid %s value.\n", MACHINE_AFFINITY_NAME);
             exit(1);
         }
-        memset(mask, 0, cpumasksize);
-        mask[0] = 1;
-        uvtid = uv_thread_self();
-        uv_thread_setaffinity(&uvtid, mask, NULL, cpumasksize);
-        mask[0] = 0;
+    }
+    if (exclusive && jl_n_threads > jl_cpu_threads()) {
+        jl_printf(JL_STDERR, "ERROR: Too many threads requested for %s option.\n", MACHINE_EXCLUSIVE_NAME);
+        exit(1);
     }
 
     // The analyzer doesn't know jl_n_threads doesn't change, help it
     size_t nthreads = jl_n_threads;
 
+    // compute the cpu for each thread up front, so that the NUMA node table
+    // is complete before any worker initializes its TLS
+    int *thread_cpu = NULL;
+    if (policy != AFFINITY_NONE) {
+        thread_cpu = (int*)malloc_s(nthreads * sizeof(int));
+        if (policy == AFFINITY_COMPACT) {
+            for (i = 0; i < nthreads; i++)
+                thread_cpu[i] = i % topology_ncpus;
+        }
+        else {
+            // interleave the cpus round-robin across nodes: each node's
+            // first cpu, then each node's second cpu, and so on
+            int *order = (int*)malloc_s(topology_ncpus * sizeof(int));
+            int n = 0;
+            for (int round = 0; n < topology_ncpus; round++) {
+                for (int node = 0; node < topology_nnodes; node++) {
+                    int seen = 0;
+                    for (int c = 0; c < topology_ncpus; c++) {
+                        if (cpu_node_map[c] == node && seen++ == round) {
+                            order[n++] = c;
+                            break;
+                        }
+                    }
+                }
+            }
+            for (i = 0; i < nthreads; i++)
+                thread_cpu[i] = order[i % topology_ncpus];
+            free(order);
+        }
+        for (i = 0; i < nthreads; i++)
+            jl_thread_numa_nodes[i] = cpu_node_map[thread_cpu[i]];
+        // the master thread's TLS was initialized before the table existed
+        jl_all_tls_states[0]->numa_node = jl_thread_numa_nodes[0];
+        memset(mask, 0, cpumasksize);
+        mask[thread_cpu[0]] = 1;
+        uvtid = uv_thread_self();
+        uv_thread_setaffinity(&uvtid, mask, NULL, cpumasksize);
+        mask[thread_cpu[0]] = 0;
+    }
+
     // create threads
     uv_barrier_init(&thread_init_done, nthreads);
 
@@ -516,13 +757,14 @@ void jl_start_threads(void)
         t->tid = i;
         t->barrier = &thread_init_done;
         uv_thread_create(&uvtid, jl_threadfun, t);
-        if (exclusive) {
-            mask[i] = 1;
+        if (thread_cpu) {
+            mask[thread_cpu[i]] = 1;
             uv_thread_setaffinity(&uvtid, mask, NULL, cpumasksize);
-            mask[i] = 0;
+            mask[thread_cpu[i]] = 0;
         }
         uv_thread_detach(&uvtid);
     }
+    free(thread_cpu);
 
     uv_barrier_wait(&thread_init_done);
 }
@@ -13,6 +13,11 @@ extern "C" {
 #define PROFILE_JL_THREADING            0
 
 extern jl_ptls_t *jl_all_tls_states JL_GLOBALLY_ROOTED; /* thread local storage */
+extern int16_t *jl_thread_numa_nodes; /* tid -> NUMA node under thread pinning */
+
+// CPU/NUMA topology
+JL_DLLEXPORT int jl_topology_nnodes(void);
+JL_DLLEXPORT int16_t jl_thread_node(int16_t tid);
 
 typedef struct _jl_threadarg_t {
     int16_t tid;
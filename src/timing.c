@@ -10,6 +10,127 @@
 extern "C" {
 #endif
 
+const char *jl_timing_names[(int)JL_TIMING_LAST] =
+    {
+#define X(name) #name
+        JL_TIMING_OWNERS
+#undef X
+    };
+
+// Event tracer
+//
+// Each thread records completed JL_TIMING spans into a private ring buffer,
+// registered on a global list the first time the thread traces an event.
+// The owning thread is the only writer; it publishes each event with a
+// release store of the event count, so a dump (normally taken after
+// `jl_timing_trace_stop`) observes fully-written events. When the ring
+// wraps, the oldest events are overwritten.
+
+// events retained per thread; must be a power of two
+#define JL_TRACE_BUF_EVENTS (1 << 14)
+
+typedef struct {
+    uint64_t t0; // ns, from jl_hrtime
+    uint64_t t1;
+    uint16_t owner;
+} jl_trace_event_t;
+
+typedef struct _jl_trace_buf_t {
+    struct _jl_trace_buf_t *next;
+    int16_t tid;
+    _Atomic(uint64_t) n; // events recorded; event i lives in events[i % size]
+    jl_trace_event_t events[JL_TRACE_BUF_EVENTS];
+} jl_trace_buf_t;
+
+JL_DLLEXPORT _Atomic(uint8_t) jl_timing_trace_enabled = 0;
+static _Atomic(jl_trace_buf_t*) trace_bufs = NULL;
+// dump target at exit when tracing was enabled by TIMING_TRACE_NAME
+static const char *trace_dump_path = NULL;
+
+JL_DLLEXPORT void jl_timing_trace_start(void)
+{
+    jl_atomic_store_release(&jl_timing_trace_enabled, 1);
+}
+
+JL_DLLEXPORT void jl_timing_trace_stop(void)
+{
+    jl_atomic_store_release(&jl_timing_trace_enabled, 0);
+}
+
+void jl_timing_trace_event(int owner, uint64_t t0, uint64_t t1)
+{
+    jl_ptls_t ptls = jl_current_task->ptls;
+    jl_trace_buf_t *buf = ptls->trace_buf;
+    if (__unlikely(buf == NULL)) {
+        buf = (jl_trace_buf_t*)malloc_s(sizeof(jl_trace_buf_t));
+        buf->tid = ptls->tid;
+        jl_atomic_store_relaxed(&buf->n, 0);
+        jl_trace_buf_t *head = jl_atomic_load_relaxed(&trace_bufs);
+        do {
+            buf->next = head;
+        } while (!jl_atomic_cmpswap(&trace_bufs, &head, buf));
+        ptls->trace_buf = buf;
+    }
+    uint64_t n = jl_atomic_load_relaxed(&buf->n);
+    jl_trace_event_t *ev = &buf->events[n % JL_TRACE_BUF_EVENTS];
+    ev->t0 = t0;
+    ev->t1 = t1;
+    ev->owner = (uint16_t)owner;
+    jl_atomic_store_release(&buf->n, n + 1);
+}
+
+// Write the recorded events as a Chrome trace ("Trace Event" JSON array of
+// complete events), loadable in chrome://tracing or ui.perfetto.dev.
+// Returns 0 on success. Dumping while tracing is still enabled is safe but
+// events overwritten during the dump may be dropped.
+JL_DLLEXPORT int jl_timing_trace_dump(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (f == NULL)
+        return -1;
+    fputs("[\n", f);
+    int first = 1;
+    for (jl_trace_buf_t *buf = jl_atomic_load_acquire(&trace_bufs);
+         buf != NULL; buf = buf->next) {
+        uint64_t n = jl_atomic_load_acquire(&buf->n);
+        uint64_t i = n > JL_TRACE_BUF_EVENTS ? n - JL_TRACE_BUF_EVENTS : 0;
+        for (; i < n; i++) {
+            jl_trace_event_t *ev = &buf->events[i % JL_TRACE_BUF_EVENTS];
+            if (ev->owner >= JL_TIMING_LAST || ev->t1 < ev->t0)
+                continue; // being overwritten concurrently
+            fprintf(f, "%s{\"name\":\"%s\",\"cat\":\"julia\",\"ph\":\"X\","
+                    "\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    first ? "" : ",\n", jl_timing_names[ev->owner],
+                    (int)buf->tid, ev->t0 / 1e3, (ev->t1 - ev->t0) / 1e3);
+            first = 0;
+        }
+    }
+    fputs("\n]\n", f);
+    int err = ferror(f);
+    fclose(f);
+    return err ? -1 : 0;
+}
+
+static void jl_init_timing_trace(void)
+{
+    const char *path = getenv(TIMING_TRACE_NAME);
+    if (path && path[0] != '\0') {
+        trace_dump_path = path;
+        jl_timing_trace_start();
+    }
+}
+
+static void jl_destroy_timing_trace(void)
+{
+    if (trace_dump_path != NULL) {
+        jl_timing_trace_stop();
+        if (jl_timing_trace_dump(trace_dump_path) != 0)
+            jl_safe_printf("WARNING: failed to write trace to %s\n",
+                           trace_dump_path);
+        trace_dump_path = NULL;
+    }
+}
+
 #ifdef ENABLE_TIMINGS
 #include "timing.h"
 
@@ -19,12 +140,6 @@ extern "C" {
 
 static uint64_t t0;
 JL_DLLEXPORT uint64_t jl_timing_data[(int)JL_TIMING_LAST] = {0};
-const char *jl_timing_names[(int)JL_TIMING_LAST] =
-    {
-#define X(name) #name
-        JL_TIMING_OWNERS
-#undef X
-    };
 
 void jl_print_timings(void)
 {
@@ -44,6 +159,7 @@ void jl_print_timings(void)
 void jl_init_timing(void)
 {
     t0 = cycleclock();
+    jl_init_timing_trace();
 }
 
 void jl_destroy_timing(void)
@@ -54,6 +170,7 @@ void jl_destroy_timing(void)
         _jl_timing_block_destroy(stack);
         stack = stack->prev;
     }
+    jl_destroy_timing_trace();
 }
 
 jl_timing_block_t *jl_pop_timing_block(jl_timing_block_t *cur_block)
@@ -74,8 +191,15 @@ void jl_timing_block_stop(jl_timing_block_t *cur_block)
 
 #else
 
-void jl_init_timing(void) { }
-void jl_destroy_timing(void) { }
+void jl_init_timing(void)
+{
+    jl_init_timing_trace();
+}
+
+void jl_destroy_timing(void)
+{
+    jl_destroy_timing_trace();
+}
 
 #endif
 
@@ -8,39 +8,21 @@ extern "C" {
 #endif
 void jl_init_timing(void);
 void jl_destroy_timing(void);
-#ifdef __cplusplus
-}
-#endif
 
-#ifndef ENABLE_TIMINGS
-#define JL_TIMING(owner)
-#else
-
-#include "julia_assert.h"
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-void jl_print_timings(void);
-jl_timing_block_t *jl_pop_timing_block(jl_timing_block_t *cur_block);
-void jl_timing_block_start(jl_timing_block_t *cur_block);
-void jl_timing_block_stop(jl_timing_block_t *cur_block);
+// Event tracer: runtime-toggleable recording of (begin, end, tid, owner)
+// events for every JL_TIMING region into per-thread ring buffers, available
+// in all builds (unlike the aggregate timings, which need ENABLE_TIMINGS).
+// `jl_timing_trace_dump` writes the recorded events in the Chrome trace
+// ("Trace Event") JSON format understood by chrome://tracing and Perfetto.
+JL_DLLEXPORT void jl_timing_trace_start(void);
+JL_DLLEXPORT void jl_timing_trace_stop(void);
+JL_DLLEXPORT int jl_timing_trace_dump(const char *path);
+void jl_timing_trace_event(int owner, uint64_t t0, uint64_t t1);
+extern _Atomic(uint8_t) jl_timing_trace_enabled;
 #ifdef __cplusplus
 }
 #endif
 
-#ifdef __cplusplus
-#define HAVE_TIMING_SUPPORT
-#elif defined(_COMPILER_CLANG_)
-#define HAVE_TIMING_SUPPORT
-#elif defined(_COMPILER_GCC_)
-#define HAVE_TIMING_SUPPORT
-#endif
-
-#ifndef HAVE_TIMING_SUPPORT
-#define JL_TIMING(owner)
-#else
-
 #define JL_TIMING_OWNERS          \
         X(ROOT),                  \
         X(GC),                    \
@@ -74,13 +56,61 @@ enum jl_timing_owners {
     JL_TIMING_LAST
 };
 
-extern uint64_t jl_timing_data[(int)JL_TIMING_LAST];
 extern const char *jl_timing_names[(int)JL_TIMING_LAST];
 
+#ifdef __cplusplus
+#define HAVE_TIMING_SUPPORT
+#elif defined(_COMPILER_CLANG_)
+#define HAVE_TIMING_SUPPORT
+#elif defined(_COMPILER_GCC_)
+#define HAVE_TIMING_SUPPORT
+#endif
+
+#ifndef HAVE_TIMING_SUPPORT
+#define JL_TIMING(owner)
+#elif !defined(ENABLE_TIMINGS)
+
+// Trace-only blocks: when the aggregate timings are compiled out, JL_TIMING
+// still records an event span, paying only a relaxed flag load when the
+// tracer is off.
+struct _jl_timing_block_t { // typedef in julia.h
+    uint64_t trace_t0;
+    int owner;
+};
+
+STATIC_INLINE void _jl_timing_block_ctor(jl_timing_block_t *block, int owner) {
+    block->owner = owner;
+    block->trace_t0 = jl_atomic_load_relaxed(&jl_timing_trace_enabled) ?
+        jl_hrtime() : 0;
+}
+
+STATIC_INLINE void _jl_timing_block_destroy(jl_timing_block_t *block) {
+    if (__unlikely(block->trace_t0 != 0))
+        jl_timing_trace_event(block->owner, block->trace_t0, jl_hrtime());
+}
+
+#else
+
+#include "julia_assert.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void jl_print_timings(void);
+jl_timing_block_t *jl_pop_timing_block(jl_timing_block_t *cur_block);
+void jl_timing_block_start(jl_timing_block_t *cur_block);
+void jl_timing_block_stop(jl_timing_block_t *cur_block);
+#ifdef __cplusplus
+}
+#endif
+
+extern uint64_t jl_timing_data[(int)JL_TIMING_LAST];
+
 struct _jl_timing_block_t { // typedef in julia.h
     jl_timing_block_t *prev;
     uint64_t total;
     uint64_t t0;
+    uint64_t trace_t0; // wall-clock begin for the event tracer (0 if off)
     int owner;
 #ifdef JL_DEBUG_BUILD
     uint8_t running;
@@ -107,6 +137,8 @@ STATIC_INLINE uint64_t _jl_timing_block_init(jl_timing_block_t *block, int owner
     uint64_t t = cycleclock();
     block->owner = owner;
     block->total = 0;
+    block->trace_t0 = jl_atomic_load_relaxed(&jl_timing_trace_enabled) ?
+        jl_hrtime() : 0;
 #ifdef JL_DEBUG_BUILD
     block->running = 0;
 #endif
@@ -129,6 +161,8 @@ STATIC_INLINE void _jl_timing_block_destroy(jl_timing_block_t *block) {
     jl_task_t *ct = jl_current_task;
     _jl_timing_block_stop(block, t);
     jl_timing_data[block->owner] += block->total;
+    if (__unlikely(block->trace_t0 != 0))
+        jl_timing_trace_event(block->owner, block->trace_t0, jl_hrtime());
     jl_timing_block_t **pcur = &ct->ptls->timing_stack;
     assert(*pcur == block);
     *pcur = block->prev;
@@ -136,6 +170,9 @@ STATIC_INLINE void _jl_timing_block_destroy(jl_timing_block_t *block) {
         _jl_timing_block_start(block->prev, t);
 }
 
+#endif
+
+#if defined(HAVE_TIMING_SUPPORT) && !defined(JL_TIMING)
 #ifdef __cplusplus
 struct jl_timing_block_cpp_t {
     jl_timing_block_t block;
@@ -157,8 +194,6 @@ struct jl_timing_block_cpp_t {
     jl_timing_block_t __timing_block; \
     _jl_timing_block_ctor(&__timing_block, JL_TIMING_ ## owner)
 #endif
-
-#endif
 #endif
 
 #endif
@@ -620,6 +620,27 @@ static void jl_eval_errorf(jl_module_t *m, const char* fmt, ...)
     JL_GC_POP();
 }
 
+// Most loop-containing top-level thunks (package `__init__` bodies, file-scope
+// initialization) run exactly once, so JIT-compiling them on the strength of a
+// loop in the IR mostly buys LLVM time for nothing. Instead of predicting from
+// the IR we measure: eligible thunks are interpreted under a wall-clock budget
+// (TOPLEVEL_INTERP_BUDGET_NAME, in ms), and only after a run actually blows the
+// budget do subsequent eligible thunks get promoted to codegen. An in-budget
+// interpreted run demotes again, so one slow thunk does not pin us in compile
+// mode. Setting the budget to 0 restores the old eager heuristic.
+static uint64_t toplevel_interp_budget_ns(void)
+{
+    static uint64_t budget = UINT64_MAX;
+    if (__unlikely(budget == UINT64_MAX)) {
+        char *env = getenv(TOPLEVEL_INTERP_BUDGET_NAME);
+        long ms = env != NULL ? atol(env) : TOPLEVEL_INTERP_BUDGET_DEFAULT;
+        budget = ms <= 0 ? 0 : (uint64_t)ms * 1000 * 1000;
+    }
+    return budget;
+}
+
+static _Atomic(int) toplevel_interp_over_budget = 0;
+
 jl_value_t *jl_toplevel_eval_flex(jl_module_t *JL_NONNULL m, jl_value_t *e, int fast, int expanded)
 {
     jl_task_t *ct = jl_current_task;
@@ -857,13 +878,22 @@ jl_value_t *jl_toplevel_eval_flex(jl_module_t *JL_NONNULL m, jl_value_t *e, int
     assert(jl_typeis(thk->code, jl_array_any_type));
     body_attributes((jl_array_t*)thk->code, &has_intrinsics, &has_defs, &has_loops, &has_opaque, &forced_compile);
 
-    jl_value_t *result;
-    if (forced_compile || has_intrinsics ||
-            (!has_defs && fast && has_loops &&
+    int use_codegen = forced_compile || has_intrinsics;
+    int measured_interp = 0;
+    if (!use_codegen && !has_defs && fast && has_loops &&
             jl_options.compile_enabled != JL_OPTIONS_COMPILE_OFF &&
             jl_options.compile_enabled != JL_OPTIONS_COMPILE_MIN &&
             jl_get_module_compile(m) != JL_OPTIONS_COMPILE_OFF &&
-            jl_get_module_compile(m) != JL_OPTIONS_COMPILE_MIN)) {
+            jl_get_module_compile(m) != JL_OPTIONS_COMPILE_MIN) {
+        if (toplevel_interp_budget_ns() == 0 ||
+                jl_atomic_load_relaxed(&toplevel_interp_over_budget))
+            use_codegen = 1;
+        else
+            measured_interp = 1;
+    }
+
+    jl_value_t *result;
+    if (use_codegen) {
         // use codegen
         mfunc = method_instance_for_thunk(thk, m);
         jl_resolve_globals_in_ir((jl_array_t*)thk->code, m, NULL, 0);
@@ -885,7 +915,15 @@ jl_value_t *jl_toplevel_eval_flex(jl_module_t *JL_NONNULL m, jl_value_t *e, int
         if (has_opaque) {
             jl_resolve_globals_in_ir((jl_array_t*)thk->code, m, NULL, 0);
         }
-        result = jl_interpret_toplevel_thunk(m, thk);
+        if (measured_interp) {
+            uint64_t t0 = jl_hrtime();
+            result = jl_interpret_toplevel_thunk(m, thk);
+            jl_atomic_store_relaxed(&toplevel_interp_over_budget,
+                                    jl_hrtime() - t0 > toplevel_interp_budget_ns());
+        }
+        else {
+            result = jl_interpret_toplevel_thunk(m, thk);
+        }
     }
 
     JL_GC_POP();
@@ -1008,6 +1046,14 @@ static jl_value_t *jl_parse_eval_all(jl_module_t *module, jl_value_t *text,
     int err = 0;
 
     JL_TRY {
+        // This loop is strictly sequential by necessity, not oversight:
+        // evaluating statement N can define macros, `using` bindings and
+        // modules that expansion of statement N+1 resolves against, so
+        // lowering cannot legally run ahead of evaluation without proving no
+        // statement in between has such effects (macro expansion itself runs
+        // arbitrary julia code, so "proving" is the hard part). Expansion
+        // also allocates GC objects and calls back into julia, which
+        // confines it to a thread with a julia task context.
         for (size_t i = 0; i < jl_expr_nargs(ast); i++) {
             expression = jl_exprarg(ast, i);
             if (jl_is_linenode(expression)) {
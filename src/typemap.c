@@ -440,7 +440,23 @@ static int jl_typemap_intersection_node_visitor(jl_typemap_entry_t *ml, struct t
     // mark this `register` because (for branch prediction)
     // that can be absolutely critical for speed
     register jl_typemap_intersection_visitor_fptr fptr = closure->fptr;
+    // arity band of the query, for a cheap pre-intersection reject below: a
+    // tuple type cannot intersect a signature whose argument-count range
+    // excludes it, and that test is two loads per entry instead of a full
+    // jl_type_intersection_env_s call
+    size_t nq = jl_nparams(jl_unwrap_unionall(closure->type));
+    int qva = closure->va != NULL;
     while (ml != (void*)jl_nothing) {
+        if (!(qva && ml->va)) {
+            size_t ns = jl_nparams(jl_unwrap_unionall((jl_value_t*)ml->sig));
+            // a vararg spans >= n-1 arguments, a fixed signature exactly n
+            if (!qva && !ml->va ? nq != ns
+                    : ml->va ? nq + 1 < ns
+                    : ns + 1 < nq) {
+                ml = jl_atomic_load_relaxed(&ml->next);
+                continue;
+            }
+        }
         if (closure->type == (jl_value_t*)ml->sig) {
             // fast-path for the intersection of a type with itself
             if (closure->env)
@@ -687,22 +703,24 @@ static jl_typemap_entry_t *jl_typemap_entry_assoc_by_type(
                     }
                 }
                 if (ismatch) {
-                    if (search->world < ml->min_world) {
+                    size_t min_world = jl_atomic_load_relaxed(&ml->min_world);
+                    size_t max_world = jl_atomic_load_relaxed(&ml->max_world);
+                    if (search->world < min_world) {
                         // ignore method table entries that are part of a later world
-                        if (search->max_valid >= ml->min_world)
-                            search->max_valid = ml->min_world - 1;
+                        if (search->max_valid >= min_world)
+                            search->max_valid = min_world - 1;
                     }
-                    else if (search->world > ml->max_world) {
+                    else if (search->world > max_world) {
                         // ignore method table entries that have been replaced in the current world
-                        if (search->min_valid <= ml->max_world)
-                            search->min_valid = ml->max_world + 1;
+                        if (search->min_valid <= max_world)
+                            search->min_valid = max_world + 1;
                     }
                     else {
                         // intersect the env valid range with method's valid range
-                        if (search->min_valid < ml->min_world)
-                            search->min_valid = ml->min_world;
-                        if (search->max_valid > ml->max_world)
-                            search->max_valid = ml->max_world;
+                        if (search->min_valid < min_world)
+                            search->min_valid = min_world;
+                        if (search->max_valid > max_world)
+                            search->max_valid = max_world;
                         return ml;
                     }
                 }
@@ -718,7 +736,8 @@ static jl_typemap_entry_t *jl_typemap_entry_lookup_by_type(
         jl_typemap_entry_t *ml, struct jl_typemap_assoc *search)
 {
     for (; ml != (void*)jl_nothing; ml = jl_atomic_load_relaxed(&ml->next)) {
-        if (search->world < ml->min_world || search->world > ml->max_world)
+        if (search->world < jl_atomic_load_relaxed(&ml->min_world) ||
+            search->world > jl_atomic_load_relaxed(&ml->max_world))
             continue;
         // unroll the first few cases here, to the extent that is possible to do fast and easily
         jl_value_t *types = search->types;
@@ -923,7 +942,8 @@ jl_typemap_entry_t *jl_typemap_entry_assoc_exact(jl_typemap_entry_t *ml, jl_valu
     // some manually-unrolled common special cases
     while (ml->simplesig == (void*)jl_nothing && ml->guardsigs == jl_emptysvec && ml->isleafsig) {
         // use a tight loop for as long as possible
-        if (world >= ml->min_world && world <= ml->max_world) {
+        if (world >= jl_atomic_load_relaxed(&ml->min_world) &&
+            world <= jl_atomic_load_relaxed(&ml->max_world)) {
             if (n == jl_nparams(ml->sig) && jl_typeof(arg1) == jl_tparam(ml->sig, 0)) {
                 if (n == 1)
                     return ml;
@@ -948,7 +968,8 @@ jl_typemap_entry_t *jl_typemap_entry_assoc_exact(jl_typemap_entry_t *ml, jl_valu
     }
 
     for (; ml != (void*)jl_nothing; ml = jl_atomic_load_relaxed(&ml->next)) {
-        if (world < ml->min_world || world > ml->max_world)
+        if (world < jl_atomic_load_relaxed(&ml->min_world) ||
+            world > jl_atomic_load_relaxed(&ml->max_world))
             continue; // ignore replaced methods
         size_t lensig = jl_nparams(ml->sig);
         if (lensig == n || (ml->va && lensig <= n+1)) {
@@ -1243,6 +1264,56 @@ static void jl_typemap_level_insert_(
     jl_typemap_list_insert_(map, &cache->linear, (jl_value_t*)cache, newrec);
 }
 
+// Typemap entries are handed out from small contiguous allocation runs so
+// that the entry chains of one method table, which are built up by
+// consecutive insertions, tend to share cache lines during dispatch-miss
+// walks. A relocating per-table arena is not possible: lock-free readers hold
+// bare entry pointers, so an entry can never move once published. Spares are
+// fully initialized placeholder objects kept alive through jl_typemap_spares
+// until they are handed out.
+#define TYPEMAP_ALLOC_BATCH 16
+jl_array_t *jl_typemap_spares JL_GLOBALLY_ROOTED;
+static jl_mutex_t typemap_spares_lock;
+
+static jl_typemap_entry_t *typemap_entry_alloc(jl_ptls_t ptls)
+{
+    jl_typemap_entry_t *newrec = NULL;
+    JL_LOCK(&typemap_spares_lock);
+    size_t n = jl_typemap_spares ? jl_array_len(jl_typemap_spares) : 0;
+    if (n > 0) {
+        newrec = (jl_typemap_entry_t*)jl_array_ptr_ref(jl_typemap_spares, n - 1);
+        jl_array_del_end(jl_typemap_spares, 1);
+    }
+    else {
+        if (jl_typemap_spares == NULL)
+            jl_typemap_spares = jl_alloc_vec_any(0);
+        for (int i = 0; i < TYPEMAP_ALLOC_BATCH - 1; i++) {
+            jl_typemap_entry_t *spare =
+                (jl_typemap_entry_t*)jl_gc_alloc(ptls, sizeof(jl_typemap_entry_t),
+                                                 jl_typemap_entry_type);
+            spare->sig = jl_anytuple_type;
+            spare->simplesig = (jl_tupletype_t*)jl_nothing;
+            spare->func.value = jl_nothing;
+            spare->guardsigs = jl_emptysvec;
+            jl_atomic_store_relaxed(&spare->next, (jl_typemap_entry_t*)jl_nothing);
+            jl_atomic_store_relaxed(&spare->min_world, 1);
+            jl_atomic_store_relaxed(&spare->max_world, 1);
+            spare->va = 0;
+            spare->issimplesig = 0;
+            spare->isleafsig = 0;
+            jl_array_ptr_1d_push(jl_typemap_spares, (jl_value_t*)spare);
+        }
+    }
+    JL_UNLOCK(&typemap_spares_lock);
+    if (newrec == NULL) {
+        // allocated right after the refill run above, so it is adjacent to
+        // the spares that the following insertions will receive
+        newrec = (jl_typemap_entry_t*)jl_gc_alloc(ptls, sizeof(jl_typemap_entry_t),
+                                                  jl_typemap_entry_type);
+    }
+    return newrec;
+}
+
 jl_typemap_entry_t *jl_typemap_alloc(
         jl_tupletype_t *type, jl_tupletype_t *simpletype, jl_svec_t *guardsigs,
         jl_value_t *newvalue, size_t min_world, size_t max_world)
@@ -1272,16 +1343,20 @@ jl_typemap_entry_t *jl_typemap_alloc(
             isleafsig = issimplesig = 0;
     }
 
-    jl_typemap_entry_t *newrec =
-        (jl_typemap_entry_t*)jl_gc_alloc(ct->ptls, sizeof(jl_typemap_entry_t),
-                                         jl_typemap_entry_type);
+    jl_typemap_entry_t *newrec = typemap_entry_alloc(ct->ptls);
+    // newrec may be a previously allocated (and possibly promoted) spare, so
+    // these stores need write barriers
     newrec->sig = type;
+    jl_gc_wb(newrec, type);
     newrec->simplesig = simpletype;
+    jl_gc_wb(newrec, simpletype);
     newrec->func.value = newvalue;
+    jl_gc_wb(newrec, newvalue);
     newrec->guardsigs = guardsigs;
+    jl_gc_wb(newrec, guardsigs);
     jl_atomic_store_relaxed(&newrec->next, (jl_typemap_entry_t*)jl_nothing);
-    newrec->min_world = min_world;
-    newrec->max_world = max_world;
+    jl_atomic_store_relaxed(&newrec->min_world, min_world);
+    jl_atomic_store_relaxed(&newrec->max_world, max_world);
     newrec->va = isva;
     newrec->issimplesig = issimplesig;
     newrec->isleafsig = isleafsig;
@@ -1291,6 +1366,7 @@ jl_typemap_entry_t *jl_typemap_alloc(
 void jl_typemap_insert(_Atomic(jl_typemap_t *) *pcache, jl_value_t *parent,
         jl_typemap_entry_t *newrec, int8_t offs)
 {
+    JL_PROBE_MT_TYPEMAP_INSERT(parent, newrec);
     jl_typemap_t *cache = jl_atomic_load_relaxed(pcache);
     jl_typemap_insert_generic(cache, pcache, parent, newrec, offs);
 }